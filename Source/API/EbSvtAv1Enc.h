@@ -60,8 +60,10 @@ typedef enum ATTRIBUTE_PACKED {
     0x00000002 // signals that the packet contains a show existing frame at the end
 #define EB_BUFFERFLAG_HAS_TD 0x00000004 // signals that the packet contains a TD
 #define EB_BUFFERFLAG_IS_ALT_REF 0x00000008 // signals that the packet contains an ALT_REF frame
+#define EB_BUFFERFLAG_PARTIAL \
+    0x00000010 // signals that the packet holds only the leading part of a frame, more packets follow
 #define EB_BUFFERFLAG_ERROR_MASK \
-    0xFFFFFFF0 // mask for signalling error assuming top flags fit in 4 bits. To be changed, if more flags are added.
+    0xFFFFFFE0 // mask for signalling error assuming top flags fit in 5 bits. To be changed, if more flags are added.
 
 /*
  * Struct for storing content light level information
@@ -136,6 +138,12 @@ typedef enum SvtAv1IntraRefreshType {
 typedef enum {
     SVT_AV1_STREAM_INFO_START                = 1,
     SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_OUT = SVT_AV1_STREAM_INFO_START,
+    /* First pass stats produced since the previous request (SvtAv1FixedBuf), valid
+     * until the next request. The stats handed out are dropped by the library, after
+     * the first request SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_OUT is no longer available. */
+    SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_NEW,
+    /* Size of the first pass stats of a picture in bytes (uint64_t) */
+    SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_SIZE,
 
     SVT_AV1_STREAM_INFO_END,
 } SVT_AV1_STREAM_INFO_ID;
@@ -339,6 +347,11 @@ typedef struct EbSvtAv1EncConfiguration {
 
     /* CDEF Level
     *
+    * -1 = auto, set per preset
+    * 0 = off
+    * 1 to 4 = strength search from the most to the fewest strengths tested
+    * 19 = level 2 with the luma second pass limited to the 4 best primary strengths
+    *
     * Default is -1. */
     int cdef_level;
 
@@ -677,6 +690,63 @@ typedef struct EbSvtAv1EncConfiguration {
      * EB_CSP_COLOCATED: value 2 from H.273 AKA "top left"
      */
     EbChromaSamplePosition chroma_sample_position;
+
+    /* Sub-frame output, only applicable for low delay (pred_structure == 1).
+     * When enabled, the frame header and each tile group (OBU_TILE_GROUP) are
+     * output as soon as the tiles are entropy coded, in packets flagged with
+     * EB_BUFFERFLAG_PARTIAL. The last packet of a frame is not flagged and carries
+     * the remaining bytes (possibly none). Concatenating the packets up to and
+     * including the unflagged one gives the temporal unit.
+     * Default is 0. */
+    Bool sub_frame_output;
+
+    /* Adaptive thread allocation. When enabled, at most --lp worker threads are
+     * kept active over the multi-threaded stages (picture analysis, ME, TPL, MDC,
+     * EncDec, DLF, CDEF, restoration, entropy coding). The busy time of each
+     * stage is measured at runtime and idle threads are moved to saturated
+     * stages; the decisions are logged. Does not change the bitstream.
+     * Default is 0. */
+    Bool adaptive_threads;
+
+    /* Size of the pictures passed to svt_av1_enc_send_picture() when it differs
+     * from source_width x source_height. The library downscales each picture to
+     * the encoding size with the resize filters, so that several encoders can be
+     * fed from one decoded source to produce the renditions of a bitrate ladder.
+     * Default is 0 (pictures are sent at the encoding size). */
+    uint32_t input_picture_width;
+    uint32_t input_picture_height;
+
+    /* Path of a file to store the motion analysis of each picture in (motion
+     * estimation candidates and distortions, global motion), and path of a file
+     * written by an earlier encode of the same source to read it from. Pictures
+     * found in the imported file skip motion estimation; a picture that differs
+     * from the exported source stops the import. The resolution, preset and
+     * prediction structure must match the export. The strings must stay valid
+     * until svt_av1_enc_init() returns. Default is NULL. */
+    const char *analysis_out_file;
+    const char *analysis_in_file;
+
+    /* Sub-pel reference planes. When set, the EIGHTTAP_REGULAR sub-pel planes of
+     * the luma of each reference picture are interpolated once the reference is
+     * reconstructed and padded, and the single reference luma predictions at
+     * those positions copy the planes instead of filtering the reference. Trades
+     * the memory of the planes (reported at init) for convolution work; does not
+     * change the bitstream.
+     * 0: off, 1: half-pel planes (3 per reference), 2: half-pel and quarter-pel
+     * planes (15 per reference).
+     * Default is 0. */
+    uint8_t subpel_ref_planes;
+
+    /* Streamed first pass stats, only applicable for the first pass (pass 1)
+     * and the single pass VBR (rate control mode 1, pass 0). The first pass
+     * stats of the pictures are sent by svt_av1_enc_send_stats() instead of
+     * being computed over the look ahead, so that the first pass and the final
+     * pass of a two-pass encode can run concurrently. The rate control works
+     * over the look ahead of the encoder and keeps the stats of a bounded window
+     * of pictures. Set for the first pass, it analyses every picture rather than
+     * repeating the stats of the pictures it analysed over the next ones.
+     * Default is 0. */
+    Bool rc_stats_stream;
 } EbSvtAv1EncConfiguration;
 
 /**
@@ -751,6 +821,19 @@ EB_API EbErrorType svt_av1_enc_stream_header_release(EbBufferHeaderType *stream_
 EB_API EbErrorType svt_av1_enc_send_picture(EbComponentType    *svt_enc_component,
                                             EbBufferHeaderType *p_buffer);
 
+/* OPTIONAL: Send the first pass stats of pictures, with rc_stats_stream set.
+     * The stats of a picture have to be sent before the picture. The buffer holds
+     * whole stats as output by the first pass (SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_NEW),
+     * the total stats closing the first pass are ignored. Returns
+     * EB_ErrorInsufficientResources when the stats queue is full, the stats can be sent
+     * again once pictures have been encoded.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ *stats              First pass stats. */
+EB_API EbErrorType svt_av1_enc_send_stats(EbComponentType      *svt_enc_component,
+                                          const SvtAv1FixedBuf *stats);
+
 /* STEP 5: Receive packet.
      * Parameter:
     * @ *svt_enc_component  Encoder handler.
@@ -48,12 +48,16 @@
 #define PASS_TOKEN "--pass"
 #define TWO_PASS_STATS_TOKEN "--stats"
 #define PASSES_TOKEN "--passes"
+#define ANALYSIS_OUT_TOKEN "--analysis-out"
+#define ANALYSIS_IN_TOKEN "--analysis-in"
+#define STATS_STREAM_TOKEN "--stats-stream"
 #define STAT_FILE_TOKEN "--stat-file"
 #define INPUT_PREDSTRUCT_FILE_TOKEN "--pred-struct-file"
 #define WIDTH_TOKEN "-w"
 #define HEIGHT_TOKEN "-h"
 #define NUMBER_OF_PICTURES_TOKEN "-n"
 #define BUFFERED_INPUT_TOKEN "--nb"
+#define READ_AHEAD_TOKEN "--read-ahead"
 #define NO_PROGRESS_TOKEN "--no-progress" // tbd if it should be removed
 #define PROGRESS_TOKEN "--progress"
 #define QP_TOKEN "-q"
@@ -85,6 +89,7 @@
 #define FILM_GRAIN_DENOISE_APPLY_TOKEN "--film-grain-denoise"
 #define INTRA_REFRESH_TYPE_TOKEN "--irefresh-type" // no Eval
 #define CDEF_ENABLE_TOKEN "--enable-cdef"
+#define CDEF_LEVEL_TOKEN "--cdef-level"
 #define SCREEN_CONTENT_TOKEN "--scm"
 // --- start: ALTREF_FILTERING_SUPPORT
 #define ENABLE_TF_TOKEN "--enable-tf"
@@ -116,6 +121,7 @@
 #define SUPER_BLOCK_SIZE_TOKEN "--sb-size"
 #define TILE_ROW_TOKEN "--tile-rows"
 #define TILE_COL_TOKEN "--tile-columns"
+#define SUB_FRAME_OUTPUT_TOKEN "--sub-frame-output"
 
 #define SCENE_CHANGE_DETECTION_TOKEN "--scd"
 #define INJECTOR_TOKEN "--inj" // no Eval
@@ -124,6 +130,7 @@
 #define THREAD_MGMNT "--lp"
 #define PIN_TOKEN "--pin"
 #define TARGET_SOCKET "--ss"
+#define ADAPTIVE_THREADS_TOKEN "--adaptive-threads"
 #define RESTRICTED_MOTION_VECTOR "--rmv"
 #define CONFIG_FILE_COMMENT_CHAR '#'
 #define CONFIG_FILE_NEWLINE_CHAR '\n'
@@ -152,6 +159,7 @@
 #define ENABLE_RESTORATION_TOKEN "--enable-restoration"
 #define MFMV_ENABLE_NEW_TOKEN "--enable-mfmv"
 #define FAST_DECODE_TOKEN "--fast-decode"
+#define SUBPEL_REF_PLANES_TOKEN "--subpel-ref-planes"
 #define HDR_INPUT_NEW_TOKEN "--enable-hdr"
 #define ADAPTIVE_QP_ENABLE_NEW_TOKEN "--aq-mode"
 #define INPUT_FILE_LONG_TOKEN "--input"
@@ -165,6 +173,9 @@
 #define LOOP_FILTER_ENABLE "--enable-dlf"
 #define FORCED_MAX_FRAME_WIDTH_TOKEN "--forced-max-frame-width"
 #define FORCED_MAX_FRAME_HEIGHT_TOKEN "--forced-max-frame-height"
+#define SCALED_WIDTH_TOKEN "--scaled-width"
+#define SCALED_HEIGHT_TOKEN "--scaled-height"
+#define LADDER_TOKEN "--ladder"
 
 #define COLOR_PRIMARIES_NEW_TOKEN "--color-primaries"
 #define TRANSFER_CHARACTERISTICS_NEW_TOKEN "--transfer-characteristics"
@@ -204,6 +215,21 @@ static Bool fopen_and_lock(FILE **file, const char *name, Bool write) {
     return FALSE;
 }
 
+Bool stats_file_released(FILE *file) {
+#ifdef _WIN32
+    HANDLE handle = get_file_handle(file);
+    if (handle == INVALID_HANDLE_VALUE || !LockFile(handle, 0, 0, MAXDWORD, MAXDWORD))
+        return FALSE;
+    UnlockFile(handle, 0, 0, MAXDWORD, MAXDWORD);
+#else
+    int fd = fileno(file);
+    if (flock(fd, LOCK_SH | LOCK_NB))
+        return FALSE;
+    flock(fd, LOCK_UN);
+#endif
+    return TRUE;
+}
+
 /**********************************
  * Set Cfg Functions
  **********************************/
@@ -293,6 +319,28 @@ static void set_two_pass_stats(const char *value, EbConfig *cfg) {
 #endif
 }
 
+static void set_analysis_out(const char *value, EbConfig *cfg) {
+    free(cfg->analysis_out);
+#ifndef _WIN32
+    cfg->analysis_out = strdup(value);
+#else
+    cfg->analysis_out               = _strdup(value);
+#endif
+    cfg->config.analysis_out_file = cfg->analysis_out;
+}
+static void set_analysis_in(const char *value, EbConfig *cfg) {
+    free(cfg->analysis_in);
+#ifndef _WIN32
+    cfg->analysis_in = strdup(value);
+#else
+    cfg->analysis_in                = _strdup(value);
+#endif
+    cfg->config.analysis_in_file = cfg->analysis_in;
+}
+static void set_stats_stream(const char *value, EbConfig *cfg) {
+    cfg->config.rc_stats_stream = (Bool)strtoul(value, NULL, 0);
+}
+
 static void set_passes(const char *value, EbConfig *cfg) {
     (void)value;
     (void)cfg;
@@ -320,12 +368,24 @@ static void set_cfg_forced_max_frame_width(const char *value, EbConfig *cfg) {
 static void set_cfg_forced_max_frame_height(const char *value, EbConfig *cfg) {
     cfg->config.forced_max_frame_height = strtoul(value, NULL, 0);
 }
+static void set_cfg_scaled_width(const char *value, EbConfig *cfg) {
+    cfg->scaled_width = strtoul(value, NULL, 0);
+}
+static void set_cfg_scaled_height(const char *value, EbConfig *cfg) {
+    cfg->scaled_height = strtoul(value, NULL, 0);
+}
+static void set_ladder(const char *value, EbConfig *cfg) {
+    cfg->ladder = (Bool)strtoul(value, NULL, 0);
+}
 static void set_cfg_frames_to_be_encoded(const char *value, EbConfig *cfg) {
     cfg->frames_to_be_encoded = strtol(value, NULL, 0);
 };
 static void set_buffered_input(const char *value, EbConfig *cfg) {
     cfg->buffered_input = strtol(value, NULL, 0);
 };
+static void set_read_ahead(const char *value, EbConfig *cfg) {
+    cfg->read_ahead = strtol(value, NULL, 0);
+};
 static void set_no_progress(const char *value, EbConfig *cfg) {
     switch (value ? *value : '1') {
     case '0': cfg->progress = 1; break; // equal to --progress 1
@@ -550,6 +610,9 @@ static void set_cdef_enable(const char *value, EbConfig *cfg) {
     // Set CDEF to either DEFAULT or 0
     cfg->config.cdef_level = -!!strtoul(value, NULL, 0);
 };
+static void set_cdef_level(const char *value, EbConfig *cfg) {
+    cfg->config.cdef_level = strtol(value, NULL, 0);
+};
 static void set_enable_restoration_flag(const char *value, EbConfig *cfg) {
     cfg->config.enable_restoration_filtering = -!!strtoul(value, NULL, 0);
 };
@@ -559,12 +622,18 @@ static void set_enable_mfmv_flag(const char *value, EbConfig *cfg) {
 static void set_fast_decode_flag(const char *value, EbConfig *cfg) {
     cfg->config.fast_decode = (Bool)strtol(value, NULL, 0);
 };
+static void set_subpel_ref_planes(const char *value, EbConfig *cfg) {
+    cfg->config.subpel_ref_planes = (uint8_t)strtoul(value, NULL, 0);
+};
 static void set_tile_row(const char *value, EbConfig *cfg) {
     cfg->config.tile_rows = strtoul(value, NULL, 0);
 };
 static void set_tile_col(const char *value, EbConfig *cfg) {
     cfg->config.tile_columns = strtoul(value, NULL, 0);
 };
+static void set_sub_frame_output(const char *value, EbConfig *cfg) {
+    cfg->config.sub_frame_output = (Bool)strtoul(value, NULL, 0);
+};
 static void set_scene_change_detection(const char *value, EbConfig *cfg) {
     cfg->config.scene_change_detection = strtoul(value, NULL, 0);
 }
@@ -729,6 +798,9 @@ static void set_pinned_execution(const char *value, EbConfig *cfg) {
 static void set_target_socket(const char *value, EbConfig *cfg) {
     cfg->config.target_socket = (int32_t)strtol(value, NULL, 0);
 };
+static void set_adaptive_threads(const char *value, EbConfig *cfg) {
+    cfg->config.adaptive_threads = (Bool)strtoul(value, NULL, 0);
+};
 static void set_restricted_motion_vector(const char *value, EbConfig *cfg) {
     cfg->config.restricted_motion_vector = !!strtol(value, NULL, 0);
 };
@@ -879,6 +951,25 @@ ConfigEntry config_entry_global_options[] = {
      "Maximum frame height value to force, default is 0 [64-8704]",
      set_cfg_forced_max_frame_height},
 
+    {SINGLE_INPUT,
+     SCALED_WIDTH_TOKEN,
+     "Encode the input downscaled by the library to this width, default is 0 [0: input width, "
+     "64-16384]",
+     set_cfg_scaled_width},
+
+    {SINGLE_INPUT,
+     SCALED_HEIGHT_TOKEN,
+     "Encode the input downscaled by the library to this height, default is 0 [0: input height, "
+     "64-8704]",
+     set_cfg_scaled_height},
+
+    {SINGLE_INPUT,
+     LADDER_TOKEN,
+     "Encode the input of the first channel in every channel, reading it once; use "
+     "--scaled-width/--scaled-height and the rate control options per channel to build a bitrate "
+     "ladder, default is 0 [0-1]",
+     set_ladder},
+
     {SINGLE_INPUT,
      NUMBER_OF_PICTURES_TOKEN,
      "Number of frames to encode. If `n` is larger than the input, the encoder will loop back and "
@@ -895,6 +986,11 @@ ConfigEntry config_entry_global_options[] = {
      "Buffer `n` input frames into memory and use them to encode, default is -1 [-1: no frames "
      "buffered, 1-`(2^31)-1`]",
      set_buffered_input},
+    {SINGLE_INPUT,
+     READ_AHEAD_TOKEN,
+     "Read `n` input frames ahead of the encoder on a separate thread, default is -1 [-1: auto, "
+     "4 frames unless the input is memory mapped or buffered, 0: off, 1-64]",
+     set_read_ahead},
     {SINGLE_INPUT,
      ENCODER_COLOR_FORMAT,
      "Color format, only yuv420 is supported at this time, default is 1 [0: yuv400, 1: yuv420, 2: "
@@ -970,6 +1066,11 @@ ConfigEntry config_entry_global_options[] = {
      "Specifies which socket to run on, assumes a max of two sockets. Refer to Appendix A.1 of the "
      "user guide, default is -1 [-1, 0, -1]",
      set_target_socket},
+    {SINGLE_INPUT,
+     ADAPTIVE_THREADS_TOKEN,
+     "Keep --lp worker threads active and move them between stages based on their measured load, "
+     "default is 0 [0-1]",
+     set_adaptive_threads},
     // Termination
     {SINGLE_INPUT, NULL, NULL, NULL}};
 
@@ -1119,6 +1220,22 @@ ConfigEntry config_entry_2p[] = {
      "Number of encoding passes, default is preset dependent but generally 1 [1: one pass encode, "
      "2: multi-pass encode]",
      set_passes},
+    {SINGLE_INPUT,
+     ANALYSIS_OUT_TOKEN,
+     "Filename to store the motion analysis of the encode in, for later encodes of the same "
+     "source at other rates",
+     set_analysis_out},
+    {SINGLE_INPUT,
+     ANALYSIS_IN_TOKEN,
+     "Filename of a motion analysis stored by --analysis-out, motion estimation is skipped for "
+     "the pictures it describes",
+     set_analysis_in},
+    {SINGLE_INPUT,
+     STATS_STREAM_TOKEN,
+     "Read the first pass stats of --stats while the first pass writes them, for a single pass "
+     "VBR encode run concurrently with the first pass; with --pass 1, write the stats of every "
+     "frame for it, default is 0 [0-1]",
+     set_stats_stream},
     // Termination
     {SINGLE_INPUT, NULL, NULL, NULL}};
 
@@ -1166,6 +1283,11 @@ ConfigEntry config_entry_specific[] = {
      "Number of tile columns to use, `TileCol == log2(x)`, default changes per resolution but is 1 "
      "[0-4]",
      set_tile_col},
+    {SINGLE_INPUT,
+     SUB_FRAME_OUTPUT_TOKEN,
+     "Output the tiles of a frame as they are coded, in tile groups, low delay with tiles only, "
+     "default is 0 [0-1]",
+     set_sub_frame_output},
 
     // DLF
     {SINGLE_INPUT,
@@ -1177,6 +1299,11 @@ ConfigEntry config_entry_specific[] = {
      CDEF_ENABLE_TOKEN,
      "Enable Constrained Directional Enhancement Filter, default is 1 [0-1]",
      set_cdef_enable},
+    {SINGLE_INPUT,
+     CDEF_LEVEL_TOKEN,
+     "CDEF strength search level, default is -1 [-1: auto, 0: off, 1-4: full to fast search, "
+     "19: level 2 with a pruned second pass]",
+     set_cdef_level},
     // RESTORATION
     {SINGLE_INPUT,
      ENABLE_RESTORATION_TOKEN,
@@ -1195,6 +1322,12 @@ ConfigEntry config_entry_specific[] = {
      FAST_DECODE_TOKEN,
      "Fast Decoder levels, default is 0 [0-1]",
      set_fast_decode_flag},
+    {SINGLE_INPUT,
+     SUBPEL_REF_PLANES_TOKEN,
+     "Precompute the sub-pel planes of the references to copy the predictions at those "
+     "positions, trading memory for speed, default is 0 [0: off, 1: half-pel, 2: half-pel and "
+     "quarter-pel]",
+     set_subpel_ref_planes},
     // --- start: ALTREF_FILTERING_SUPPORT
     {SINGLE_INPUT,
      ENABLE_TF_TOKEN,
@@ -1345,10 +1478,14 @@ ConfigEntry config_entry[] = {
      FORCED_MAX_FRAME_HEIGHT_TOKEN,
      "ForcedMaximumFrameHeight",
      set_cfg_forced_max_frame_height},
+    {SINGLE_INPUT, SCALED_WIDTH_TOKEN, "ScaledWidth", set_cfg_scaled_width},
+    {SINGLE_INPUT, SCALED_HEIGHT_TOKEN, "ScaledHeight", set_cfg_scaled_height},
+    {SINGLE_INPUT, LADDER_TOKEN, "Ladder", set_ladder},
     // Prediction Structure
     {SINGLE_INPUT, NUMBER_OF_PICTURES_TOKEN, "FrameToBeEncoded", set_cfg_frames_to_be_encoded},
     {SINGLE_INPUT, NUMBER_OF_PICTURES_LONG_TOKEN, "FrameToBeEncoded", set_cfg_frames_to_be_encoded},
     {SINGLE_INPUT, BUFFERED_INPUT_TOKEN, "BufferedInput", set_buffered_input},
+    {SINGLE_INPUT, READ_AHEAD_TOKEN, "ReadAhead", set_read_ahead},
 
     //   Annex A parameters
     {SINGLE_INPUT, TIER_TOKEN, "Tier", set_tier}, // Lacks a command line flag for now
@@ -1386,6 +1523,7 @@ ConfigEntry config_entry[] = {
     {SINGLE_INPUT, THREAD_MGMNT, "LogicalProcessors", set_logical_processors},
     {SINGLE_INPUT, PIN_TOKEN, "PinnedExecution", set_pinned_execution},
     {SINGLE_INPUT, TARGET_SOCKET, "TargetSocket", set_target_socket},
+    {SINGLE_INPUT, ADAPTIVE_THREADS_TOKEN, "AdaptiveThreads", set_adaptive_threads},
 
     // Rate Control Options
     {SINGLE_INPUT, RATE_CONTROL_ENABLE_TOKEN, "RateControlMode", set_rate_control_mode},
@@ -1455,6 +1593,9 @@ ConfigEntry config_entry[] = {
     {SINGLE_INPUT, PASS_TOKEN, "Pass", set_pass},
     {SINGLE_INPUT, TWO_PASS_STATS_TOKEN, "Stats", set_two_pass_stats},
     {SINGLE_INPUT, PASSES_TOKEN, "Passes", set_passes},
+    {SINGLE_INPUT, ANALYSIS_OUT_TOKEN, "AnalysisOut", set_analysis_out},
+    {SINGLE_INPUT, ANALYSIS_IN_TOKEN, "AnalysisIn", set_analysis_in},
+    {SINGLE_INPUT, STATS_STREAM_TOKEN, "StatsStream", set_stats_stream},
 
     // GOP size and type Options
     {SINGLE_INPUT, INTRA_PERIOD_TOKEN, "IntraPeriod", set_cfg_intra_period},
@@ -1472,12 +1613,15 @@ ConfigEntry config_entry[] = {
     // AV1 Specific Options
     {SINGLE_INPUT, TILE_ROW_TOKEN, "TileRow", set_tile_row},
     {SINGLE_INPUT, TILE_COL_TOKEN, "TileCol", set_tile_col},
+    {SINGLE_INPUT, SUB_FRAME_OUTPUT_TOKEN, "SubFrameOutput", set_sub_frame_output},
     {SINGLE_INPUT, LOOP_FILTER_ENABLE, "LoopFilterEnable", set_enable_dlf_flag},
     {SINGLE_INPUT, CDEF_ENABLE_TOKEN, "CDEFLevel", set_cdef_enable},
+    {SINGLE_INPUT, CDEF_LEVEL_TOKEN, "CDEFSearchLevel", set_cdef_level},
     {SINGLE_INPUT, ENABLE_RESTORATION_TOKEN, "EnableRestoration", set_enable_restoration_flag},
     {SINGLE_INPUT, ENABLE_TPL_LA_TOKEN, "EnableTPLModel", set_enable_tpl_la},
     {SINGLE_INPUT, MFMV_ENABLE_NEW_TOKEN, "Mfmv", set_enable_mfmv_flag},
     {SINGLE_INPUT, FAST_DECODE_TOKEN, "FastDecode", set_fast_decode_flag},
+    {SINGLE_INPUT, SUBPEL_REF_PLANES_TOKEN, "SubpelRefPlanes", set_subpel_ref_planes},
     {SINGLE_INPUT, TUNE_TOKEN, "Tune", set_tune},
     //   ALT-REF filtering support
     {SINGLE_INPUT, ENABLE_TF_TOKEN, "EnableTf", set_enable_tf},
@@ -1530,6 +1674,7 @@ EbConfig *svt_config_ctor() {
         return NULL;
     config_ptr->error_log_file      = stderr;
     config_ptr->buffered_input      = -1;
+    config_ptr->read_ahead          = -1;
     config_ptr->progress            = 1;
     config_ptr->injector_frame_rate = 60;
 
@@ -1549,7 +1694,7 @@ void svt_config_dtor(EbConfig *config_ptr) {
     }
 
     if (config_ptr->input_file) {
-        if (!config_ptr->input_file_is_fifo)
+        if (!config_ptr->input_file_is_fifo && !config_ptr->input_shared)
             fclose(config_ptr->input_file);
         config_ptr->input_file = (FILE *)NULL;
     }
@@ -1589,6 +1734,9 @@ void svt_config_dtor(EbConfig *config_ptr) {
         config_ptr->stat_file = (FILE *)NULL;
     }
     free((void *)config_ptr->stats);
+    free(config_ptr->analysis_out);
+    free(config_ptr->analysis_in);
+    free(config_ptr->sub_frame_buffer);
     free(config_ptr);
     return;
 }
@@ -1926,10 +2074,22 @@ EbErrorType handle_stats_file(EbConfig *config, EncPass enc_pass,
                 return EB_ErrorBadParameter;
             }
         }
+        // Streamed stats: the file is read while the first pass writes it, without locking it
+        else if (config->config.rc_stats_stream && config->config.rate_control_mode == 1) {
+            FOPEN(config->input_stat_file, stats, "rb");
+            if (!config->input_stat_file) {
+                fprintf(config->error_log_file,
+                        "Error instance %u: can't read stats file %s for read\n",
+                        channel_number + 1,
+                        stats);
+                return EB_ErrorBadParameter;
+            }
+        }
         break;
     }
 
     case ENC_FIRST_PASS: {
+        config->keep_first_pass_stats = TRUE;
         // for combined two passes,
         // we only ouptut first pass stats when user explicitly set the --stats
         if (config->stats) {
@@ -2015,6 +2175,27 @@ static EbErrorType app_verify_config(EbConfig *config, uint32_t channel_number)
         return_error = EB_ErrorBadParameter;
     }
 
+    if (config->read_ahead < -1 || config->read_ahead > 64) {
+        fprintf(config->error_log_file,
+                "Error instance %u: Invalid read_ahead. read_ahead must be [-1 - 64]\n",
+                channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->read_ahead > 0 && config->buffered_input != -1) {
+        fprintf(config->error_log_file,
+                "Error instance %u: Read ahead is not available with buffered input\n",
+                channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (!config->scaled_width != !config->scaled_height) {
+        fprintf(config->error_log_file,
+                "Error instance %u: Scaled width and height must be set together\n",
+                channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
     if (config->buffered_input > config->frames_to_be_encoded) {
         fprintf(config->error_log_file,
                 "Error instance %u: Invalid buffered_input. buffered_input must be less or equal "
@@ -2812,6 +2993,26 @@ EbErrorType read_command_line(int32_t argc, char *const argv[], EncChannel *chan
         }
     }
 
+    /***************************************************************************************************/
+    /********************** Share the input of the first channel in ladder mode ************************/
+    /***************************************************************************************************/
+    if (channels[0].config->ladder) {
+        EbConfig *leader = channels[0].config;
+        for (index = 1; index < num_channels; ++index) {
+            EbConfig *config = channels[index].config;
+            if (config->input_file) {
+                fprintf(config->error_log_file,
+                        "Error instance %u: The input of the first channel is used with --ladder\n",
+                        index + 1);
+                return EB_ErrorBadParameter;
+            }
+            config->input_file         = leader->input_file;
+            config->input_file_is_fifo = leader->input_file_is_fifo;
+            config->input_shared       = TRUE;
+            channels[index - 1].next_rendition = channels + index;
+        }
+    }
+
     /***************************************************************************************************/
     /********************** Parse parameters from input file if in y4m format **************************/
     /********************** overriding config file and command line inputs    **************************/
@@ -2819,7 +3020,7 @@ EbErrorType read_command_line(int32_t argc, char *const argv[], EncChannel *chan
 
     for (index = 0; index < num_channels; ++index) {
         EncChannel *c = channels + index;
-        if (c->config->y4m_input == TRUE) {
+        if (c->config->y4m_input == TRUE && !c->config->input_shared) {
             ret_y4m = read_y4m_header(c->config);
             if (ret_y4m == EB_ErrorBadParameter) {
                 fprintf(stderr, "Error found when reading the y4m file parameters.\n");
@@ -2827,6 +3028,21 @@ EbErrorType read_command_line(int32_t argc, char *const argv[], EncChannel *chan
             }
         }
     }
+    // The renditions are sent the pictures read for the first channel
+    for (index = 1; index < num_channels; ++index) {
+        EbConfig *config = channels[index].config;
+        if (!config->input_shared)
+            continue;
+        const EbConfig *leader                = channels[0].config;
+        config->y4m_input                     = leader->y4m_input;
+        config->config.source_width           = leader->config.source_width;
+        config->config.source_height          = leader->config.source_height;
+        config->config.encoder_bit_depth      = leader->config.encoder_bit_depth;
+        config->config.encoder_color_format   = leader->config.encoder_color_format;
+        config->config.frame_rate_numerator   = leader->config.frame_rate_numerator;
+        config->config.frame_rate_denominator = leader->config.frame_rate_denominator;
+        config->config.compressed_ten_bit_format = leader->config.compressed_ten_bit_format;
+    }
     /***************************************************************************************************/
     /*******************************   Parse manual prediction structure  ******************************/
     /***************************************************************************************************/
@@ -2860,6 +3076,20 @@ EbErrorType read_command_line(int32_t argc, char *const argv[], EncChannel *chan
                     config->input_padded_height = config->config.source_height;
                 }
 
+                // The library downscales the input pictures to the encoding size
+                if (c->return_error == EB_ErrorNone && config->scaled_width &&
+                    (config->scaled_width != config->config.source_width ||
+                     config->scaled_height != config->config.source_height)) {
+                    config->config.input_picture_width  = config->config.source_width;
+                    config->config.input_picture_height = config->config.source_height;
+                    config->config.source_width         = config->scaled_width;
+                    config->config.source_height        = config->scaled_height;
+                }
+
+                // Renditions encode as many frames as the first channel reads
+                if (c->return_error == EB_ErrorNone && config->input_shared)
+                    config->frames_to_be_encoded = channels[0].config->frames_to_be_encoded;
+
                 // Assuming no errors, set the frames to be encoded to the number of frames in the input yuv
                 if (c->return_error == EB_ErrorNone && config->frames_to_be_encoded == 0)
                     config->frames_to_be_encoded = compute_frames_to_be_encoded(config);
@@ -17,6 +17,7 @@
 #include "EbSvtAv1Enc.h"
 
 typedef struct EbAppContext_ EbAppContext;
+typedef struct InputReader   InputReader;
 
 #ifdef _WIN32
 #define fseeko _fseeki64
@@ -160,6 +161,7 @@ typedef struct EbPerformanceContext {
 
     uint64_t sum_qp;
 
+    double input_stall_time; // time spent waiting for input frames
 } EbPerformanceContext;
 
 typedef struct MemMapFile {
@@ -190,10 +192,19 @@ typedef struct EbConfig {
     const char   *stats;
     FILE         *input_stat_file;
     FILE         *output_stat_file;
+    Bool          keep_first_pass_stats; // kept in memory for the next passes of the run
+    uint64_t      streamed_stats_sent; // streamed first pass stats sent to the encoder
+    Bool          streamed_stats_done; // no more stats in the streamed stats file
+    /* motion analysis export / import */
+    char         *analysis_out;
+    char         *analysis_in;
     FILE         *input_pred_struct_file;
     char         *input_pred_struct_filename;
     Bool          y4m_input;
     unsigned char y4m_buf[9];
+    // The input file belongs to the first channel, which reads the frames for all renditions
+    Bool input_shared;
+    Bool ladder;
 
     uint8_t progress; // 0 = no progress output, 1 = normal, 2 = aomenc style verbose progress
     /****************************************
@@ -203,12 +214,19 @@ typedef struct EbConfig {
 
     uint32_t input_padded_width;
     uint32_t input_padded_height;
+    // Encoding size when the input is downscaled by the library, 0 when not scaled
+    uint32_t scaled_width;
+    uint32_t scaled_height;
     // -1 indicates unknown (auto-detect at earliest opportunity)
     // auto-detect is performed on load for files and at end of stream for pipes
     int64_t   frames_to_be_encoded;
     int32_t   frames_encoded;
     int32_t   buffered_input;
     uint8_t **sequence_buffer;
+    // Frames read ahead of the encoder on a separate thread, -1 is auto
+    int32_t      read_ahead;
+    InputReader *input_reader;
+    uint64_t     read_frame_count; // frames read from the input file
 
     uint32_t injector_frame_rate;
     uint32_t injector;
@@ -227,6 +245,11 @@ typedef struct EbConfig {
 
     uint64_t byte_count_since_ivf;
     uint64_t ivf_count;
+
+    // Sub-frame packets of the frame being output, written once the frame is complete
+    uint8_t *sub_frame_buffer;
+    uint32_t sub_frame_size;
+    uint32_t sub_frame_alloc;
     /****************************************
      * On-the-fly Testing
      ****************************************/
@@ -245,6 +268,7 @@ typedef struct EncChannel {
     AppExitConditionType exit_cond_input; // Processing loop exit condition
     AppExitConditionType exit_cond; // Processing loop exit condition
     Bool                 active;
+    struct EncChannel   *next_rendition; // next channel encoding this channel's input (--ladder)
 } EncChannel;
 
 typedef enum MultiPassModes {
@@ -270,4 +294,6 @@ uint32_t        get_passes(int32_t argc, char *const argv[], EncPass enc_pass[MA
                            MultiPassModes *multi_pass_mode);
 EbErrorType handle_stats_file(EbConfig *config, EncPass pass, const SvtAv1FixedBuf *rc_stats_buffer,
                               uint32_t channel_number);
+// Returns TRUE when the stats file is no longer written by the first pass
+Bool stats_file_released(FILE *file);
 #endif //EbAppConfig_h
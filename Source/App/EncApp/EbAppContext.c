@@ -167,18 +167,41 @@ EbErrorType allocate_input_buffers(EbConfig *config, EbAppContext *callback_data
                   EB_ErrorInsufficientResources);
 
     // Allocate frame buffer for the p_buffer
-    if (config->buffered_input == -1)
+    if (config->buffered_input == -1 && config->read_ahead <= 0 && !config->input_shared)
         allocate_frame_buffer(config, callback_data->input_buffer_pool->p_buffer);
 
     // Assign the variables
     callback_data->input_buffer_pool->p_app_private = NULL;
     callback_data->input_buffer_pool->pic_type      = EB_AV1_INVALID_PICTURE;
 
+    // The frames read ahead are sent from their own buffers
+    if (config->read_ahead > 0) {
+        EB_APP_MALLOC(EbBufferHeaderType *,
+                      callback_data->read_ahead_buffers,
+                      sizeof(EbBufferHeaderType) * config->read_ahead,
+                      EB_N_PTR,
+                      EB_ErrorInsufficientResources);
+        memset(callback_data->read_ahead_buffers,
+               0,
+               sizeof(EbBufferHeaderType) * config->read_ahead);
+        for (int32_t i = 0; i < config->read_ahead; i++) {
+            EbBufferHeaderType *header = &callback_data->read_ahead_buffers[i];
+            header->size               = sizeof(EbBufferHeaderType);
+            header->pic_type           = EB_AV1_INVALID_PICTURE;
+            EB_APP_MALLOC(uint8_t *,
+                          header->p_buffer,
+                          sizeof(EbSvtIOFormat),
+                          EB_N_PTR,
+                          EB_ErrorInsufficientResources);
+            allocate_frame_buffer(config, header->p_buffer);
+        }
+    }
+
     return EB_ErrorNone;
 }
 
 EbErrorType allocate_output_recon_buffers(EbConfig *config, EbAppContext *callback_data) {
-    const size_t luma_size = config->input_padded_width * config->input_padded_height;
+    const size_t luma_size = config->config.source_width * config->config.source_height;
 
     // both u and v
     const size_t chroma_size = luma_size >> (3 - config->config.encoder_color_format);
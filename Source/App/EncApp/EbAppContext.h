@@ -28,6 +28,7 @@ struct EbAppContext_ {
 
     // Buffer Pools
     EbBufferHeaderType *input_buffer_pool;
+    EbBufferHeaderType *read_ahead_buffers; // config->read_ahead input frames
     EbBufferHeaderType *recon_buffer;
 
     // Instance Index
@@ -0,0 +1,209 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+/***************************************
+ * Includes
+ ***************************************/
+#include <stdlib.h>
+#include <string.h>
+
+#include "EbAppInputReader.h"
+#include "EbTime.h"
+
+#ifdef _WIN32
+#include <windows.h>
+typedef CRITICAL_SECTION   ReaderMutex;
+typedef CONDITION_VARIABLE ReaderCond;
+typedef HANDLE             ReaderThread;
+#else
+#include <pthread.h>
+#include <fcntl.h>
+typedef pthread_mutex_t ReaderMutex;
+typedef pthread_cond_t  ReaderCond;
+typedef pthread_t       ReaderThread;
+#endif
+
+void read_input_frames(EbConfig *config, uint8_t is_16bit, EbBufferHeaderType *header_ptr);
+
+struct InputReader {
+    EbConfig           *config;
+    EbBufferHeaderType *frames; // ring of preallocated input buffers
+    uint32_t            depth;
+    uint32_t            head; // oldest frame read
+    uint32_t            count; // frames read and not released yet
+    Bool                eos; // no frame is read after the ones in the ring
+    Bool                stop;
+    ReaderMutex         mutex;
+    ReaderCond          frame_read; // signaled when a frame is added to the ring
+    ReaderCond          frame_released; // signaled when a frame is given back
+    ReaderThread        thread;
+};
+
+#ifdef _WIN32
+static void reader_mutex_init(ReaderMutex *m) { InitializeCriticalSection(m); }
+static void reader_mutex_destroy(ReaderMutex *m) { DeleteCriticalSection(m); }
+static void reader_lock(ReaderMutex *m) { EnterCriticalSection(m); }
+static void reader_unlock(ReaderMutex *m) { LeaveCriticalSection(m); }
+static void reader_cond_init(ReaderCond *c) { InitializeConditionVariable(c); }
+static void reader_cond_destroy(ReaderCond *c) { (void)c; }
+static void reader_wait(ReaderCond *c, ReaderMutex *m) { SleepConditionVariableCS(c, m, INFINITE); }
+static void reader_signal(ReaderCond *c) { WakeConditionVariable(c); }
+#else
+static void reader_mutex_init(ReaderMutex *m) { pthread_mutex_init(m, NULL); }
+static void reader_mutex_destroy(ReaderMutex *m) { pthread_mutex_destroy(m); }
+static void reader_lock(ReaderMutex *m) { pthread_mutex_lock(m); }
+static void reader_unlock(ReaderMutex *m) { pthread_mutex_unlock(m); }
+static void reader_cond_init(ReaderCond *c) { pthread_cond_init(c, NULL); }
+static void reader_cond_destroy(ReaderCond *c) { pthread_cond_destroy(c); }
+static void reader_wait(ReaderCond *c, ReaderMutex *m) { pthread_cond_wait(c, m); }
+static void reader_signal(ReaderCond *c) { pthread_cond_signal(c); }
+#endif
+
+/************************************
+ * input_reader_kernel
+ *   Reads frames into the free entries of the ring until the number of
+ *   frames to encode is reached, the end of a pipe is reached or the
+ *   reader is stopped.
+ ************************************/
+static void input_reader_kernel(InputReader *reader) {
+    EbConfig      *config      = reader->config;
+    const uint8_t  is_16bit    = (uint8_t)(config->config.encoder_bit_depth > 8);
+    const Bool     is_pipe     = config->input_file == stdin || config->input_file_is_fifo;
+    const int64_t  frame_count = config->frames_to_be_encoded;
+    int64_t        frames_read = 0;
+    Bool           empty_read  = FALSE; // the last read got no data
+
+    for (;;) {
+        reader_lock(&reader->mutex);
+        while (reader->count == reader->depth && !reader->stop)
+            reader_wait(&reader->frame_released, &reader->mutex);
+        const Bool stop = reader->stop;
+        // The entry after the last frame read is only touched by this thread until it is counted
+        EbBufferHeaderType *frame = &reader->frames[(reader->head + reader->count) % reader->depth];
+        reader_unlock(&reader->mutex);
+        if (stop)
+            break;
+
+        Bool eos = frame_count >= 0 && frames_read == frame_count;
+        if (!eos) {
+            read_input_frames(config, is_16bit, frame);
+            // At the end of a regular file, the next read loops back to its start. A read
+            // that gets nothing again (empty or truncated file, read error) ends the input.
+            if (!frame->n_filled_len && !is_pipe && !empty_read && !ferror(config->input_file)) {
+                empty_read = TRUE;
+                continue;
+            }
+            empty_read = FALSE;
+            eos        = !frame->n_filled_len;
+        }
+
+        reader_lock(&reader->mutex);
+        if (eos)
+            reader->eos = TRUE;
+        else {
+            frames_read++;
+            reader->count++;
+        }
+        reader_signal(&reader->frame_read);
+        reader_unlock(&reader->mutex);
+        if (eos)
+            break;
+    }
+}
+
+#ifdef _WIN32
+static DWORD WINAPI input_reader_thread(LPVOID arg) {
+    input_reader_kernel((InputReader *)arg);
+    return 0;
+}
+#else
+static void *input_reader_thread(void *arg) {
+    input_reader_kernel((InputReader *)arg);
+    return NULL;
+}
+#endif
+
+EbErrorType input_reader_start(InputReader **reader_ptr, EbConfig *config,
+                               EbBufferHeaderType *frames, uint32_t depth) {
+    InputReader *reader = (InputReader *)calloc(1, sizeof(InputReader));
+    if (!reader)
+        return EB_ErrorInsufficientResources;
+    reader->config = config;
+    reader->frames = frames;
+    reader->depth  = depth;
+    reader_mutex_init(&reader->mutex);
+    reader_cond_init(&reader->frame_read);
+    reader_cond_init(&reader->frame_released);
+
+#if !defined(_WIN32) && defined(POSIX_FADV_SEQUENTIAL)
+    // Let the kernel read further ahead of the file position
+    if (config->input_file != stdin && !config->input_file_is_fifo)
+        posix_fadvise(fileno(config->input_file), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+#ifdef _WIN32
+    reader->thread = CreateThread(NULL, 0, input_reader_thread, reader, 0, NULL);
+    const Bool created = reader->thread != NULL;
+#else
+    const Bool created = pthread_create(&reader->thread, NULL, input_reader_thread, reader) == 0;
+#endif
+    if (!created) {
+        reader_cond_destroy(&reader->frame_released);
+        reader_cond_destroy(&reader->frame_read);
+        reader_mutex_destroy(&reader->mutex);
+        free(reader);
+        return EB_ErrorInsufficientResources;
+    }
+    *reader_ptr = reader;
+    return EB_ErrorNone;
+}
+
+EbBufferHeaderType *input_reader_get_frame(InputReader *reader) {
+    EbBufferHeaderType *frame = NULL;
+    uint64_t            start_seconds, start_useconds, finish_seconds, finish_useconds;
+
+    app_svt_av1_get_time(&start_seconds, &start_useconds);
+    reader_lock(&reader->mutex);
+    while (!reader->count && !reader->eos) reader_wait(&reader->frame_read, &reader->mutex);
+    if (reader->count)
+        frame = &reader->frames[reader->head];
+    reader_unlock(&reader->mutex);
+    app_svt_av1_get_time(&finish_seconds, &finish_useconds);
+
+    reader->config->performance_context.input_stall_time += app_svt_av1_compute_overall_elapsed_time(
+        start_seconds, start_useconds, finish_seconds, finish_useconds);
+    return frame;
+}
+
+void input_reader_release_frame(InputReader *reader) {
+    reader_lock(&reader->mutex);
+    reader->head = (reader->head + 1) % reader->depth;
+    reader->count--;
+    reader_signal(&reader->frame_released);
+    reader_unlock(&reader->mutex);
+}
+
+void input_reader_stop(InputReader *reader) {
+    reader_lock(&reader->mutex);
+    reader->stop = TRUE;
+    reader_signal(&reader->frame_released);
+    reader_unlock(&reader->mutex);
+#ifdef _WIN32
+    WaitForSingleObject(reader->thread, INFINITE);
+    CloseHandle(reader->thread);
+#else
+    pthread_join(reader->thread, NULL);
+#endif
+    reader_cond_destroy(&reader->frame_released);
+    reader_cond_destroy(&reader->frame_read);
+    reader_mutex_destroy(&reader->mutex);
+    free(reader);
+}
@@ -0,0 +1,36 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbAppInputReader_h
+#define EbAppInputReader_h
+
+#include "EbAppConfig.h"
+
+// Number of frames read ahead when the input is neither memory mapped nor preloaded
+#define DEFAULT_READ_AHEAD 4
+
+/* Reads the input file on its own thread into a ring of frames, so that a slow
+ * input (pipe, network file system) is read while the encoder is busy. */
+EbErrorType input_reader_start(InputReader **reader_ptr, EbConfig *config,
+                               EbBufferHeaderType *frames, uint32_t depth);
+
+/* Waits for the next frame read from the input and returns it, or NULL once
+ * all the frames were returned. The time spent waiting is added to the input
+ * stall time of the channel. */
+EbBufferHeaderType *input_reader_get_frame(InputReader *reader);
+
+/* Gives the frame returned by input_reader_get_frame() back to the reader. */
+void input_reader_release_frame(InputReader *reader);
+
+/* Stops the reader thread and frees the reader. */
+void input_reader_stop(InputReader *reader);
+
+#endif // EbAppInputReader_h
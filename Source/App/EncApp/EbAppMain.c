@@ -28,6 +28,7 @@
 #include <string.h>
 #include "EbAppConfig.h"
 #include "EbAppContext.h"
+#include "EbAppInputReader.h"
 #include "EbTime.h"
 #ifdef _WIN32
 #include <windows.h>
@@ -58,6 +59,7 @@ int tot_frames_done = 0;
  * External Functions
  ***************************************/
 void process_input_buffer(EncChannel* c);
+void end_renditions(EncChannel* c);
 
 void process_output_recon_buffer(EncChannel* c);
 
@@ -104,8 +106,17 @@ void init_memory_file_map(EbConfig* config) {
     config->mmap.enable = (config->buffered_input == -1) ? 1 : 0;
 #endif
 
-    if (config->input_file == stdin || config->input_file_is_fifo)
+    if (config->input_file == stdin || config->input_file_is_fifo || config->read_ahead > 0 ||
+        config->input_shared)
         config->mmap.enable = 0;
+    // Renditions do not read, the first channel sends them its pictures
+    if (config->input_shared)
+        config->read_ahead = 0;
+    // Read ahead on a separate thread when the input is neither mapped nor preloaded
+    if (config->read_ahead == -1)
+        config->read_ahead = (config->buffered_input == -1 && !config->mmap.enable)
+            ? DEFAULT_READ_AHEAD
+            : 0;
 
     if (config->mmap.enable) {
         if (config->input_file) {
@@ -188,10 +199,24 @@ static EbErrorType enc_context_ctor(EncApp* enc_app, EncContext* enc_context, in
             if (c->return_error == EB_ErrorNone) {
                 c->return_error = init_encoder(config, c->app_callback, inst_cnt);
             }
+            if (c->return_error == EB_ErrorNone && config->read_ahead > 0)
+                c->return_error = input_reader_start(&config->input_reader,
+                                                     config,
+                                                     c->app_callback->read_ahead_buffers,
+                                                     config->read_ahead);
             return_error = (EbErrorType)(return_error | c->return_error);
         } else
             c->active = FALSE;
     }
+    // Renditions cannot run without the channel reading their input
+    for (uint32_t inst_cnt = 1; inst_cnt < num_channels; ++inst_cnt) {
+        EncChannel* c = enc_context->channels + inst_cnt;
+        if (c->config->input_shared && enc_context->channels[0].return_error != EB_ErrorNone &&
+            c->return_error == EB_ErrorNone) {
+            c->return_error = EB_ErrorBadParameter;
+            return_error    = EB_ErrorBadParameter;
+        }
+    }
     return return_error;
 }
 
@@ -199,6 +224,8 @@ static void enc_context_dctor(EncContext* enc_context) {
     // DeInit Encoder
     for (int32_t inst_cnt = enc_context->num_channels - 1; inst_cnt >= 0; --inst_cnt) {
         EncChannel* c = enc_context->channels + inst_cnt;
+        if (c->config && c->config->input_reader)
+            input_reader_stop(c->config->input_reader);
         enc_channel_dctor(c, inst_cnt);
     }
 
@@ -327,13 +354,14 @@ static void print_performance(const EncContext* const enc_context) {
                     fprintf(stderr,
                             "\nChannel %u\nAverage Speed:\t\t%.3f fps\nTotal Encoding Time:\t%.0f "
                             "ms\nTotal Execution Time:\t%.0f ms\nAverage Latency:\t%.0f ms\nMax "
-                            "Latency:\t\t%u ms\n",
+                            "Latency:\t\t%u ms\nInput Stall Time:\t%.0f ms\n",
                             (uint32_t)(inst_cnt + 1),
                             config->performance_context.average_speed,
                             config->performance_context.total_encode_time * 1000,
                             config->performance_context.total_execution_time * 1000,
                             config->performance_context.average_latency,
-                            (uint32_t)(config->performance_context.max_latency));
+                            (uint32_t)(config->performance_context.max_latency),
+                            config->performance_context.input_stall_time * 1000);
             } else
                 fprintf(stderr, "\nChannel %u Encoding Interrupted\n", (uint32_t)(inst_cnt + 1));
         } else if (c->return_error == EB_ErrorInsufficientResources)
@@ -380,6 +408,8 @@ static void enc_channel_step(EncChannel* c, EncApp* enc_app, EncContext* enc_con
          c->exit_cond_output == APP_ExitConditionError ||
          c->exit_cond_input == APP_ExitConditionError)) {
         c->active = FALSE;
+        // the renditions of this channel get no more pictures
+        end_renditions(c);
         if (config->recon_file)
             c->exit_cond = (AppExitConditionType)(c->exit_cond_recon | c->exit_cond_output |
                                                   c->exit_cond_input);
@@ -21,6 +21,7 @@
 #include "EbAppConfig.h"
 #include "EbSvtAv1ErrorCodes.h"
 #include "EbAppInputy4m.h"
+#include "EbAppInputReader.h"
 #include "EbTime.h"
 
 #ifndef _WIN32
@@ -198,7 +199,7 @@ void read_input_frames(EbConfig *config, uint8_t is_16bit, EbBufferHeaderType *h
             header_ptr->n_filled_len = 0;
 
             if (config->mmap.enable) {
-                if (config->y4m_input == TRUE && config->processed_frame_count == 0) {
+                if (config->y4m_input == TRUE && config->read_frame_count == 0) {
                     read_and_compute_y4m_frame_delimiter(
                         config->input_file, config->error_log_file, &config->mmap.y4m_frm_hdr);
                 }
@@ -211,7 +212,7 @@ void read_input_frames(EbConfig *config, uint8_t is_16bit, EbBufferHeaderType *h
                 << is_16bit;
             uint32_t chroma_read_size = ((uint32_t)luma_read_size >> (3 - color_format));
             uint8_t *eb_input_ptr     = input_ptr->luma;
-            if (!config->y4m_input && config->processed_frame_count == 0 &&
+            if (!config->y4m_input && config->read_frame_count == 0 &&
                 (config->input_file == stdin || config->input_file_is_fifo)) {
                 /* 9 bytes were already buffered during the the YUV4MPEG2 header probe */
                 memcpy(eb_input_ptr, config->y4m_buf, YUV4MPEG2_IND_SIZE);
@@ -375,8 +376,7 @@ void read_input_frames(EbConfig *config, uint8_t is_16bit, EbBufferHeaderType *h
 
         if (feof(input_file) != 0) {
             if ((input_file == stdin) || (config->input_file_is_fifo)) {
-                //for a fifo, we only know this when we reach eof
-                config->frames_to_be_encoded = config->frames_encoded;
+                //for a fifo, we only know this when we reach eof, see process_input_buffer()
                 if (header_ptr->n_filled_len != read_size) {
                     // not a completed frame
                     header_ptr->n_filled_len = 0;
@@ -444,6 +444,8 @@ void read_input_frames(EbConfig *config, uint8_t is_16bit, EbBufferHeaderType *h
             header_ptr->n_filled_len = (uint32_t)(luma_size + 2 * chroma_size);
         }
     }
+    if (header_ptr->n_filled_len)
+        config->read_frame_count++;
 
     return;
 }
@@ -521,6 +523,110 @@ static void injector(uint64_t processed_frame_count, uint32_t injector_frame_rat
     }
 }
 
+// Sends the streamed first pass stats of the pictures up to frames, waiting for the first pass
+// running concurrently to write them
+static void send_streamed_stats(EbConfig *config, EbComponentType *component_handle,
+                                uint64_t frames) {
+    FILE    *file      = config->input_stat_file;
+    uint64_t stat_size = 0;
+    svt_av1_enc_get_stream_info(
+        component_handle, SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_SIZE, &stat_size);
+    uint8_t *stat = (uint8_t *)malloc((size_t)stat_size);
+    if (!stat)
+        return;
+    Bool released = FALSE;
+    while (!config->streamed_stats_done && config->streamed_stats_sent < frames) {
+        const long pos = ftell(file);
+        if (fread(stat, 1, (size_t)stat_size, file) == stat_size) {
+            SvtAv1FixedBuf stats = {stat, stat_size};
+            if (svt_av1_enc_send_stats(component_handle, &stats) != EB_ErrorNone) {
+                // the queue of the encoder is full, sent again with the next picture
+                fseek(file, pos, SEEK_SET);
+                break;
+            }
+            config->streamed_stats_sent++;
+            continue;
+        }
+        // the first pass has not written the stats yet, done when it released the file
+        clearerr(file);
+        fseek(file, pos, SEEK_SET);
+        if (released) {
+            fprintf(config->error_log_file,
+                    "Warning: no first pass stats past picture %llu\n",
+                    (unsigned long long)config->streamed_stats_sent);
+            config->streamed_stats_done = TRUE;
+        } else if (stats_file_released(file))
+            released = TRUE;
+        else
+            app_svt_av1_sleep(10);
+    }
+    free(stat);
+}
+
+static void send_input_frame(EbConfig *config, EbComponentType *component_handle,
+                             EbBufferHeaderType *header_ptr) {
+    // Update the context parameters
+    config->processed_byte_count += header_ptr->n_filled_len;
+    header_ptr->p_app_private = (EbPtr)NULL;
+
+    config->mmap.file_frame_it++;
+    config->frames_encoded = (int32_t)(++config->processed_frame_count);
+
+    // Configuration parameters changed on the fly
+    if (config->config.use_qp_file && config->qp_file)
+        header_ptr->qp = send_qp_on_the_fly(config->qp_file, &config->config.use_qp_file);
+
+    if (keep_running == 0 && !config->stop_encoder)
+        config->stop_encoder = TRUE;
+    // Fill in Buffers Header control data
+    header_ptr->pts      = config->processed_frame_count - 1;
+    header_ptr->pic_type = EB_AV1_INVALID_PICTURE;
+    header_ptr->flags    = 0;
+    header_ptr->metadata = NULL;
+    // The stats of a picture are sent before it
+    if (config->config.rc_stats_stream && config->input_stat_file)
+        send_streamed_stats(config, component_handle, config->processed_frame_count);
+    // Send the picture
+    svt_av1_enc_send_picture(component_handle, header_ptr);
+}
+
+static void send_eos(EbComponentType *component_handle, EbBufferHeaderType *header_ptr) {
+    header_ptr->n_alloc_len   = 0;
+    header_ptr->n_filled_len  = 0;
+    header_ptr->n_tick_count  = 0;
+    header_ptr->p_app_private = NULL;
+    header_ptr->flags         = EB_BUFFERFLAG_EOS;
+    header_ptr->p_buffer      = NULL;
+    header_ptr->pic_type      = EB_AV1_INVALID_PICTURE;
+    header_ptr->metadata      = NULL;
+    svt_av1_enc_send_picture(component_handle, header_ptr);
+}
+
+// Send the picture read for the first channel to the channels encoding its renditions
+static void send_renditions(EncChannel *channel, EbBufferHeaderType *header_ptr) {
+    for (EncChannel *r = channel->next_rendition; r; r = r->next_rendition) {
+        if (r->exit_cond_input != APP_ExitConditionNone)
+            continue;
+        send_input_frame(
+            r->config, (EbComponentType *)r->app_callback->svt_encoder_handle, header_ptr);
+    }
+}
+
+// Send the end of stream to the renditions once the first channel stops reading
+void end_renditions(EncChannel *channel) {
+    for (EncChannel *r = channel->next_rendition; r; r = r->next_rendition) {
+        if (r->exit_cond_input != APP_ExitConditionNone)
+            continue;
+        if (!r->config->stop_encoder)
+            r->config->frames_to_be_encoded = r->config->frames_encoded;
+        EbBufferHeaderType eos_header;
+        memset(&eos_header, 0, sizeof(eos_header));
+        eos_header.size = sizeof(eos_header);
+        send_eos((EbComponentType *)r->app_callback->svt_encoder_handle, &eos_header);
+        r->exit_cond_input = APP_ExitConditionFinished;
+    }
+}
+
 //************************************/
 // process_input_buffer
 // Reads yuv frames from file and copy
@@ -546,7 +652,8 @@ void process_input_buffer(EncChannel *channel) {
                    2 * ((input_padded_width * input_padded_width) >> (3 - color_format)));
     compressed10bit_frame_size += compressed10bit_frame_size / 4;
 
-    if (channel->exit_cond_input != APP_ExitConditionNone)
+    // The renditions are fed by the first channel
+    if (channel->exit_cond_input != APP_ExitConditionNone || config->input_shared)
         return;
     if (config->injector && config->processed_frame_count)
         injector(config->processed_frame_count, config->injector_frame_rate);
@@ -561,46 +668,54 @@ void process_input_buffer(EncChannel *channel) {
         ? -1
         : total_bytes_to_process_count - (int64_t)config->processed_byte_count;
 
+    // With read ahead, the frames come from the reader thread which knows when to stop
+    if (config->input_reader) {
+        EbBufferHeaderType *frame = config->stop_encoder
+            ? NULL
+            : input_reader_get_frame(config->input_reader);
+        if (frame) {
+            send_input_frame(config, component_handle, frame);
+            send_renditions(channel, frame);
+            input_reader_release_frame(config->input_reader);
+        } else if (!config->stop_encoder)
+            config->frames_to_be_encoded = config->frames_encoded;
+
+        if (!frame || config->processed_frame_count == (uint64_t)config->frames_to_be_encoded ||
+            config->stop_encoder) {
+            EbBufferHeaderType eos_header;
+            memset(&eos_header, 0, sizeof(eos_header));
+            eos_header.size = sizeof(eos_header);
+            send_eos(component_handle, &eos_header);
+            end_renditions(channel);
+            return_value = APP_ExitConditionFinished;
+        }
+        channel->exit_cond_input = return_value;
+        return;
+    }
+
     // If there are bytes left to encode, configure the header
     if (remaining_byte_count != 0 && config->stop_encoder == FALSE) {
+        uint64_t start_seconds, start_useconds, finish_seconds, finish_useconds;
+        app_svt_av1_get_time(&start_seconds, &start_useconds);
         read_input_frames(config, is_16bit, header_ptr);
+        app_svt_av1_get_time(&finish_seconds, &finish_useconds);
+        config->performance_context.input_stall_time += app_svt_av1_compute_overall_elapsed_time(
+            start_seconds, start_useconds, finish_seconds, finish_useconds);
+
         if (header_ptr->n_filled_len) {
-            // Update the context parameters
-            config->processed_byte_count += header_ptr->n_filled_len;
-            header_ptr->p_app_private = (EbPtr)NULL;
-
-            config->mmap.file_frame_it++;
-            config->frames_encoded = (int32_t)(++config->processed_frame_count);
-
-            // Configuration parameters changed on the fly
-            if (config->config.use_qp_file && config->qp_file)
-                header_ptr->qp = send_qp_on_the_fly(config->qp_file, &config->config.use_qp_file);
-
-            if (keep_running == 0 && !config->stop_encoder)
-                config->stop_encoder = TRUE;
-            // Fill in Buffers Header control data
-            header_ptr->pts      = config->processed_frame_count - 1;
-            header_ptr->pic_type = EB_AV1_INVALID_PICTURE;
-            header_ptr->flags    = 0;
-            header_ptr->metadata = NULL;
-            // Send the picture
-            svt_av1_enc_send_picture(component_handle, header_ptr);
+            send_input_frame(config, component_handle, header_ptr);
+            send_renditions(channel, header_ptr);
 
             if (config->mmap.enable)
                 release_memory_mapped_file(config, is_16bit, header_ptr);
-        }
+        } else if (config->input_file == stdin || config->input_file_is_fifo)
+            //for a fifo, we only know this when we reach eof
+            config->frames_to_be_encoded = config->frames_encoded;
 
         if ((config->processed_frame_count == (uint64_t)config->frames_to_be_encoded) ||
             config->stop_encoder) {
-            header_ptr->n_alloc_len   = 0;
-            header_ptr->n_filled_len  = 0;
-            header_ptr->n_tick_count  = 0;
-            header_ptr->p_app_private = NULL;
-            header_ptr->flags         = EB_BUFFERFLAG_EOS;
-            header_ptr->p_buffer      = NULL;
-            header_ptr->pic_type      = EB_AV1_INVALID_PICTURE;
-            header_ptr->metadata      = NULL;
-            svt_av1_enc_send_picture(component_handle, header_ptr);
+            send_eos(component_handle, header_ptr);
+            end_renditions(channel);
         }
 
         return_value = (header_ptr->flags == EB_BUFFERFLAG_EOS) ? APP_ExitConditionFinished
@@ -644,8 +759,8 @@ static void write_ivf_stream_header(EbConfig *config) {
     mem_put_le16(header + 4, 0); // version
     mem_put_le16(header + 6, 32); // header size
     mem_put_le32(header + 8, AV1_FOURCC); // fourcc
-    mem_put_le16(header + 12, config->input_padded_width); // width
-    mem_put_le16(header + 14, config->input_padded_height); // height
+    mem_put_le16(header + 12, config->config.source_width); // width
+    mem_put_le16(header + 14, config->config.source_height); // height
     mem_put_le32(header + 16, config->config.frame_rate_numerator); // rate
     mem_put_le32(header + 20, config->config.frame_rate_denominator); // scale
     mem_put_le32(header + 24, 0); // length
@@ -753,6 +868,31 @@ void process_output_statistics_buffer(EbBufferHeaderType *header_ptr, EbConfig *
     return;
 }
 
+// Appends the first pass stats produced since the previous packet to the stats file, and to the
+// stats of the next passes of the run
+static void write_first_pass_stats(EbConfig *config, EncApp *enc_app,
+                                   EbComponentType *component_handle) {
+    SvtAv1FixedBuf first_pass_stat;
+    if (svt_av1_enc_get_stream_info(component_handle,
+                                    SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_NEW,
+                                    &first_pass_stat) != EB_ErrorNone ||
+        !first_pass_stat.sz)
+        return;
+    if (config->output_stat_file) {
+        fwrite(first_pass_stat.buf, 1, first_pass_stat.sz, config->output_stat_file);
+        fflush(config->output_stat_file);
+    }
+    if (config->keep_first_pass_stats) {
+        uint8_t *buf = (uint8_t *)realloc(enc_app->rc_twopasses_stats.buf,
+                                          enc_app->rc_twopasses_stats.sz + first_pass_stat.sz);
+        if (buf) {
+            memcpy(buf + enc_app->rc_twopasses_stats.sz, first_pass_stat.buf, first_pass_stat.sz);
+            enc_app->rc_twopasses_stats.buf = buf;
+            enc_app->rc_twopasses_stats.sz += first_pass_stat.sz;
+        }
+    }
+}
+
 void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t *frame_count) {
     EbConfig            *config        = channel->config;
     EbAppContext        *app_call_back = channel->app_callback;
@@ -789,7 +929,30 @@ void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t
             return;
         } else if (stream_status != EB_NoErrorEmptyQueue) {
             uint32_t flags = header_ptr->flags;
-            is_alt_ref     = (flags & EB_BUFFERFLAG_IS_ALT_REF);
+            if (flags & EB_BUFFERFLAG_PARTIAL) {
+                // Hold sub-frame packets until the frame is complete, ivf stores whole frames
+                uint32_t size = config->sub_frame_size + header_ptr->n_filled_len;
+                if (size > config->sub_frame_alloc) {
+                    uint8_t *buf = (uint8_t *)realloc(config->sub_frame_buffer, size);
+                    if (!buf) {
+                        fprintf(config->error_log_file, "Error: sub-frame buffer allocation failed\n");
+                        svt_av1_enc_release_out_buffer(&header_ptr);
+                        channel->exit_cond_output = APP_ExitConditionError;
+                        return;
+                    }
+                    config->sub_frame_buffer = buf;
+                    config->sub_frame_alloc  = size;
+                }
+                memcpy(config->sub_frame_buffer + config->sub_frame_size,
+                       header_ptr->p_buffer,
+                       header_ptr->n_filled_len);
+                config->sub_frame_size = size;
+                svt_av1_enc_release_out_buffer(&header_ptr);
+                // the rest of the frame follows
+                is_alt_ref = 1;
+                continue;
+            }
+            is_alt_ref = (flags & EB_BUFFERFLAG_IS_ALT_REF);
             if (!(flags & EB_BUFFERFLAG_IS_ALT_REF))
                 ++(config->performance_context.frame_count);
             *total_latency += (uint64_t)header_ptr->n_tick_count;
@@ -820,11 +983,14 @@ void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t
                     !(flags & EB_BUFFERFLAG_IS_ALT_REF)) {
                     write_ivf_stream_header(config);
                 }
-                write_ivf_frame_header(config, header_ptr->n_filled_len);
+                write_ivf_frame_header(config, config->sub_frame_size + header_ptr->n_filled_len);
+                fwrite(config->sub_frame_buffer, 1, config->sub_frame_size, stream_file);
                 fwrite(header_ptr->p_buffer, 1, header_ptr->n_filled_len, stream_file);
             }
 
-            config->performance_context.byte_count += header_ptr->n_filled_len;
+            config->performance_context.byte_count += config->sub_frame_size +
+                header_ptr->n_filled_len;
+            config->sub_frame_size = 0;
 
             if (config->config.stat_report && !(flags & EB_BUFFERFLAG_IS_ALT_REF))
                 process_output_statistics_buffer(header_ptr, config);
@@ -835,31 +1001,12 @@ void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t
                                                        : APP_ExitConditionNone;
             // Release the output buffer
             svt_av1_enc_release_out_buffer(&header_ptr);
+            // The first pass stats are written as they are produced, so that the final pass can
+            // read them while the first pass runs
+            if (config->config.pass == ENC_FIRST_PASS)
+                write_first_pass_stats(config, enc_app, component_handle);
 
             if (flags & EB_BUFFERFLAG_EOS) {
-                if (config->config.pass == ENC_FIRST_PASS) {
-                    SvtAv1FixedBuf first_pass_stat;
-                    EbErrorType    ret = svt_av1_enc_get_stream_info(
-                        component_handle,
-                        SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_OUT,
-                        &first_pass_stat);
-                    if (ret == EB_ErrorNone) {
-                        if (config->output_stat_file) {
-                            fwrite(first_pass_stat.buf,
-                                   1,
-                                   first_pass_stat.sz,
-                                   config->output_stat_file);
-                        }
-                        enc_app->rc_twopasses_stats.buf = realloc(enc_app->rc_twopasses_stats.buf,
-                                                                  first_pass_stat.sz);
-                        if (enc_app->rc_twopasses_stats.buf) {
-                            memcpy(enc_app->rc_twopasses_stats.buf,
-                                   first_pass_stat.buf,
-                                   first_pass_stat.sz);
-                            enc_app->rc_twopasses_stats.sz = first_pass_stat.sz;
-                        }
-                    }
-                }
                 if (config->config.pass == ENC_SECOND_PASS) {
                     if (config->output_stat_file && config->config.rc_stats_buffer.buf) {
                         fwrite(config->config.rc_stats_buffer.buf,
@@ -780,6 +780,119 @@ static INLINE void row_store_32x2xh(const __m256i *r0, const __m256i *r1, int32_
         dst += stride;
     }
 }
+
+// Each row is a broadcast of its left sample
+static INLINE void h_predictor_32xh(uint8_t *dst, ptrdiff_t stride, const uint8_t *left,
+                                    int32_t height) {
+    for (int32_t i = 0; i < height; ++i) {
+        _mm256_storeu_si256((__m256i *)dst, _mm256_set1_epi8((char)left[i]));
+        dst += stride;
+    }
+}
+
+static INLINE void h_predictor_64xh(uint8_t *dst, ptrdiff_t stride, const uint8_t *left,
+                                    int32_t height) {
+    for (int32_t i = 0; i < height; ++i) {
+        const __m256i row = _mm256_set1_epi8((char)left[i]);
+        _mm256_storeu_si256((__m256i *)dst, row);
+        _mm256_storeu_si256((__m256i *)(dst + 32), row);
+        dst += stride;
+    }
+}
+
+void svt_aom_h_predictor_32x8_avx2(uint8_t *dst, ptrdiff_t stride, const uint8_t *above,
+                                   const uint8_t *left) {
+    (void)above;
+    h_predictor_32xh(dst, stride, left, 8);
+}
+
+void svt_aom_h_predictor_32x16_avx2(uint8_t *dst, ptrdiff_t stride, const uint8_t *above,
+                                    const uint8_t *left) {
+    (void)above;
+    h_predictor_32xh(dst, stride, left, 16);
+}
+
+void svt_aom_h_predictor_32x64_avx2(uint8_t *dst, ptrdiff_t stride, const uint8_t *above,
+                                    const uint8_t *left) {
+    (void)above;
+    h_predictor_32xh(dst, stride, left, 64);
+}
+
+void svt_aom_h_predictor_64x16_avx2(uint8_t *dst, ptrdiff_t stride, const uint8_t *above,
+                                    const uint8_t *left) {
+    (void)above;
+    h_predictor_64xh(dst, stride, left, 16);
+}
+
+void svt_aom_h_predictor_64x32_avx2(uint8_t *dst, ptrdiff_t stride, const uint8_t *above,
+                                    const uint8_t *left) {
+    (void)above;
+    h_predictor_64xh(dst, stride, left, 32);
+}
+
+void svt_aom_h_predictor_64x64_avx2(uint8_t *dst, ptrdiff_t stride, const uint8_t *above,
+                                    const uint8_t *left) {
+    (void)above;
+    h_predictor_64xh(dst, stride, left, 64);
+}
+
+void svt_aom_v_predictor_32x8_avx2(uint8_t *dst, ptrdiff_t stride, const uint8_t *above,
+                                   const uint8_t *left) {
+    const __m256i row = _mm256_loadu_si256((const __m256i *)above);
+    (void)left;
+    row_store_32xh(&row, 8, dst, stride);
+}
+
+static INLINE __m128i dc_sum_8_sse2(const uint8_t *ref) {
+    const __m128i x = _mm_loadl_epi64((__m128i const *)ref);
+    return _mm_sad_epu8(x, _mm_setzero_si128());
+}
+
+void svt_aom_dc_predictor_32x8_avx2(uint8_t *dst, ptrdiff_t stride, const uint8_t *above,
+                                    const uint8_t *left) {
+    const __m128i top_sum  = dc_sum_32_sse2(above);
+    const __m128i left_sum = dc_sum_8_sse2(left);
+    uint32_t      sum      = _mm_cvtsi128_si32(_mm_add_epi16(top_sum, left_sum));
+    sum += 20;
+    sum /= 40;
+    const __m256i row = _mm256_set1_epi8((uint8_t)sum);
+    row_store_32xh(&row, 8, dst, stride);
+}
+
+void svt_aom_dc_top_predictor_32x8_avx2(uint8_t *dst, ptrdiff_t stride, const uint8_t *above,
+                                        const uint8_t *left) {
+    __m256i sum = dc_sum_32(above);
+    (void)left;
+
+    const __m256i sixteen = _mm256_set1_epi16(16);
+    sum                   = _mm256_add_epi16(sum, sixteen);
+    sum                   = _mm256_srai_epi16(sum, 5);
+    const __m256i zero    = _mm256_setzero_si256();
+    __m256i       row     = _mm256_shuffle_epi8(sum, zero);
+    row_store_32xh(&row, 8, dst, stride);
+}
+
+void svt_aom_dc_left_predictor_32x8_avx2(uint8_t *dst, ptrdiff_t stride, const uint8_t *above,
+                                         const uint8_t *left) {
+    __m128i sum = dc_sum_8_sse2(left);
+    (void)above;
+
+    const __m128i four = _mm_set1_epi16(4);
+    sum                = _mm_add_epi16(sum, four);
+    sum                = _mm_srai_epi16(sum, 3);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i r    = _mm_shuffle_epi8(sum, zero);
+    const __m256i row  = _mm256_inserti128_si256(_mm256_castsi128_si256(r), r, 1);
+    row_store_32xh(&row, 8, dst, stride);
+}
+
+void svt_aom_dc_128_predictor_32x8_avx2(uint8_t *dst, ptrdiff_t stride, const uint8_t *above,
+                                        const uint8_t *left) {
+    (void)above;
+    (void)left;
+    const __m256i row = _mm256_set1_epi8((uint8_t)0x80);
+    row_store_32xh(&row, 8, dst, stride);
+}
 void svt_aom_v_predictor_64x64_avx2(uint8_t *dst, ptrdiff_t stride, const uint8_t *above,
                                     const uint8_t *left) {
     const __m256i row0 = _mm256_loadu_si256((const __m256i *)above);
@@ -5090,3 +5203,102 @@ void svt_aom_highbd_paeth_predictor_4x16_avx2(uint16_t *dst, ptrdiff_t stride,
         dst += 4 * stride;
     }
 }
+
+// The outer, inner and center taps of the intra edge filter of each strength
+static const int16_t intra_edge_kernel[3][3] = {{0, 4, 8}, {0, 5, 6}, {2, 4, 4}};
+
+// 16 filtered samples, x[t] holding the samples at the offset t of the 5 taps,
+// the outer taps being used by the strength 3 only
+static INLINE __m256i filter_intra_edge_16(const __m256i x[5], const __m256i k[3],
+                                           int32_t five_taps) {
+    __m256i s = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_add_epi16(x[1], x[3]), k[1]),
+                                 _mm256_mullo_epi16(x[2], k[2]));
+    if (five_taps)
+        s = _mm256_add_epi16(s, _mm256_mullo_epi16(_mm256_add_epi16(x[0], x[4]), k[0]));
+    // the sum of at most 16 times a 12 bit sample fits in 16 unsigned bits
+    return _mm256_srli_epi16(_mm256_add_epi16(s, _mm256_set1_epi16(8)), 4);
+}
+
+static INLINE void load_intra_edge_taps(const uint8_t *p, int32_t five_taps, __m256i x[5]) {
+    for (int32_t t = !five_taps; t < 5 - !five_taps; t++)
+        x[t] = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(p - 2 + t)));
+}
+
+static INLINE void load_intra_edge_taps_high(const uint16_t *p, int32_t five_taps,
+                                             __m256i x[5]) {
+    for (int32_t t = !five_taps; t < 5 - !five_taps; t++)
+        x[t] = _mm256_loadu_si256((const __m256i *)(p - 2 + t));
+}
+
+void svt_av1_filter_intra_edge_avx2(uint8_t *p, int32_t sz, int32_t strength) {
+    if (!strength)
+        return;
+    // the 8 samples a step of the SSE4.1 filter are enough for the short edges
+    if (sz <= 16) {
+        svt_av1_filter_intra_edge_sse4_1(p, sz, strength);
+        return;
+    }
+    const int16_t *kern      = intra_edge_kernel[strength - 1];
+    const int32_t  five_taps = strength == 3;
+    const __m256i  k[3]      = {
+        _mm256_set1_epi16(kern[0]), _mm256_set1_epi16(kern[1]), _mm256_set1_epi16(kern[2])};
+    __m256i x[5];
+    // The taps past the last sample read it, as the taps before the first
+    // sample read the first one
+    p[sz] = p[sz + 1] = p[sz - 1];
+    load_intra_edge_taps(p + 1, five_taps, x);
+    x[0] = _mm256_insert_epi16(x[0], p[0], 0);
+    // the first sample is not filtered
+    for (int32_t i = 1; i < sz; i += 16) {
+        const __m256i s = filter_intra_edge_16(x, k, five_taps);
+        const __m128i d = _mm_packus_epi16(_mm256_castsi256_si128(s),
+                                           _mm256_extracti128_si256(s, 1));
+        // the filter is in place: the next taps are read before the store
+        if (i + 16 < sz)
+            load_intra_edge_taps(p + i + 16, five_taps, x);
+        if (sz - i >= 16)
+            _mm_storeu_si128((__m128i *)(p + i), d);
+        else {
+            const __m128i iota = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+            const __m128i mask = _mm_cmpgt_epi8(_mm_set1_epi8((char)(sz - i)), iota);
+            const __m128i out  = _mm_loadu_si128((const __m128i *)(p + i));
+            _mm_storeu_si128((__m128i *)(p + i), _mm_blendv_epi8(out, d, mask));
+        }
+    }
+}
+
+void svt_av1_filter_intra_edge_high_avx2(uint16_t *p, int32_t sz, int32_t strength) {
+    if (!strength)
+        return;
+    // the 8 samples a step of the SSE4.1 filter are enough for the short edges
+    if (sz <= 16) {
+        svt_av1_filter_intra_edge_high_sse4_1(p, sz, strength);
+        return;
+    }
+    const int16_t *kern      = intra_edge_kernel[strength - 1];
+    const int32_t  five_taps = strength == 3;
+    const __m256i  k[3]      = {
+        _mm256_set1_epi16(kern[0]), _mm256_set1_epi16(kern[1]), _mm256_set1_epi16(kern[2])};
+    __m256i x[5];
+    // The taps past the last sample read it, as the taps before the first
+    // sample read the first one
+    p[sz] = p[sz + 1] = p[sz - 1];
+    load_intra_edge_taps_high(p + 1, five_taps, x);
+    x[0] = _mm256_insert_epi16(x[0], p[0], 0);
+    // the first sample is not filtered
+    for (int32_t i = 1; i < sz; i += 16) {
+        const __m256i s = filter_intra_edge_16(x, k, five_taps);
+        // the filter is in place: the next taps are read before the store
+        if (i + 16 < sz)
+            load_intra_edge_taps_high(p + i + 16, five_taps, x);
+        if (sz - i >= 16)
+            _mm256_storeu_si256((__m256i *)(p + i), s);
+        else {
+            const __m256i iota = _mm256_setr_epi16(
+                0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+            const __m256i mask = _mm256_cmpgt_epi16(_mm256_set1_epi16((short)(sz - i)), iota);
+            const __m256i out  = _mm256_loadu_si256((const __m256i *)(p + i));
+            _mm256_storeu_si256((__m256i *)(p + i), _mm256_blendv_epi8(out, s, mask));
+        }
+    }
+}
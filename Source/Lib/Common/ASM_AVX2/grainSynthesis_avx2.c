@@ -0,0 +1,183 @@
+/*
+* Copyright (c) 2019, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <immintrin.h>
+
+#include "EbDefinitions.h"
+#include "common_dsp_rtcd.h"
+
+// sample + ((scaling_lut[index] * grain + rounding) >> shift), clamped
+static INLINE __m256i add_scaled_grain(__m256i sample, __m256i index, const int32_t *scaling_lut,
+                                       const int32_t *grain, __m256i rounding, __m128i shift,
+                                       __m256i min_value, __m256i max_value) {
+    const __m256i scale = _mm256_i32gather_epi32(scaling_lut, index, 4);
+    __m256i       noise = _mm256_mullo_epi32(scale, _mm256_loadu_si256((const __m256i *)grain));
+    noise               = _mm256_sra_epi32(_mm256_add_epi32(noise, rounding), shift);
+    const __m256i sum   = _mm256_add_epi32(sample, noise);
+    return _mm256_min_epi32(_mm256_max_epi32(sum, min_value), max_value);
+}
+
+// the 8 non negative 32 bit values packed to 16 bits in the low 128 bits
+static INLINE __m128i pack_epi32_to_u16(__m256i v) {
+    return _mm256_castsi256_si128(_mm256_permute4x64_epi64(_mm256_packus_epi32(v, v), 0x08));
+}
+
+static INLINE void store_u8x8(uint8_t *dst, __m256i v) {
+    const __m128i v16 = pack_epi32_to_u16(v);
+    _mm_storel_epi64((__m128i *)dst, _mm_packus_epi16(v16, v16));
+}
+
+static INLINE void store_u16x8(uint16_t *dst, __m256i v) {
+    _mm_storeu_si128((__m128i *)dst, pack_epi32_to_u16(v));
+}
+
+// rounded average of the 8 pairs of the 16 luma samples
+static INLINE __m256i average_pairs(__m256i luma16) {
+    const __m256i sum = _mm256_madd_epi16(luma16, _mm256_set1_epi16(1));
+    return _mm256_srai_epi32(_mm256_add_epi32(sum, _mm256_set1_epi32(1)), 1);
+}
+
+// clamp(((average_luma * luma_mult + mult * chroma) >> 6) + offset, 0, max_index)
+static INLINE __m256i chroma_scaling_index(__m256i average_luma, __m256i chroma, __m256i luma_mult,
+                                           __m256i mult, __m256i offset, __m256i max_index) {
+    __m256i index = _mm256_add_epi32(_mm256_mullo_epi32(average_luma, luma_mult),
+                                     _mm256_mullo_epi32(chroma, mult));
+    index         = _mm256_add_epi32(_mm256_srai_epi32(index, 6), offset);
+    return _mm256_min_epi32(_mm256_max_epi32(index, _mm256_setzero_si256()), max_index);
+}
+
+void svt_av1_fgn_add_luma_noise_row_avx2(uint8_t *luma, const int32_t *grain,
+                                         const int32_t *scaling_lut, int32_t width,
+                                         int32_t scaling_shift, int32_t min_value,
+                                         int32_t max_value) {
+    const __m256i rounding = _mm256_set1_epi32(1 << (scaling_shift - 1));
+    const __m128i shift    = _mm_cvtsi32_si128(scaling_shift);
+    const __m256i min_v    = _mm256_set1_epi32(min_value);
+    const __m256i max_v    = _mm256_set1_epi32(max_value);
+    int32_t       j        = 0;
+    for (; j + 8 <= width; j += 8) {
+        const __m256i sample = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(luma + j)));
+        store_u8x8(
+            luma + j,
+            add_scaled_grain(
+                sample, sample, scaling_lut, grain + j, rounding, shift, min_v, max_v));
+    }
+    if (j < width)
+        svt_av1_fgn_add_luma_noise_row_c(
+            luma + j, grain + j, scaling_lut, width - j, scaling_shift, min_value, max_value);
+}
+
+void svt_av1_fgn_add_luma_noise_row_hbd_avx2(uint16_t *luma, const int32_t *grain,
+                                             const int32_t *scaling_lut, int32_t width,
+                                             int32_t scaling_shift, int32_t min_value,
+                                             int32_t max_value) {
+    const __m256i rounding = _mm256_set1_epi32(1 << (scaling_shift - 1));
+    const __m128i shift    = _mm_cvtsi32_si128(scaling_shift);
+    const __m256i min_v    = _mm256_set1_epi32(min_value);
+    const __m256i max_v    = _mm256_set1_epi32(max_value);
+    int32_t       j        = 0;
+    for (; j + 8 <= width; j += 8) {
+        const __m256i sample = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(luma + j)));
+        store_u16x8(
+            luma + j,
+            add_scaled_grain(
+                sample, sample, scaling_lut, grain + j, rounding, shift, min_v, max_v));
+    }
+    if (j < width)
+        svt_av1_fgn_add_luma_noise_row_hbd_c(
+            luma + j, grain + j, scaling_lut, width - j, scaling_shift, min_value, max_value);
+}
+
+void svt_av1_fgn_add_chroma_noise_row_avx2(uint8_t *chroma, const uint8_t *luma,
+                                           int32_t chroma_subsamp_x, const int32_t *grain,
+                                           const int32_t *scaling_lut, int32_t width,
+                                           int32_t luma_mult, int32_t mult, int32_t offset,
+                                           int32_t max_index, int32_t scaling_shift,
+                                           int32_t min_value, int32_t max_value) {
+    const __m256i rounding    = _mm256_set1_epi32(1 << (scaling_shift - 1));
+    const __m128i shift       = _mm_cvtsi32_si128(scaling_shift);
+    const __m256i min_v       = _mm256_set1_epi32(min_value);
+    const __m256i max_v       = _mm256_set1_epi32(max_value);
+    const __m256i luma_mult_v = _mm256_set1_epi32(luma_mult);
+    const __m256i mult_v      = _mm256_set1_epi32(mult);
+    const __m256i offset_v    = _mm256_set1_epi32(offset);
+    const __m256i max_index_v = _mm256_set1_epi32(max_index);
+    int32_t       j           = 0;
+    for (; j + 8 <= width; j += 8) {
+        const __m256i average_luma = chroma_subsamp_x
+            ? average_pairs(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(luma + 2 * j))))
+            : _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(luma + j)));
+        const __m256i sample = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(chroma + j)));
+        const __m256i index  = chroma_scaling_index(
+            average_luma, sample, luma_mult_v, mult_v, offset_v, max_index_v);
+        store_u8x8(
+            chroma + j,
+            add_scaled_grain(sample, index, scaling_lut, grain + j, rounding, shift, min_v, max_v));
+    }
+    if (j < width)
+        svt_av1_fgn_add_chroma_noise_row_c(chroma + j,
+                                           luma + (j << chroma_subsamp_x),
+                                           chroma_subsamp_x,
+                                           grain + j,
+                                           scaling_lut,
+                                           width - j,
+                                           luma_mult,
+                                           mult,
+                                           offset,
+                                           max_index,
+                                           scaling_shift,
+                                           min_value,
+                                           max_value);
+}
+
+void svt_av1_fgn_add_chroma_noise_row_hbd_avx2(uint16_t *chroma, const uint16_t *luma,
+                                               int32_t chroma_subsamp_x, const int32_t *grain,
+                                               const int32_t *scaling_lut, int32_t width,
+                                               int32_t luma_mult, int32_t mult, int32_t offset,
+                                               int32_t max_index, int32_t scaling_shift,
+                                               int32_t min_value, int32_t max_value) {
+    const __m256i rounding    = _mm256_set1_epi32(1 << (scaling_shift - 1));
+    const __m128i shift       = _mm_cvtsi32_si128(scaling_shift);
+    const __m256i min_v       = _mm256_set1_epi32(min_value);
+    const __m256i max_v       = _mm256_set1_epi32(max_value);
+    const __m256i luma_mult_v = _mm256_set1_epi32(luma_mult);
+    const __m256i mult_v      = _mm256_set1_epi32(mult);
+    const __m256i offset_v    = _mm256_set1_epi32(offset);
+    const __m256i max_index_v = _mm256_set1_epi32(max_index);
+    int32_t       j           = 0;
+    for (; j + 8 <= width; j += 8) {
+        // the samples of at most 12 bits are positive 16 bit values for madd
+        const __m256i average_luma = chroma_subsamp_x
+            ? average_pairs(_mm256_loadu_si256((const __m256i *)(luma + 2 * j)))
+            : _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(luma + j)));
+        const __m256i sample = _mm256_cvtepu16_epi32(
+            _mm_loadu_si128((const __m128i *)(chroma + j)));
+        const __m256i index = chroma_scaling_index(
+            average_luma, sample, luma_mult_v, mult_v, offset_v, max_index_v);
+        store_u16x8(
+            chroma + j,
+            add_scaled_grain(sample, index, scaling_lut, grain + j, rounding, shift, min_v, max_v));
+    }
+    if (j < width)
+        svt_av1_fgn_add_chroma_noise_row_hbd_c(chroma + j,
+                                               luma + (j << chroma_subsamp_x),
+                                               chroma_subsamp_x,
+                                               grain + j,
+                                               scaling_lut,
+                                               width - j,
+                                               luma_mult,
+                                               mult,
+                                               offset,
+                                               max_index,
+                                               scaling_shift,
+                                               min_value,
+                                               max_value);
+}
@@ -766,6 +766,57 @@ void svt_av1_selfguided_restoration_avx2(const uint8_t *dgd8, int32_t width, int
     }
 }
 
+void svt_av1_sgr_integral_images_avx2(const uint8_t *dgd8, int32_t width, int32_t height,
+                                      int32_t dgd_stride, int32_t *C, int32_t *D,
+                                      int32_t buf_stride, int32_t highbd) {
+    const int32_t width_ext  = width + 2 * SGRPROJ_BORDER_HORZ;
+    const int32_t height_ext = height + 2 * SGRPROJ_BORDER_VERT;
+    // C and D point at (0, 0), after the border and the zero row and column
+    const int32_t  buf_diag_border = SGRPROJ_BORDER_HORZ + 1 +
+        buf_stride * (SGRPROJ_BORDER_VERT + 1);
+    const int32_t  dgd_diag_border = SGRPROJ_BORDER_HORZ + dgd_stride * SGRPROJ_BORDER_VERT;
+    const uint8_t *dgd0            = dgd8 - dgd_diag_border;
+
+    if (highbd)
+        integral_images_highbd(CONVERT_TO_SHORTPTR(dgd0),
+                               dgd_stride,
+                               width_ext,
+                               height_ext,
+                               C - buf_diag_border,
+                               D - buf_diag_border,
+                               buf_stride);
+    else
+        integral_images(dgd0,
+                        dgd_stride,
+                        width_ext,
+                        height_ext,
+                        C - buf_diag_border,
+                        D - buf_diag_border,
+                        buf_stride);
+}
+
+void svt_av1_selfguided_restoration_from_ii_avx2(const uint8_t *dgd8, int32_t width,
+                                                 int32_t height, int32_t dgd_stride,
+                                                 const int32_t *C, const int32_t *D, int32_t *A,
+                                                 int32_t *B, int32_t buf_stride, int32_t *flt0,
+                                                 int32_t *flt1, int32_t flt_stride,
+                                                 int32_t sgr_params_idx, int32_t bit_depth,
+                                                 int32_t highbd) {
+    const SgrParamsType *const params = &eb_sgr_params[sgr_params_idx];
+    assert(!(params->r[0] == 0 && params->r[1] == 0));
+
+    if (params->r[0] > 0) {
+        calc_ab_fast(A, B, C, D, width, height, buf_stride, bit_depth, sgr_params_idx, 0);
+        final_filter_fast(
+            flt0, flt_stride, A, B, buf_stride, dgd8, dgd_stride, width, height, highbd);
+    }
+
+    if (params->r[1] > 0) {
+        calc_ab(A, B, C, D, width, height, buf_stride, bit_depth, sgr_params_idx, 1);
+        final_filter(flt1, flt_stride, A, B, buf_stride, dgd8, dgd_stride, width, height, highbd);
+    }
+}
+
 void svt_apply_selfguided_restoration_avx2(const uint8_t *dat8, int32_t width, int32_t height,
                                            int32_t stride, int32_t eps, const int32_t *xqd,
                                            uint8_t *dst8, int32_t dst_stride, int32_t *tmpbuf,
@@ -15,6 +15,9 @@
 
 #include "EbDefinitions.h"
 #include "common_dsp_rtcd.h"
+#ifdef ARCH_X86_64
+#include <emmintrin.h>
+#endif
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -520,6 +523,22 @@ static inline uint8_t get_prob(uint32_t num, uint32_t den) {
     return p > 255 ? 255 : (uint8_t)p - 1;
 }
 
+#ifdef ARCH_X86_64
+/* Adapts the 8 cdf values starting at index first: values below val move toward
+   AOM_ICDF(0), the others toward 0, and only indices below nsymbs - 1 change. */
+static INLINE __m128i update_cdf_lanes_sse2(__m128i c, int32_t first, int32_t val,
+                                            int32_t nsymbs, __m128i rate) {
+    const __m128i idx  = _mm_add_epi16(_mm_set1_epi16((int16_t)first),
+                                      _mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7));
+    const __m128i up   = _mm_cmpgt_epi16(_mm_set1_epi16((int16_t)val), idx);
+    const __m128i live = _mm_cmpgt_epi16(_mm_set1_epi16((int16_t)(nsymbs - 1)), idx);
+    const __m128i inc  = _mm_and_si128(
+        up, _mm_srl_epi16(_mm_sub_epi16(_mm_set1_epi16((int16_t)AOM_ICDF(0)), c), rate));
+    const __m128i dec = _mm_andnot_si128(up, _mm_srl_epi16(c, rate));
+    return _mm_add_epi16(c, _mm_and_si128(live, _mm_sub_epi16(inc, dec)));
+}
+#endif
+
 static INLINE void update_cdf(AomCdfProb *cdf, int32_t val, int32_t nsymbs) {
     int32_t    rate;
     int32_t    i /*,tmp*/;
@@ -528,7 +547,36 @@ static INLINE void update_cdf(AomCdfProb *cdf, int32_t val, int32_t nsymbs) {
     static const int32_t nsymbs2speed[17] = {0, 0, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2};
     assert(nsymbs < 17);
     rate = 3 + (cdf[nsymbs] > 15) + (cdf[nsymbs] > 31) + nsymbs2speed[nsymbs]; // + get_msb(nsymbs);
-    tmp  = AOM_ICDF(0);
+#ifdef ARCH_X86_64
+    // The cdf holds nsymbs + 1 values (the last one is the counter). Two loads, the
+    // second one ending at the counter at most, cover the nsymbs - 1 adapted values
+    // without reading past the array; the overlap is stored by the first load last.
+    if (nsymbs >= 8) {
+        const int32_t o  = nsymbs == 16 ? 8 : nsymbs - 7;
+        const __m128i r  = _mm_cvtsi32_si128(rate);
+        const __m128i lo = update_cdf_lanes_sse2(
+            _mm_loadu_si128((const __m128i *)cdf), 0, val, nsymbs, r);
+        const __m128i hi = update_cdf_lanes_sse2(
+            _mm_loadu_si128((const __m128i *)(cdf + o)), o, val, nsymbs, r);
+        _mm_storeu_si128((__m128i *)(cdf + o), hi);
+        _mm_storeu_si128((__m128i *)cdf, lo);
+        cdf[nsymbs] += (cdf[nsymbs] < 32);
+        return;
+    }
+    if (nsymbs >= 4) {
+        const int32_t o  = nsymbs - 3;
+        const __m128i r  = _mm_cvtsi32_si128(rate);
+        const __m128i lo = update_cdf_lanes_sse2(
+            _mm_loadl_epi64((const __m128i *)cdf), 0, val, nsymbs, r);
+        const __m128i hi = update_cdf_lanes_sse2(
+            _mm_loadl_epi64((const __m128i *)(cdf + o)), o, val, nsymbs, r);
+        _mm_storel_epi64((__m128i *)(cdf + o), hi);
+        _mm_storel_epi64((__m128i *)cdf, lo);
+        cdf[nsymbs] += (cdf[nsymbs] < 32);
+        return;
+    }
+#endif
+    tmp = AOM_ICDF(0);
 
     // Single loop (faster)
     for (i = 0; i < nsymbs - 1; ++i) {
@@ -109,7 +109,7 @@ that we have a highly directional pattern (e.g. a high contrast
 edge), so we can apply more deringing. A low variance means that we
 either have a low contrast edge, or a non-directional texture, so
 we want to be careful not to blur. */
-static INLINE int32_t adjust_strength(int32_t strength, int32_t var) {
+int32_t svt_cdef_adjust_strength(int32_t strength, int32_t var) {
     const int32_t i = (var >> 6) ? AOMMIN(get_msb(var >> 6), 12) : 0;
     /* We use the variance of 8x8 blocks to adjust the strength. */
     return var ? (strength * (4 + i) + 8) >> 4 : 0;
@@ -369,7 +369,7 @@ void svt_cdef_filter_fb(uint8_t *dst8, uint16_t *dst16, int32_t dstride, uint16_
                                   NULL,
                                   dstride ? dstride : 1 << bsizex,
                                   &in[(by * CDEF_BSTRIDE << bsizey) + (bx << bsizex)],
-                                  (pli ? t : adjust_strength(t, var[by][bx])),
+                                  (pli ? t : svt_cdef_adjust_strength(t, var[by][bx])),
                                   s,
                                   t ? dir[by][bx] : 0,
                                   pri_damping,
@@ -383,7 +383,7 @@ void svt_cdef_filter_fb(uint8_t *dst8, uint16_t *dst16, int32_t dstride, uint16_
                                                  : bi << (bsizex + bsizey)],
                                   dstride ? dstride : 1 << bsizex,
                                   &in[(by * CDEF_BSTRIDE << bsizey) + (bx << bsizex)],
-                                  (pli ? t : adjust_strength(t, var[by][bx])),
+                                  (pli ? t : svt_cdef_adjust_strength(t, var[by][bx])),
                                   s,
                                   t ? dir[by][bx] : 0,
                                   pri_damping,
@@ -46,7 +46,8 @@ DECLARE_ALIGNED(16, extern const int32_t, eb_cdef_directions[8][2]);
 #define REDUCED_TOTAL_STRENGTHS (REDUCED_PRI_STRENGTHS * CDEF_SEC_STRENGTHS)
 #define TOTAL_STRENGTHS (CDEF_PRI_STRENGTHS * CDEF_SEC_STRENGTHS)
 
-void fill_rect(uint16_t *dst, int32_t dstride, int32_t v, int32_t h, uint16_t x);
+int32_t svt_cdef_adjust_strength(int32_t strength, int32_t var);
+void    fill_rect(uint16_t *dst, int32_t dstride, int32_t v, int32_t h, uint16_t x);
 
 void copy_sb16_16(uint16_t *dst, int32_t dstride, const uint16_t *src, int32_t src_voffset,
                   int32_t src_hoffset, int32_t sstride, int32_t vsize, int32_t hsize);
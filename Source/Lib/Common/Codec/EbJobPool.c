@@ -0,0 +1,178 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <stdlib.h>
+#include "EbJobPool.h"
+#include "EbThreads.h"
+
+// A job being run, queued in the pool until its ranges are all taken
+typedef struct SvtJobBatch {
+    SvtJobFn            fn;
+    void               *ctx;
+    int32_t             count;
+    int32_t             range_count;
+    int32_t             next; // first range not taken
+    int32_t             running; // ranges taken by the pool threads, not done
+    int32_t             result;
+    Bool                waiting;
+    EbHandle            done_semaphore;
+    struct SvtJobBatch *next_batch;
+} SvtJobBatch;
+
+struct SvtJobPool {
+    EbHandle     mutex;
+    EbHandle     work_semaphore; // posted per range queued, and per thread to quit
+    SvtJobBatch *head;
+    Bool         quit;
+    uint32_t     thread_count;
+    EbHandle    *threads;
+};
+
+static int32_t run_range(const SvtJobBatch *batch, int32_t range) {
+    return batch->fn(batch->ctx,
+                     batch->count * range / batch->range_count,
+                     batch->count * (range + 1) / batch->range_count);
+}
+
+// Takes the next range of batch, called with the pool mutex held
+static int32_t take_range(SvtJobPool *pool, SvtJobBatch *batch) {
+    const int32_t range = batch->next++;
+    if (batch->next == batch->range_count) {
+        SvtJobBatch **link = &pool->head;
+        while (*link != batch) link = &(*link)->next_batch;
+        *link = batch->next_batch;
+    }
+    return range;
+}
+
+static void *job_pool_kernel(void *input_ptr) {
+    SvtJobPool *pool = (SvtJobPool *)input_ptr;
+    for (;;) {
+        svt_block_on_semaphore(pool->work_semaphore);
+        svt_block_on_mutex(pool->mutex);
+        if (pool->quit) {
+            svt_release_mutex(pool->mutex);
+            break;
+        }
+        // the calling thread may have taken the ranges already
+        SvtJobBatch *batch = pool->head;
+        if (!batch) {
+            svt_release_mutex(pool->mutex);
+            continue;
+        }
+        const int32_t range = take_range(pool, batch);
+        batch->running++;
+        svt_release_mutex(pool->mutex);
+
+        const int32_t result = run_range(batch, range);
+
+        svt_block_on_mutex(pool->mutex);
+        batch->result &= result;
+        const Bool last = --batch->running == 0 && batch->waiting;
+        if (last)
+            batch->waiting = FALSE;
+        svt_release_mutex(pool->mutex);
+        if (last)
+            svt_post_semaphore(batch->done_semaphore);
+    }
+    return NULL;
+}
+
+SvtJobPool *svt_job_pool_create(uint32_t thread_count) {
+    if (!thread_count)
+        return NULL;
+    SvtJobPool *pool = (SvtJobPool *)calloc(1, sizeof(*pool));
+    if (!pool)
+        return NULL;
+    pool->mutex          = svt_create_mutex();
+    pool->work_semaphore = svt_create_semaphore(0, INT32_MAX);
+    pool->threads        = (EbHandle *)calloc(thread_count, sizeof(*pool->threads));
+    if (!pool->mutex || !pool->work_semaphore || !pool->threads) {
+        svt_job_pool_destroy(pool);
+        return NULL;
+    }
+    for (uint32_t i = 0; i < thread_count; i++) {
+        pool->threads[i] = svt_create_thread(job_pool_kernel, pool);
+        if (!pool->threads[i])
+            break;
+        pool->thread_count++;
+    }
+    if (!pool->thread_count) {
+        svt_job_pool_destroy(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+void svt_job_pool_destroy(SvtJobPool *pool) {
+    if (!pool)
+        return;
+    if (pool->thread_count) {
+        svt_block_on_mutex(pool->mutex);
+        pool->quit = TRUE;
+        svt_release_mutex(pool->mutex);
+        for (uint32_t i = 0; i < pool->thread_count; i++)
+            svt_post_semaphore(pool->work_semaphore);
+        for (uint32_t i = 0; i < pool->thread_count; i++) svt_destroy_thread(pool->threads[i]);
+    }
+    free(pool->threads);
+    if (pool->work_semaphore)
+        svt_destroy_semaphore(pool->work_semaphore);
+    if (pool->mutex)
+        svt_destroy_mutex(pool->mutex);
+    free(pool);
+}
+
+int32_t svt_job_pool_run(SvtJobPool *pool, SvtJobFn fn, void *ctx, int32_t count) {
+    if (!pool || count <= 1)
+        return fn(ctx, 0, count);
+    SvtJobBatch batch;
+    batch.fn             = fn;
+    batch.ctx            = ctx;
+    batch.count          = count;
+    batch.range_count    = AOMMIN(count, (int32_t)pool->thread_count + 1);
+    batch.next           = 0;
+    batch.running        = 0;
+    batch.result         = 1;
+    batch.waiting        = FALSE;
+    batch.done_semaphore = svt_create_semaphore(0, 1);
+    batch.next_batch     = NULL;
+    if (!batch.done_semaphore)
+        return fn(ctx, 0, count);
+
+    svt_block_on_mutex(pool->mutex);
+    SvtJobBatch **link = &pool->head;
+    while (*link) link = &(*link)->next_batch;
+    *link = &batch;
+    svt_release_mutex(pool->mutex);
+    for (int32_t i = 1; i < batch.range_count; i++) svt_post_semaphore(pool->work_semaphore);
+
+    int32_t result = 1;
+    for (;;) {
+        svt_block_on_mutex(pool->mutex);
+        if (batch.next == batch.range_count) {
+            svt_release_mutex(pool->mutex);
+            break;
+        }
+        const int32_t range = take_range(pool, &batch);
+        svt_release_mutex(pool->mutex);
+        result &= run_range(&batch, range);
+    }
+
+    svt_block_on_mutex(pool->mutex);
+    const Bool wait = batch.running > 0;
+    batch.waiting   = wait;
+    svt_release_mutex(pool->mutex);
+    if (wait)
+        svt_block_on_semaphore(batch.done_semaphore);
+    svt_destroy_semaphore(batch.done_semaphore);
+    return result & batch.result;
+}
@@ -0,0 +1,46 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbJobPool_h
+#define EbJobPool_h
+
+#include "EbDefinitions.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Processes the items [first, end) of a job, returns 0 on failure
+typedef int32_t (*SvtJobFn)(void *ctx, int32_t first, int32_t end);
+
+/**************************************
+ * SvtJobPool
+ *   Threads shared by the parallel jobs run inside the pipeline
+ *   processes of an encoder, or inside a decoder, so that the
+ *   threads they use stay within the thread count of the codec.
+ *   The items of a job are split in contiguous ranges, one per
+ *   thread of the pool plus the calling thread. The calling thread
+ *   takes the ranges no pool thread has taken, so a job never waits
+ *   for a busy pool. The items of a job must be independent, so
+ *   that the result does not depend on the number of threads.
+ **************************************/
+typedef struct SvtJobPool SvtJobPool;
+
+// Returns NULL when thread_count is 0 or on failure, the jobs then run on the calling thread
+SvtJobPool *svt_job_pool_create(uint32_t thread_count);
+void        svt_job_pool_destroy(SvtJobPool *pool);
+// Returns the AND of the results of the ranges
+int32_t svt_job_pool_run(SvtJobPool *pool, SvtJobFn fn, void *ctx, int32_t count);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbJobPool_h
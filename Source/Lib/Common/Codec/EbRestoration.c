@@ -24,10 +24,6 @@ void svt_av1_upscale_normative_rows(const Av1Common *cm, const uint8_t *src, int
 void av1_foreach_rest_unit_in_frame(Av1Common *cm, int32_t plane, RestTileStartVisitor on_tile,
                                     RestUnitVisitor on_rest_unit, void *priv);
 
-void svt_aom_yv12_copy_y_c(const Yv12BufferConfig *src_ybc, Yv12BufferConfig *dst_ybc);
-void svt_aom_yv12_copy_u_c(const Yv12BufferConfig *src_bc, Yv12BufferConfig *dst_bc);
-void svt_aom_yv12_copy_v_c(const Yv12BufferConfig *src_bc, Yv12BufferConfig *dst_bc);
-
 int32_t svt_aom_realloc_frame_buffer(Yv12BufferConfig *ybf, int32_t width, int32_t height,
                                      int32_t ss_x, int32_t ss_y, int32_t use_highbitdepth,
                                      int32_t border, int32_t byte_alignment,
@@ -204,49 +200,69 @@ EbErrorType svt_av1_alloc_restoration_struct(struct Av1Common *cm, RestorationIn
 }
 
 static void extend_frame_lowbd(uint8_t *data, int32_t width, int32_t height, int32_t stride,
-                               int32_t border_horz, int32_t border_vert) {
+                               int32_t border_horz, int32_t border_vert, int32_t row_start,
+                               int32_t row_end) {
     uint8_t *data_p;
     int32_t  i;
-    for (i = 0; i < height; ++i) {
+    for (i = row_start; i < row_end; ++i) {
         data_p = data + i * stride;
         memset(data_p - border_horz, data_p[0], border_horz);
         memset(data_p + width, data_p[width - 1], border_horz);
     }
     data_p = data - border_horz;
-    for (i = -border_vert; i < 0; ++i)
-        svt_memcpy(data_p + i * stride, data_p, width + 2 * border_horz);
-    for (i = height; i < height + border_vert; ++i) {
-        svt_memcpy(data_p + i * stride, data_p + (height - 1) * stride, width + 2 * border_horz);
-    }
+    if (row_start == 0)
+        for (i = -border_vert; i < 0; ++i)
+            svt_memcpy(data_p + i * stride, data_p, width + 2 * border_horz);
+    if (row_end == height)
+        for (i = height; i < height + border_vert; ++i) {
+            svt_memcpy(
+                data_p + i * stride, data_p + (height - 1) * stride, width + 2 * border_horz);
+        }
 }
 
 static void extend_frame_highbd(uint16_t *data, int32_t width, int32_t height, int32_t stride,
-                                int32_t border_horz, int32_t border_vert) {
+                                int32_t border_horz, int32_t border_vert, int32_t row_start,
+                                int32_t row_end) {
     uint16_t *data_p;
     int32_t   i, j;
-    for (i = 0; i < height; ++i) {
+    for (i = row_start; i < row_end; ++i) {
         data_p = data + i * stride;
         for (j = -border_horz; j < 0; ++j) data_p[j] = data_p[0];
         for (j = width; j < width + border_horz; ++j) data_p[j] = data_p[width - 1];
     }
     data_p = data - border_horz;
-    for (i = -border_vert; i < 0; ++i) {
-        svt_memcpy(data_p + i * stride, data_p, (width + 2 * border_horz) * sizeof(uint16_t));
-    }
-    for (i = height; i < height + border_vert; ++i) {
-        svt_memcpy(data_p + i * stride,
-                   data_p + (height - 1) * stride,
-                   (width + 2 * border_horz) * sizeof(uint16_t));
-    }
+    if (row_start == 0)
+        for (i = -border_vert; i < 0; ++i) {
+            svt_memcpy(data_p + i * stride, data_p, (width + 2 * border_horz) * sizeof(uint16_t));
+        }
+    if (row_end == height)
+        for (i = height; i < height + border_vert; ++i) {
+            svt_memcpy(data_p + i * stride,
+                       data_p + (height - 1) * stride,
+                       (width + 2 * border_horz) * sizeof(uint16_t));
+        }
 }
 
 void svt_extend_frame(uint8_t *data, int32_t width, int32_t height, int32_t stride,
                       int32_t border_horz, int32_t border_vert, int32_t highbd) {
+    svt_extend_frame_rows(data, width, height, stride, border_horz, border_vert, 0, height, highbd);
+}
+
+void svt_extend_frame_rows(uint8_t *data, int32_t width, int32_t height, int32_t stride,
+                           int32_t border_horz, int32_t border_vert, int32_t row_start,
+                           int32_t row_end, int32_t highbd) {
     if (highbd)
-        extend_frame_highbd(
-            CONVERT_TO_SHORTPTR(data), width, height, stride, border_horz, border_vert);
+        extend_frame_highbd(CONVERT_TO_SHORTPTR(data),
+                            width,
+                            height,
+                            stride,
+                            border_horz,
+                            border_vert,
+                            row_start,
+                            row_end);
     else
-        extend_frame_lowbd(data, width, height, stride, border_horz, border_vert);
+        extend_frame_lowbd(
+            data, width, height, stride, border_horz, border_vert, row_start, row_end);
 }
 
 static void copy_tile_lowbd(int32_t width, int32_t height, const uint8_t *src, int32_t src_stride,
@@ -1034,6 +1050,133 @@ void svt_av1_selfguided_restoration_c(const uint8_t *dgd8, int32_t width, int32_
             dgd32, width, height, dgd32_stride, flt1, flt_stride, bit_depth, sgr_params_idx, 1);
 }
 
+void svt_av1_sgr_integral_images_c(const uint8_t *dgd8, int32_t width, int32_t height,
+                                   int32_t dgd_stride, int32_t *C, int32_t *D, int32_t buf_stride,
+                                   int32_t highbd) {
+    const int32_t width_ext  = width + 2 * SGRPROJ_BORDER_HORZ;
+    const int32_t height_ext = height + 2 * SGRPROJ_BORDER_VERT;
+    // The sums wrap around in 32 bits, the box sums taken from them don't
+    uint32_t *ct = (uint32_t *)C - SGRPROJ_BORDER_VERT * buf_stride - SGRPROJ_BORDER_HORZ;
+    uint32_t *dt = (uint32_t *)D - SGRPROJ_BORDER_VERT * buf_stride - SGRPROJ_BORDER_HORZ;
+
+    memset(ct - buf_stride - 1, 0, sizeof(*ct) * (width_ext + 1));
+    memset(dt - buf_stride - 1, 0, sizeof(*dt) * (width_ext + 1));
+    for (int32_t i = 0; i < height_ext; ++i) {
+        const int32_t y     = i - SGRPROJ_BORDER_VERT;
+        uint32_t      c_row = 0;
+        uint32_t      d_row = 0;
+        ct[i * buf_stride - 1] = dt[i * buf_stride - 1] = 0;
+        for (int32_t j = 0; j < width_ext; ++j) {
+            const int32_t  x = j - SGRPROJ_BORDER_HORZ;
+            const uint32_t v = highbd ? CONVERT_TO_SHORTPTR(dgd8)[y * dgd_stride + x]
+                                      : dgd8[y * dgd_stride + x];
+            c_row += v * v;
+            d_row += v;
+            ct[i * buf_stride + j] = ct[(i - 1) * buf_stride + j] + c_row;
+            dt[i * buf_stride + j] = dt[(i - 1) * buf_stride + j] + d_row;
+        }
+    }
+}
+
+// Box sum of radius r centred at ii from an integral image
+static INLINE uint32_t boxsum_from_ii(const int32_t *ii, int32_t stride, int32_t r) {
+    const uint32_t *p = (const uint32_t *)ii;
+    return p[r + r * stride] - p[-(r + 1) + r * stride] - p[r - (r + 1) * stride] +
+        p[-(r + 1) - (r + 1) * stride];
+}
+
+// A[] and B[] of the rows from -1 to height + 1 by row_step, as computed in
+// selfguided_restoration_internal()
+static void calc_ab_from_ii(int32_t *A, int32_t *B, const int32_t *C, const int32_t *D,
+                            int32_t width, int32_t height, int32_t buf_stride, int32_t bit_depth,
+                            int32_t sgr_params_idx, int32_t radius_idx, int32_t row_step) {
+    const SgrParamsType *const params = &eb_sgr_params[sgr_params_idx];
+    const int32_t              r      = params->r[radius_idx];
+    const int32_t              n      = (2 * r + 1) * (2 * r + 1);
+    const uint32_t             s      = params->s[radius_idx];
+
+    for (int32_t i = -1; i < height + 1; i += row_step) {
+        for (int32_t j = -1; j < width + 1; ++j) {
+            const int32_t  k = i * buf_stride + j;
+            const uint32_t a = ROUND_POWER_OF_TWO(boxsum_from_ii(C + k, buf_stride, r),
+                                                  2 * (bit_depth - 8));
+            const uint32_t b = ROUND_POWER_OF_TWO(boxsum_from_ii(D + k, buf_stride, r),
+                                                  bit_depth - 8);
+            const uint32_t p = (a * n < b * b) ? 0 : a * n - b * b;
+            const uint32_t z = ROUND_POWER_OF_TWO(p * s, SGRPROJ_MTABLE_BITS);
+            A[k]             = eb_x_by_xplus1[AOMMIN(z, 255)];
+            B[k]             = (int32_t)ROUND_POWER_OF_TWO((uint32_t)(SGRPROJ_SGR - A[k]) *
+                                                   boxsum_from_ii(D + k, buf_stride, r) *
+                                                   (uint32_t)eb_one_by_x[n - 1],
+                                               SGRPROJ_RECIP_BITS);
+        }
+    }
+}
+
+void svt_av1_selfguided_restoration_from_ii_c(const uint8_t *dgd8, int32_t width, int32_t height,
+                                              int32_t dgd_stride, const int32_t *C,
+                                              const int32_t *D, int32_t *A, int32_t *B,
+                                              int32_t buf_stride, int32_t *flt0, int32_t *flt1,
+                                              int32_t flt_stride, int32_t sgr_params_idx,
+                                              int32_t bit_depth, int32_t highbd) {
+    const SgrParamsType *const params = &eb_sgr_params[sgr_params_idx];
+    assert(!(params->r[0] == 0 && params->r[1] == 0));
+
+    if (params->r[0] > 0) {
+        calc_ab_from_ii(A, B, C, D, width, height, buf_stride, bit_depth, sgr_params_idx, 0, 2);
+        for (int32_t i = 0; i < height; ++i) {
+            // the even rows take the A[] and B[] of the rows above and below
+            const int32_t nb = (i & 1) ? 4 : 5;
+            for (int32_t j = 0; j < width; ++j) {
+                const int32_t k = i * buf_stride + j;
+                const int32_t u = highbd ? CONVERT_TO_SHORTPTR(dgd8)[i * dgd_stride + j]
+                                         : dgd8[i * dgd_stride + j];
+                int32_t       a, b;
+                if (!(i & 1)) {
+                    a = (A[k - buf_stride] + A[k + buf_stride]) * 6 +
+                        (A[k - 1 - buf_stride] + A[k - 1 + buf_stride] + A[k + 1 - buf_stride] +
+                         A[k + 1 + buf_stride]) *
+                            5;
+                    b = (B[k - buf_stride] + B[k + buf_stride]) * 6 +
+                        (B[k - 1 - buf_stride] + B[k - 1 + buf_stride] + B[k + 1 - buf_stride] +
+                         B[k + 1 + buf_stride]) *
+                            5;
+                } else {
+                    a = A[k] * 6 + (A[k - 1] + A[k + 1]) * 5;
+                    b = B[k] * 6 + (B[k - 1] + B[k + 1]) * 5;
+                }
+                flt0[i * flt_stride + j] = ROUND_POWER_OF_TWO(
+                    a * u + b, SGRPROJ_SGR_BITS + nb - SGRPROJ_RST_BITS);
+            }
+        }
+    }
+    if (params->r[1] > 0) {
+        const int32_t nb = 5;
+        calc_ab_from_ii(A, B, C, D, width, height, buf_stride, bit_depth, sgr_params_idx, 1, 1);
+        for (int32_t i = 0; i < height; ++i) {
+            for (int32_t j = 0; j < width; ++j) {
+                const int32_t k = i * buf_stride + j;
+                const int32_t u = highbd ? CONVERT_TO_SHORTPTR(dgd8)[i * dgd_stride + j]
+                                         : dgd8[i * dgd_stride + j];
+                const int32_t a = (A[k] + A[k - 1] + A[k + 1] + A[k - buf_stride] +
+                                   A[k + buf_stride]) *
+                        4 +
+                    (A[k - 1 - buf_stride] + A[k - 1 + buf_stride] + A[k + 1 - buf_stride] +
+                     A[k + 1 + buf_stride]) *
+                        3;
+                const int32_t b = (B[k] + B[k - 1] + B[k + 1] + B[k - buf_stride] +
+                                   B[k + buf_stride]) *
+                        4 +
+                    (B[k - 1 - buf_stride] + B[k - 1 + buf_stride] + B[k + 1 - buf_stride] +
+                     B[k + 1 + buf_stride]) *
+                        3;
+                flt1[i * flt_stride + j] = ROUND_POWER_OF_TWO(
+                    a * u + b, SGRPROJ_SGR_BITS + nb - SGRPROJ_RST_BITS);
+            }
+        }
+    }
+}
+
 void svt_apply_selfguided_restoration_c(const uint8_t *dat8, int32_t width, int32_t height,
                                         int32_t stride, int32_t eps, const int32_t *xqd,
                                         uint8_t *dst8, int32_t dst_stride, int32_t *tmpbuf,
@@ -1238,56 +1381,25 @@ void svt_av1_loop_restoration_filter_unit(
     }
 }
 
-typedef struct {
-    const RestorationInfo  *rsi;
-    RestorationLineBuffers *rlbs;
-    const Av1Common        *cm;
-    int32_t                 tile_stripe0;
-    int32_t                 ss_x, ss_y;
-    int32_t                 highbd, bit_depth;
-    uint8_t                *data8, *dst8;
-    int32_t                 data_stride, dst_stride;
-    int32_t                *tmpbuf;
-} FilterFrameCtxt;
-
-static void filter_frame_on_tile(int32_t tile_row, int32_t tile_col, void *priv) {
-    (void)tile_col;
-    FilterFrameCtxt *ctxt = (FilterFrameCtxt *)priv;
-    ctxt->tile_stripe0    = (tile_row == 0) ? 0 : ctxt->cm->child_pcs->rst_end_stripe[tile_row - 1];
+/* Number of restoration stripes of the plane. The stripes are RESTORATION_PROC_UNIT_SIZE luma
+ * rows high, the first one RESTORATION_UNIT_OFFSET luma rows shorter. */
+static int32_t lr_plane_stripe_count(const Av1Common *cm, int32_t plane) {
+    const int32_t ss_y         = plane > 0 && cm->subsampling_y;
+    const int32_t plane_height = ROUND_POWER_OF_TWO(cm->frm_size.frame_height, ss_y);
+    const int32_t stripe_h     = RESTORATION_PROC_UNIT_SIZE >> ss_y;
+    return (plane_height + (RESTORATION_UNIT_OFFSET >> ss_y) + stripe_h - 1) / stripe_h;
 }
 
-static void filter_frame_on_unit(const RestorationTileLimits *limits, const Av1PixelRect *tile_rect,
-                                 int32_t rest_unit_idx, void *priv) {
-    FilterFrameCtxt       *ctxt = (FilterFrameCtxt *)priv;
-    const RestorationInfo *rsi  = ctxt->rsi;
-
-    svt_av1_loop_restoration_filter_unit(1,
-                                         limits,
-                                         &rsi->unit_info[rest_unit_idx],
-                                         &rsi->boundaries,
-                                         ctxt->rlbs,
-                                         tile_rect,
-                                         ctxt->tile_stripe0,
-                                         ctxt->ss_x,
-                                         ctxt->ss_y,
-                                         ctxt->highbd,
-                                         ctxt->bit_depth,
-                                         ctxt->data8,
-                                         ctxt->data_stride,
-                                         ctxt->dst8,
-                                         ctxt->dst_stride,
-                                         ctxt->tmpbuf,
-                                         rsi->optimized_lr);
+int32_t svt_av1_loop_restoration_stripe_count(const Av1Common *cm) {
+    int32_t count = 0;
+    for (int32_t plane = 0; plane < 3; ++plane)
+        count = AOMMAX(count, lr_plane_stripe_count(cm, plane));
+    return count;
 }
 
-void svt_av1_loop_restoration_filter_frame(Yv12BufferConfig *frame, Av1Common *cm,
-                                           int32_t optimized_lr) {
-    // assert(!cm->all_lossless);
-    const int32_t num_planes = 3; // av1_num_planes(cm);
-    typedef void (*CopyFun)(const Yv12BufferConfig *src, Yv12BufferConfig *dst);
-    static const CopyFun copy_funs[3] = {
-        svt_aom_yv12_copy_y_c, svt_aom_yv12_copy_u_c, svt_aom_yv12_copy_v_c}; //CHKN SSE
-
+/* Allocates the restoration output frame and extends the planes to restore */
+void svt_av1_loop_restoration_filter_frame_init(Yv12BufferConfig *frame, Av1Common *cm,
+                                                int32_t optimized_lr) {
     Yv12BufferConfig *dst = &cm->rst_frame;
 
     const int32_t frame_width  = frame->crop_widths[0];
@@ -1305,54 +1417,146 @@ void svt_av1_loop_restoration_filter_frame(Yv12BufferConfig *frame, Av1Common *c
                                      NULL) < 0)
         SVT_LOG("Failed to allocate restoration dst buffer\n");
 
-    RestorationLineBuffers rlbs;
-    const int32_t          bit_depth = cm->bit_depth;
-    const int32_t          highbd    = cm->use_highbitdepth;
-
-    for (int32_t plane = 0; plane < num_planes; ++plane) {
-        RestorationInfo *rsi   = &cm->child_pcs->rst_info[plane];
-        RestorationType  rtype = rsi->frame_restoration_type;
-        rsi->optimized_lr      = optimized_lr;
-
-        if (rtype == RESTORE_NONE)
+    for (int32_t plane = 0; plane < 3; ++plane) {
+        RestorationInfo *rsi = &cm->child_pcs->rst_info[plane];
+        rsi->optimized_lr    = optimized_lr;
+        if (rsi->frame_restoration_type == RESTORE_NONE)
             continue;
-        const int32_t is_uv        = plane > 0;
-        const int32_t plane_width  = frame->crop_widths[is_uv];
-        const int32_t plane_height = frame->crop_heights[is_uv];
-
+        const int32_t is_uv = plane > 0;
         svt_extend_frame(frame->buffers[plane],
-                         plane_width,
-                         plane_height,
+                         frame->crop_widths[is_uv],
+                         frame->crop_heights[is_uv],
                          frame->strides[is_uv],
                          RESTORATION_BORDER,
                          RESTORATION_BORDER,
-                         highbd);
-
-        FilterFrameCtxt ctxt;
-        ctxt.rsi         = rsi;
-        ctxt.rlbs        = &rlbs;
-        ctxt.cm          = cm;
-        ctxt.ss_x        = is_uv && cm->subsampling_x;
-        ctxt.ss_y        = is_uv && cm->subsampling_y;
-        ctxt.highbd      = highbd;
-        ctxt.bit_depth   = bit_depth;
-        ctxt.data8       = frame->buffers[plane];
-        ctxt.dst8        = dst->buffers[plane];
-        ctxt.data_stride = frame->strides[is_uv];
-        ctxt.dst_stride  = dst->strides[is_uv];
-        ctxt.tmpbuf      = cm->rst_tmpbuf;
-
-        av1_foreach_rest_unit_in_frame(
-            cm, plane, filter_frame_on_tile, filter_frame_on_unit, &ctxt);
-
-        copy_funs[plane](dst, frame);
+                         cm->use_highbitdepth);
+    }
+}
+
+/* Restores the stripe of the planes to the restoration output frame. The stripe boundaries are
+ * set up in the frame while the stripe is filtered, so the stripes next to each other are not
+ * filtered at the same time. */
+void svt_av1_loop_restoration_filter_stripe(Yv12BufferConfig *frame, Av1Common *cm,
+                                            int32_t stripe, int32_t *tmpbuf) {
+    Yv12BufferConfig      *dst = &cm->rst_frame;
+    RestorationLineBuffers rlbs;
+
+    for (int32_t plane = 0; plane < 3; ++plane) {
+        const RestorationInfo *rsi = &cm->child_pcs->rst_info[plane];
+        if (rsi->frame_restoration_type == RESTORE_NONE)
+            continue;
+        const int32_t      is_uv     = plane > 0;
+        const int32_t      ss_x      = is_uv && cm->subsampling_x;
+        const int32_t      ss_y      = is_uv && cm->subsampling_y;
+        const Av1PixelRect tile_rect = whole_frame_rect(
+            &cm->frm_size, cm->subsampling_x, cm->subsampling_y, is_uv);
+        const int32_t stripe_h = RESTORATION_PROC_UNIT_SIZE >> ss_y;
+        const int32_t voffset  = RESTORATION_UNIT_OFFSET >> ss_y;
+
+        RestorationTileLimits limits;
+        limits.v_start = AOMMAX(tile_rect.top, stripe * stripe_h - voffset);
+        limits.v_end   = AOMMIN(tile_rect.bottom, (stripe + 1) * stripe_h - voffset);
+        if (limits.v_start >= limits.v_end)
+            continue;
+
+        // The units are offset upwards like the stripes, the last unit row taking the rest
+        const int32_t unit_size = rsi->restoration_unit_size;
+        const int32_t ext_size  = unit_size * 3 / 2;
+        const int32_t unit_row  = AOMMIN((limits.v_start + voffset) / unit_size,
+                                        rsi->vert_units_per_tile - 1);
+        const int32_t tile_w    = tile_rect.right - tile_rect.left;
+        int32_t       x0 = 0, j = 0;
+        while (x0 < tile_w) {
+            const int32_t remaining_w = tile_w - x0;
+            const int32_t w           = (remaining_w < ext_size) ? remaining_w : unit_size;
+            limits.h_start            = tile_rect.left + x0;
+            limits.h_end              = tile_rect.left + x0 + w;
+            svt_av1_loop_restoration_filter_unit(
+                1,
+                &limits,
+                &rsi->unit_info[unit_row * rsi->horz_units_per_tile + j],
+                &rsi->boundaries,
+                &rlbs,
+                &tile_rect,
+                0,
+                ss_x,
+                ss_y,
+                cm->use_highbitdepth,
+                cm->bit_depth,
+                frame->buffers[plane],
+                frame->strides[is_uv],
+                dst->buffers[plane],
+                dst->strides[is_uv],
+                tmpbuf,
+                rsi->optimized_lr);
+            x0 += w;
+            ++j;
+        }
+    }
+}
+
+/* Copies the rows of the stripe of the restored planes back to the frame, the last stripe
+ * taking the rows down to the aligned plane height */
+void svt_av1_loop_restoration_copy_stripe(Yv12BufferConfig *frame, Av1Common *cm,
+                                          int32_t stripe) {
+    const Yv12BufferConfig *dst = &cm->rst_frame;
+
+    for (int32_t plane = 0; plane < 3; ++plane) {
+        if (cm->child_pcs->rst_info[plane].frame_restoration_type == RESTORE_NONE)
+            continue;
+        const int32_t stripe_count = lr_plane_stripe_count(cm, plane);
+        if (stripe >= stripe_count)
+            continue;
+        const int32_t is_uv    = plane > 0;
+        const int32_t ss_y     = is_uv && cm->subsampling_y;
+        const int32_t stripe_h = RESTORATION_PROC_UNIT_SIZE >> ss_y;
+        const int32_t voffset  = RESTORATION_UNIT_OFFSET >> ss_y;
+        const int32_t y0       = AOMMAX(0, stripe * stripe_h - voffset);
+        const int32_t y1 = stripe == stripe_count - 1 ? dst->heights[is_uv]
+                                                      : (stripe + 1) * stripe_h - voffset;
+        const int32_t src_stride = dst->strides[is_uv];
+        const int32_t dst_stride = frame->strides[is_uv];
+        if (dst->flags & YV12_FLAG_HIGHBITDEPTH) {
+            const uint16_t *src16 = CONVERT_TO_SHORTPTR(dst->buffers[plane]) + y0 * src_stride;
+            uint16_t       *dst16 = CONVERT_TO_SHORTPTR(frame->buffers[plane]) + y0 * dst_stride;
+            for (int32_t row = y0; row < y1; ++row) {
+                svt_memcpy(dst16, src16, dst->widths[is_uv] * sizeof(uint16_t));
+                src16 += src_stride;
+                dst16 += dst_stride;
+            }
+        } else {
+            const uint8_t *src8 = dst->buffers[plane] + y0 * src_stride;
+            uint8_t       *dst8 = frame->buffers[plane] + y0 * dst_stride;
+            for (int32_t row = y0; row < y1; ++row) {
+                svt_memcpy(dst8, src8, dst->widths[is_uv]);
+                src8 += src_stride;
+                dst8 += dst_stride;
+            }
+        }
     }
+}
+
+void svt_av1_loop_restoration_filter_frame_free(Av1Common *cm) {
+    Yv12BufferConfig *dst = &cm->rst_frame;
     if (dst->buffer_alloc_sz) {
         dst->buffer_alloc_sz = 0;
         EB_FREE_ARRAY(dst->buffer_alloc);
     }
 }
 
+void svt_av1_loop_restoration_filter_frame(Yv12BufferConfig *frame, Av1Common *cm,
+                                           int32_t optimized_lr) {
+    // assert(!cm->all_lossless);
+    const int32_t stripe_count = svt_av1_loop_restoration_stripe_count(cm);
+
+    svt_av1_loop_restoration_filter_frame_init(frame, cm, optimized_lr);
+    for (int32_t stripe = 0; stripe < stripe_count; ++stripe)
+        svt_av1_loop_restoration_filter_stripe(frame, cm, stripe, cm->rst_tmpbuf);
+    for (int32_t stripe = 0; stripe < stripe_count; ++stripe)
+        svt_av1_loop_restoration_copy_stripe(frame, cm, stripe);
+    svt_av1_loop_restoration_filter_frame_free(cm);
+}
+
 static void foreach_rest_unit_in_tile(const Av1PixelRect *tile_rect, int32_t tile_row,
                                       int32_t tile_col, int32_t tile_cols, int32_t hunits_per_tile,
                                       int32_t units_per_tile, int32_t unit_size, int32_t ss_y,
@@ -1731,10 +1935,12 @@ void save_cdef_boundary_lines(uint8_t *src_buf, int32_t src_stride, int32_t src_
                  use_highbd);
 }
 
-void save_tile_row_boundary_lines(uint8_t *src, int32_t src_stride, int32_t src_width,
-                                  int32_t src_height, int32_t use_highbd, int32_t plane,
-                                  Av1Common *cm, int32_t after_cdef,
-                                  RestorationStripeBoundaries *boundaries) {
+/* Saves the boundary lines of the stripes stripe_start to stripe_end - 1 of the plane */
+void save_tile_row_boundary_lines_stripes(uint8_t *src, int32_t src_stride, int32_t src_width,
+                                          int32_t src_height, int32_t use_highbd, int32_t plane,
+                                          Av1Common *cm, int32_t after_cdef, int32_t stripe_start,
+                                          int32_t stripe_end,
+                                          RestorationStripeBoundaries *boundaries) {
     const int32_t is_uv         = plane > 0;
     const int32_t ss_y          = is_uv && cm->subsampling_y;
     const int32_t stripe_height = RESTORATION_PROC_UNIT_SIZE >> ss_y;
@@ -1749,7 +1955,7 @@ void save_tile_row_boundary_lines(uint8_t *src, int32_t src_stride, int32_t src_
     int32_t plane_height = ROUND_POWER_OF_TWO(cm->frm_size.frame_height, ss_y);
 
     int32_t tile_stripe;
-    for (tile_stripe = 0;; ++tile_stripe) {
+    for (tile_stripe = stripe_start; tile_stripe < stripe_end; ++tile_stripe) {
         const int32_t rel_y0 = AOMMAX(0, tile_stripe * stripe_height - stripe_off);
         const int32_t y0     = tile_rect.top + rel_y0;
         if (y0 >= tile_rect.bottom)
@@ -1830,6 +2036,23 @@ void save_tile_row_boundary_lines(uint8_t *src, int32_t src_stride, int32_t src_
     }
 }
 
+void save_tile_row_boundary_lines(uint8_t *src, int32_t src_stride, int32_t src_width,
+                                  int32_t src_height, int32_t use_highbd, int32_t plane,
+                                  Av1Common *cm, int32_t after_cdef,
+                                  RestorationStripeBoundaries *boundaries) {
+    save_tile_row_boundary_lines_stripes(src,
+                                         src_stride,
+                                         src_width,
+                                         src_height,
+                                         use_highbd,
+                                         plane,
+                                         cm,
+                                         after_cdef,
+                                         0,
+                                         INT32_MAX,
+                                         boundaries);
+}
+
 // For each RESTORATION_PROC_UNIT_SIZE pixel high stripe, save 4 scan
 // lines to be used as boundary in the loop restoration process. The
 // lines are saved in rst_internal.stripe_boundary_lines
@@ -85,6 +85,18 @@ void svt_apply_selfguided_restoration_c(const uint8_t *dat8, int32_t width, int3
 // Two 32-bit buffers needed for the restored versions from two filters
 #define SGRPROJ_TMPBUF_SIZE (RESTORATION_UNITPELS_MAX * 2 * sizeof(int32_t))
 
+// The integral images of a unit extended by the Sgr border, with a zero row
+// and column above and left, and the A and B arrays of a processing unit of
+// the unit, all with the stride of the unit
+#define SGRPROJ_II_STRIDE(width) ALIGN_POWER_OF_TWO((width) + 2 * SGRPROJ_BORDER_HORZ + 16, 3)
+#define SGRPROJ_II_ROWS(height) (ALIGN_POWER_OF_TWO((height) + 2 * SGRPROJ_BORDER_VERT, 3) + 1)
+#define SGRPROJ_II_PELS_MAX                              \
+    (SGRPROJ_II_STRIDE(RESTORATION_UNITSIZE_MAX * 3 / 2) * \
+     SGRPROJ_II_ROWS(RESTORATION_UNITSIZE_MAX * 3 / 2 + RESTORATION_UNIT_OFFSET))
+#define SGRPROJ_AB_PELS_MAX \
+    (SGRPROJ_II_STRIDE(RESTORATION_UNITSIZE_MAX * 3 / 2) * (RESTORATION_PROC_UNIT_SIZE + 3))
+#define SGRPROJ_II_TMPBUF_SIZE ((SGRPROJ_II_PELS_MAX + SGRPROJ_AB_PELS_MAX) * 2 * sizeof(int32_t))
+
 #define SGRPROJ_EXTBUF_SIZE (0)
 #define SGRPROJ_PARAMS_BITS 4
 #define SGRPROJ_PARAMS (1 << SGRPROJ_PARAMS_BITS)
@@ -155,6 +167,9 @@ void svt_apply_selfguided_restoration_c(const uint8_t *dat8, int32_t width, int3
 // Max of SGRPROJ_TMPBUF_SIZE, DOMAINTXFMRF_TMPBUF_SIZE, WIENER_TMPBUF_SIZE
 #define RESTORATION_TMPBUF_SIZE (SGRPROJ_TMPBUF_SIZE)
 
+// The search keeps the integral images of the unit after the restored versions
+#define RESTORATION_SEARCH_TMPBUF_SIZE (RESTORATION_TMPBUF_SIZE + SGRPROJ_II_TMPBUF_SIZE)
+
 // Max of SGRPROJ_EXTBUF_SIZE, WIENER_EXTBUF_SIZE
 #define RESTORATION_EXTBUF_SIZE (WIENER_EXTBUF_SIZE)
 
@@ -270,6 +285,11 @@ extern const int32_t       eb_one_by_x[MAX_NELEM];
 //                                      int32_t is_uv);
 void svt_extend_frame(uint8_t *data, int32_t width, int32_t height, int32_t stride,
                       int32_t border_horz, int32_t border_vert, int32_t highbd);
+// Extends the rows [row_start, row_end) of the frame sideways, and the frame above its top row
+// and below its bottom row once the range holds them
+void svt_extend_frame_rows(uint8_t *data, int32_t width, int32_t height, int32_t stride,
+                           int32_t border_horz, int32_t border_vert, int32_t row_start,
+                           int32_t row_end, int32_t highbd);
 void svt_decode_xq(const int32_t *xqd, int32_t *xq, const SgrParamsType *params);
 
 // Filter a single loop restoration unit.
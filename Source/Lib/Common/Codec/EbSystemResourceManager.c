@@ -15,12 +15,14 @@
 #include "EbSystemResourceManager.h"
 #include "EbDefinitions.h"
 #include "EbThreads.h"
+#include "EbTime.h"
 #if SRM_REPORT
 #include "EbLog.h"
 #endif
 static void svt_fifo_dctor(EbPtr p) {
     EbFifo *obj = (EbFifo *)p;
     EB_DESTROY_SEMAPHORE(obj->counting_semaphore);
+    EB_DESTROY_SEMAPHORE(obj->park_semaphore);
     EB_DESTROY_MUTEX(obj->lockout_mutex);
 }
 /**************************************
@@ -28,11 +30,14 @@ static void svt_fifo_dctor(EbPtr p) {
  **************************************/
 static EbErrorType svt_fifo_ctor(EbFifo *fifoPtr, uint32_t initial_count, uint32_t max_count,
                                  EbObjectWrapper *firstWrapperPtr, EbObjectWrapper *lastWrapperPtr,
-                                 EbMuxingQueue *queue_ptr) {
+                                 EbMuxingQueue *queue_ptr, uint32_t process_index) {
     fifoPtr->dctor = svt_fifo_dctor;
     // Create Counting Semaphore
     EB_CREATE_SEMAPHORE(fifoPtr->counting_semaphore, initial_count, max_count);
 
+    // Create Park Semaphore, posted by unpark and by shutdown
+    EB_CREATE_SEMAPHORE(fifoPtr->park_semaphore, 0, 2);
+
     // Create Buffer Pool Mutex
     EB_CREATE_MUTEX(fifoPtr->lockout_mutex);
 
@@ -41,7 +46,8 @@ static EbErrorType svt_fifo_ctor(EbFifo *fifoPtr, uint32_t initial_count, uint32
     fifoPtr->last_ptr  = lastWrapperPtr;
 
     // Copy the Muxing Queue ptr this Fifo belongs to
-    fifoPtr->queue_ptr = queue_ptr;
+    fifoPtr->queue_ptr     = queue_ptr;
+    fifoPtr->process_index = process_index;
 
     return EB_ErrorNone;
 }
@@ -95,6 +101,7 @@ static EbErrorType svt_fifo_shutdown(EbFifo *fifo_ptr) {
     svt_release_mutex(fifo_ptr->lockout_mutex);
     //Wake up the waiting process if any
     svt_post_semaphore(fifo_ptr->counting_semaphore);
+    svt_post_semaphore(fifo_ptr->park_semaphore);
 
     return return_error;
 }
@@ -204,8 +211,9 @@ static EbErrorType svt_muxing_queue_ctor(EbMuxingQueue *queue_ptr, uint32_t obje
     uint32_t    process_index;
     EbErrorType return_error = EB_ErrorNone;
 
-    queue_ptr->dctor               = svt_muxing_queue_dctor;
-    queue_ptr->process_total_count = process_total_count;
+    queue_ptr->dctor                = svt_muxing_queue_dctor;
+    queue_ptr->process_total_count  = process_total_count;
+    queue_ptr->active_process_count = process_total_count;
 
     // Lockout Mutex
     EB_CREATE_MUTEX(queue_ptr->lockout_mutex);
@@ -224,7 +232,8 @@ static EbErrorType svt_muxing_queue_ctor(EbMuxingQueue *queue_ptr, uint32_t obje
                object_total_count,
                (EbObjectWrapper *)NULL,
                (EbObjectWrapper *)NULL,
-               queue_ptr);
+               queue_ptr,
+               process_index);
     }
 
     return return_error;
@@ -521,6 +530,73 @@ EbErrorType svt_shutdown_process(const EbSystemResource *resource_ptr) {
     return EB_ErrorNone;
 }
 
+static uint64_t svt_get_time_us(void) {
+    uint64_t seconds, useconds;
+    svt_av1_get_time(&seconds, &useconds);
+    return seconds * 1000000 + useconds;
+}
+
+EbErrorType svt_system_resource_enable_monitor(const EbSystemResource *resource_ptr) {
+    if (!resource_ptr || !resource_ptr->full_queue)
+        return EB_ErrorNone;
+    resource_ptr->full_queue->monitor = TRUE;
+    return EB_ErrorNone;
+}
+
+uint64_t svt_system_resource_get_busy_time(const EbSystemResource *resource_ptr) {
+    EbMuxingQueue *queue_ptr = resource_ptr->full_queue;
+    svt_block_on_mutex(queue_ptr->lockout_mutex);
+    const uint64_t busy_time_us = queue_ptr->busy_time_us;
+    svt_release_mutex(queue_ptr->lockout_mutex);
+    return busy_time_us;
+}
+
+EbErrorType svt_system_resource_set_active_process_count(const EbSystemResource *resource_ptr,
+                                                         uint32_t                active_count) {
+    EbMuxingQueue *queue_ptr = resource_ptr->full_queue;
+    if (active_count > queue_ptr->process_total_count)
+        active_count = queue_ptr->process_total_count;
+    if (active_count == 0)
+        active_count = 1;
+
+    svt_block_on_mutex(queue_ptr->lockout_mutex);
+    queue_ptr->active_process_count = active_count;
+    // Wake up the parked processes that are back in range
+    for (uint32_t i = 0; i < active_count; i++) {
+        EbFifo *fifo_ptr = queue_ptr->process_fifo_ptr_array[i];
+        if (fifo_ptr->parked) {
+            fifo_ptr->parked = FALSE;
+            svt_post_semaphore(fifo_ptr->park_semaphore);
+        }
+    }
+    svt_release_mutex(queue_ptr->lockout_mutex);
+    return EB_ErrorNone;
+}
+
+/*********************************************************************
+ * svt_fifo_monitor_idle
+ *   Called by a monitored consumer process when it asks for its next
+ *   object: accumulates the time spent on the previous object and parks
+ *   the process while it is beyond the active process count.
+ *********************************************************************/
+static void svt_fifo_monitor_idle(EbFifo *fifo_ptr) {
+    EbMuxingQueue *queue_ptr = fifo_ptr->queue_ptr;
+
+    svt_block_on_mutex(queue_ptr->lockout_mutex);
+    if (fifo_ptr->busy_start_us) {
+        queue_ptr->busy_time_us += svt_get_time_us() - fifo_ptr->busy_start_us;
+        fifo_ptr->busy_start_us = 0;
+    }
+    while (fifo_ptr->process_index >= queue_ptr->active_process_count && !fifo_ptr->quit_signal) {
+        fifo_ptr->parked = TRUE;
+        svt_release_mutex(queue_ptr->lockout_mutex);
+        svt_block_on_semaphore(fifo_ptr->park_semaphore);
+        svt_block_on_mutex(queue_ptr->lockout_mutex);
+    }
+    fifo_ptr->parked = FALSE;
+    svt_release_mutex(queue_ptr->lockout_mutex);
+}
+
 /*********************************************************************
  * EbSystemResourceReleaseProcess
  *********************************************************************/
@@ -732,6 +808,11 @@ EbErrorType svt_get_empty_object(EbFifo *empty_fifo_ptr, EbObjectWrapper **wrapp
  *********************************************************************/
 EbErrorType svt_get_full_object(EbFifo *full_fifo_ptr, EbObjectWrapper **wrapper_dbl_ptr) {
     EbErrorType return_error = EB_ErrorNone;
+    const Bool  monitor      = full_fifo_ptr->queue_ptr->monitor;
+
+    // Account for the previous object and park if the process is inactive
+    if (monitor)
+        svt_fifo_monitor_idle(full_fifo_ptr);
 
     // Queue the Fifo requesting the full fifo
     svt_release_process(full_fifo_ptr);
@@ -744,6 +825,8 @@ EbErrorType svt_get_full_object(EbFifo *full_fifo_ptr, EbObjectWrapper **wrapper
 
     if (!full_fifo_ptr->quit_signal) {
         svt_fifo_pop_front(full_fifo_ptr, wrapper_dbl_ptr);
+        if (monitor)
+            full_fifo_ptr->busy_start_us = svt_get_time_us();
     } else {
         *wrapper_dbl_ptr = NULL;
         return_error     = EB_NoErrorFifoShutdown;
@@ -88,6 +88,18 @@ typedef struct EbFifo {
     // queue_ptr - pointer to MuxingQueue that the EbFifo is
     //   associated with.
     struct EbMuxingQueue *queue_ptr;
+
+    // process_index - index of the Fifo within its MuxingQueue.
+    uint32_t process_index;
+
+    // park_semaphore - blocks the consumer process while its index is
+    //   beyond the MuxingQueue active_process_count.
+    EbHandle park_semaphore;
+    Bool     parked;
+
+    // busy_start_us - time at which the consumer process got its last
+    //   object, used to accumulate the MuxingQueue busy_time_us.
+    uint64_t busy_start_us;
 } EbFifo;
 
 /*********************************************************************
@@ -112,6 +124,13 @@ typedef struct EbMuxingQueue {
     EbCircularBuffer *process_queue;
     uint32_t          process_total_count;
     EbFifo          **process_fifo_ptr_array;
+    // active_process_count - number of processes allowed to get objects;
+    //   processes with a higher index are parked.
+    uint32_t active_process_count;
+    // monitor - when set, the time consumer processes spend between getting
+    //   an object and asking for the next one is accumulated in busy_time_us.
+    Bool     monitor;
+    uint64_t busy_time_us;
 #if SRM_REPORT
     uint32_t curr_count; //run time fullness
     uint8_t  log; //if set monitor out the queue size
@@ -330,6 +349,42 @@ extern EbErrorType svt_release_object(EbObjectWrapper *object_ptr);
      *********************************************************************/
 extern EbErrorType svt_shutdown_process(const EbSystemResource *resource_ptr);
 
+/*********************************************************************
+     * svt_system_resource_enable_monitor
+     *   Starts accumulating the busy time of the consumer processes of
+     *   the SystemResource and allows them to be parked. Must be called
+     *   before the consumer processes are started.
+     *
+     *   resource_ptr
+     *      pointer to the SystemResource.
+     *********************************************************************/
+extern EbErrorType svt_system_resource_enable_monitor(const EbSystemResource *resource_ptr);
+
+/*********************************************************************
+     * svt_system_resource_get_busy_time
+     *   Returns the time in microseconds the consumer processes of the
+     *   SystemResource spent on objects since the monitor was enabled.
+     *
+     *   resource_ptr
+     *      pointer to the SystemResource.
+     *********************************************************************/
+extern uint64_t svt_system_resource_get_busy_time(const EbSystemResource *resource_ptr);
+
+/*********************************************************************
+     * svt_system_resource_set_active_process_count
+     *   Sets the number of consumer processes allowed to get objects.
+     *   Processes beyond that count park the next time they ask for an
+     *   object, processes brought back in range are woken up.
+     *
+     *   resource_ptr
+     *      pointer to the SystemResource.
+     *
+     *   active_count
+     *      number of active consumer processes, clamped to [1, total].
+     *********************************************************************/
+extern EbErrorType svt_system_resource_set_active_process_count(
+    const EbSystemResource *resource_ptr, uint32_t active_count);
+
 #define EB_GET_FULL_OBJECT(full_fifo_ptr, wrapper_dbl_ptr)                     \
     do {                                                                       \
         EbErrorType err = svt_get_full_object(full_fifo_ptr, wrapper_dbl_ptr); \
@@ -367,6 +367,39 @@ void atomic_set_u32(AtomicVarU32 *var, uint32_t in) {
     svt_release_mutex(var->mutex);
 }
 
+int32_t svt_atomic_add_i32(volatile int32_t *var, int32_t in) {
+#ifdef _WIN32
+    return InterlockedExchangeAdd((volatile LONG *)var, in) + in;
+#else
+    return __atomic_add_fetch(var, in, __ATOMIC_SEQ_CST);
+#endif
+}
+
+int32_t svt_atomic_load_i32(volatile int32_t *var) {
+#ifdef _WIN32
+    return InterlockedCompareExchange((volatile LONG *)var, 0, 0);
+#else
+    return __atomic_load_n(var, __ATOMIC_SEQ_CST);
+#endif
+}
+
+void svt_atomic_store_i32(volatile int32_t *var, int32_t in) {
+#ifdef _WIN32
+    InterlockedExchange((volatile LONG *)var, in);
+#else
+    __atomic_store_n(var, in, __ATOMIC_SEQ_CST);
+#endif
+}
+
+Bool svt_atomic_cas_i32(volatile int32_t *var, int32_t expected, int32_t desired) {
+#ifdef _WIN32
+    return InterlockedCompareExchange((volatile LONG *)var, desired, expected) == expected;
+#else
+    return __atomic_compare_exchange_n(
+        var, &expected, desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+#endif
+}
+
 /*
     create condition variable
 
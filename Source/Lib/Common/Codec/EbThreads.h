@@ -119,6 +119,15 @@ extern EbErrorType svt_destroy_mutex(EbHandle mutex_handle);
 
 void atomic_set_u32(AtomicVarU32 *var, uint32_t in);
 
+/*
+ Lock-free 32-bit integers, all accesses being sequentially consistent
+*/
+int32_t svt_atomic_add_i32(volatile int32_t *var, int32_t in); // returns the new value
+int32_t svt_atomic_load_i32(volatile int32_t *var);
+void    svt_atomic_store_i32(volatile int32_t *var, int32_t in);
+// sets var to desired if it holds expected, returns TRUE if it did
+Bool svt_atomic_cas_i32(volatile int32_t *var, int32_t expected, int32_t desired);
+
 /*
  Condition variable
 */
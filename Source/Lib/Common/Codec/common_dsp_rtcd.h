@@ -191,6 +191,10 @@ extern "C" {
     RTCD_EXTERN void(*svt_av1_selfguided_restoration)(const uint8_t *dgd8, int32_t width, int32_t height,
         int32_t dgd_stride, int32_t *flt0, int32_t *flt1, int32_t flt_stride,
         int32_t sgr_params_idx, int32_t bit_depth, int32_t highbd);
+    void svt_av1_sgr_integral_images_c(const uint8_t *dgd8, int32_t width, int32_t height, int32_t dgd_stride, int32_t *C, int32_t *D, int32_t buf_stride, int32_t highbd);
+    RTCD_EXTERN void(*svt_av1_sgr_integral_images)(const uint8_t *dgd8, int32_t width, int32_t height, int32_t dgd_stride, int32_t *C, int32_t *D, int32_t buf_stride, int32_t highbd);
+    void svt_av1_selfguided_restoration_from_ii_c(const uint8_t *dgd8, int32_t width, int32_t height, int32_t dgd_stride, const int32_t *C, const int32_t *D, int32_t *A, int32_t *B, int32_t buf_stride, int32_t *flt0, int32_t *flt1, int32_t flt_stride, int32_t sgr_params_idx, int32_t bit_depth, int32_t highbd);
+    RTCD_EXTERN void(*svt_av1_selfguided_restoration_from_ii)(const uint8_t *dgd8, int32_t width, int32_t height, int32_t dgd_stride, const int32_t *C, const int32_t *D, int32_t *A, int32_t *B, int32_t buf_stride, int32_t *flt0, int32_t *flt1, int32_t flt_stride, int32_t sgr_params_idx, int32_t bit_depth, int32_t highbd);
     void svt_av1_convolve_2d_copy_sr_c(const uint8_t *src, int32_t src_stride, uint8_t *dst, int32_t dst_stride, int32_t w, int32_t h, InterpFilterParams *filter_params_x, InterpFilterParams *filter_params_y, const int32_t subpel_x_q4, const int32_t subpel_y_q4, ConvolveParams *conv_params);
     RTCD_EXTERN void(*svt_av1_convolve_2d_copy_sr)(const uint8_t *src, int32_t src_stride, uint8_t *dst, int32_t dst_stride, int32_t w, int32_t h, InterpFilterParams *filter_params_x, InterpFilterParams *filter_params_y, const int32_t subpel_x_q4, const int32_t subpel_y_q4, ConvolveParams *conv_params);
     void svt_av1_convolve_2d_sr_c(const uint8_t *src, int32_t src_stride, uint8_t *dst, int32_t dst_stride, int32_t w, int32_t h, InterpFilterParams *filter_params_x, InterpFilterParams *filter_params_y, const int32_t subpel_x_q4, const int32_t subpel_y_q4, ConvolveParams *conv_params);
@@ -1069,6 +1073,14 @@ extern "C" {
     RTCD_EXTERN uint32_t(*svt_log2f)(uint32_t x);
     void svt_memcpy_c(void  *dst_ptr, void  const*src_ptr, size_t size);
     RTCD_EXTERN void (*svt_memcpy)(void  *dst_ptr, void  const*src_ptr, size_t size);
+    void svt_av1_fgn_add_luma_noise_row_c(uint8_t *luma, const int32_t *grain, const int32_t *scaling_lut, int32_t width, int32_t scaling_shift, int32_t min_value, int32_t max_value);
+    RTCD_EXTERN void(*svt_av1_fgn_add_luma_noise_row)(uint8_t *luma, const int32_t *grain, const int32_t *scaling_lut, int32_t width, int32_t scaling_shift, int32_t min_value, int32_t max_value);
+    void svt_av1_fgn_add_luma_noise_row_hbd_c(uint16_t *luma, const int32_t *grain, const int32_t *scaling_lut, int32_t width, int32_t scaling_shift, int32_t min_value, int32_t max_value);
+    RTCD_EXTERN void(*svt_av1_fgn_add_luma_noise_row_hbd)(uint16_t *luma, const int32_t *grain, const int32_t *scaling_lut, int32_t width, int32_t scaling_shift, int32_t min_value, int32_t max_value);
+    void svt_av1_fgn_add_chroma_noise_row_c(uint8_t *chroma, const uint8_t *luma, int32_t chroma_subsamp_x, const int32_t *grain, const int32_t *scaling_lut, int32_t width, int32_t luma_mult, int32_t mult, int32_t offset, int32_t max_index, int32_t scaling_shift, int32_t min_value, int32_t max_value);
+    RTCD_EXTERN void(*svt_av1_fgn_add_chroma_noise_row)(uint8_t *chroma, const uint8_t *luma, int32_t chroma_subsamp_x, const int32_t *grain, const int32_t *scaling_lut, int32_t width, int32_t luma_mult, int32_t mult, int32_t offset, int32_t max_index, int32_t scaling_shift, int32_t min_value, int32_t max_value);
+    void svt_av1_fgn_add_chroma_noise_row_hbd_c(uint16_t *chroma, const uint16_t *luma, int32_t chroma_subsamp_x, const int32_t *grain, const int32_t *scaling_lut, int32_t width, int32_t luma_mult, int32_t mult, int32_t offset, int32_t max_index, int32_t scaling_shift, int32_t min_value, int32_t max_value);
+    RTCD_EXTERN void(*svt_av1_fgn_add_chroma_noise_row_hbd)(uint16_t *chroma, const uint16_t *luma, int32_t chroma_subsamp_x, const int32_t *grain, const int32_t *scaling_lut, int32_t width, int32_t luma_mult, int32_t mult, int32_t offset, int32_t max_index, int32_t scaling_shift, int32_t min_value, int32_t max_value);
 #ifdef ARCH_X86_64
 
     void svt_aom_blend_a64_vmask_sse4_1(uint8_t *dst, uint32_t dst_stride, const uint8_t *src0, uint32_t src0_stride, const uint8_t *src1, uint32_t src1_stride, const uint8_t *mask, int w, int h);
@@ -1097,8 +1109,12 @@ extern "C" {
 
     void svt_av1_filter_intra_edge_sse4_1(uint8_t *p, int32_t sz, int32_t strength);
 
+    void svt_av1_filter_intra_edge_avx2(uint8_t *p, int32_t sz, int32_t strength);
+
     void svt_av1_filter_intra_edge_high_sse4_1(uint16_t *p, int32_t sz, int32_t strength);
 
+    void svt_av1_filter_intra_edge_high_avx2(uint16_t *p, int32_t sz, int32_t strength);
+
     void svt_av1_upsample_intra_edge_sse4_1(uint8_t *p, int32_t sz);
 
     // AMIR
@@ -1252,6 +1268,8 @@ extern "C" {
 
     void svt_av1_selfguided_restoration_sse4_1(const uint8_t *dgd8, int32_t width, int32_t height, int32_t dgd_stride, int32_t *flt0, int32_t *flt1, int32_t flt_stride, int32_t sgr_params_idx, int32_t bit_depth, int32_t highbd);
     void svt_av1_selfguided_restoration_avx2(const uint8_t *dgd8, int32_t width, int32_t height, int32_t dgd_stride, int32_t *flt0, int32_t *flt1, int32_t flt_stride, int32_t sgr_params_idx, int32_t bit_depth, int32_t highbd);
+    void svt_av1_sgr_integral_images_avx2(const uint8_t *dgd8, int32_t width, int32_t height, int32_t dgd_stride, int32_t *C, int32_t *D, int32_t buf_stride, int32_t highbd);
+    void svt_av1_selfguided_restoration_from_ii_avx2(const uint8_t *dgd8, int32_t width, int32_t height, int32_t dgd_stride, const int32_t *C, const int32_t *D, int32_t *A, int32_t *B, int32_t buf_stride, int32_t *flt0, int32_t *flt1, int32_t flt_stride, int32_t sgr_params_idx, int32_t bit_depth, int32_t highbd);
 
     void svt_av1_convolve_2d_copy_sr_sse2(const uint8_t *src, int32_t src_stride, uint8_t *dst, int32_t dst_stride, int32_t w, int32_t h, InterpFilterParams *filter_params_x, InterpFilterParams *filter_params_y, const int32_t subpel_x_q4, const int32_t subpel_y_q4, ConvolveParams *conv_params);
     void svt_av1_convolve_2d_copy_sr_avx2(const uint8_t *src, int32_t src_stride, uint8_t *dst, int32_t dst_stride, int32_t w, int32_t h, InterpFilterParams *filter_params_x, InterpFilterParams *filter_params_y, const int32_t subpel_x_q4, const int32_t subpel_y_q4, ConvolveParams *conv_params);
@@ -1778,6 +1796,8 @@ extern "C" {
 
     void svt_aom_dc_predictor_32x8_sse2(uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left);
 
+    void svt_aom_dc_predictor_32x8_avx2(uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left);
+
     void svt_aom_dc_predictor_4x16_sse2(uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left);
 
     void svt_aom_dc_predictor_4x8_sse2(uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left);
@@ -1818,6 +1838,8 @@ extern "C" {
 
     void svt_aom_dc_left_predictor_32x8_sse2(uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left);
 
+    void svt_aom_dc_left_predictor_32x8_avx2(uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left);
+
     void svt_aom_dc_left_predictor_4x16_sse2(uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left);
 
     void svt_aom_dc_left_predictor_4x8_sse2(uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left);
@@ -1858,6 +1880,8 @@ extern "C" {
 
     void svt_aom_dc_top_predictor_32x8_sse2(uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left);
 
+    void svt_aom_dc_top_predictor_32x8_avx2(uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left);
+
     void svt_aom_dc_top_predictor_4x16_sse2(uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left);
 
     void svt_aom_dc_top_predictor_4x8_sse2(uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left);
@@ -1897,6 +1921,8 @@ extern "C" {
 
     void svt_aom_dc_128_predictor_32x8_sse2(uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left);
 
+    void svt_aom_dc_128_predictor_32x8_avx2(uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left);
+
     void svt_aom_dc_128_predictor_4x16_sse2(uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left);
 
     void svt_aom_dc_128_predictor_4x8_sse2(uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left);
@@ -2055,6 +2081,8 @@ extern "C" {
 
     void svt_aom_v_predictor_32x8_sse2(uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left);
 
+    void svt_aom_v_predictor_32x8_avx2(uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left);
+
     void svt_aom_v_predictor_4x16_sse2(uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left);
 
     void svt_aom_v_predictor_4x8_sse2(uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left);
@@ -2081,6 +2109,8 @@ extern "C" {
 
     void svt_aom_h_predictor_64x64_sse2(uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left);
 
+    void svt_aom_h_predictor_64x64_avx2(uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left);
+
     void svt_aom_h_predictor_16x32_sse2(uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left);
 
     void svt_aom_h_predictor_16x4_sse2(uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left);
@@ -2091,18 +2121,28 @@ extern "C" {
 
     void svt_aom_h_predictor_32x16_sse2(uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left);
 
+    void svt_aom_h_predictor_32x16_avx2(uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left);
+
     void svt_aom_h_predictor_32x64_sse2(uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left);
 
+    void svt_aom_h_predictor_32x64_avx2(uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left);
+
     void svt_aom_h_predictor_32x8_sse2(uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left);
 
+    void svt_aom_h_predictor_32x8_avx2(uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left);
+
     void svt_aom_h_predictor_4x16_sse2(uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left);
 
     void svt_aom_h_predictor_4x8_sse2(uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left);
 
     void svt_aom_h_predictor_64x16_sse2(uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left);
 
+    void svt_aom_h_predictor_64x16_avx2(uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left);
+
     void svt_aom_h_predictor_64x32_sse2(uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left);
 
+    void svt_aom_h_predictor_64x32_avx2(uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left);
+
     void svt_aom_h_predictor_8x16_sse2(uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left);
 
     void svt_aom_h_predictor_8x32_sse2(uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left);
@@ -2246,6 +2286,11 @@ extern "C" {
     uint32_t Log2f_ASM(uint32_t x);
 
     extern void svt_memcpy_intrin_sse (void  *dst_ptr, void  const *src_ptr, size_t size);
+
+    void svt_av1_fgn_add_luma_noise_row_avx2(uint8_t *luma, const int32_t *grain, const int32_t *scaling_lut, int32_t width, int32_t scaling_shift, int32_t min_value, int32_t max_value);
+    void svt_av1_fgn_add_luma_noise_row_hbd_avx2(uint16_t *luma, const int32_t *grain, const int32_t *scaling_lut, int32_t width, int32_t scaling_shift, int32_t min_value, int32_t max_value);
+    void svt_av1_fgn_add_chroma_noise_row_avx2(uint8_t *chroma, const uint8_t *luma, int32_t chroma_subsamp_x, const int32_t *grain, const int32_t *scaling_lut, int32_t width, int32_t luma_mult, int32_t mult, int32_t offset, int32_t max_index, int32_t scaling_shift, int32_t min_value, int32_t max_value);
+    void svt_av1_fgn_add_chroma_noise_row_hbd_avx2(uint16_t *chroma, const uint16_t *luma, int32_t chroma_subsamp_x, const int32_t *grain, const int32_t *scaling_lut, int32_t width, int32_t luma_mult, int32_t mult, int32_t offset, int32_t max_index, int32_t scaling_shift, int32_t min_value, int32_t max_value);
 #endif
 
 
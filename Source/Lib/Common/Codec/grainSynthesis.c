@@ -185,11 +185,8 @@ static const int32_t gaussian_sequence[2048] = {
 
 static const int32_t gauss_bits = 11;
 
-static int32_t luma_subblock_size_y = 32;
-static int32_t luma_subblock_size_x = 32;
-
-static int32_t chroma_subblock_size_y = 16;
-static int32_t chroma_subblock_size_x = 16;
+static const int32_t luma_subblock_size_y = 32;
+static const int32_t luma_subblock_size_x = 32;
 
 static const int32_t min_luma_legal_range = 16;
 static const int32_t max_luma_legal_range = 235;
@@ -197,15 +194,66 @@ static const int32_t max_luma_legal_range = 235;
 static const int32_t min_chroma_legal_range = 16;
 static const int32_t max_chroma_legal_range = 240;
 
-static int32_t scaling_lut_y[256];
-static int32_t scaling_lut_cb[256];
-static int32_t scaling_lut_cr[256];
-
-static int32_t grain_center;
-static int32_t grain_min;
-static int32_t grain_max;
+// padding to offset for AR coefficients
+static const int32_t left_pad   = 3;
+static const int32_t right_pad  = 3;
+static const int32_t top_pad    = 3;
+static const int32_t bottom_pad = 0;
+// maximum lag used for stabilization of AR coefficients
+static const int32_t ar_padding = 3;
+
+/**************************************
+ * FilmGrainContext
+ *   Picture wide state of a grain synthesis run. It is only read once the
+ *   grain templates and the scaling functions are generated, so that the
+ *   stripes of the picture can get their grain from several threads.
+ **************************************/
+typedef struct FilmGrainContext {
+    AomFilmGrain *params;
+    uint8_t      *luma;
+    uint8_t      *cb;
+    uint8_t      *cr;
+    int32_t       height;
+    int32_t       width;
+    int32_t       luma_stride;
+    int32_t       chroma_stride;
+    int32_t       use_high_bit_depth;
+    int32_t       chroma_subsamp_y;
+    int32_t       chroma_subsamp_x;
+    int32_t       chroma_subblock_size_y;
+    int32_t       chroma_subblock_size_x;
+
+    int32_t *luma_grain_block;
+    int32_t *cb_grain_block;
+    int32_t *cr_grain_block;
+    int32_t  luma_grain_stride;
+    int32_t  chroma_grain_stride;
+
+    // scaling functions indexed by the sample value, interpolated for high
+    // bit depths
+    int32_t *scaling_lut_y;
+    int32_t *scaling_lut_cb;
+    int32_t *scaling_lut_cr;
+
+    int32_t grain_min;
+    int32_t grain_max;
+} FilmGrainContext;
+
+/**************************************
+ * FilmGrainStripeBuffers
+ *   Grain overlap buffers carried from a block to the next one of a stripe
+ *   (col) and from a stripe to the next one (line).
+ **************************************/
+typedef struct FilmGrainStripeBuffers {
+    int32_t *y_line_buf;
+    int32_t *cb_line_buf;
+    int32_t *cr_line_buf;
+    int32_t *y_col_buf;
+    int32_t *cb_col_buf;
+    int32_t *cr_col_buf;
 
-static uint16_t random_register = 0; // random number generator register
+    uint16_t random_register; // random number generator register
+} FilmGrainStripeBuffers;
 
 //----------------------------------------------------------------------
 // todo: aomlib memory functions (to be replaced by Eb functions)
@@ -270,18 +318,8 @@ void svt_aom_free(void *memblk) {
 */
 //--------------------------------------------------------------------
 
-static void init_arrays(AomFilmGrain *params, int32_t luma_stride, int32_t chroma_stride,
-                        int32_t ***pred_pos_luma_p, int32_t ***pred_pos_chroma_p,
-                        int32_t **luma_grain_block, int32_t **cb_grain_block,
-                        int32_t **cr_grain_block, int32_t **y_line_buf, int32_t **cb_line_buf,
-                        int32_t **cr_line_buf, int32_t **y_col_buf, int32_t **cb_col_buf,
-                        int32_t **cr_col_buf, int32_t luma_grain_samples,
-                        int32_t chroma_grain_samples, int32_t chroma_subsamp_y,
-                        int32_t chroma_subsamp_x) {
-    memset(scaling_lut_y, 0, sizeof(*scaling_lut_y) * 256);
-    memset(scaling_lut_cb, 0, sizeof(*scaling_lut_cb) * 256);
-    memset(scaling_lut_cr, 0, sizeof(*scaling_lut_cr) * 256);
-
+static void init_pred_pos(AomFilmGrain *params, int32_t ***pred_pos_luma_p,
+                          int32_t ***pred_pos_chroma_p) {
     int32_t num_pos_luma   = 2 * params->ar_coeff_lag * (params->ar_coeff_lag + 1);
     int32_t num_pos_chroma = num_pos_luma;
     if (params->num_y_points > 0)
@@ -339,31 +377,10 @@ static void init_arrays(AomFilmGrain *params, int32_t luma_stride, int32_t chrom
 
     *pred_pos_luma_p   = pred_pos_luma;
     *pred_pos_chroma_p = pred_pos_chroma;
-
-    *y_line_buf  = (int32_t *)malloc(sizeof(**y_line_buf) * luma_stride * 2);
-    *cb_line_buf = (int32_t *)malloc(sizeof(**cb_line_buf) * chroma_stride *
-                                     (2 >> chroma_subsamp_y));
-    *cr_line_buf = (int32_t *)malloc(sizeof(**cr_line_buf) * chroma_stride *
-                                     (2 >> chroma_subsamp_y));
-
-    *y_col_buf  = (int32_t *)malloc(sizeof(**y_col_buf) * (luma_subblock_size_y + 2) * 2);
-    *cb_col_buf = (int32_t *)malloc(sizeof(**cb_col_buf) *
-                                    (chroma_subblock_size_y + (2 >> chroma_subsamp_y)) *
-                                    (2 >> chroma_subsamp_x));
-    *cr_col_buf = (int32_t *)malloc(sizeof(**cr_col_buf) *
-                                    (chroma_subblock_size_y + (2 >> chroma_subsamp_y)) *
-                                    (2 >> chroma_subsamp_x));
-
-    *luma_grain_block = (int32_t *)malloc(sizeof(**luma_grain_block) * luma_grain_samples);
-    *cb_grain_block   = (int32_t *)malloc(sizeof(**cb_grain_block) * chroma_grain_samples);
-    *cr_grain_block   = (int32_t *)malloc(sizeof(**cr_grain_block) * chroma_grain_samples);
 }
 
-static void dealloc_arrays(AomFilmGrain *params, int32_t ***pred_pos_luma,
-                           int32_t ***pred_pos_chroma, int32_t **luma_grain_block,
-                           int32_t **cb_grain_block, int32_t **cr_grain_block, int32_t **y_line_buf,
-                           int32_t **cb_line_buf, int32_t **cr_line_buf, int32_t **y_col_buf,
-                           int32_t **cb_col_buf, int32_t **cr_col_buf) {
+static void dealloc_pred_pos(AomFilmGrain *params, int32_t ***pred_pos_luma,
+                             int32_t ***pred_pos_chroma) {
     int32_t num_pos_luma   = 2 * params->ar_coeff_lag * (params->ar_coeff_lag + 1);
     int32_t num_pos_chroma = num_pos_luma;
     if (params->num_y_points > 0)
@@ -374,56 +391,68 @@ static void dealloc_arrays(AomFilmGrain *params, int32_t ***pred_pos_luma,
 
     for (int32_t row = 0; row < num_pos_chroma; row++) free((*pred_pos_chroma)[row]);
     free((*pred_pos_chroma));
+}
 
-    free(*y_line_buf);
-
-    free(*cb_line_buf);
-
-    free(*cr_line_buf);
-
-    free(*y_col_buf);
-
-    free(*cb_col_buf);
-
-    free(*cr_col_buf);
-
-    free(*luma_grain_block);
-
-    free(*cb_grain_block);
+static void init_stripe_buffers(const FilmGrainContext *ctx, FilmGrainStripeBuffers *bufs) {
+    const int32_t chroma_subsamp_y = ctx->chroma_subsamp_y;
+    const int32_t chroma_subsamp_x = ctx->chroma_subsamp_x;
+
+    bufs->y_line_buf  = (int32_t *)malloc(sizeof(*bufs->y_line_buf) * ctx->luma_stride * 2);
+    bufs->cb_line_buf = (int32_t *)malloc(sizeof(*bufs->cb_line_buf) * ctx->chroma_stride *
+                                          (2 >> chroma_subsamp_y));
+    bufs->cr_line_buf = (int32_t *)malloc(sizeof(*bufs->cr_line_buf) * ctx->chroma_stride *
+                                          (2 >> chroma_subsamp_y));
+
+    bufs->y_col_buf  = (int32_t *)malloc(sizeof(*bufs->y_col_buf) * (luma_subblock_size_y + 2) * 2);
+    bufs->cb_col_buf = (int32_t *)malloc(
+        sizeof(*bufs->cb_col_buf) * (ctx->chroma_subblock_size_y + (2 >> chroma_subsamp_y)) *
+        (2 >> chroma_subsamp_x));
+    bufs->cr_col_buf = (int32_t *)malloc(
+        sizeof(*bufs->cr_col_buf) * (ctx->chroma_subblock_size_y + (2 >> chroma_subsamp_y)) *
+        (2 >> chroma_subsamp_x));
+    ASSERT(bufs->y_line_buf && bufs->cb_line_buf && bufs->cr_line_buf && bufs->y_col_buf &&
+           bufs->cb_col_buf && bufs->cr_col_buf);
+}
 
-    free(*cr_grain_block);
+static void dealloc_stripe_buffers(FilmGrainStripeBuffers *bufs) {
+    free(bufs->y_line_buf);
+    free(bufs->cb_line_buf);
+    free(bufs->cr_line_buf);
+    free(bufs->y_col_buf);
+    free(bufs->cb_col_buf);
+    free(bufs->cr_col_buf);
 }
 
 // get a number between 0 and 2^bits - 1
-static INLINE int32_t get_random_number(int32_t bits) {
+static INLINE int32_t get_random_number(uint16_t *random_register, int32_t bits) {
     uint16_t bit;
-    bit = ((random_register >> 0) ^ (random_register >> 1) ^ (random_register >> 3) ^
-           (random_register >> 12)) &
+    bit = ((*random_register >> 0) ^ (*random_register >> 1) ^ (*random_register >> 3) ^
+           (*random_register >> 12)) &
         1;
-    random_register = (random_register >> 1) | (bit << 15);
-    return (random_register >> (16 - bits)) & ((1 << bits) - 1);
+    *random_register = (*random_register >> 1) | (bit << 15);
+    return (*random_register >> (16 - bits)) & ((1 << bits) - 1);
 }
 
-static void init_random_generator(int32_t luma_line, uint16_t seed) {
+static uint16_t init_random_generator(int32_t luma_line, uint16_t seed) {
     // same for the picture
 
     uint16_t msb = (seed >> 8) & 255;
     uint16_t lsb = seed & 255;
 
-    random_register = (msb << 8) + lsb;
+    uint16_t random_register = (msb << 8) + lsb;
 
     //  changes for each row
     int32_t luma_num = luma_line >> 5;
 
     random_register ^= ((luma_num * 37 + 178) & 255) << 8;
     random_register ^= ((luma_num * 173 + 105) & 255);
+    return random_register;
 }
 
 static void generate_luma_grain_block(AomFilmGrain *params, int32_t **pred_pos_luma,
                                       int32_t *luma_grain_block, int32_t luma_block_size_y,
                                       int32_t luma_block_size_x, int32_t luma_grain_stride,
-                                      int32_t left_pad, int32_t top_pad, int32_t right_pad,
-                                      int32_t bottom_pad) {
+                                      int32_t grain_min, int32_t grain_max) {
     if (params->num_y_points == 0)
         return;
 
@@ -433,10 +462,11 @@ static void generate_luma_grain_block(AomFilmGrain *params, int32_t **pred_pos_l
     int32_t num_pos_luma    = 2 * params->ar_coeff_lag * (params->ar_coeff_lag + 1);
     int32_t rounding_offset = (1 << (params->ar_coeff_shift - 1));
 
+    uint16_t random_register = params->random_seed;
     for (int32_t i = 0; i < luma_block_size_y; i++)
         for (int32_t j = 0; j < luma_block_size_x; j++)
             luma_grain_block[i * luma_grain_stride + j] =
-                (gaussian_sequence[get_random_number(gauss_bits)] +
+                (gaussian_sequence[get_random_number(&random_register, gauss_bits)] +
                  ((1 << gauss_sec_shift) >> 1)) >>
                 gauss_sec_shift;
 
@@ -457,13 +487,13 @@ static void generate_luma_grain_block(AomFilmGrain *params, int32_t **pred_pos_l
         }
 }
 
-static void generate_chroma_grain_blocks(
-    AomFilmGrain *params,
-    //                                  int32_t** pred_pos_luma,
-    int32_t **pred_pos_chroma, int32_t *luma_grain_block, int32_t *cb_grain_block,
-    int32_t *cr_grain_block, int32_t luma_grain_stride, int32_t chroma_block_size_y,
-    int32_t chroma_block_size_x, int32_t chroma_grain_stride, int32_t left_pad, int32_t top_pad,
-    int32_t right_pad, int32_t bottom_pad, int32_t chroma_subsamp_y, int32_t chroma_subsamp_x) {
+static void generate_chroma_grain_blocks(AomFilmGrain *params, int32_t **pred_pos_chroma,
+                                         int32_t *luma_grain_block, int32_t *cb_grain_block,
+                                         int32_t *cr_grain_block, int32_t luma_grain_stride,
+                                         int32_t chroma_block_size_y, int32_t chroma_block_size_x,
+                                         int32_t chroma_grain_stride, int32_t grain_min,
+                                         int32_t grain_max, int32_t chroma_subsamp_y,
+                                         int32_t chroma_subsamp_x) {
     int32_t bit_depth       = params->bit_depth;
     int32_t gauss_sec_shift = 12 - bit_depth + params->grain_scale_shift;
 
@@ -475,24 +505,24 @@ static void generate_chroma_grain_blocks(
     int chroma_grain_block_size = chroma_block_size_y * chroma_grain_stride;
 
     if (params->num_cb_points || params->chroma_scaling_from_luma) {
-        init_random_generator(7 << 5, params->random_seed);
+        uint16_t random_register = init_random_generator(7 << 5, params->random_seed);
 
         for (int32_t i = 0; i < chroma_block_size_y; i++)
             for (int32_t j = 0; j < chroma_block_size_x; j++)
                 cb_grain_block[i * chroma_grain_stride + j] =
-                    (gaussian_sequence[get_random_number(gauss_bits)] +
+                    (gaussian_sequence[get_random_number(&random_register, gauss_bits)] +
                      ((1 << gauss_sec_shift) >> 1)) >>
                     gauss_sec_shift;
     } else {
         memset(cb_grain_block, 0, sizeof(*cb_grain_block) * chroma_grain_block_size);
     }
     if (params->num_cr_points || params->chroma_scaling_from_luma) {
-        init_random_generator(11 << 5, params->random_seed);
+        uint16_t random_register = init_random_generator(11 << 5, params->random_seed);
 
         for (int32_t i = 0; i < chroma_block_size_y; i++)
             for (int32_t j = 0; j < chroma_block_size_x; j++)
                 cr_grain_block[i * chroma_grain_stride + j] =
-                    (gaussian_sequence[get_random_number(gauss_bits)] +
+                    (gaussian_sequence[get_random_number(&random_register, gauss_bits)] +
                      ((1 << gauss_sec_shift) >> 1)) >>
                     gauss_sec_shift;
     } else {
@@ -586,12 +616,90 @@ static int32_t scale_lut(int32_t *scaling_lut, int32_t index, int32_t bit_depth)
              (bit_depth - 8));
 }
 
-static void add_noise_to_block(AomFilmGrain *params, uint8_t *luma, uint8_t *cb, uint8_t *cr,
-                               int32_t luma_stride, int32_t chroma_stride, int32_t *luma_grain,
-                               int32_t *cb_grain, int32_t *cr_grain, int32_t luma_grain_stride,
+// expands the 8 bit scaling function to all the values of bit_depth samples
+static void init_scaling_lut(int32_t scaling_points[][2], int32_t num_points, int32_t bit_depth,
+                             int32_t *scaling_lut) {
+    int32_t scaling_lut_8bit[256];
+    memset(scaling_lut_8bit, 0, sizeof(scaling_lut_8bit));
+    init_scaling_function(scaling_points, num_points, scaling_lut_8bit);
+    for (int32_t index = 0; index < (256 << (bit_depth - 8)); index++)
+        scaling_lut[index] = scale_lut(scaling_lut_8bit, index, bit_depth);
+}
+
+void svt_av1_fgn_add_luma_noise_row_c(uint8_t *luma, const int32_t *grain,
+                                      const int32_t *scaling_lut, int32_t width,
+                                      int32_t scaling_shift, int32_t min_value, int32_t max_value) {
+    const int32_t rounding_offset = 1 << (scaling_shift - 1);
+    for (int32_t j = 0; j < width; j++)
+        luma[j] = clamp(
+            luma[j] + ((scaling_lut[luma[j]] * grain[j] + rounding_offset) >> scaling_shift),
+            min_value,
+            max_value);
+}
+
+void svt_av1_fgn_add_luma_noise_row_hbd_c(uint16_t *luma, const int32_t *grain,
+                                          const int32_t *scaling_lut, int32_t width,
+                                          int32_t scaling_shift, int32_t min_value,
+                                          int32_t max_value) {
+    const int32_t rounding_offset = 1 << (scaling_shift - 1);
+    for (int32_t j = 0; j < width; j++)
+        luma[j] = clamp(
+            luma[j] + ((scaling_lut[luma[j]] * grain[j] + rounding_offset) >> scaling_shift),
+            min_value,
+            max_value);
+}
+
+void svt_av1_fgn_add_chroma_noise_row_c(uint8_t *chroma, const uint8_t *luma,
+                                        int32_t chroma_subsamp_x, const int32_t *grain,
+                                        const int32_t *scaling_lut, int32_t width,
+                                        int32_t luma_mult, int32_t mult, int32_t offset,
+                                        int32_t max_index, int32_t scaling_shift,
+                                        int32_t min_value, int32_t max_value) {
+    const int32_t rounding_offset = 1 << (scaling_shift - 1);
+    for (int32_t j = 0; j < width; j++) {
+        const int32_t average_luma = chroma_subsamp_x
+            ? (luma[j << 1] + luma[(j << 1) + 1] + 1) >> 1
+            : luma[j];
+        const int32_t index = clamp(
+            ((average_luma * luma_mult + mult * chroma[j]) >> 6) + offset, 0, max_index);
+        chroma[j] = clamp(
+            chroma[j] + ((scaling_lut[index] * grain[j] + rounding_offset) >> scaling_shift),
+            min_value,
+            max_value);
+    }
+}
+
+void svt_av1_fgn_add_chroma_noise_row_hbd_c(uint16_t *chroma, const uint16_t *luma,
+                                            int32_t chroma_subsamp_x, const int32_t *grain,
+                                            const int32_t *scaling_lut, int32_t width,
+                                            int32_t luma_mult, int32_t mult, int32_t offset,
+                                            int32_t max_index, int32_t scaling_shift,
+                                            int32_t min_value, int32_t max_value) {
+    const int32_t rounding_offset = 1 << (scaling_shift - 1);
+    for (int32_t j = 0; j < width; j++) {
+        const int32_t average_luma = chroma_subsamp_x
+            ? (luma[j << 1] + luma[(j << 1) + 1] + 1) >> 1
+            : luma[j];
+        const int32_t index = clamp(
+            ((average_luma * luma_mult + mult * chroma[j]) >> 6) + offset, 0, max_index);
+        chroma[j] = clamp(
+            chroma[j] + ((scaling_lut[index] * grain[j] + rounding_offset) >> scaling_shift),
+            min_value,
+            max_value);
+    }
+}
+
+static void add_noise_to_block(const FilmGrainContext *ctx, uint8_t *luma, uint8_t *cb,
+                               uint8_t *cr, int32_t *luma_grain, int32_t *cb_grain,
+                               int32_t *cr_grain, int32_t luma_grain_stride,
                                int32_t chroma_grain_stride, int32_t half_luma_height,
-                               int32_t half_luma_width, int32_t bit_depth, int32_t chroma_subsamp_y,
-                               int32_t chroma_subsamp_x) {
+                               int32_t half_luma_width) {
+    const AomFilmGrain *params           = ctx->params;
+    const int32_t       luma_stride      = ctx->luma_stride;
+    const int32_t       chroma_stride    = ctx->chroma_stride;
+    const int32_t       chroma_subsamp_y = ctx->chroma_subsamp_y;
+    const int32_t       chroma_subsamp_x = ctx->chroma_subsamp_x;
+
     int32_t cb_mult      = params->cb_mult - 128; // fixed scale
     int32_t cb_luma_mult = params->cb_luma_mult - 128; // fixed scale
     int32_t cb_offset    = params->cb_offset - 256;
@@ -600,8 +708,6 @@ static void add_noise_to_block(AomFilmGrain *params, uint8_t *luma, uint8_t *cb,
     int32_t cr_luma_mult = params->cr_luma_mult - 128; // fixed scale
     int32_t cr_offset    = params->cr_offset - 256;
 
-    int32_t rounding_offset = (1 << (params->scaling_shift - 1));
-
     int32_t apply_y  = params->num_y_points > 0 ? 1 : 0;
     int32_t apply_cb = (params->num_cb_points > 0 || params->chroma_scaling_from_luma) ? 1 : 0;
     int32_t apply_cr = (params->num_cr_points > 0 || params->chroma_scaling_from_luma) ? 1 : 0;
@@ -629,77 +735,63 @@ static void add_noise_to_block(AomFilmGrain *params, uint8_t *luma, uint8_t *cb,
         max_luma = max_chroma = 255;
     }
 
+    const int32_t chroma_width = half_luma_width << (1 - chroma_subsamp_x);
     for (int32_t i = 0; i < (half_luma_height << (1 - chroma_subsamp_y)); i++) {
-        for (int32_t j = 0; j < (half_luma_width << (1 - chroma_subsamp_x)); j++) {
-            int32_t average_luma = 0;
-            if (chroma_subsamp_x) {
-                average_luma =
-                    (luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x)] +
-                     luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x) + 1] +
-                     1) >>
-                    1;
-            } else
-                average_luma = luma[(i << chroma_subsamp_y) * luma_stride + j];
-            if (apply_cb) {
-                cb[i * chroma_stride + j] = clamp(
-                    cb[i * chroma_stride + j] +
-                        ((scale_lut(scaling_lut_cb,
-                                    clamp(((average_luma * cb_luma_mult +
-                                            cb_mult * cb[i * chroma_stride + j]) >>
-                                           6) +
-                                              cb_offset,
-                                          0,
-                                          (256 << (bit_depth - 8)) - 1),
-                                    8) *
-                              cb_grain[i * chroma_grain_stride + j] +
-                          rounding_offset) >>
-                         params->scaling_shift),
-                    min_chroma,
-                    max_chroma);
-            }
-
-            if (apply_cr) {
-                cr[i * chroma_stride + j] = clamp(
-                    cr[i * chroma_stride + j] +
-                        ((scale_lut(scaling_lut_cr,
-                                    clamp(((average_luma * cr_luma_mult +
-                                            cr_mult * cr[i * chroma_stride + j]) >>
-                                           6) +
-                                              cr_offset,
-                                          0,
-                                          (256 << (bit_depth - 8)) - 1),
-                                    8) *
-                              cr_grain[i * chroma_grain_stride + j] +
-                          rounding_offset) >>
-                         params->scaling_shift),
-                    min_chroma,
-                    max_chroma);
-            }
-        }
+        const uint8_t *luma_row = luma + (i << chroma_subsamp_y) * luma_stride;
+        if (apply_cb)
+            svt_av1_fgn_add_chroma_noise_row(cb + i * chroma_stride,
+                                             luma_row,
+                                             chroma_subsamp_x,
+                                             cb_grain + i * chroma_grain_stride,
+                                             ctx->scaling_lut_cb,
+                                             chroma_width,
+                                             cb_luma_mult,
+                                             cb_mult,
+                                             cb_offset,
+                                             255,
+                                             params->scaling_shift,
+                                             min_chroma,
+                                             max_chroma);
+        if (apply_cr)
+            svt_av1_fgn_add_chroma_noise_row(cr + i * chroma_stride,
+                                             luma_row,
+                                             chroma_subsamp_x,
+                                             cr_grain + i * chroma_grain_stride,
+                                             ctx->scaling_lut_cr,
+                                             chroma_width,
+                                             cr_luma_mult,
+                                             cr_mult,
+                                             cr_offset,
+                                             255,
+                                             params->scaling_shift,
+                                             min_chroma,
+                                             max_chroma);
     }
 
     if (apply_y) {
-        for (int32_t i = 0; i < (half_luma_height << 1); i++) {
-            for (int32_t j = 0; j < (half_luma_width << 1); j++) {
-                luma[i * luma_stride + j] = clamp(
-                    luma[i * luma_stride + j] +
-                        ((scale_lut(scaling_lut_y, luma[i * luma_stride + j], 8) *
-                              luma_grain[i * luma_grain_stride + j] +
-                          rounding_offset) >>
-                         params->scaling_shift),
-                    min_luma,
-                    max_luma);
-            }
-        }
+        for (int32_t i = 0; i < (half_luma_height << 1); i++)
+            svt_av1_fgn_add_luma_noise_row(luma + i * luma_stride,
+                                           luma_grain + i * luma_grain_stride,
+                                           ctx->scaling_lut_y,
+                                           half_luma_width << 1,
+                                           params->scaling_shift,
+                                           min_luma,
+                                           max_luma);
     }
 }
 
-static void add_noise_to_block_hbd(AomFilmGrain *params, uint16_t *luma, uint16_t *cb, uint16_t *cr,
-                                   int32_t luma_stride, int32_t chroma_stride, int32_t *luma_grain,
-                                   int32_t *cb_grain, int32_t *cr_grain, int32_t luma_grain_stride,
+static void add_noise_to_block_hbd(const FilmGrainContext *ctx, uint16_t *luma, uint16_t *cb,
+                                   uint16_t *cr, int32_t *luma_grain, int32_t *cb_grain,
+                                   int32_t *cr_grain, int32_t luma_grain_stride,
                                    int32_t chroma_grain_stride, int32_t half_luma_height,
-                                   int32_t half_luma_width, int32_t bit_depth,
-                                   int32_t chroma_subsamp_y, int32_t chroma_subsamp_x) {
+                                   int32_t half_luma_width) {
+    const AomFilmGrain *params           = ctx->params;
+    const int32_t       bit_depth        = params->bit_depth;
+    const int32_t       luma_stride      = ctx->luma_stride;
+    const int32_t       chroma_stride    = ctx->chroma_stride;
+    const int32_t       chroma_subsamp_y = ctx->chroma_subsamp_y;
+    const int32_t       chroma_subsamp_x = ctx->chroma_subsamp_x;
+
     int32_t cb_mult      = params->cb_mult - 128; // fixed scale
     int32_t cb_luma_mult = params->cb_luma_mult - 128; // fixed scale
     // offset value depends on the bit depth
@@ -710,8 +802,6 @@ static void add_noise_to_block_hbd(AomFilmGrain *params, uint16_t *luma, uint16_
     // offset value depends on the bit depth
     int32_t cr_offset = (params->cr_offset << (bit_depth - 8)) - (1 << bit_depth);
 
-    int32_t rounding_offset = (1 << (params->scaling_shift - 1));
-
     int32_t apply_y  = params->num_y_points > 0 ? 1 : 0;
     int32_t apply_cb = params->num_cb_points > 0 ? 1 : 0;
     int32_t apply_cr = params->num_cr_points > 0 ? 1 : 0;
@@ -739,67 +829,48 @@ static void add_noise_to_block_hbd(AomFilmGrain *params, uint16_t *luma, uint16_
         max_luma = max_chroma = (256 << (bit_depth - 8)) - 1;
     }
 
+    const int32_t chroma_width = half_luma_width << (1 - chroma_subsamp_x);
     for (int32_t i = 0; i < (half_luma_height << (1 - chroma_subsamp_y)); i++) {
-        for (int32_t j = 0; j < (half_luma_width << (1 - chroma_subsamp_x)); j++) {
-            int32_t average_luma = 0;
-            if (chroma_subsamp_x) {
-                average_luma =
-                    (luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x)] +
-                     luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x) + 1] +
-                     1) >>
-                    1;
-            } else
-                average_luma = luma[(i << chroma_subsamp_y) * luma_stride + j];
-            if (apply_cb) {
-                cb[i * chroma_stride + j] = clamp(
-                    cb[i * chroma_stride + j] +
-                        ((scale_lut(scaling_lut_cb,
-                                    clamp(((average_luma * cb_luma_mult +
-                                            cb_mult * cb[i * chroma_stride + j]) >>
-                                           6) +
-                                              cb_offset,
-                                          0,
-                                          (256 << (bit_depth - 8)) - 1),
-                                    bit_depth) *
-                              cb_grain[i * chroma_grain_stride + j] +
-                          rounding_offset) >>
-                         params->scaling_shift),
-                    min_chroma,
-                    max_chroma);
-            }
-            if (apply_cr) {
-                cr[i * chroma_stride + j] = clamp(
-                    cr[i * chroma_stride + j] +
-                        ((scale_lut(scaling_lut_cr,
-                                    clamp(((average_luma * cr_luma_mult +
-                                            cr_mult * cr[i * chroma_stride + j]) >>
-                                           6) +
-                                              cr_offset,
-                                          0,
-                                          (256 << (bit_depth - 8)) - 1),
-                                    bit_depth) *
-                              cr_grain[i * chroma_grain_stride + j] +
-                          rounding_offset) >>
-                         params->scaling_shift),
-                    min_chroma,
-                    max_chroma);
-            }
-        }
+        const uint16_t *luma_row = luma + (i << chroma_subsamp_y) * luma_stride;
+        if (apply_cb)
+            svt_av1_fgn_add_chroma_noise_row_hbd(cb + i * chroma_stride,
+                                                 luma_row,
+                                                 chroma_subsamp_x,
+                                                 cb_grain + i * chroma_grain_stride,
+                                                 ctx->scaling_lut_cb,
+                                                 chroma_width,
+                                                 cb_luma_mult,
+                                                 cb_mult,
+                                                 cb_offset,
+                                                 (256 << (bit_depth - 8)) - 1,
+                                                 params->scaling_shift,
+                                                 min_chroma,
+                                                 max_chroma);
+        if (apply_cr)
+            svt_av1_fgn_add_chroma_noise_row_hbd(cr + i * chroma_stride,
+                                                 luma_row,
+                                                 chroma_subsamp_x,
+                                                 cr_grain + i * chroma_grain_stride,
+                                                 ctx->scaling_lut_cr,
+                                                 chroma_width,
+                                                 cr_luma_mult,
+                                                 cr_mult,
+                                                 cr_offset,
+                                                 (256 << (bit_depth - 8)) - 1,
+                                                 params->scaling_shift,
+                                                 min_chroma,
+                                                 max_chroma);
     }
 
     if (apply_y) {
-        for (int32_t i = 0; i < (half_luma_height << 1); i++) {
-            for (int32_t j = 0; j < (half_luma_width << 1); j++) {
-                luma[i * luma_stride + j] = clamp(
-                    luma[i * luma_stride + j] +
-                        ((scale_lut(scaling_lut_y, luma[i * luma_stride + j], bit_depth) *
-                              luma_grain[i * luma_grain_stride + j] +
-                          rounding_offset) >>
-                         params->scaling_shift),
-                    min_luma,
-                    max_luma);
-            }
-        }
+        for (int32_t i = 0; i < (half_luma_height << 1); i++)
+            svt_av1_fgn_add_luma_noise_row_hbd(luma + i * luma_stride,
+                                               luma_grain + i * luma_grain_stride,
+                                               ctx->scaling_lut_y,
+                                               half_luma_width << 1,
+                                               params->scaling_shift,
+                                               min_luma,
+                                               max_luma);
     }
 }
 
@@ -897,7 +968,8 @@ static void copy_area(int32_t *src, int32_t src_stride, int32_t *dst, int32_t ds
 
 static void ver_boundary_overlap(int32_t *left_block, int32_t left_stride, int32_t *right_block,
                                  int32_t right_stride, int32_t *dst_block, int32_t dst_stride,
-                                 int32_t width, int32_t height) {
+                                 int32_t width, int32_t height, int32_t grain_min,
+                                 int32_t grain_max) {
     if (width == 1) {
         while (height) {
             *dst_block = clamp(
@@ -923,68 +995,432 @@ static void ver_boundary_overlap(int32_t *left_block, int32_t left_stride, int32
     }
 }
 
+// blends a row of the top and the bottom grain with the given weights, the
+// rows being independent, the loop vectorizes
+static INLINE void hor_boundary_overlap_row(const int32_t *top, int32_t top_weight,
+                                            const int32_t *bottom, int32_t bottom_weight,
+                                            int32_t *dst, int32_t width, int32_t grain_min,
+                                            int32_t grain_max) {
+    for (int32_t j = 0; j < width; j++)
+        dst[j] = clamp(
+            (top_weight * top[j] + bottom_weight * bottom[j] + 16) >> 5, grain_min, grain_max);
+}
+
 static void hor_boundary_overlap(int32_t *top_block, int32_t top_stride, int32_t *bottom_block,
                                  int32_t bottom_stride, int32_t *dst_block, int32_t dst_stride,
-                                 int32_t width, int32_t height) {
+                                 int32_t width, int32_t height, int32_t grain_min,
+                                 int32_t grain_max) {
     if (height == 1) {
-        while (width) {
-            *dst_block = clamp(
-                (*top_block * 23 + *bottom_block * 22 + 16) >> 5, grain_min, grain_max);
-            ++top_block;
-            ++bottom_block;
-            ++dst_block;
-            --width;
-        }
+        hor_boundary_overlap_row(
+            top_block, 23, bottom_block, 22, dst_block, width, grain_min, grain_max);
         return;
     } else if (height == 2) {
-        while (width) {
-            dst_block[0] = clamp(
-                (27 * top_block[0] + 17 * bottom_block[0] + 16) >> 5, grain_min, grain_max);
-            dst_block[dst_stride] = clamp(
-                (17 * top_block[top_stride] + 27 * bottom_block[bottom_stride] + 16) >> 5,
-                grain_min,
-                grain_max);
-            ++top_block;
-            ++bottom_block;
-            ++dst_block;
-            --width;
-        }
+        hor_boundary_overlap_row(
+            top_block, 27, bottom_block, 17, dst_block, width, grain_min, grain_max);
+        hor_boundary_overlap_row(top_block + top_stride,
+                                 17,
+                                 bottom_block + bottom_stride,
+                                 27,
+                                 dst_block + dst_stride,
+                                 width,
+                                 grain_min,
+                                 grain_max);
         return;
     }
 }
 
-void svt_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb, uint8_t *cr,
-                                int32_t height, int32_t width, int32_t luma_stride,
-                                int32_t chroma_stride, int32_t use_high_bit_depth,
-                                int32_t chroma_subsamp_y, int32_t chroma_subsamp_x) {
-    int32_t **pred_pos_luma;
-    int32_t **pred_pos_chroma;
-    int32_t  *luma_grain_block;
-    int32_t  *cb_grain_block;
-    int32_t  *cr_grain_block;
+static void add_noise_to_block_any(const FilmGrainContext *ctx, uint8_t *luma, uint8_t *cb,
+                                   uint8_t *cr, int32_t *luma_grain, int32_t *cb_grain,
+                                   int32_t *cr_grain, int32_t luma_grain_stride,
+                                   int32_t chroma_grain_stride, int32_t half_luma_height,
+                                   int32_t half_luma_width) {
+    if (ctx->use_high_bit_depth)
+        add_noise_to_block_hbd(ctx,
+                               (uint16_t *)luma,
+                               (uint16_t *)cb,
+                               (uint16_t *)cr,
+                               luma_grain,
+                               cb_grain,
+                               cr_grain,
+                               luma_grain_stride,
+                               chroma_grain_stride,
+                               half_luma_height,
+                               half_luma_width);
+    else
+        add_noise_to_block(ctx,
+                           luma,
+                           cb,
+                           cr,
+                           luma_grain,
+                           cb_grain,
+                           cr_grain,
+                           luma_grain_stride,
+                           chroma_grain_stride,
+                           half_luma_height,
+                           half_luma_width);
+}
 
-    int32_t *y_line_buf;
-    int32_t *cb_line_buf;
-    int32_t *cr_line_buf;
+/**************************************
+ * add_film_grain_stripe
+ *   Adds the grain to the 32 luma rows starting at luma row 2 * y. When
+ *   apply_noise is FALSE, only the overlap buffers are updated: the line
+ *   buffers then hold what the stripe below needs, so that a thread can start
+ *   at any stripe by replaying the one above it.
+ **************************************/
+static void add_film_grain_stripe(const FilmGrainContext *ctx, FilmGrainStripeBuffers *bufs,
+                                  int32_t y, Bool apply_noise) {
+    const AomFilmGrain *params                 = ctx->params;
+    const int32_t       height                 = ctx->height;
+    const int32_t       width                  = ctx->width;
+    const int32_t       luma_stride            = ctx->luma_stride;
+    const int32_t       chroma_stride          = ctx->chroma_stride;
+    const int32_t       chroma_subsamp_y       = ctx->chroma_subsamp_y;
+    const int32_t       chroma_subsamp_x       = ctx->chroma_subsamp_x;
+    const int32_t       chroma_subblock_size_y = ctx->chroma_subblock_size_y;
+    const int32_t       chroma_subblock_size_x = ctx->chroma_subblock_size_x;
+    const int32_t       luma_grain_stride      = ctx->luma_grain_stride;
+    const int32_t       chroma_grain_stride    = ctx->chroma_grain_stride;
+    const int32_t       grain_min              = ctx->grain_min;
+    const int32_t       grain_max              = ctx->grain_max;
+    const int32_t       overlap                = params->overlap_flag;
+    const int32_t       pel_shift              = ctx->use_high_bit_depth;
+    uint8_t            *luma                   = ctx->luma;
+    uint8_t            *cb                     = ctx->cb;
+    uint8_t            *cr                     = ctx->cr;
+    int32_t            *luma_grain_block       = ctx->luma_grain_block;
+    int32_t            *cb_grain_block         = ctx->cb_grain_block;
+    int32_t            *cr_grain_block         = ctx->cr_grain_block;
+    int32_t            *y_line_buf             = bufs->y_line_buf;
+    int32_t            *cb_line_buf            = bufs->cb_line_buf;
+    int32_t            *cr_line_buf            = bufs->cr_line_buf;
+    int32_t            *y_col_buf              = bufs->y_col_buf;
+    int32_t            *cb_col_buf             = bufs->cb_col_buf;
+    int32_t            *cr_col_buf             = bufs->cr_col_buf;
+
+    bufs->random_register = init_random_generator(y * 2, params->random_seed);
+
+    for (int32_t x = 0; x < width / 2; x += (luma_subblock_size_x >> 1)) {
+        int32_t offset_y = get_random_number(&bufs->random_register, 8);
+        int32_t offset_x = (offset_y >> 4) & 15;
+        offset_y &= 15;
+
+        int32_t luma_offset_y = left_pad + 2 * ar_padding + (offset_y << 1);
+        int32_t luma_offset_x = top_pad + 2 * ar_padding + (offset_x << 1);
+
+        int32_t chroma_offset_y = top_pad + (2 >> chroma_subsamp_y) * ar_padding +
+            offset_y * (2 >> chroma_subsamp_y);
+        int32_t chroma_offset_x = left_pad + (2 >> chroma_subsamp_x) * ar_padding +
+            offset_x * (2 >> chroma_subsamp_x);
+
+        if (overlap && x) {
+            ver_boundary_overlap(y_col_buf,
+                                 2,
+                                 luma_grain_block + luma_offset_y * luma_grain_stride +
+                                     luma_offset_x,
+                                 luma_grain_stride,
+                                 y_col_buf,
+                                 2,
+                                 2,
+                                 AOMMIN(luma_subblock_size_y + 2, height - (y << 1)),
+                                 grain_min,
+                                 grain_max);
+
+            ver_boundary_overlap(
+                cb_col_buf,
+                2 >> chroma_subsamp_x,
+                cb_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x,
+                chroma_grain_stride,
+                cb_col_buf,
+                2 >> chroma_subsamp_x,
+                2 >> chroma_subsamp_x,
+                AOMMIN(chroma_subblock_size_y + (2 >> chroma_subsamp_y),
+                       (height - (y << 1)) >> chroma_subsamp_y),
+                grain_min,
+                grain_max);
 
-    int32_t *y_col_buf;
-    int32_t *cb_col_buf;
-    int32_t *cr_col_buf;
+            ver_boundary_overlap(
+                cr_col_buf,
+                2 >> chroma_subsamp_x,
+                cr_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x,
+                chroma_grain_stride,
+                cr_col_buf,
+                2 >> chroma_subsamp_x,
+                2 >> chroma_subsamp_x,
+                AOMMIN(chroma_subblock_size_y + (2 >> chroma_subsamp_y),
+                       (height - (y << 1)) >> chroma_subsamp_y),
+                grain_min,
+                grain_max);
 
-    random_register = params->random_seed;
+            int32_t i = y ? 1 : 0;
+
+            if (apply_noise)
+                add_noise_to_block_any(
+                    ctx,
+                    luma + ((((y + i) << 1) * luma_stride + (x << 1)) << pel_shift),
+                    cb +
+                        ((((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
+                          (x << (1 - chroma_subsamp_x)))
+                         << pel_shift),
+                    cr +
+                        ((((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
+                          (x << (1 - chroma_subsamp_x)))
+                         << pel_shift),
+                    y_col_buf + i * 4,
+                    cb_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
+                    cr_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
+                    2,
+                    (2 - chroma_subsamp_x),
+                    AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i,
+                    1);
+        }
 
-    int32_t left_pad   = 3;
-    int32_t right_pad  = 3; // padding to offset for AR coefficients
-    int32_t top_pad    = 3;
-    int32_t bottom_pad = 0;
+        if (overlap && y && apply_noise) {
+            if (x) {
+                ASSERT(y_col_buf != NULL);
+                hor_boundary_overlap(y_line_buf + (x << 1),
+                                     luma_stride,
+                                     y_col_buf,
+                                     2,
+                                     y_line_buf + (x << 1),
+                                     luma_stride,
+                                     2,
+                                     2,
+                                     grain_min,
+                                     grain_max);
+
+                hor_boundary_overlap(cb_line_buf + x * (2 >> chroma_subsamp_x),
+                                     chroma_stride,
+                                     cb_col_buf,
+                                     2 >> chroma_subsamp_x,
+                                     cb_line_buf + x * (2 >> chroma_subsamp_x),
+                                     chroma_stride,
+                                     2 >> chroma_subsamp_x,
+                                     2 >> chroma_subsamp_y,
+                                     grain_min,
+                                     grain_max);
+
+                hor_boundary_overlap(cr_line_buf + x * (2 >> chroma_subsamp_x),
+                                     chroma_stride,
+                                     cr_col_buf,
+                                     2 >> chroma_subsamp_x,
+                                     cr_line_buf + x * (2 >> chroma_subsamp_x),
+                                     chroma_stride,
+                                     2 >> chroma_subsamp_x,
+                                     2 >> chroma_subsamp_y,
+                                     grain_min,
+                                     grain_max);
+            }
 
-    int32_t ar_padding = 3; // maximum lag used for stabilization of AR coefficients
+            hor_boundary_overlap(y_line_buf + ((x ? x + 1 : 0) << 1),
+                                 luma_stride,
+                                 luma_grain_block + luma_offset_y * luma_grain_stride +
+                                     luma_offset_x + (x ? 2 : 0),
+                                 luma_grain_stride,
+                                 y_line_buf + ((x ? x + 1 : 0) << 1),
+                                 luma_stride,
+                                 AOMMIN(luma_subblock_size_x - ((x ? 1 : 0) << 1),
+                                        width - ((x ? x + 1 : 0) << 1)),
+                                 2,
+                                 grain_min,
+                                 grain_max);
+
+            hor_boundary_overlap(
+                cb_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
+                chroma_stride,
+                cb_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x +
+                    ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
+                chroma_grain_stride,
+                cb_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
+                chroma_stride,
+                AOMMIN(chroma_subblock_size_x - ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
+                       (width - ((x ? x + 1 : 0) << 1)) >> chroma_subsamp_x),
+                2 >> chroma_subsamp_y,
+                grain_min,
+                grain_max);
 
-    luma_subblock_size_y = 32;
-    luma_subblock_size_x = 32;
+            hor_boundary_overlap(
+                cr_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
+                chroma_stride,
+                cr_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x +
+                    ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
+                chroma_grain_stride,
+                cr_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
+                chroma_stride,
+                AOMMIN(chroma_subblock_size_x - ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
+                       (width - ((x ? x + 1 : 0) << 1)) >> chroma_subsamp_x),
+                2 >> chroma_subsamp_y,
+                grain_min,
+                grain_max);
+
+            add_noise_to_block_any(ctx,
+                                   luma + (((y << 1) * luma_stride + (x << 1)) << pel_shift),
+                                   cb +
+                                       (((y << (1 - chroma_subsamp_y)) * chroma_stride +
+                                         (x << (1 - chroma_subsamp_x)))
+                                        << pel_shift),
+                                   cr +
+                                       (((y << (1 - chroma_subsamp_y)) * chroma_stride +
+                                         (x << (1 - chroma_subsamp_x)))
+                                        << pel_shift),
+                                   y_line_buf + (x << 1),
+                                   cb_line_buf + (x << (1 - chroma_subsamp_x)),
+                                   cr_line_buf + (x << (1 - chroma_subsamp_x)),
+                                   luma_stride,
+                                   chroma_stride,
+                                   1,
+                                   AOMMIN(luma_subblock_size_x >> 1, width / 2 - x));
+        }
+
+        int32_t i = overlap && y ? 1 : 0;
+        int32_t j = overlap && x ? 1 : 0;
+
+        if (apply_noise)
+            add_noise_to_block_any(
+                ctx,
+                luma + ((((y + i) << 1) * luma_stride + ((x + j) << 1)) << pel_shift),
+                cb +
+                    ((((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
+                      ((x + j) << (1 - chroma_subsamp_x)))
+                     << pel_shift),
+                cr +
+                    ((((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
+                      ((x + j) << (1 - chroma_subsamp_x)))
+                     << pel_shift),
+                luma_grain_block + (luma_offset_y + (i << 1)) * luma_grain_stride + luma_offset_x +
+                    (j << 1),
+                cb_grain_block +
+                    (chroma_offset_y + (i << (1 - chroma_subsamp_y))) * chroma_grain_stride +
+                    chroma_offset_x + (j << (1 - chroma_subsamp_x)),
+                cr_grain_block +
+                    (chroma_offset_y + (i << (1 - chroma_subsamp_y))) * chroma_grain_stride +
+                    chroma_offset_x + (j << (1 - chroma_subsamp_x)),
+                luma_grain_stride,
+                chroma_grain_stride,
+                AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i,
+                AOMMIN(luma_subblock_size_x >> 1, width / 2 - x) - j);
+
+        if (overlap) {
+            if (x) {
+                // Copy overlapped column bufer to line buffer
+                copy_area(y_col_buf + (luma_subblock_size_y << 1),
+                          2,
+                          y_line_buf + (x << 1),
+                          luma_stride,
+                          2,
+                          2);
+
+                copy_area(cb_col_buf + (chroma_subblock_size_y << (1 - chroma_subsamp_x)),
+                          2 >> chroma_subsamp_x,
+                          cb_line_buf + (x << (1 - chroma_subsamp_x)),
+                          chroma_stride,
+                          2 >> chroma_subsamp_x,
+                          2 >> chroma_subsamp_y);
+
+                copy_area(cr_col_buf + (chroma_subblock_size_y << (1 - chroma_subsamp_x)),
+                          2 >> chroma_subsamp_x,
+                          cr_line_buf + (x << (1 - chroma_subsamp_x)),
+                          chroma_stride,
+                          2 >> chroma_subsamp_x,
+                          2 >> chroma_subsamp_y);
+            }
+
+            // Copy grain to the line buffer for overlap with a bottom block
+            copy_area(luma_grain_block + (luma_offset_y + luma_subblock_size_y) * luma_grain_stride +
+                          luma_offset_x + ((x ? 2 : 0)),
+                      luma_grain_stride,
+                      y_line_buf + ((x ? x + 1 : 0) << 1),
+                      luma_stride,
+                      AOMMIN(luma_subblock_size_x, width - (x << 1)) - (x ? 2 : 0),
+                      2);
+
+            copy_area(cb_grain_block +
+                          (chroma_offset_y + chroma_subblock_size_y) * chroma_grain_stride +
+                          chroma_offset_x + (x ? 2 >> chroma_subsamp_x : 0),
+                      chroma_grain_stride,
+                      cb_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
+                      chroma_stride,
+                      AOMMIN(chroma_subblock_size_x, ((width - (x << 1)) >> chroma_subsamp_x)) -
+                          (x ? 2 >> chroma_subsamp_x : 0),
+                      2 >> chroma_subsamp_y);
+
+            copy_area(cr_grain_block +
+                          (chroma_offset_y + chroma_subblock_size_y) * chroma_grain_stride +
+                          chroma_offset_x + (x ? 2 >> chroma_subsamp_x : 0),
+                      chroma_grain_stride,
+                      cr_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
+                      chroma_stride,
+                      AOMMIN(chroma_subblock_size_x, ((width - (x << 1)) >> chroma_subsamp_x)) -
+                          (x ? 2 >> chroma_subsamp_x : 0),
+                      2 >> chroma_subsamp_y);
+
+            // Copy grain to the column buffer for overlap with the next block to
+            // the right
+
+            copy_area(luma_grain_block + luma_offset_y * luma_grain_stride + luma_offset_x +
+                          luma_subblock_size_x,
+                      luma_grain_stride,
+                      y_col_buf,
+                      2,
+                      2,
+                      AOMMIN(luma_subblock_size_y + 2, height - (y << 1)));
+
+            copy_area(cb_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x +
+                          chroma_subblock_size_x,
+                      chroma_grain_stride,
+                      cb_col_buf,
+                      2 >> chroma_subsamp_x,
+                      2 >> chroma_subsamp_x,
+                      AOMMIN(chroma_subblock_size_y + (2 >> chroma_subsamp_y),
+                             (height - (y << 1)) >> chroma_subsamp_y));
+
+            copy_area(cr_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x +
+                          chroma_subblock_size_x,
+                      chroma_grain_stride,
+                      cr_col_buf,
+                      2 >> chroma_subsamp_x,
+                      2 >> chroma_subsamp_x,
+                      AOMMIN(chroma_subblock_size_y + (2 >> chroma_subsamp_y),
+                             (height - (y << 1)) >> chroma_subsamp_y));
+        }
+    }
+}
 
-    chroma_subblock_size_y = luma_subblock_size_y >> chroma_subsamp_y;
-    chroma_subblock_size_x = luma_subblock_size_x >> chroma_subsamp_x;
+// adds the grain to the stripes [first_stripe, end_stripe) of the picture
+static int32_t add_film_grain_stripes(void *ctx_ptr, int32_t first_stripe, int32_t end_stripe) {
+    const FilmGrainContext *ctx         = (const FilmGrainContext *)ctx_ptr;
+    const int32_t           stripe_rows = luma_subblock_size_y >> 1;
+    FilmGrainStripeBuffers  bufs;
+
+    init_stripe_buffers(ctx, &bufs);
+    // the overlap with the stripe above needs its line buffers
+    if (first_stripe && ctx->params->overlap_flag)
+        add_film_grain_stripe(ctx, &bufs, (first_stripe - 1) * stripe_rows, FALSE);
+    for (int32_t stripe = first_stripe; stripe < end_stripe; stripe++)
+        add_film_grain_stripe(ctx, &bufs, stripe * stripe_rows, TRUE);
+    dealloc_stripe_buffers(&bufs);
+    return 1;
+}
+
+void svt_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb, uint8_t *cr,
+                                int32_t height, int32_t width, int32_t luma_stride,
+                                int32_t chroma_stride, int32_t use_high_bit_depth,
+                                int32_t chroma_subsamp_y, int32_t chroma_subsamp_x,
+                                SvtJobPool *job_pool) {
+    FilmGrainContext ctx;
+
+    ctx.params                 = params;
+    ctx.luma                   = luma;
+    ctx.cb                     = cb;
+    ctx.cr                     = cr;
+    ctx.height                 = height;
+    ctx.width                  = width;
+    ctx.luma_stride            = luma_stride;
+    ctx.chroma_stride          = chroma_stride;
+    ctx.use_high_bit_depth     = use_high_bit_depth;
+    ctx.chroma_subsamp_y       = chroma_subsamp_y;
+    ctx.chroma_subsamp_x       = chroma_subsamp_x;
+    ctx.chroma_subblock_size_y = luma_subblock_size_y >> chroma_subsamp_y;
+    ctx.chroma_subblock_size_x = luma_subblock_size_x >> chroma_subsamp_x;
 
     // Initial padding is only needed for generation of
     // film grain templates (to stabilize the AR process)
@@ -996,434 +1432,86 @@ void svt_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb
         2 * ar_padding + right_pad;
 
     int32_t chroma_block_size_y = top_pad + (2 >> chroma_subsamp_y) * ar_padding +
-        chroma_subblock_size_y * 2 + bottom_pad;
+        ctx.chroma_subblock_size_y * 2 + bottom_pad;
     int32_t chroma_block_size_x = left_pad + (2 >> chroma_subsamp_x) * ar_padding +
-        chroma_subblock_size_x * 2 + (2 >> chroma_subsamp_x) * ar_padding + right_pad;
+        ctx.chroma_subblock_size_x * 2 + (2 >> chroma_subsamp_x) * ar_padding + right_pad;
 
-    int32_t luma_grain_stride   = luma_block_size_x;
-    int32_t chroma_grain_stride = chroma_block_size_x;
+    ctx.luma_grain_stride   = luma_block_size_x;
+    ctx.chroma_grain_stride = chroma_block_size_x;
 
-    int32_t overlap   = params->overlap_flag;
-    int32_t bit_depth = params->bit_depth;
+    int32_t bit_depth    = params->bit_depth;
+    int32_t grain_center = 128 << (bit_depth - 8);
+    ctx.grain_min        = 0 - grain_center;
+    ctx.grain_max        = (256 << (bit_depth - 8)) - 1 - grain_center;
 
-    grain_center = 128 << (bit_depth - 8);
-    grain_min    = 0 - grain_center;
-    grain_max    = (256 << (bit_depth - 8)) - 1 - grain_center;
+    int32_t **pred_pos_luma;
+    int32_t **pred_pos_chroma;
+    init_pred_pos(params, &pred_pos_luma, &pred_pos_chroma);
 
-    init_arrays(params,
-                luma_stride,
-                chroma_stride,
-                &pred_pos_luma,
-                &pred_pos_chroma,
-                &luma_grain_block,
-                &cb_grain_block,
-                &cr_grain_block,
-                &y_line_buf,
-                &cb_line_buf,
-                &cr_line_buf,
-                &y_col_buf,
-                &cb_col_buf,
-                &cr_col_buf,
-                luma_block_size_y * luma_block_size_x,
-                chroma_block_size_y * chroma_block_size_x,
-                chroma_subsamp_y,
-                chroma_subsamp_x);
+    ctx.luma_grain_block = (int32_t *)malloc(sizeof(*ctx.luma_grain_block) * luma_block_size_y *
+                                             luma_block_size_x);
+    ctx.cb_grain_block   = (int32_t *)malloc(sizeof(*ctx.cb_grain_block) * chroma_block_size_y *
+                                           chroma_block_size_x);
+    ctx.cr_grain_block   = (int32_t *)malloc(sizeof(*ctx.cr_grain_block) * chroma_block_size_y *
+                                           chroma_block_size_x);
+    ASSERT(ctx.luma_grain_block && ctx.cb_grain_block && ctx.cr_grain_block);
 
     generate_luma_grain_block(params,
                               pred_pos_luma,
-                              luma_grain_block,
+                              ctx.luma_grain_block,
                               luma_block_size_y,
                               luma_block_size_x,
-                              luma_grain_stride,
-                              left_pad,
-                              top_pad,
-                              right_pad,
-                              bottom_pad);
+                              ctx.luma_grain_stride,
+                              ctx.grain_min,
+                              ctx.grain_max);
 
     generate_chroma_grain_blocks(params,
-                                 //                               pred_pos_luma,
                                  pred_pos_chroma,
-                                 luma_grain_block,
-                                 cb_grain_block,
-                                 cr_grain_block,
-                                 luma_grain_stride,
+                                 ctx.luma_grain_block,
+                                 ctx.cb_grain_block,
+                                 ctx.cr_grain_block,
+                                 ctx.luma_grain_stride,
                                  chroma_block_size_y,
                                  chroma_block_size_x,
-                                 chroma_grain_stride,
-                                 left_pad,
-                                 top_pad,
-                                 right_pad,
-                                 bottom_pad,
+                                 ctx.chroma_grain_stride,
+                                 ctx.grain_min,
+                                 ctx.grain_max,
                                  chroma_subsamp_y,
                                  chroma_subsamp_x);
 
-    init_scaling_function(params->scaling_points_y, params->num_y_points, scaling_lut_y);
+    dealloc_pred_pos(params, &pred_pos_luma, &pred_pos_chroma);
+
+    // the 8 bit path looks the scaling up with 8 bit samples
+    const int32_t lut_bit_depth = use_high_bit_depth ? bit_depth : 8;
+    const size_t  lut_size      = (size_t)256 << (lut_bit_depth - 8);
+    ctx.scaling_lut_y           = (int32_t *)malloc(sizeof(*ctx.scaling_lut_y) * lut_size * 3);
+    ASSERT(ctx.scaling_lut_y);
+    ctx.scaling_lut_cb = ctx.scaling_lut_y + lut_size;
+    ctx.scaling_lut_cr = ctx.scaling_lut_cb + lut_size;
 
+    init_scaling_lut(params->scaling_points_y, params->num_y_points, lut_bit_depth, ctx.scaling_lut_y);
     if (params->chroma_scaling_from_luma) {
-        svt_memcpy(scaling_lut_cb, scaling_lut_y, sizeof(*scaling_lut_y) * 256);
-        svt_memcpy(scaling_lut_cr, scaling_lut_y, sizeof(*scaling_lut_y) * 256);
+        svt_memcpy(ctx.scaling_lut_cb, ctx.scaling_lut_y, sizeof(*ctx.scaling_lut_y) * lut_size);
+        svt_memcpy(ctx.scaling_lut_cr, ctx.scaling_lut_y, sizeof(*ctx.scaling_lut_y) * lut_size);
     } else {
-        init_scaling_function(params->scaling_points_cb, params->num_cb_points, scaling_lut_cb);
-        init_scaling_function(params->scaling_points_cr, params->num_cr_points, scaling_lut_cr);
+        init_scaling_lut(
+            params->scaling_points_cb, params->num_cb_points, lut_bit_depth, ctx.scaling_lut_cb);
+        init_scaling_lut(
+            params->scaling_points_cr, params->num_cr_points, lut_bit_depth, ctx.scaling_lut_cr);
     }
-    for (int32_t y = 0; y < height / 2; y += (luma_subblock_size_y >> 1)) {
-        init_random_generator(y * 2, params->random_seed);
 
-        for (int32_t x = 0; x < width / 2; x += (luma_subblock_size_x >> 1)) {
-            int32_t offset_y = get_random_number(8);
-            int32_t offset_x = (offset_y >> 4) & 15;
-            offset_y &= 15;
+    // stripes of 32 luma rows, split in contiguous ranges over the threads
+    const int32_t stripe_rows  = luma_subblock_size_y >> 1;
+    const int32_t stripe_count = (height / 2 + stripe_rows - 1) / stripe_rows;
+    svt_job_pool_run(job_pool, add_film_grain_stripes, &ctx, stripe_count);
 
-            int32_t luma_offset_y = left_pad + 2 * ar_padding + (offset_y << 1);
-            int32_t luma_offset_x = top_pad + 2 * ar_padding + (offset_x << 1);
-
-            int32_t chroma_offset_y = top_pad + (2 >> chroma_subsamp_y) * ar_padding +
-                offset_y * (2 >> chroma_subsamp_y);
-            int32_t chroma_offset_x = left_pad + (2 >> chroma_subsamp_x) * ar_padding +
-                offset_x * (2 >> chroma_subsamp_x);
-
-            if (overlap && x) {
-                ver_boundary_overlap(
-                    y_col_buf,
-                    2,
-                    luma_grain_block + luma_offset_y * luma_grain_stride + luma_offset_x,
-                    luma_grain_stride,
-                    y_col_buf,
-                    2,
-                    2,
-                    AOMMIN(luma_subblock_size_y + 2, height - (y << 1)));
-
-                ver_boundary_overlap(
-                    cb_col_buf,
-                    2 >> chroma_subsamp_x,
-                    cb_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x,
-                    chroma_grain_stride,
-                    cb_col_buf,
-                    2 >> chroma_subsamp_x,
-                    2 >> chroma_subsamp_x,
-                    AOMMIN(chroma_subblock_size_y + (2 >> chroma_subsamp_y),
-                           (height - (y << 1)) >> chroma_subsamp_y));
-
-                ver_boundary_overlap(
-                    cr_col_buf,
-                    2 >> chroma_subsamp_x,
-                    cr_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x,
-                    chroma_grain_stride,
-                    cr_col_buf,
-                    2 >> chroma_subsamp_x,
-                    2 >> chroma_subsamp_x,
-                    AOMMIN(chroma_subblock_size_y + (2 >> chroma_subsamp_y),
-                           (height - (y << 1)) >> chroma_subsamp_y));
-
-                int32_t i = y ? 1 : 0;
-
-                if (use_high_bit_depth) {
-                    add_noise_to_block_hbd(
-                        params,
-                        (uint16_t *)luma + ((y + i) << 1) * luma_stride + (x << 1),
-                        (uint16_t *)cb + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                            (x << (1 - chroma_subsamp_x)),
-                        (uint16_t *)cr + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                            (x << (1 - chroma_subsamp_x)),
-                        luma_stride,
-                        chroma_stride,
-                        y_col_buf + i * 4,
-                        cb_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
-                        cr_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
-                        2,
-                        (2 - chroma_subsamp_x),
-                        AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i,
-                        1,
-                        bit_depth,
-                        chroma_subsamp_y,
-                        chroma_subsamp_x);
-                } else {
-                    add_noise_to_block(
-                        params,
-                        luma + ((y + i) << 1) * luma_stride + (x << 1),
-                        cb + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                            (x << (1 - chroma_subsamp_x)),
-                        cr + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                            (x << (1 - chroma_subsamp_x)),
-                        luma_stride,
-                        chroma_stride,
-                        y_col_buf + i * 4,
-                        cb_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
-                        cr_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
-                        2,
-                        (2 - chroma_subsamp_x),
-                        AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i,
-                        1,
-                        bit_depth,
-                        chroma_subsamp_y,
-                        chroma_subsamp_x);
-                }
-            }
-
-            if (overlap && y) {
-                if (x) {
-                    ASSERT(y_col_buf != NULL);
-                    hor_boundary_overlap(y_line_buf + (x << 1),
-                                         luma_stride,
-                                         y_col_buf,
-                                         2,
-                                         y_line_buf + (x << 1),
-                                         luma_stride,
-                                         2,
-                                         2);
-
-                    hor_boundary_overlap(cb_line_buf + x * (2 >> chroma_subsamp_x),
-                                         chroma_stride,
-                                         cb_col_buf,
-                                         2 >> chroma_subsamp_x,
-                                         cb_line_buf + x * (2 >> chroma_subsamp_x),
-                                         chroma_stride,
-                                         2 >> chroma_subsamp_x,
-                                         2 >> chroma_subsamp_y);
-
-                    hor_boundary_overlap(cr_line_buf + x * (2 >> chroma_subsamp_x),
-                                         chroma_stride,
-                                         cr_col_buf,
-                                         2 >> chroma_subsamp_x,
-                                         cr_line_buf + x * (2 >> chroma_subsamp_x),
-                                         chroma_stride,
-                                         2 >> chroma_subsamp_x,
-                                         2 >> chroma_subsamp_y);
-                }
-
-                hor_boundary_overlap(y_line_buf + ((x ? x + 1 : 0) << 1),
-                                     luma_stride,
-                                     luma_grain_block + luma_offset_y * luma_grain_stride +
-                                         luma_offset_x + (x ? 2 : 0),
-                                     luma_grain_stride,
-                                     y_line_buf + ((x ? x + 1 : 0) << 1),
-                                     luma_stride,
-                                     AOMMIN(luma_subblock_size_x - ((x ? 1 : 0) << 1),
-                                            width - ((x ? x + 1 : 0) << 1)),
-                                     2);
-
-                hor_boundary_overlap(
-                    cb_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
-                    chroma_stride,
-                    cb_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x +
-                        ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
-                    chroma_grain_stride,
-                    cb_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
-                    chroma_stride,
-                    AOMMIN(chroma_subblock_size_x - ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
-                           (width - ((x ? x + 1 : 0) << 1)) >> chroma_subsamp_x),
-                    2 >> chroma_subsamp_y);
-
-                hor_boundary_overlap(
-                    cr_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
-                    chroma_stride,
-                    cr_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x +
-                        ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
-                    chroma_grain_stride,
-                    cr_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
-                    chroma_stride,
-                    AOMMIN(chroma_subblock_size_x - ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
-                           (width - ((x ? x + 1 : 0) << 1)) >> chroma_subsamp_x),
-                    2 >> chroma_subsamp_y);
-
-                if (use_high_bit_depth) {
-                    add_noise_to_block_hbd(
-                        params,
-                        (uint16_t *)luma + (y << 1) * luma_stride + (x << 1),
-                        (uint16_t *)cb + (y << (1 - chroma_subsamp_y)) * chroma_stride +
-                            (x << ((1 - chroma_subsamp_x))),
-                        (uint16_t *)cr + (y << (1 - chroma_subsamp_y)) * chroma_stride +
-                            (x << ((1 - chroma_subsamp_x))),
-                        luma_stride,
-                        chroma_stride,
-                        y_line_buf + (x << 1),
-                        cb_line_buf + (x << (1 - chroma_subsamp_x)),
-                        cr_line_buf + (x << (1 - chroma_subsamp_x)),
-                        luma_stride,
-                        chroma_stride,
-                        1,
-                        AOMMIN(luma_subblock_size_x >> 1, width / 2 - x),
-                        bit_depth,
-                        chroma_subsamp_y,
-                        chroma_subsamp_x);
-                } else {
-                    add_noise_to_block(params,
-                                       luma + (y << 1) * luma_stride + (x << 1),
-                                       cb + (y << (1 - chroma_subsamp_y)) * chroma_stride +
-                                           (x << ((1 - chroma_subsamp_x))),
-                                       cr + (y << (1 - chroma_subsamp_y)) * chroma_stride +
-                                           (x << ((1 - chroma_subsamp_x))),
-                                       luma_stride,
-                                       chroma_stride,
-                                       y_line_buf + (x << 1),
-                                       cb_line_buf + (x << (1 - chroma_subsamp_x)),
-                                       cr_line_buf + (x << (1 - chroma_subsamp_x)),
-                                       luma_stride,
-                                       chroma_stride,
-                                       1,
-                                       AOMMIN(luma_subblock_size_x >> 1, width / 2 - x),
-                                       bit_depth,
-                                       chroma_subsamp_y,
-                                       chroma_subsamp_x);
-                }
-            }
-
-            int32_t i = overlap && y ? 1 : 0;
-            int32_t j = overlap && x ? 1 : 0;
-
-            if (use_high_bit_depth) {
-                add_noise_to_block_hbd(
-                    params,
-                    (uint16_t *)luma + ((y + i) << 1) * luma_stride + ((x + j) << 1),
-                    (uint16_t *)cb + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                        ((x + j) << (1 - chroma_subsamp_x)),
-                    (uint16_t *)cr + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                        ((x + j) << (1 - chroma_subsamp_x)),
-                    luma_stride,
-                    chroma_stride,
-                    luma_grain_block + (luma_offset_y + (i << 1)) * luma_grain_stride +
-                        luma_offset_x + (j << 1),
-                    cb_grain_block +
-                        (chroma_offset_y + (i << (1 - chroma_subsamp_y))) * chroma_grain_stride +
-                        chroma_offset_x + (j << (1 - chroma_subsamp_x)),
-                    cr_grain_block +
-                        (chroma_offset_y + (i << (1 - chroma_subsamp_y))) * chroma_grain_stride +
-                        chroma_offset_x + (j << (1 - chroma_subsamp_x)),
-                    luma_grain_stride,
-                    chroma_grain_stride,
-                    AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i,
-                    AOMMIN(luma_subblock_size_x >> 1, width / 2 - x) - j,
-                    bit_depth,
-                    chroma_subsamp_y,
-                    chroma_subsamp_x);
-            } else {
-                add_noise_to_block(
-                    params,
-                    luma + ((y + i) << 1) * luma_stride + ((x + j) << 1),
-                    cb + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                        ((x + j) << (1 - chroma_subsamp_x)),
-                    cr + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                        ((x + j) << (1 - chroma_subsamp_x)),
-                    luma_stride,
-                    chroma_stride,
-                    luma_grain_block + (luma_offset_y + (i << 1)) * luma_grain_stride +
-                        luma_offset_x + (j << 1),
-                    cb_grain_block +
-                        (chroma_offset_y + (i << (1 - chroma_subsamp_y))) * chroma_grain_stride +
-                        chroma_offset_x + (j << (1 - chroma_subsamp_x)),
-                    cr_grain_block +
-                        (chroma_offset_y + (i << (1 - chroma_subsamp_y))) * chroma_grain_stride +
-                        chroma_offset_x + (j << (1 - chroma_subsamp_x)),
-                    luma_grain_stride,
-                    chroma_grain_stride,
-                    AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i,
-                    AOMMIN(luma_subblock_size_x >> 1, width / 2 - x) - j,
-                    bit_depth,
-                    chroma_subsamp_y,
-                    chroma_subsamp_x);
-            }
-
-            if (overlap) {
-                if (x) {
-                    // Copy overlapped column bufer to line buffer
-                    copy_area(y_col_buf + (luma_subblock_size_y << 1),
-                              2,
-                              y_line_buf + (x << 1),
-                              luma_stride,
-                              2,
-                              2);
-
-                    copy_area(cb_col_buf + (chroma_subblock_size_y << (1 - chroma_subsamp_x)),
-                              2 >> chroma_subsamp_x,
-                              cb_line_buf + (x << (1 - chroma_subsamp_x)),
-                              chroma_stride,
-                              2 >> chroma_subsamp_x,
-                              2 >> chroma_subsamp_y);
-
-                    copy_area(cr_col_buf + (chroma_subblock_size_y << (1 - chroma_subsamp_x)),
-                              2 >> chroma_subsamp_x,
-                              cr_line_buf + (x << (1 - chroma_subsamp_x)),
-                              chroma_stride,
-                              2 >> chroma_subsamp_x,
-                              2 >> chroma_subsamp_y);
-                }
-
-                // Copy grain to the line buffer for overlap with a bottom block
-                copy_area(luma_grain_block +
-                              (luma_offset_y + luma_subblock_size_y) * luma_grain_stride +
-                              luma_offset_x + ((x ? 2 : 0)),
-                          luma_grain_stride,
-                          y_line_buf + ((x ? x + 1 : 0) << 1),
-                          luma_stride,
-                          AOMMIN(luma_subblock_size_x, width - (x << 1)) - (x ? 2 : 0),
-                          2);
-
-                copy_area(cb_grain_block +
-                              (chroma_offset_y + chroma_subblock_size_y) * chroma_grain_stride +
-                              chroma_offset_x + (x ? 2 >> chroma_subsamp_x : 0),
-                          chroma_grain_stride,
-                          cb_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
-                          chroma_stride,
-                          AOMMIN(chroma_subblock_size_x, ((width - (x << 1)) >> chroma_subsamp_x)) -
-                              (x ? 2 >> chroma_subsamp_x : 0),
-                          2 >> chroma_subsamp_y);
-
-                copy_area(cr_grain_block +
-                              (chroma_offset_y + chroma_subblock_size_y) * chroma_grain_stride +
-                              chroma_offset_x + (x ? 2 >> chroma_subsamp_x : 0),
-                          chroma_grain_stride,
-                          cr_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
-                          chroma_stride,
-                          AOMMIN(chroma_subblock_size_x, ((width - (x << 1)) >> chroma_subsamp_x)) -
-                              (x ? 2 >> chroma_subsamp_x : 0),
-                          2 >> chroma_subsamp_y);
-
-                // Copy grain to the column buffer for overlap with the next block to
-                // the right
-
-                copy_area(luma_grain_block + luma_offset_y * luma_grain_stride + luma_offset_x +
-                              luma_subblock_size_x,
-                          luma_grain_stride,
-                          y_col_buf,
-                          2,
-                          2,
-                          AOMMIN(luma_subblock_size_y + 2, height - (y << 1)));
-
-                copy_area(cb_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x +
-                              chroma_subblock_size_x,
-                          chroma_grain_stride,
-                          cb_col_buf,
-                          2 >> chroma_subsamp_x,
-                          2 >> chroma_subsamp_x,
-                          AOMMIN(chroma_subblock_size_y + (2 >> chroma_subsamp_y),
-                                 (height - (y << 1)) >> chroma_subsamp_y));
-
-                copy_area(cr_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x +
-                              chroma_subblock_size_x,
-                          chroma_grain_stride,
-                          cr_col_buf,
-                          2 >> chroma_subsamp_x,
-                          2 >> chroma_subsamp_x,
-                          AOMMIN(chroma_subblock_size_y + (2 >> chroma_subsamp_y),
-                                 (height - (y << 1)) >> chroma_subsamp_y));
-            }
-        }
-    }
-
-    dealloc_arrays(params,
-                   &pred_pos_luma,
-                   &pred_pos_chroma,
-                   &luma_grain_block,
-                   &cb_grain_block,
-                   &cr_grain_block,
-                   &y_line_buf,
-                   &cb_line_buf,
-                   &cr_line_buf,
-                   &y_col_buf,
-                   &cb_col_buf,
-                   &cr_col_buf);
+    free(ctx.scaling_lut_y);
+    free(ctx.luma_grain_block);
+    free(ctx.cb_grain_block);
+    free(ctx.cr_grain_block);
 }
 
+
 /*
 void av1_film_grain_write_updated(const AomFilmGrain *pars,
                                   int32_t monochrome,
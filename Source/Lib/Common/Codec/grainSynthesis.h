@@ -18,6 +18,7 @@
 
 #include "EbDefinitions.h"
 #include "common_dsp_rtcd.h"
+#include "EbJobPool.h"
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -96,11 +97,14 @@ int32_t film_grain_params_equal(AomFilmGrain *pars_a, AomFilmGrain *pars_b);
      * \param[in]    width            luma plane width
      * \param[in]    luma_stride      luma plane stride
      * \param[in]    chroma_stride    chroma plane stride
+     * \param[in]    job_pool         threads sharing the stripes of the picture, NULL for
+     *                                the calling thread only
      */
 void svt_av1_add_film_grain_run(AomFilmGrain *grain_params, uint8_t *luma, uint8_t *cb, uint8_t *cr,
                                 int32_t height, int32_t width, int32_t luma_stride,
                                 int32_t chroma_stride, int32_t use_high_bit_depth,
-                                int32_t chroma_subsamp_y, int32_t chroma_subsamp_x);
+                                int32_t chroma_subsamp_y, int32_t chroma_subsamp_x,
+                                SvtJobPool *job_pool);
 
 /*!\brief Add film grain
      *
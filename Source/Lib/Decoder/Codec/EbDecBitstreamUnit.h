@@ -38,11 +38,13 @@ extern "C" {
 #define EC_MIN_PROB 4 // must be <= (1<<EC_PROB_SHIFT)/16
 
 /*OPT: OdEcWindow must be at least 32 bits, but if you have fast arithmetic
-   on a larger type, you can speed up the decoder by using it here.*/
-//typedef uint32_t OdEcWindow;
+   on a larger type, you can speed up the decoder by using it here.
+  The decoder uses its own 64-bit window, so a refill inserts up to 6 bytes
+   instead of 2; OdEcWindow stays 32 bits for the encoder.*/
+typedef uint64_t OdEcDecWindow;
 
-/*The size in bits of OdEcWindow.*/
-//#define OD_EC_WINDOW_SIZE ((int)sizeof(OdEcWindow) * CHAR_BIT)
+/*The size in bits of OdEcDecWindow.*/
+#define OD_EC_DEC_WINDOW_SIZE ((int)sizeof(OdEcDecWindow) * CHAR_BIT)
 
 /********************************************************************************************************************************/
 /********************************************************************************************************************************/
@@ -70,24 +72,9 @@ extern int   enable_dump;
   inverse).*/
 #define AOM_ICDF(x) (CDF_PROB_TOP - (x))
 
+// Same adaptation as the encoder, see update_cdf()
 static INLINE void dec_update_cdf(AomCdfProb *cdf, int8_t val, int nsymbs) {
-    int rate;
-    int i, tmp;
-
-    static const int nsymbs2speed[17] = {0, 0, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2};
-    assert(nsymbs < 17);
-    rate = 3 + (cdf[nsymbs] > 15) + (cdf[nsymbs] > 31) + nsymbs2speed[nsymbs]; // + get_msb(nsymbs);
-    tmp  = AOM_ICDF(0);
-
-    // Single loop (faster)
-    for (i = 0; i < nsymbs - 1; ++i) {
-        tmp = (i == val) ? 0 : tmp;
-        if (tmp < cdf[i]) {
-            cdf[i] -= (AomCdfProb)((cdf[i] - tmp) >> rate);
-        } else
-            cdf[i] += (AomCdfProb)((tmp - cdf[i]) >> rate);
-    }
-    cdf[nsymbs] += (cdf[nsymbs] < 32);
+    update_cdf(cdf, val, nsymbs);
 }
 
 /********************************************************************************************************************************/
@@ -114,12 +101,12 @@ typedef struct OdEcDec {
 
     /*The difference between the high end of the current range, (low + rng), and
     the coded value, minus 1.
-    This stores up to OD_EC_WINDOW_SIZE bits of that difference, but the
+    This stores up to OD_EC_DEC_WINDOW_SIZE bits of that difference, but the
     decoder only uses the top 16 bits of the window to decode the next symbol.
     As we shift up during renormalization, if we don't have enough bits left in
     the window to fill the top 16, we'll read in more bits of the coded
     value.*/
-    OdEcWindow dif;
+    OdEcDecWindow dif;
     /*The number of values in the current range.*/
     uint16_t rng;
     /*The number of bits of data in the current value.*/
@@ -136,7 +123,7 @@ static void od_ec_dec_refill(OdEcDec *dec);
   ret: The value to return.
   Return: ret.
           This allows the compiler to jump to this function via a tail-call.*/
-static int od_ec_dec_normalize(OdEcDec *dec, OdEcWindow dif, unsigned rng, int ret) {
+static int od_ec_dec_normalize(OdEcDec *dec, OdEcDecWindow dif, unsigned rng, int ret) {
     int d;
     assert(rng <= 65535U);
     /*The number of leading zeros in the 16-bit binary representation of rng.*/
@@ -155,8 +142,8 @@ static int od_ec_dec_normalize(OdEcDec *dec, OdEcWindow dif, unsigned rng, int r
   f: The probability that the bit is one, scaled by 32768.
   Return: The value decoded (0 or 1).*/
 static int od_ec_decode_bool_q15(OdEcDec *dec, unsigned f) {
-    OdEcWindow dif;
-    OdEcWindow vw;
+    OdEcDecWindow dif;
+    OdEcDecWindow vw;
     unsigned   r;
     unsigned   r_new;
     unsigned   v;
@@ -165,11 +152,11 @@ static int od_ec_decode_bool_q15(OdEcDec *dec, unsigned f) {
     assert(f < 32768U);
     dif = dec->dif;
     r   = dec->rng;
-    assert(dif >> (OD_EC_WINDOW_SIZE - 16) < r);
+    assert(dif >> (OD_EC_DEC_WINDOW_SIZE - 16) < r);
     assert(32768U <= r);
     v = ((r >> 8) * (uint32_t)(f >> EC_PROB_SHIFT) >> (7 - EC_PROB_SHIFT));
     v += EC_MIN_PROB;
-    vw    = (OdEcWindow)v << (OD_EC_WINDOW_SIZE - 16);
+    vw    = (OdEcDecWindow)v << (OD_EC_DEC_WINDOW_SIZE - 16);
     ret   = 1;
     r_new = v;
     if (dif >= vw) {
@@ -180,6 +167,48 @@ static int od_ec_decode_bool_q15(OdEcDec *dec, unsigned f) {
     return od_ec_dec_normalize(dec, dif, r_new, ret);
 }
 
+/*The lower bound of the range of the symbol with icdf value f, when n symbols
+   follow it.*/
+#define OD_EC_SYMBOL_BOUND(r, f, n) \
+    ((((r) >> 8) * (uint32_t)((f) >> EC_PROB_SHIFT) >> (7 - EC_PROB_SHIFT - CDF_SHIFT)) + \
+     EC_MIN_PROB * (n))
+
+#ifdef ARCH_X86_64
+/*Returns the index of the first symbol whose lower bound is at most c, the
+   vector form of the search loop of od_ec_decode_cdf_q15() for nsyms >= 4.
+  Like update_cdf(), two overlapping loads cover the nsyms values of icdf
+   without reading past its counter.*/
+static INLINE int od_ec_find_symbol_sse2(const uint16_t *icdf, int nsyms, unsigned c,
+                                         unsigned r) {
+    const int     N    = nsyms - 1;
+    const int     w    = nsyms >= 8 ? 8 : 4;
+    const int     o    = nsyms == 16 ? 8 : nsyms + 1 - w;
+    const __m128i r8   = _mm_set1_epi16((int16_t)(r >> 8));
+    const __m128i c16  = _mm_set1_epi16((int16_t)c);
+    const __m128i step = _mm_setr_epi16(0, 4, 8, 12, 16, 20, 24, 28);
+    const __m128i lo   = w == 8 ? _mm_loadu_si128((const __m128i *)icdf)
+                                : _mm_loadl_epi64((const __m128i *)icdf);
+    const __m128i hi   = w == 8 ? _mm_loadu_si128((const __m128i *)(icdf + o))
+                                : _mm_loadl_epi64((const __m128i *)(icdf + o));
+    int           mask[2];
+    for (int k = 0; k < 2; k++) {
+        const int     first = k ? o : 0;
+        const __m128i f     = _mm_srli_epi16(k ? hi : lo, EC_PROB_SHIFT);
+        // (r >> 8) * f needs 17 bits, its half fits in 16
+        const __m128i p     = _mm_or_si128(_mm_slli_epi16(_mm_mulhi_epu16(r8, f), 15),
+                                       _mm_srli_epi16(_mm_mullo_epi16(r8, f), 1));
+        const __m128i v =
+            _mm_add_epi16(p, _mm_sub_epi16(_mm_set1_epi16((int16_t)(EC_MIN_PROB * (N - first))), step));
+        // v <= c, the lanes past N never come first as the bound of symbol N is 0
+        mask[k] = _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_subs_epu16(v, c16), _mm_setzero_si128())) &
+            ((1 << (2 * w)) - 1);
+    }
+    if (mask[0])
+        return get_msb(mask[0] & -mask[0]) >> 1;
+    return o + (get_msb(mask[1] & -mask[1]) >> 1);
+}
+#endif
+
 /*Decodes a symbol given an inverse cumulative distribution function (CDF)
    table in Q15.
   icdf: CDF_PROB_TOP minus the CDF, such that symbol s falls in the range
@@ -190,7 +219,7 @@ static int od_ec_decode_bool_q15(OdEcDec *dec, unsigned f) {
          This should be at most 16.
   Return: The decoded symbol s.*/
 static int od_ec_decode_cdf_q15(OdEcDec *dec, const uint16_t *icdf, int nsyms) {
-    OdEcWindow dif;
+    OdEcDecWindow dif;
     unsigned   r;
     unsigned   c;
     unsigned   u;
@@ -201,11 +230,23 @@ static int od_ec_decode_cdf_q15(OdEcDec *dec, const uint16_t *icdf, int nsyms) {
     r           = dec->rng;
     const int N = nsyms - 1;
 
-    assert(dif >> (OD_EC_WINDOW_SIZE - 16) < r);
+    assert(dif >> (OD_EC_DEC_WINDOW_SIZE - 16) < r);
     assert(icdf[nsyms - 1] == OD_ICDF(CDF_PROB_TOP));
     assert(32768U <= r);
     assert(7 - EC_PROB_SHIFT - CDF_SHIFT >= 0);
-    c   = (unsigned)(dif >> (OD_EC_WINDOW_SIZE - 16));
+    c = (unsigned)(dif >> (OD_EC_DEC_WINDOW_SIZE - 16));
+#ifdef ARCH_X86_64
+    if (nsyms >= 4) {
+        ret = od_ec_find_symbol_sse2(icdf, nsyms, c, r);
+        u   = ret ? OD_EC_SYMBOL_BOUND(r, icdf[ret - 1], N - ret + 1) : r;
+        v   = OD_EC_SYMBOL_BOUND(r, icdf[ret], N - ret);
+        assert(v < u);
+        assert(u <= r);
+        r = u - v;
+        dif -= (OdEcDecWindow)v << (OD_EC_DEC_WINDOW_SIZE - 16);
+        return od_ec_dec_normalize(dec, dif, r, ret);
+    }
+#endif
     v   = r;
     ret = -1;
     do {
@@ -217,7 +258,7 @@ static int od_ec_decode_cdf_q15(OdEcDec *dec, const uint16_t *icdf, int nsyms) {
     assert(v < u);
     assert(u <= r);
     r = u - v;
-    dif -= (OdEcWindow)v << (OD_EC_WINDOW_SIZE - 16);
+    dif -= (OdEcDecWindow)v << (OD_EC_DEC_WINDOW_SIZE - 16);
     return od_ec_dec_normalize(dec, dif, r, ret);
 }
 
@@ -236,7 +277,7 @@ static int od_ec_decode_cdf_q15(OdEcDec *dec, const uint16_t *icdf, int nsyms) {
    call.*/
 static void od_ec_dec_refill(OdEcDec *dec) {
     int                  s;
-    OdEcWindow           dif;
+    OdEcDecWindow           dif;
     int16_t              cnt;
     const unsigned char *bptr;
     const unsigned char *end;
@@ -244,13 +285,13 @@ static void od_ec_dec_refill(OdEcDec *dec) {
     cnt  = dec->cnt;
     bptr = dec->bptr;
     end  = dec->end;
-    s    = OD_EC_WINDOW_SIZE - 9 - (cnt + 15);
+    s    = OD_EC_DEC_WINDOW_SIZE - 9 - (cnt + 15);
     for (; s >= 0 && bptr < end; s -= 8, bptr++) {
         /*Each time a byte is inserted into the window (dif), bptr advances and cnt
        is incremented by 8, so the total number of consumed bits (the return
        value of od_ec_dec_tell) does not change.*/
-        assert(s <= OD_EC_WINDOW_SIZE - 8);
-        dif ^= (OdEcWindow)bptr[0] << s;
+        assert(s <= OD_EC_DEC_WINDOW_SIZE - 8);
+        dif ^= (OdEcDecWindow)bptr[0] << s;
         cnt += 8;
     }
     if (bptr >= end) {
@@ -278,10 +319,10 @@ static void od_ec_dec_refill(OdEcDec *dec) {
   storage: The size in bytes of the input buffer.*/
 static void od_ec_dec_init(OdEcDec *dec, const unsigned char *buf, uint32_t storage) {
     dec->buf       = buf;
-    dec->tell_offs = 10 - (OD_EC_WINDOW_SIZE - 8);
+    dec->tell_offs = 10 - (OD_EC_DEC_WINDOW_SIZE - 8);
     dec->end       = buf + storage;
     dec->bptr      = buf;
-    dec->dif       = ((OdEcWindow)1 << (OD_EC_WINDOW_SIZE - 1)) - 1;
+    dec->dif       = ((OdEcDecWindow)1 << (OD_EC_DEC_WINDOW_SIZE - 1)) - 1;
     dec->rng       = 0x8000;
     dec->cnt       = -15;
     od_ec_dec_refill(dec);
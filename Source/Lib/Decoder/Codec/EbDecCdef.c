@@ -589,94 +589,105 @@ void svt_cdef_sb_row_mt(EbDecHandle *dec_handle, int32_t *mi_wide_l2, int32_t *m
     }
 }
 
-/* Frame level call, for CDEF */
-void svt_cdef_frame(EbDecHandle *dec_handle, int enable_flag) {
-    if (!enable_flag)
-        return;
-
+/* Frame level init of the single thread CDEF */
+void svt_cdef_frame_init(EbDecHandle *dec_handle, DecCdefCtxt *cdef_ctxt) {
     EbPictureBufferDesc *recon_picture_ptr = dec_handle->cur_pic_buf[0]->ps_pic_buf;
+    FrameHeader         *frame_info        = &dec_handle->frame_header;
+    const int32_t        num_planes = av1_num_planes(&dec_handle->seq_header.color_config);
+    const int32_t        nhfb       = (frame_info->mi_cols + MI_SIZE_64X64 - 1) / MI_SIZE_64X64;
 
-    uint8_t      *curr_blk_recon_buf[MAX_MB_PLANE];
-    int32_t       curr_recon_stride[MAX_MB_PLANE];
-    FrameHeader  *frame_info = &dec_handle->frame_header;
-    const int32_t num_planes = av1_num_planes(&dec_handle->seq_header.color_config);
+    cdef_ctxt->row_cdef = (uint8_t *)svt_aom_malloc(sizeof(*cdef_ctxt->row_cdef) * (nhfb + 2) * 2);
+    assert(cdef_ctxt->row_cdef != NULL);
+    memset(cdef_ctxt->row_cdef, 1, sizeof(*cdef_ctxt->row_cdef) * (nhfb + 2) * 2);
+    cdef_ctxt->prev_row_cdef = cdef_ctxt->row_cdef + 1;
+    cdef_ctxt->curr_row_cdef = cdef_ctxt->prev_row_cdef + nhfb + 2;
 
-    DECLARE_ALIGNED(16, uint16_t, src[CDEF_INBUF_SIZE]);
-    uint16_t     *linebuf[3];
-    uint16_t     *colbuf[3];
-    uint8_t      *row_cdef, *prev_row_cdef, *curr_row_cdef;
-    int32_t       mi_wide_l2[3];
-    int32_t       mi_high_l2[3];
-    const int32_t nvfb = (frame_info->mi_rows + MI_SIZE_64X64 - 1) / MI_SIZE_64X64;
-    const int32_t nhfb = (frame_info->mi_cols + MI_SIZE_64X64 - 1) / MI_SIZE_64X64;
-    row_cdef           = (uint8_t *)svt_aom_malloc(sizeof(*row_cdef) * (nhfb + 2) * 2);
-
-    assert(row_cdef != NULL);
-    memset(row_cdef, 1, sizeof(*row_cdef) * (nhfb + 2) * 2);
-    prev_row_cdef = row_cdef + 1;
-    curr_row_cdef = prev_row_cdef + nhfb + 2;
-
-    const int32_t stride = (frame_info->mi_cols << MI_SIZE_LOG2) + 2 * CDEF_HBORDER;
+    cdef_ctxt->linebuf_stride = (frame_info->mi_cols << MI_SIZE_LOG2) + 2 * CDEF_HBORDER;
 
     for (int32_t pli = 0; pli < num_planes; pli++) {
         int32_t sub_x = (pli == 0) ? 0 : dec_handle->seq_header.color_config.subsampling_x;
         int32_t sub_y = (pli == 0) ? 0 : dec_handle->seq_header.color_config.subsampling_y;
 
-        mi_wide_l2[pli] = MI_SIZE_LOG2 - sub_x;
-        mi_high_l2[pli] = MI_SIZE_LOG2 - sub_y;
+        cdef_ctxt->mi_wide_l2[pli] = MI_SIZE_LOG2 - sub_x;
+        cdef_ctxt->mi_high_l2[pli] = MI_SIZE_LOG2 - sub_y;
 
         /*Deriveing  recon pict buffer ptr's*/
         derive_blk_pointers(recon_picture_ptr,
                             pli,
                             0,
                             0,
-                            (void *)&curr_blk_recon_buf[pli],
-                            &curr_recon_stride[pli],
+                            (void *)&cdef_ctxt->curr_blk_recon_buf[pli],
+                            &cdef_ctxt->curr_recon_stride[pli],
                             sub_x,
                             sub_y);
         /*Allocating memory for line buffes->to fill from src if needed*/
-        linebuf[pli] = (uint16_t *)svt_aom_malloc(sizeof(*linebuf) * CDEF_VBORDER * stride);
+        cdef_ctxt->linebuf[pli] = (uint16_t *)svt_aom_malloc(
+            sizeof(*cdef_ctxt->linebuf) * CDEF_VBORDER * cdef_ctxt->linebuf_stride);
         /*Allocating memory for col buffes->to fill from src if needed*/
-        colbuf[pli] = (uint16_t *)svt_aom_malloc(
-            sizeof(*colbuf) * ((CDEF_BLOCKSIZE << mi_high_l2[pli]) + 2 * CDEF_VBORDER) *
-            CDEF_HBORDER);
+        cdef_ctxt->colbuf[pli] = (uint16_t *)svt_aom_malloc(
+            sizeof(*cdef_ctxt->colbuf) *
+            ((CDEF_BLOCKSIZE << cdef_ctxt->mi_high_l2[pli]) + 2 * CDEF_VBORDER) * CDEF_HBORDER);
     }
+}
 
-    /*Loop for 64x64 block wise, along col wise for frame size*/
-    for (int32_t fbr = 0; fbr < nvfb; fbr++) {
-        for (int32_t pli = 0; pli < num_planes; pli++) {
-            const int32_t block_height = (MI_SIZE_64X64 << mi_high_l2[pli]) + 2 * CDEF_VBORDER;
-            /*Filling the colbuff's with some values.*/
-            fill_rect(colbuf[pli], CDEF_HBORDER, block_height, CDEF_HBORDER, CDEF_VERY_LARGE);
-        }
+/* CDEF of a 64x64 filter block row, single thread. The rows are filtered in order, the line
+   buffer holding the unfiltered bottom lines of the row above. */
+void svt_cdef_fb_row(EbDecHandle *dec_handle, DecCdefCtxt *cdef_ctxt, int32_t fbr) {
+    FrameHeader  *frame_info = &dec_handle->frame_header;
+    const int32_t num_planes = av1_num_planes(&dec_handle->seq_header.color_config);
+    const int32_t nhfb       = (frame_info->mi_cols + MI_SIZE_64X64 - 1) / MI_SIZE_64X64;
 
-        uint32_t cdef_left = 1;
-        /*Loop for 64x64 block wise, along row wise for frame size*/
-        for (int32_t fbc = 0; fbc < nhfb; fbc++) {
-            svt_cdef_block(dec_handle,
-                           mi_wide_l2,
-                           mi_high_l2,
-                           colbuf,
-                           prev_row_cdef,
-                           curr_row_cdef,
-                           fbr,
-                           fbc,
-                           &cdef_left,
-                           num_planes,
-                           src,
-                           curr_recon_stride,
-                           curr_blk_recon_buf,
-                           linebuf,
-                           linebuf,
-                           stride);
-        }
-        uint8_t *tmp  = prev_row_cdef;
-        prev_row_cdef = curr_row_cdef;
-        curr_row_cdef = tmp;
+    for (int32_t pli = 0; pli < num_planes; pli++) {
+        const int32_t block_height = (MI_SIZE_64X64 << cdef_ctxt->mi_high_l2[pli]) +
+            2 * CDEF_VBORDER;
+        /*Filling the colbuff's with some values.*/
+        fill_rect(cdef_ctxt->colbuf[pli], CDEF_HBORDER, block_height, CDEF_HBORDER, CDEF_VERY_LARGE);
+    }
+
+    uint32_t cdef_left = 1;
+    /*Loop for 64x64 block wise, along row wise for frame size*/
+    for (int32_t fbc = 0; fbc < nhfb; fbc++) {
+        svt_cdef_block(dec_handle,
+                       cdef_ctxt->mi_wide_l2,
+                       cdef_ctxt->mi_high_l2,
+                       cdef_ctxt->colbuf,
+                       cdef_ctxt->prev_row_cdef,
+                       cdef_ctxt->curr_row_cdef,
+                       fbr,
+                       fbc,
+                       &cdef_left,
+                       num_planes,
+                       cdef_ctxt->src,
+                       cdef_ctxt->curr_recon_stride,
+                       cdef_ctxt->curr_blk_recon_buf,
+                       cdef_ctxt->linebuf,
+                       cdef_ctxt->linebuf,
+                       cdef_ctxt->linebuf_stride);
     }
-    svt_aom_free(row_cdef);
+    uint8_t *tmp             = cdef_ctxt->prev_row_cdef;
+    cdef_ctxt->prev_row_cdef = cdef_ctxt->curr_row_cdef;
+    cdef_ctxt->curr_row_cdef = tmp;
+}
+
+void svt_cdef_frame_free(EbDecHandle *dec_handle, DecCdefCtxt *cdef_ctxt) {
+    const int32_t num_planes = av1_num_planes(&dec_handle->seq_header.color_config);
+    svt_aom_free(cdef_ctxt->row_cdef);
     for (int32_t pli = 0; pli < num_planes; pli++) {
-        svt_aom_free(linebuf[pli]);
-        svt_aom_free(colbuf[pli]);
+        svt_aom_free(cdef_ctxt->linebuf[pli]);
+        svt_aom_free(cdef_ctxt->colbuf[pli]);
     }
 }
+
+/* Frame level call, for CDEF */
+void svt_cdef_frame(EbDecHandle *dec_handle, int enable_flag) {
+    if (!enable_flag)
+        return;
+
+    DecCdefCtxt   cdef_ctxt;
+    const int32_t nvfb = (dec_handle->frame_header.mi_rows + MI_SIZE_64X64 - 1) / MI_SIZE_64X64;
+
+    svt_cdef_frame_init(dec_handle, &cdef_ctxt);
+    /*Loop for 64x64 block wise, along col wise for frame size*/
+    for (int32_t fbr = 0; fbr < nvfb; fbr++) svt_cdef_fb_row(dec_handle, &cdef_ctxt, fbr);
+    svt_cdef_frame_free(dec_handle, &cdef_ctxt);
+}
@@ -21,6 +21,22 @@
 extern "C" {
 #endif
 
+/* State of the single thread CDEF over the filter block rows of a frame */
+typedef struct DecCdefCtxt {
+    uint8_t  *curr_blk_recon_buf[MAX_MB_PLANE];
+    int32_t   curr_recon_stride[MAX_MB_PLANE];
+    uint16_t *linebuf[MAX_MB_PLANE];
+    uint16_t *colbuf[MAX_MB_PLANE];
+    int32_t   linebuf_stride;
+    uint8_t  *row_cdef, *prev_row_cdef, *curr_row_cdef;
+    int32_t   mi_wide_l2[MAX_MB_PLANE];
+    int32_t   mi_high_l2[MAX_MB_PLANE];
+    DECLARE_ALIGNED(16, uint16_t, src[CDEF_INBUF_SIZE]);
+} DecCdefCtxt;
+
+void svt_cdef_frame_init(EbDecHandle *dec_handle, DecCdefCtxt *cdef_ctxt);
+void svt_cdef_fb_row(EbDecHandle *dec_handle, DecCdefCtxt *cdef_ctxt, int32_t fbr);
+void svt_cdef_frame_free(EbDecHandle *dec_handle, DecCdefCtxt *cdef_ctxt);
 void svt_cdef_frame(EbDecHandle *dec_handle, int enable_flag);
 
 void svt_cdef_sb_row_mt(EbDecHandle *dec_handle, int32_t *mi_wide_l2, int32_t *mi_high_l2,
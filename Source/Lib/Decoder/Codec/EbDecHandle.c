@@ -109,6 +109,7 @@ static EbErrorType svt_dec_handle_ctor(EbDecHandle    **decHandleDblPtr,
     svt_dec_lib_malloc_count = 0;
 
     dec_handle_ptr->start_thread_process = FALSE;
+    dec_handle_ptr->job_pool             = NULL;
     memory_map_start_address             = NULL;
     memory_map_end_address               = NULL;
 
@@ -389,7 +390,8 @@ int svt_dec_out_buf(EbDecHandle *dec_handle_ptr, EbBufferHeaderType *p_buffer) {
                                        out_img->cb_stride,
                                        use_high_bit_depth,
                                        sy,
-                                       sx);
+                                       sx,
+                                       dec_handle_ptr->job_pool);
         }
     }
 
@@ -558,6 +560,8 @@ EB_API EbErrorType svt_av1_dec_init(EbComponentType *svt_dec_component) {
     return_error = dec_mem_init(dec_handle_ptr);
     if (return_error != EB_ErrorNone)
         return return_error;
+    if (dec_handle_ptr->dec_config.threads > 1)
+        dec_handle_ptr->job_pool = svt_job_pool_create(dec_handle_ptr->dec_config.threads - 1);
 
     return return_error;
 }
@@ -635,6 +639,8 @@ EB_API EbErrorType svt_av1_dec_deinit(EbComponentType *svt_dec_component) {
         return EB_ErrorNone;
     if (dec_handle_ptr->dec_config.threads > 1)
         dec_sync_all_threads(dec_handle_ptr);
+    svt_job_pool_destroy(dec_handle_ptr->job_pool);
+    dec_handle_ptr->job_pool = NULL;
     if (!svt_dec_memory_map)
         return EB_ErrorNone;
 
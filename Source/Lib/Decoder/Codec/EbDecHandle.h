@@ -244,6 +244,8 @@ typedef struct EbDecHandle {
     Bool                  start_thread_process;
     EbHandle              thread_semaphore;
     struct DecThreadCtxt *thread_ctxt_pa;
+    // threads of the film grain application
+    SvtJobPool *job_pool;
 
     Bool
         is_16bit_pipeline; // internal bit-depth: when equals 1 internal bit-depth is 16bits regardless of the input bit-depth
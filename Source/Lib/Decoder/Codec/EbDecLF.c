@@ -747,25 +747,13 @@ void dec_loop_filter_row(EbDecHandle *dec_handle_ptr, EbPictureBufferDesc *recon
     }
 }
 
-/*Frame level function to trigger loop filter for each superblock*/
-void dec_av1_loop_filter_frame(EbDecHandle *dec_handle_ptr, EbPictureBufferDesc *recon_picture_buf,
-                               LfCtxt *lf_ctxt, int32_t plane_start, int32_t plane_end,
-                               int32_t is_mt, int enable_flag) {
-    if (!enable_flag)
-        return;
-
-    FrameHeader *frm_hdr      = &dec_handle_ptr->frame_header;
-    SeqHeader   *seq_header   = &dec_handle_ptr->seq_header;
-    uint8_t      sb_size_log2 = seq_header->sb_size_log2;
-
+/* Frame level init of the loop filter */
+void dec_av1_loop_filter_frame_init(EbDecHandle *dec_handle_ptr, LfCtxt *lf_ctxt,
+                                    int32_t plane_start, int32_t plane_end) {
+    FrameHeader     *frm_hdr = &dec_handle_ptr->frame_header;
     LoopFilterInfoN *lf_info = &lf_ctxt->lf_info;
     lf_ctxt->delta_lf_stride = dec_handle_ptr->main_frame_buf.sb_cols * FRAME_LF_COUNT;
 
-    int32_t  sb_size_w            = block_size_wide[seq_header->sb_size];
-    int32_t  sb_size_h            = block_size_high[seq_header->sb_size];
-    uint32_t pic_width_in_sb      = (frm_hdr->frame_size.frame_width + sb_size_w - 1) / sb_size_w;
-    uint32_t picture_height_in_sb = (frm_hdr->frame_size.frame_height + sb_size_h - 1) / sb_size_h;
-
     frm_hdr->loop_filter_params.combine_vert_horz_lf = 1;
     /*init hev threshold const vectors*/
     for (int lvl = 0; lvl <= MAX_LOOP_FILTER; lvl++)
@@ -775,43 +763,64 @@ void dec_av1_loop_filter_frame(EbDecHandle *dec_handle_ptr, EbPictureBufferDesc
 
     set_lbd_lf_filter_tap_functions();
     set_hbd_lf_filter_tap_functions();
+}
+
+/* Row level function to trigger loop filter for each superblock, single thread */
+void dec_av1_loop_filter_sb_row(EbDecHandle *dec_handle_ptr, EbPictureBufferDesc *recon_picture_buf,
+                                LfCtxt *lf_ctxt, uint32_t y_sb_index, int32_t plane_start,
+                                int32_t plane_end) {
+    FrameHeader  *frm_hdr         = &dec_handle_ptr->frame_header;
+    SeqHeader    *seq_header      = &dec_handle_ptr->seq_header;
+    uint8_t       sb_size_log2    = seq_header->sb_size_log2;
+    int32_t       sb_size_w       = block_size_wide[seq_header->sb_size];
+    uint32_t      pic_width_in_sb = (frm_hdr->frame_size.frame_width + sb_size_w - 1) / sb_size_w;
+    MainFrameBuf *main_frame_buf  = &dec_handle_ptr->main_frame_buf;
+    CurFrameBuf  *frame_buf       = &main_frame_buf->cur_frame_bufs[0];
 
-    if (is_mt) {
-        for (uint32_t y_sb_index = 0; y_sb_index < picture_height_in_sb; ++y_sb_index) {
+    for (uint32_t x_sb_index = 0; x_sb_index < pic_width_in_sb; ++x_sb_index) {
+        uint32_t sb_origin_x     = x_sb_index << sb_size_log2;
+        uint32_t sb_origin_y     = y_sb_index << sb_size_log2;
+        Bool     end_of_row_flag = x_sb_index == pic_width_in_sb - 1;
+
+        SBInfo *sb_info = frame_buf->sb_info +
+            (((y_sb_index * main_frame_buf->sb_cols) + x_sb_index));
+
+        /*LF function for a SB*/
+        dec_loop_filter_sb(dec_handle_ptr,
+                           sb_info,
+                           frm_hdr,
+                           seq_header,
+                           recon_picture_buf,
+                           lf_ctxt,
+                           sb_origin_y >> 2,
+                           sb_origin_x >> 2,
+                           plane_start,
+                           plane_end,
+                           end_of_row_flag,
+                           sb_info->sb_delta_lf);
+    }
+}
+
+/*Frame level function to trigger loop filter for each superblock*/
+void dec_av1_loop_filter_frame(EbDecHandle *dec_handle_ptr, EbPictureBufferDesc *recon_picture_buf,
+                               LfCtxt *lf_ctxt, int32_t plane_start, int32_t plane_end,
+                               int32_t is_mt, int enable_flag) {
+    if (!enable_flag)
+        return;
+
+    FrameHeader *frm_hdr              = &dec_handle_ptr->frame_header;
+    int32_t      sb_size_h            = block_size_high[dec_handle_ptr->seq_header.sb_size];
+    uint32_t     picture_height_in_sb = (frm_hdr->frame_size.frame_height + sb_size_h - 1) /
+        sb_size_h;
+
+    dec_av1_loop_filter_frame_init(dec_handle_ptr, lf_ctxt, plane_start, plane_end);
+
+    for (uint32_t y_sb_index = 0; y_sb_index < picture_height_in_sb; ++y_sb_index) {
+        if (is_mt)
             dec_loop_filter_row(
                 dec_handle_ptr, recon_picture_buf, lf_ctxt, y_sb_index, plane_start, plane_end);
-        }
-    } else {
-        /*Loop over a frame : tregger dec_loop_filter_sb for each SB*/
-        for (uint32_t y_sb_index = 0; y_sb_index < picture_height_in_sb; ++y_sb_index) {
-            for (uint32_t x_sb_index = 0; x_sb_index < pic_width_in_sb; ++x_sb_index) {
-                uint32_t sb_origin_x     = x_sb_index << sb_size_log2;
-                uint32_t sb_origin_y     = y_sb_index << sb_size_log2;
-                Bool     end_of_row_flag = x_sb_index == pic_width_in_sb - 1;
-
-                MainFrameBuf *main_frame_buf = &dec_handle_ptr->main_frame_buf;
-                CurFrameBuf  *frame_buf      = &main_frame_buf->cur_frame_bufs[0];
-
-                SBInfo *sb_info = frame_buf->sb_info +
-                    (((y_sb_index * main_frame_buf->sb_cols) + x_sb_index));
-
-                /*sb_info->sb_delta_lf = frame_buf->delta_lf + (FRAME_LF_COUNT *
-                    ((y_sb_index * main_frame_buf->sb_cols) + x_sb_index));*/
-
-                /*LF function for a SB*/
-                dec_loop_filter_sb(dec_handle_ptr,
-                                   sb_info,
-                                   frm_hdr,
-                                   seq_header,
-                                   recon_picture_buf,
-                                   lf_ctxt,
-                                   sb_origin_y >> 2,
-                                   sb_origin_x >> 2,
-                                   plane_start,
-                                   plane_end,
-                                   end_of_row_flag,
-                                   sb_info->sb_delta_lf);
-            }
-        }
+        else
+            dec_av1_loop_filter_sb_row(
+                dec_handle_ptr, recon_picture_buf, lf_ctxt, y_sb_index, plane_start, plane_end);
     }
 }
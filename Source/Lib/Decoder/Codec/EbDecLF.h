@@ -34,6 +34,11 @@ typedef struct LfCtxt {
 void fill_4x4_lf_param(LfCtxt *lf_ctxt, int32_t tu_x, int32_t tu_y, int32_t stride, TxSize tx_size,
                        int32_t sub_x, int32_t sub_y, int plane);
 
+void dec_av1_loop_filter_frame_init(EbDecHandle *dec_handle_ptr, LfCtxt *lf_ctxt,
+                                    int32_t plane_start, int32_t plane_end);
+void dec_av1_loop_filter_sb_row(EbDecHandle *dec_handle_ptr, EbPictureBufferDesc *recon_picture_buf,
+                                LfCtxt *lf_ctxt, uint32_t y_sb_index, int32_t plane_start,
+                                int32_t plane_end);
 void dec_av1_loop_filter_frame(EbDecHandle *dec_handle_ptr, EbPictureBufferDesc *recon_picture_buf,
                                LfCtxt *lf_ctxt, int32_t plane_start, int32_t plane_end,
                                int32_t is_mt, int enable_flag);
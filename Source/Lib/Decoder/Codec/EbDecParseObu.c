@@ -34,6 +34,7 @@
 #include "EbDecLF.h"
 
 #include "EbDecCdef.h"
+#include "EbDecPostFilter.h"
 #include "EbLog.h"
 
 void dec_av1_loop_filter_frame_mt(EbDecHandle         *dec_handle_ptr,
@@ -2405,54 +2406,59 @@ EbErrorType read_tile_group_obu(Bitstrm *bs, EbDecHandle *dec_handle_ptr, TilesI
     if ((tg_end + 1) != num_tiles)
         return 0;
 
-    if (is_mt) {
-        dec_av1_loop_filter_frame_mt(dec_handle_ptr,
-                                     dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf,
-                                     dec_handle_ptr->pv_lf_ctxt,
-                                     AOM_PLANE_Y,
-                                     MAX_MB_PLANE,
-                                     NULL);
+    if (!is_mt && !do_upscale) {
+        /* Deblocking, CDEF and LR run over the SB rows in one pass */
+        dec_av1_post_filter_frame(dec_handle_ptr, do_lf_flag, do_cdef, do_lr);
     } else {
-        dec_av1_loop_filter_frame(dec_handle_ptr,
-                                  dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf,
-                                  dec_handle_ptr->pv_lf_ctxt,
-                                  AOM_PLANE_Y,
-                                  MAX_MB_PLANE,
-                                  is_mt,
-                                  do_lf_flag);
-    }
-
-    if (!is_mt && do_lr)
-        dec_av1_loop_restoration_save_boundary_lines(dec_handle_ptr, 0);
-
-    if (is_mt) {
-        svt_cdef_frame_mt(dec_handle_ptr, NULL);
-    } else
-        svt_cdef_frame(dec_handle_ptr, do_cdef);
+        if (is_mt) {
+            dec_av1_loop_filter_frame_mt(dec_handle_ptr,
+                                         dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf,
+                                         dec_handle_ptr->pv_lf_ctxt,
+                                         AOM_PLANE_Y,
+                                         MAX_MB_PLANE,
+                                         NULL);
+        } else {
+            dec_av1_loop_filter_frame(dec_handle_ptr,
+                                      dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf,
+                                      dec_handle_ptr->pv_lf_ctxt,
+                                      AOM_PLANE_Y,
+                                      MAX_MB_PLANE,
+                                      is_mt,
+                                      do_lf_flag);
+        }
 
-    svt_av1_superres_upscale(&dec_handle_ptr->cm,
-                             &dec_handle_ptr->frame_header,
-                             &dec_handle_ptr->seq_header,
-                             dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf,
-                             do_upscale);
+        if (!is_mt && do_lr)
+            dec_av1_loop_restoration_save_boundary_lines(dec_handle_ptr, 0);
 
-    if (do_upscale)
-        dec_handle_ptr->cm.frm_size.frame_width =
-            dec_handle_ptr->frame_header.frame_size.frame_width;
+        if (is_mt) {
+            svt_cdef_frame_mt(dec_handle_ptr, NULL);
+        } else
+            svt_cdef_frame(dec_handle_ptr, do_cdef);
 
-    if (do_lr && (!is_mt || do_upscale))
-        dec_av1_loop_restoration_save_boundary_lines(dec_handle_ptr, 1);
+        svt_av1_superres_upscale(&dec_handle_ptr->cm,
+                                 &dec_handle_ptr->frame_header,
+                                 &dec_handle_ptr->seq_header,
+                                 dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf,
+                                 do_upscale);
 
-    if (is_mt) {
         if (do_upscale)
-            svt_av1_queue_lr_jobs(dec_handle_ptr);
-        dec_handle_ptr->main_frame_buf.cur_frame_bufs[0].dec_mt_frame_data.start_lr_frame = TRUE;
-        svt_post_semaphore(dec_handle_ptr->thread_semaphore);
-        for (uint32_t lib_thrd = 0; lib_thrd < num_threads - 1; lib_thrd++)
-            svt_post_semaphore(dec_handle_ptr->thread_ctxt_pa[lib_thrd].thread_semaphore);
-        dec_av1_loop_restoration_filter_frame_mt(dec_handle_ptr, NULL);
-    } else
-        dec_av1_loop_restoration_filter_frame(dec_handle_ptr, 0, /*opt_lr*/ do_lr);
+            dec_handle_ptr->cm.frm_size.frame_width =
+                dec_handle_ptr->frame_header.frame_size.frame_width;
+
+        if (do_lr && (!is_mt || do_upscale))
+            dec_av1_loop_restoration_save_boundary_lines(dec_handle_ptr, 1);
+
+        if (is_mt) {
+            if (do_upscale)
+                svt_av1_queue_lr_jobs(dec_handle_ptr);
+            dec_handle_ptr->main_frame_buf.cur_frame_bufs[0].dec_mt_frame_data.start_lr_frame = TRUE;
+            svt_post_semaphore(dec_handle_ptr->thread_semaphore);
+            for (uint32_t lib_thrd = 0; lib_thrd < num_threads - 1; lib_thrd++)
+                svt_post_semaphore(dec_handle_ptr->thread_ctxt_pa[lib_thrd].thread_semaphore);
+            dec_av1_loop_restoration_filter_frame_mt(dec_handle_ptr, NULL);
+        } else
+            dec_av1_loop_restoration_filter_frame(dec_handle_ptr, 0, /*opt_lr*/ do_lr);
+    }
 
     /* Save CDF */
     if (frame_header->disable_frame_end_update_cdf)
@@ -0,0 +1,147 @@
+/*
+* Copyright(c) 2019 Netflix, Inc.
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include "EbDefinitions.h"
+#include "EbDecHandle.h"
+#include "EbDecUtils.h"
+#include "EbDecProcessFrame.h"
+#include "EbDecLF.h"
+#include "EbDecCdef.h"
+#include "EbDecRestoration.h"
+#include "EbDecPostFilter.h"
+#include "EbRestoration.h"
+
+void pad_pre_lr(EbPictureBufferDesc *recon_picture_buf, int32_t sb_row, int32_t sb_size,
+                int32_t num_rows, uint8_t **curr_blk_recon_buf, int *rec_stride,
+                uint32_t frame_width, uint32_t frame_height, int sx, int sy);
+
+/* Single thread post filter of the frame. The deblocking, the CDEF and the LR run over the SB
+   rows one after the other, each one lagging behind the filter it reads from by the rows this
+   filter can still modify, so the rows are filtered by the 3 filters while they are in cache.
+   The output matches the frame level filters run one after the other. */
+void dec_av1_post_filter_frame(EbDecHandle *dec_handle_ptr, Bool do_lf, Bool do_cdef, Bool do_lr) {
+    EbPictureBufferDesc *recon_picture_buf = dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf;
+    FrameHeader         *frame_header      = &dec_handle_ptr->frame_header;
+    SeqHeader           *seq_header        = &dec_handle_ptr->seq_header;
+    LfCtxt              *lf_ctxt           = (LfCtxt *)dec_handle_ptr->pv_lf_ctxt;
+    LrCtxt              *lr_ctxt           = (LrCtxt *)dec_handle_ptr->pv_lr_ctxt;
+    const int32_t        num_planes        = av1_num_planes(&seq_header->color_config);
+    const int32_t        sb_size           = block_size_high[seq_header->sb_size];
+    const int32_t        frame_height      = frame_header->frame_size.frame_height;
+    const int32_t        sb_rows           = (frame_height + sb_size - 1) / sb_size;
+    /* 64x64 filter block rows, also the LR stripes offset upwards by 8 rows */
+    const int32_t nvfb = (frame_header->mi_rows + MI_SIZE_64X64 - 1) / MI_SIZE_64X64;
+
+    DecCdefCtxt  cdef_ctxt;
+    uint8_t     *curr_blk_recon_buf[MAX_MB_PLANE];
+    int32_t      curr_recon_stride[MAX_MB_PLANE];
+    int32_t      recon_stride[MAX_MB_PLANE];
+    Av1PixelRect tile_rect[MAX_MB_PLANE];
+    const int    sx = seq_header->color_config.subsampling_x;
+    const int    sy = seq_header->color_config.subsampling_y;
+
+    if (do_lf)
+        dec_av1_loop_filter_frame_init(dec_handle_ptr, lf_ctxt, AOM_PLANE_Y, MAX_MB_PLANE);
+    if (do_cdef)
+        svt_cdef_frame_init(dec_handle_ptr, &cdef_ctxt);
+    if (do_lr) {
+        const int32_t shift = (recon_picture_buf->bit_depth != EB_8BIT ||
+                               recon_picture_buf->is_16bit_pipeline)
+            ? 1
+            : 0;
+        for (int32_t pli = 0; pli < num_planes; pli++) {
+            int32_t sub_x = (pli == 0) ? 0 : sx;
+            int32_t sub_y = (pli == 0) ? 0 : sy;
+
+            /*Deriveing  recon pict buffer ptr's*/
+            derive_blk_pointers(recon_picture_buf,
+                                pli,
+                                0,
+                                0,
+                                (void *)&curr_blk_recon_buf[pli],
+                                &curr_recon_stride[pli],
+                                sub_x,
+                                sub_y);
+
+            tile_rect[pli] = whole_frame_rect(&frame_header->frame_size, sub_x, sub_y, pli > 0);
+        }
+        recon_stride[AOM_PLANE_Y] = recon_picture_buf->stride_y << shift;
+        recon_stride[AOM_PLANE_U] = recon_picture_buf->stride_cb << shift;
+        recon_stride[AOM_PLANE_V] = recon_picture_buf->stride_cr << shift;
+    }
+
+    int32_t lf_stripes_saved   = 0; // stripes with their deblocked boundary lines saved
+    int32_t cdef_stripes_saved = 0; // stripes with their CDEF boundary lines saved
+    int32_t cdef_fb_rows       = 0; // filter block rows done by the CDEF
+    int32_t lr_sb_rows         = 0; // SB rows done by the LR
+    for (int32_t sb_row = 0; sb_row < sb_rows; sb_row++) {
+        const Bool last = sb_row == sb_rows - 1;
+
+        if (do_lf)
+            dec_av1_loop_filter_sb_row(
+                dec_handle_ptr, recon_picture_buf, lf_ctxt, sb_row, AOM_PLANE_Y, MAX_MB_PLANE);
+
+        /* The deblocking of the next SB row modifies the last rows of this one, so the
+           deblocked rows are final up to the last 64 rows deblocked. A stripe needs the
+           deblocked lines on both its edges. */
+        const int32_t lf_fb_rows = last ? INT32_MAX : (((sb_row + 1) * sb_size) >> 6) - 1;
+        if (do_lr && lf_stripes_saved < lf_fb_rows) {
+            dec_av1_loop_restoration_save_boundary_lines_stripes(
+                dec_handle_ptr, 0, lf_stripes_saved, lf_fb_rows);
+            lf_stripes_saved = lf_fb_rows;
+        }
+
+        /* The CDEF of a filter block row reads the deblocked lines below it, and the lines
+           of the stripe edges must be saved before the CDEF modifies them */
+        const int32_t cdef_end = last ? nvfb : lf_fb_rows - 1;
+        for (; cdef_fb_rows < cdef_end; cdef_fb_rows++) {
+            if (do_cdef)
+                svt_cdef_fb_row(dec_handle_ptr, &cdef_ctxt, cdef_fb_rows);
+        }
+
+        if (!do_lr)
+            continue;
+        /* A stripe ends 8 rows above the end of its filter block row */
+        const int32_t cdef_stripes = last ? INT32_MAX : cdef_fb_rows;
+        if (cdef_stripes_saved < cdef_stripes) {
+            dec_av1_loop_restoration_save_boundary_lines_stripes(
+                dec_handle_ptr, 1, cdef_stripes_saved, cdef_stripes);
+            cdef_stripes_saved = cdef_stripes;
+        }
+        /* The LR of an SB row filters in place the stripes ending 8 rows above its end, and
+           reads the CDEF rows of its stripes only */
+        for (; lr_sb_rows < sb_rows && (last || (((lr_sb_rows + 1) * sb_size) >> 6) <= cdef_fb_rows);
+             lr_sb_rows++) {
+            /* Pad LR_PAD_SIDE pixels for each row before the
+               LR process starts for the current row. */
+            pad_pre_lr(recon_picture_buf,
+                       lr_sb_rows,
+                       sb_size,
+                       sb_rows,
+                       &curr_blk_recon_buf[AOM_PLANE_Y],
+                       &recon_stride[AOM_PLANE_Y],
+                       frame_header->frame_size.superres_upscaled_width,
+                       frame_height,
+                       sx,
+                       sy);
+            dec_av1_loop_restoration_filter_row(dec_handle_ptr,
+                                                lr_sb_rows,
+                                                &curr_blk_recon_buf[AOM_PLANE_Y],
+                                                &curr_recon_stride[AOM_PLANE_Y],
+                                                tile_rect,
+                                                0 /*opt_lr*/,
+                                                lr_ctxt->dst,
+                                                0);
+        }
+    }
+    if (do_cdef)
+        svt_cdef_frame_free(dec_handle_ptr, &cdef_ctxt);
+}
@@ -0,0 +1,27 @@
+/*
+* Copyright(c) 2019 Netflix, Inc.
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbDecPostFilter_h
+#define EbDecPostFilter_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "EbDecHandle.h"
+
+void dec_av1_post_filter_frame(EbDecHandle *dec_handle_ptr, Bool do_lf, Bool do_cdef, Bool do_lr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // EbDecPostFilter_h
@@ -24,6 +24,11 @@ void save_tile_row_boundary_lines(uint8_t *src, int32_t src_stride, int32_t src_
                                   int32_t src_height, int32_t use_highbd, int32_t plane,
                                   Av1Common *cm, int32_t after_cdef,
                                   RestorationStripeBoundaries *boundaries);
+void save_tile_row_boundary_lines_stripes(uint8_t *src, int32_t src_stride, int32_t src_width,
+                                          int32_t src_height, int32_t use_highbd, int32_t plane,
+                                          Av1Common *cm, int32_t after_cdef, int32_t stripe_start,
+                                          int32_t stripe_end,
+                                          RestorationStripeBoundaries *boundaries);
 
 void lr_generate_padding(
     EbByte   src_pic, //output paramter, pointer to the source picture(0,0).
@@ -522,7 +527,10 @@ void dec_av1_loop_restoration_filter_frame(EbDecHandle *dec_handle, int optimize
     }
 }
 
-void dec_av1_loop_restoration_save_boundary_lines(EbDecHandle *dec_handle, int after_cdef) {
+/* Saves the LR boundary lines of the stripes stripe_start to stripe_end - 1 */
+void dec_av1_loop_restoration_save_boundary_lines_stripes(EbDecHandle *dec_handle, int after_cdef,
+                                                          int32_t stripe_start,
+                                                          int32_t stripe_end) {
     const int num_planes = av1_num_planes(&dec_handle->seq_header.color_config);
     const int use_highbd = (dec_handle->seq_header.color_config.bit_depth > EB_8BIT ||
                             dec_handle->is_16bit_pipeline);
@@ -546,14 +554,20 @@ void dec_av1_loop_restoration_save_boundary_lines(EbDecHandle *dec_handle, int a
         int32_t  src_stride = stride;
         RestorationStripeBoundaries *boundaries = &lr_ctxt->boundaries[p];
 
-        save_tile_row_boundary_lines(src_buf,
-                                     src_stride,
-                                     crop_width,
-                                     crop_height,
-                                     use_highbd,
-                                     p,
-                                     &dec_handle->cm,
-                                     after_cdef,
-                                     boundaries);
+        save_tile_row_boundary_lines_stripes(src_buf,
+                                             src_stride,
+                                             crop_width,
+                                             crop_height,
+                                             use_highbd,
+                                             p,
+                                             &dec_handle->cm,
+                                             after_cdef,
+                                             stripe_start,
+                                             stripe_end,
+                                             boundaries);
     }
 }
+
+void dec_av1_loop_restoration_save_boundary_lines(EbDecHandle *dec_handle, int after_cdef) {
+    dec_av1_loop_restoration_save_boundary_lines_stripes(dec_handle, after_cdef, 0, INT32_MAX);
+}
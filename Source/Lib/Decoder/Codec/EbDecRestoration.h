@@ -25,6 +25,9 @@ extern "C" {
 #define LR_PAD_MAX (LR_PAD_SIDE << 1)
 
 void dec_av1_loop_restoration_save_boundary_lines(EbDecHandle *dec_handle, int after_cdef);
+void dec_av1_loop_restoration_save_boundary_lines_stripes(EbDecHandle *dec_handle, int after_cdef,
+                                                          int32_t stripe_start,
+                                                          int32_t stripe_end);
 void lr_pad_pic(EbPictureBufferDesc *recon_picture_buf, FrameHeader *frame_hdr,
                 EbColorConfig *color_cfg);
 void dec_av1_loop_restoration_filter_frame(EbDecHandle *dec_handle, int optimized_lr,
@@ -12,6 +12,9 @@
 #include "EbDefinitions.h"
 #include <immintrin.h>
 #include <math.h>
+#include "EbCdef.h"
+#include "EbBitstreamUnit.h"
+#include "synonyms.h"
 
 #define REDUCED_PRI_STRENGTHS 8
 #define REDUCED_TOTAL_STRENGTHS (REDUCED_PRI_STRENGTHS * CDEF_SEC_STRENGTHS)
@@ -521,3 +524,151 @@ uint64_t compute_cdef_dist_8bit_avx2(const uint8_t *dst8, int32_t dstride, const
     }
     return sum >> 2 * coeff_shift;
 }
+
+/* 16 pixels of the rows of a block 8 or 4 pixels wide, the rows row_step apart */
+static INLINE __m256i cdef_load_rows(const uint16_t *p, int32_t w, int32_t row_step) {
+    if (w == 8)
+        return _mm256_setr_m128i(_mm_loadu_si128((const __m128i *)p),
+                                 _mm_loadu_si128((const __m128i *)(p + row_step)));
+    const __m128i lo = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)p),
+                                          _mm_loadl_epi64((const __m128i *)(p + row_step)));
+    const __m128i hi = _mm_unpacklo_epi64(
+        _mm_loadl_epi64((const __m128i *)(p + 2 * row_step)),
+        _mm_loadl_epi64((const __m128i *)(p + 3 * row_step)));
+    return _mm256_setr_m128i(lo, hi);
+}
+
+static INLINE __m256i cdef_constrain_avx2(__m256i diff, __m256i abs_diff, __m256i threshold,
+                                          __m128i shift) {
+    const __m256i v = _mm256_min_epi16(
+        abs_diff, _mm256_subs_epu16(threshold, _mm256_srl_epi16(abs_diff, shift)));
+    return _mm256_sign_epi16(v, diff);
+}
+
+/* sum of the constrained differences of the taps, taps[0] weighing the 2 * pairs first ones
+   and taps[1] the others */
+static INLINE __m256i cdef_taps_sum_avx2(const __m256i *diff, const __m256i *abs_diff, int32_t pairs,
+                                         int32_t strength, int32_t damping, const int32_t *taps) {
+    if (!strength)
+        return _mm256_setzero_si256();
+    const __m256i threshold = _mm256_set1_epi16((int16_t)strength);
+    const __m128i shift     = _mm_cvtsi32_si128(AOMMAX(0, damping - get_msb(strength)));
+    __m256i       sum[2];
+    for (int32_t k = 0; k < 2; k++) {
+        sum[k] = _mm256_setzero_si256();
+        for (int32_t t = 2 * pairs * k; t < 2 * pairs * (k + 1); t++)
+            sum[k] = _mm256_add_epi16(
+                sum[k], cdef_constrain_avx2(diff[t], abs_diff[t], threshold, shift));
+    }
+    return _mm256_add_epi16(_mm256_mullo_epi16(sum[0], _mm256_set1_epi16((int16_t)taps[0])),
+                            _mm256_mullo_epi16(sum[1], _mm256_set1_epi16((int16_t)taps[1])));
+}
+
+void svt_cdef_search_block_sums_avx2(const uint16_t *in, int32_t dir, int32_t bsize,
+                                     uint8_t subsampling_factor, const int32_t *pri_strengths,
+                                     int32_t num_pri, int32_t pri_damping,
+                                     const int32_t *sec_strengths, int32_t num_sec,
+                                     int32_t sec_damping, int32_t coeff_shift, int16_t *range,
+                                     int16_t *pri_sums, int16_t *sec_sums) {
+    const int32_t w        = 4 << (int32_t)(bsize == BLOCK_8X8 || bsize == BLOCK_8X4);
+    const int32_t h        = 4 << (int32_t)(bsize == BLOCK_8X8 || bsize == BLOCK_4X8);
+    const int32_t row_step = subsampling_factor * CDEF_BSTRIDE;
+    const int32_t n        = h / subsampling_factor * w;
+    // the taps of the primary filter then of the secondary filter, by distance to the pixel
+    const int32_t offsets[6] = {eb_cdef_directions[dir][0],
+                                eb_cdef_directions[dir][1],
+                                eb_cdef_directions[(dir + 2) & 7][0],
+                                eb_cdef_directions[(dir + 6) & 7][0],
+                                eb_cdef_directions[(dir + 2) & 7][1],
+                                eb_cdef_directions[(dir + 6) & 7][1]};
+    const __m256i large = _mm256_set1_epi16(CDEF_VERY_LARGE);
+
+    for (int32_t v = 0; v < n; v += 16) {
+        const uint16_t *p = in + v / w * row_step;
+        const __m256i   x = cdef_load_rows(p, w, row_step);
+        __m256i         min = x, max = x;
+        __m256i         diff[12], abs_diff[12];
+        for (int32_t t = 0; t < 12; t++) {
+            const int32_t offset = (t & 1) ? -offsets[t >> 1] : offsets[t >> 1];
+            const __m256i tap    = cdef_load_rows(p + offset, w, row_step);
+            max = _mm256_max_epi16(max, _mm256_andnot_si256(_mm256_cmpeq_epi16(tap, large), tap));
+            min = _mm256_min_epi16(min, tap);
+            diff[t]     = _mm256_sub_epi16(tap, x);
+            abs_diff[t] = _mm256_abs_epi16(diff[t]);
+        }
+        _mm256_storeu_si256((__m256i *)(range + v), x);
+        _mm256_storeu_si256((__m256i *)(range + 64 + v), min);
+        _mm256_storeu_si256((__m256i *)(range + 128 + v), max);
+
+        for (int32_t s = 0; s < num_pri; s++)
+            _mm256_storeu_si256(
+                (__m256i *)(pri_sums + s * 64 + v),
+                cdef_taps_sum_avx2(diff,
+                                   abs_diff,
+                                   1,
+                                   pri_strengths[s],
+                                   pri_damping,
+                                   eb_cdef_pri_taps[(pri_strengths[s] >> coeff_shift) & 1]));
+        for (int32_t s = 0; s < num_sec; s++)
+            _mm256_storeu_si256((__m256i *)(sec_sums + s * 64 + v),
+                                cdef_taps_sum_avx2(diff + 4,
+                                                   abs_diff + 4,
+                                                   2,
+                                                   sec_strengths[s],
+                                                   sec_damping,
+                                                   eb_cdef_sec_taps[0]));
+    }
+}
+
+void svt_cdef_search_block_combine_avx2(const int16_t *range, const int16_t *pri_sum,
+                                        const int16_t *sec_sum, int32_t bsize,
+                                        uint8_t subsampling_factor, uint8_t *dst8,
+                                        uint16_t *dst16) {
+    const int32_t w        = 4 << (int32_t)(bsize == BLOCK_8X8 || bsize == BLOCK_8X4);
+    const int32_t h        = 4 << (int32_t)(bsize == BLOCK_8X8 || bsize == BLOCK_4X8);
+    const int32_t row_step = subsampling_factor * w;
+    const int32_t n        = h / subsampling_factor * w;
+
+    for (int32_t v = 0; v < n; v += 16) {
+        __m256i sum = _mm256_setzero_si256();
+        if (pri_sum)
+            sum = _mm256_loadu_si256((const __m256i *)(pri_sum + v));
+        if (sec_sum)
+            sum = _mm256_add_epi16(sum, _mm256_loadu_si256((const __m256i *)(sec_sum + v)));
+        // (8 + sum - (sum < 0)) >> 4
+        sum = _mm256_add_epi16(sum, _mm256_cmpgt_epi16(_mm256_setzero_si256(), sum));
+        sum = _mm256_srai_epi16(_mm256_add_epi16(sum, _mm256_set1_epi16(8)), 4);
+        __m256i y = _mm256_add_epi16(_mm256_loadu_si256((const __m256i *)(range + v)), sum);
+        y = _mm256_max_epi16(y, _mm256_loadu_si256((const __m256i *)(range + 64 + v)));
+        y = _mm256_min_epi16(y, _mm256_loadu_si256((const __m256i *)(range + 128 + v)));
+
+        const int32_t offset = v / w * row_step;
+        if (dst8) {
+            const __m256i y8 = _mm256_packus_epi16(y, y);
+            const __m128i lo = _mm256_castsi256_si128(y8);
+            const __m128i hi = _mm256_extracti128_si256(y8, 1);
+            if (w == 8) {
+                xx_storel_64(dst8 + offset, lo);
+                xx_storel_64(dst8 + offset + row_step, hi);
+            } else {
+                xx_storel_32(dst8 + offset, lo);
+                xx_storel_32(dst8 + offset + row_step, _mm_srli_si128(lo, 4));
+                xx_storel_32(dst8 + offset + 2 * row_step, hi);
+                xx_storel_32(dst8 + offset + 3 * row_step, _mm_srli_si128(hi, 4));
+            }
+        } else {
+            const __m128i lo = _mm256_castsi256_si128(y);
+            const __m128i hi = _mm256_extracti128_si256(y, 1);
+            if (w == 8) {
+                _mm_storeu_si128((__m128i *)(dst16 + offset), lo);
+                _mm_storeu_si128((__m128i *)(dst16 + offset + row_step), hi);
+            } else {
+                _mm_storel_epi64((__m128i *)(dst16 + offset), lo);
+                _mm_storel_epi64((__m128i *)(dst16 + offset + row_step), _mm_srli_si128(lo, 8));
+                _mm_storel_epi64((__m128i *)(dst16 + offset + 2 * row_step), hi);
+                _mm_storel_epi64((__m128i *)(dst16 + offset + 3 * row_step),
+                                 _mm_srli_si128(hi, 8));
+            }
+        }
+    }
+}
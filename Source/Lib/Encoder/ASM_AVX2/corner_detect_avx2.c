@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+ */
+
+#include <immintrin.h>
+#include "corner_detect.h"
+#include "aom_dsp_rtcd.h"
+#include "EbBitstreamUnit.h"
+
+// 0xff in the lanes of q not brighter than (center + b) saturated
+static INLINE __m256i not_brighter(__m256i q, __m256i bright_th) {
+    return _mm256_cmpeq_epi8(_mm256_subs_epu8(q, bright_th), _mm256_setzero_si256());
+}
+
+// 0xff in the lanes of q not darker than (center - b) saturated
+static INLINE __m256i not_darker(__m256i q, __m256i dark_th) {
+    return _mm256_cmpeq_epi8(_mm256_subs_epu8(dark_th, q), _mm256_setzero_si256());
+}
+
+// 0xff in the lanes where no 9 contiguous of the 16 masks are clear
+static INLINE __m256i no_arc9(const __m256i m[16]) {
+    __m256i pair[16], quad[16], oct[16];
+    __m256i result = _mm256_set1_epi8(-1);
+    for (int i = 0; i < 16; i++) pair[i] = _mm256_or_si256(m[i], m[(i + 1) & 15]);
+    for (int i = 0; i < 16; i++) quad[i] = _mm256_or_si256(pair[i], pair[(i + 2) & 15]);
+    for (int i = 0; i < 16; i++) oct[i] = _mm256_or_si256(quad[i], quad[(i + 4) & 15]);
+    for (int i = 0; i < 16; i++)
+        result = _mm256_and_si256(result, _mm256_or_si256(oct[i], m[(i + 8) & 15]));
+    return result;
+}
+
+int svt_av1_fast9_detect_row_avx2(const uint8_t *row, int stride, int x_start, int x_end, int b,
+                                  int *corner_x) {
+    int offsets[16];
+    int count = 0;
+    int x     = x_start;
+    svt_av1_fast9_circle_offsets(offsets, stride);
+    // b beyond 255 leaves no corner, as for the saturated thresholds
+    const __m256i barrier = _mm256_set1_epi8((char)AOMMIN(b, 255));
+    for (; x + 32 <= x_end; x += 32) {
+        const uint8_t *p         = row + x;
+        const __m256i  center    = _mm256_loadu_si256((const __m256i *)p);
+        const __m256i  bright_th = _mm256_adds_epu8(center, barrier);
+        const __m256i  dark_th   = _mm256_subs_epu8(center, barrier);
+        __m256i        nb[16], nd[16];
+        // any 9 contiguous pixels of the circle hold one of the pixels 0 and 8
+        // and one of the pixels 4 and 12
+        for (int i = 0; i < 16; i += 4) {
+            const __m256i q = _mm256_loadu_si256((const __m256i *)(p + offsets[i]));
+            nb[i]           = not_brighter(q, bright_th);
+            nd[i]           = not_darker(q, dark_th);
+        }
+        const __m256i reject_b = _mm256_or_si256(_mm256_and_si256(nb[0], nb[8]),
+                                                 _mm256_and_si256(nb[4], nb[12]));
+        const __m256i reject_d = _mm256_or_si256(_mm256_and_si256(nd[0], nd[8]),
+                                                 _mm256_and_si256(nd[4], nd[12]));
+        if (_mm256_movemask_epi8(_mm256_and_si256(reject_b, reject_d)) == -1)
+            continue;
+        for (int i = 0; i < 16; i++) {
+            if (!(i & 3))
+                continue;
+            const __m256i q = _mm256_loadu_si256((const __m256i *)(p + offsets[i]));
+            nb[i]           = not_brighter(q, bright_th);
+            nd[i]           = not_darker(q, dark_th);
+        }
+        uint32_t corners = ~(uint32_t)_mm256_movemask_epi8(
+            _mm256_and_si256(no_arc9(nb), no_arc9(nd)));
+        while (corners) {
+            const int lane = get_msb(corners & (0u - corners));
+            corner_x[count++] = x + lane;
+            corners &= corners - 1;
+        }
+    }
+    if (x < x_end)
+        count += svt_av1_fast9_detect_row_c(row, stride, x, x_end, b, corner_x + count);
+    return count;
+}
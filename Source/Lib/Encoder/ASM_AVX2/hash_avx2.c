@@ -0,0 +1,103 @@
+/*
+* Copyright (c) 2019, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <immintrin.h>
+#include "aom_dsp_rtcd.h"
+
+// crc of 8 bytes, each at position k from the end of its message
+static INLINE __m256i crc_slice_gather(const CRC_CALCULATOR *crc, int k, __m256i bytes) {
+    return _mm256_i32gather_epi32((const int *)crc->slice_table[k], bytes, 4);
+}
+
+static INLINE __m256i load_u8_epi32(const uint8_t *p) {
+    return _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)p));
+}
+
+void svt_av1_block_2x2_hash_row_avx2(const uint8_t *src, int stride, int count,
+                                     const CRC_CALCULATOR *crc_calculator1,
+                                     const CRC_CALCULATOR *crc_calculator2, uint32_t *hash_value1,
+                                     uint32_t *hash_value2) {
+    int x = 0;
+    // the loads read 9 pixels of each row for 8 blocks
+    for (; x + 8 <= count; x += 8) {
+        const __m256i p0 = load_u8_epi32(src + x);
+        const __m256i p1 = load_u8_epi32(src + x + 1);
+        const __m256i p2 = load_u8_epi32(src + x + stride);
+        const __m256i p3 = load_u8_epi32(src + x + stride + 1);
+
+        __m256i h1 = _mm256_xor_si256(crc_slice_gather(crc_calculator1, 3, p0),
+                                      crc_slice_gather(crc_calculator1, 2, p1));
+        h1         = _mm256_xor_si256(h1, crc_slice_gather(crc_calculator1, 1, p2));
+        h1         = _mm256_xor_si256(h1, crc_slice_gather(crc_calculator1, 0, p3));
+        __m256i h2 = _mm256_xor_si256(crc_slice_gather(crc_calculator2, 3, p0),
+                                      crc_slice_gather(crc_calculator2, 2, p1));
+        h2         = _mm256_xor_si256(h2, crc_slice_gather(crc_calculator2, 1, p2));
+        h2         = _mm256_xor_si256(h2, crc_slice_gather(crc_calculator2, 0, p3));
+        _mm256_storeu_si256((__m256i *)(hash_value1 + x), h1);
+        _mm256_storeu_si256((__m256i *)(hash_value2 + x), h2);
+    }
+    if (x < count)
+        svt_av1_block_2x2_hash_row_c(src + x,
+                                     stride,
+                                     count - x,
+                                     crc_calculator1,
+                                     crc_calculator2,
+                                     hash_value1 + x,
+                                     hash_value2 + x);
+}
+
+// crc of the 16 byte messages made of the 4 little endian words w[0..3], the
+// words being crcs of the calculator their bytes above its width are zero
+static INLINE __m256i crc_words(const CRC_CALCULATOR *crc, const __m256i w[4]) {
+    const __m256i byte_mask  = _mm256_set1_epi32(0xff);
+    const int     word_bytes = (crc->bits + 7) >> 3;
+    __m256i       h          = _mm256_setzero_si256();
+    for (int j = 0; j < 4; j++) {
+        for (int b = 0; b < word_bytes; b++) {
+            const __m256i bytes = _mm256_and_si256(_mm256_srli_epi32(w[j], 8 * b), byte_mask);
+            h = _mm256_xor_si256(h, crc_slice_gather(crc, 15 - 4 * j - b, bytes));
+        }
+    }
+    return h;
+}
+
+static INLINE void load_quad(const uint32_t *src, int src_size, int bottom, __m256i w[4]) {
+    w[0] = _mm256_loadu_si256((const __m256i *)src);
+    w[1] = _mm256_loadu_si256((const __m256i *)(src + src_size));
+    w[2] = _mm256_loadu_si256((const __m256i *)(src + bottom));
+    w[3] = _mm256_loadu_si256((const __m256i *)(src + bottom + src_size));
+}
+
+void svt_av1_block_hash_row_avx2(const uint32_t *src_hash1, const uint32_t *src_hash2,
+                                 int src_size, int pic_width, int count,
+                                 const CRC_CALCULATOR *crc_calculator1,
+                                 const CRC_CALCULATOR *crc_calculator2, uint32_t *dst_hash1,
+                                 uint32_t *dst_hash2) {
+    const int bottom = src_size * pic_width;
+    __m256i   w[4];
+    int       x = 0;
+    for (; x + 8 <= count; x += 8) {
+        load_quad(src_hash1 + x, src_size, bottom, w);
+        _mm256_storeu_si256((__m256i *)(dst_hash1 + x), crc_words(crc_calculator1, w));
+        load_quad(src_hash2 + x, src_size, bottom, w);
+        _mm256_storeu_si256((__m256i *)(dst_hash2 + x), crc_words(crc_calculator2, w));
+    }
+    if (x < count)
+        svt_av1_block_hash_row_c(src_hash1 + x,
+                                 src_hash2 + x,
+                                 src_size,
+                                 pic_width,
+                                 count - x,
+                                 crc_calculator1,
+                                 crc_calculator2,
+                                 dst_hash1 + x,
+                                 dst_hash2 + x);
+}
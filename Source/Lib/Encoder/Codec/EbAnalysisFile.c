@@ -0,0 +1,386 @@
+/*
+* Copyright (c) 2019, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <string.h>
+
+#include "EbAnalysisFile.h"
+#include "EbSequenceControlSet.h"
+#include "EbPictureControlSet.h"
+#include "EbReferenceObject.h"
+#include "EbMotionEstimationLcuResults.h"
+#include "EbUtility.h"
+#include "EbMalloc.h"
+#include "EbLog.h"
+
+#ifdef _WIN32
+#define analysis_fseek _fseeki64
+#define analysis_ftell _ftelli64
+#else
+#define analysis_fseek fseeko
+#define analysis_ftell ftello
+#endif
+
+#define ANALYSIS_FILE_MAGIC "SVTANLYS"
+#define ANALYSIS_FILE_VERSION 2
+// words of the file header following the magic
+#define ANALYSIS_FILE_HEADER_WORDS 10
+// bytes of a record before the per SB results: key, source and filter hashes, picture and ME
+// layout
+#define ANALYSIS_RECORD_HEADER_SIZE (8 + 8 + 8 + 8)
+// records can't describe more pictures than that, a larger key means a corrupted file
+#define ANALYSIS_MAX_PICTURES (1ULL << 31)
+
+/**************************************
+ * The file starts with the magic and the settings the motion analysis
+ * depends on, followed by one record per picture in decode order:
+ *   uint32 size of the record after this field
+ *   uint64 picture number, uint64 hash of the sources the ME results depend on,
+ *   uint64 hash of the temporal filter settings of the picture and its references
+ *   uint8  slice type, list0 / list1 reference counts, PUs per SB, max refs,
+ *          max candidates, uint16 SB count
+ *   global motion flag and parameters of each reference
+ *   per SB: candidate counts, MVs, candidates and the SB distortions
+ * Fields are stored in the byte order of the machine that wrote them.
+ **************************************/
+static void analysis_header_words(const SequenceControlSet *scs_ptr,
+                                  uint32_t                  words[ANALYSIS_FILE_HEADER_WORDS]) {
+    words[0] = ANALYSIS_FILE_VERSION;
+    words[1] = scs_ptr->max_input_luma_width;
+    words[2] = scs_ptr->max_input_luma_height;
+    words[3] = scs_ptr->sb_sz;
+    words[4] = scs_ptr->sb_total_count;
+    words[5] = (uint32_t)scs_ptr->static_config.enc_mode;
+    words[6] = scs_ptr->static_config.hierarchical_levels;
+    words[7] = scs_ptr->static_config.pred_structure;
+    words[8] = scs_ptr->static_config.enable_tf;
+    words[9] = scs_ptr->static_config.tune;
+}
+
+static size_t analysis_record_size(uint32_t sb_count, uint32_t npus, uint32_t max_refs,
+                                   uint32_t max_cand) {
+    const size_t gm_size = MAX_NUM_OF_REF_PIC_LIST * REF_LIST_MAX_DEPTH *
+        (1 + sizeof(EbWarpedMotionParams));
+    const size_t sb_size = npus * (sizeof(uint8_t) + max_refs * sizeof(MvCandidate) +
+                                   max_cand * sizeof(MeCandidate)) +
+        6 * sizeof(uint32_t) + 2 * sizeof(uint8_t);
+    return ANALYSIS_RECORD_HEADER_SIZE + gm_size + sb_count * sb_size;
+}
+
+static INLINE uint8_t *analysis_put(uint8_t *dst, const void *src, size_t size) {
+    memcpy(dst, src, size);
+    return dst + size;
+}
+
+static INLINE const uint8_t *analysis_get(const uint8_t *src, void *dst, size_t size) {
+    memcpy(dst, src, size);
+    return src + size;
+}
+
+static EbErrorType analysis_index_records(AnalysisFile *af) {
+    for (;;) {
+        const int64_t offset = analysis_ftell(af->file);
+        uint32_t      size;
+        uint64_t      key;
+        if (fread(&size, sizeof(size), 1, af->file) != 1 ||
+            fread(&key, sizeof(key), 1, af->file) != 1)
+            return EB_ErrorNone;
+        if (size > af->buffer_size || size < ANALYSIS_RECORD_HEADER_SIZE ||
+            key >= ANALYSIS_MAX_PICTURES)
+            return EB_ErrorBadParameter;
+        if (key >= af->record_count) {
+            const uint64_t count = MAX(key + 1, af->record_count * 2);
+            EB_REALLOC_ARRAY(af->record_offset, count);
+            if (!af->record_offset)
+                return EB_ErrorInsufficientResources;
+            memset(af->record_offset + af->record_count,
+                   0,
+                   (count - af->record_count) * sizeof(*af->record_offset));
+            af->record_count = count;
+        }
+        af->record_offset[key] = offset;
+        if (analysis_fseek(af->file, size - sizeof(key), SEEK_CUR))
+            return EB_ErrorBadParameter;
+    }
+}
+
+/**************************************
+ * analysis_file_open
+ *   Creates the file and writes its header, or opens an existing file,
+ *   checks that it was written with the same settings and indexes its records.
+ **************************************/
+EbErrorType analysis_file_open(AnalysisFile **af_ptr, SequenceControlSet *scs_ptr,
+                               const char *path, Bool write) {
+    uint32_t words[ANALYSIS_FILE_HEADER_WORDS];
+    analysis_header_words(scs_ptr, words);
+
+    AnalysisFile *af;
+    EB_CALLOC(af, 1, sizeof(*af));
+    *af_ptr         = af;
+    af->write       = write;
+    af->buffer_size = analysis_record_size(
+        scs_ptr->sb_total_count, SQUARE_PU_COUNT, MAX_PA_ME_MV, MAX_PA_ME_CAND);
+    EB_MALLOC(af->buffer, af->buffer_size);
+
+    FOPEN(af->file, path, write ? "wb" : "rb");
+    if (!af->file) {
+        SVT_ERROR("Instance %u: can't open analysis file %s\n",
+                  scs_ptr->static_config.channel_id + 1,
+                  path);
+        return EB_ErrorBadParameter;
+    }
+    if (write) {
+        if (fwrite(ANALYSIS_FILE_MAGIC, 8, 1, af->file) != 1 ||
+            fwrite(words, sizeof(words), 1, af->file) != 1) {
+            SVT_ERROR("Instance %u: can't write analysis file %s\n",
+                      scs_ptr->static_config.channel_id + 1,
+                      path);
+            return EB_ErrorBadParameter;
+        }
+        return EB_ErrorNone;
+    }
+
+    char     magic[8];
+    uint32_t file_words[ANALYSIS_FILE_HEADER_WORDS];
+    if (fread(magic, sizeof(magic), 1, af->file) != 1 ||
+        fread(file_words, sizeof(file_words), 1, af->file) != 1 ||
+        memcmp(magic, ANALYSIS_FILE_MAGIC, sizeof(magic))) {
+        SVT_ERROR("Instance %u: %s is not an analysis file\n",
+                  scs_ptr->static_config.channel_id + 1,
+                  path);
+        return EB_ErrorBadParameter;
+    }
+    if (memcmp(words, file_words, sizeof(words))) {
+        SVT_ERROR("Instance %u: analysis file %s was written with a different resolution, preset, "
+                  "prediction structure, temporal filtering or tune\n",
+                  scs_ptr->static_config.channel_id + 1,
+                  path);
+        return EB_ErrorBadParameter;
+    }
+    const EbErrorType return_error = analysis_index_records(af);
+    if (return_error != EB_ErrorNone)
+        SVT_ERROR("Instance %u: analysis file %s is corrupted\n",
+                  scs_ptr->static_config.channel_id + 1,
+                  path);
+    return return_error;
+}
+
+void analysis_file_close(AnalysisFile **af_ptr) {
+    AnalysisFile *af = *af_ptr;
+    if (!af)
+        return;
+    if (af->file)
+        fclose(af->file);
+    EB_FREE_ARRAY(af->record_offset);
+    EB_FREE(af->buffer);
+    EB_FREE(af);
+    *af_ptr = NULL;
+}
+
+static INLINE uint64_t analysis_hash_combine(uint64_t hash, uint64_t value) {
+    hash = (hash ^ value) * 0x100000001b3ULL;
+    return hash ^ (hash >> 29);
+}
+
+/**************************************
+ * analysis_hash_picture
+ *   Checksum of the visible luma samples, used to tell whether an imported
+ *   record was computed on the same source picture.
+ **************************************/
+uint64_t analysis_hash_picture(const EbPictureBufferDesc *pic, uint32_t width, uint32_t height) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (uint32_t y = 0; y < height; y++) {
+        const uint8_t *row = pic->buffer_y + (pic->origin_y + y) * pic->stride_y + pic->origin_x;
+        uint32_t       x   = 0;
+        for (; x + 8 <= width; x += 8) {
+            uint64_t word;
+            memcpy(&word, row + x, sizeof(word));
+            hash = analysis_hash_combine(hash, word);
+        }
+        for (; x < width; x++) hash = (hash ^ row[x]) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+/**************************************
+ * analysis_mark_filtered
+ *   Records that the picture was temporally filtered. The filter strength
+ *   depends on the QP (CRF), so the ME results of the picture and of the
+ *   pictures referencing it are only imported by encodes filtering it at the
+ *   same QP; the other pictures are still shared across QPs.
+ **************************************/
+void analysis_mark_filtered(PictureParentControlSet *pcs_ptr) {
+    const SequenceControlSet *scs_ptr = pcs_ptr->scs_ptr;
+    EbPaReferenceObject      *pa_ref_obj =
+        (EbPaReferenceObject *)pcs_ptr->pa_reference_picture_wrapper_ptr->object_ptr;
+    pcs_ptr->filter_hash    = analysis_hash_combine(0xcbf29ce484222325ULL,
+                                                 scs_ptr->static_config.qp);
+    pa_ref_obj->filter_hash = pcs_ptr->filter_hash;
+}
+
+/**************************************
+ * analysis_dependency_hash
+ *   Combines the checksums of the sources the ME results of a picture were
+ *   computed from: the picture itself, its references and, when the picture
+ *   is temporally filtered, the pictures of the filtering window. The
+ *   temporal filter settings of the picture and its references are combined
+ *   in analysis_filter_hash.
+ **************************************/
+uint64_t analysis_dependency_hash(PictureParentControlSet *pcs_ptr) {
+    uint64_t hash        = analysis_hash_combine(0xcbf29ce484222325ULL, pcs_ptr->source_hash);
+    uint64_t filter_hash = analysis_hash_combine(0xcbf29ce484222325ULL, pcs_ptr->filter_hash);
+    if (pcs_ptr->slice_type != I_SLICE) {
+        const uint8_t ref_count[MAX_NUM_OF_REF_PIC_LIST] = {
+            pcs_ptr->ref_list0_count_try,
+            pcs_ptr->slice_type == B_SLICE ? pcs_ptr->ref_list1_count_try : 0};
+        for (int list = 0; list < MAX_NUM_OF_REF_PIC_LIST; list++)
+            for (int ref = 0; ref < ref_count[list]; ref++) {
+                const EbPaReferenceObject *ref_obj =
+                    (const EbPaReferenceObject *)pcs_ptr->ref_pa_pic_ptr_array[list][ref]->object_ptr;
+                hash        = analysis_hash_combine(hash, ref_obj->source_hash);
+                filter_hash = analysis_hash_combine(filter_hash, ref_obj->filter_hash);
+            }
+    }
+    if (pcs_ptr->tf_ctrls.enabled) {
+        const int frames = pcs_ptr->past_altref_nframes + pcs_ptr->future_altref_nframes + 1;
+        for (int i = 0; i < frames; i++)
+            hash = analysis_hash_combine(hash, pcs_ptr->temp_filt_pcs_list[i]->source_hash);
+    }
+    pcs_ptr->analysis_filter_hash = filter_hash;
+    return hash;
+}
+
+/**************************************
+ * analysis_write_picture
+ *   Appends the motion analysis of a picture once all its ME segments are done.
+ **************************************/
+void analysis_write_picture(AnalysisFile *af, PictureParentControlSet *pcs_ptr) {
+    if (af->halted || pcs_ptr->slice_type == I_SLICE || pcs_ptr->is_overlay)
+        return;
+    const MotionEstimationData *me       = pcs_ptr->pa_me_data;
+    const uint32_t              sb_count = pcs_ptr->sb_total_count;
+    const uint32_t              npus     = pcs_ptr->max_number_of_pus_per_sb;
+    const size_t size = analysis_record_size(sb_count, npus, me->max_refs, me->max_cand);
+    if (size > af->buffer_size)
+        return;
+
+    const uint64_t key     = pcs_ptr->picture_number;
+    const uint8_t  info[8] = {(uint8_t)pcs_ptr->slice_type,
+                              pcs_ptr->ref_list0_count_try,
+                              pcs_ptr->ref_list1_count_try,
+                              npus,
+                              me->max_refs,
+                              me->max_cand,
+                              (uint8_t)(sb_count & 0xff),
+                              (uint8_t)(sb_count >> 8)};
+    uint8_t       *p       = af->buffer;
+    p = analysis_put(p, &key, sizeof(key));
+    p = analysis_put(p, &pcs_ptr->analysis_hash, sizeof(pcs_ptr->analysis_hash));
+    p = analysis_put(p, &pcs_ptr->analysis_filter_hash, sizeof(pcs_ptr->analysis_filter_hash));
+    p = analysis_put(p, info, sizeof(info));
+    for (int list = 0; list < MAX_NUM_OF_REF_PIC_LIST; list++)
+        for (int ref = 0; ref < REF_LIST_MAX_DEPTH; ref++) {
+            const uint8_t is_gm = (uint8_t)pcs_ptr->is_global_motion[list][ref];
+            p = analysis_put(p, &is_gm, 1);
+            p = analysis_put(
+                p, &pcs_ptr->global_motion_estimation[list][ref], sizeof(EbWarpedMotionParams));
+        }
+    for (uint32_t sb = 0; sb < sb_count; sb++) {
+        const MeSbResults *res = me->me_results[sb];
+        p = analysis_put(p, res->total_me_candidate_index, npus);
+        p = analysis_put(p, res->me_mv_array, npus * me->max_refs * sizeof(MvCandidate));
+        p = analysis_put(p, res->me_candidate_array, npus * me->max_cand * sizeof(MeCandidate));
+        p = analysis_put(p, &pcs_ptr->rc_me_distortion[sb], sizeof(uint32_t));
+        p = analysis_put(p, &pcs_ptr->me_8x8_cost_variance[sb], sizeof(uint32_t));
+        p = analysis_put(p, &pcs_ptr->me_64x64_distortion[sb], sizeof(uint32_t));
+        p = analysis_put(p, &pcs_ptr->me_32x32_distortion[sb], sizeof(uint32_t));
+        p = analysis_put(p, &pcs_ptr->me_16x16_distortion[sb], sizeof(uint32_t));
+        p = analysis_put(p, &pcs_ptr->me_8x8_distortion[sb], sizeof(uint32_t));
+        p = analysis_put(p, &pcs_ptr->stationary_block_present_sb[sb], 1);
+        p = analysis_put(p, &pcs_ptr->rc_me_allow_gm[sb], 1);
+    }
+    assert((size_t)(p - af->buffer) == size);
+
+    const uint32_t record_size = (uint32_t)size;
+    if (fwrite(&record_size, sizeof(record_size), 1, af->file) != 1 ||
+        fwrite(af->buffer, size, 1, af->file) != 1) {
+        SVT_WARN("analysis file: write failed, the remaining pictures are not exported\n");
+        af->halted = TRUE;
+    }
+}
+
+/**************************************
+ * analysis_read_picture
+ *   Fills the motion analysis of a picture from its record. Returns FALSE
+ *   when the picture has no usable record and has to go through ME. A record
+ *   computed on a different source stops the import for the rest of the encode.
+ **************************************/
+Bool analysis_read_picture(AnalysisFile *af, PictureParentControlSet *pcs_ptr) {
+    const uint64_t key = pcs_ptr->picture_number;
+    if (af->halted || pcs_ptr->slice_type == I_SLICE || pcs_ptr->is_overlay ||
+        key >= af->record_count || !af->record_offset[key])
+        return FALSE;
+    MotionEstimationData *me       = pcs_ptr->pa_me_data;
+    const uint32_t        sb_count = pcs_ptr->sb_total_count;
+    const uint32_t        npus     = pcs_ptr->max_number_of_pus_per_sb;
+    const size_t size = analysis_record_size(sb_count, npus, me->max_refs, me->max_cand);
+
+    uint32_t record_size;
+    if (analysis_fseek(af->file, af->record_offset[key], SEEK_SET) ||
+        fread(&record_size, sizeof(record_size), 1, af->file) != 1 || record_size != size ||
+        fread(af->buffer, size, 1, af->file) != 1)
+        return FALSE;
+
+    uint64_t       hash, filter_hash;
+    uint8_t        info[8];
+    const uint8_t *p = af->buffer + sizeof(key);
+    p = analysis_get(p, &hash, sizeof(hash));
+    p = analysis_get(p, &filter_hash, sizeof(filter_hash));
+    p = analysis_get(p, info, sizeof(info));
+    if (hash != pcs_ptr->analysis_hash) {
+        SVT_WARN("analysis file: the source of picture %llu differs from the export, motion "
+                 "estimation is performed from there on\n",
+                 (unsigned long long)key);
+        af->halted = TRUE;
+        return FALSE;
+    }
+    // filtered at another QP, or a reference was
+    if (filter_hash != pcs_ptr->analysis_filter_hash)
+        return FALSE;
+    if (info[0] != (uint8_t)pcs_ptr->slice_type || info[1] != pcs_ptr->ref_list0_count_try ||
+        info[2] != pcs_ptr->ref_list1_count_try || info[3] != npus || info[4] != me->max_refs ||
+        info[5] != me->max_cand || (info[6] | (info[7] << 8)) != (int)sb_count)
+        return FALSE;
+
+    for (int list = 0; list < MAX_NUM_OF_REF_PIC_LIST; list++)
+        for (int ref = 0; ref < REF_LIST_MAX_DEPTH; ref++) {
+            uint8_t is_gm;
+            p = analysis_get(p, &is_gm, 1);
+            pcs_ptr->is_global_motion[list][ref] = (Bool)is_gm;
+            p = analysis_get(
+                p, &pcs_ptr->global_motion_estimation[list][ref], sizeof(EbWarpedMotionParams));
+        }
+    for (uint32_t sb = 0; sb < sb_count; sb++) {
+        MeSbResults *res = me->me_results[sb];
+        p = analysis_get(p, res->total_me_candidate_index, npus);
+        p = analysis_get(p, res->me_mv_array, npus * me->max_refs * sizeof(MvCandidate));
+        p = analysis_get(p, res->me_candidate_array, npus * me->max_cand * sizeof(MeCandidate));
+        p = analysis_get(p, &pcs_ptr->rc_me_distortion[sb], sizeof(uint32_t));
+        p = analysis_get(p, &pcs_ptr->me_8x8_cost_variance[sb], sizeof(uint32_t));
+        p = analysis_get(p, &pcs_ptr->me_64x64_distortion[sb], sizeof(uint32_t));
+        p = analysis_get(p, &pcs_ptr->me_32x32_distortion[sb], sizeof(uint32_t));
+        p = analysis_get(p, &pcs_ptr->me_16x16_distortion[sb], sizeof(uint32_t));
+        p = analysis_get(p, &pcs_ptr->me_8x8_distortion[sb], sizeof(uint32_t));
+        p = analysis_get(p, &pcs_ptr->stationary_block_present_sb[sb], 1);
+        p = analysis_get(p, &pcs_ptr->rc_me_allow_gm[sb], 1);
+    }
+    assert((size_t)(p - af->buffer) == size);
+    return TRUE;
+}
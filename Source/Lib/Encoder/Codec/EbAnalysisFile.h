@@ -0,0 +1,58 @@
+/*
+* Copyright (c) 2019, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbAnalysisFile_h
+#define EbAnalysisFile_h
+
+#include <stdio.h>
+
+#include "EbDefinitions.h"
+#include "EbPictureBufferDesc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct SequenceControlSet;
+struct PictureParentControlSet;
+
+/**************************************
+ * AnalysisFile
+ *   Motion analysis of the pictures of an encode, stored so that a later
+ *   encode of the same source at a different rate can skip motion estimation.
+ *   A file is either written (export) or read (import) by one encoder.
+ **************************************/
+typedef struct AnalysisFile {
+    FILE    *file;
+    Bool     write;
+    // import: file offset of the record of each picture, 0 when absent
+    int64_t *record_offset;
+    uint64_t record_count;
+    // set on a source mismatch (import) or a write error (export), nothing is
+    // transferred afterwards
+    Bool     halted;
+    uint8_t *buffer;
+    size_t   buffer_size;
+} AnalysisFile;
+
+EbErrorType analysis_file_open(AnalysisFile **af_ptr, struct SequenceControlSet *scs_ptr,
+                               const char *path, Bool write);
+void        analysis_file_close(AnalysisFile **af_ptr);
+uint64_t    analysis_hash_picture(const EbPictureBufferDesc *pic, uint32_t width, uint32_t height);
+void        analysis_mark_filtered(struct PictureParentControlSet *pcs_ptr);
+uint64_t    analysis_dependency_hash(struct PictureParentControlSet *pcs_ptr);
+void        analysis_write_picture(AnalysisFile *af, struct PictureParentControlSet *pcs_ptr);
+Bool        analysis_read_picture(AnalysisFile *af, struct PictureParentControlSet *pcs_ptr);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbAnalysisFile_h
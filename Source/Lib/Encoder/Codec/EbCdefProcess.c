@@ -36,10 +36,11 @@ int32_t svt_sb_all_skip(PictureControlSet *pcs_ptr, const Av1Common *const cm, i
 int32_t svt_sb_compute_cdef_list(PictureControlSet *pcs_ptr, const Av1Common *const cm,
                                  int32_t mi_row, int32_t mi_col, CdefList *dlist, BlockSize bs);
 void    finish_cdef_search(PictureControlSet *pcs_ptr);
-void    av1_cdef_frame16bit(EncDecContext *context_ptr, SequenceControlSet *scs_ptr,
-                            PictureControlSet *pCs);
-void    svt_av1_cdef_frame(EncDecContext *context_ptr, SequenceControlSet *scs_ptr,
-                           PictureControlSet *pCs);
+void    svt_av1_cdef_save_boundary_lines(SequenceControlSet *scs_ptr, PictureControlSet *pCs,
+                                         Bool is_16bit);
+void    svt_av1_cdef_free_boundary_lines(SequenceControlSet *scs_ptr, PictureControlSet *pCs);
+void    av1_cdef_fb_row16bit(SequenceControlSet *scs_ptr, PictureControlSet *pCs, int32_t fbr);
+void    svt_av1_cdef_fb_row(SequenceControlSet *scs_ptr, PictureControlSet *pCs, int32_t fbr);
 void    svt_av1_loop_restoration_save_boundary_lines(const Yv12BufferConfig *frame, Av1Common *cm,
                                                      int32_t after_cdef);
 void    svt_av1_superres_upscale_frame(struct Av1Common *cm, PictureControlSet *pcs_ptr,
@@ -54,11 +55,29 @@ void get_recon_pic(PictureControlSet *pcs_ptr, EbPictureBufferDesc **recon_ptr,
 typedef struct CdefContext {
     EbFifo *cdef_input_fifo_ptr;
     EbFifo *cdef_output_fifo_ptr;
+    EbFifo *cdef_feedback_fifo_ptr; // CDEF segment helper tasks to the CDEF threads
+    volatile int32_t *cdef_seg_task_count;
+    // Strength search of a filter block plane, see cdef_search_prepare_fb()
+    int16_t *search_sums; // the sums of the 8x8 blocks, CDEF_SEARCH_BLOCK_SUMS values each
+    int8_t   pri_slot[CDEF_PRI_STRENGTHS]; // slot of the sums of a primary strength, -1 if none
+    int8_t   sec_slot[CDEF_SEC_STRENGTHS + 2]; // slot of the sums of a secondary strength
 } CdefContext;
 
+/* The sums of an 8x8 block for the strength search: the range of the pixels of the block
+ * filtered in its direction, then the one of the block filtered in the direction 0 (the
+ * direction of the pairs with no primary strength), the sums of the primary strengths and the
+ * sums of the secondary strengths in both directions. */
+#define CDEF_SEARCH_RANGE 0
+#define CDEF_SEARCH_RANGE_DIR0 (3 * 64)
+#define CDEF_SEARCH_PRI (6 * 64)
+#define CDEF_SEARCH_SEC (CDEF_SEARCH_PRI + CDEF_PRI_STRENGTHS * 64)
+#define CDEF_SEARCH_SEC_DIR0 (CDEF_SEARCH_SEC + 3 * 64)
+#define CDEF_SEARCH_BLOCK_SUMS (CDEF_SEARCH_SEC_DIR0 + 3 * 64)
+
 static void cdef_context_dctor(EbPtr p) {
     EbThreadContext *thread_context_ptr = (EbThreadContext *)p;
     CdefContext     *obj                = (CdefContext *)thread_context_ptr->priv;
+    EB_FREE_ALIGNED_ARRAY(obj->search_sums);
     EB_FREE_ARRAY(obj);
 }
 
@@ -77,18 +96,221 @@ EbErrorType cdef_context_ctor(EbThreadContext   *thread_context_ptr,
         enc_handle_ptr->dlf_results_resource_ptr, index);
     context_ptr->cdef_output_fifo_ptr = svt_system_resource_get_producer_fifo(
         enc_handle_ptr->cdef_results_resource_ptr, index);
+    context_ptr->cdef_feedback_fifo_ptr = svt_system_resource_get_producer_fifo(
+        enc_handle_ptr->dlf_results_resource_ptr,
+        enc_handle_ptr->scs_instance_array[0]->scs_ptr->dlf_process_init_count + index);
+    context_ptr->cdef_seg_task_count =
+        &enc_handle_ptr->scs_instance_array[0]->encode_context_ptr->cdef_seg_task_count;
+    // a filter block of a 128x128 SB holds 16x16 blocks of 8x8
+    const int32_t max_blocks =
+        enc_handle_ptr->scs_instance_array[0]->scs_ptr->super_block_size == 128 ? 256 : 64;
+    EB_MALLOC_ALIGNED_ARRAY(context_ptr->search_sums, max_blocks * CDEF_SEARCH_BLOCK_SUMS);
 
     return EB_ErrorNone;
 }
 
+/* Computes the sums of all the strengths searched for the blocks of a filter block plane, from
+ * which cdef_search_filter_fb() filters the blocks with any strength pair. The filter of the
+ * pair (p, s) adds the sums of the primary strength p and of the secondary strength s, so each
+ * strength is applied once to a block whatever the number of pairs using it. The directions
+ * and variances of the luma blocks are computed and kept in dir and var for the chroma planes
+ * and for the filtering of the picture. */
+static void cdef_search_prepare_fb(CdefContext *context_ptr, CdefControls *cdef_ctrls,
+                                   const uint16_t *in, int32_t pli, int32_t bsize,
+                                   uint8_t dir[CDEF_NBLOCKS][CDEF_NBLOCKS],
+                                   int32_t var[CDEF_NBLOCKS][CDEF_NBLOCKS], const CdefList *dlist,
+                                   int32_t cdef_count, int32_t pri_damping, int32_t sec_damping,
+                                   int32_t coeff_shift, uint8_t subsampling_factor) {
+    const int32_t bsizex = 3 - (pli != 0);
+    const int32_t bsizey = 3 - (pli != 0);
+    int32_t       pri_levels[CDEF_PRI_STRENGTHS], sec_strengths[3];
+    int32_t       num_pri = 0, num_sec = 0;
+    Bool          dir0_sec = FALSE;
+    memset(context_ptr->pri_slot, -1, sizeof(context_ptr->pri_slot));
+    memset(context_ptr->sec_slot, -1, sizeof(context_ptr->sec_slot));
+    for (int32_t gi = 0; gi < cdef_ctrls->first_pass_fs_num + cdef_ctrls->default_second_pass_fs_num;
+         gi++) {
+        const int32_t fs = gi < cdef_ctrls->first_pass_fs_num
+            ? cdef_ctrls->default_first_pass_fs[gi]
+            : cdef_ctrls->default_second_pass_fs[gi - cdef_ctrls->first_pass_fs_num];
+        const int32_t pri = fs / CDEF_SEC_STRENGTHS;
+        const int32_t sec = fs % CDEF_SEC_STRENGTHS + (fs % CDEF_SEC_STRENGTHS == 3);
+        if (pri && context_ptr->pri_slot[pri] < 0) {
+            context_ptr->pri_slot[pri] = (int8_t)num_pri;
+            pri_levels[num_pri++]      = pri;
+        }
+        if (sec && context_ptr->sec_slot[sec] < 0) {
+            context_ptr->sec_slot[sec] = (int8_t)num_sec;
+            sec_strengths[num_sec++]   = sec << coeff_shift;
+        }
+        dir0_sec |= !pri && sec;
+    }
+    pri_damping += coeff_shift - (pli != AOM_PLANE_Y);
+    sec_damping += coeff_shift - (pli != AOM_PLANE_Y);
+
+    for (int32_t bi = 0; bi < cdef_count; bi++) {
+        const int32_t   by   = dlist[bi].by;
+        const int32_t   bx   = dlist[bi].bx;
+        const uint16_t *blk  = &in[(by * CDEF_BSTRIDE << bsizey) + (bx << bsizex)];
+        int16_t        *sums = context_ptr->search_sums + bi * CDEF_SEARCH_BLOCK_SUMS;
+        int32_t         pri_strengths[CDEF_PRI_STRENGTHS];
+        if (pli == 0)
+            dir[by][bx] = svt_cdef_find_dir(
+                &in[8 * by * CDEF_BSTRIDE + 8 * bx], CDEF_BSTRIDE, &var[by][bx], coeff_shift);
+        if (dlist[bi].skip) {
+            // only the range, the block being left as is
+            svt_cdef_search_block_sums(blk,
+                                       0,
+                                       bsize,
+                                       subsampling_factor,
+                                       NULL,
+                                       0,
+                                       pri_damping,
+                                       NULL,
+                                       0,
+                                       sec_damping,
+                                       coeff_shift,
+                                       sums + CDEF_SEARCH_RANGE,
+                                       NULL,
+                                       NULL);
+            continue;
+        }
+        for (int32_t s = 0; s < num_pri; s++)
+            pri_strengths[s] = pli ? pri_levels[s] << coeff_shift
+                                   : svt_cdef_adjust_strength(pri_levels[s] << coeff_shift,
+                                                              var[by][bx]);
+        svt_cdef_search_block_sums(blk,
+                                   dir[by][bx],
+                                   bsize,
+                                   subsampling_factor,
+                                   pri_strengths,
+                                   num_pri,
+                                   pri_damping,
+                                   sec_strengths,
+                                   num_sec,
+                                   sec_damping,
+                                   coeff_shift,
+                                   sums + CDEF_SEARCH_RANGE,
+                                   sums + CDEF_SEARCH_PRI,
+                                   sums + CDEF_SEARCH_SEC);
+        if (dir0_sec && dir[by][bx])
+            svt_cdef_search_block_sums(blk,
+                                       0,
+                                       bsize,
+                                       subsampling_factor,
+                                       NULL,
+                                       0,
+                                       pri_damping,
+                                       sec_strengths,
+                                       num_sec,
+                                       sec_damping,
+                                       coeff_shift,
+                                       sums + CDEF_SEARCH_RANGE_DIR0,
+                                       NULL,
+                                       sums + CDEF_SEARCH_SEC_DIR0);
+    }
+}
+
+/* Filters the blocks of the filter block plane prepared by cdef_search_prepare_fb() with a
+ * strength pair, as svt_cdef_filter_fb() does to a packed destination. */
+static void cdef_search_filter_fb(CdefContext *context_ptr, uint8_t *dst8, uint16_t *dst16,
+                                  int32_t pli, int32_t bsize,
+                                  uint8_t dir[CDEF_NBLOCKS][CDEF_NBLOCKS], const CdefList *dlist,
+                                  int32_t cdef_count, int32_t pri_strength, int32_t sec_strength,
+                                  uint8_t subsampling_factor) {
+    const int32_t blk_shift = 2 * (3 - (pli != 0));
+    for (int32_t bi = 0; bi < cdef_count; bi++) {
+        const int16_t *sums   = context_ptr->search_sums + bi * CDEF_SEARCH_BLOCK_SUMS;
+        const int32_t  offset = bi << blk_shift;
+        const int16_t *pri_sum = NULL, *sec_sum = NULL;
+        const int16_t *range   = sums + CDEF_SEARCH_RANGE;
+        if (!dlist[bi].skip) {
+            // the pairs with no primary strength filter in the direction 0
+            const Bool dir0 = !pri_strength && dir[dlist[bi].by][dlist[bi].bx];
+            if (pri_strength)
+                pri_sum = sums + CDEF_SEARCH_PRI + context_ptr->pri_slot[pri_strength] * 64;
+            if (sec_strength)
+                sec_sum = sums + (dir0 ? CDEF_SEARCH_SEC_DIR0 : CDEF_SEARCH_SEC) +
+                    context_ptr->sec_slot[sec_strength] * 64;
+            if (dir0 && sec_strength)
+                range = sums + CDEF_SEARCH_RANGE_DIR0;
+        }
+        svt_cdef_search_block_combine(range,
+                                      pri_sum,
+                                      sec_sum,
+                                      bsize,
+                                      subsampling_factor,
+                                      dst8 ? dst8 + offset : NULL,
+                                      dst16 ? dst16 + offset : NULL);
+    }
+}
+
+/* The index of the first pass pair of a strength pair, -1 if none */
+static int32_t cdef_first_pass_gi(const CdefControls *cdef_ctrls, int32_t fs) {
+    for (int32_t gi = 0; gi < cdef_ctrls->first_pass_fs_num; gi++)
+        if (cdef_ctrls->default_first_pass_fs[gi] == fs)
+            return gi;
+    return -1;
+}
+
+/* Whether the pair gi of the luma second pass is left to cdef_search_model_pairs(), the first
+ * pass mse of its primary strength alone not being among the second_pass_prim_num best ones */
+static Bool cdef_search_pair_pruned(const CdefControls *cdef_ctrls, const uint64_t *mse,
+                                    int32_t gi) {
+    if (!cdef_ctrls->second_pass_prim_num)
+        return FALSE;
+    const int32_t fs  = cdef_ctrls->default_second_pass_fs[gi - cdef_ctrls->first_pass_fs_num];
+    const int32_t pgi = cdef_first_pass_gi(cdef_ctrls, fs - fs % CDEF_SEC_STRENGTHS);
+    if (pgi < 0)
+        return FALSE;
+    int32_t rank = 0;
+    for (int32_t i = 0; i < cdef_ctrls->first_pass_fs_num; i++)
+        if (!(cdef_ctrls->default_first_pass_fs[i] % CDEF_SEC_STRENGTHS) &&
+            (mse[i] < mse[pgi] || (mse[i] == mse[pgi] && i < pgi)))
+            rank++;
+    return rank >= cdef_ctrls->second_pass_prim_num;
+}
+
+/* Models the mse of the pairs pruned by cdef_search_pair_pruned(): a secondary strength is taken
+ * to change the mse of a primary strength as much as it changes the one of the best primary
+ * strength, whose pairs are all filtered. */
+static void cdef_search_model_pairs(const CdefControls *cdef_ctrls, uint64_t *mse) {
+    const int32_t first_pass_fs_num = cdef_ctrls->first_pass_fs_num;
+    int32_t       best              = -1;
+    if (!cdef_ctrls->second_pass_prim_num)
+        return;
+    for (int32_t i = 0; i < first_pass_fs_num; i++)
+        if (!(cdef_ctrls->default_first_pass_fs[i] % CDEF_SEC_STRENGTHS) &&
+            (best < 0 || mse[i] < mse[best]))
+            best = i;
+    for (int32_t gi = first_pass_fs_num;
+         gi < first_pass_fs_num + cdef_ctrls->default_second_pass_fs_num;
+         gi++) {
+        if (!cdef_search_pair_pruned(cdef_ctrls, mse, gi))
+            continue;
+        const int32_t fs  = cdef_ctrls->default_second_pass_fs[gi - first_pass_fs_num];
+        const int32_t sec = fs % CDEF_SEC_STRENGTHS;
+        const int32_t pgi = cdef_first_pass_gi(cdef_ctrls, fs - sec);
+        int32_t       bgi = -1;
+        for (int32_t i = first_pass_fs_num;
+             i < first_pass_fs_num + cdef_ctrls->default_second_pass_fs_num;
+             i++)
+            if (cdef_ctrls->default_second_pass_fs[i - first_pass_fs_num] ==
+                cdef_ctrls->default_first_pass_fs[best] + sec)
+                bgi = i;
+        const int64_t delta = bgi < 0 ? 0 : (int64_t)mse[bgi] - (int64_t)mse[best];
+        mse[gi]             = (uint64_t)AOMMAX((int64_t)mse[pgi] + delta, 0);
+    }
+}
+
 #define default_mse_uv 1040400
 /* Search for the best filter strength pair for each 64x64 filter block.
  *
  * For each 64x64 filter block and each plane, search the allowable filter strength pairs.
  * Call cdef_filter_fb() to perform filtering, then compute the MSE for each pair.
 */
-void cdef_seg_search(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr,
-                     uint32_t segment_index) {
+static void cdef_seg_search(CdefContext *context_ptr, PictureControlSet *pcs_ptr,
+                            SequenceControlSet *scs_ptr, uint32_t segment_index) {
     struct PictureParentControlSet *ppcs    = pcs_ptr->parent_pcs_ptr;
     FrameHeader                    *frm_hdr = &ppcs->frm_hdr;
     Av1Common                      *cm      = pcs_ptr->parent_pcs_ptr->av1_cm;
@@ -174,7 +396,6 @@ void cdef_seg_search(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr,
     // This is the SB loop
     for (fbr = y_b64_start_idx; fbr < y_b64_end_idx; ++fbr) {
         for (fbc = x_b64_start_idx; fbc < x_b64_end_idx; ++fbc) {
-            int32_t        dirinit    = 0;
             const uint32_t lc         = MI_SIZE_64X64 * fbc;
             const uint32_t lr         = MI_SIZE_64X64 * fbr;
             nhb                       = AOMMIN(MI_SIZE_64X64, mi_cols - lc);
@@ -246,6 +467,19 @@ void cdef_seg_search(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr,
                     subsampling_factor = MIN(subsampling_factor, 2);
                 else if (bsize[pli] == BLOCK_4X4)
                     subsampling_factor = MIN(subsampling_factor, 1);
+                cdef_search_prepare_fb(context_ptr,
+                                       cdef_ctrls,
+                                       in,
+                                       pli,
+                                       bsize[pli],
+                                       *dir,
+                                       *var,
+                                       dlist,
+                                       cdef_count,
+                                       pri_damping,
+                                       sec_damping,
+                                       coeff_shift,
+                                       subsampling_factor);
                 /* first cdef stage
                  * Perform the pri_filter strength search for the current sub_block
                  */
@@ -254,24 +488,17 @@ void cdef_seg_search(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr,
                         pri_strength = cdef_ctrls->default_first_pass_fs[gi] / CDEF_SEC_STRENGTHS;
                         sec_strength = cdef_ctrls->default_first_pass_fs[gi] % CDEF_SEC_STRENGTHS;
 
-                        svt_cdef_filter_fb(tmp_dst,
-                                           NULL,
-                                           0,
-                                           in,
-                                           xdec[pli],
-                                           ydec[pli],
-                                           *dir,
-                                           &dirinit,
-                                           *var,
-                                           pli,
-                                           dlist,
-                                           cdef_count,
-                                           pri_strength,
-                                           sec_strength + (sec_strength == 3),
-                                           pri_damping,
-                                           sec_damping,
-                                           coeff_shift,
-                                           subsampling_factor);
+                        cdef_search_filter_fb(context_ptr,
+                                              tmp_dst,
+                                              NULL,
+                                              pli,
+                                              bsize[pli],
+                                              *dir,
+                                              dlist,
+                                              cdef_count,
+                                              pri_strength,
+                                              sec_strength + (sec_strength == 3),
+                                              subsampling_factor);
                         curr_mse = svt_compute_cdef_dist_8bit(
                             ref_coeff[pli] + (lr << mi_high_l2[pli]) * stride_ref[pli] +
                                 (lc << mi_wide_l2[pli]),
@@ -300,29 +527,26 @@ void cdef_seg_search(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr,
                      gi++) {
                     if (!pli ||
                         (cdef_ctrls->default_second_pass_fs_uv[gi - first_pass_fs_num] != -1)) {
+                        if (!pli &&
+                            cdef_search_pair_pruned(
+                                cdef_ctrls, pcs_ptr->mse_seg[0][fb_idx], gi))
+                            continue;
                         pri_strength = cdef_ctrls->default_second_pass_fs[gi - first_pass_fs_num] /
                             CDEF_SEC_STRENGTHS;
                         sec_strength = cdef_ctrls->default_second_pass_fs[gi - first_pass_fs_num] %
                             CDEF_SEC_STRENGTHS;
 
-                        svt_cdef_filter_fb(tmp_dst,
-                                           NULL,
-                                           0,
-                                           in,
-                                           xdec[pli],
-                                           ydec[pli],
-                                           *dir,
-                                           &dirinit,
-                                           *var,
-                                           pli,
-                                           dlist,
-                                           cdef_count,
-                                           pri_strength,
-                                           sec_strength + (sec_strength == 3),
-                                           pri_damping,
-                                           sec_damping,
-                                           coeff_shift,
-                                           subsampling_factor);
+                        cdef_search_filter_fb(context_ptr,
+                                              tmp_dst,
+                                              NULL,
+                                              pli,
+                                              bsize[pli],
+                                              *dir,
+                                              dlist,
+                                              cdef_count,
+                                              pri_strength,
+                                              sec_strength + (sec_strength == 3),
+                                              subsampling_factor);
                         curr_mse = svt_compute_cdef_dist_8bit(
                             ref_coeff[pli] + (lr << mi_high_l2[pli]) * stride_ref[pli] +
                                 (lc << mi_wide_l2[pli]),
@@ -343,6 +567,8 @@ void cdef_seg_search(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr,
                     } else
                         pcs_ptr->mse_seg[1][fb_idx][gi] = default_mse_uv * 64;
                 }
+                if (!pli)
+                    cdef_search_model_pairs(cdef_ctrls, pcs_ptr->mse_seg[0][fb_idx]);
             }
         }
     }
@@ -352,8 +578,8 @@ void cdef_seg_search(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr,
  * For each 64x64 filter block and each plane, search the allowable filter strength pairs.
  * Call cdef_filter_fb() to perform filtering, then compute the MSE for each pair.
 */
-void cdef_seg_search16bit(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr,
-                          uint32_t segment_index) {
+static void cdef_seg_search16bit(CdefContext *context_ptr, PictureControlSet *pcs_ptr,
+                                 SequenceControlSet *scs_ptr, uint32_t segment_index) {
     EbPictureBufferDesc *input_pic_ptr = pcs_ptr->input_frame16bit;
 
     EbPictureBufferDesc *recon_pic_ptr;
@@ -436,7 +662,6 @@ void cdef_seg_search16bit(PictureControlSet *pcs_ptr, SequenceControlSet *scs_pt
             const uint32_t lc = MI_SIZE_64X64 * fbc;
             const uint32_t lr = MI_SIZE_64X64 * fbr;
             int32_t        nvb, nhb;
-            int32_t        dirinit    = 0;
             nhb                       = AOMMIN(MI_SIZE_64X64, mi_cols - lc);
             nvb                       = AOMMIN(MI_SIZE_64X64, mi_rows - lr);
             int32_t           hb_step = 1; //these should be all time with 64x64 SBs
@@ -511,6 +736,19 @@ void cdef_seg_search16bit(PictureControlSet *pcs_ptr, SequenceControlSet *scs_pt
                     subsampling_factor = MIN(subsampling_factor, 2);
                 else if (bsize[pli] == BLOCK_4X4)
                     subsampling_factor = MIN(subsampling_factor, 1);
+                cdef_search_prepare_fb(context_ptr,
+                                       cdef_ctrls,
+                                       in,
+                                       pli,
+                                       bsize[pli],
+                                       *dir,
+                                       *var,
+                                       dlist,
+                                       cdef_count,
+                                       pri_damping,
+                                       sec_damping,
+                                       coeff_shift,
+                                       subsampling_factor);
                 /* first cdef stage
                  * Perform the pri_filter strength search for the current sub_block
                  */
@@ -519,24 +757,17 @@ void cdef_seg_search16bit(PictureControlSet *pcs_ptr, SequenceControlSet *scs_pt
                         pri_strength = cdef_ctrls->default_first_pass_fs[gi] / CDEF_SEC_STRENGTHS;
                         sec_strength = cdef_ctrls->default_first_pass_fs[gi] % CDEF_SEC_STRENGTHS;
 
-                        svt_cdef_filter_fb(NULL,
-                                           tmp_dst,
-                                           0,
-                                           in,
-                                           xdec[pli],
-                                           ydec[pli],
-                                           *dir,
-                                           &dirinit,
-                                           *var,
-                                           pli,
-                                           dlist,
-                                           cdef_count,
-                                           pri_strength,
-                                           sec_strength + (sec_strength == 3),
-                                           pri_damping,
-                                           sec_damping,
-                                           coeff_shift,
-                                           subsampling_factor);
+                        cdef_search_filter_fb(context_ptr,
+                                              NULL,
+                                              tmp_dst,
+                                              pli,
+                                              bsize[pli],
+                                              *dir,
+                                              dlist,
+                                              cdef_count,
+                                              pri_strength,
+                                              sec_strength + (sec_strength == 3),
+                                              subsampling_factor);
                         curr_mse = svt_compute_cdef_dist_16bit(
                             ref_coeff[pli] + (lr << mi_high_l2[pli]) * stride_ref[pli] +
                                 (lc << mi_wide_l2[pli]),
@@ -565,29 +796,26 @@ void cdef_seg_search16bit(PictureControlSet *pcs_ptr, SequenceControlSet *scs_pt
                      gi++) {
                     if (!pli ||
                         (cdef_ctrls->default_second_pass_fs_uv[gi - first_pass_fs_num] != 1)) {
+                        if (!pli &&
+                            cdef_search_pair_pruned(
+                                cdef_ctrls, pcs_ptr->mse_seg[0][fb_idx], gi))
+                            continue;
                         pri_strength = cdef_ctrls->default_second_pass_fs[gi - first_pass_fs_num] /
                             CDEF_SEC_STRENGTHS;
                         sec_strength = cdef_ctrls->default_second_pass_fs[gi - first_pass_fs_num] %
                             CDEF_SEC_STRENGTHS;
 
-                        svt_cdef_filter_fb(NULL,
-                                           tmp_dst,
-                                           0,
-                                           in,
-                                           xdec[pli],
-                                           ydec[pli],
-                                           *dir,
-                                           &dirinit,
-                                           *var,
-                                           pli,
-                                           dlist,
-                                           cdef_count,
-                                           pri_strength,
-                                           sec_strength + (sec_strength == 3),
-                                           pri_damping,
-                                           sec_damping,
-                                           coeff_shift,
-                                           subsampling_factor);
+                        cdef_search_filter_fb(context_ptr,
+                                              NULL,
+                                              tmp_dst,
+                                              pli,
+                                              bsize[pli],
+                                              *dir,
+                                              dlist,
+                                              cdef_count,
+                                              pri_strength,
+                                              sec_strength + (sec_strength == 3),
+                                              subsampling_factor);
                         curr_mse = svt_compute_cdef_dist_16bit(
                             ref_coeff[pli] + (lr << mi_high_l2[pli]) * stride_ref[pli] +
                                 (lc << mi_wide_l2[pli]),
@@ -607,11 +835,146 @@ void cdef_seg_search16bit(PictureControlSet *pcs_ptr, SequenceControlSet *scs_pt
                     } else
                         pcs_ptr->mse_seg[1][fb_idx][gi] = default_mse_uv * 64;
                 }
+                if (!pli)
+                    cdef_search_model_pairs(cdef_ctrls, pcs_ptr->mse_seg[0][fb_idx]);
             }
         }
     }
 }
 
+/* Sends the LR search segments [first, end) of the picture to the Rest process */
+static void post_rest_segments(CdefContext *context_ptr, PictureControlSet *pcs_ptr,
+                               uint32_t first, uint32_t end) {
+    for (uint32_t segment_index = first; segment_index < end; ++segment_index) {
+        EbObjectWrapper *cdef_results_wrapper_ptr;
+        svt_get_empty_object(context_ptr->cdef_output_fifo_ptr, &cdef_results_wrapper_ptr);
+        CdefResults *cdef_results_ptr = (CdefResults *)cdef_results_wrapper_ptr->object_ptr;
+        cdef_results_ptr->pcs_wrapper_ptr        = pcs_ptr->c_pcs_wrapper_ptr;
+        cdef_results_ptr->segment_index          = segment_index;
+        cdef_results_ptr->rest_segments          = FALSE;
+        cdef_results_ptr->subpel_ref_wrapper_ptr = NULL;
+        svt_post_full_object(cdef_results_wrapper_ptr);
+    }
+}
+
+/* Whether the rows the LR search reads for the segment row y_seg_idx, its restoration units
+ * and the border the filters read below them, are in the leading luma_rows filtered rows */
+static Bool rest_seg_row_ready(PictureControlSet *pcs_ptr, uint32_t y_seg_idx, int32_t luma_rows) {
+    Av1Common *cm = pcs_ptr->parent_pcs_ptr->av1_cm;
+    for (int32_t plane = 0; plane < MAX_MB_PLANE; plane++) {
+        const RestorationInfo *rsi  = &pcs_ptr->rst_info[plane];
+        const int32_t          ss_y = plane ? cm->subsampling_y : 0;
+        const int32_t          y_unit_end = SEGMENT_END_IDX(
+            y_seg_idx, rsi->vert_units_per_tile, pcs_ptr->rest_segments_row_count);
+        // the last units of the plane extend to its bottom
+        if (y_unit_end == rsi->vert_units_per_tile)
+            return FALSE;
+        if (((y_unit_end * rsi->restoration_unit_size + RESTORATION_BORDER) << ss_y) > luma_rows)
+            return FALSE;
+    }
+    return TRUE;
+}
+
+/* Wavefront LR search: once the leading filter block rows are filtered, extends them for the
+ * LR search as restoration_seg_search() would extend the whole planes, and sends the LR search
+ * segment rows reading no later row */
+static void cdef_fb_row_filtered(CdefContext *context_ptr, PictureControlSet *pcs_ptr,
+                                 uint32_t fbr) {
+    Av1Common        *cm      = pcs_ptr->parent_pcs_ptr->av1_cm;
+    Yv12BufferConfig *frame   = cm->frame_to_show;
+    const uint16_t    fb_rows = (uint16_t)((cm->mi_rows + MI_SIZE_64X64 - 1) / MI_SIZE_64X64);
+
+    svt_block_on_mutex(pcs_ptr->cdef_fb_row_mutex);
+    pcs_ptr->cdef_fb_row_done[fbr] = TRUE;
+    const uint16_t first = pcs_ptr->cdef_fb_rows_done;
+    while (pcs_ptr->cdef_fb_rows_done < fb_rows &&
+           pcs_ptr->cdef_fb_row_done[pcs_ptr->cdef_fb_rows_done])
+        pcs_ptr->cdef_fb_rows_done++;
+    const uint16_t end      = pcs_ptr->cdef_fb_rows_done;
+    const Bool     all_done = end == fb_rows;
+    if (end > first) {
+        for (int32_t plane = 0; plane < MAX_MB_PLANE; plane++) {
+            const int32_t is_uv  = plane > 0;
+            const int32_t ss_y   = is_uv ? cm->subsampling_y : 0;
+            const int32_t height = frame->crop_heights[is_uv];
+            const int32_t row_end = all_done
+                ? height
+                : AOMMIN((end * CDEF_BLOCKSIZE) >> ss_y, height);
+            svt_extend_frame_rows(frame->buffers[plane],
+                                  frame->crop_widths[is_uv],
+                                  height,
+                                  frame->strides[is_uv],
+                                  RESTORATION_BORDER,
+                                  RESTORATION_BORDER,
+                                  AOMMIN((first * CDEF_BLOCKSIZE) >> ss_y, row_end),
+                                  row_end,
+                                  cm->use_highbitdepth);
+        }
+        // the LR application reads these lines once the search is done
+        if (all_done)
+            svt_av1_loop_restoration_save_boundary_lines(frame, cm, 1);
+        while (pcs_ptr->rest_seg_rows_posted < pcs_ptr->rest_segments_row_count &&
+               (all_done ||
+                rest_seg_row_ready(
+                    pcs_ptr, pcs_ptr->rest_seg_rows_posted, end * CDEF_BLOCKSIZE))) {
+            const uint32_t y_seg_idx = pcs_ptr->rest_seg_rows_posted++;
+            post_rest_segments(context_ptr,
+                               pcs_ptr,
+                               y_seg_idx * pcs_ptr->rest_segments_column_count,
+                               (y_seg_idx + 1) * pcs_ptr->rest_segments_column_count);
+        }
+    }
+    svt_release_mutex(pcs_ptr->cdef_fb_row_mutex);
+}
+
+/* Applies the CDEF to a 64x64 filter block row */
+static uint64_t cdef_filter_segment(PictureControlSet *pcs_ptr, void *thread_ctx,
+                                    const SegmentPassStep *step, uint32_t segment_index) {
+    SequenceControlSet *scs_ptr = pcs_ptr->scs_ptr;
+    (void)step;
+    if (scs_ptr->is_16bit_pipeline)
+        av1_cdef_fb_row16bit(scs_ptr, pcs_ptr, (int32_t)segment_index);
+    else
+        svt_av1_cdef_fb_row(scs_ptr, pcs_ptr, (int32_t)segment_index);
+    if (pcs_ptr->rest_search_wavefront)
+        cdef_fb_row_filtered((CdefContext *)thread_ctx, pcs_ptr, segment_index);
+    return 0;
+}
+
+static void cdef_post_segment_task(EbFifo *fifo_ptr, PictureControlSet *pcs_ptr) {
+    EbObjectWrapper *wrapper_ptr;
+    svt_get_empty_object(fifo_ptr, &wrapper_ptr);
+    DlfResults *task_ptr      = (DlfResults *)wrapper_ptr->object_ptr;
+    task_ptr->pcs_wrapper_ptr = pcs_ptr->c_pcs_wrapper_ptr;
+    task_ptr->segment_index   = 0;
+    task_ptr->cdef_segments   = TRUE;
+    svt_post_full_object(wrapper_ptr);
+}
+
+/* Applies the CDEF to the picture over the filter block rows */
+static void cdef_run_segments(CdefContext *context_ptr, PictureControlSet *pcs_ptr) {
+    SequenceControlSet *scs_ptr       = pcs_ptr->scs_ptr;
+    Av1Common          *cm            = pcs_ptr->parent_pcs_ptr->av1_cm;
+    const uint16_t      segment_count = (uint16_t)((cm->mi_rows + MI_SIZE_64X64 - 1) /
+                                                  MI_SIZE_64X64);
+    const SegmentPassStep    step    = {cdef_filter_segment, 0, {0, 0}};
+    const SegmentPassHelpers helpers = {context_ptr->cdef_feedback_fifo_ptr,
+                                        cdef_post_segment_task,
+                                        context_ptr->cdef_seg_task_count,
+                                        (int32_t)scs_ptr->cdef_process_init_count - 1};
+
+    if (pcs_ptr->rest_search_wavefront) {
+        memset(pcs_ptr->cdef_fb_row_done, 0, segment_count * sizeof(*pcs_ptr->cdef_fb_row_done));
+        pcs_ptr->cdef_fb_rows_done    = 0;
+        pcs_ptr->rest_seg_rows_posted = 0;
+    }
+    // The rows read across the segment edges must be read before they are filtered
+    svt_av1_cdef_save_boundary_lines(scs_ptr, pcs_ptr, scs_ptr->is_16bit_pipeline);
+    svt_segment_pass_run(
+        &pcs_ptr->cdef_seg, pcs_ptr, &step, segment_count, context_ptr, &helpers);
+    svt_av1_cdef_free_boundary_lines(scs_ptr, pcs_ptr);
+}
+
 /******************************************************
  * CDEF Kernel
  ******************************************************/
@@ -626,10 +989,6 @@ void *cdef_kernel(void *input_ptr) {
     EbObjectWrapper *dlf_results_wrapper_ptr;
     DlfResults      *dlf_results_ptr;
 
-    //// Output
-    EbObjectWrapper *cdef_results_wrapper_ptr;
-    CdefResults     *cdef_results_ptr;
-
     // SB Loop variables
 
     for (;;) {
@@ -642,24 +1001,38 @@ void *cdef_kernel(void *input_ptr) {
         pcs_ptr         = (PictureControlSet *)dlf_results_ptr->pcs_wrapper_ptr->object_ptr;
         scs_ptr         = pcs_ptr->scs_ptr;
 
+        if (dlf_results_ptr->cdef_segments) {
+            svt_segment_pass_help(
+                &pcs_ptr->cdef_seg, pcs_ptr, context_ptr, context_ptr->cdef_seg_task_count);
+            svt_release_object(dlf_results_wrapper_ptr);
+            continue;
+        }
+
         Bool       is_16bit      = scs_ptr->is_16bit_pipeline;
         Av1Common *cm            = pcs_ptr->parent_pcs_ptr->av1_cm;
         frm_hdr                  = &pcs_ptr->parent_pcs_ptr->frm_hdr;
         CdefControls *cdef_ctrls = &pcs_ptr->parent_pcs_ptr->cdef_ctrls;
-        if (!cdef_ctrls->use_reference_cdef_fs) {
+        // In wavefront mode the DLF process sends one extra, empty segment once the whole
+        // picture is deblocked and prepared for the CDEF application
+        const uint32_t total_segments = pcs_ptr->cdef_segments_total_count +
+            (pcs_ptr->cdef_search_wavefront ? 1 : 0);
+        if (!cdef_ctrls->use_reference_cdef_fs &&
+            dlf_results_ptr->segment_index < pcs_ptr->cdef_segments_total_count) {
             if (scs_ptr->seq_header.cdef_level && pcs_ptr->parent_pcs_ptr->cdef_level) {
                 if (is_16bit)
-                    cdef_seg_search16bit(pcs_ptr, scs_ptr, dlf_results_ptr->segment_index);
+                    cdef_seg_search16bit(
+                        context_ptr, pcs_ptr, scs_ptr, dlf_results_ptr->segment_index);
                 else
-                    cdef_seg_search(pcs_ptr, scs_ptr, dlf_results_ptr->segment_index);
+                    cdef_seg_search(context_ptr, pcs_ptr, scs_ptr, dlf_results_ptr->segment_index);
             }
         }
         //all seg based search is done. update total processed segments. if all done, finish the search and perfrom application.
         svt_block_on_mutex(pcs_ptr->cdef_search_mutex);
 
         pcs_ptr->tot_seg_searched_cdef++;
-        if (pcs_ptr->tot_seg_searched_cdef == pcs_ptr->cdef_segments_total_count) {
+        if (pcs_ptr->tot_seg_searched_cdef == total_segments) {
             // SVT_LOG("    CDEF all seg here  %i\n", pcs_ptr->picture_number);
+            Bool apply_cdef = FALSE;
             if (scs_ptr->seq_header.cdef_level && pcs_ptr->parent_pcs_ptr->cdef_level) {
                 finish_cdef_search(pcs_ptr);
 
@@ -667,14 +1040,9 @@ void *cdef_kernel(void *input_ptr) {
                     pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag ||
                     scs_ptr->static_config.recon_enabled) {
                     // Do application iff there are non-zero filters
-                    if (frm_hdr->cdef_params.cdef_y_strength[0] != 0 ||
+                    apply_cdef = frm_hdr->cdef_params.cdef_y_strength[0] != 0 ||
                         frm_hdr->cdef_params.cdef_uv_strength[0] != 0 ||
-                        pcs_ptr->parent_pcs_ptr->nb_cdef_strengths != 1) {
-                        if (is_16bit)
-                            av1_cdef_frame16bit(0, scs_ptr, pcs_ptr);
-                        else
-                            svt_av1_cdef_frame(0, scs_ptr, pcs_ptr);
-                    }
+                        pcs_ptr->parent_pcs_ptr->nb_cdef_strengths != 1;
                 }
             } else {
                 frm_hdr->cdef_params.cdef_bits             = 0;
@@ -683,21 +1051,6 @@ void *cdef_kernel(void *input_ptr) {
                 frm_hdr->cdef_params.cdef_uv_strength[0]   = 0;
             }
 
-            //restoration prep
-            if (scs_ptr->seq_header.enable_restoration) {
-                svt_av1_loop_restoration_save_boundary_lines(cm->frame_to_show, cm, 1);
-            }
-
-            // ------- start: Normative upscaling - super-resolution tool
-            if (frm_hdr->allow_intrabc == 0 && !av1_superres_unscaled(&cm->frm_size)) {
-                svt_av1_superres_upscale_frame(cm, pcs_ptr, scs_ptr);
-
-                if (is_16bit) {
-                    set_unscaled_input_16bit(pcs_ptr);
-                }
-            }
-            // ------- end: Normative upscaling - super-resolution tool
-
             pcs_ptr->rest_segments_column_count = scs_ptr->rest_segment_column_count;
             pcs_ptr->rest_segments_row_count    = scs_ptr->rest_segment_row_count;
             pcs_ptr->rest_segments_total_count  = (uint16_t)(pcs_ptr->rest_segments_column_count *
@@ -705,20 +1058,36 @@ void *cdef_kernel(void *input_ptr) {
             pcs_ptr->tot_seg_searched_rest      = 0;
             pcs_ptr->parent_pcs_ptr->av1_cm->use_boundaries_in_rest_search =
                 scs_ptr->use_boundaries_in_rest_search;
-            pcs_ptr->rest_extend_flag[0] = FALSE;
-            pcs_ptr->rest_extend_flag[1] = FALSE;
-            pcs_ptr->rest_extend_flag[2] = FALSE;
-
-            uint32_t segment_index;
-            for (segment_index = 0; segment_index < pcs_ptr->rest_segments_total_count;
-                 ++segment_index) {
-                // Get Empty Cdef Results to Rest
-                svt_get_empty_object(context_ptr->cdef_output_fifo_ptr, &cdef_results_wrapper_ptr);
-                cdef_results_ptr = (struct CdefResults *)cdef_results_wrapper_ptr->object_ptr;
-                cdef_results_ptr->pcs_wrapper_ptr = dlf_results_ptr->pcs_wrapper_ptr;
-                cdef_results_ptr->segment_index   = segment_index;
-                // Post Cdef Results
-                svt_post_full_object(cdef_results_wrapper_ptr);
+            // In wavefront mode the CDEF application extends the planes for the LR search and
+            // sends the LR search segment rows as it filters the rows they read. The search of
+            // an upscaled picture, or of a copy of the picture, waits for the whole picture.
+            pcs_ptr->rest_search_wavefront = apply_cdef &&
+                scs_ptr->seq_header.enable_restoration && frm_hdr->allow_intrabc == 0 &&
+                av1_superres_unscaled(&cm->frm_size) && !scs_ptr->use_boundaries_in_rest_search;
+            pcs_ptr->rest_extend_flag[0] = pcs_ptr->rest_search_wavefront;
+            pcs_ptr->rest_extend_flag[1] = pcs_ptr->rest_search_wavefront;
+            pcs_ptr->rest_extend_flag[2] = pcs_ptr->rest_search_wavefront;
+
+            if (apply_cdef)
+                cdef_run_segments(context_ptr, pcs_ptr);
+
+            if (!pcs_ptr->rest_search_wavefront) {
+                //restoration prep
+                if (scs_ptr->seq_header.enable_restoration) {
+                    svt_av1_loop_restoration_save_boundary_lines(cm->frame_to_show, cm, 1);
+                }
+
+                // ------- start: Normative upscaling - super-resolution tool
+                if (frm_hdr->allow_intrabc == 0 && !av1_superres_unscaled(&cm->frm_size)) {
+                    svt_av1_superres_upscale_frame(cm, pcs_ptr, scs_ptr);
+
+                    if (is_16bit) {
+                        set_unscaled_input_16bit(pcs_ptr);
+                    }
+                }
+                // ------- end: Normative upscaling - super-resolution tool
+
+                post_rest_segments(context_ptr, pcs_ptr, 0, pcs_ptr->rest_segments_total_count);
             }
         }
         svt_release_mutex(pcs_ptr->cdef_search_mutex);
@@ -321,10 +321,10 @@ typedef struct IntraBcContext {
     // used only in svt_av1_get_block_hash_value()
     // [first hash/second hash]
     // [two buffers used ping-pong]
-    uint32_t      *hash_value_buffer[2][2];
-    uint8_t        is_exhaustive_allowed;
-    CRC_CALCULATOR crc_calculator1;
-    CRC_CALCULATOR crc_calculator2;
+    uint32_t             *hash_value_buffer[2][2];
+    uint8_t               is_exhaustive_allowed;
+    const CRC_CALCULATOR *crc_calculator1;
+    const CRC_CALCULATOR *crc_calculator2;
     uint8_t
         approx_inter_rate; // use approximate rate for inter cost (set at pic-level b/c some pic-level initializations will be removed)
 } IntraBcContext;
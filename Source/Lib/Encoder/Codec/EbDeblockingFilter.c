@@ -710,46 +710,55 @@ void svt_av1_loop_filter_frame(EbPictureBufferDesc *frame_buffer, PictureControl
 }
 extern int16_t svt_av1_ac_quant_q3(int32_t qindex, int32_t delta, AomBitDepth bit_depth);
 
-void svt_copy_buffer(EbPictureBufferDesc *srcBuffer, EbPictureBufferDesc *dstBuffer,
-                     PictureControlSet *pcs_ptr, uint8_t plane) {
-    Bool is_16bit          = pcs_ptr->parent_pcs_ptr->scs_ptr->is_16bit_pipeline;
-    dstBuffer->origin_x    = srcBuffer->origin_x;
-    dstBuffer->origin_y    = srcBuffer->origin_y;
-    dstBuffer->width       = srcBuffer->width;
-    dstBuffer->height      = srcBuffer->height;
-    dstBuffer->max_width   = srcBuffer->max_width;
-    dstBuffer->max_height  = srcBuffer->max_height;
-    dstBuffer->bit_depth   = srcBuffer->bit_depth;
-    dstBuffer->luma_size   = srcBuffer->luma_size;
-    dstBuffer->chroma_size = srcBuffer->chroma_size;
-    dstBuffer->packed_flag = srcBuffer->packed_flag;
-
-    uint32_t luma_buffer_offset = (srcBuffer->origin_x + srcBuffer->origin_y * srcBuffer->stride_y)
-        << is_16bit;
+/* Points dst at the layout of src, for the copies of svt_copy_buffer */
+static void copy_buffer_layout(const EbPictureBufferDesc *src, EbPictureBufferDesc *dst) {
+    dst->origin_x          = src->origin_x;
+    dst->origin_y          = src->origin_y;
+    dst->width             = src->width;
+    dst->height            = src->height;
+    dst->max_width         = src->max_width;
+    dst->max_height        = src->max_height;
+    dst->bit_depth         = src->bit_depth;
+    dst->luma_size         = src->luma_size;
+    dst->chroma_size       = src->chroma_size;
+    dst->packed_flag       = src->packed_flag;
+    dst->stride_y          = src->stride_y;
+    dst->stride_bit_inc_y  = src->stride_bit_inc_y;
+    dst->stride_cb         = src->stride_cb;
+    dst->stride_bit_inc_cb = src->stride_bit_inc_cb;
+    dst->stride_cr         = src->stride_cr;
+    dst->stride_bit_inc_cr = src->stride_bit_inc_cr;
+}
+
+/* Copies the plane rows of the luma rows [row_start, row_end) */
+static void svt_copy_buffer(EbPictureBufferDesc *srcBuffer, EbPictureBufferDesc *dstBuffer,
+                            PictureControlSet *pcs_ptr, uint8_t plane, uint32_t row_start,
+                            uint32_t row_end) {
+    Bool     is_16bit    = pcs_ptr->parent_pcs_ptr->scs_ptr->is_16bit_pipeline;
     uint16_t luma_width  = (uint16_t)(srcBuffer->width) << is_16bit;
-    uint16_t luma_height = (uint16_t)(srcBuffer->height);
+    uint32_t luma_height = AOMMIN(row_end, srcBuffer->height);
 
     uint16_t chroma_width = (luma_width >> 1);
     if (plane == 0) {
-        uint16_t stride_y = srcBuffer->stride_y << is_16bit;
-
-        dstBuffer->stride_y         = srcBuffer->stride_y;
-        dstBuffer->stride_bit_inc_y = srcBuffer->stride_bit_inc_y;
+        uint16_t stride_y           = srcBuffer->stride_y << is_16bit;
+        uint32_t luma_buffer_offset = (srcBuffer->origin_x +
+                                       srcBuffer->origin_y * srcBuffer->stride_y)
+            << is_16bit;
 
-        for (int32_t input_row_index = 0; input_row_index < luma_height; input_row_index++) {
+        for (uint32_t input_row_index = row_start; input_row_index < luma_height;
+             input_row_index++) {
             svt_memcpy((dstBuffer->buffer_y + luma_buffer_offset + stride_y * input_row_index),
                        (srcBuffer->buffer_y + luma_buffer_offset + stride_y * input_row_index),
                        luma_width);
         }
     } else if (plane == 1) {
-        uint16_t stride_cb           = srcBuffer->stride_cb << is_16bit;
-        dstBuffer->stride_cb         = srcBuffer->stride_cb;
-        dstBuffer->stride_bit_inc_cb = srcBuffer->stride_bit_inc_cb;
+        uint16_t stride_cb = srcBuffer->stride_cb << is_16bit;
 
         uint32_t chroma_buffer_offset =
             (srcBuffer->origin_x / 2 + srcBuffer->origin_y / 2 * srcBuffer->stride_cb) << is_16bit;
 
-        for (int32_t input_row_index = 0; input_row_index < luma_height / 2; input_row_index++) {
+        for (uint32_t input_row_index = row_start / 2; input_row_index < luma_height / 2;
+             input_row_index++) {
             svt_memcpy((dstBuffer->buffer_cb + chroma_buffer_offset + stride_cb * input_row_index),
                        (srcBuffer->buffer_cb + chroma_buffer_offset + stride_cb * input_row_index),
                        chroma_width);
@@ -757,152 +766,184 @@ void svt_copy_buffer(EbPictureBufferDesc *srcBuffer, EbPictureBufferDesc *dstBuf
     } else if (plane == 2) {
         uint16_t stride_cr = srcBuffer->stride_cr << is_16bit;
 
-        dstBuffer->stride_cr         = srcBuffer->stride_cr;
-        dstBuffer->stride_bit_inc_cr = srcBuffer->stride_bit_inc_cr;
-
         uint32_t chroma_buffer_offset =
             (srcBuffer->origin_x / 2 + srcBuffer->origin_y / 2 * srcBuffer->stride_cr) << is_16bit;
 
-        for (int32_t input_row_index = 0; input_row_index < luma_height / 2; input_row_index++) {
+        for (uint32_t input_row_index = row_start / 2; input_row_index < luma_height / 2;
+             input_row_index++) {
             svt_memcpy((dstBuffer->buffer_cr + chroma_buffer_offset + stride_cr * input_row_index),
                        (srcBuffer->buffer_cr + chroma_buffer_offset + stride_cr * input_row_index),
                        chroma_width);
         }
     }
 }
-uint64_t picture_sse_calculations(PictureControlSet *pcs_ptr, EbPictureBufferDesc *recon_ptr,
-                                  int32_t plane)
 
-{
-    SequenceControlSet *scs_ptr  = pcs_ptr->parent_pcs_ptr->scs_ptr;
-    Bool                is_16bit = scs_ptr->is_16bit_pipeline;
+/* SSE between the source and the recon plane rows of the luma rows [row_start, row_end) */
+static uint64_t picture_sse_calculations(PictureControlSet *pcs_ptr, EbPictureBufferDesc *recon_ptr,
+                                         int32_t plane, uint32_t row_start, uint32_t row_end) {
+    SequenceControlSet  *scs_ptr           = pcs_ptr->parent_pcs_ptr->scs_ptr;
+    Bool                 is_16bit          = scs_ptr->is_16bit_pipeline;
+    EbPictureBufferDesc *input_picture_ptr = is_16bit
+                 ? pcs_ptr->input_frame16bit
+                 : (EbPictureBufferDesc *)pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr;
 
-    const uint32_t ss_x = scs_ptr->subsampling_x;
-    const uint32_t ss_y = scs_ptr->subsampling_y;
+    const uint32_t ss_x = plane ? scs_ptr->subsampling_x : 0;
+    const uint32_t ss_y = plane ? scs_ptr->subsampling_y : 0;
+    // the chroma origins are halved whatever the subsampling
+    const uint32_t org_shift = plane ? 1 : 0;
 
     uint8_t *input_buffer;
     uint8_t *recon_coeff_buffer;
+    uint32_t input_stride;
+    uint32_t recon_stride;
+    switch (plane) {
+    case 0:
+        input_buffer       = input_picture_ptr->buffer_y;
+        input_stride       = input_picture_ptr->stride_y;
+        recon_coeff_buffer = recon_ptr->buffer_y;
+        recon_stride       = recon_ptr->stride_y;
+        break;
+    case 1:
+        input_buffer       = input_picture_ptr->buffer_cb;
+        input_stride       = input_picture_ptr->stride_cb;
+        recon_coeff_buffer = recon_ptr->buffer_cb;
+        recon_stride       = recon_ptr->stride_cb;
+        break;
+    case 2:
+        input_buffer       = input_picture_ptr->buffer_cr;
+        input_stride       = input_picture_ptr->stride_cr;
+        recon_coeff_buffer = recon_ptr->buffer_cr;
+        recon_stride       = recon_ptr->stride_cr;
+        break;
+    default: return 0;
+    }
+    const uint32_t y_start = row_start >> ss_y;
+    const uint32_t y_end   = AOMMIN(row_end, input_picture_ptr->height) >> ss_y;
+    if (y_start >= y_end)
+        return 0;
+    input_buffer += ((input_picture_ptr->origin_x >> org_shift) +
+                     ((input_picture_ptr->origin_y >> org_shift) + y_start) * input_stride)
+        << is_16bit;
+    recon_coeff_buffer += ((recon_ptr->origin_x >> org_shift) +
+                           ((recon_ptr->origin_y >> org_shift) + y_start) * recon_stride)
+        << is_16bit;
 
-    if (!is_16bit) {
-        EbPictureBufferDesc *input_picture_ptr = (EbPictureBufferDesc *)
-                                                     pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr;
-
-        if (plane == 0) {
-            recon_coeff_buffer = (uint8_t *)&(
-                (recon_ptr
-                     ->buffer_y)[recon_ptr->origin_x + recon_ptr->origin_y * recon_ptr->stride_y]);
-            input_buffer = (uint8_t *)&(
-                (input_picture_ptr
-                     ->buffer_y)[input_picture_ptr->origin_x +
-                                 input_picture_ptr->origin_y * input_picture_ptr->stride_y]);
-
-            return svt_spatial_full_distortion_kernel(input_buffer,
-                                                      0,
-                                                      input_picture_ptr->stride_y,
-                                                      recon_coeff_buffer,
-                                                      0,
-                                                      recon_ptr->stride_y,
-                                                      input_picture_ptr->width,
-                                                      input_picture_ptr->height);
-        } else if (plane == 1) {
-            recon_coeff_buffer = (uint8_t *)&(
-                (recon_ptr->buffer_cb)[recon_ptr->origin_x / 2 +
-                                       recon_ptr->origin_y / 2 * recon_ptr->stride_cb]);
-            input_buffer = (uint8_t *)&(
-                (input_picture_ptr
-                     ->buffer_cb)[input_picture_ptr->origin_x / 2 +
-                                  input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cb]);
-
-            return svt_spatial_full_distortion_kernel(input_buffer,
-                                                      0,
-                                                      input_picture_ptr->stride_cb,
-                                                      recon_coeff_buffer,
-                                                      0,
-                                                      recon_ptr->stride_cb,
-                                                      input_picture_ptr->width >> ss_x,
-                                                      input_picture_ptr->height >> ss_y);
-        } else if (plane == 2) {
-            recon_coeff_buffer = (uint8_t *)&(
-                (recon_ptr->buffer_cr)[recon_ptr->origin_x / 2 +
-                                       recon_ptr->origin_y / 2 * recon_ptr->stride_cr]);
-            input_buffer = (uint8_t *)&(
-                (input_picture_ptr
-                     ->buffer_cr)[input_picture_ptr->origin_x / 2 +
-                                  input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cr]);
-
-            return svt_spatial_full_distortion_kernel(input_buffer,
-                                                      0,
-                                                      input_picture_ptr->stride_cr,
-                                                      recon_coeff_buffer,
-                                                      0,
-                                                      recon_ptr->stride_cr,
-                                                      input_picture_ptr->width >> ss_x,
-                                                      input_picture_ptr->height >> ss_y);
+    if (!is_16bit)
+        return svt_spatial_full_distortion_kernel(input_buffer,
+                                                  0,
+                                                  input_stride,
+                                                  recon_coeff_buffer,
+                                                  0,
+                                                  recon_stride,
+                                                  input_picture_ptr->width >> ss_x,
+                                                  y_end - y_start);
+    return svt_full_distortion_kernel16_bits(input_buffer,
+                                             0,
+                                             input_stride,
+                                             recon_coeff_buffer,
+                                             0,
+                                             recon_stride,
+                                             input_picture_ptr->width >> ss_x,
+                                             y_end - y_start);
+}
+/*************************************************************************************************
+* svt_av1_loop_filter_segment
+* Runs a pass of the loop filter over the DLF segment (SB row) segment_index. The edges of one
+* direction do not overlap, so the vertical pass of all the segments followed by the horizontal
+* pass gives the output of the frame filtered in SB order. Returns the SSE of an SSE pass.
+*************************************************************************************************/
+uint64_t svt_av1_loop_filter_segment(PictureControlSet *pcs_ptr, DlfSegmentPass pass,
+                                     int32_t plane_start, int32_t plane_end,
+                                     uint32_t segment_index) {
+    SequenceControlSet  *scs_ptr  = pcs_ptr->scs_ptr;
+    FrameHeader         *frm_hdr  = &pcs_ptr->parent_pcs_ptr->frm_hdr;
+    const Bool           is_16bit = scs_ptr->is_16bit_pipeline;
+    const uint32_t       sb_size  = scs_ptr->sb_size_pix;
+    EbPictureBufferDesc *recon_buffer;
+    get_recon_pic(pcs_ptr, &recon_buffer, is_16bit);
+    EbPictureBufferDesc *temp_lf_recon_buffer = is_16bit ? pcs_ptr->temp_lf_recon_picture16bit_ptr
+                                                         : pcs_ptr->temp_lf_recon_picture_ptr;
+    uint64_t sse = 0;
+
+    if (pass == DLF_SEG_SAVE_PASS || pass == DLF_SEG_SSE_PASS) {
+        for (int32_t plane = plane_start; plane < plane_end; plane++) {
+            if (pass == DLF_SEG_SSE_PASS) {
+                sse += picture_sse_calculations(pcs_ptr,
+                                                recon_buffer,
+                                                plane,
+                                                segment_index * sb_size,
+                                                (segment_index + 1) * sb_size);
+                // Re-instate the unfiltered rows
+                svt_copy_buffer(temp_lf_recon_buffer,
+                                recon_buffer,
+                                pcs_ptr,
+                                (uint8_t)plane,
+                                segment_index * sb_size,
+                                (segment_index + 1) * sb_size);
+            } else
+                svt_copy_buffer(recon_buffer,
+                                temp_lf_recon_buffer,
+                                pcs_ptr,
+                                (uint8_t)plane,
+                                segment_index * sb_size,
+                                (segment_index + 1) * sb_size);
         }
-        return 0;
-    } else {
-        EbPictureBufferDesc *input_picture_ptr = (EbPictureBufferDesc *)pcs_ptr->input_frame16bit;
-
-        if (plane == 0) {
-            recon_coeff_buffer = (uint8_t *)&(
-                (recon_ptr
-                     ->buffer_y)[(recon_ptr->origin_x + recon_ptr->origin_y * recon_ptr->stride_y)
-                                 << is_16bit]);
-            input_buffer = (uint8_t *)&(
-                (input_picture_ptr
-                     ->buffer_y)[(input_picture_ptr->origin_x +
-                                  input_picture_ptr->origin_y * input_picture_ptr->stride_y)
-                                 << is_16bit]);
-
-            return svt_full_distortion_kernel16_bits(input_buffer,
-                                                     0,
-                                                     input_picture_ptr->stride_y,
-                                                     recon_coeff_buffer,
-                                                     0,
-                                                     recon_ptr->stride_y,
-                                                     input_picture_ptr->width,
-                                                     input_picture_ptr->height);
-        } else if (plane == 1) {
-            recon_coeff_buffer = (uint8_t *)&(
-                (recon_ptr->buffer_cb)[(recon_ptr->origin_x / 2 +
-                                        recon_ptr->origin_y / 2 * recon_ptr->stride_cb)
-                                       << is_16bit]);
-            input_buffer = (uint8_t *)&(
-                (input_picture_ptr
-                     ->buffer_cb)[(input_picture_ptr->origin_x / 2 +
-                                   input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cb)
-                                  << is_16bit]);
-
-            return svt_full_distortion_kernel16_bits(input_buffer,
-                                                     0,
-                                                     input_picture_ptr->stride_cb,
-                                                     recon_coeff_buffer,
-                                                     0,
-                                                     recon_ptr->stride_cb,
-                                                     input_picture_ptr->width >> ss_x,
-                                                     input_picture_ptr->height >> ss_y);
-        } else if (plane == 2) {
-            recon_coeff_buffer = (uint8_t *)&(
-                (recon_ptr->buffer_cr)[(recon_ptr->origin_x / 2 +
-                                        recon_ptr->origin_y / 2 * recon_ptr->stride_cr)
-                                       << is_16bit]);
-            input_buffer = (uint8_t *)&(
-                (input_picture_ptr
-                     ->buffer_cr)[(input_picture_ptr->origin_x / 2 +
-                                   input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cr)
-                                  << is_16bit]);
-
-            return svt_full_distortion_kernel16_bits(input_buffer,
-                                                     0,
-                                                     input_picture_ptr->stride_cr,
-                                                     recon_coeff_buffer,
-                                                     0,
-                                                     recon_ptr->stride_cr,
-                                                     input_picture_ptr->width >> ss_x,
-                                                     input_picture_ptr->height >> ss_y);
+        return sse;
+    }
+
+    struct MacroblockdPlane pd[3];
+    pd[0].subsampling_x = 0;
+    pd[0].subsampling_y = 0;
+    pd[0].plane_type    = PLANE_TYPE_Y;
+    pd[1].subsampling_x = 1;
+    pd[1].subsampling_y = 1;
+    pd[1].plane_type    = PLANE_TYPE_UV;
+    pd[2].subsampling_x = 1;
+    pd[2].subsampling_y = 1;
+    pd[2].plane_type    = PLANE_TYPE_UV;
+    pd[0].is_16bit = pd[1].is_16bit = pd[2].is_16bit = is_16bit || recon_buffer->bit_depth > 8;
+
+    const uint32_t pic_width_in_sb = (pcs_ptr->parent_pcs_ptr->aligned_width + sb_size - 1) /
+        sb_size;
+    const int32_t mi_row = (segment_index * sb_size) >> MI_SIZE_LOG2;
+    for (int32_t plane = plane_start; plane < plane_end; plane++) {
+        if (plane == 0 && !(frm_hdr->loop_filter_params.filter_level[0]) &&
+            !(frm_hdr->loop_filter_params.filter_level[1]))
+            break;
+        else if (plane == 1 && !(frm_hdr->loop_filter_params.filter_level_u))
+            continue;
+        else if (plane == 2 && !(frm_hdr->loop_filter_params.filter_level_v))
+            continue;
+        for (uint32_t x_sb_index = 0; x_sb_index < pic_width_in_sb; ++x_sb_index) {
+            const int32_t mi_col = (x_sb_index * sb_size) >> MI_SIZE_LOG2;
+            svt_av1_setup_dst_planes(pcs_ptr,
+                                     pd,
+                                     scs_ptr->seq_header.sb_size,
+                                     recon_buffer,
+                                     mi_row,
+                                     mi_col,
+                                     plane,
+                                     plane + 1);
+            if (pass == DLF_SEG_VERT_PASS)
+                svt_av1_filter_block_plane_vert(pcs_ptr, plane, &pd[plane], mi_row, mi_col);
+            else
+                svt_av1_filter_block_plane_horz(pcs_ptr, plane, &pd[plane], mi_row, mi_col);
         }
-        return 0;
     }
+    return sse;
+}
+/*************************************************************************************************
+* svt_av1_loop_filter_frame_segments
+* Filters the frame as svt_av1_loop_filter_frame, over the DLF segments
+*************************************************************************************************/
+void svt_av1_loop_filter_frame_segments(PictureControlSet *pcs_ptr, int32_t plane_start,
+                                        int32_t plane_end) {
+    svt_av1_loop_filter_frame_init(&pcs_ptr->parent_pcs_ptr->frm_hdr,
+                                   &pcs_ptr->parent_pcs_ptr->lf_info,
+                                   plane_start,
+                                   plane_end);
+    dlf_run_segments(pcs_ptr, DLF_SEG_VERT_PASS, plane_start, plane_end);
+    dlf_run_segments(pcs_ptr, DLF_SEG_HORZ_PASS, plane_start, plane_end);
 }
 /*************************************************************************************************
 * try_filter_frame
@@ -912,13 +953,10 @@ uint64_t picture_sse_calculations(PictureControlSet *pcs_ptr, EbPictureBufferDes
 static int64_t try_filter_frame(
     //const Yv12BufferConfig *sd,
     //Av1Comp *const cpi,
-    const EbPictureBufferDesc *sd, EbPictureBufferDesc *temp_lf_recon_buffer,
-    PictureControlSet *pcs_ptr, int32_t filt_level, int32_t partial_frame, int32_t plane,
-    int32_t dir) {
+    const EbPictureBufferDesc *sd, PictureControlSet *pcs_ptr, int32_t filt_level,
+    int32_t partial_frame, int32_t plane, int32_t dir) {
     (void)sd;
     (void)partial_frame;
-    (void)sd;
-    int64_t      filt_err;
     FrameHeader *frm_hdr = &pcs_ptr->parent_pcs_ptr->frm_hdr;
     assert(plane >= 0 && plane <= 2);
     int32_t filter_level[2] = {filt_level, filt_level};
@@ -927,10 +965,6 @@ static int64_t try_filter_frame(
     if (plane == 0 && dir == 1)
         filter_level[0] = frm_hdr->loop_filter_params.filter_level[0];
 
-    Bool                 is_16bit = pcs_ptr->parent_pcs_ptr->scs_ptr->is_16bit_pipeline;
-    EbPictureBufferDesc *recon_buffer;
-    get_recon_pic(pcs_ptr, &recon_buffer, is_16bit);
-
     // set base filters for use of get_filter_level when in DELTA_Q_LF mode
     switch (plane) {
     case 0:
@@ -941,17 +975,10 @@ static int64_t try_filter_frame(
     case 2: frm_hdr->loop_filter_params.filter_level_v = filter_level[0]; break;
     }
 
-    svt_av1_loop_filter_frame(recon_buffer, pcs_ptr, plane, plane + 1);
-
-    filt_err = picture_sse_calculations(pcs_ptr, recon_buffer, plane);
-
-    // Re-instate the unfiltered frame
-    svt_copy_buffer(temp_lf_recon_buffer /*cpi->last_frame_uf*/,
-                    recon_buffer /*cm->frame_to_show*/,
-                    pcs_ptr,
-                    (uint8_t)plane);
+    svt_av1_loop_filter_frame_segments(pcs_ptr, plane, plane + 1);
 
-    return filt_err;
+    // The SSE pass re-instates the unfiltered frame
+    return (int64_t)dlf_run_segments(pcs_ptr, DLF_SEG_SSE_PASS, plane, plane + 1);
 }
 /*************************************************************************************************
 * search_filter_level
@@ -991,13 +1018,11 @@ static int32_t search_filter_level(
     // Set each entry to -1
     memset(ss_err, 0xFF, sizeof(ss_err));
     // make a copy of recon_buffer
-    svt_copy_buffer(recon_buffer /*cm->frame_to_show*/,
-                    temp_lf_recon_buffer /*&cpi->last_frame_uf*/,
-                    pcs_ptr,
-                    (uint8_t)plane);
+    copy_buffer_layout(recon_buffer /*cm->frame_to_show*/,
+                       temp_lf_recon_buffer /*&cpi->last_frame_uf*/);
+    dlf_run_segments(pcs_ptr, DLF_SEG_SAVE_PASS, plane, plane + 1);
 
-    best_err = try_filter_frame(
-        sd, temp_lf_recon_buffer, pcs_ptr, filt_mid, partial_frame, plane, dir);
+    best_err = try_filter_frame(sd, pcs_ptr, filt_mid, partial_frame, plane, dir);
     filt_best        = filt_mid;
     ss_err[filt_mid] = best_err;
     while (filter_step > 0) {
@@ -1015,7 +1040,7 @@ static int32_t search_filter_level(
             // Get Low filter error score
             if (ss_err[filt_low] < 0) {
                 ss_err[filt_low] = try_filter_frame(
-                    sd, temp_lf_recon_buffer, pcs_ptr, filt_low, partial_frame, plane, dir);
+                    sd, pcs_ptr, filt_low, partial_frame, plane, dir);
             }
             // If value is close to the best so far then bias towards a lower loop
             // filter value.
@@ -1031,7 +1056,7 @@ static int32_t search_filter_level(
         if (filt_direction >= 0 && filt_high != filt_mid) {
             if (ss_err[filt_high] < 0) {
                 ss_err[filt_high] = try_filter_frame(
-                    sd, temp_lf_recon_buffer, pcs_ptr, filt_high, partial_frame, plane, dir);
+                    sd, pcs_ptr, filt_high, partial_frame, plane, dir);
             }
             // If value is significantly better than previous best, bias added against
             // raising filter value
@@ -54,6 +54,13 @@ void svt_av1_loop_filter_frame(
         /*MacroBlockD *xd,*/ int32_t plane_start, int32_t plane_end/*,
         int32_t partial_frame*/);
 
+void svt_av1_loop_filter_frame_segments(PictureControlSet *pcs_ptr, int32_t plane_start,
+                                        int32_t plane_end);
+
+uint64_t svt_av1_loop_filter_segment(PictureControlSet *pcs_ptr, DlfSegmentPass pass,
+                                     int32_t plane_start, int32_t plane_end,
+                                     uint32_t segment_index);
+
 EbErrorType svt_av1_pick_filter_level(EbPictureBufferDesc *srcBuffer, // source input
                                       PictureControlSet *pcs_ptr, LpfPickMethod method);
 
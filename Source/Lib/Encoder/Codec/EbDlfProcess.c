@@ -49,9 +49,146 @@ EbErrorType dlf_context_ctor(EbThreadContext *thread_context_ptr, const EbEncHan
         enc_handle_ptr->enc_dec_results_resource_ptr, index);
     context_ptr->dlf_output_fifo_ptr = svt_system_resource_get_producer_fifo(
         enc_handle_ptr->dlf_results_resource_ptr, index);
+    context_ptr->dlf_feedback_fifo_ptr = svt_system_resource_get_producer_fifo(
+        enc_handle_ptr->enc_dec_results_resource_ptr,
+        enc_handle_ptr->scs_instance_array[0]->scs_ptr->enc_dec_process_init_count + index);
+    context_ptr->dlf_seg_task_count =
+        &enc_handle_ptr->scs_instance_array[0]->encode_context_ptr->dlf_seg_task_count;
     return EB_ErrorNone;
 }
 
+/******************************************************
+ * CDEF search init
+ * Points the CDEF search at the deblocked recon and the source, and resets the
+ * segment bookkeeping
+ ******************************************************/
+void cdef_search_init(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr) {
+    Bool                 is_16bit = scs_ptr->is_16bit_pipeline;
+    EbPictureBufferDesc *recon_picture_ptr;
+    get_recon_pic(pcs_ptr, &recon_picture_ptr, is_16bit);
+    if (scs_ptr->seq_header.cdef_level && pcs_ptr->parent_pcs_ptr->cdef_level) {
+        if (is_16bit) {
+            pcs_ptr->src[0] = (uint16_t *)recon_picture_ptr->buffer_y +
+                (recon_picture_ptr->origin_x +
+                 recon_picture_ptr->origin_y * recon_picture_ptr->stride_y);
+            pcs_ptr->src[1] = (uint16_t *)recon_picture_ptr->buffer_cb +
+                (recon_picture_ptr->origin_x / 2 +
+                 recon_picture_ptr->origin_y / 2 * recon_picture_ptr->stride_cb);
+            pcs_ptr->src[2] = (uint16_t *)recon_picture_ptr->buffer_cr +
+                (recon_picture_ptr->origin_x / 2 +
+                 recon_picture_ptr->origin_y / 2 * recon_picture_ptr->stride_cr);
+
+            EbPictureBufferDesc *input_picture_ptr = pcs_ptr->input_frame16bit;
+            pcs_ptr->ref_coeff[0] = (uint16_t *)input_picture_ptr->buffer_y +
+                (input_picture_ptr->origin_x +
+                 input_picture_ptr->origin_y * input_picture_ptr->stride_y);
+            pcs_ptr->ref_coeff[1] = (uint16_t *)input_picture_ptr->buffer_cb +
+                (input_picture_ptr->origin_x / 2 +
+                 input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cb);
+            pcs_ptr->ref_coeff[2] = (uint16_t *)input_picture_ptr->buffer_cr +
+                (input_picture_ptr->origin_x / 2 +
+                 input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cr);
+        } else {
+            EbByte rec_ptr    = &((
+                recon_picture_ptr
+                    ->buffer_y)[recon_picture_ptr->origin_x +
+                                recon_picture_ptr->origin_y * recon_picture_ptr->stride_y]);
+            EbByte rec_ptr_cb = &(
+                (recon_picture_ptr->buffer_cb)[recon_picture_ptr->origin_x / 2 +
+                                               recon_picture_ptr->origin_y / 2 *
+                                                   recon_picture_ptr->stride_cb]);
+            EbByte rec_ptr_cr = &(
+                (recon_picture_ptr->buffer_cr)[recon_picture_ptr->origin_x / 2 +
+                                               recon_picture_ptr->origin_y / 2 *
+                                                   recon_picture_ptr->stride_cr]);
+
+            EbPictureBufferDesc *input_picture_ptr =
+                (EbPictureBufferDesc *)pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr;
+            EbByte enh_ptr    = &((
+                input_picture_ptr
+                    ->buffer_y)[input_picture_ptr->origin_x +
+                                input_picture_ptr->origin_y * input_picture_ptr->stride_y]);
+            EbByte enh_ptr_cb = &(
+                (input_picture_ptr->buffer_cb)[input_picture_ptr->origin_x / 2 +
+                                               input_picture_ptr->origin_y / 2 *
+                                                   input_picture_ptr->stride_cb]);
+            EbByte enh_ptr_cr = &(
+                (input_picture_ptr->buffer_cr)[input_picture_ptr->origin_x / 2 +
+                                               input_picture_ptr->origin_y / 2 *
+                                                   input_picture_ptr->stride_cr]);
+
+            pcs_ptr->src[0] = (uint16_t *)rec_ptr;
+            pcs_ptr->src[1] = (uint16_t *)rec_ptr_cb;
+            pcs_ptr->src[2] = (uint16_t *)rec_ptr_cr;
+
+            pcs_ptr->ref_coeff[0] = (uint16_t *)enh_ptr;
+            pcs_ptr->ref_coeff[1] = (uint16_t *)enh_ptr_cb;
+            pcs_ptr->ref_coeff[2] = (uint16_t *)enh_ptr_cr;
+        }
+    }
+
+    pcs_ptr->cdef_segments_column_count = scs_ptr->cdef_segment_column_count;
+    pcs_ptr->cdef_segments_row_count    = scs_ptr->cdef_segment_row_count;
+    pcs_ptr->cdef_segments_total_count  = (uint16_t)(pcs_ptr->cdef_segments_column_count *
+                                                    pcs_ptr->cdef_segments_row_count);
+    pcs_ptr->tot_seg_searched_cdef      = 0;
+}
+
+/* Sends the CDEF search segments of segment rows [seg_row_start, seg_row_end) */
+static void post_cdef_segments(DlfContext *context_ptr, EbObjectWrapper *pcs_wrapper_ptr,
+                               PictureControlSet *pcs_ptr, uint32_t seg_row_start,
+                               uint32_t seg_row_end) {
+    for (uint32_t segment_index = seg_row_start * pcs_ptr->cdef_segments_column_count;
+         segment_index < seg_row_end * pcs_ptr->cdef_segments_column_count;
+         ++segment_index) {
+        EbObjectWrapper   *dlf_results_wrapper_ptr;
+        struct DlfResults *dlf_results_ptr;
+        // Get Empty DLF Results to Cdef
+        svt_get_empty_object(context_ptr->dlf_output_fifo_ptr, &dlf_results_wrapper_ptr);
+        dlf_results_ptr = (struct DlfResults *)dlf_results_wrapper_ptr->object_ptr;
+        dlf_results_ptr->pcs_wrapper_ptr = pcs_wrapper_ptr;
+        dlf_results_ptr->segment_index   = segment_index;
+        dlf_results_ptr->cdef_segments   = FALSE;
+        // Post DLF Results
+        svt_post_full_object(dlf_results_wrapper_ptr);
+    }
+}
+
+/* Filters a DLF segment, returns its SSE in an SSE pass */
+static uint64_t dlf_filter_segment(PictureControlSet *pcs_ptr, void *thread_ctx,
+                                   const SegmentPassStep *step, uint32_t segment_index) {
+    (void)thread_ctx;
+    return svt_av1_loop_filter_segment(
+        pcs_ptr, (DlfSegmentPass)step->pass, step->arg[0], step->arg[1], segment_index);
+}
+
+static void dlf_post_segment_task(EbFifo *fifo_ptr, PictureControlSet *pcs_ptr) {
+    EbObjectWrapper *wrapper_ptr;
+    svt_get_empty_object(fifo_ptr, &wrapper_ptr);
+    EncDecResults *task_ptr   = (EncDecResults *)wrapper_ptr->object_ptr;
+    task_ptr->pcs_wrapper_ptr = pcs_ptr->c_pcs_wrapper_ptr;
+    task_ptr->partial         = FALSE;
+    task_ptr->dlf_segments    = TRUE;
+    svt_post_full_object(wrapper_ptr);
+}
+
+/* Runs a pass over the DLF segments of the picture, returns the SSE of an SSE pass */
+uint64_t dlf_run_segments(PictureControlSet *pcs_ptr, DlfSegmentPass pass, int32_t plane_start,
+                          int32_t plane_end) {
+    SequenceControlSet *scs_ptr       = pcs_ptr->scs_ptr;
+    const uint16_t      segment_count = (uint16_t)((pcs_ptr->parent_pcs_ptr->aligned_height +
+                                                  scs_ptr->sb_size_pix - 1) /
+                                                 scs_ptr->sb_size_pix);
+    const SegmentPassStep    step    = {dlf_filter_segment,
+                                        (uint8_t)pass,
+                                        {(uint8_t)plane_start, (uint8_t)plane_end}};
+    const SegmentPassHelpers helpers = {pcs_ptr->dlf_seg_fifo_ptr,
+                                        dlf_post_segment_task,
+                                        &scs_ptr->encode_context_ptr->dlf_seg_task_count,
+                                        (int32_t)scs_ptr->dlf_process_init_count - 1};
+    return svt_segment_pass_run(&pcs_ptr->dlf_seg, pcs_ptr, &step, segment_count, NULL, &helpers);
+}
+
 /******************************************************
  * Dlf Kernel
  ******************************************************/
@@ -79,6 +216,22 @@ void *dlf_kernel(void *input_ptr) {
         pcs_ptr             = (PictureControlSet *)enc_dec_results_ptr->pcs_wrapper_ptr->object_ptr;
         scs_ptr             = pcs_ptr->scs_ptr;
 
+        if (enc_dec_results_ptr->dlf_segments) {
+            svt_segment_pass_help(&pcs_ptr->dlf_seg, pcs_ptr, NULL, context_ptr->dlf_seg_task_count);
+            svt_release_object(enc_dec_results_wrapper_ptr);
+            continue;
+        }
+        if (enc_dec_results_ptr->partial) {
+            // Wavefront post-filtering: search CDEF on the rows EncDec has finished
+            post_cdef_segments(context_ptr,
+                               enc_dec_results_ptr->pcs_wrapper_ptr,
+                               pcs_ptr,
+                               enc_dec_results_ptr->cdef_seg_row_start,
+                               enc_dec_results_ptr->cdef_seg_row_end);
+            svt_release_object(enc_dec_results_wrapper_ptr);
+            continue;
+        }
+
         Bool is_16bit = scs_ptr->is_16bit_pipeline;
         if (is_16bit && scs_ptr->static_config.encoder_bit_depth == EB_8BIT) {
             svt_convert_pic_8bit_to_16bit(pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr,
@@ -103,15 +256,14 @@ void *dlf_kernel(void *input_ptr) {
         // Move sb level lf to here if tile_parallel
         if ((dlf_enable_flag && !pcs_ptr->parent_pcs_ptr->dlf_ctrls.sb_based_dlf) ||
             (dlf_enable_flag && pcs_ptr->parent_pcs_ptr->dlf_ctrls.sb_based_dlf && tg_count > 1)) {
-            EbPictureBufferDesc *recon_buffer;
-            get_recon_pic(pcs_ptr, &recon_buffer, is_16bit);
+            pcs_ptr->dlf_seg_fifo_ptr = context_ptr->dlf_feedback_fifo_ptr;
             svt_av1_loop_filter_init(pcs_ptr);
             svt_av1_pick_filter_level(
                 (EbPictureBufferDesc *)pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr,
                 pcs_ptr,
                 LPF_PICK_FROM_FULL_IMAGE);
 
-            svt_av1_loop_filter_frame(recon_buffer, pcs_ptr, 0, 3);
+            svt_av1_loop_filter_frame_segments(pcs_ptr, 0, 3);
         }
 
         //pre-cdef prep
@@ -126,84 +278,28 @@ void *dlf_kernel(void *input_ptr) {
                                        is_16bit);
             if (scs_ptr->seq_header.enable_restoration)
                 svt_av1_loop_restoration_save_boundary_lines(cm->frame_to_show, cm, 0);
-            if (scs_ptr->seq_header.cdef_level && pcs_ptr->parent_pcs_ptr->cdef_level) {
-                if (is_16bit) {
-                    pcs_ptr->src[0] = (uint16_t *)recon_picture_ptr->buffer_y +
-                        (recon_picture_ptr->origin_x +
-                         recon_picture_ptr->origin_y * recon_picture_ptr->stride_y);
-                    pcs_ptr->src[1] = (uint16_t *)recon_picture_ptr->buffer_cb +
-                        (recon_picture_ptr->origin_x / 2 +
-                         recon_picture_ptr->origin_y / 2 * recon_picture_ptr->stride_cb);
-                    pcs_ptr->src[2] = (uint16_t *)recon_picture_ptr->buffer_cr +
-                        (recon_picture_ptr->origin_x / 2 +
-                         recon_picture_ptr->origin_y / 2 * recon_picture_ptr->stride_cr);
-
-                    EbPictureBufferDesc *input_picture_ptr = pcs_ptr->input_frame16bit;
-                    pcs_ptr->ref_coeff[0] = (uint16_t *)input_picture_ptr->buffer_y +
-                        (input_picture_ptr->origin_x +
-                         input_picture_ptr->origin_y * input_picture_ptr->stride_y);
-                    pcs_ptr->ref_coeff[1] = (uint16_t *)input_picture_ptr->buffer_cb +
-                        (input_picture_ptr->origin_x / 2 +
-                         input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cb);
-                    pcs_ptr->ref_coeff[2] = (uint16_t *)input_picture_ptr->buffer_cr +
-                        (input_picture_ptr->origin_x / 2 +
-                         input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cr);
-                } else {
-                    EbByte rec_ptr    = &((
-                        recon_picture_ptr
-                            ->buffer_y)[recon_picture_ptr->origin_x +
-                                        recon_picture_ptr->origin_y * recon_picture_ptr->stride_y]);
-                    EbByte rec_ptr_cb = &(
-                        (recon_picture_ptr->buffer_cb)[recon_picture_ptr->origin_x / 2 +
-                                                       recon_picture_ptr->origin_y / 2 *
-                                                           recon_picture_ptr->stride_cb]);
-                    EbByte rec_ptr_cr = &(
-                        (recon_picture_ptr->buffer_cr)[recon_picture_ptr->origin_x / 2 +
-                                                       recon_picture_ptr->origin_y / 2 *
-                                                           recon_picture_ptr->stride_cr]);
-
-                    EbPictureBufferDesc *input_picture_ptr =
-                        (EbPictureBufferDesc *)pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr;
-                    EbByte enh_ptr    = &((
-                        input_picture_ptr
-                            ->buffer_y)[input_picture_ptr->origin_x +
-                                        input_picture_ptr->origin_y * input_picture_ptr->stride_y]);
-                    EbByte enh_ptr_cb = &(
-                        (input_picture_ptr->buffer_cb)[input_picture_ptr->origin_x / 2 +
-                                                       input_picture_ptr->origin_y / 2 *
-                                                           input_picture_ptr->stride_cb]);
-                    EbByte enh_ptr_cr = &(
-                        (input_picture_ptr->buffer_cr)[input_picture_ptr->origin_x / 2 +
-                                                       input_picture_ptr->origin_y / 2 *
-                                                           input_picture_ptr->stride_cr]);
-
-                    pcs_ptr->src[0] = (uint16_t *)rec_ptr;
-                    pcs_ptr->src[1] = (uint16_t *)rec_ptr_cb;
-                    pcs_ptr->src[2] = (uint16_t *)rec_ptr_cr;
-
-                    pcs_ptr->ref_coeff[0] = (uint16_t *)enh_ptr;
-                    pcs_ptr->ref_coeff[1] = (uint16_t *)enh_ptr_cb;
-                    pcs_ptr->ref_coeff[2] = (uint16_t *)enh_ptr_cr;
-                }
-            }
         }
 
-        pcs_ptr->cdef_segments_column_count = scs_ptr->cdef_segment_column_count;
-        pcs_ptr->cdef_segments_row_count    = scs_ptr->cdef_segment_row_count;
-        pcs_ptr->cdef_segments_total_count  = (uint16_t)(pcs_ptr->cdef_segments_column_count *
-                                                        pcs_ptr->cdef_segments_row_count);
-        pcs_ptr->tot_seg_searched_cdef      = 0;
-        uint32_t segment_index;
-
-        for (segment_index = 0; segment_index < pcs_ptr->cdef_segments_total_count;
-             ++segment_index) {
-            // Get Empty DLF Results to Cdef
+        if (pcs_ptr->cdef_search_wavefront) {
+            // Rows EncDec did not send yet, then an empty segment telling CDEF the picture is done
+            post_cdef_segments(context_ptr,
+                               enc_dec_results_ptr->pcs_wrapper_ptr,
+                               pcs_ptr,
+                               pcs_ptr->cdef_seg_rows_posted,
+                               pcs_ptr->cdef_segments_row_count);
             svt_get_empty_object(context_ptr->dlf_output_fifo_ptr, &dlf_results_wrapper_ptr);
             dlf_results_ptr = (struct DlfResults *)dlf_results_wrapper_ptr->object_ptr;
             dlf_results_ptr->pcs_wrapper_ptr = enc_dec_results_ptr->pcs_wrapper_ptr;
-            dlf_results_ptr->segment_index   = segment_index;
-            // Post DLF Results
+            dlf_results_ptr->segment_index   = pcs_ptr->cdef_segments_total_count;
+            dlf_results_ptr->cdef_segments   = FALSE;
             svt_post_full_object(dlf_results_wrapper_ptr);
+        } else {
+            cdef_search_init(pcs_ptr, scs_ptr);
+            post_cdef_segments(context_ptr,
+                               enc_dec_results_ptr->pcs_wrapper_ptr,
+                               pcs_ptr,
+                               0,
+                               pcs_ptr->cdef_segments_row_count);
         }
 
         // Release EncDec Results
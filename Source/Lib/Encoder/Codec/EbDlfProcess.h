@@ -16,6 +16,7 @@
 #include "EbObject.h"
 #include "EbPictureBufferDesc.h"
 #include "EbSvtAv1Formats.h"
+#include "EbPictureControlSet.h"
 
 /**************************************
  * Dlf Context
@@ -23,8 +24,23 @@
 typedef struct DlfContext {
     EbFifo *dlf_input_fifo_ptr;
     EbFifo *dlf_output_fifo_ptr;
+    EbFifo *dlf_feedback_fifo_ptr; // DLF segment helper tasks to the DLF threads
+    volatile int32_t *dlf_seg_task_count;
 } DlfContext;
 
+/**************************************
+ * DLF segments
+ *   A DLF segment is a band of SB rows. The passes over
+ *   the segments of a picture are run by the DLF threads
+ *   together, one pass at a time.
+ **************************************/
+typedef enum DlfSegmentPass {
+    DLF_SEG_SAVE_PASS, // copies the recon rows to the unfiltered recon
+    DLF_SEG_VERT_PASS, // filters the vertical edges
+    DLF_SEG_HORZ_PASS, // filters the horizontal edges
+    DLF_SEG_SSE_PASS // SSE of the filtered rows, then restores the unfiltered rows
+} DlfSegmentPass;
+
 /**************************************
  * Extern Function Declarations
  **************************************/
@@ -33,4 +49,9 @@ extern EbErrorType dlf_context_ctor(EbThreadContext   *thread_context_ptr,
 
 extern void *dlf_kernel(void *input_ptr);
 
+extern void cdef_search_init(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr);
+
+extern uint64_t dlf_run_segments(PictureControlSet *pcs_ptr, DlfSegmentPass pass,
+                                 int32_t plane_start, int32_t plane_end);
+
 #endif // EbEntropyCodingProcess_h
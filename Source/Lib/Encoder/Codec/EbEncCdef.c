@@ -252,6 +252,102 @@ uint64_t compute_cdef_dist_8bit_c(const uint8_t *dst8, int32_t dstride, const ui
     return sum >> 2 * coeff_shift;
 }
 
+static INLINE int32_t cdef_constrain(int32_t diff, int32_t threshold, int32_t damping) {
+    const int32_t shift = AOMMAX(0, damping - get_msb(threshold));
+    const int32_t v     = AOMMIN(abs(diff), AOMMAX(0, threshold - (abs(diff) >> shift)));
+    return diff < 0 ? -v : v;
+}
+
+/* The filter of a block sums the constrained differences of the primary taps and of the
+ * secondary taps, and clamps the result to the range of the taps. For the strength search
+ * the two sums are computed once for each primary and for each secondary strength:
+ * - range: the pixels, then the min and the max of their taps
+ * - pri_sums, sec_sums: the sums of the strengths, 64 values apart
+ * The rows filtered, one every subsampling_factor rows, are packed. */
+void svt_cdef_search_block_sums_c(const uint16_t *in, int32_t dir, int32_t bsize,
+                                  uint8_t subsampling_factor, const int32_t *pri_strengths,
+                                  int32_t num_pri, int32_t pri_damping,
+                                  const int32_t *sec_strengths, int32_t num_sec,
+                                  int32_t sec_damping, int32_t coeff_shift, int16_t *range,
+                                  int16_t *pri_sums, int16_t *sec_sums) {
+    const int32_t w = 4 << (int32_t)(bsize == BLOCK_8X8 || bsize == BLOCK_8X4);
+    const int32_t h = 4 << (int32_t)(bsize == BLOCK_8X8 || bsize == BLOCK_4X8);
+    const int32_t pri_dir[2] = {eb_cdef_directions[dir][0], eb_cdef_directions[dir][1]};
+    const int32_t sec_dir[2][2] = {
+        {eb_cdef_directions[(dir + 2) & 7][0], eb_cdef_directions[(dir + 6) & 7][0]},
+        {eb_cdef_directions[(dir + 2) & 7][1], eb_cdef_directions[(dir + 6) & 7][1]}};
+    int32_t n = 0;
+
+    for (int32_t i = 0; i < h; i += subsampling_factor) {
+        for (int32_t j = 0; j < w; j++, n++) {
+            const uint16_t *p   = &in[i * CDEF_BSTRIDE + j];
+            const int32_t   x   = p[0];
+            int32_t         max = x;
+            int32_t         min = x;
+            int32_t         taps[12];
+            for (int32_t k = 0; k < 2; k++) {
+                taps[2 * k]     = p[pri_dir[k]];
+                taps[2 * k + 1] = p[-pri_dir[k]];
+                taps[4 + 4 * k] = p[sec_dir[k][0]];
+                taps[5 + 4 * k] = p[-sec_dir[k][0]];
+                taps[6 + 4 * k] = p[sec_dir[k][1]];
+                taps[7 + 4 * k] = p[-sec_dir[k][1]];
+            }
+            for (int32_t t = 0; t < 12; t++) {
+                if (taps[t] != CDEF_VERY_LARGE)
+                    max = AOMMAX(taps[t], max);
+                min = AOMMIN(taps[t], min);
+            }
+            range[n]       = (int16_t)x;
+            range[64 + n]  = (int16_t)min;
+            range[128 + n] = (int16_t)max;
+
+            for (int32_t s = 0; s < num_pri; s++) {
+                const int32_t  strength = pri_strengths[s];
+                const int32_t *pri_taps = eb_cdef_pri_taps[(strength >> coeff_shift) & 1];
+                int16_t        sum      = 0;
+                for (int32_t k = 0; strength && k < 2; k++)
+                    for (int32_t t = 2 * k; t < 2 * k + 2; t++)
+                        sum += (int16_t)(pri_taps[k] *
+                                         cdef_constrain(taps[t] - x, strength, pri_damping));
+                pri_sums[s * 64 + n] = sum;
+            }
+            for (int32_t s = 0; s < num_sec; s++) {
+                const int32_t strength = sec_strengths[s];
+                int16_t       sum      = 0;
+                for (int32_t k = 0; strength && k < 2; k++)
+                    for (int32_t t = 4 + 4 * k; t < 8 + 4 * k; t++)
+                        sum += (int16_t)(eb_cdef_sec_taps[0][k] *
+                                         cdef_constrain(taps[t] - x, strength, sec_damping));
+                sec_sums[s * 64 + n] = sum;
+            }
+        }
+    }
+}
+
+/* Filters a block from the sums of a strength pair of svt_cdef_search_block_sums(), a NULL sum
+ * standing for a strength 0. The output is the one of svt_cdef_filter_block() to a packed
+ * block. */
+void svt_cdef_search_block_combine_c(const int16_t *range, const int16_t *pri_sum,
+                                     const int16_t *sec_sum, int32_t bsize,
+                                     uint8_t subsampling_factor, uint8_t *dst8, uint16_t *dst16) {
+    const int32_t w = 4 << (int32_t)(bsize == BLOCK_8X8 || bsize == BLOCK_8X4);
+    const int32_t h = 4 << (int32_t)(bsize == BLOCK_8X8 || bsize == BLOCK_4X8);
+    int32_t       n = 0;
+
+    for (int32_t i = 0; i < h; i += subsampling_factor) {
+        for (int32_t j = 0; j < w; j++, n++) {
+            const int16_t sum = (int16_t)((pri_sum ? pri_sum[n] : 0) + (sec_sum ? sec_sum[n] : 0));
+            const int16_t y   = (int16_t)clamp(
+                range[n] + ((8 + sum - (sum < 0)) >> 4), range[64 + n], range[128 + n]);
+            if (dst8)
+                dst8[i * w + j] = (uint8_t)y;
+            else
+                dst16[i * w + j] = (uint16_t)y;
+        }
+    }
+}
+
 int32_t svt_sb_all_skip(PictureControlSet *pcs_ptr, const Av1Common *const cm, int32_t mi_row,
                         int32_t mi_col) {
     int32_t maxc, maxr;
@@ -315,13 +411,69 @@ int32_t svt_sb_compute_cdef_list(PictureControlSet *pcs_ptr, const Av1Common *co
 }
 
 /*
-Loop over all 64x64 filter blocks and perform the CDEF filtering for each block, using
-the filter strength pairs chosen in finish_cdef_search().
+Save the CDEF input lines around the top edge of each 64x64 filter block row, CDEF_VBORDER
+lines above the edge then CDEF_VBORDER lines below it, before any filter block row is
+filtered. The buffers are freed by svt_av1_cdef_free_boundary_lines().
 */
-void svt_av1_cdef_frame(EncDecContext *context_ptr, SequenceControlSet *scs_ptr,
-                        PictureControlSet *pCs) {
-    (void)context_ptr;
+void svt_av1_cdef_save_boundary_lines(SequenceControlSet *scs_ptr, PictureControlSet *pCs,
+                                      Bool is_16bit) {
+    Av1Common           *cm = pCs->parent_pcs_ptr->av1_cm;
+    EbPictureBufferDesc *recon_picture_ptr;
+    get_recon_pic(pCs, &recon_picture_ptr, is_16bit);
+
+    const int32_t num_planes = av1_num_planes(&scs_ptr->seq_header.color_config);
+    const int32_t nvfb       = (cm->mi_rows + MI_SIZE_64X64 - 1) / MI_SIZE_64X64;
+    const int32_t stride     = cm->mi_cols << MI_SIZE_LOG2;
+    pCs->cdef_linebuf_stride = stride;
+    for (int32_t pli = 0; pli < num_planes; pli++) {
+        // as in the filtering, the chroma planes are subsampled
+        const int32_t ss_x       = pli ? 1 : 0;
+        const int32_t ss_y       = pli ? 1 : 0;
+        const int32_t rec_stride = pli == 0 ? recon_picture_ptr->stride_y
+            : pli == 1                      ? recon_picture_ptr->stride_cb
+                                            : recon_picture_ptr->stride_cr;
+        const EbByte  buffer     = pli == 0 ? recon_picture_ptr->buffer_y
+             : pli == 1                     ? recon_picture_ptr->buffer_cb
+                                            : recon_picture_ptr->buffer_cr;
+        const int32_t offset     = (recon_picture_ptr->origin_x >> ss_x) +
+            (recon_picture_ptr->origin_y >> ss_y) * rec_stride;
+        pCs->cdef_linebuf[pli] = (uint16_t *)svt_aom_malloc(
+            sizeof(*pCs->cdef_linebuf[pli]) * nvfb * 2 * CDEF_VBORDER * stride);
+        for (int32_t fbr = 1; fbr < nvfb; fbr++) {
+            uint16_t     *dst = pCs->cdef_linebuf[pli] + fbr * 2 * CDEF_VBORDER * stride;
+            const int32_t row = ((MI_SIZE_64X64 << MI_SIZE_LOG2) >> ss_y) * fbr - CDEF_VBORDER;
+            const int32_t width = (cm->mi_cols << MI_SIZE_LOG2) >> ss_x;
+            if (is_16bit)
+                copy_sb16_16(dst,
+                             stride,
+                             (uint16_t *)buffer + offset,
+                             row,
+                             0,
+                             rec_stride,
+                             2 * CDEF_VBORDER,
+                             width);
+            else
+                copy_sb8_16(
+                    dst, stride, buffer + offset, row, 0, rec_stride, 2 * CDEF_VBORDER, width);
+        }
+    }
+}
 
+void svt_av1_cdef_free_boundary_lines(SequenceControlSet *scs_ptr, PictureControlSet *pCs) {
+    const int32_t num_planes = av1_num_planes(&scs_ptr->seq_header.color_config);
+    for (int32_t pli = 0; pli < num_planes; pli++) {
+        svt_aom_free(pCs->cdef_linebuf[pli]);
+        pCs->cdef_linebuf[pli] = NULL;
+    }
+}
+
+/*
+Perform the CDEF filtering of the 64x64 filter blocks of the filter block row fbr, using
+the filter strength pairs chosen in finish_cdef_search(). The rows above and below the
+filter block row are read from the lines saved by svt_av1_cdef_save_boundary_lines(), so
+the filter block rows can be filtered in any order.
+*/
+void svt_av1_cdef_fb_row(SequenceControlSet *scs_ptr, PictureControlSet *pCs, int32_t fbr) {
     struct PictureParentControlSet *ppcs    = pCs->parent_pcs_ptr;
     Av1Common                      *cm      = ppcs->av1_cm;
     FrameHeader                    *frm_hdr = &ppcs->frm_hdr;
@@ -341,10 +493,8 @@ void svt_av1_cdef_frame(EncDecContext *context_ptr, SequenceControlSet *scs_ptr,
 
     const int32_t num_planes = av1_num_planes(&scs_ptr->seq_header.color_config);
     DECLARE_ALIGNED(16, uint16_t, src[CDEF_INBUF_SIZE]);
-    uint16_t      *linebuf[3];
     uint16_t      *colbuf[3];
     CdefList       dlist[MI_SIZE_64X64 * MI_SIZE_64X64];
-    uint8_t       *row_cdef, *prev_row_cdef, *curr_row_cdef;
     int32_t        cdef_count;
     const uint32_t sb_size = scs_ptr->super_block_size;
     int32_t        mi_wide_l2[3];
@@ -354,12 +504,6 @@ void svt_av1_cdef_frame(EncDecContext *context_ptr, SequenceControlSet *scs_ptr,
     int32_t coeff_shift = AOMMAX(scs_ptr->static_config.encoder_bit_depth /*cm->bit_depth*/ - 8, 0);
     const int32_t nvfb  = (cm->mi_rows + MI_SIZE_64X64 - 1) / MI_SIZE_64X64;
     const int32_t nhfb  = (cm->mi_cols + MI_SIZE_64X64 - 1) / MI_SIZE_64X64;
-    //svt_av1_setup_dst_planes(xd->plane, cm->seq_params.sb_size, frame, 0, 0, 0, num_planes);
-    row_cdef = (uint8_t *)svt_aom_malloc(sizeof(*row_cdef) * (nhfb + 2) * 2);
-    assert(row_cdef != NULL);
-    memset(row_cdef, 1, sizeof(*row_cdef) * (nhfb + 2) * 2);
-    prev_row_cdef = row_cdef + 1;
-    curr_row_cdef = prev_row_cdef + nhfb + 2;
     for (int32_t pli = 0; pli < num_planes; pli++) {
         int32_t subsampling_x = (pli == 0) ? 0 : 1;
         int32_t subsampling_y = (pli == 0) ? 0 : 1;
@@ -370,314 +514,277 @@ void svt_av1_cdef_frame(EncDecContext *context_ptr, SequenceControlSet *scs_ptr,
         mi_high_l2[pli] = MI_SIZE_LOG2 - subsampling_y; //CHKN xd->plane[pli].subsampling_y;
     }
 
-    const int32_t stride = (cm->mi_cols << MI_SIZE_LOG2) + 2 * CDEF_HBORDER;
+    const int32_t stride = pCs->cdef_linebuf_stride;
+    uint16_t     *linebuf_above[3];
+    uint16_t     *linebuf_below[3];
     for (int32_t pli = 0; pli < num_planes; pli++) {
-        linebuf[pli] = (uint16_t *)svt_aom_malloc(sizeof(*linebuf) * CDEF_VBORDER * stride);
-        colbuf[pli]  = (uint16_t *)svt_aom_malloc(
+        // the lines saved at the top edges of this filter block row and of the next one
+        linebuf_above[pli] = pCs->cdef_linebuf[pli] + fbr * 2 * CDEF_VBORDER * stride;
+        linebuf_below[pli] = linebuf_above[pli] + 3 * CDEF_VBORDER * stride;
+        colbuf[pli]        = (uint16_t *)svt_aom_malloc(
             sizeof(*colbuf) * ((CDEF_BLOCKSIZE << mi_high_l2[pli]) + 2 * CDEF_VBORDER) *
             CDEF_HBORDER);
     }
 
-    for (int32_t fbr = 0; fbr < nvfb; fbr++) {
-        int32_t cdef_left = 1;
-        for (int32_t fbc = 0; fbc < nhfb; fbc++) {
-            int32_t level, sec_strength;
-            int32_t uv_level, uv_sec_strength;
-            int32_t nhb, nvb;
-            int32_t cstart     = 0;
-            curr_row_cdef[fbc] = 0;
-            assert(pCs->mi_grid_base[MI_SIZE_64X64 * fbr * cm->mi_stride + MI_SIZE_64X64 * fbc] !=
-                       NULL &&
-                   "CDEF ERROR: Skipping Current FB");
-            assert(pCs->mi_grid_base[MI_SIZE_64X64 * fbr * cm->mi_stride + MI_SIZE_64X64 * fbc]
-                           ->mbmi.cdef_strength != -1 &&
-                   "CDEF ERROR: Skipping Current FB");
-            if (!cdef_left)
-                cstart =
-                    -CDEF_HBORDER; //CHKN if the left block has not been filtered, then we can use samples on the left as input.
-
-            nhb = AOMMIN(MI_SIZE_64X64, cm->mi_cols - MI_SIZE_64X64 * fbc);
-            nvb = AOMMIN(MI_SIZE_64X64, cm->mi_rows - MI_SIZE_64X64 * fbr);
-            int32_t frame_top, frame_left, frame_bottom, frame_right;
-
-            int32_t mi_row = MI_SIZE_64X64 * fbr;
-            int32_t mi_col = MI_SIZE_64X64 * fbc;
-            // for the current filter block, it's top left corner mi structure (mi_tl)
-            // is first accessed to check whether the top and left boundaries are
-            // frame boundaries. Then bottom-left and top-right mi structures are
-            // accessed to check whether the bottom and right boundaries
-            // (respectively) are frame boundaries.
-            //
-            // Note that we can't just check the bottom-right mi structure - eg. if
-            // we're at the right-hand edge of the frame but not the bottom, then
-            // the bottom-right mi is NULL but the bottom-left is not.
-            frame_top  = (mi_row == 0) ? 1 : 0;
-            frame_left = (mi_col == 0) ? 1 : 0;
-
-            if (fbr != nvfb - 1)
-                frame_bottom = (mi_row + MI_SIZE_64X64 == cm->mi_rows) ? 1 : 0;
+    int32_t cdef_left = 1;
+    for (int32_t fbc = 0; fbc < nhfb; fbc++) {
+        int32_t level, sec_strength;
+        int32_t uv_level, uv_sec_strength;
+        int32_t nhb, nvb;
+        int32_t cstart = 0;
+        assert(pCs->mi_grid_base[MI_SIZE_64X64 * fbr * cm->mi_stride + MI_SIZE_64X64 * fbc] !=
+                   NULL &&
+               "CDEF ERROR: Skipping Current FB");
+        assert(pCs->mi_grid_base[MI_SIZE_64X64 * fbr * cm->mi_stride + MI_SIZE_64X64 * fbc]
+                       ->mbmi.cdef_strength != -1 &&
+               "CDEF ERROR: Skipping Current FB");
+        if (!cdef_left)
+            cstart =
+                -CDEF_HBORDER; //CHKN if the left block has not been filtered, then we can use samples on the left as input.
+
+        nhb = AOMMIN(MI_SIZE_64X64, cm->mi_cols - MI_SIZE_64X64 * fbc);
+        nvb = AOMMIN(MI_SIZE_64X64, cm->mi_rows - MI_SIZE_64X64 * fbr);
+        int32_t frame_top, frame_left, frame_bottom, frame_right;
+
+        int32_t mi_row = MI_SIZE_64X64 * fbr;
+        int32_t mi_col = MI_SIZE_64X64 * fbc;
+        // for the current filter block, it's top left corner mi structure (mi_tl)
+        // is first accessed to check whether the top and left boundaries are
+        // frame boundaries. Then bottom-left and top-right mi structures are
+        // accessed to check whether the bottom and right boundaries
+        // (respectively) are frame boundaries.
+        //
+        // Note that we can't just check the bottom-right mi structure - eg. if
+        // we're at the right-hand edge of the frame but not the bottom, then
+        // the bottom-right mi is NULL but the bottom-left is not.
+        frame_top  = (mi_row == 0) ? 1 : 0;
+        frame_left = (mi_col == 0) ? 1 : 0;
+
+        if (fbr != nvfb - 1)
+            frame_bottom = (mi_row + MI_SIZE_64X64 == cm->mi_rows) ? 1 : 0;
+        else
+            frame_bottom = 1;
+
+        if (fbc != nhfb - 1)
+            frame_right = (mi_col + MI_SIZE_64X64 == cm->mi_cols) ? 1 : 0;
+        else
+            frame_right = 1;
+
+        // Find the index of the CDEF strength for the filter block
+        const int32_t mbmi_cdef_strength =
+            pCs->mi_grid_base[MI_SIZE_64X64 * fbr * cm->mi_stride + MI_SIZE_64X64 * fbc]
+                ->mbmi.cdef_strength;
+        level = frm_hdr->cdef_params.cdef_y_strength[mbmi_cdef_strength] / CDEF_SEC_STRENGTHS;
+        sec_strength = frm_hdr->cdef_params.cdef_y_strength[mbmi_cdef_strength] %
+            CDEF_SEC_STRENGTHS;
+        // Secondary luma strength takes values in {0, 1, 2, 4}. If sec_strength is equal to 3 from the step above, change it to 4.
+        sec_strength += sec_strength == 3;
+        // Set primary and secondary chroma strengths.
+        uv_level = frm_hdr->cdef_params.cdef_uv_strength[mbmi_cdef_strength] /
+            CDEF_SEC_STRENGTHS;
+        uv_sec_strength = frm_hdr->cdef_params.cdef_uv_strength[mbmi_cdef_strength] %
+            CDEF_SEC_STRENGTHS;
+        // Secondary chroma strength takes values in {0, 1, 2, 4}. If sec_strength is equal to 3 from the step above, change it to 4.
+        uv_sec_strength += uv_sec_strength == 3;
+        if ((level == 0 && sec_strength == 0 && uv_level == 0 && uv_sec_strength == 0) ||
+            (cdef_count = svt_sb_compute_cdef_list(
+                 pCs, cm, fbr * MI_SIZE_64X64, fbc * MI_SIZE_64X64, dlist, BLOCK_64X64)) == 0) {
+            cdef_left = 0;
+            continue;
+        }
+
+        int dirinit = !(ppcs->cdef_ctrls.use_reference_cdef_fs);
+        // When SB 128 is used, the search for certain blocks is skipped, so dir/var info is not generated
+        // In those cases, must generate info here
+        if (sb_size == 128) {
+            const uint32_t    lc      = MI_SIZE_64X64 * fbc;
+            const uint32_t    lr      = MI_SIZE_64X64 * fbr;
+            ModeInfo        **mi      = pCs->mi_grid_base + lr * cm->mi_stride + lc;
+            const MbModeInfo *mbmi    = &mi[0]->mbmi;
+            const BlockSize   sb_type = mbmi->block_mi.sb_type;
+            if (((fbc & 1) && (sb_type == BLOCK_128X128 || sb_type == BLOCK_128X64)) ||
+                ((fbr & 1) && (sb_type == BLOCK_128X128 || sb_type == BLOCK_64X128)))
+                dirinit = 0;
+        }
+        uint8_t(*dir)[CDEF_NBLOCKS][CDEF_NBLOCKS] = &pCs->cdef_dir_data[fbr * nhfb + fbc].dir;
+        int32_t(*var)[CDEF_NBLOCKS][CDEF_NBLOCKS] = &pCs->cdef_dir_data[fbr * nhfb + fbc].var;
+        for (int32_t pli = 0; pli < num_planes; pli++) {
+            int32_t coffset;
+            int32_t rend, cend;
+            int32_t pri_damping = frm_hdr->cdef_params.cdef_damping;
+            int32_t sec_damping = pri_damping;
+            int32_t hsize       = nhb << mi_wide_l2[pli];
+            int32_t vsize       = nvb << mi_high_l2[pli];
+            if (fbc == nhfb - 1)
+                cend = hsize;
             else
-                frame_bottom = 1;
+                cend = hsize + CDEF_HBORDER;
 
-            if (fbc != nhfb - 1)
-                frame_right = (mi_col + MI_SIZE_64X64 == cm->mi_cols) ? 1 : 0;
+            if (fbr == nvfb - 1)
+                rend = vsize;
             else
-                frame_right = 1;
-
-            // Find the index of the CDEF strength for the filter block
-            const int32_t mbmi_cdef_strength =
-                pCs->mi_grid_base[MI_SIZE_64X64 * fbr * cm->mi_stride + MI_SIZE_64X64 * fbc]
-                    ->mbmi.cdef_strength;
-            level = frm_hdr->cdef_params.cdef_y_strength[mbmi_cdef_strength] / CDEF_SEC_STRENGTHS;
-            sec_strength = frm_hdr->cdef_params.cdef_y_strength[mbmi_cdef_strength] %
-                CDEF_SEC_STRENGTHS;
-            // Secondary luma strength takes values in {0, 1, 2, 4}. If sec_strength is equal to 3 from the step above, change it to 4.
-            sec_strength += sec_strength == 3;
-            // Set primary and secondary chroma strengths.
-            uv_level = frm_hdr->cdef_params.cdef_uv_strength[mbmi_cdef_strength] /
-                CDEF_SEC_STRENGTHS;
-            uv_sec_strength = frm_hdr->cdef_params.cdef_uv_strength[mbmi_cdef_strength] %
-                CDEF_SEC_STRENGTHS;
-            // Secondary chroma strength takes values in {0, 1, 2, 4}. If sec_strength is equal to 3 from the step above, change it to 4.
-            uv_sec_strength += uv_sec_strength == 3;
-            if ((level == 0 && sec_strength == 0 && uv_level == 0 && uv_sec_strength == 0) ||
-                (cdef_count = svt_sb_compute_cdef_list(
-                     pCs, cm, fbr * MI_SIZE_64X64, fbc * MI_SIZE_64X64, dlist, BLOCK_64X64)) == 0) {
-                cdef_left = 0;
-                continue;
-            }
+                rend = vsize + CDEF_VBORDER;
 
-            int dirinit = !(ppcs->cdef_ctrls.use_reference_cdef_fs);
-            // When SB 128 is used, the search for certain blocks is skipped, so dir/var info is not generated
-            // In those cases, must generate info here
-            if (sb_size == 128) {
-                const uint32_t    lc      = MI_SIZE_64X64 * fbc;
-                const uint32_t    lr      = MI_SIZE_64X64 * fbr;
-                ModeInfo        **mi      = pCs->mi_grid_base + lr * cm->mi_stride + lc;
-                const MbModeInfo *mbmi    = &mi[0]->mbmi;
-                const BlockSize   sb_type = mbmi->block_mi.sb_type;
-                if (((fbc & 1) && (sb_type == BLOCK_128X128 || sb_type == BLOCK_128X64)) ||
-                    ((fbr & 1) && (sb_type == BLOCK_128X128 || sb_type == BLOCK_64X128)))
-                    dirinit = 0;
+            coffset             = fbc * MI_SIZE_64X64 << mi_wide_l2[pli];
+            uint8_t *rec_buff   = 0;
+            uint32_t rec_stride = 0;
+
+            switch (pli) {
+            case 0:
+                rec_buff   = recon_buffer_y;
+                rec_stride = recon_picture_ptr->stride_y;
+                break;
+            case 1:
+                rec_buff     = recon_buffer_cb;
+                rec_stride   = recon_picture_ptr->stride_cb;
+                level        = uv_level;
+                sec_strength = uv_sec_strength;
+                break;
+            case 2:
+                rec_buff     = recon_buffer_cr;
+                rec_stride   = recon_picture_ptr->stride_cr;
+                level        = uv_level;
+                sec_strength = uv_sec_strength;
+                break;
             }
-            uint8_t(*dir)[CDEF_NBLOCKS][CDEF_NBLOCKS] = &pCs->cdef_dir_data[fbr * nhfb + fbc].dir;
-            int32_t(*var)[CDEF_NBLOCKS][CDEF_NBLOCKS] = &pCs->cdef_dir_data[fbr * nhfb + fbc].var;
-            curr_row_cdef[fbc]                        = 1;
-            for (int32_t pli = 0; pli < num_planes; pli++) {
-                int32_t coffset;
-                int32_t rend, cend;
-                int32_t pri_damping = frm_hdr->cdef_params.cdef_damping;
-                int32_t sec_damping = pri_damping;
-                int32_t hsize       = nhb << mi_wide_l2[pli];
-                int32_t vsize       = nvb << mi_high_l2[pli];
-                if (fbc == nhfb - 1)
-                    cend = hsize;
-                else
-                    cend = hsize + CDEF_HBORDER;
-
-                if (fbr == nvfb - 1)
-                    rend = vsize;
-                else
-                    rend = vsize + CDEF_VBORDER;
-
-                coffset             = fbc * MI_SIZE_64X64 << mi_wide_l2[pli];
-                uint8_t *rec_buff   = 0;
-                uint32_t rec_stride = 0;
-
-                switch (pli) {
-                case 0:
-                    rec_buff   = recon_buffer_y;
-                    rec_stride = recon_picture_ptr->stride_y;
-                    break;
-                case 1:
-                    rec_buff     = recon_buffer_cb;
-                    rec_stride   = recon_picture_ptr->stride_cb;
-                    level        = uv_level;
-                    sec_strength = uv_sec_strength;
-                    break;
-                case 2:
-                    rec_buff     = recon_buffer_cr;
-                    rec_stride   = recon_picture_ptr->stride_cr;
-                    level        = uv_level;
-                    sec_strength = uv_sec_strength;
-                    break;
-                }
 
-                /* Copy in the pixels we need from the current superblock for
-                   deringing.*/
-                copy_sb8_16(&src[CDEF_VBORDER * CDEF_BSTRIDE + CDEF_HBORDER + cstart],
-                            CDEF_BSTRIDE,
-                            rec_buff,
-                            (MI_SIZE_64X64 << mi_high_l2[pli]) * fbr,
-                            coffset + cstart,
-                            rec_stride,
-                            rend,
-                            cend - cstart);
-                if (!prev_row_cdef[fbc]) {
-                    copy_sb8_16(&src[CDEF_HBORDER],
-                                CDEF_BSTRIDE,
-                                rec_buff,
-                                (MI_SIZE_64X64 << mi_high_l2[pli]) * fbr - CDEF_VBORDER,
-                                coffset,
-                                rec_stride,
-                                CDEF_VBORDER,
-                                hsize);
-                } else if (fbr > 0) {
-                    copy_rect(&src[CDEF_HBORDER],
-                              CDEF_BSTRIDE,
-                              &linebuf[pli][coffset],
-                              stride,
-                              CDEF_VBORDER,
-                              hsize);
-                } else {
-                    fill_rect(
-                        &src[CDEF_HBORDER], CDEF_BSTRIDE, CDEF_VBORDER, hsize, CDEF_VERY_LARGE);
-                }
+            /* Copy in the pixels we need from the current superblock for
+               deringing.*/
+            copy_sb8_16(&src[CDEF_VBORDER * CDEF_BSTRIDE + CDEF_HBORDER + cstart],
+                        CDEF_BSTRIDE,
+                        rec_buff,
+                        (MI_SIZE_64X64 << mi_high_l2[pli]) * fbr,
+                        coffset + cstart,
+                        rec_stride,
+                        vsize,
+                        cend - cstart);
+            if (fbr < nvfb - 1)
+                copy_rect(&src[(vsize + CDEF_VBORDER) * CDEF_BSTRIDE + CDEF_HBORDER + cstart],
+                          CDEF_BSTRIDE,
+                          &linebuf_below[pli][coffset + cstart],
+                          stride,
+                          CDEF_VBORDER,
+                          cend - cstart);
+            if (fbr > 0) {
+                copy_rect(&src[CDEF_HBORDER],
+                          CDEF_BSTRIDE,
+                          &linebuf_above[pli][coffset],
+                          stride,
+                          CDEF_VBORDER,
+                          hsize);
+            } else {
+                fill_rect(&src[CDEF_HBORDER], CDEF_BSTRIDE, CDEF_VBORDER, hsize, CDEF_VERY_LARGE);
+            }
 
-                if (!prev_row_cdef[fbc - 1]) {
-                    copy_sb8_16(src,
-                                CDEF_BSTRIDE,
-                                rec_buff,
-                                (MI_SIZE_64X64 << mi_high_l2[pli]) * fbr - CDEF_VBORDER,
-                                coffset - CDEF_HBORDER,
-                                rec_stride,
-                                CDEF_VBORDER,
-                                CDEF_HBORDER);
-                } else if (fbr > 0 && fbc > 0) {
-                    copy_rect(src,
-                              CDEF_BSTRIDE,
-                              &linebuf[pli][coffset - CDEF_HBORDER],
-                              stride,
-                              CDEF_VBORDER,
-                              CDEF_HBORDER);
-                } else {
-                    fill_rect(src, CDEF_BSTRIDE, CDEF_VBORDER, CDEF_HBORDER, CDEF_VERY_LARGE);
-                }
+            if (fbr > 0 && fbc > 0) {
+                copy_rect(src,
+                          CDEF_BSTRIDE,
+                          &linebuf_above[pli][coffset - CDEF_HBORDER],
+                          stride,
+                          CDEF_VBORDER,
+                          CDEF_HBORDER);
+            } else {
+                fill_rect(src, CDEF_BSTRIDE, CDEF_VBORDER, CDEF_HBORDER, CDEF_VERY_LARGE);
+            }
 
-                if (!prev_row_cdef[fbc + 1]) {
-                    copy_sb8_16(&src[CDEF_HBORDER + (nhb << mi_wide_l2[pli])],
-                                CDEF_BSTRIDE,
-                                rec_buff,
-                                (MI_SIZE_64X64 << mi_high_l2[pli]) * fbr - CDEF_VBORDER,
-                                coffset + hsize,
-                                rec_stride,
-                                CDEF_VBORDER,
-                                CDEF_HBORDER);
-                } else if (fbr > 0 && fbc < nhfb - 1) {
-                    copy_rect(&src[hsize + CDEF_HBORDER],
-                              CDEF_BSTRIDE,
-                              &linebuf[pli][coffset + hsize],
-                              stride,
-                              CDEF_VBORDER,
-                              CDEF_HBORDER);
-                } else {
-                    fill_rect(&src[hsize + CDEF_HBORDER],
-                              CDEF_BSTRIDE,
-                              CDEF_VBORDER,
-                              CDEF_HBORDER,
-                              CDEF_VERY_LARGE);
-                }
+            if (fbr > 0 && fbc < nhfb - 1) {
+                copy_rect(&src[hsize + CDEF_HBORDER],
+                          CDEF_BSTRIDE,
+                          &linebuf_above[pli][coffset + hsize],
+                          stride,
+                          CDEF_VBORDER,
+                          CDEF_HBORDER);
+            } else {
+                fill_rect(&src[hsize + CDEF_HBORDER],
+                          CDEF_BSTRIDE,
+                          CDEF_VBORDER,
+                          CDEF_HBORDER,
+                          CDEF_VERY_LARGE);
+            }
 
-                if (cdef_left) {
-                    /* If we deringed the superblock on the left then we need to copy in
-                       saved pixels. */
-                    copy_rect(src,
-                              CDEF_BSTRIDE,
-                              colbuf[pli],
-                              CDEF_HBORDER,
-                              rend + CDEF_VBORDER,
-                              CDEF_HBORDER);
-                }
+            if (cdef_left) {
+                /* If we deringed the superblock on the left then we need to copy in
+                   saved pixels. */
+                copy_rect(src,
+                          CDEF_BSTRIDE,
+                          colbuf[pli],
+                          CDEF_HBORDER,
+                          rend + CDEF_VBORDER,
+                          CDEF_HBORDER);
+            }
 
-                /* Saving pixels in case we need to dering the superblock on the
-                    right. */
-                if (fbc < nhfb - 1)
-                    copy_rect(colbuf[pli],
-                              CDEF_HBORDER,
-                              src + hsize,
-                              CDEF_BSTRIDE,
-                              rend + CDEF_VBORDER,
-                              CDEF_HBORDER);
-
-                if (fbr < nvfb - 1)
-                    copy_sb8_16(&linebuf[pli][coffset],
-                                stride,
-                                rec_buff,
-                                (MI_SIZE_64X64 << mi_high_l2[pli]) * (fbr + 1) - CDEF_VBORDER,
-                                coffset,
-                                rec_stride,
-                                CDEF_VBORDER,
-                                hsize);
-
-                if (frame_top) {
-                    fill_rect(
-                        src, CDEF_BSTRIDE, CDEF_VBORDER, hsize + 2 * CDEF_HBORDER, CDEF_VERY_LARGE);
-                }
-                if (frame_left) {
-                    fill_rect(
-                        src, CDEF_BSTRIDE, vsize + 2 * CDEF_VBORDER, CDEF_HBORDER, CDEF_VERY_LARGE);
-                }
-                if (frame_bottom) {
-                    fill_rect(&src[(vsize + CDEF_VBORDER) * CDEF_BSTRIDE],
-                              CDEF_BSTRIDE,
-                              CDEF_VBORDER,
-                              hsize + 2 * CDEF_HBORDER,
-                              CDEF_VERY_LARGE);
-                }
-                if (frame_right) {
-                    fill_rect(&src[hsize + CDEF_HBORDER],
-                              CDEF_BSTRIDE,
-                              vsize + 2 * CDEF_VBORDER,
-                              CDEF_HBORDER,
-                              CDEF_VERY_LARGE);
-                }
-                // if ppcs->cdef_ctrls.use_reference_cdef_fs is true, then search was not performed
-                // Therefore, need to make sure dir and var are initialized
-                if (level || sec_strength || !dirinit) {
-                    svt_cdef_filter_fb(
-                        &rec_buff[rec_stride * (MI_SIZE_64X64 * fbr << mi_high_l2[pli]) +
-                                  (fbc * MI_SIZE_64X64 << mi_wide_l2[pli])],
-                        NULL,
-                        rec_stride,
-                        &src[CDEF_VBORDER * CDEF_BSTRIDE + CDEF_HBORDER],
-                        xdec[pli],
-                        ydec[pli],
-                        *dir,
-                        &dirinit,
-                        *var,
-                        pli,
-                        dlist,
-                        cdef_count,
-                        level,
-                        sec_strength,
-                        pri_damping,
-                        sec_damping,
-                        coeff_shift,
-                        1); // no subsampling
-                }
+            /* Saving pixels in case we need to dering the superblock on the
+                right. */
+            if (fbc < nhfb - 1)
+                copy_rect(colbuf[pli],
+                          CDEF_HBORDER,
+                          src + hsize,
+                          CDEF_BSTRIDE,
+                          rend + CDEF_VBORDER,
+                          CDEF_HBORDER);
+
+
+            if (frame_top) {
+                fill_rect(
+                    src, CDEF_BSTRIDE, CDEF_VBORDER, hsize + 2 * CDEF_HBORDER, CDEF_VERY_LARGE);
+            }
+            if (frame_left) {
+                fill_rect(
+                    src, CDEF_BSTRIDE, vsize + 2 * CDEF_VBORDER, CDEF_HBORDER, CDEF_VERY_LARGE);
+            }
+            if (frame_bottom) {
+                fill_rect(&src[(vsize + CDEF_VBORDER) * CDEF_BSTRIDE],
+                          CDEF_BSTRIDE,
+                          CDEF_VBORDER,
+                          hsize + 2 * CDEF_HBORDER,
+                          CDEF_VERY_LARGE);
+            }
+            if (frame_right) {
+                fill_rect(&src[hsize + CDEF_HBORDER],
+                          CDEF_BSTRIDE,
+                          vsize + 2 * CDEF_VBORDER,
+                          CDEF_HBORDER,
+                          CDEF_VERY_LARGE);
+            }
+            // if ppcs->cdef_ctrls.use_reference_cdef_fs is true, then search was not performed
+            // Therefore, need to make sure dir and var are initialized
+            if (level || sec_strength || !dirinit) {
+                svt_cdef_filter_fb(
+                    &rec_buff[rec_stride * (MI_SIZE_64X64 * fbr << mi_high_l2[pli]) +
+                              (fbc * MI_SIZE_64X64 << mi_wide_l2[pli])],
+                    NULL,
+                    rec_stride,
+                    &src[CDEF_VBORDER * CDEF_BSTRIDE + CDEF_HBORDER],
+                    xdec[pli],
+                    ydec[pli],
+                    *dir,
+                    &dirinit,
+                    *var,
+                    pli,
+                    dlist,
+                    cdef_count,
+                    level,
+                    sec_strength,
+                    pri_damping,
+                    sec_damping,
+                    coeff_shift,
+                    1); // no subsampling
             }
-            cdef_left = 1; //CHKN filtered data is written back directy to recFrame.
-        }
-        {
-            uint8_t *tmp  = prev_row_cdef;
-            prev_row_cdef = curr_row_cdef;
-            curr_row_cdef = tmp;
         }
+        cdef_left = 1; //CHKN filtered data is written back directy to recFrame.
     }
-    svt_aom_free(row_cdef);
     for (int32_t pli = 0; pli < num_planes; pli++) {
-        svt_aom_free(linebuf[pli]);
         svt_aom_free(colbuf[pli]);
     }
 }
 
 /*
-Loop over all 64x64 filter blocks and perform the CDEF filtering for each block, using
-the filter strength pairs chosen in finish_cdef_search().
+Perform the CDEF filtering of the 64x64 filter blocks of the filter block row fbr, using
+the filter strength pairs chosen in finish_cdef_search(). The rows above and below the
+filter block row are read from the lines saved by svt_av1_cdef_save_boundary_lines(), so
+the filter block rows can be filtered in any order.
 */
-void av1_cdef_frame16bit(EncDecContext *context_ptr, SequenceControlSet *scs_ptr,
-                         PictureControlSet *pCs) {
-    (void)context_ptr;
+void av1_cdef_fb_row16bit(SequenceControlSet *scs_ptr, PictureControlSet *pCs, int32_t fbr) {
     struct PictureParentControlSet *ppcs    = pCs->parent_pcs_ptr;
     Av1Common                      *cm      = ppcs->av1_cm;
     FrameHeader                    *frm_hdr = &ppcs->frm_hdr;
@@ -695,10 +802,8 @@ void av1_cdef_frame16bit(EncDecContext *context_ptr, SequenceControlSet *scs_ptr
 
     const int32_t num_planes = av1_num_planes(&scs_ptr->seq_header.color_config);
     DECLARE_ALIGNED(16, uint16_t, src[CDEF_INBUF_SIZE]);
-    uint16_t      *linebuf[3];
     uint16_t      *colbuf[3];
     CdefList       dlist[MI_SIZE_64X64 * MI_SIZE_64X64];
-    uint8_t       *row_cdef, *prev_row_cdef, *curr_row_cdef;
     int32_t        cdef_count;
     const uint32_t sb_size = scs_ptr->super_block_size;
     int32_t        mi_wide_l2[3];
@@ -708,11 +813,6 @@ void av1_cdef_frame16bit(EncDecContext *context_ptr, SequenceControlSet *scs_ptr
     int32_t coeff_shift = AOMMAX(scs_ptr->static_config.encoder_bit_depth /*cm->bit_depth*/ - 8, 0);
     const int32_t nvfb  = (cm->mi_rows + MI_SIZE_64X64 - 1) / MI_SIZE_64X64;
     const int32_t nhfb  = (cm->mi_cols + MI_SIZE_64X64 - 1) / MI_SIZE_64X64;
-    row_cdef            = (uint8_t *)svt_aom_malloc(sizeof(*row_cdef) * (nhfb + 2) * 2);
-    assert(row_cdef);
-    memset(row_cdef, 1, sizeof(*row_cdef) * (nhfb + 2) * 2);
-    prev_row_cdef = row_cdef + 1;
-    curr_row_cdef = prev_row_cdef + nhfb + 2;
     for (int32_t pli = 0; pli < num_planes; pli++) {
         int32_t subsampling_x = (pli == 0) ? 0 : 1;
         int32_t subsampling_y = (pli == 0) ? 0 : 1;
@@ -723,300 +823,263 @@ void av1_cdef_frame16bit(EncDecContext *context_ptr, SequenceControlSet *scs_ptr
         mi_high_l2[pli] = MI_SIZE_LOG2 - subsampling_y; //CHKN xd->plane[pli].subsampling_y;
     }
 
-    const int32_t stride = (cm->mi_cols << MI_SIZE_LOG2) + 2 * CDEF_HBORDER;
+    const int32_t stride = pCs->cdef_linebuf_stride;
+    uint16_t     *linebuf_above[3];
+    uint16_t     *linebuf_below[3];
     for (int32_t pli = 0; pli < num_planes; pli++) {
-        linebuf[pli] = (uint16_t *)svt_aom_malloc(sizeof(*linebuf) * CDEF_VBORDER * stride);
-        colbuf[pli]  = (uint16_t *)svt_aom_malloc(
+        // the lines saved at the top edges of this filter block row and of the next one
+        linebuf_above[pli] = pCs->cdef_linebuf[pli] + fbr * 2 * CDEF_VBORDER * stride;
+        linebuf_below[pli] = linebuf_above[pli] + 3 * CDEF_VBORDER * stride;
+        colbuf[pli]        = (uint16_t *)svt_aom_malloc(
             sizeof(*colbuf) * ((CDEF_BLOCKSIZE << mi_high_l2[pli]) + 2 * CDEF_VBORDER) *
             CDEF_HBORDER);
     }
 
-    for (int32_t fbr = 0; fbr < nvfb; fbr++) {
-        int32_t cdef_left = 1;
-        for (int32_t fbc = 0; fbc < nhfb; fbc++) {
-            int32_t level, sec_strength;
-            int32_t uv_level, uv_sec_strength;
-            int32_t nhb, nvb;
-            int32_t cstart     = 0;
-            curr_row_cdef[fbc] = 0;
-
-            assert(pCs->mi_grid_base[MI_SIZE_64X64 * fbr * cm->mi_stride + MI_SIZE_64X64 * fbc] !=
-                       NULL &&
-                   "CDEF ERROR: Skipping Current FB");
-            assert(pCs->mi_grid_base[MI_SIZE_64X64 * fbr * cm->mi_stride + MI_SIZE_64X64 * fbc]
-                           ->mbmi.cdef_strength != -1 &&
-                   "CDEF ERROR: Skipping Current FB");
-            if (!cdef_left)
-                cstart =
-                    -CDEF_HBORDER; //CHKN if the left block has not been filtered, then we can use samples on the left as input.
-
-            nhb = AOMMIN(MI_SIZE_64X64, cm->mi_cols - MI_SIZE_64X64 * fbc);
-            nvb = AOMMIN(MI_SIZE_64X64, cm->mi_rows - MI_SIZE_64X64 * fbr);
-            int32_t frame_top, frame_left, frame_bottom, frame_right;
-
-            int32_t mi_row = MI_SIZE_64X64 * fbr;
-            int32_t mi_col = MI_SIZE_64X64 * fbc;
-            // for the current filter block, it's top left corner mi structure (mi_tl)
-            // is first accessed to check whether the top and left boundaries are
-            // frame boundaries. Then bottom-left and top-right mi structures are
-            // accessed to check whether the bottom and right boundaries
-            // (respectively) are frame boundaries.
-            //
-            // Note that we can't just check the bottom-right mi structure - eg. if
-            // we're at the right-hand edge of the frame but not the bottom, then
-            // the bottom-right mi is NULL but the bottom-left is not.
-            frame_top  = (mi_row == 0) ? 1 : 0;
-            frame_left = (mi_col == 0) ? 1 : 0;
-
-            if (fbr != nvfb - 1)
-                frame_bottom = (mi_row + MI_SIZE_64X64 == cm->mi_rows) ? 1 : 0;
-            else
-                frame_bottom = 1;
+    int32_t cdef_left = 1;
+    for (int32_t fbc = 0; fbc < nhfb; fbc++) {
+        int32_t level, sec_strength;
+        int32_t uv_level, uv_sec_strength;
+        int32_t nhb, nvb;
+        int32_t cstart = 0;
+
+        assert(pCs->mi_grid_base[MI_SIZE_64X64 * fbr * cm->mi_stride + MI_SIZE_64X64 * fbc] !=
+                   NULL &&
+               "CDEF ERROR: Skipping Current FB");
+        assert(pCs->mi_grid_base[MI_SIZE_64X64 * fbr * cm->mi_stride + MI_SIZE_64X64 * fbc]
+                       ->mbmi.cdef_strength != -1 &&
+               "CDEF ERROR: Skipping Current FB");
+        if (!cdef_left)
+            cstart =
+                -CDEF_HBORDER; //CHKN if the left block has not been filtered, then we can use samples on the left as input.
+
+        nhb = AOMMIN(MI_SIZE_64X64, cm->mi_cols - MI_SIZE_64X64 * fbc);
+        nvb = AOMMIN(MI_SIZE_64X64, cm->mi_rows - MI_SIZE_64X64 * fbr);
+        int32_t frame_top, frame_left, frame_bottom, frame_right;
+
+        int32_t mi_row = MI_SIZE_64X64 * fbr;
+        int32_t mi_col = MI_SIZE_64X64 * fbc;
+        // for the current filter block, it's top left corner mi structure (mi_tl)
+        // is first accessed to check whether the top and left boundaries are
+        // frame boundaries. Then bottom-left and top-right mi structures are
+        // accessed to check whether the bottom and right boundaries
+        // (respectively) are frame boundaries.
+        //
+        // Note that we can't just check the bottom-right mi structure - eg. if
+        // we're at the right-hand edge of the frame but not the bottom, then
+        // the bottom-right mi is NULL but the bottom-left is not.
+        frame_top  = (mi_row == 0) ? 1 : 0;
+        frame_left = (mi_col == 0) ? 1 : 0;
+
+        if (fbr != nvfb - 1)
+            frame_bottom = (mi_row + MI_SIZE_64X64 == cm->mi_rows) ? 1 : 0;
+        else
+            frame_bottom = 1;
+
+        if (fbc != nhfb - 1)
+            frame_right = (mi_col + MI_SIZE_64X64 == cm->mi_cols) ? 1 : 0;
+        else
+            frame_right = 1;
+
+        const int32_t mbmi_cdef_strength =
+            pCs->mi_grid_base[MI_SIZE_64X64 * fbr * cm->mi_stride + MI_SIZE_64X64 * fbc]
+                ->mbmi.cdef_strength;
+        level = frm_hdr->cdef_params.cdef_y_strength[mbmi_cdef_strength] / CDEF_SEC_STRENGTHS;
+        sec_strength = frm_hdr->cdef_params.cdef_y_strength[mbmi_cdef_strength] %
+            CDEF_SEC_STRENGTHS;
+        sec_strength += sec_strength == 3;
+        uv_level = frm_hdr->cdef_params.cdef_uv_strength[mbmi_cdef_strength] /
+            CDEF_SEC_STRENGTHS;
+        uv_sec_strength = frm_hdr->cdef_params.cdef_uv_strength[mbmi_cdef_strength] %
+            CDEF_SEC_STRENGTHS;
+        uv_sec_strength += uv_sec_strength == 3;
+        if ((level == 0 && sec_strength == 0 && uv_level == 0 && uv_sec_strength == 0) ||
+            (cdef_count = svt_sb_compute_cdef_list(
+                 pCs, cm, fbr * MI_SIZE_64X64, fbc * MI_SIZE_64X64, dlist, BLOCK_64X64)) == 0) {
+            cdef_left = 0;
+            continue;
+        }
 
-            if (fbc != nhfb - 1)
-                frame_right = (mi_col + MI_SIZE_64X64 == cm->mi_cols) ? 1 : 0;
+        int dirinit = !(ppcs->cdef_ctrls.use_reference_cdef_fs);
+        // When SB 128 is used, the search for certain blocks is skipped, so dir/var info is not generated
+        // In those cases, must generate info here
+        if (sb_size == 128) {
+            const uint32_t    lc      = MI_SIZE_64X64 * fbc;
+            const uint32_t    lr      = MI_SIZE_64X64 * fbr;
+            ModeInfo        **mi      = pCs->mi_grid_base + lr * cm->mi_stride + lc;
+            const MbModeInfo *mbmi    = &mi[0]->mbmi;
+            const BlockSize   sb_type = mbmi->block_mi.sb_type;
+            if (((fbc & 1) && (sb_type == BLOCK_128X128 || sb_type == BLOCK_128X64)) ||
+                ((fbr & 1) && (sb_type == BLOCK_128X128 || sb_type == BLOCK_64X128)))
+                dirinit = 0;
+        }
+        uint8_t(*dir)[CDEF_NBLOCKS][CDEF_NBLOCKS] = &pCs->cdef_dir_data[fbr * nhfb + fbc].dir;
+        int32_t(*var)[CDEF_NBLOCKS][CDEF_NBLOCKS] = &pCs->cdef_dir_data[fbr * nhfb + fbc].var;
+        for (int32_t pli = 0; pli < num_planes; pli++) {
+            int32_t coffset;
+            int32_t rend, cend;
+            int32_t pri_damping = frm_hdr->cdef_params.cdef_damping;
+            int32_t sec_damping = pri_damping;
+            int32_t hsize       = nhb << mi_wide_l2[pli];
+            int32_t vsize       = nvb << mi_high_l2[pli];
+            if (fbc == nhfb - 1)
+                cend = hsize;
             else
-                frame_right = 1;
-
-            const int32_t mbmi_cdef_strength =
-                pCs->mi_grid_base[MI_SIZE_64X64 * fbr * cm->mi_stride + MI_SIZE_64X64 * fbc]
-                    ->mbmi.cdef_strength;
-            level = frm_hdr->cdef_params.cdef_y_strength[mbmi_cdef_strength] / CDEF_SEC_STRENGTHS;
-            sec_strength = frm_hdr->cdef_params.cdef_y_strength[mbmi_cdef_strength] %
-                CDEF_SEC_STRENGTHS;
-            sec_strength += sec_strength == 3;
-            uv_level = frm_hdr->cdef_params.cdef_uv_strength[mbmi_cdef_strength] /
-                CDEF_SEC_STRENGTHS;
-            uv_sec_strength = frm_hdr->cdef_params.cdef_uv_strength[mbmi_cdef_strength] %
-                CDEF_SEC_STRENGTHS;
-            uv_sec_strength += uv_sec_strength == 3;
-            if ((level == 0 && sec_strength == 0 && uv_level == 0 && uv_sec_strength == 0) ||
-                (cdef_count = svt_sb_compute_cdef_list(
-                     pCs, cm, fbr * MI_SIZE_64X64, fbc * MI_SIZE_64X64, dlist, BLOCK_64X64)) == 0) {
-                cdef_left = 0;
-                continue;
-            }
+                cend = hsize + CDEF_HBORDER;
 
-            int dirinit = !(ppcs->cdef_ctrls.use_reference_cdef_fs);
-            // When SB 128 is used, the search for certain blocks is skipped, so dir/var info is not generated
-            // In those cases, must generate info here
-            if (sb_size == 128) {
-                const uint32_t    lc      = MI_SIZE_64X64 * fbc;
-                const uint32_t    lr      = MI_SIZE_64X64 * fbr;
-                ModeInfo        **mi      = pCs->mi_grid_base + lr * cm->mi_stride + lc;
-                const MbModeInfo *mbmi    = &mi[0]->mbmi;
-                const BlockSize   sb_type = mbmi->block_mi.sb_type;
-                if (((fbc & 1) && (sb_type == BLOCK_128X128 || sb_type == BLOCK_128X64)) ||
-                    ((fbr & 1) && (sb_type == BLOCK_128X128 || sb_type == BLOCK_64X128)))
-                    dirinit = 0;
-            }
-            uint8_t(*dir)[CDEF_NBLOCKS][CDEF_NBLOCKS] = &pCs->cdef_dir_data[fbr * nhfb + fbc].dir;
-            int32_t(*var)[CDEF_NBLOCKS][CDEF_NBLOCKS] = &pCs->cdef_dir_data[fbr * nhfb + fbc].var;
-            curr_row_cdef[fbc]                        = 1;
-            for (int32_t pli = 0; pli < num_planes; pli++) {
-                int32_t coffset;
-                int32_t rend, cend;
-                int32_t pri_damping = frm_hdr->cdef_params.cdef_damping;
-                int32_t sec_damping = pri_damping;
-                int32_t hsize       = nhb << mi_wide_l2[pli];
-                int32_t vsize       = nvb << mi_high_l2[pli];
-                if (fbc == nhfb - 1)
-                    cend = hsize;
-                else
-                    cend = hsize + CDEF_HBORDER;
-
-                if (fbr == nvfb - 1)
-                    rend = vsize;
-                else
-                    rend = vsize + CDEF_VBORDER;
-
-                coffset              = fbc * MI_SIZE_64X64 << mi_wide_l2[pli];
-                uint16_t *rec_buff   = 0;
-                uint32_t  rec_stride = 0;
-
-                switch (pli) {
-                case 0:
-                    rec_buff   = recon_buffer_y;
-                    rec_stride = recon_picture_ptr->stride_y;
-                    break;
-                case 1:
-                    rec_buff     = recon_buffer_cb;
-                    rec_stride   = recon_picture_ptr->stride_cb;
-                    level        = uv_level;
-                    sec_strength = uv_sec_strength;
-                    break;
-                case 2:
-                    rec_buff     = recon_buffer_cr;
-                    rec_stride   = recon_picture_ptr->stride_cr;
-                    level        = uv_level;
-                    sec_strength = uv_sec_strength;
-                    break;
-                }
+            if (fbr == nvfb - 1)
+                rend = vsize;
+            else
+                rend = vsize + CDEF_VBORDER;
 
-                /* Copy in the pixels we need from the current superblock for
-                deringing.*/
+            coffset              = fbc * MI_SIZE_64X64 << mi_wide_l2[pli];
+            uint16_t *rec_buff   = 0;
+            uint32_t  rec_stride = 0;
 
-                copy_sb16_16(&src[CDEF_VBORDER * CDEF_BSTRIDE + CDEF_HBORDER + cstart],
-                             CDEF_BSTRIDE,
-                             rec_buff,
-                             (MI_SIZE_64X64 << mi_high_l2[pli]) * fbr,
-                             coffset + cstart,
-                             rec_stride,
-                             rend,
-                             cend - cstart);
-
-                if (!prev_row_cdef[fbc]) {
-                    copy_sb16_16(&src[CDEF_HBORDER],
-                                 CDEF_BSTRIDE,
-                                 rec_buff,
-                                 (MI_SIZE_64X64 << mi_high_l2[pli]) * fbr - CDEF_VBORDER,
-                                 coffset,
-                                 rec_stride,
-                                 CDEF_VBORDER,
-                                 hsize);
-                } else if (fbr > 0) {
-                    copy_rect(&src[CDEF_HBORDER],
-                              CDEF_BSTRIDE,
-                              &linebuf[pli][coffset],
-                              stride,
-                              CDEF_VBORDER,
-                              hsize);
-                } else {
-                    fill_rect(
-                        &src[CDEF_HBORDER], CDEF_BSTRIDE, CDEF_VBORDER, hsize, CDEF_VERY_LARGE);
-                }
+            switch (pli) {
+            case 0:
+                rec_buff   = recon_buffer_y;
+                rec_stride = recon_picture_ptr->stride_y;
+                break;
+            case 1:
+                rec_buff     = recon_buffer_cb;
+                rec_stride   = recon_picture_ptr->stride_cb;
+                level        = uv_level;
+                sec_strength = uv_sec_strength;
+                break;
+            case 2:
+                rec_buff     = recon_buffer_cr;
+                rec_stride   = recon_picture_ptr->stride_cr;
+                level        = uv_level;
+                sec_strength = uv_sec_strength;
+                break;
+            }
 
-                if (!prev_row_cdef[fbc - 1]) {
-                    copy_sb16_16(src,
-                                 CDEF_BSTRIDE,
-                                 rec_buff,
-                                 (MI_SIZE_64X64 << mi_high_l2[pli]) * fbr - CDEF_VBORDER,
-                                 coffset - CDEF_HBORDER,
-                                 rec_stride,
-                                 CDEF_VBORDER,
-                                 CDEF_HBORDER);
-                } else if (fbr > 0 && fbc > 0) {
-                    copy_rect(src,
-                              CDEF_BSTRIDE,
-                              &linebuf[pli][coffset - CDEF_HBORDER],
-                              stride,
-                              CDEF_VBORDER,
-                              CDEF_HBORDER);
-                } else {
-                    fill_rect(src, CDEF_BSTRIDE, CDEF_VBORDER, CDEF_HBORDER, CDEF_VERY_LARGE);
-                }
+            /* Copy in the pixels we need from the current superblock for
+            deringing.*/
+
+            copy_sb16_16(&src[CDEF_VBORDER * CDEF_BSTRIDE + CDEF_HBORDER + cstart],
+                         CDEF_BSTRIDE,
+                         rec_buff,
+                         (MI_SIZE_64X64 << mi_high_l2[pli]) * fbr,
+                         coffset + cstart,
+                         rec_stride,
+                         vsize,
+                         cend - cstart);
+            if (fbr < nvfb - 1)
+                copy_rect(&src[(vsize + CDEF_VBORDER) * CDEF_BSTRIDE + CDEF_HBORDER + cstart],
+                          CDEF_BSTRIDE,
+                          &linebuf_below[pli][coffset + cstart],
+                          stride,
+                          CDEF_VBORDER,
+                          cend - cstart);
+
+            if (fbr > 0) {
+                copy_rect(&src[CDEF_HBORDER],
+                          CDEF_BSTRIDE,
+                          &linebuf_above[pli][coffset],
+                          stride,
+                          CDEF_VBORDER,
+                          hsize);
+            } else {
+                fill_rect(&src[CDEF_HBORDER], CDEF_BSTRIDE, CDEF_VBORDER, hsize, CDEF_VERY_LARGE);
+            }
 
-                if (!prev_row_cdef[fbc + 1]) {
-                    copy_sb16_16(&src[CDEF_HBORDER + (nhb << mi_wide_l2[pli])],
-                                 CDEF_BSTRIDE,
-                                 rec_buff,
-                                 (MI_SIZE_64X64 << mi_high_l2[pli]) * fbr - CDEF_VBORDER,
-                                 coffset + hsize,
-                                 rec_stride,
-                                 CDEF_VBORDER,
-                                 CDEF_HBORDER);
-                } else if (fbr > 0 && fbc < nhfb - 1) {
-                    copy_rect(&src[hsize + CDEF_HBORDER],
-                              CDEF_BSTRIDE,
-                              &linebuf[pli][coffset + hsize],
-                              stride,
-                              CDEF_VBORDER,
-                              CDEF_HBORDER);
-                } else {
-                    fill_rect(&src[hsize + CDEF_HBORDER],
-                              CDEF_BSTRIDE,
-                              CDEF_VBORDER,
-                              CDEF_HBORDER,
-                              CDEF_VERY_LARGE);
-                }
+            if (fbr > 0 && fbc > 0) {
+                copy_rect(src,
+                          CDEF_BSTRIDE,
+                          &linebuf_above[pli][coffset - CDEF_HBORDER],
+                          stride,
+                          CDEF_VBORDER,
+                          CDEF_HBORDER);
+            } else {
+                fill_rect(src, CDEF_BSTRIDE, CDEF_VBORDER, CDEF_HBORDER, CDEF_VERY_LARGE);
+            }
 
-                if (cdef_left) {
-                    /* If we deringed the superblock on the left then we need to copy in
-                    saved pixels. */
-                    copy_rect(src,
-                              CDEF_BSTRIDE,
-                              colbuf[pli],
-                              CDEF_HBORDER,
-                              rend + CDEF_VBORDER,
-                              CDEF_HBORDER);
-                }
+            if (fbr > 0 && fbc < nhfb - 1) {
+                copy_rect(&src[hsize + CDEF_HBORDER],
+                          CDEF_BSTRIDE,
+                          &linebuf_above[pli][coffset + hsize],
+                          stride,
+                          CDEF_VBORDER,
+                          CDEF_HBORDER);
+            } else {
+                fill_rect(&src[hsize + CDEF_HBORDER],
+                          CDEF_BSTRIDE,
+                          CDEF_VBORDER,
+                          CDEF_HBORDER,
+                          CDEF_VERY_LARGE);
+            }
 
-                /* Saving pixels in case we need to dering the superblock on the
-                right. */
-                if (fbc < nhfb - 1)
-                    copy_rect(colbuf[pli],
-                              CDEF_HBORDER,
-                              src + hsize,
-                              CDEF_BSTRIDE,
-                              rend + CDEF_VBORDER,
-                              CDEF_HBORDER);
-                if (fbr < nvfb - 1)
-                    copy_sb16_16(&linebuf[pli][coffset],
-                                 stride,
-                                 rec_buff,
-                                 (MI_SIZE_64X64 << mi_high_l2[pli]) * (fbr + 1) - CDEF_VBORDER,
-                                 coffset,
-                                 rec_stride,
-                                 CDEF_VBORDER,
-                                 hsize);
-                if (frame_top) {
-                    fill_rect(
-                        src, CDEF_BSTRIDE, CDEF_VBORDER, hsize + 2 * CDEF_HBORDER, CDEF_VERY_LARGE);
-                }
-                if (frame_left) {
-                    fill_rect(
-                        src, CDEF_BSTRIDE, vsize + 2 * CDEF_VBORDER, CDEF_HBORDER, CDEF_VERY_LARGE);
-                }
-                if (frame_bottom) {
-                    fill_rect(&src[(vsize + CDEF_VBORDER) * CDEF_BSTRIDE],
-                              CDEF_BSTRIDE,
-                              CDEF_VBORDER,
-                              hsize + 2 * CDEF_HBORDER,
-                              CDEF_VERY_LARGE);
-                }
-                if (frame_right) {
-                    fill_rect(&src[hsize + CDEF_HBORDER],
-                              CDEF_BSTRIDE,
-                              vsize + 2 * CDEF_VBORDER,
-                              CDEF_HBORDER,
-                              CDEF_VERY_LARGE);
-                }
+            if (cdef_left) {
+                /* If we deringed the superblock on the left then we need to copy in
+                saved pixels. */
+                copy_rect(src,
+                          CDEF_BSTRIDE,
+                          colbuf[pli],
+                          CDEF_HBORDER,
+                          rend + CDEF_VBORDER,
+                          CDEF_HBORDER);
+            }
 
-                // if ppcs->cdef_ctrls.use_reference_cdef_fs is true, then search was not performed
-                // Therefore, need to make sure dir and var are initialized
-                if (level || sec_strength || !dirinit)
-                    svt_cdef_filter_fb(
-                        NULL,
-                        &rec_buff[rec_stride * (MI_SIZE_64X64 * fbr << mi_high_l2[pli]) +
-                                  (fbc * MI_SIZE_64X64 << mi_wide_l2[pli])],
-                        rec_stride,
-                        &src[CDEF_VBORDER * CDEF_BSTRIDE + CDEF_HBORDER],
-                        xdec[pli],
-                        ydec[pli],
-                        *dir,
-                        &dirinit,
-                        *var,
-                        pli,
-                        dlist,
-                        cdef_count,
-                        level,
-                        sec_strength,
-                        pri_damping,
-                        sec_damping,
-                        coeff_shift,
-                        1); // no subsampling
+            /* Saving pixels in case we need to dering the superblock on the
+            right. */
+            if (fbc < nhfb - 1)
+                copy_rect(colbuf[pli],
+                          CDEF_HBORDER,
+                          src + hsize,
+                          CDEF_BSTRIDE,
+                          rend + CDEF_VBORDER,
+                          CDEF_HBORDER);
+            if (frame_top) {
+                fill_rect(
+                    src, CDEF_BSTRIDE, CDEF_VBORDER, hsize + 2 * CDEF_HBORDER, CDEF_VERY_LARGE);
             }
-            cdef_left = 1; //CHKN filtered data is written back directy to recFrame.
-        }
-        {
-            uint8_t *tmp  = prev_row_cdef;
-            prev_row_cdef = curr_row_cdef;
-            curr_row_cdef = tmp;
+            if (frame_left) {
+                fill_rect(
+                    src, CDEF_BSTRIDE, vsize + 2 * CDEF_VBORDER, CDEF_HBORDER, CDEF_VERY_LARGE);
+            }
+            if (frame_bottom) {
+                fill_rect(&src[(vsize + CDEF_VBORDER) * CDEF_BSTRIDE],
+                          CDEF_BSTRIDE,
+                          CDEF_VBORDER,
+                          hsize + 2 * CDEF_HBORDER,
+                          CDEF_VERY_LARGE);
+            }
+            if (frame_right) {
+                fill_rect(&src[hsize + CDEF_HBORDER],
+                          CDEF_BSTRIDE,
+                          vsize + 2 * CDEF_VBORDER,
+                          CDEF_HBORDER,
+                          CDEF_VERY_LARGE);
+            }
+
+            // if ppcs->cdef_ctrls.use_reference_cdef_fs is true, then search was not performed
+            // Therefore, need to make sure dir and var are initialized
+            if (level || sec_strength || !dirinit)
+                svt_cdef_filter_fb(
+                    NULL,
+                    &rec_buff[rec_stride * (MI_SIZE_64X64 * fbr << mi_high_l2[pli]) +
+                              (fbc * MI_SIZE_64X64 << mi_wide_l2[pli])],
+                    rec_stride,
+                    &src[CDEF_VBORDER * CDEF_BSTRIDE + CDEF_HBORDER],
+                    xdec[pli],
+                    ydec[pli],
+                    *dir,
+                    &dirinit,
+                    *var,
+                    pli,
+                    dlist,
+                    cdef_count,
+                    level,
+                    sec_strength,
+                    pri_damping,
+                    sec_damping,
+                    coeff_shift,
+                    1); // no subsampling
         }
+        cdef_left = 1; //CHKN filtered data is written back directy to recFrame.
     }
-    svt_aom_free(row_cdef);
     for (int32_t pli = 0; pli < num_planes; pli++) {
-        svt_aom_free(linebuf[pli]);
         svt_aom_free(colbuf[pli]);
     }
 }
@@ -33,10 +33,8 @@ void copy_mv_rate(PictureControlSet *pcs, MdRateEstimationContext *dst_rate);
 void svt_av1_cdef_search(EncDecContext *context_ptr, SequenceControlSet *scs_ptr,
                          PictureControlSet *pcs_ptr);
 
-void av1_cdef_frame16bit(uint8_t is_16bit, SequenceControlSet *scs_ptr, PictureControlSet *pCs);
-
 void svt_av1_add_film_grain(EbPictureBufferDesc *src, EbPictureBufferDesc *dst,
-                            AomFilmGrain *film_grain_ptr);
+                            AomFilmGrain *film_grain_ptr, SvtJobPool *job_pool);
 
 void svt_av1_loop_restoration_save_boundary_lines(const Yv12BufferConfig *frame, Av1Common *cm,
                                                   int32_t after_cdef);
@@ -109,6 +107,8 @@ EbErrorType enc_dec_context_ctor(EbThreadContext   *thread_context_ptr,
         enc_handle_ptr->enc_dec_results_resource_ptr, index);
     context_ptr->enc_dec_feedback_fifo_ptr = svt_system_resource_get_producer_fifo(
         enc_handle_ptr->enc_dec_tasks_resource_ptr, tasks_index);
+    context_ptr->wavefront_queue =
+        &enc_handle_ptr->scs_instance_array[0]->encode_context_ptr->enc_dec_wavefront_queue;
 
     // Prediction Buffer
     context_ptr->input_sample16bit_buffer = NULL;
@@ -430,6 +430,80 @@ Bool assign_enc_dec_segments(EncDecSegments *segmentPtr, uint16_t *segmentInOutI
 
     return continue_processing_flag;
 }
+
+/* EncDec is skipped for the first pass and for the pictures the stats pass does not code */
+static Bool enc_dec_bypassed(SequenceControlSet *scs_ptr, PictureControlSet *pcs_ptr) {
+    return scs_ptr->static_config.pass == ENC_FIRST_PASS ||
+        (!pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag && scs_ptr->rc_stat_gen_pass_mode &&
+         !pcs_ptr->parent_pcs_ptr->first_frame_in_minigop);
+}
+
+/******************************************************
+ * Start EncDec Wavefront
+ *   A picture tile group coded as an SB wavefront (single
+ *   SB segments) joins the wavefront queue, its task
+ *   becoming the one of its first row.
+ ******************************************************/
+static void start_enc_dec_wavefront(EncDecContext *context_ptr, EncDecTasks *task_ptr) {
+    PictureControlSet *pcs_ptr      = (PictureControlSet *)task_ptr->pcs_wrapper_ptr->object_ptr;
+    EncDecSegments    *segments_ptr = pcs_ptr->enc_dec_segment_ctrl[task_ptr->tile_group_index];
+    if (!segments_ptr->sb_wavefront || enc_dec_bypassed(pcs_ptr->scs_ptr, pcs_ptr))
+        return;
+    enc_dec_wavefront_queue_add(context_ptr->wavefront_queue,
+                                segments_ptr,
+                                task_ptr->pcs_wrapper_ptr,
+                                pcs_ptr->parent_pcs_ptr->decode_order,
+                                task_ptr->tile_group_index);
+    task_ptr->input_type = ENCDEC_TASKS_WAVEFRONT_INPUT;
+}
+
+/******************************************************
+ * Take EncDec Wavefront Row
+ *   The task of a pending wavefront row codes the first
+ *   pending row of the oldest picture, which may not be
+ *   the picture that posted it.
+ ******************************************************/
+static Bool take_enc_dec_wavefront_row(EncDecContext *context_ptr, EncDecTasks *task_ptr) {
+    uint32_t        sb_row;
+    EncDecSegments *segments_ptr = enc_dec_wavefront_queue_take_row(context_ptr->wavefront_queue,
+                                                                    &sb_row);
+    if (!segments_ptr)
+        return FALSE;
+    task_ptr->pcs_wrapper_ptr     = segments_ptr->pcs_wrapper_ptr;
+    task_ptr->tile_group_index    = segments_ptr->tile_group_index;
+    task_ptr->enc_dec_segment_row = (int16_t)sb_row;
+    return TRUE;
+}
+
+/******************************************************
+ * Assign EncDec SB Row
+ *   Counterpart of assign_enc_dec_segments for the SB
+ *   wavefront: the task carries the SB row to code, from
+ *   its first SB not coded yet, and the SB dependencies
+ *   are then resolved SB by SB with the lock-free row
+ *   progress counters.
+ ******************************************************/
+static Bool assign_enc_dec_sb_row(uint32_t *sb_row, EncDecTasks *task_ptr) {
+    if (task_ptr->input_type != ENCDEC_TASKS_WAVEFRONT_INPUT)
+        return FALSE;
+    *sb_row              = (uint32_t)task_ptr->enc_dec_segment_row;
+    task_ptr->input_type = ENCDEC_TASKS_CONTINUE;
+    return TRUE;
+}
+
+/* Hands the SB row out to the EncDec threads */
+static void post_enc_dec_sb_row(EncDecContext *context_ptr, EncDecTasks *task_ptr,
+                                EncDecSegments *segments_ptr, uint32_t sb_row) {
+    EbObjectWrapper *wrapper_ptr;
+    enc_dec_wavefront_queue_post_row(context_ptr->wavefront_queue, segments_ptr, sb_row);
+    svt_get_empty_object(context_ptr->enc_dec_feedback_fifo_ptr, &wrapper_ptr);
+    EncDecTasks *feedback_task_ptr         = (EncDecTasks *)wrapper_ptr->object_ptr;
+    feedback_task_ptr->input_type          = ENCDEC_TASKS_WAVEFRONT_INPUT;
+    feedback_task_ptr->enc_dec_segment_row = (int16_t)sb_row;
+    feedback_task_ptr->pcs_wrapper_ptr     = task_ptr->pcs_wrapper_ptr;
+    feedback_task_ptr->tile_group_index    = task_ptr->tile_group_index;
+    svt_post_full_object(wrapper_ptr);
+}
 void recon_output(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr) {
     EncodeContext *encode_context_ptr = scs_ptr->encode_context_ptr;
     // The totalNumberOfReconFrames counter has to be write/read protected as
@@ -505,7 +579,10 @@ void recon_output(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr) {
                     film_grain_ptr = &pcs_ptr->parent_pcs_ptr->frm_hdr.film_grain_params;
 
                 if (intermediate_buffer_ptr) {
-                    svt_av1_add_film_grain(recon_ptr, intermediate_buffer_ptr, film_grain_ptr);
+                    svt_av1_add_film_grain(recon_ptr,
+                                           intermediate_buffer_ptr,
+                                           film_grain_ptr,
+                                           scs_ptr->encode_context_ptr->job_pool);
                     recon_ptr = intermediate_buffer_ptr;
                 }
             }
@@ -6721,6 +6798,53 @@ uint8_t is_vlpd0_safe(PictureControlSet *pcs_ptr, ModeDecisionContext *md_ctx) {
 
     return is_vlpd0_safe;
 }
+/*
+* Wavefront post-filtering: counts the SB as coded and sends the DLF process the CDEF search
+* segment rows whose (in-loop deblocked) pixels are now final. A segment row needs the SB rows
+* it covers plus the next one, whose deblocking still changes the last lines above it and
+* which the CDEF search reads across.
+*/
+static void post_cdef_search_rows(EncDecContext *context_ptr, PictureControlSet *pcs_ptr,
+                                  EbObjectWrapper *pcs_wrapper_ptr, uint32_t sb_row) {
+    const uint32_t sb_size           = pcs_ptr->scs_ptr->sb_size_pix;
+    const uint32_t pic_width_in_sb   = (pcs_ptr->parent_pcs_ptr->aligned_width + sb_size - 1) /
+        sb_size;
+    const uint32_t pic_height_in_sb  = (pcs_ptr->parent_pcs_ptr->aligned_height + sb_size - 1) /
+        sb_size;
+    const uint32_t pic_height_in_b64 = (pcs_ptr->parent_pcs_ptr->aligned_height + 64 - 1) / 64;
+
+    svt_block_on_mutex(pcs_ptr->enc_dec_row_mutex);
+    pcs_ptr->enc_dec_sb_row_count[sb_row]++;
+    while (pcs_ptr->enc_dec_sb_rows_done < pic_height_in_sb &&
+           pcs_ptr->enc_dec_sb_row_count[pcs_ptr->enc_dec_sb_rows_done] == pic_width_in_sb)
+        pcs_ptr->enc_dec_sb_rows_done++;
+    const uint8_t seg_row_start = pcs_ptr->cdef_seg_rows_posted;
+    uint8_t       seg_row_end   = seg_row_start;
+    while (seg_row_end < pcs_ptr->cdef_segments_row_count) {
+        const uint32_t b64_end = SEGMENT_END_IDX(
+            seg_row_end, pic_height_in_b64, pcs_ptr->cdef_segments_row_count);
+        const uint32_t sb_rows_needed = MIN(pic_height_in_sb, (b64_end * 64) / sb_size + 1);
+        if (pcs_ptr->enc_dec_sb_rows_done < sb_rows_needed)
+            break;
+        seg_row_end++;
+    }
+    pcs_ptr->cdef_seg_rows_posted = seg_row_end;
+    svt_release_mutex(pcs_ptr->enc_dec_row_mutex);
+
+    if (seg_row_end > seg_row_start) {
+        EbObjectWrapper *enc_dec_results_wrapper_ptr;
+        svt_get_empty_object(context_ptr->enc_dec_output_fifo_ptr, &enc_dec_results_wrapper_ptr);
+        EncDecResults *enc_dec_results_ptr = (EncDecResults *)
+                                                 enc_dec_results_wrapper_ptr->object_ptr;
+        enc_dec_results_ptr->pcs_wrapper_ptr    = pcs_wrapper_ptr;
+        enc_dec_results_ptr->partial            = TRUE;
+        enc_dec_results_ptr->cdef_seg_row_start = seg_row_start;
+        enc_dec_results_ptr->cdef_seg_row_end   = seg_row_end;
+        enc_dec_results_ptr->dlf_segments       = FALSE;
+        svt_post_full_object(enc_dec_results_wrapper_ptr);
+    }
+}
+
 /* EncDec (Encode Decode) Kernel */
 /*********************************************************************************
 *
@@ -6789,6 +6913,7 @@ void *mode_decision_kernel(void *input_ptr) {
     uint32_t        segment_row_index;
     uint32_t        segment_band_index;
     uint32_t        segment_band_size;
+    uint32_t        sb_row_index = 0;
     EncDecSegments *segments_ptr;
 
     segment_index = 0;
@@ -6797,8 +6922,15 @@ void *mode_decision_kernel(void *input_ptr) {
         // Get Mode Decision Results
         EB_GET_FULL_OBJECT(context_ptr->mode_decision_input_fifo_ptr, &enc_dec_tasks_wrapper_ptr);
 
-        EncDecTasks       *enc_dec_tasks_ptr = (EncDecTasks *)enc_dec_tasks_wrapper_ptr->object_ptr;
-        PictureControlSet *pcs_ptr           = (PictureControlSet *)
+        EncDecTasks *enc_dec_tasks_ptr = (EncDecTasks *)enc_dec_tasks_wrapper_ptr->object_ptr;
+        if (enc_dec_tasks_ptr->input_type == ENCDEC_TASKS_MDC_INPUT)
+            start_enc_dec_wavefront(context_ptr, enc_dec_tasks_ptr);
+        if (enc_dec_tasks_ptr->input_type == ENCDEC_TASKS_WAVEFRONT_INPUT &&
+            !take_enc_dec_wavefront_row(context_ptr, enc_dec_tasks_ptr)) {
+            svt_release_object(enc_dec_tasks_wrapper_ptr);
+            continue;
+        }
+        PictureControlSet *pcs_ptr = (PictureControlSet *)
                                          enc_dec_tasks_ptr->pcs_wrapper_ptr->object_ptr;
         SequenceControlSet             *scs_ptr = pcs_ptr->scs_ptr;
         ModeDecisionContext            *md_ctx  = context_ptr->md_context;
@@ -6822,9 +6954,7 @@ void *mode_decision_kernel(void *input_ptr) {
         context_ptr->tot_intra_coded_area = 0;
         context_ptr->tot_skip_coded_area  = 0;
         // Bypass encdec for the first pass
-        if (scs_ptr->static_config.pass == ENC_FIRST_PASS ||
-            (!pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag &&
-             scs_ptr->rc_stat_gen_pass_mode && !pcs_ptr->parent_pcs_ptr->first_frame_in_minigop)) {
+        if (enc_dec_bypassed(scs_ptr, pcs_ptr)) {
             svt_release_object(pcs_ptr->parent_pcs_ptr->me_data_wrapper_ptr);
             pcs_ptr->parent_pcs_ptr->me_data_wrapper_ptr = (EbObjectWrapper *)NULL;
             pcs_ptr->parent_pcs_ptr->pa_me_data          = NULL;
@@ -6833,6 +6963,8 @@ void *mode_decision_kernel(void *input_ptr) {
                                  &enc_dec_results_wrapper_ptr);
             enc_dec_results_ptr = (EncDecResults *)enc_dec_results_wrapper_ptr->object_ptr;
             enc_dec_results_ptr->pcs_wrapper_ptr = enc_dec_tasks_ptr->pcs_wrapper_ptr;
+            enc_dec_results_ptr->partial         = FALSE;
+            enc_dec_results_ptr->dlf_segments    = FALSE;
 
             // Post EncDec Results
             svt_post_full_object(enc_dec_results_wrapper_ptr);
@@ -6887,35 +7019,50 @@ void *mode_decision_kernel(void *input_ptr) {
                                                    &pcs_ptr->md_frame_context);
             }
             // Segment-loop
-            while (assign_enc_dec_segments(segments_ptr,
-                                           &segment_index,
-                                           enc_dec_tasks_ptr,
-                                           context_ptr->enc_dec_feedback_fifo_ptr) == TRUE) {
-                x_sb_start_index = segments_ptr->x_start_array[segment_index];
-                y_sb_start_index = segments_ptr->y_start_array[segment_index];
-                sb_start_index   = y_sb_start_index * tile_group_width_in_sb + x_sb_start_index;
-                sb_segment_count = segments_ptr->valid_sb_count_array[segment_index];
-
-                segment_row_index  = segment_index / segments_ptr->segment_band_count;
-                segment_band_index = segment_index -
-                    segment_row_index * segments_ptr->segment_band_count;
-                segment_band_size = (segments_ptr->sb_band_count * (segment_band_index + 1) +
-                                     segments_ptr->segment_band_count - 1) /
-                    segments_ptr->segment_band_count;
-
-                // Reset Coding Loop State
-                reset_mode_decision(scs_ptr,
-                                    context_ptr->md_context,
-                                    pcs_ptr,
-                                    context_ptr->tile_group_index,
-                                    segment_index);
-
-                // Reset EncDec Coding State
-                reset_enc_dec( // HT done
-                    context_ptr,
-                    pcs_ptr,
-                    scs_ptr,
-                    segment_index);
+            const Bool sb_wavefront = segments_ptr->sb_wavefront;
+            while (sb_wavefront
+                       ? assign_enc_dec_sb_row(&sb_row_index, enc_dec_tasks_ptr)
+                       : assign_enc_dec_segments(segments_ptr,
+                                                 &segment_index,
+                                                 enc_dec_tasks_ptr,
+                                                 context_ptr->enc_dec_feedback_fifo_ptr) == TRUE) {
+                if (sb_wavefront) {
+                    // the rest of the SB row, the SBs being reset one by one below
+                    x_sb_start_index = (uint32_t)svt_atomic_load_i32(
+                        &segments_ptr->sb_row_array[sb_row_index].progress);
+                    y_sb_start_index  = sb_row_index;
+                    sb_start_index    = y_sb_start_index * tile_group_width_in_sb +
+                        x_sb_start_index;
+                    sb_segment_count  = tile_group_width_in_sb - x_sb_start_index;
+                    segment_band_size = segments_ptr->sb_band_count;
+                } else {
+                    x_sb_start_index = segments_ptr->x_start_array[segment_index];
+                    y_sb_start_index = segments_ptr->y_start_array[segment_index];
+                    sb_start_index   = y_sb_start_index * tile_group_width_in_sb +
+                        x_sb_start_index;
+                    sb_segment_count = segments_ptr->valid_sb_count_array[segment_index];
+
+                    segment_row_index  = segment_index / segments_ptr->segment_band_count;
+                    segment_band_index = segment_index -
+                        segment_row_index * segments_ptr->segment_band_count;
+                    segment_band_size = (segments_ptr->sb_band_count * (segment_band_index + 1) +
+                                         segments_ptr->segment_band_count - 1) /
+                        segments_ptr->segment_band_count;
+
+                    // Reset Coding Loop State
+                    reset_mode_decision(scs_ptr,
+                                        context_ptr->md_context,
+                                        pcs_ptr,
+                                        context_ptr->tile_group_index,
+                                        segment_index);
+
+                    // Reset EncDec Coding State
+                    reset_enc_dec( // HT done
+                        context_ptr,
+                        pcs_ptr,
+                        scs_ptr,
+                        segment_index);
+                }
                 for (y_sb_index = y_sb_start_index, sb_segment_index = sb_start_index;
                      sb_segment_index < sb_start_index + sb_segment_count;
                      ++y_sb_index) {
@@ -6923,6 +7070,23 @@ void *mode_decision_kernel(void *input_ptr) {
                          (x_sb_index + y_sb_index < segment_band_size) &&
                          sb_segment_index < sb_start_index + sb_segment_count;
                          ++x_sb_index, ++sb_segment_index) {
+                        if (sb_wavefront) {
+                            // leave the row if its top-right SB is not coded yet
+                            if (!enc_dec_segments_sb_ready(segments_ptr, x_sb_index, y_sb_index) &&
+                                enc_dec_segments_park_sb_row(segments_ptr, y_sb_index)) {
+                                sb_segment_index = sb_start_index + sb_segment_count;
+                                break;
+                            }
+                            // each SB is a segment of its own
+                            const uint32_t sb_segment = y_sb_index * tile_group_width_in_sb +
+                                x_sb_index;
+                            reset_mode_decision(scs_ptr,
+                                                context_ptr->md_context,
+                                                pcs_ptr,
+                                                context_ptr->tile_group_index,
+                                                sb_segment);
+                            reset_enc_dec(context_ptr, pcs_ptr, scs_ptr, sb_segment);
+                        }
                         uint16_t tile_group_y_sb_start =
                             pcs_ptr->parent_pcs_ptr->tile_group_info[context_ptr->tile_group_index]
                                 .tile_group_sb_start_y;
@@ -7219,6 +7383,24 @@ void *mode_decision_kernel(void *input_ptr) {
                                           context_ptr);
 
                         context_ptr->coded_sb_count++;
+                        if (pcs_ptr->cdef_search_wavefront)
+                            post_cdef_search_rows(context_ptr,
+                                                  pcs_ptr,
+                                                  enc_dec_tasks_ptr->pcs_wrapper_ptr,
+                                                  y_sb_index + tile_group_y_sb_start);
+                        if (sb_wavefront) {
+                            const int32_t ready_row = enc_dec_segments_sb_done(segments_ptr,
+                                                                               y_sb_index);
+                            if (ready_row >= 0)
+                                post_enc_dec_sb_row(context_ptr,
+                                                    enc_dec_tasks_ptr,
+                                                    segments_ptr,
+                                                    (uint32_t)ready_row);
+                            else if (y_sb_index + 1 == segments_ptr->sb_row_count &&
+                                     x_sb_index + 1 == tile_group_width_in_sb)
+                                enc_dec_wavefront_queue_remove(context_ptr->wavefront_queue,
+                                                               segments_ptr);
+                        }
                     }
                     x_sb_start_index = (x_sb_start_index > 0) ? x_sb_start_index - 1 : 0;
                 }
@@ -7309,6 +7491,8 @@ void *mode_decision_kernel(void *input_ptr) {
                                          &enc_dec_results_wrapper_ptr);
                     enc_dec_results_ptr = (EncDecResults *)enc_dec_results_wrapper_ptr->object_ptr;
                     enc_dec_results_ptr->pcs_wrapper_ptr = enc_dec_tasks_ptr->pcs_wrapper_ptr;
+                    enc_dec_results_ptr->partial         = FALSE;
+                    enc_dec_results_ptr->dlf_segments    = FALSE;
 
                     // Post EncDec Results
                     svt_post_full_object(enc_dec_results_wrapper_ptr);
@@ -7322,7 +7506,7 @@ void *mode_decision_kernel(void *input_ptr) {
 }
 
 void svt_av1_add_film_grain(EbPictureBufferDesc *src, EbPictureBufferDesc *dst,
-                            AomFilmGrain *film_grain_ptr) {
+                            AomFilmGrain *film_grain_ptr, SvtJobPool *job_pool) {
     uint8_t *luma, *cb, *cr;
     int32_t  height, width, luma_stride, chroma_stride;
     int32_t  use_high_bit_depth = 0;
@@ -7417,6 +7601,7 @@ void svt_av1_add_film_grain(EbPictureBufferDesc *src, EbPictureBufferDesc *dst,
                                chroma_stride,
                                use_high_bit_depth,
                                chroma_subsamp_y,
-                               chroma_subsamp_x);
+                               chroma_subsamp_x,
+                               job_pool);
     return;
 }
@@ -40,6 +40,7 @@ typedef struct EncDecContext {
     EbFifo              *enc_dec_output_fifo_ptr;
     EbFifo              *enc_dec_feedback_fifo_ptr;
     EbFifo              *picture_demux_output_fifo_ptr; // to picture-manager
+    EncDecWavefrontQueue *wavefront_queue;
     ModeDecisionContext *md_context;
     const BlockGeom     *blk_geom;
     // Coding Unit Workspace---------------------------
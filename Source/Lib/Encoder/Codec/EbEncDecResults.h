@@ -24,18 +24,32 @@ extern "C" {
 typedef struct EncDecResults {
     EbDctor          dctor;
     EbObjectWrapper *pcs_wrapper_ptr;
+    // Wavefront post-filtering: only CDEF search segment rows [cdef_seg_row_start,
+    // cdef_seg_row_end) are ready, the picture itself is not done
+    Bool    partial;
+    uint8_t cdef_seg_row_start;
+    uint8_t cdef_seg_row_end;
+    // Not a result: a DLF thread is asked to help with the DLF segments of the picture
+    Bool dlf_segments;
 } EncDecResults;
 
 typedef struct DlfResults {
     EbDctor          dctor;
     EbObjectWrapper *pcs_wrapper_ptr;
     uint32_t         segment_index;
+    // Not a result: a CDEF thread is asked to help with the CDEF segments of the picture
+    Bool cdef_segments;
 } DlfResults;
 
 typedef struct CdefResults {
     EbDctor          dctor;
     EbObjectWrapper *pcs_wrapper_ptr;
     uint32_t         segment_index;
+    // Not a result: a Rest thread is asked to help with the LR segments of the picture
+    Bool rest_segments;
+    // Not a result: a Rest thread is asked to build the sub-pel plane segment_index of the
+    // reference, see svt_subpel_ref_planes_build_plane()
+    EbObjectWrapper *subpel_ref_wrapper_ptr;
 } CdefResults;
 
 typedef struct RestResults {
@@ -26,6 +26,7 @@ static void enc_dec_segments_dctor(EbPtr p) {
     EB_FREE_ARRAY(obj->valid_sb_count_array);
     EB_FREE_ARRAY(obj->dep_map.dependency_map);
     EB_FREE_ARRAY(obj->row_array);
+    EB_FREE_ARRAY(obj->sb_row_array);
 
     EB_FREE_ARRAY(obj->dep_map.dependency_map);
     EB_FREE_ARRAY(obj->valid_sb_count_array);
@@ -66,11 +67,19 @@ EbErrorType enc_dec_segments_ctor(EncDecSegments *segments_ptr, uint32_t segment
         EB_CREATE_MUTEX(segments_ptr->row_array[row_index].assignment_mutex);
     }
 
+    // SB rows of the wavefront
+    EB_CALLOC_ARRAY(segments_ptr->sb_row_array, segments_ptr->segment_max_row_count);
+
     return EB_ErrorNone;
 }
 
 void enc_dec_segments_init(EncDecSegments *segments_ptr, uint32_t segColCount, uint32_t segRowCount,
                            uint32_t pic_width_sb, uint32_t pic_height_sb) {
+    segments_ptr->sb_wavefront = segColCount >= pic_width_sb && segRowCount >= pic_height_sb &&
+        pic_height_sb <= segments_ptr->segment_max_row_count;
+    segments_ptr->sb_col_count = pic_width_sb;
+    if (segments_ptr->sb_wavefront)
+        EB_MEMSET(segments_ptr->sb_row_array, 0, sizeof(EncDecSegSbRow) * pic_height_sb);
     segColCount = (segColCount < pic_width_sb) ? segColCount : pic_width_sb;
     segRowCount = (segRowCount < pic_height_sb) ? segRowCount : pic_height_sb;
     segRowCount = (segRowCount < segments_ptr->segment_max_row_count)
@@ -161,3 +170,98 @@ void enc_dec_segments_init(EncDecSegments *segments_ptr, uint32_t segColCount, u
 
     return;
 }
+
+/* TRUE when the top-right SB of the SB is coded (or out of the picture) */
+Bool enc_dec_segments_sb_ready(EncDecSegments *segments_ptr, uint32_t x_sb_index,
+                               uint32_t y_sb_index) {
+    if (y_sb_index == 0)
+        return TRUE;
+    const int32_t needed = (int32_t)AOMMIN(x_sb_index + 2, segments_ptr->sb_col_count);
+    return svt_atomic_load_i32(&segments_ptr->sb_row_array[y_sb_index - 1].progress) >= needed;
+}
+
+/* Parks the row whose next SB is not ready. Returns FALSE if the SB became ready meanwhile and
+ * the caller keeps the row, TRUE if the caller must leave it to be handed out again. */
+Bool enc_dec_segments_park_sb_row(EncDecSegments *segments_ptr, uint32_t y_sb_index) {
+    EncDecSegSbRow *sb_row = &segments_ptr->sb_row_array[y_sb_index];
+    svt_atomic_store_i32(&sb_row->parked, 1);
+    // the row above may have moved on before seeing the row parked
+    if (enc_dec_segments_sb_ready(
+            segments_ptr, (uint32_t)svt_atomic_load_i32(&sb_row->progress), y_sb_index) &&
+        svt_atomic_cas_i32(&sb_row->parked, 1, 0))
+        return FALSE;
+    return TRUE;
+}
+
+/* Counts the next SB of the row as coded. Returns the row below when it has to be handed out
+ * to a thread, i.e. when its first SB becomes ready or when it is parked on an SB that became
+ * ready, -1 otherwise. */
+int32_t enc_dec_segments_sb_done(EncDecSegments *segments_ptr, uint32_t y_sb_index) {
+    const int32_t progress = svt_atomic_add_i32(&segments_ptr->sb_row_array[y_sb_index].progress,
+                                                1);
+    if (y_sb_index + 1 >= segments_ptr->sb_row_count)
+        return -1;
+    EncDecSegSbRow *below = &segments_ptr->sb_row_array[y_sb_index + 1];
+    if (progress == (int32_t)AOMMIN(2, segments_ptr->sb_col_count))
+        return (int32_t)y_sb_index + 1;
+    if (svt_atomic_load_i32(&below->parked) &&
+        enc_dec_segments_sb_ready(
+            segments_ptr, (uint32_t)svt_atomic_load_i32(&below->progress), y_sb_index + 1) &&
+        svt_atomic_cas_i32(&below->parked, 1, 0))
+        return (int32_t)y_sb_index + 1;
+    return -1;
+}
+
+/* Adds the wavefront of the picture tile group, with its first row pending */
+void enc_dec_wavefront_queue_add(EncDecWavefrontQueue *queue, EncDecSegments *segments_ptr,
+                                 EbObjectWrapper *pcs_wrapper_ptr, uint64_t decode_order,
+                                 uint16_t tile_group_index) {
+    segments_ptr->pcs_wrapper_ptr  = pcs_wrapper_ptr;
+    segments_ptr->decode_order     = decode_order;
+    segments_ptr->tile_group_index = tile_group_index;
+    svt_block_on_mutex(queue->mutex);
+    EncDecSegments **link = &queue->head;
+    while (*link && (*link)->decode_order <= decode_order) link = &(*link)->next_wavefront;
+    segments_ptr->next_wavefront = *link;
+    *link                        = segments_ptr;
+    segments_ptr->sb_row_array[0].pending = TRUE;
+    segments_ptr->pending_sb_row_count    = 1;
+    svt_release_mutex(queue->mutex);
+}
+
+void enc_dec_wavefront_queue_post_row(EncDecWavefrontQueue *queue, EncDecSegments *segments_ptr,
+                                      uint32_t y_sb_index) {
+    svt_block_on_mutex(queue->mutex);
+    segments_ptr->sb_row_array[y_sb_index].pending = TRUE;
+    segments_ptr->pending_sb_row_count++;
+    svt_release_mutex(queue->mutex);
+}
+
+/* Takes the first pending row of the oldest picture, NULL if no row is pending */
+EncDecSegments *enc_dec_wavefront_queue_take_row(EncDecWavefrontQueue *queue,
+                                                 uint32_t             *y_sb_index) {
+    svt_block_on_mutex(queue->mutex);
+    EncDecSegments *segments_ptr = queue->head;
+    while (segments_ptr && !segments_ptr->pending_sb_row_count)
+        segments_ptr = segments_ptr->next_wavefront;
+    if (segments_ptr) {
+        uint32_t y = 0;
+        while (!segments_ptr->sb_row_array[y].pending) y++;
+        segments_ptr->sb_row_array[y].pending = FALSE;
+        segments_ptr->pending_sb_row_count--;
+        *y_sb_index = y;
+    }
+    svt_release_mutex(queue->mutex);
+    return segments_ptr;
+}
+
+/* Removes the wavefront once all its SBs are coded */
+void enc_dec_wavefront_queue_remove(EncDecWavefrontQueue *queue, EncDecSegments *segments_ptr) {
+    svt_block_on_mutex(queue->mutex);
+    EncDecSegments **link = &queue->head;
+    while (*link && *link != segments_ptr) link = &(*link)->next_wavefront;
+    if (*link)
+        *link = segments_ptr->next_wavefront;
+    segments_ptr->next_wavefront = NULL;
+    svt_release_mutex(queue->mutex);
+}
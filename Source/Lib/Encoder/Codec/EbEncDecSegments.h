@@ -15,6 +15,7 @@
 #include "EbDefinitions.h"
 #include "EbThreads.h"
 #include "EbObject.h"
+#include "EbSystemResourceManager.h"
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -54,6 +55,16 @@ typedef struct EncDecSegSegmentRow {
     EbHandle assignment_mutex;
 } EncDecSegSegmentRow;
 
+/* With single SB segments the picture is coded as a wavefront of SB rows instead: an SB
+ * waits for the top-right SB of the row above, a row being coded by one thread at a time. A
+ * thread reaching an SB whose top-right SB is not coded parks the row and leaves it; the thread
+ * coding the row above hands the row out again once the SB is ready. */
+typedef struct EncDecSegSbRow {
+    volatile int32_t progress; // SBs coded
+    volatile int32_t parked; // set while the row waits for the row above with no thread on it
+    Bool             pending; // handed out, not taken by a thread yet (under the queue mutex)
+} EncDecSegSbRow;
+
 /**************************************
      * ENCDEC Segments
      **************************************/
@@ -61,6 +72,14 @@ typedef struct EncDecSegments {
     EbDctor                dctor;
     EncDecSegDependencyMap dep_map;
     EncDecSegSegmentRow   *row_array;
+    EncDecSegSbRow        *sb_row_array;
+    Bool                   sb_wavefront;
+    // wavefront queue entry
+    struct EncDecSegments *next_wavefront;
+    EbObjectWrapper       *pcs_wrapper_ptr;
+    uint64_t               decode_order;
+    uint16_t               tile_group_index;
+    uint32_t               pending_sb_row_count;
 
     uint16_t *x_start_array;
     uint16_t *y_start_array;
@@ -71,6 +90,7 @@ typedef struct EncDecSegments {
     uint32_t segment_ttl_count;
     uint32_t sb_band_count;
     uint32_t sb_row_count;
+    uint32_t sb_col_count;
 
     uint32_t segment_max_band_count;
     uint32_t segment_max_row_count;
@@ -86,6 +106,29 @@ extern EbErrorType enc_dec_segments_ctor(EncDecSegments *segments_ptr, uint32_t
 extern void enc_dec_segments_init(EncDecSegments *segments_ptr, uint32_t col_count,
                                   uint32_t row_count, uint32_t pic_width_sb,
                                   uint32_t pic_height_sb);
+
+/* The SB wavefronts being coded, oldest picture first. The EncDec tasks of the wavefronts
+ * only stand for a row handed out: the thread taking a task codes the first pending row of
+ * the oldest picture, so that the pictures in flight do not all slow down together. */
+typedef struct EncDecWavefrontQueue {
+    EbHandle        mutex;
+    EncDecSegments *head;
+} EncDecWavefrontQueue;
+
+extern void enc_dec_wavefront_queue_add(EncDecWavefrontQueue *queue, EncDecSegments *segments_ptr,
+                                        EbObjectWrapper *pcs_wrapper_ptr, uint64_t decode_order,
+                                        uint16_t tile_group_index);
+extern void enc_dec_wavefront_queue_post_row(EncDecWavefrontQueue *queue,
+                                             EncDecSegments *segments_ptr, uint32_t y_sb_index);
+extern EncDecSegments *enc_dec_wavefront_queue_take_row(EncDecWavefrontQueue *queue,
+                                                        uint32_t             *y_sb_index);
+extern void enc_dec_wavefront_queue_remove(EncDecWavefrontQueue *queue,
+                                           EncDecSegments       *segments_ptr);
+
+extern Bool enc_dec_segments_sb_ready(EncDecSegments *segments_ptr, uint32_t x_sb_index,
+                                      uint32_t y_sb_index);
+extern Bool enc_dec_segments_park_sb_row(EncDecSegments *segments_ptr, uint32_t y_sb_index);
+extern int32_t enc_dec_segments_sb_done(EncDecSegments *segments_ptr, uint32_t y_sb_index);
 #ifdef __cplusplus
 }
 #endif
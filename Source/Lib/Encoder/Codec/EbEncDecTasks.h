@@ -22,6 +22,7 @@ extern "C" {
 #define ENCDEC_TASKS_ENCDEC_INPUT 1
 #define ENCDEC_TASKS_CONTINUE 2
 #define ENCDEC_TASKS_SUPERRES_INPUT 3
+#define ENCDEC_TASKS_WAVEFRONT_INPUT 4 // a row of an SB wavefront is pending
 
 /**************************************
      * Process Results
@@ -4992,6 +4992,68 @@ static uint8_t inter_chroma_4xn_pred(PictureControlSet *pcs, MacroBlockD *xd,
     return sub8x8_inter;
 }
 
+/*
+ * Copies the single reference luma prediction of the block from the sub-pel planes of its
+ * reference, returns FALSE when the planes do not hold it
+ */
+static Bool luma_pred_from_subpel_planes(SequenceControlSet *scs_ptr, PictureControlSet *pcs,
+                                         MvReferenceFrame rf, EbPictureBufferDesc *ref_pic,
+                                         MV mv, const ScaleFactors *sf, uint32_t interp_filters,
+                                         MacroBlockD *av1xd, int16_t pre_y, int16_t pre_x,
+                                         uint8_t bwidth, uint8_t bheight, uint8_t *dst_ptr,
+                                         int32_t dst_stride, uint8_t bit_depth, uint8_t is16bit) {
+    if (!scs_ptr->static_config.subpel_ref_planes || pcs == NULL || av1_is_scaled(sf))
+        return FALSE;
+    EbReferenceObject *ref_obj =
+        (EbReferenceObject *)pcs->ref_pic_ptr_array[get_list_idx(rf)][get_ref_frame_idx(rf)]
+            ->object_ptr;
+    SubpelRefPlanes *planes = &ref_obj->subpel_planes;
+    if (ref_obj->reference_picture != ref_pic || planes->bit_depth != bit_depth ||
+        planes->is_highbd != is16bit)
+        return FALSE;
+    SubpelParams subpel_params;
+    int32_t      pos_y, pos_x;
+    compute_subpel_params(scs_ptr,
+                          pre_y,
+                          pre_x,
+                          mv,
+                          sf,
+                          ref_pic->width,
+                          ref_pic->height,
+                          bwidth,
+                          bheight,
+                          av1xd,
+                          0,
+                          0,
+                          &subpel_params,
+                          &pos_y,
+                          &pos_x);
+    // the planes are interpolated with the 8-tap regular filters, the filters of the blocks of
+    // 4 samples having 4 taps
+    if (subpel_params.subpel_x &&
+        (bwidth <= 4 || av1_extract_interp_filter(interp_filters, 1) != EIGHTTAP_REGULAR))
+        return FALSE;
+    if (subpel_params.subpel_y &&
+        (bheight <= 4 || av1_extract_interp_filter(interp_filters, 0) != EIGHTTAP_REGULAR))
+        return FALSE;
+    int32_t        stride;
+    const uint8_t *src = svt_subpel_ref_planes_get(planes,
+                                                   pos_x,
+                                                   pos_y,
+                                                   subpel_params.subpel_x,
+                                                   subpel_params.subpel_y,
+                                                   bwidth,
+                                                   bheight,
+                                                   &stride);
+    if (!src)
+        return FALSE;
+    for (int32_t i = 0; i < bheight; i++)
+        svt_memcpy(dst_ptr + ((i * dst_stride) << is16bit),
+                   src + ((i * stride) << is16bit),
+                   bwidth << is16bit);
+    return TRUE;
+}
+
 EbErrorType av1_inter_prediction(
     SequenceControlSet *scs_ptr, PictureControlSet *pcs, uint32_t interp_filters,
     BlkStruct *blk_ptr, uint8_t ref_frame_type, MvUnit *mv_unit, uint8_t use_intrabc,
@@ -5105,33 +5167,50 @@ EbErrorType av1_inter_prediction(
                 ? &sf_identity
                 : &ref0_scale_factors;
 
-            enc_make_inter_predictor(scs_ptr,
-                                     src_ptr,
-                                     src_ptr_2b,
-                                     dst_ptr_y,
-                                     (int16_t)pu_origin_y,
-                                     (int16_t)pu_origin_x,
-                                     mv,
-                                     sf,
-                                     &conv_params_y,
-                                     interp_filters,
-                                     interinter_comp,
-                                     seg_mask,
-                                     ref_pic_list0->width,
-                                     ref_pic_list0->height,
-                                     bwidth,
-                                     bheight,
-                                     blk_geom->bsize,
-                                     blk_ptr->av1xd,
-                                     ref_pic_list0->stride_y,
-                                     pred_pic->stride_y,
-                                     0,
-                                     ss_y,
-                                     ss_x,
-                                     bit_depth,
-                                     use_intrabc,
-                                     0,
-                                     is16bit);
+            if (is_compound || use_intrabc ||
+                !luma_pred_from_subpel_planes(scs_ptr,
+                                              pcs,
+                                              rf[0],
+                                              ref_pic_list0,
+                                              mv,
+                                              sf,
+                                              interp_filters,
+                                              blk_ptr->av1xd,
+                                              (int16_t)pu_origin_y,
+                                              (int16_t)pu_origin_x,
+                                              bwidth,
+                                              bheight,
+                                              dst_ptr_y,
+                                              pred_pic->stride_y,
+                                              bit_depth,
+                                              is16bit))
+                enc_make_inter_predictor(scs_ptr,
+                                         src_ptr,
+                                         src_ptr_2b,
+                                         dst_ptr_y,
+                                         (int16_t)pu_origin_y,
+                                         (int16_t)pu_origin_x,
+                                         mv,
+                                         sf,
+                                         &conv_params_y,
+                                         interp_filters,
+                                         interinter_comp,
+                                         seg_mask,
+                                         ref_pic_list0->width,
+                                         ref_pic_list0->height,
+                                         bwidth,
+                                         bheight,
+                                         blk_geom->bsize,
+                                         blk_ptr->av1xd,
+                                         ref_pic_list0->stride_y,
+                                         pred_pic->stride_y,
+                                         0,
+                                         ss_y,
+                                         ss_x,
+                                         bit_depth,
+                                         use_intrabc,
+                                         0,
+                                         is16bit);
         }
 
         if (mv_unit->pred_direction == UNI_PRED_LIST_1 || mv_unit->pred_direction == BI_PRED) {
@@ -5159,33 +5238,51 @@ EbErrorType av1_inter_prediction(
                 ? &sf_identity
                 : &ref1_scale_factors;
 
-            enc_make_inter_predictor(scs_ptr,
-                                     src_ptr,
-                                     src_ptr_2b,
-                                     dst_ptr_y,
-                                     (int16_t)pu_origin_y,
-                                     (int16_t)pu_origin_x,
-                                     mv,
-                                     sf,
-                                     &conv_params_y,
-                                     interp_filters,
-                                     interinter_comp,
-                                     seg_mask,
-                                     ref_pic_list1->width,
-                                     ref_pic_list1->height,
-                                     bwidth,
-                                     bheight,
-                                     blk_geom->bsize,
-                                     blk_ptr->av1xd,
-                                     ref_pic_list1->stride_y,
-                                     pred_pic->stride_y,
-                                     0,
-                                     ss_y,
-                                     ss_x,
-                                     bit_depth,
-                                     use_intrabc,
-                                     is_compound && is_masked_compound_type(interinter_comp->type),
-                                     is16bit);
+            if (is_compound || use_intrabc ||
+                !luma_pred_from_subpel_planes(scs_ptr,
+                                              pcs,
+                                              rf[0],
+                                              ref_pic_list1,
+                                              mv,
+                                              sf,
+                                              interp_filters,
+                                              blk_ptr->av1xd,
+                                              (int16_t)pu_origin_y,
+                                              (int16_t)pu_origin_x,
+                                              bwidth,
+                                              bheight,
+                                              dst_ptr_y,
+                                              pred_pic->stride_y,
+                                              bit_depth,
+                                              is16bit))
+                enc_make_inter_predictor(scs_ptr,
+                                         src_ptr,
+                                         src_ptr_2b,
+                                         dst_ptr_y,
+                                         (int16_t)pu_origin_y,
+                                         (int16_t)pu_origin_x,
+                                         mv,
+                                         sf,
+                                         &conv_params_y,
+                                         interp_filters,
+                                         interinter_comp,
+                                         seg_mask,
+                                         ref_pic_list1->width,
+                                         ref_pic_list1->height,
+                                         bwidth,
+                                         bheight,
+                                         blk_geom->bsize,
+                                         blk_ptr->av1xd,
+                                         ref_pic_list1->stride_y,
+                                         pred_pic->stride_y,
+                                         0,
+                                         ss_y,
+                                         ss_x,
+                                         bit_depth,
+                                         use_intrabc,
+                                         is_compound &&
+                                             is_masked_compound_type(interinter_comp->type),
+                                         is16bit);
         }
     }
 
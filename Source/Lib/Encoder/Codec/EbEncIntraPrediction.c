@@ -732,6 +732,131 @@ void svt_av1_predict_intra_block_16bit(
         have_bottom_left ? AOMMIN(txhpx, yd) : 0, plane, bit_depth);
 }
 
+/* Builds the luma edges of the block shared by its non-directional intra candidates at tx depth 0.
+ * None of these modes reads the above-right or bottom-left samples, and the fill of a missing
+ * edge is the one V and H use when they return early, so one set of edges serves them all. */
+void svt_av1_build_intra_nd_edges(ModeDecisionContext *md_context_ptr) {
+    IntraNdEdges *const    edges    = md_context_ptr->intra_nd_edges;
+    const BlockGeom *const blk_geom = md_context_ptr->blk_geom;
+    const MacroBlockD *const xd     = md_context_ptr->blk_ptr->av1xd;
+    const TxSize  tx_size = blk_geom->txsize[0][0];
+    const int32_t txwpx   = tx_size_wide[tx_size];
+    const int32_t txhpx   = tx_size_high[tx_size];
+    // Distances between the right and bottom edges of the block and those of the frame
+    const int32_t xr        = (xd->mb_to_right_edge >> 3) + (blk_geom->bwidth - txwpx);
+    const int32_t yd        = (xd->mb_to_bottom_edge >> 3) + (blk_geom->bheight - txhpx);
+    const int32_t n_top_px  = xd->up_available ? AOMMIN(txwpx, xr + txwpx) : 0;
+    const int32_t n_left_px = xd->left_available ? AOMMIN(txhpx, yd + txhpx) : 0;
+    const int32_t top_left_offset =
+            md_context_ptr->blk_origin_x - md_context_ptr->blk_origin_y;
+    int32_t i;
+
+    memset(edges->above_data, 0x80, sizeof(edges->above_data));
+    memset(edges->left_data, 0x80, sizeof(edges->left_data));
+    if (!md_context_ptr->hbd_mode_decision) {
+        const NeighborArrayUnit *na = md_context_ptr->luma_recon_neighbor_array;
+        const uint8_t *above_ref = na->top_array + md_context_ptr->blk_origin_x;
+        const uint8_t *left_ref  = na->left_array + md_context_ptr->blk_origin_y;
+        uint8_t *const above_row = (uint8_t *)edges->above_data + 32;
+        uint8_t *const left_col  = (uint8_t *)edges->left_data + 32;
+
+        if (n_left_px > 0) {
+            for (i = 0; i < n_left_px; i++) left_col[i] = left_ref[i];
+            memset(&left_col[i], left_col[i - 1], txhpx - i);
+        }
+        else
+            memset(left_col, n_top_px > 0 ? above_ref[0] : 129, txhpx);
+        if (n_top_px > 0) {
+            svt_memcpy(above_row, above_ref, n_top_px);
+            memset(&above_row[n_top_px], above_row[n_top_px - 1], txwpx - n_top_px);
+        }
+        else
+            memset(above_row, n_left_px > 0 ? left_ref[0] : 127, txwpx);
+        if (n_top_px > 0 && n_left_px > 0)
+            above_row[-1] = na->top_left_array[na->max_pic_h + top_left_offset];
+        else if (n_top_px > 0)
+            above_row[-1] = above_ref[0];
+        else if (n_left_px > 0)
+            above_row[-1] = left_ref[0];
+        else
+            above_row[-1] = 128;
+        left_col[-1] = above_row[-1];
+    } else {
+        const NeighborArrayUnit *na = md_context_ptr->luma_recon_neighbor_array16bit;
+        const uint16_t *above_ref = (uint16_t *)na->top_array + md_context_ptr->blk_origin_x;
+        const uint16_t *left_ref  = (uint16_t *)na->left_array + md_context_ptr->blk_origin_y;
+        uint16_t *const above_row = edges->above_data + 16;
+        uint16_t *const left_col  = edges->left_data + 16;
+        const int32_t   base      = 128 << (EB_10BIT - 8);
+
+        if (n_left_px > 0) {
+            for (i = 0; i < n_left_px; i++) left_col[i] = left_ref[i];
+            svt_aom_memset16(&left_col[i], left_col[i - 1], txhpx - i);
+        }
+        else
+            svt_aom_memset16(left_col, n_top_px > 0 ? above_ref[0] : base + 1, txhpx);
+        if (n_top_px > 0) {
+            svt_memcpy(above_row, above_ref, n_top_px * sizeof(above_ref[0]));
+            svt_aom_memset16(&above_row[n_top_px], above_row[n_top_px - 1], txwpx - n_top_px);
+        }
+        else
+            svt_aom_memset16(above_row, n_left_px > 0 ? left_ref[0] : base - 1, txwpx);
+        if (n_top_px > 0 && n_left_px > 0)
+            above_row[-1] = ((uint16_t *)na->top_left_array)[na->max_pic_h + top_left_offset];
+        else if (n_top_px > 0)
+            above_row[-1] = above_ref[0];
+        else if (n_left_px > 0)
+            above_row[-1] = left_ref[0];
+        else
+            above_row[-1] = base;
+        left_col[-1] = above_row[-1];
+    }
+    edges->n_top_px  = n_top_px;
+    edges->n_left_px = n_left_px;
+    edges->ready     = TRUE;
+}
+
+/* Returns TRUE when the luma of the candidate is predicted from the edges built by
+ * svt_av1_build_intra_nd_edges */
+static Bool use_intra_nd_edges(const ModeDecisionContext *md_context_ptr,
+                               const ModeDecisionCandidate *candidate_ptr) {
+    const PredictionMode mode = candidate_ptr->pred_mode;
+    return md_context_ptr->intra_nd_edges->ready && candidate_ptr->tx_depth == 0 &&
+            (mode <= H_PRED || mode >= SMOOTH_PRED) && candidate_ptr->angle_delta[PLANE_TYPE_Y] == 0 &&
+            candidate_ptr->filter_intra_mode == FILTER_INTRA_MODES &&
+            !(candidate_ptr->palette_info && candidate_ptr->palette_size[0] > 0);
+}
+
+static void predict_intra_nd(const ModeDecisionContext *md_context_ptr, PredictionMode mode,
+                             EbPictureBufferDesc *prediction_ptr) {
+    const IntraNdEdges *const edges   = md_context_ptr->intra_nd_edges;
+    const TxSize              tx_size = md_context_ptr->blk_geom->txsize[0][0];
+    const int32_t             offset  = md_context_ptr->blk_geom->origin_x + prediction_ptr->origin_x +
+            (md_context_ptr->blk_geom->origin_y + prediction_ptr->origin_y) * prediction_ptr->stride_y;
+    const int32_t dc_left = edges->n_left_px > 0;
+    const int32_t dc_top  = edges->n_top_px > 0;
+
+    if (!md_context_ptr->hbd_mode_decision) {
+        uint8_t *const       dst       = prediction_ptr->buffer_y + offset;
+        const uint8_t *const above_row = (const uint8_t *)edges->above_data + 32;
+        const uint8_t *const left_col  = (const uint8_t *)edges->left_data + 32;
+        if (mode == DC_PRED)
+            dc_pred[dc_left][dc_top][tx_size](dst, prediction_ptr->stride_y, above_row, left_col);
+        else
+            eb_pred[mode][tx_size](dst, prediction_ptr->stride_y, above_row, left_col);
+    } else {
+        uint16_t *const       dst       = (uint16_t *)prediction_ptr->buffer_y + offset;
+        const uint16_t *const above_row = edges->above_data + 16;
+        const uint16_t *const left_col  = edges->left_data + 16;
+        if (mode == DC_PRED)
+            dc_pred_high[dc_left][dc_top][tx_size](
+                    dst, prediction_ptr->stride_y, above_row, left_col, EB_10BIT);
+        else
+            pred_high[mode][tx_size](
+                    dst, prediction_ptr->stride_y, above_row, left_col, EB_10BIT);
+    }
+}
+
 /** IntraPrediction()
 is the main function to compute intra prediction for a PU
 */
@@ -772,6 +897,10 @@ EbErrorType svt_av1_intra_prediction_cl(
             else
                 mode = candidate_buffer_ptr->candidate_ptr->pred_mode;
             assert(mode < INTRA_MODES);
+            if (plane == 0 && use_intra_nd_edges(md_context_ptr, candidate_buffer_ptr->candidate_ptr)) {
+                predict_intra_nd(md_context_ptr, mode, candidate_buffer_ptr->prediction_ptr);
+                continue;
+            }
              int ang = plane ? candidate_buffer_ptr->candidate_ptr->angle_delta[PLANE_TYPE_UV] : candidate_buffer_ptr->candidate_ptr->angle_delta[PLANE_TYPE_Y];
              if (ang==0 ){
                     IntraSize intra_size = intra_unit[mode];
@@ -907,6 +1036,10 @@ EbErrorType svt_av1_intra_prediction_cl(
                 mode = candidate_buffer_ptr->candidate_ptr->pred_mode;
 
             assert(mode < INTRA_MODES);
+            if (plane == 0 && use_intra_nd_edges(md_context_ptr, candidate_buffer_ptr->candidate_ptr)) {
+                predict_intra_nd(md_context_ptr, mode, candidate_buffer_ptr->prediction_ptr);
+                continue;
+            }
             int ang = plane ? candidate_buffer_ptr->candidate_ptr->angle_delta[PLANE_TYPE_UV] : candidate_buffer_ptr->candidate_ptr->angle_delta[PLANE_TYPE_Y];
             if (ang == 0) {
 
@@ -29,6 +29,8 @@ extern EbErrorType svt_av1_intra_prediction_cl(uint8_t                      hbd_
                                                struct ModeDecisionContext  *context_ptr,
                                                PictureControlSet           *pcs_ptr,
                                                ModeDecisionCandidateBuffer *candidate_buffer_ptr);
+// Builds the luma edges shared by the non-directional intra candidates of the block
+void svt_av1_build_intra_nd_edges(struct ModeDecisionContext *context_ptr);
 
 extern EbErrorType update_neighbor_samples_array_open_loop_mb(
     uint8_t use_top_righ_bottom_left, uint8_t update_top_neighbor, uint8_t *above_ref,
@@ -56,7 +56,10 @@ static void encode_context_dctor(EbPtr p) {
     EB_DESTROY_MUTEX(obj->shared_reference_mutex);
     EB_DESTROY_MUTEX(obj->stat_file_mutex);
     EB_DESTROY_MUTEX(obj->frame_updated_mutex);
+    EB_DESTROY_MUTEX(obj->enc_dec_wavefront_queue.mutex);
+    EB_DESTROY_MUTEX(obj->sub_frame_output_mutex);
     EB_DELETE(obj->prediction_structure_group_ptr);
+    analysis_file_close(&obj->analysis_file);
     EB_DELETE_PTR_ARRAY(obj->picture_decision_reorder_queue,
                         PICTURE_DECISION_REORDER_QUEUE_MAX_DEPTH);
     EB_FREE(obj->pre_assignment_buffer);
@@ -69,6 +72,10 @@ static void encode_context_dctor(EbPtr p) {
                         INITIAL_RATE_CONTROL_REORDER_QUEUE_MAX_DEPTH);
     EB_DELETE_PTR_ARRAY(obj->packetization_reorder_queue, PACKETIZATION_REORDER_QUEUE_MAX_DEPTH);
     EB_FREE(obj->stats_out.stat);
+    EB_FREE(obj->stats_out.new_stat);
+    EB_FREE_ARRAY(obj->stats_stream.stat);
+    EB_DESTROY_MUTEX(obj->stats_stream.mutex);
+    EB_FREE_ARRAY(obj->stats_buf_context.lap_stats);
     destroy_stats_buffer(&obj->stats_buf_context, obj->frame_stats_buffer);
     EB_DELETE_PTR_ARRAY(obj->rc.coded_frames_stat_queue, CODED_FRAMES_STAT_QUEUE_MAX_DEPTH);
 }
@@ -83,6 +90,7 @@ EbErrorType encode_context_ctor(EncodeContext *encode_context_ptr, EbPtr object_
 
     EB_CREATE_MUTEX(encode_context_ptr->total_number_of_recon_frame_mutex);
     EB_CREATE_MUTEX(encode_context_ptr->frame_updated_mutex);
+    EB_CREATE_MUTEX(encode_context_ptr->enc_dec_wavefront_queue.mutex);
     EB_ALLOC_PTR_ARRAY(encode_context_ptr->picture_decision_reorder_queue,
                        PICTURE_DECISION_REORDER_QUEUE_MAX_DEPTH);
 
@@ -157,6 +165,7 @@ EbErrorType encode_context_ctor(EncodeContext *encode_context_ptr, EbPtr object_
     encode_context_ptr->rc_cfg.min_cr                 = 0;
     EB_CREATE_MUTEX(encode_context_ptr->shared_reference_mutex);
     EB_CREATE_MUTEX(encode_context_ptr->stat_file_mutex);
+    EB_CREATE_MUTEX(encode_context_ptr->sub_frame_output_mutex);
     encode_context_ptr->num_lap_buffers = 0; //lap not supported for now
     int *num_lap_buffers                = &encode_context_ptr->num_lap_buffers;
     create_stats_buffer(&encode_context_ptr->frame_stats_buffer,
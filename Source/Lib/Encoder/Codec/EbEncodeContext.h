@@ -18,6 +18,9 @@
 #include "EbSvtAv1Enc.h"
 #include "EbPictureDecisionReorderQueue.h"
 #include "EbPictureDecisionQueue.h"
+#include "EbThreadBudget.h"
+#include "EbJobPool.h"
+#include "EbAnalysisFile.h"
 #include "EbPictureManagerQueue.h"
 #include "EbPacketizationReorderQueue.h"
 #include "EbInitialRateControlReorderQueue.h"
@@ -28,6 +31,7 @@
 #include "encoder.h"
 #include "firstpass.h"
 #include "EbRateControlProcess.h"
+#include "EbEncDecSegments.h"
 
 // *Note - the queues are small for testing purposes.  They should be increased when they are done.
 #define PRE_ASSIGNMENT_MAX_DEPTH 128 // should be large enough to hold an entire prediction period
@@ -68,10 +72,29 @@ typedef struct DPBInfo {
 
 typedef struct FirstPassStatsOut {
     FIRSTPASS_STATS *stat;
-    size_t           size;
+    size_t           size; // frames output
     size_t           capability;
+    // Incremental output (SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_NEW): stat[0] holds frame first,
+    // the frames before handed_out were copied to new_stat and are dropped but the last one.
+    size_t           first;
+    size_t           handed_out;
+    FIRSTPASS_STATS *new_stat;
+    size_t           new_capability;
 } FirstPassStatsOut;
 
+// First pass stats sent by svt_av1_enc_send_stats(), consumed in picture order by the look
+// ahead of the encoder
+typedef struct FirstPassStatsIn {
+    FIRSTPASS_STATS *stat;
+    uint32_t         capability;
+    uint32_t         head;
+    uint32_t         count;
+    FIRSTPASS_STATS  last; // stats of the previous picture
+    Bool             warned;
+    Bool             warned_repeated;
+    EbHandle         mutex;
+} FirstPassStatsIn;
+
 typedef struct EncodeContext {
     EbDctor dctor;
     // Callback Functions
@@ -131,6 +154,21 @@ typedef struct EncodeContext {
     // Packetization Reorder Queue
     PacketizationReorderEntry **packetization_reorder_queue;
     uint32_t                    packetization_reorder_queue_head_index;
+    // Sub-frame output: decode order of the next frame allowed to output partial packets,
+    // advanced by the packetization process once a frame has been fully output
+    EbHandle sub_frame_output_mutex;
+    uint64_t sub_frame_output_decode_order;
+    // Pictures with sub-frame output not fully entropy coded yet, indexed by decode order, so
+    // that the finished tiles of a frame are sent when it becomes the next one
+    struct PictureControlSet *sub_frame_pending[PACKETIZATION_REORDER_QUEUE_MAX_DEPTH];
+
+    // Adaptive thread allocation, updated by the packetization process
+    ThreadBudget thread_budget;
+    // threads of the parallel jobs run inside the processes, within the thread budget
+    SvtJobPool *job_pool;
+
+    // Motion analysis exported to / imported from a file, NULL when not used
+    AnalysisFile *analysis_file;
 
     // GOP Counters
     uint32_t intra_period_position; // Current position in intra period
@@ -191,12 +229,20 @@ typedef struct EncodeContext {
     STATS_BUFFER_CTX  stats_buf_context;
     SvtAv1FixedBuf    rc_stats_buffer; // replaced oxcf->two_pass_cfg.stats_in in aom
     FirstPassStatsOut stats_out;
+    FirstPassStatsIn  stats_stream;
     RecodeLoopType    recode_loop;
     // This feature controls the tolerence vs target used in deciding whether to
     // recode a frame. It has no meaning if recode is disabled.
     int      recode_tolerance;
     int32_t  frame_updated;
     EbHandle frame_updated_mutex;
+    // SB wavefronts in EncDec
+    EncDecWavefrontQueue enc_dec_wavefront_queue;
+    // DLF segment helper tasks sent, not taken yet
+    volatile int32_t dlf_seg_task_count;
+    // CDEF and LR segment helper tasks sent, not taken yet
+    volatile int32_t cdef_seg_task_count;
+    volatile int32_t rest_seg_task_count;
 } EncodeContext;
 
 typedef struct EncodeContextInitData {
@@ -2957,7 +2957,10 @@ static void write_tile_info(const PictureParentControlSet *const pcs_ptr,
                                    pcs_ptr->child_pcs->entropy_coding_info[tile_idx]
                                        ->entropy_coder_ptr->ec_writer.pos);
         }
-        if (max_tile_size >> 24 != 0)
+        // With sub-frame output the header is written before all tiles are coded
+        if (pcs_ptr->child_pcs->sub_frame_output)
+            pcs_ptr->child_pcs->tile_size_bytes_minus_1 = 3;
+        else if (max_tile_size >> 24 != 0)
             pcs_ptr->child_pcs->tile_size_bytes_minus_1 = 3;
         else if (max_tile_size >> 16 != 0)
             pcs_ptr->child_pcs->tile_size_bytes_minus_1 = 2;
@@ -4148,6 +4151,42 @@ static uint32_t write_tile_group_header(uint8_t *const dst, int startTile, int e
     return size;
 }
 
+/* Appends the entropy coded data of tiles [tile_start, tile_end] at data + curr_data_size.
+ * Every tile but the last one of the group is preceded by its size. Returns the new size. */
+static int32_t write_tile_group_data(OutputBitstreamUnit *output_bitstream_ptr, uint8_t **data_ptr,
+                                     int32_t curr_data_size, PictureControlSet *pcs_ptr,
+                                     int tile_start, int tile_end) {
+    uint8_t *data = *data_ptr;
+    for (int tile_idx = tile_start; tile_idx <= tile_end; tile_idx++) {
+        const int32_t tile_size =
+            pcs_ptr->entropy_coding_info[tile_idx]->entropy_coder_ptr->ec_writer.pos;
+        uint8_t tile_size_bytes = 0;
+        if (tile_idx != tile_end) {
+            tile_size_bytes = pcs_ptr->tile_size_bytes_minus_1 + 1;
+            mem_put_varsize(data + curr_data_size, tile_size_bytes, tile_size - 1);
+        }
+        OutputBitstreamUnit *ec_output_bitstream_ptr =
+            (OutputBitstreamUnit *)pcs_ptr->entropy_coding_info[tile_idx]
+                ->entropy_coder_ptr->ec_output_bitstream_ptr;
+        assert(output_bitstream_ptr->buffer_av1 >= output_bitstream_ptr->buffer_begin_av1);
+        // Size of the buffer needed to store all data; if buffer is too small, increase buffer size
+        uint32_t data_size = (uint32_t)tile_size + curr_data_size + tile_size_bytes +
+            10 /*MAX length_field_size*/ +
+            (uint32_t)(output_bitstream_ptr->buffer_av1 - output_bitstream_ptr->buffer_begin_av1);
+        if (output_bitstream_ptr->size < data_size) {
+            svt_realloc_output_bitstream_unit(output_bitstream_ptr,
+                                              data_size + 1); // plus one for good measure
+            data = output_bitstream_ptr->buffer_av1;
+        }
+        svt_memcpy(data + curr_data_size + tile_size_bytes,
+                   ec_output_bitstream_ptr->buffer_begin_av1,
+                   tile_size);
+        curr_data_size += (tile_size + tile_size_bytes);
+    }
+    *data_ptr = data;
+    return curr_data_size;
+}
+
 static uint32_t write_frame_header_obu(SequenceControlSet      *scs_ptr,
                                        PictureParentControlSet *pcs_ptr, uint8_t *const dst,
                                        uint8_t show_existing, int32_t appendTrailingBits) {
@@ -4239,34 +4278,8 @@ EbErrorType write_frame_header_av1(Bitstream *bitstream_ptr, SequenceControlSet
 
     if (!show_existing) {
         // Add data from EC stream to Picture Stream.
-        for (int tile_idx = 0; tile_idx < tile_cnt; tile_idx++) {
-            const int32_t tile_size =
-                pcs_ptr->entropy_coding_info[tile_idx]->entropy_coder_ptr->ec_writer.pos;
-            uint8_t tile_size_bytes = 0;
-            //tile_size += (tile_idx != tile_cnt - 1) ? 4 : 0;
-            if (tile_idx != tile_cnt - 1 && tile_cnt > 1) {
-                tile_size_bytes = pcs_ptr->tile_size_bytes_minus_1 + 1;
-                mem_put_varsize(data + curr_data_size, tile_size_bytes, tile_size - 1);
-            }
-            OutputBitstreamUnit *ec_output_bitstream_ptr =
-                (OutputBitstreamUnit *)pcs_ptr->entropy_coding_info[tile_idx]
-                    ->entropy_coder_ptr->ec_output_bitstream_ptr;
-            assert(output_bitstream_ptr->buffer_av1 >= output_bitstream_ptr->buffer_begin_av1);
-            // Size of the buffer needed to store all data; if buffer is too small, increase buffer size
-            uint32_t data_size = (uint32_t)tile_size + curr_data_size + tile_size_bytes +
-                10 /*MAX length_field_size*/ +
-                (uint32_t)(output_bitstream_ptr->buffer_av1 -
-                           output_bitstream_ptr->buffer_begin_av1);
-            if (output_bitstream_ptr->size < data_size) {
-                svt_realloc_output_bitstream_unit(output_bitstream_ptr,
-                                                  data_size + 1); // plus one for good measure
-                data = output_bitstream_ptr->buffer_av1;
-            }
-            svt_memcpy(data + curr_data_size + tile_size_bytes,
-                       ec_output_bitstream_ptr->buffer_begin_av1,
-                       tile_size);
-            curr_data_size += (tile_size + tile_size_bytes);
-        }
+        curr_data_size = write_tile_group_data(
+            output_bitstream_ptr, &data, curr_data_size, pcs_ptr, 0, tile_cnt - 1);
     }
     const uint32_t obu_payload_size  = curr_data_size - obu_header_size;
     const size_t   length_field_size = obu_mem_move(obu_header_size, obu_payload_size, data);
@@ -4280,6 +4293,62 @@ EbErrorType write_frame_header_av1(Bitstream *bitstream_ptr, SequenceControlSet
     return return_error;
 }
 
+/**************************************************
+* write_frame_header_obu_av1
+* Writes a standalone OBU_FRAME_HEADER, the tile data follows in
+* OBU_TILE_GROUPs (sub-frame output)
+**************************************************/
+EbErrorType write_frame_header_obu_av1(Bitstream *bitstream_ptr, SequenceControlSet *scs_ptr,
+                                       PictureControlSet *pcs_ptr) {
+    OutputBitstreamUnit *output_bitstream_ptr = (OutputBitstreamUnit *)
+                                                    bitstream_ptr->output_bitstream_ptr;
+    uint8_t *data = output_bitstream_ptr->buffer_av1;
+
+    const uint32_t obu_header_size  = write_obu_header(OBU_FRAME_HEADER, 0, data);
+    const uint32_t obu_payload_size = write_frame_header_obu(
+        scs_ptr, pcs_ptr->parent_pcs_ptr, data + obu_header_size, 0, 1);
+    const size_t length_field_size = obu_mem_move(obu_header_size, obu_payload_size, data);
+    if (write_uleb_obu_size(obu_header_size, obu_payload_size, data) != AOM_CODEC_OK) {
+        assert(0);
+    }
+    output_bitstream_ptr->buffer_av1 = data + obu_header_size + obu_payload_size +
+        length_field_size;
+    return EB_ErrorNone;
+}
+
+/**************************************************
+* write_tile_group_av1
+* Writes an OBU_TILE_GROUP holding tiles [tile_start, tile_end]
+**************************************************/
+EbErrorType write_tile_group_av1(Bitstream *bitstream_ptr, PictureControlSet *pcs_ptr,
+                                 uint16_t tile_start, uint16_t tile_end) {
+    OutputBitstreamUnit *output_bitstream_ptr = (OutputBitstreamUnit *)
+                                                    bitstream_ptr->output_bitstream_ptr;
+    Av1Common *const cm   = pcs_ptr->parent_pcs_ptr->av1_cm;
+    uint8_t         *data = output_bitstream_ptr->buffer_av1;
+
+    int32_t        curr_data_size  = write_obu_header(OBU_TILE_GROUP, 0, data);
+    const uint32_t obu_header_size = curr_data_size;
+    const int      n_log2_tiles    = cm->log2_tile_rows + cm->log2_tile_cols;
+    const uint16_t tile_cnt        = cm->tiles_info.tile_rows * cm->tiles_info.tile_cols;
+    // The range is implicit when the group holds all the tiles of the frame
+    const int tile_start_and_end_present_flag = tile_end - tile_start + 1 < tile_cnt;
+
+    curr_data_size += write_tile_group_header(
+        data + curr_data_size, tile_start, tile_end, n_log2_tiles, tile_start_and_end_present_flag);
+    curr_data_size = write_tile_group_data(
+        output_bitstream_ptr, &data, curr_data_size, pcs_ptr, tile_start, tile_end);
+
+    const uint32_t obu_payload_size  = curr_data_size - obu_header_size;
+    const size_t   length_field_size = obu_mem_move(obu_header_size, obu_payload_size, data);
+    if (write_uleb_obu_size(obu_header_size, obu_payload_size, data) != AOM_CODEC_OK) {
+        assert(0);
+    }
+    curr_data_size += (int32_t)length_field_size;
+    output_bitstream_ptr->buffer_av1 = data + curr_data_size;
+    return EB_ErrorNone;
+}
+
 /**************************************************
 * encode_sps_av1
 **************************************************/
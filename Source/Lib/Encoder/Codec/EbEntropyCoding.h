@@ -204,6 +204,12 @@ extern EbErrorType write_metadata_av1(Bitstream *bitstream_ptr, SvtMetadataArray
                                       const EbAv1MetadataType type);
 extern EbErrorType write_frame_header_av1(Bitstream *bitstream_ptr, SequenceControlSet *scs_ptr,
                                           PictureControlSet *pcs_ptr, uint8_t show_existing);
+extern EbErrorType write_frame_header_obu_av1(Bitstream *bitstream_ptr, SequenceControlSet *scs_ptr,
+                                              PictureControlSet *pcs_ptr);
+extern EbErrorType write_tile_group_av1(Bitstream *bitstream_ptr, PictureControlSet *pcs_ptr,
+                                        uint16_t tile_start, uint16_t tile_end);
+// Size of the temporal delimiter OBU written by encode_td_av1()
+#define TD_SIZE 2
 extern EbErrorType encode_td_av1(uint8_t *bitstream_ptr);
 extern EbErrorType encode_sps_av1(Bitstream *bitstream_ptr, SequenceControlSet *scs_ptr);
 
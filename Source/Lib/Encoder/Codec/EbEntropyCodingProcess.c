@@ -19,6 +19,8 @@
 #include "EbRateControlTasks.h"
 #include "EbCabacContextModel.h"
 #include "EbLog.h"
+#include "EbEntropyCoding.h"
+#include "EbTime.h"
 #include "common_dsp_rtcd.h"
 #define AV1_MIN_TILE_SIZE_BYTES 1
 void svt_av1_reset_loop_restoration(PictureControlSet *piCSetPtr, uint16_t tile_idx);
@@ -217,9 +219,152 @@ static void reset_entropy_coding_picture(EntropyCodingContext *context_ptr,
 
         entropy_coding_reset_neighbor_arrays(pcs_ptr, tile_idx);
     }
+
+    // Sub-frame output sends the frame header before the tiles are done, so it is only used for
+    // shown multi-tile frames that carry no metadata OBUs and are not recoded
+    const EbSvtAv1EncConfiguration *config = &scs_ptr->static_config;
+    pcs_ptr->sub_frame_output              = config->sub_frame_output && tile_cnt > 1 &&
+        frm_hdr->show_frame && !pcs_ptr->parent_pcs_ptr->input_ptr->metadata &&
+        pcs_ptr->parent_pcs_ptr->superres_total_recode_loop == 0 &&
+        !(frm_hdr->frame_type == KEY_FRAME &&
+          (config->mastering_display.max_luma || config->content_light_level.max_cll));
+    pcs_ptr->sub_frame_tiles_emitted = 0;
+    pcs_ptr->sub_frame_bytes_emitted = 0;
+    if (pcs_ptr->sub_frame_output) {
+        EncodeContext *encode_context_ptr = scs_ptr->encode_context_ptr;
+        svt_block_on_mutex(encode_context_ptr->sub_frame_output_mutex);
+        encode_context_ptr->sub_frame_pending[pcs_ptr->parent_pcs_ptr->decode_order %
+                                              PACKETIZATION_REORDER_QUEUE_MAX_DEPTH] = pcs_ptr;
+        svt_release_mutex(encode_context_ptr->sub_frame_output_mutex);
+    }
     return;
 }
 
+/**************************************************
+ * Sub-Frame Output
+ * Sends the finished leading tiles of the picture next in output order as a partial packet;
+ * the first one also carries the TD, the sequence header (key frames) and the frame header.
+ * Called with entropy_coding_pic_mutex held; output_stream_wrapper_ptr is an empty output
+ * buffer taken before the mutex, it is released when there is nothing to send.
+ **************************************************/
+static EbErrorType sub_frame_output(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr,
+                                    uint16_t tile_cnt, EbObjectWrapper *output_stream_wrapper_ptr) {
+    EncodeContext *encode_context_ptr = scs_ptr->encode_context_ptr;
+    EbErrorType    return_error       = EB_ErrorNone;
+
+    svt_block_on_mutex(encode_context_ptr->sub_frame_output_mutex);
+    uint16_t tile_start = pcs_ptr->sub_frame_tiles_emitted;
+    uint16_t tile_end   = tile_start;
+    if (pcs_ptr->parent_pcs_ptr->decode_order == encode_context_ptr->sub_frame_output_decode_order)
+        while (tile_end < tile_cnt &&
+               pcs_ptr->entropy_coding_info[tile_end]->entropy_coding_tile_done)
+            tile_end++;
+    if (tile_end > tile_start) {
+        Bitstream *bitstream_ptr = pcs_ptr->bitstream_ptr;
+        bitstream_reset(bitstream_ptr);
+        if (tile_start == 0) {
+            if (pcs_ptr->parent_pcs_ptr->frm_hdr.frame_type == KEY_FRAME)
+                encode_sps_av1(bitstream_ptr, scs_ptr);
+            write_frame_header_obu_av1(bitstream_ptr, scs_ptr, pcs_ptr);
+        }
+        write_tile_group_av1(bitstream_ptr, pcs_ptr, tile_start, tile_end - 1);
+        const uint32_t size    = (uint32_t)bitstream_get_bytes_count(bitstream_ptr);
+        const uint32_t td_size = tile_start == 0 ? TD_SIZE : 0;
+
+        EbBufferHeaderType *output_stream_ptr = (EbBufferHeaderType *)
+                                                    output_stream_wrapper_ptr->object_ptr;
+        output_stream_ptr->n_alloc_len = size + td_size;
+        EB_NO_THROW_MALLOC(output_stream_ptr->p_buffer, output_stream_ptr->n_alloc_len);
+        if (!output_stream_ptr->p_buffer) {
+            SVT_ERROR("failed to allocate sub-frame output buffer\n");
+            svt_release_object(output_stream_wrapper_ptr);
+            return_error = EB_ErrorInsufficientResources;
+        } else {
+            if (td_size)
+                encode_td_av1(output_stream_ptr->p_buffer);
+            bitstream_copy(bitstream_ptr, output_stream_ptr->p_buffer + td_size, size);
+            output_stream_ptr->n_filled_len = size + td_size;
+            output_stream_ptr->flags        = EB_BUFFERFLAG_PARTIAL |
+                (td_size ? EB_BUFFERFLAG_HAS_TD : 0);
+            output_stream_ptr->pts           = pcs_ptr->parent_pcs_ptr->input_ptr->pts;
+            output_stream_ptr->dts           = output_stream_ptr->pts;
+            output_stream_ptr->pic_type      = pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag
+                     ? pcs_ptr->parent_pcs_ptr->idr_flag ? EB_AV1_KEY_PICTURE : pcs_ptr->slice_type
+                     : EB_AV1_NON_REF_PICTURE;
+            output_stream_ptr->p_app_private = NULL;
+            output_stream_ptr->qp            = pcs_ptr->parent_pcs_ptr->picture_qp;
+            output_stream_ptr->luma_sse      = 0;
+            output_stream_ptr->cr_sse        = 0;
+            output_stream_ptr->cb_sse        = 0;
+            output_stream_ptr->luma_ssim     = 0;
+            output_stream_ptr->cr_ssim       = 0;
+            output_stream_ptr->cb_ssim       = 0;
+
+            uint64_t finish_time_seconds   = 0;
+            uint64_t finish_time_u_seconds = 0;
+            svt_av1_get_time(&finish_time_seconds, &finish_time_u_seconds);
+            output_stream_ptr->n_tick_count = (uint32_t)svt_av1_compute_overall_elapsed_time_ms(
+                pcs_ptr->parent_pcs_ptr->start_time_seconds,
+                pcs_ptr->parent_pcs_ptr->start_time_u_seconds,
+                finish_time_seconds,
+                finish_time_u_seconds);
+            svt_post_full_object(output_stream_wrapper_ptr);
+
+            pcs_ptr->sub_frame_tiles_emitted = tile_end;
+            pcs_ptr->sub_frame_bytes_emitted += size;
+        }
+    } else
+        svt_release_object(output_stream_wrapper_ptr);
+    svt_release_mutex(encode_context_ptr->sub_frame_output_mutex);
+    return return_error;
+}
+
+static Bool sub_frame_output_is_next(PictureControlSet *pcs_ptr, EncodeContext *encode_context_ptr) {
+    svt_block_on_mutex(encode_context_ptr->sub_frame_output_mutex);
+    const Bool is_next = pcs_ptr->parent_pcs_ptr->decode_order ==
+        encode_context_ptr->sub_frame_output_decode_order;
+    svt_release_mutex(encode_context_ptr->sub_frame_output_mutex);
+    return is_next;
+}
+
+/**************************************************
+ * Sub-Frame Output Advance
+ * Called by the packetization process once the next frame in decode order has been fully
+ * output. Moves on to the following frame and sends the tiles it finished while waiting.
+ * The packetization process releases the pictures, so a pending picture stays valid here.
+ **************************************************/
+void sub_frame_output_advance(EncodeContext *encode_context_ptr, uint64_t frames) {
+    svt_block_on_mutex(encode_context_ptr->sub_frame_output_mutex);
+    encode_context_ptr->sub_frame_output_decode_order += frames;
+    const uint64_t     decode_order = encode_context_ptr->sub_frame_output_decode_order;
+    PictureControlSet *pcs_ptr      = encode_context_ptr->sub_frame_pending[
+        decode_order % PACKETIZATION_REORDER_QUEUE_MAX_DEPTH];
+    if (pcs_ptr && pcs_ptr->parent_pcs_ptr->decode_order != decode_order)
+        pcs_ptr = NULL;
+    svt_release_mutex(encode_context_ptr->sub_frame_output_mutex);
+    if (!pcs_ptr)
+        return;
+
+    Av1Common *const cm       = pcs_ptr->parent_pcs_ptr->av1_cm;
+    const uint16_t   tile_cnt = cm->tiles_info.tile_rows * cm->tiles_info.tile_cols;
+    EbObjectWrapper *output_stream_wrapper_ptr;
+    svt_get_empty_object(encode_context_ptr->stream_output_fifo_ptr, &output_stream_wrapper_ptr);
+    svt_block_on_mutex(pcs_ptr->entropy_coding_pic_mutex);
+    Bool pic_ready = TRUE;
+    for (uint16_t i = 0; i < tile_cnt; i++) {
+        if (pcs_ptr->entropy_coding_info[i]->entropy_coding_tile_done == FALSE) {
+            pic_ready = FALSE;
+            break;
+        }
+    }
+    // A completed picture is sent whole by the packetization process
+    if (pic_ready)
+        svt_release_object(output_stream_wrapper_ptr);
+    else
+        sub_frame_output(pcs_ptr, pcs_ptr->scs_ptr, tile_cnt, output_stream_wrapper_ptr);
+    svt_release_mutex(pcs_ptr->entropy_coding_pic_mutex);
+}
+
 /* Entropy Coding */
 
 /*********************************************************************************
@@ -331,6 +476,15 @@ void *entropy_coding_kernel(void *input_ptr) {
         // Current tile ready
         encode_slice_finish(pcs_ptr->entropy_coding_info[tile_idx]->entropy_coder_ptr);
 
+        // Take the sub-frame output buffer before the picture mutex, waiting on a drained output
+        // pool must not block the other tiles of the picture. Only the next frame in decode order
+        // sends its tiles, the others are sent by sub_frame_output_advance() when it gets there.
+        EncodeContext   *encode_context_ptr    = scs_ptr->encode_context_ptr;
+        EbObjectWrapper *sub_frame_wrapper_ptr = NULL;
+        if (pcs_ptr->sub_frame_output && sub_frame_output_is_next(pcs_ptr, encode_context_ptr))
+            svt_get_empty_object(encode_context_ptr->stream_output_fifo_ptr,
+                                 &sub_frame_wrapper_ptr);
+
         svt_block_on_mutex(pcs_ptr->entropy_coding_pic_mutex);
         pcs_ptr->entropy_coding_info[tile_idx]->entropy_coding_tile_done = TRUE;
         for (uint16_t i = 0; i < tile_cnt; i++) {
@@ -339,7 +493,20 @@ void *entropy_coding_kernel(void *input_ptr) {
                 break;
             }
         }
+        if (sub_frame_wrapper_ptr && !pic_ready)
+            sub_frame_output(pcs_ptr, scs_ptr, tile_cnt, sub_frame_wrapper_ptr);
+        if (pcs_ptr->sub_frame_output && pic_ready) {
+            // The packetization process takes it from there
+            svt_block_on_mutex(encode_context_ptr->sub_frame_output_mutex);
+            PictureControlSet **pending = &encode_context_ptr->sub_frame_pending[
+                pcs_ptr->parent_pcs_ptr->decode_order % PACKETIZATION_REORDER_QUEUE_MAX_DEPTH];
+            if (*pending == pcs_ptr)
+                *pending = NULL;
+            svt_release_mutex(encode_context_ptr->sub_frame_output_mutex);
+        }
         svt_release_mutex(pcs_ptr->entropy_coding_pic_mutex);
+        if (sub_frame_wrapper_ptr && pic_ready)
+            svt_release_object(sub_frame_wrapper_ptr);
         if (pic_ready) {
             if (pcs_ptr->parent_pcs_ptr->superres_total_recode_loop == 0) {
                 // Release the List 0 Reference Pictures
@@ -76,5 +76,6 @@ extern EbErrorType entropy_coding_context_ctor(EbThreadContext   *thread_context
                                                int rate_control_index);
 
 extern void *entropy_coding_kernel(void *input_ptr);
+extern void  sub_frame_output_advance(EncodeContext *encode_context_ptr, uint64_t frames);
 
 #endif // EbEntropyCodingProcess_h
@@ -18,12 +18,91 @@
 #include "EbMotionEstimationProcess.h"
 #include "EbEncWarpedMotion.h"
 #include "EbUtility.h"
+#include "EbThreads.h"
 #include "global_motion.h"
 #include "corner_detect.h"
+#include "corner_match.h"
 // Normalized distortion-based thresholds
 #define GMV_ME_SAD_TH_0 0
 #define GMV_ME_SAD_TH_1 5
 #define GMV_ME_SAD_TH_2 10
+
+/*
+  Copies to corners the FAST corners of the source of a reference, detected by
+  the first picture using it at the downsampling level and returns their
+  count. The corners are detected without caching when they could not be
+  allocated.
+*/
+static int get_reference_corners(EbPaReferenceObject *reference_object, EbPictureBufferDesc *ref_pic,
+                                 int level, int width, int height, int *corners) {
+    unsigned char *ref_buffer = ref_pic->buffer_y + ref_pic->origin_x +
+        ref_pic->origin_y * ref_pic->stride_y;
+    int num_corners;
+    svt_block_on_mutex(reference_object->gm_corners_mutex);
+    if (reference_object->gm_corners_picture_number != reference_object->picture_number ||
+        reference_object->gm_corners_level != level ||
+        reference_object->gm_corners_width != width ||
+        reference_object->gm_corners_height != height) {
+        reference_object->gm_corners_picture_number = (uint64_t)~0;
+        if (!reference_object->gm_corners)
+            EB_NO_THROW_MALLOC(reference_object->gm_corners,
+                               sizeof(*reference_object->gm_corners) * 2 * MAX_CORNERS);
+        if (reference_object->gm_corners) {
+            reference_object->gm_num_corners = svt_av1_fast_corner_detect(
+                ref_buffer, width, height, ref_pic->stride_y, reference_object->gm_corners,
+                MAX_CORNERS);
+            reference_object->gm_corners_level          = level;
+            reference_object->gm_corners_width          = width;
+            reference_object->gm_corners_height         = height;
+            reference_object->gm_corners_picture_number = reference_object->picture_number;
+        }
+    }
+    if (reference_object->gm_corners_picture_number == reference_object->picture_number) {
+        num_corners = reference_object->gm_num_corners;
+        svt_memcpy(corners, reference_object->gm_corners, sizeof(*corners) * 2 * num_corners);
+    } else
+        num_corners = svt_av1_fast_corner_detect(
+            ref_buffer, width, height, ref_pic->stride_y, corners, MAX_CORNERS);
+    svt_release_mutex(reference_object->gm_corners_mutex);
+    return num_corners;
+}
+
+// global motion search of one reference
+typedef struct GmReferenceJob {
+    PictureParentControlSet *pcs_ptr;
+    EbPictureBufferDesc     *input_pic;
+    const int               *frm_corners;
+    int                      num_frm_corners;
+    EbPaReferenceObject     *reference_object;
+    EbPictureBufferDesc     *ref_pic;
+    EbWarpedMotionParams    *warped_motion;
+} GmReferenceJob;
+
+// runs the searches [first, end) of a GmReferenceJob array
+static int32_t gm_reference_jobs(void *ctx, int32_t first, int32_t end) {
+    GmReferenceJob *jobs = (GmReferenceJob *)ctx;
+    for (int32_t i = first; i < end; i++) {
+        GmReferenceJob *job = &jobs[i];
+        int             ref_corners[2 * MAX_CORNERS];
+        const int       num_ref_corners = get_reference_corners(job->reference_object,
+                                                          job->ref_pic,
+                                                          job->pcs_ptr->gm_ctrls.downsample_level,
+                                                          job->input_pic->width,
+                                                          job->input_pic->height,
+                                                          ref_corners);
+        compute_global_motion(job->pcs_ptr,
+                              job->input_pic,
+                              job->ref_pic,
+                              job->frm_corners,
+                              job->num_frm_corners,
+                              ref_corners,
+                              num_ref_corners,
+                              job->warped_motion,
+                              job->pcs_ptr->frm_hdr.allow_high_precision_mv);
+    }
+    return 1;
+}
+
 void global_motion_estimation(PictureParentControlSet *pcs_ptr,
                               EbPictureBufferDesc     *input_picture_ptr) {
     // Get downsampled pictures with a downsampling factor of 2 in each dimension
@@ -85,7 +164,25 @@ void global_motion_estimation(PictureParentControlSet *pcs_ptr,
                          100)))) // if more than 5% of SB(s) have stationary block(s) then shut gm
             global_motion_estimation_level = 0;
     }
-    if (global_motion_estimation_level)
+    if (global_motion_estimation_level) {
+        SvtJobPool    *job_pool = pcs_ptr->scs_ptr->encode_context_ptr->job_pool;
+        GmReferenceJob jobs[REF_LIST_MAX_DEPTH];
+        // Set the source picture to be used by the global motion search based
+        // on the input search mode, its corners serve all the references
+        if (pcs_ptr->gm_ctrls.downsample_level == GM_DOWN16)
+            input_picture_ptr = sixteenth_picture_ptr;
+        else if (pcs_ptr->gm_ctrls.downsample_level == GM_DOWN)
+            input_picture_ptr = quarter_picture_ptr;
+        int frm_corners[2 * MAX_CORNERS];
+        // compute interest points using FAST features
+        const int num_frm_corners = svt_av1_fast_corner_detect(
+            input_picture_ptr->buffer_y + input_picture_ptr->origin_x +
+                input_picture_ptr->origin_y * input_picture_ptr->stride_y,
+            input_picture_ptr->width,
+            input_picture_ptr->height,
+            input_picture_ptr->stride_y,
+            frm_corners,
+            MAX_CORNERS);
         for (uint32_t list_index = REF_LIST_0; list_index < num_of_list_to_search; ++list_index) {
             uint32_t num_of_ref_pic_to_search;
             num_of_ref_pic_to_search = pcs_ptr->slice_type == P_SLICE ? pcs_ptr->ref_list0_count_try
@@ -104,29 +201,31 @@ void global_motion_estimation(PictureParentControlSet *pcs_ptr,
                                        ->ref_pa_pic_ptr_array[list_index][ref_pic_index]
                                        ->object_ptr;
 
-                // Set the source and the reference picture to be used by the global motion search
+                // Set the reference picture to be used by the global motion search
                 // based on the input search mode
                 if (pcs_ptr->gm_ctrls.downsample_level == GM_DOWN16) {
                     sixteenth_ref_pic_ptr = (EbPictureBufferDesc *)
                                                 reference_object->sixteenth_downsampled_picture_ptr;
-                    ref_picture_ptr   = sixteenth_ref_pic_ptr;
-                    input_picture_ptr = sixteenth_picture_ptr;
+                    ref_picture_ptr = sixteenth_ref_pic_ptr;
                 } else if (pcs_ptr->gm_ctrls.downsample_level == GM_DOWN) {
                     quarter_ref_pic_ptr = (EbPictureBufferDesc *)
                                               reference_object->quarter_downsampled_picture_ptr;
-                    ref_picture_ptr   = quarter_ref_pic_ptr;
-                    input_picture_ptr = quarter_picture_ptr;
+                    ref_picture_ptr = quarter_ref_pic_ptr;
                 } else {
                     ref_picture_ptr = (EbPictureBufferDesc *)
                                           reference_object->input_padded_picture_ptr;
                 }
 
-                compute_global_motion(pcs_ptr,
-                                      input_picture_ptr,
-                                      ref_picture_ptr,
-                                      &pcs_ptr->global_motion_estimation[list_index][ref_pic_index],
-                                      pcs_ptr->frm_hdr.allow_high_precision_mv);
+                jobs[ref_pic_index].pcs_ptr          = pcs_ptr;
+                jobs[ref_pic_index].input_pic        = input_picture_ptr;
+                jobs[ref_pic_index].frm_corners      = frm_corners;
+                jobs[ref_pic_index].num_frm_corners  = num_frm_corners;
+                jobs[ref_pic_index].reference_object = reference_object;
+                jobs[ref_pic_index].ref_pic          = ref_picture_ptr;
+                jobs[ref_pic_index].warped_motion =
+                    &pcs_ptr->global_motion_estimation[list_index][ref_pic_index];
             }
+            svt_job_pool_run(job_pool, gm_reference_jobs, jobs, (int32_t)num_of_ref_pic_to_search);
 
             if (pcs_ptr->gm_ctrls.identiy_exit) {
                 if (list_index == 0) {
@@ -136,6 +235,7 @@ void global_motion_estimation(PictureParentControlSet *pcs_ptr,
                 }
             }
         }
+    }
     for (uint32_t list_index = REF_LIST_0; list_index < num_of_list_to_search; ++list_index) {
         uint32_t num_of_ref_pic_to_search = pcs_ptr->slice_type == P_SLICE
             ? pcs_ptr->ref_list0_count
@@ -153,8 +253,9 @@ void global_motion_estimation(PictureParentControlSet *pcs_ptr,
 }
 
 void compute_global_motion(PictureParentControlSet *pcs_ptr, EbPictureBufferDesc *input_pic,
-                           EbPictureBufferDesc *ref_pic, EbWarpedMotionParams *bestWarpedMotion,
-                           int allow_high_precision_mv) {
+                           EbPictureBufferDesc *ref_pic, const int *frm_corners,
+                           int num_frm_corners, const int *ref_corners, int num_ref_corners,
+                           EbWarpedMotionParams *bestWarpedMotion, int allow_high_precision_mv) {
     MotionModel params_by_motion[RANSAC_NUM_MOTIONS];
     for (int m = 0; m < RANSAC_NUM_MOTIONS; m++) {
         memset(&params_by_motion[m], 0, sizeof(params_by_motion[m]));
@@ -180,16 +281,24 @@ void compute_global_motion(PictureParentControlSet *pcs_ptr, EbPictureBufferDesc
     // TODO: check ref_params
     const EbWarpedMotionParams *ref_params = &default_warp_params;
 
-    {
-        int frm_corners[2 * MAX_CORNERS], inliers_by_motion[RANSAC_NUM_MOTIONS];
-        // compute interest points using FAST features
-        int num_frm_corners = svt_av1_fast_corner_detect(frm_buffer,
-                                                         input_pic->width,
-                                                         input_pic->height,
-                                                         input_pic->stride_y,
-                                                         frm_corners,
-                                                         MAX_CORNERS);
+    // find correspondences between the two images, the same for all the models
+    int *correspondences     = (int *)malloc(num_frm_corners * 4 * sizeof(*correspondences));
+    int  num_correspondences = correspondences
+         ? svt_av1_determine_correspondence(frm_buffer,
+                                           (int *)frm_corners,
+                                           num_frm_corners,
+                                           ref_buffer,
+                                           (int *)ref_corners,
+                                           num_ref_corners,
+                                           input_pic->width,
+                                           input_pic->height,
+                                           input_pic->stride_y,
+                                           ref_pic->stride_y,
+                                           correspondences)
+         : 0;
 
+    {
+        int                  inliers_by_motion[RANSAC_NUM_MOTIONS];
         TransformationType   model;
         EbWarpedMotionParams tmp_wm_params;
 #define GLOBAL_TRANS_TYPES_ENC 3
@@ -208,15 +317,8 @@ void compute_global_motion(PictureParentControlSet *pcs_ptr, EbPictureBufferDesc
             }
 
             svt_av1_compute_global_motion(model,
-                                          frm_buffer,
-                                          input_pic->width,
-                                          input_pic->height,
-                                          input_pic->stride_y,
-                                          frm_corners,
-                                          num_frm_corners,
-                                          ref_buffer,
-                                          ref_pic->stride_y,
-                                          EB_8BIT,
+                                          correspondences,
+                                          num_correspondences,
                                           gm_estimation_type,
                                           inliers_by_motion,
                                           params_by_motion,
@@ -297,5 +399,7 @@ void compute_global_motion(PictureParentControlSet *pcs_ptr, EbPictureBufferDesc
 
     *bestWarpedMotion = global_motion;
 
+    free(correspondences);
+
     for (int m = 0; m < RANSAC_NUM_MOTIONS; m++) { free(params_by_motion[m].inliers); }
 }
@@ -18,8 +18,11 @@
 
 void global_motion_estimation(PictureParentControlSet *pcs_ptr,
                               EbPictureBufferDesc     *input_picture_ptr);
+// Searches the global motion of ref_pic from input_pic, given the FAST corners
+// of both
 void compute_global_motion(PictureParentControlSet *pcs_ptr, EbPictureBufferDesc *input_pic,
-                           EbPictureBufferDesc *ref_pic, EbWarpedMotionParams *bestWarpedMotion,
-                           int allow_high_precision_mv);
+                           EbPictureBufferDesc *ref_pic, const int *frm_corners,
+                           int num_frm_corners, const int *ref_corners, int num_ref_corners,
+                           EbWarpedMotionParams *bestWarpedMotion, int allow_high_precision_mv);
 
 #endif // EbGlobalMotionEstimation_h
@@ -0,0 +1,295 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <string.h>
+
+#include "EbHpelCache.h"
+#include "EbUtility.h"
+#include "EbThreads.h"
+
+// padding read around the picture by the tiles of the blocks the cache holds: the blocks are at
+// most AOM_INTERP_EXTEND out of the picture, their tiles reach HPEL_CACHE_TILE - 1 further and
+// the 8-tap filters read 4 more samples
+#define HPEL_CACHE_PADDING (AOM_INTERP_EXTEND + HPEL_CACHE_TILE + 4)
+
+EbErrorType svt_hpel_cache_ctor(HpelCache *cache) {
+    memset(cache, 0, sizeof(*cache));
+    for (int i = 0; i < HPEL_PLANES; i++)
+        EB_MALLOC_ARRAY(cache->plane[i], HPEL_CACHE_WIN * HPEL_CACHE_WIN * sizeof(uint16_t));
+    return EB_ErrorNone;
+}
+
+void svt_hpel_cache_dctor(HpelCache *cache) {
+    for (int i = 0; i < HPEL_PLANES; i++) EB_FREE_ARRAY(cache->plane[i]);
+}
+
+void svt_hpel_cache_reset(HpelCache *cache, const ScaleFactors *sf, EbPictureBufferDesc *ref,
+                          uint16_t *ref_highbd, uint8_t bit_depth, int32_t block_x,
+                          int32_t block_y, int32_t block_size) {
+    cache->is_highbd  = bit_depth > EB_8BIT;
+    cache->bit_depth  = bit_depth;
+    cache->sf         = sf;
+    cache->ref_stride = ref->stride_y;
+    cache->width      = ref->width;
+    cache->height     = ref->height;
+    cache->ref        = (cache->is_highbd ? (uint8_t *)ref_highbd : ref->buffer_y) +
+        ((ref->origin_x + ref->origin_y * ref->stride_y) << cache->is_highbd);
+    cache->win_x      = block_x + (block_size - HPEL_CACHE_WIN) / 2;
+    cache->win_y      = block_y + (block_size - HPEL_CACHE_WIN) / 2;
+    cache->enabled    = ref->origin_x >= HPEL_CACHE_PADDING && ref->origin_y >= HPEL_CACHE_PADDING &&
+        ref->origin_bot_y >= HPEL_CACHE_PADDING &&
+        ref->stride_y - ref->width - ref->origin_x >= HPEL_CACHE_PADDING;
+    memset(cache->tile_done, 0, sizeof(cache->tile_done));
+}
+
+// Interpolates the tile of the plane with the convolution of the regular prediction
+static void hpel_cache_fill_tile(HpelCache *cache, HpelPlane plane, int32_t tile_x,
+                                 int32_t tile_y) {
+    const int32_t      x            = cache->win_x + tile_x * HPEL_CACHE_TILE;
+    const int32_t      y            = cache->win_y + tile_y * HPEL_CACHE_TILE;
+    const InterpFilters interp_filters = av1_make_interp_filters(EIGHTTAP_REGULAR,
+                                                                 EIGHTTAP_REGULAR);
+    // half-pel in 1/16 units
+    const int32_t half = (SUBPEL_SHIFTS / 2) << SCALE_EXTRA_BITS;
+    SubpelParams  subpel_params;
+    subpel_params.xs       = SCALE_SUBPEL_SHIFTS;
+    subpel_params.ys       = SCALE_SUBPEL_SHIFTS;
+    subpel_params.subpel_x = plane == HPEL_PLANE_V ? 0 : half;
+    subpel_params.subpel_y = plane == HPEL_PLANE_H ? 0 : half;
+    ConvolveParams conv_params = get_conv_params_no_round(
+        0, 0, 0, NULL, 0, 0, cache->bit_depth);
+    const int32_t offset = (tile_y * HPEL_CACHE_WIN + tile_x) * HPEL_CACHE_TILE;
+
+    if (cache->is_highbd)
+        svt_highbd_inter_predictor((uint16_t *)cache->ref + y * cache->ref_stride + x,
+                                   cache->ref_stride,
+                                   (uint16_t *)cache->plane[plane] + offset,
+                                   HPEL_CACHE_WIN,
+                                   &subpel_params,
+                                   cache->sf,
+                                   HPEL_CACHE_TILE,
+                                   HPEL_CACHE_TILE,
+                                   &conv_params,
+                                   interp_filters,
+                                   0, // use_intrabc
+                                   cache->bit_depth);
+    else
+        svt_inter_predictor(cache->ref + y * cache->ref_stride + x,
+                            cache->ref_stride,
+                            cache->plane[plane] + offset,
+                            HPEL_CACHE_WIN,
+                            &subpel_params,
+                            cache->sf,
+                            HPEL_CACHE_TILE,
+                            HPEL_CACHE_TILE,
+                            &conv_params,
+                            interp_filters,
+                            0); // use_intrabc
+    cache->tile_done[plane][tile_y * HPEL_CACHE_WIN_TILES + tile_x] = 1;
+    cache->tile_fills++;
+}
+
+const uint8_t *svt_hpel_cache_get(HpelCache *cache, int32_t x, int32_t y, MV mv, int32_t bw,
+                                  int32_t bh, int32_t *stride) {
+    // 1/8-pel mvs
+    const int32_t frac_x = mv.col & 7;
+    const int32_t frac_y = mv.row & 7;
+    if ((frac_x && frac_x != 4) || (frac_y && frac_y != 4))
+        return NULL;
+    // the block in the reference, the half-pel planes being aligned on the full-pel samples they
+    // follow
+    const int32_t pos_x = x + (mv.col >> 3);
+    const int32_t pos_y = y + (mv.row >> 3);
+    // the prediction clamps the mvs of the blocks far enough out of the picture
+    const Bool in_picture = cache->enabled && pos_x >= -AOM_INTERP_EXTEND &&
+        pos_y >= -AOM_INTERP_EXTEND && pos_x + bw <= cache->width + AOM_INTERP_EXTEND &&
+        pos_y + bh <= cache->height + AOM_INTERP_EXTEND;
+    if (!frac_x && !frac_y) {
+        if (!in_picture)
+            return NULL;
+        *stride = cache->ref_stride;
+        return cache->ref + ((pos_y * cache->ref_stride + pos_x) << cache->is_highbd);
+    }
+    const int32_t win_x = pos_x - cache->win_x;
+    const int32_t win_y = pos_y - cache->win_y;
+    if (!in_picture || win_x < 0 || win_y < 0 || win_x + bw > HPEL_CACHE_WIN ||
+        win_y + bh > HPEL_CACHE_WIN) {
+        cache->misses++;
+        return NULL;
+    }
+    const HpelPlane plane = !frac_y ? HPEL_PLANE_H : !frac_x ? HPEL_PLANE_V : HPEL_PLANE_D;
+    for (int32_t tile_y = win_y / HPEL_CACHE_TILE; tile_y <= (win_y + bh - 1) / HPEL_CACHE_TILE;
+         tile_y++)
+        for (int32_t tile_x = win_x / HPEL_CACHE_TILE;
+             tile_x <= (win_x + bw - 1) / HPEL_CACHE_TILE;
+             tile_x++)
+            if (!cache->tile_done[plane][tile_y * HPEL_CACHE_WIN_TILES + tile_x])
+                hpel_cache_fill_tile(cache, plane, tile_x, tile_y);
+    cache->hits++;
+    *stride = HPEL_CACHE_WIN;
+    return cache->plane[plane] + ((win_y * HPEL_CACHE_WIN + win_x) << cache->is_highbd);
+}
+
+// size of the tiles the reference planes are interpolated by, the tiles of the right and bottom
+// edges overlapping their neighbors
+#define SUBPEL_REF_PLANES_TILE 64
+// samples of the padding the 8-tap filters read around the planes
+#define SUBPEL_REF_PLANES_BORDER 8
+
+// phase step of the planes of a level, in 1/4 pel
+static INLINE int32_t subpel_ref_planes_step(uint8_t level) { return level > 1 ? 1 : 2; }
+
+uint64_t svt_subpel_ref_planes_size(uint8_t level, int32_t max_width, int32_t max_height,
+                                    int32_t padding, uint8_t is_highbd) {
+    const int32_t step   = subpel_ref_planes_step(level);
+    const int32_t phases = (4 / step) * (4 / step) - 1;
+    return (uint64_t)phases * (max_width + 2 * padding) * (max_height + 2 * padding)
+        << is_highbd;
+}
+
+EbErrorType svt_subpel_ref_planes_ctor(SubpelRefPlanes *planes, uint8_t level, int32_t max_width,
+                                       int32_t max_height, int32_t padding, uint8_t is_highbd) {
+    memset(planes, 0, sizeof(*planes));
+    planes->level     = level;
+    planes->is_highbd = is_highbd;
+    planes->stride    = max_width + 2 * padding;
+    planes->origin    = padding;
+    if (!level)
+        return EB_ErrorNone;
+    const int32_t step = subpel_ref_planes_step(level);
+    for (int32_t y = 0; y < 4; y += step)
+        for (int32_t x = 0; x < 4; x += step)
+            if (x || y)
+                EB_MALLOC_ARRAY(planes->plane[4 * y + x - 1],
+                                (size_t)planes->stride * (max_height + 2 * padding)
+                                    << is_highbd);
+    return EB_ErrorNone;
+}
+
+void svt_subpel_ref_planes_dctor(SubpelRefPlanes *planes) {
+    for (int i = 0; i < SUBPEL_REF_PLANES; i++) EB_FREE_ARRAY(planes->plane[i]);
+}
+
+// start of the tile of a row or column of tiles, the last one ending at the end
+static INLINE int32_t subpel_ref_planes_tile_start(int32_t start, int32_t end, int32_t t) {
+    return AOMMIN(start + t * SUBPEL_REF_PLANES_TILE, end - SUBPEL_REF_PLANES_TILE);
+}
+
+int32_t svt_subpel_ref_planes_start(SubpelRefPlanes *planes, const ScaleFactors *sf,
+                                    EbPictureBufferDesc *pic, uint8_t bit_depth) {
+    const int32_t step    = subpel_ref_planes_step(planes->level);
+    const int32_t padding = AOMMIN(
+        AOMMIN(AOMMIN(pic->origin_x, pic->origin_y), pic->origin_bot_y),
+        AOMMIN(pic->stride_y - pic->width - pic->origin_x, planes->origin));
+    planes->bit_depth = bit_depth;
+    planes->width     = pic->width;
+    planes->height    = pic->height;
+    planes->margin    = padding - SUBPEL_REF_PLANES_BORDER;
+    planes->pic       = pic;
+    planes->sf        = sf;
+    if (!planes->level || pic->width + 2 * planes->margin < SUBPEL_REF_PLANES_TILE ||
+        pic->height + 2 * planes->margin < SUBPEL_REF_PLANES_TILE)
+        return 0;
+    const int32_t count = (4 / step) * (4 / step) - 1;
+    svt_atomic_store_i32(&planes->planes_left, count);
+    return count;
+}
+
+Bool svt_subpel_ref_planes_build_plane(SubpelRefPlanes *planes, int32_t index) {
+    const InterpFilters interp_filters = av1_make_interp_filters(EIGHTTAP_REGULAR,
+                                                                 EIGHTTAP_REGULAR);
+    EbPictureBufferDesc *pic       = planes->pic;
+    const uint8_t        bit_depth = planes->bit_depth;
+    // the index-th held phase, the full-pel one excluded
+    const int32_t step   = subpel_ref_planes_step(planes->level);
+    const int32_t phases = 4 / step;
+    const int32_t px     = (index + 1) % phases * step;
+    const int32_t py     = (index + 1) / phases * step;
+    const int32_t x0     = -planes->margin;
+    const int32_t y0     = -planes->margin;
+    const int32_t x1     = pic->width + planes->margin;
+    const int32_t y1     = pic->height + planes->margin;
+    const int32_t tiles_x = (x1 - x0 + SUBPEL_REF_PLANES_TILE - 1) / SUBPEL_REF_PLANES_TILE;
+    const int32_t tiles_y = (y1 - y0 + SUBPEL_REF_PLANES_TILE - 1) / SUBPEL_REF_PLANES_TILE;
+    const uint8_t *ref    = pic->buffer_y +
+        ((pic->origin_y * pic->stride_y + pic->origin_x) << planes->is_highbd);
+
+    uint8_t *plane = planes->plane[4 * py + px - 1] +
+        ((planes->origin * planes->stride + planes->origin) << planes->is_highbd);
+    SubpelParams subpel_params;
+    subpel_params.xs       = SCALE_SUBPEL_SHIFTS;
+    subpel_params.ys       = SCALE_SUBPEL_SHIFTS;
+    subpel_params.subpel_x = (px * SUBPEL_SHIFTS / 4) << SCALE_EXTRA_BITS;
+    subpel_params.subpel_y = (py * SUBPEL_SHIFTS / 4) << SCALE_EXTRA_BITS;
+    for (int32_t ty = 0; ty < tiles_y; ty++) {
+        const int32_t y = subpel_ref_planes_tile_start(y0, y1, ty);
+        for (int32_t tx = 0; tx < tiles_x; tx++) {
+            const int32_t  x           = subpel_ref_planes_tile_start(x0, x1, tx);
+            ConvolveParams conv_params = get_conv_params_no_round(0, 0, 0, NULL, 0, 0, bit_depth);
+            if (planes->is_highbd)
+                svt_highbd_inter_predictor((const uint16_t *)ref + y * pic->stride_y + x,
+                                           pic->stride_y,
+                                           (uint16_t *)plane + y * planes->stride + x,
+                                           planes->stride,
+                                           &subpel_params,
+                                           planes->sf,
+                                           SUBPEL_REF_PLANES_TILE,
+                                           SUBPEL_REF_PLANES_TILE,
+                                           &conv_params,
+                                           interp_filters,
+                                           0, // use_intrabc
+                                           bit_depth);
+            else
+                svt_inter_predictor(ref + y * pic->stride_y + x,
+                                    pic->stride_y,
+                                    plane + y * planes->stride + x,
+                                    planes->stride,
+                                    &subpel_params,
+                                    planes->sf,
+                                    SUBPEL_REF_PLANES_TILE,
+                                    SUBPEL_REF_PLANES_TILE,
+                                    &conv_params,
+                                    interp_filters,
+                                    0); // use_intrabc
+        }
+    }
+    if (svt_atomic_add_i32(&planes->planes_left, -1) != 0)
+        return FALSE;
+    svt_atomic_store_i32(&planes->ready, 1);
+    return TRUE;
+}
+
+void svt_subpel_ref_planes_build(SubpelRefPlanes *planes, const ScaleFactors *sf,
+                                 EbPictureBufferDesc *pic, uint8_t bit_depth) {
+    const int32_t count = svt_subpel_ref_planes_start(planes, sf, pic, bit_depth);
+    for (int32_t index = 0; index < count; index++)
+        svt_subpel_ref_planes_build_plane(planes, index);
+}
+
+const uint8_t *svt_subpel_ref_planes_get(SubpelRefPlanes *planes, int32_t pos_x, int32_t pos_y,
+                                         int32_t subpel_x, int32_t subpel_y, int32_t bw,
+                                         int32_t bh, int32_t *stride) {
+    // 1/16-pel phases
+    const int32_t frac_x = subpel_x >> SCALE_EXTRA_BITS;
+    const int32_t frac_y = subpel_y >> SCALE_EXTRA_BITS;
+    if ((frac_x & 3) || (frac_y & 3) || (!frac_x && !frac_y))
+        return NULL;
+    const uint8_t *plane = planes->plane[frac_y + (frac_x >> 2) - 1];
+    if (!plane || !svt_atomic_load_i32(&planes->ready))
+        return NULL;
+    if (pos_x < -planes->margin || pos_y < -planes->margin ||
+        pos_x + bw > planes->width + planes->margin ||
+        pos_y + bh > planes->height + planes->margin)
+        return NULL;
+    *stride = planes->stride;
+    return plane +
+        (((planes->origin + pos_y) * planes->stride + planes->origin + pos_x) << planes->is_highbd);
+}
@@ -0,0 +1,133 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbHpelCache_h
+#define EbHpelCache_h
+
+#include "EbDefinitions.h"
+#include "EbPictureBufferDesc.h"
+#include "EbInterPrediction.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+/**************************************
+ * Defines
+ **************************************/
+#define HPEL_CACHE_TILE 16 // the planes are interpolated by tiles of 16x16 on first use
+// Memory cap: the window of the cache holds 8x8 tiles of each half-pel plane, 96 KB at 16 bits.
+// Centered on a 64x64 block, it holds the half-pel positions of the mvs up to 31 pixels.
+#define HPEL_CACHE_WIN_TILES 8
+#define HPEL_CACHE_WIN (HPEL_CACHE_TILE * HPEL_CACHE_WIN_TILES)
+
+typedef enum HpelPlane {
+    HPEL_PLANE_H, // x + 1/2
+    HPEL_PLANE_V, // y + 1/2
+    HPEL_PLANE_D, // x + 1/2, y + 1/2
+    HPEL_PLANES
+} HpelPlane;
+
+/**************************************
+ * Half-pel plane cache
+ *
+ * Holds the EIGHTTAP_REGULAR half-pel planes of a reference luma over a window, interpolated
+ * by the same convolutions as the regular prediction so that a block read from the planes is
+ * the prediction of its mv. The sub-pel searches of the blocks of the window share the planes
+ * instead of predicting each half-pel position of each block.
+ **************************************/
+typedef struct HpelCache {
+    uint8_t *plane[HPEL_PLANES]; // HPEL_CACHE_WIN x HPEL_CACHE_WIN samples of 8 or 16 bits
+    uint8_t  tile_done[HPEL_PLANES][HPEL_CACHE_WIN_TILES * HPEL_CACHE_WIN_TILES];
+    uint8_t *ref; // reference luma at the picture origin
+    int32_t  ref_stride;
+    int32_t  width;
+    int32_t  height;
+    int32_t  win_x; // window origin in the reference
+    int32_t  win_y;
+    uint8_t  bit_depth;
+    uint8_t  is_highbd;
+    Bool     enabled;
+    const ScaleFactors *sf;
+    // hit-rate counters of the half-pel positions
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t tile_fills;
+} HpelCache;
+
+extern EbErrorType svt_hpel_cache_ctor(HpelCache *cache);
+extern void        svt_hpel_cache_dctor(HpelCache *cache);
+// Points the cache to the luma of ref (ref_highbd when not NULL, in the geometry of ref) and
+// centers its window on the block_size block at (block_x, block_y), dropping the planes.
+extern void svt_hpel_cache_reset(HpelCache *cache, const ScaleFactors *sf, EbPictureBufferDesc *ref,
+                                 uint16_t *ref_highbd, uint8_t bit_depth, int32_t block_x,
+                                 int32_t block_y, int32_t block_size);
+// Returns the EIGHTTAP_REGULAR prediction of the bw x bh block at (x, y) for the full-pel or
+// half-pel mv, in the reference or the half-pel planes, or NULL when the cache does not hold it.
+// The returned samples are 16 bits wide for a high bit depth reference.
+extern const uint8_t *svt_hpel_cache_get(HpelCache *cache, int32_t x, int32_t y, MV mv,
+                                         int32_t bw, int32_t bh, int32_t *stride);
+
+/**************************************
+ * Sub-pel reference planes
+ *
+ * The EIGHTTAP_REGULAR sub-pel planes of a whole reference luma, built once the reference is
+ * padded so that the single reference predictions of the pictures using it at those positions
+ * are copies of the planes. Level 1 holds the 3 half-pel planes, level 2 the 15 half-pel and
+ * quarter-pel planes.
+ **************************************/
+#define SUBPEL_REF_PLANES 15 // the 1/4-pel phases but the full-pel one
+
+typedef struct SubpelRefPlanes {
+    // planes of the 1/4-pel phases, indexed by 4 * y phase + x phase - 1, NULL when not held
+    uint8_t *plane[SUBPEL_REF_PLANES];
+    uint8_t  level;
+    uint8_t  is_highbd;
+    uint8_t  bit_depth;
+    int32_t  stride; // geometry of the planes, the one of the padded reference
+    int32_t  origin;
+    int32_t  width; // picture the planes were built for
+    int32_t  height;
+    int32_t  margin; // extent of the planes around the picture
+    // reference the planes are interpolated from, and planes left to build, see
+    // svt_subpel_ref_planes_start()
+    EbPictureBufferDesc *pic;
+    const ScaleFactors  *sf;
+    volatile int32_t     planes_left;
+    // set once the planes of the reference are built, reset when the reference is recycled
+    volatile int32_t ready;
+} SubpelRefPlanes;
+
+// Memory of the planes of a reference of max_width x max_height padded by padding
+extern uint64_t    svt_subpel_ref_planes_size(uint8_t level, int32_t max_width, int32_t max_height,
+                                              int32_t padding, uint8_t is_highbd);
+extern EbErrorType svt_subpel_ref_planes_ctor(SubpelRefPlanes *planes, uint8_t level,
+                                              int32_t max_width, int32_t max_height,
+                                              int32_t padding, uint8_t is_highbd);
+extern void        svt_subpel_ref_planes_dctor(SubpelRefPlanes *planes);
+// Prepares the planes to be interpolated from the luma of the padded reference pic (16 bits
+// samples for a high bit depth reference), which must stay valid until they are built. Returns
+// the number of planes to build with svt_subpel_ref_planes_build_plane(), 0 when there is none.
+extern int32_t svt_subpel_ref_planes_start(SubpelRefPlanes *planes, const ScaleFactors *sf,
+                                           EbPictureBufferDesc *pic, uint8_t bit_depth);
+// Interpolates the index-th plane to build, the planes may be built in any order and on several
+// threads. Returns TRUE for the last plane built, the planes are then available.
+extern Bool svt_subpel_ref_planes_build_plane(SubpelRefPlanes *planes, int32_t index);
+// Interpolates all the planes and makes them available.
+extern void svt_subpel_ref_planes_build(SubpelRefPlanes *planes, const ScaleFactors *sf,
+                                        EbPictureBufferDesc *pic, uint8_t bit_depth);
+// Returns the bw x bh block at (pos_x, pos_y) of the plane of the subpel_x / subpel_y phase (in
+// the units of SubpelParams), or NULL when the planes do not hold it.
+extern const uint8_t *svt_subpel_ref_planes_get(SubpelRefPlanes *planes, int32_t pos_x,
+                                                int32_t pos_y, int32_t subpel_x, int32_t subpel_y,
+                                                int32_t bw, int32_t bh, int32_t *stride);
+#ifdef __cplusplus
+}
+#endif
+#endif // EbHpelCache_h
@@ -398,15 +398,18 @@ void process_lad_queue(InitialRateControlContext *ctx, uint8_t pass_thru) {
             if (head_pcs->scs_ptr->static_config.pass == ENC_MIDDLE_PASS ||
                 head_pcs->scs_ptr->static_config.pass == ENC_LAST_PASS ||
                 head_pcs->scs_ptr->lap_rc) {
+                STATS_BUFFER_CTX *stats_buf_ctx = head_pcs->scs_ptr->twopass.stats_buf_ctx;
+                const uint64_t    stats_count   = head_pcs->scs_ptr->lap_rc
+                         ? stats_buf_ctx->lap_stats_count
+                         : (uint64_t)(stats_buf_ctx->stats_in_end_write -
+                                   stats_buf_ctx->stats_in_start);
                 head_pcs->stats_in_offset     = head_pcs->decode_order;
                 head_pcs->stats_in_end_offset = head_pcs->ext_group_size &&
                         !(head_pcs->scs_ptr->static_config.pass == ENC_MIDDLE_PASS ||
                           head_pcs->scs_ptr->static_config.pass == ENC_LAST_PASS)
-                    ? MIN((uint64_t)(head_pcs->scs_ptr->twopass.stats_buf_ctx->stats_in_end_write -
-                                     head_pcs->scs_ptr->twopass.stats_buf_ctx->stats_in_start),
+                    ? MIN(stats_count,
                           head_pcs->stats_in_offset + (uint64_t)head_pcs->ext_group_size + 1)
-                    : (uint64_t)(head_pcs->scs_ptr->twopass.stats_buf_ctx->stats_in_end_write -
-                                 head_pcs->scs_ptr->twopass.stats_buf_ctx->stats_in_start);
+                    : stats_count;
                 head_pcs->frames_in_sw        = (int)(head_pcs->stats_in_end_offset -
                                                head_pcs->stats_in_offset);
                 if (head_pcs->scs_ptr->enable_dec_order == 0 && head_pcs->scs_ptr->lap_rc &&
@@ -414,14 +417,10 @@ void process_lad_queue(InitialRateControlContext *ctx, uint8_t pass_thru) {
                     for (uint64_t num_frames = head_pcs->stats_in_offset;
                          num_frames < head_pcs->stats_in_end_offset;
                          ++num_frames) {
-                        FIRSTPASS_STATS *cur_frame =
-                            head_pcs->scs_ptr->twopass.stats_buf_ctx->stats_in_start + num_frames;
-                        if ((int64_t)cur_frame->frame >
-                            head_pcs->scs_ptr->twopass.stats_buf_ctx->last_frame_accumulated) {
-                            svt_av1_accumulate_stats(
-                                head_pcs->scs_ptr->twopass.stats_buf_ctx->total_stats, cur_frame);
-                            head_pcs->scs_ptr->twopass.stats_buf_ctx->last_frame_accumulated =
-                                (int64_t)cur_frame->frame;
+                        FIRSTPASS_STATS *cur_frame = svt_av1_lap_stats(stats_buf_ctx, num_frames);
+                        if ((int64_t)cur_frame->frame > stats_buf_ctx->last_frame_accumulated) {
+                            svt_av1_accumulate_stats(stats_buf_ctx->total_stats, cur_frame);
+                            stats_buf_ctx->last_frame_accumulated = (int64_t)cur_frame->frame;
                         }
                     }
                 }
@@ -527,6 +526,11 @@ void *initial_rate_control_kernel(void *input_ptr) {
                 continue;
             }
 
+            // Store the motion analysis for later encodes of the same source
+            AnalysisFile *analysis_file = scs_ptr->encode_context_ptr->analysis_file;
+            if (analysis_file && analysis_file->write)
+                analysis_write_picture(analysis_file, pcs_ptr);
+
             if (pcs_ptr->picture_number == 0) {
                 Quants *const   quants_8bit = &scs_ptr->quants_8bit;
                 Dequants *const deq_8bit    = &scs_ptr->deq_8bit;
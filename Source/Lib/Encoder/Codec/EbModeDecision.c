@@ -4411,8 +4411,8 @@ void intra_bc_search(PictureControlSet *pcs, ModeDecisionContext *context_ptr,
             context_ptr->blk_geom->bheight == 4
         ? 1
         : 0;
-    svt_memcpy(&x->crc_calculator1, &pcs->crc_calculator1, sizeof(pcs->crc_calculator1));
-    svt_memcpy(&x->crc_calculator2, &pcs->crc_calculator2, sizeof(pcs->crc_calculator2));
+    x->crc_calculator1   = &pcs->crc_calculator1;
+    x->crc_calculator2   = &pcs->crc_calculator2;
     x->approx_inter_rate = context_ptr->approx_inter_rate;
     x->xd                = blk_ptr->av1xd;
     x->nmv_vec_cost      = context_ptr->md_rate_estimation_ptr->nmv_vec_cost;
@@ -26,6 +26,7 @@
 #include "EbCoefficients.h"
 #include "EbCommonUtils.h"
 #include "EbResize.h"
+#include "EbDlfProcess.h"
 
 int32_t get_qzbin_factor(int32_t q, AomBitDepth bit_depth);
 void    invert_quant(int16_t *quant, int16_t *shift, int32_t d);
@@ -1331,7 +1332,6 @@ void get_ref_skip_percentage(PictureControlSet *pcs_ptr, uint8_t *skip_area) {
 
     *skip_area = skip_perc;
 }
-void *rtime_alloc_block_hash_block_is_same(size_t size) { return malloc(size); }
 /* Mode Decision Configuration Kernel */
 
 /*********************************************************************************
@@ -1484,21 +1484,6 @@ void *mode_decision_configuration_kernel(void *input_ptr) {
 
             {
                 // add to hash table
-                const int pic_width  = pcs_ptr->parent_pcs_ptr->aligned_width;
-                const int pic_height = pcs_ptr->parent_pcs_ptr->aligned_height;
-
-                uint32_t *block_hash_values[2][2];
-                int8_t *  is_block_same[2][3];
-                int       k, j;
-
-                for (k = 0; k < 2; k++) {
-                    for (j = 0; j < 2; j++)
-                        block_hash_values[k][j] = rtime_alloc_block_hash_block_is_same(
-                            sizeof(uint32_t) * pic_width * pic_height);
-                    for (j = 0; j < 3; j++)
-                        is_block_same[k][j] = rtime_alloc_block_hash_block_is_same(
-                            sizeof(int8_t) * pic_width * pic_height);
-                }
                 pcs_ptr->hash_table.p_lookup_table = NULL;
                 rtime_alloc_svt_av1_hash_table_create(&pcs_ptr->hash_table);
                 Yv12BufferConfig cpi_source;
@@ -1508,33 +1493,13 @@ void *mode_decision_configuration_kernel(void *input_ptr) {
                 svt_av1_crc_calculator_init(&pcs_ptr->crc_calculator1, 24, 0x5D6DCB);
                 svt_av1_crc_calculator_init(&pcs_ptr->crc_calculator2, 24, 0x864CFB);
 
-                svt_av1_generate_block_2x2_hash_value(
-                    &cpi_source, block_hash_values[0], is_block_same[0], pcs_ptr);
-                uint8_t       src_idx = 0;
-                const uint8_t max_sb_size =
-                    pcs_ptr->parent_pcs_ptr->intraBC_ctrls.max_block_size_hash;
-                for (int size = 4; size <= max_sb_size; size <<= 1, src_idx = !src_idx) {
-                    const uint8_t dst_idx = !src_idx;
-                    svt_av1_generate_block_hash_value(&cpi_source,
-                                                      size,
-                                                      block_hash_values[src_idx],
-                                                      block_hash_values[dst_idx],
-                                                      is_block_same[src_idx],
-                                                      is_block_same[dst_idx],
-                                                      pcs_ptr);
-                    if (size != 4 || pcs_ptr->parent_pcs_ptr->intraBC_ctrls.hash_4x4_blocks)
-                        rtime_alloc_svt_av1_add_to_hash_map_by_row_with_precal_data(
-                            &pcs_ptr->hash_table,
-                            block_hash_values[dst_idx],
-                            is_block_same[dst_idx][2],
-                            pic_width,
-                            pic_height,
-                            size);
-                }
-                for (k = 0; k < 2; k++) {
-                    for (j = 0; j < 2; j++) free(block_hash_values[k][j]);
-                    for (j = 0; j < 3; j++) free(is_block_same[k][j]);
-                }
+                svt_av1_build_hash_table(
+                    &pcs_ptr->hash_table,
+                    &cpi_source,
+                    pcs_ptr->parent_pcs_ptr->intraBC_ctrls.hash_4x4_blocks ? 4 : 8,
+                    pcs_ptr->parent_pcs_ptr->intraBC_ctrls.max_block_size_hash,
+                    &pcs_ptr->crc_calculator1,
+                    &pcs_ptr->crc_calculator2);
             }
 
             svt_av1_init3smotion_compensation(
@@ -1661,6 +1626,30 @@ void *mode_decision_configuration_kernel(void *input_ptr) {
 
         uint16_t tg_count = pcs_ptr->parent_pcs_ptr->tile_group_cols *
             pcs_ptr->parent_pcs_ptr->tile_group_rows;
+        // Wavefront post-filtering: start the CDEF search on the SB rows EncDec has coded and
+        // deblocked, instead of on the whole picture. Needs in-loop SB deblocking (one tile group,
+        // 8-bit pipeline) and a picture EncDec will not code again.
+        pcs_ptr->cdef_search_wavefront = tg_count == 1 && !scs_ptr->is_16bit_pipeline &&
+            (!pcs_ptr->parent_pcs_ptr->dlf_ctrls.enabled ||
+             pcs_ptr->parent_pcs_ptr->dlf_ctrls.sb_based_dlf) &&
+            scs_ptr->seq_header.cdef_level && pcs_ptr->parent_pcs_ptr->cdef_level &&
+            !pcs_ptr->parent_pcs_ptr->cdef_ctrls.use_reference_cdef_fs &&
+            scs_ptr->static_config.superres_mode == SUPERRES_NONE &&
+            scs_ptr->static_config.pass != ENC_FIRST_PASS &&
+            !((scs_ptr->static_config.rate_control_mode == 1 ||
+               scs_ptr->static_config.max_bit_rate != 0) &&
+              scs_ptr->encode_context_ptr->recode_loop != DISALLOW_RECODE);
+        if (pcs_ptr->cdef_search_wavefront) {
+            const uint32_t pic_height_in_sb = (pcs_ptr->parent_pcs_ptr->aligned_height +
+                                               scs_ptr->sb_size_pix - 1) /
+                scs_ptr->sb_size_pix;
+            memset(pcs_ptr->enc_dec_sb_row_count,
+                   0,
+                   pic_height_in_sb * sizeof(*pcs_ptr->enc_dec_sb_row_count));
+            pcs_ptr->enc_dec_sb_rows_done = 0;
+            pcs_ptr->cdef_seg_rows_posted = 0;
+            cdef_search_init(pcs_ptr, scs_ptr);
+        }
         for (uint16_t tile_group_idx = 0; tile_group_idx < tg_count; tile_group_idx++) {
             svt_get_empty_object(context_ptr->mode_decision_configuration_output_fifo_ptr,
                                  &enc_dec_tasks_wrapper_ptr);
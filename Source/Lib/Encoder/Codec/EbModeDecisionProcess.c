@@ -52,6 +52,7 @@ static void mode_decision_context_dctor(EbPtr p) {
     EB_DELETE(obj->trans_quant_buffers_ptr);
     EB_FREE_ALIGNED_ARRAY(obj->cfl_temp_luma_recon16bit);
     EB_FREE_ALIGNED_ARRAY(obj->cfl_temp_luma_recon);
+    EB_FREE_ALIGNED(obj->intra_nd_edges);
     EB_FREE_ARRAY(obj->fast_candidate_array);
     EB_FREE_ARRAY(obj->fast_candidate_ptr_array);
     EB_FREE_2D(obj->injected_mvs);
@@ -200,6 +201,8 @@ EbErrorType mode_decision_context_ctor(ModeDecisionContext *context_ptr, EbColor
                           sizeof(uint16_t) * sb_size * sb_size);
     if (context_ptr->hbd_mode_decision != EB_10_BIT_MD)
         EB_MALLOC_ALIGNED(context_ptr->cfl_temp_luma_recon, sizeof(uint8_t) * sb_size * sb_size);
+    EB_MALLOC_ALIGNED(context_ptr->intra_nd_edges, sizeof(*context_ptr->intra_nd_edges));
+    context_ptr->intra_nd_edges->ready = FALSE;
     uint8_t use_update_cdf = 0;
     for (uint8_t is_islice = 0; is_islice < 2; is_islice++) {
         for (uint8_t is_base = 0; is_base < 2; is_base++) {
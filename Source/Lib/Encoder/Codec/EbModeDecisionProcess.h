@@ -526,6 +526,15 @@ typedef struct CandReductionCtrls {
     uint8_t                  reduce_unipred_candidates;
 
 } CandReductionCtrls;
+// The luma edges of the block at tx depth 0, built once by md_stage_0 for all its non-directional
+// intra candidates (DC, V, H, SMOOTH*, PAETH), which read the same samples
+typedef struct IntraNdEdges {
+    EB_ALIGN(32) uint16_t above_data[MAX_TX_SIZE * 2 + 48]; // 8 bit samples unless hbd MD
+    EB_ALIGN(32) uint16_t left_data[MAX_TX_SIZE * 2 + 48];
+    int32_t n_top_px;
+    int32_t n_left_px;
+    Bool    ready;
+} IntraNdEdges;
 typedef struct ModeDecisionContext {
     EbDctor dctor;
 
@@ -615,6 +624,7 @@ typedef struct ModeDecisionContext {
     int32_t is_inter_ctx;
     uint8_t intra_luma_left_mode;
     uint8_t intra_luma_top_mode;
+    IntraNdEdges *intra_nd_edges;
 
     EB_ALIGN(64)
     int16_t pred_buf_q3
@@ -1569,6 +1569,109 @@ void integer_search_b64(PictureParentControlSet *pcs_ptr, uint32_t b64_index, ui
     }
 }
 
+/*
+  Hash based search: the aligned 8x8 to 64x64 blocks of the 64x64 block are
+  looked up in the block hash table of each reference. A match replaces the
+  integer search result of the block when its SAD is lower, which finds the
+  scrolled or moved content of screen captures far outside the search area.
+*/
+static void hash_me_b64(MeContext *context_ptr, uint32_t b64_origin_x, uint32_t b64_origin_y) {
+    const Bool sub_sad = (context_ptr->me_search_method == SUB_SAD_SEARCH);
+    const int  max_mv  = (MV_UPP >> 3) - 1; // full-pel
+    uint32_t   hash_value1[HASH_B64_BLOCK_COUNT];
+    uint32_t   hash_value2[HASH_B64_BLOCK_COUNT];
+
+    svt_av1_get_b64_hash_values(context_ptr->b64_src_ptr,
+                                context_ptr->b64_src_stride,
+                                &context_ptr->crc_calculator1,
+                                &context_ptr->crc_calculator2,
+                                hash_value1,
+                                hash_value2);
+
+    for (uint32_t n_idx = 0; n_idx < SQUARE_PU_COUNT; n_idx++) {
+        // position of the block in the 64x64 block, blocks of the same size are in z-order
+        uint32_t x, y, size, hash_idx;
+        if (n_idx < ME_TIER_ZERO_PU_32x32_0) {
+            x = y    = 0;
+            size     = 64;
+            hash_idx = HASH_B64_64X64_OFFSET;
+        } else if (n_idx < ME_TIER_ZERO_PU_16x16_0) {
+            const uint32_t k = n_idx - ME_TIER_ZERO_PU_32x32_0;
+            x                = (k & 1) * 32;
+            y                = (k >> 1) * 32;
+            size             = 32;
+            hash_idx         = HASH_B64_32X32_OFFSET + (y >> 5) * 2 + (x >> 5);
+        } else if (n_idx < ME_TIER_ZERO_PU_8x8_0) {
+            const uint32_t k = n_idx - ME_TIER_ZERO_PU_16x16_0;
+            x                = ((k >> 2) & 1) * 32 + (k & 1) * 16;
+            y                = (k >> 3) * 32 + ((k >> 1) & 1) * 16;
+            size             = 16;
+            hash_idx         = HASH_B64_16X16_OFFSET + (y >> 4) * 4 + (x >> 4);
+        } else {
+            const uint32_t k = n_idx - ME_TIER_ZERO_PU_8x8_0;
+            x                = ((k >> 4) & 1) * 32 + ((k >> 2) & 1) * 16 + (k & 1) * 8;
+            y                = (k >> 5) * 32 + ((k >> 3) & 1) * 16 + ((k >> 1) & 1) * 8;
+            size             = 8;
+            hash_idx         = HASH_B64_8X8_OFFSET + (y >> 3) * 8 + (x >> 3);
+        }
+        if (x + size > context_ptr->block_width || y + size > context_ptr->block_height)
+            continue;
+        const int      blk_x   = (int)(b64_origin_x + x);
+        const int      blk_y   = (int)(b64_origin_y + y);
+        const uint8_t *src_ptr = context_ptr->b64_src_ptr + y * context_ptr->b64_src_stride + x;
+
+        for (uint32_t li = 0; li < context_ptr->num_of_list_to_search; li++) {
+            for (uint32_t ri = 0; ri < context_ptr->num_of_ref_pic_to_search[li]; ri++) {
+                HashTable *hash_table = context_ptr->hash_table[li][ri];
+                if (!hash_table || !context_ptr->search_results[li][ri].do_ref)
+                    continue;
+                const int count = svt_av1_hash_table_count(hash_table, hash_value1[hash_idx]);
+                if (!count)
+                    continue;
+                EbPictureBufferDesc *ref_pic_ptr = context_ptr->me_ds_ref_array[li][ri].picture_ptr;
+                const uint8_t       *ref_origin  = ref_pic_ptr->buffer_y + ref_pic_ptr->origin_x +
+                    ref_pic_ptr->origin_y * ref_pic_ptr->stride_y;
+                const uint32_t       best_mv     = context_ptr->p_sb_best_mv[li][ri][n_idx];
+                uint32_t             best_sad    = context_ptr->p_sb_best_sad[li][ri][n_idx];
+                int                  best_len    = (abs(_MVXT(best_mv)) + abs(_MVYT(best_mv))) >> 2;
+                int                  checked     = 0;
+                Iterator             iterator    = svt_av1_hash_get_first_iterator(
+                    hash_table, hash_value1[hash_idx]);
+                for (int i = 0; i < count && checked < context_ptr->hash_me_ctrls.max_matches;
+                     i++, iterator_increment(&iterator)) {
+                    const BlockHash *ref_block_hash = (BlockHash *)iterator_get(&iterator);
+                    if (ref_block_hash->hash_value2 != hash_value2[hash_idx])
+                        continue;
+                    checked++;
+                    const int mv_x = ref_block_hash->x - blk_x;
+                    const int mv_y = ref_block_hash->y - blk_y;
+                    if (abs(mv_x) > max_mv || abs(mv_y) > max_mv)
+                        continue;
+                    // same metric as the integer search
+                    const uint8_t *ref_ptr = ref_origin + ref_block_hash->y * ref_pic_ptr->stride_y +
+                        ref_block_hash->x;
+                    const uint32_t sad = svt_nxm_sad_kernel(src_ptr,
+                                                            context_ptr->b64_src_stride << sub_sad,
+                                                            ref_ptr,
+                                                            ref_pic_ptr->stride_y << sub_sad,
+                                                            size >> sub_sad,
+                                                            size)
+                        << sub_sad;
+                    // prefer the shortest of the equally good matches
+                    const int len = abs(mv_x) + abs(mv_y);
+                    if (sad < best_sad || (sad == best_sad && len < best_len)) {
+                        best_sad = sad;
+                        best_len = len;
+                        context_ptr->p_sb_best_sad[li][ri][n_idx] = sad;
+                        context_ptr->p_sb_best_mv[li][ri][n_idx] =
+                            ((uint32_t)(uint16_t)(mv_y * 4) << 16) | (uint16_t)(mv_x * 4);
+                    }
+                }
+            }
+        }
+    }
+}
+
 /*
   using previous stage ME results (Integer Search) for each reference
   frame. keep only the references that are close to the best reference.
@@ -2968,6 +3071,8 @@ EbErrorType motion_estimation_b64(
     }
     // Full pel: Perform the Integer Motion Estimation on the allowed refrence frames.
     integer_search_b64(pcs_ptr, b64_index, b64_origin_x, b64_origin_y, context_ptr, input_ptr);
+    if (context_ptr->me_type == ME_OPEN_LOOP && context_ptr->hash_me_ctrls.enabled)
+        hash_me_b64(context_ptr, b64_origin_x, b64_origin_y);
 
     // prune the refrence frames
     if (prune_ref && context_ptr->me_hme_prune_ctrls.enable_me_hme_ref_pruning) {
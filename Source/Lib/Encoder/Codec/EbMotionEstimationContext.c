@@ -14,18 +14,28 @@
 
 #include "EbMotionEstimationContext.h"
 #include "EbUtility.h"
+#include "EbLog.h"
 
 static void me_context_dctor(EbPtr p) {
     MeContext *obj = (MeContext *)p;
 
     EB_FREE_ARRAY(obj->mvd_bits_array);
     EB_FREE_ARRAY(obj->p_eight_pos_sad16x16);
+    if (obj->tf_hpel_cache.hits + obj->tf_hpel_cache.misses)
+        SVT_DEBUG("TF half-pel cache: %llu hits, %llu misses, %llu tiles interpolated\n",
+                  (unsigned long long)obj->tf_hpel_cache.hits,
+                  (unsigned long long)obj->tf_hpel_cache.misses,
+                  (unsigned long long)obj->tf_hpel_cache.tile_fills);
+    svt_hpel_cache_dctor(&obj->tf_hpel_cache);
 }
 EbErrorType me_context_ctor(MeContext *object_ptr) {
     object_ptr->dctor = me_context_dctor;
 
     EB_MALLOC_ARRAY(object_ptr->p_eight_pos_sad16x16,
                     8 * 16); //16= 16 16x16 blocks in a SB.       8=8search points
+    EbErrorType return_error = svt_hpel_cache_ctor(&object_ptr->tf_hpel_cache);
+    if (return_error != EB_ErrorNone)
+        return return_error;
 
     // Initialize Alt-Ref parameters
     object_ptr->me_type                     = ME_CLOSE_LOOP;
@@ -33,5 +43,9 @@ EbErrorType me_context_ctor(MeContext *object_ptr) {
     object_ptr->num_of_ref_pic_to_search[0] = 0;
     object_ptr->num_of_ref_pic_to_search[1] = 0;
 
+    // same polynomials as the intra block copy hash
+    svt_av1_crc_calculator_init(&object_ptr->crc_calculator1, 24, 0x5D6DCB);
+    svt_av1_crc_calculator_init(&object_ptr->crc_calculator2, 24, 0x864CFB);
+
     return EB_ErrorNone;
 }
@@ -16,6 +16,8 @@
 #include "EbMdRateEstimation.h"
 #include "EbCodingUnit.h"
 #include "EbObject.h"
+#include "hash.h"
+#include "EbHpelCache.h"
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -327,6 +329,10 @@ typedef struct MeHmeSearchAreaCtrls {
     SearchArea       hme_l2_sa[SEARCH_REGION_COUNT];
     SearchAreaMinMax me_sa[SEARCH_REGION_COUNT];
 } MeHmeSearchAreaCtrls;
+typedef struct HashMeCtrls {
+    uint8_t enabled; // look up the blocks of the SB in the hash tables of the references
+    uint8_t max_matches; // number of table entries checked per block and reference
+} HashMeCtrls;
 typedef struct SearchResults {
     uint8_t  list_i; // list index of this ref
     uint8_t  ref_i; // ref list index of this ref
@@ -441,6 +447,11 @@ typedef struct MeContext {
     uint8_t                     temporal_layer_index;
     Bool                        is_used_as_reference_flag;
     EbDownScaledBufDescPtrArray me_ds_ref_array[MAX_NUM_OF_REF_PIC_LIST][REF_LIST_MAX_DEPTH];
+    // hash based search
+    HashMeCtrls       hash_me_ctrls;
+    struct HashTable *hash_table[MAX_NUM_OF_REF_PIC_LIST][REF_LIST_MAX_DEPTH];
+    CRC_CALCULATOR    crc_calculator1;
+    CRC_CALCULATOR    crc_calculator2;
     // tf
     uint8_t      tf_chroma;
     int          tf_frame_index;
@@ -457,6 +468,7 @@ typedef struct MeContext {
     uint64_t     tf_32x32_block_error[4];
     int          tf_32x32_block_split_flag[4];
     int          tf_16x16_search_do[4];
+    HpelCache    tf_hpel_cache; // half-pel planes shared by the sub-pel searches of a 64x64 block
     int          tf_block_row;
     int          tf_block_col;
     uint32_t     idx_32x32;
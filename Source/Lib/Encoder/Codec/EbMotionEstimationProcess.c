@@ -328,6 +328,54 @@ void set_me_hme_ref_prune_ctrls(MeContext *context_ptr, uint8_t prune_level) {
     }
 }
 
+static void set_hash_me_ctrls(MeContext *context_ptr, uint8_t hash_me_level) {
+    HashMeCtrls *hash_me_ctrls = &context_ptr->hash_me_ctrls;
+
+    switch (hash_me_level) {
+    case 0: hash_me_ctrls->enabled = 0; break;
+    case 1:
+        hash_me_ctrls->enabled     = 1;
+        hash_me_ctrls->max_matches = 16;
+        break;
+    default: assert(0); break;
+    }
+}
+
+/*
+  Returns the block hash table of the source of a reference, built by the
+  first ME segment that needs it. NULL when it could not be allocated.
+*/
+static HashTable *get_pa_reference_hash_table(EbPaReferenceObject *reference_object,
+                                              MeContext           *me_context_ptr) {
+    svt_block_on_mutex(reference_object->hash_mutex);
+    if (reference_object->hash_picture_number != reference_object->picture_number) {
+        EbPictureBufferDesc *ref_pic_ptr = reference_object->input_padded_picture_ptr;
+        Yv12BufferConfig     ref_source;
+        memset(&ref_source, 0, sizeof(ref_source));
+        ref_source.y_buffer = ref_pic_ptr->buffer_y + ref_pic_ptr->origin_x +
+            ref_pic_ptr->origin_y * ref_pic_ptr->stride_y;
+        ref_source.y_stride      = ref_pic_ptr->stride_y;
+        ref_source.y_crop_width  = ref_pic_ptr->width;
+        ref_source.y_crop_height = ref_pic_ptr->height;
+
+        reference_object->hash_picture_number = (uint64_t)~0;
+        if (rtime_alloc_svt_av1_hash_table_create(&reference_object->hash_table) ==
+                EB_ErrorNone &&
+            svt_av1_build_hash_table(&reference_object->hash_table,
+                                     &ref_source,
+                                     8,
+                                     BLOCK_SIZE_64,
+                                     &me_context_ptr->crc_calculator1,
+                                     &me_context_ptr->crc_calculator2) == EB_ErrorNone)
+            reference_object->hash_picture_number = reference_object->picture_number;
+    }
+    HashTable *hash_table = reference_object->hash_picture_number == reference_object->picture_number
+        ? &reference_object->hash_table
+        : NULL;
+    svt_release_mutex(reference_object->hash_mutex);
+    return hash_table;
+}
+
 void set_me_sr_adjustment_ctrls(MeContext *context_ptr, uint8_t sr_adjustment_level) {
     MeSrCtrls *me_sr_adjustment_ctrls = &context_ptr->me_sr_adjustment_ctrls;
 
@@ -570,6 +618,11 @@ EbErrorType signal_derivation_me_kernel_oq(SequenceControlSet *       scs_ptr,
         context_ptr->me_context_ptr->prune_me_candidates_th = 0;
     else
         context_ptr->me_context_ptr->prune_me_candidates_th = 65;
+    // Hash based search finds the repeated content of screen captures at any distance
+    if (pcs_ptr->sc_class1 && !pcs_ptr->frame_superres_enabled)
+        set_hash_me_ctrls(context_ptr->me_context_ptr, 1);
+    else
+        set_hash_me_ctrls(context_ptr->me_context_ptr, 0);
     // Set signal at picture level b/c may check signal in MD
     context_ptr->me_context_ptr->use_best_unipred_cand_only =
         pcs_ptr->use_best_me_unipred_cand_only;
@@ -790,7 +843,8 @@ void *motion_estimation_kernel(void *input_ptr) {
                 skip_me = TRUE;
             // skip me for the first pass. ME is already performed
             if (!skip_me) {
-                if (pcs_ptr->slice_type != I_SLICE) {
+                // ME and GM results read from the analysis file are used as is
+                if (pcs_ptr->slice_type != I_SLICE && !pcs_ptr->me_imported) {
                     // Use scaled source references if resolution of the reference is different that of the input
                     use_scaled_source_refs_if_needed(pcs_ptr,
                                                      input_picture_ptr,
@@ -799,6 +853,20 @@ void *motion_estimation_kernel(void *input_ptr) {
                                                      &quarter_picture_ptr,
                                                      &sixteenth_picture_ptr);
 
+                    MeContext *me_context_ptr = context_ptr->me_context_ptr;
+                    memset(me_context_ptr->hash_table, 0, sizeof(me_context_ptr->hash_table));
+                    if (me_context_ptr->hash_me_ctrls.enabled) {
+                        const uint8_t list_count = pcs_ptr->slice_type == P_SLICE ? 1 : 2;
+                        for (uint8_t i = 0; i < list_count; i++) {
+                            const uint8_t ref_count = i == REF_LIST_0 ? pcs_ptr->ref_list0_count_try
+                                                                      : pcs_ptr->ref_list1_count_try;
+                            for (uint8_t j = 0; j < ref_count; j++)
+                                me_context_ptr->hash_table[i][j] = get_pa_reference_hash_table(
+                                    (EbPaReferenceObject *)pcs_ptr->ref_pa_pic_ptr_array[i][j]->object_ptr,
+                                    me_context_ptr);
+                        }
+                    }
+
                     // 64x64 Block Loop
                     for (uint32_t y_b64_index = y_b64_start_index; y_b64_index < y_b64_end_index; ++y_b64_index) {
                         for (uint32_t x_b64_index = x_b64_start_index; x_b64_index < x_b64_end_index; ++x_b64_index) {
@@ -16,6 +16,7 @@
 #include "EbSequenceControlSet.h"
 #include "EbPictureControlSet.h"
 #include "EbEntropyCoding.h"
+#include "EbEntropyCodingProcess.h"
 #include "EbRateControlTasks.h"
 #include "EbTime.h"
 #include "EbModeDecisionProcess.h"
@@ -307,12 +308,13 @@ static void collect_frames_info(PacketizationContext *context_ptr,
     }
 }
 
-#define TD_SIZE 2
-
 //a tu start with a td, + 0 more not displable frame, + 1 display frame
 static EbErrorType encode_tu(EncodeContext *encode_context_ptr, int frames, uint32_t total_bytes,
                              EbBufferHeaderType *output_stream_ptr) {
-    total_bytes += TD_SIZE;
+    // A frame sent as sub-frame packets already carried the TD in its first packet
+    const Bool has_td = !get_reorder_queue_entry(encode_context_ptr, 0)->sub_frame_output;
+    if (has_td)
+        total_bytes += TD_SIZE;
     if (total_bytes > output_stream_ptr->n_alloc_len) {
         uint8_t *pbuff;
         EB_MALLOC(pbuff, total_bytes);
@@ -349,10 +351,12 @@ static EbErrorType encode_tu(EncodeContext *encode_context_ptr, int frames, uint
     }
     if (frames > 1)
         sort_undisplayed_frame(encode_context_ptr);
-    dst -= TD_SIZE;
-    encode_td_av1(dst);
     output_stream_ptr->n_filled_len = total_bytes;
-    output_stream_ptr->flags |= EB_BUFFERFLAG_HAS_TD;
+    if (has_td) {
+        dst -= TD_SIZE;
+        encode_td_av1(dst);
+        output_stream_ptr->flags |= EB_BUFFERFLAG_HAS_TD;
+    }
     return EB_ErrorNone;
 }
 
@@ -456,6 +460,9 @@ void *packetization_kernel(void *input_ptr) {
         PictureParentControlSet *parent_pcs_ptr = (PictureParentControlSet *)
                                                       pcs_ptr->parent_pcs_ptr;
 
+        if (encode_context_ptr->thread_budget.enabled)
+            thread_budget_update(&encode_context_ptr->thread_budget);
+
         if (parent_pcs_ptr->superres_total_recode_loop > 0 &&
             parent_pcs_ptr->superres_recode_loop < parent_pcs_ptr->superres_total_recode_loop) {
             // Reset the Bitstream before writing to it
@@ -764,8 +771,11 @@ void *packetization_kernel(void *input_ptr) {
 
         size_t metadata_sz = 0;
 
+        // The sequence header, frame header and leading tiles went out as sub-frame packets
+        const Bool sub_frame_started = pcs_ptr->sub_frame_tiles_emitted > 0;
+
         // Code the SPS
-        if (frm_hdr->frame_type == KEY_FRAME) {
+        if (frm_hdr->frame_type == KEY_FRAME && !sub_frame_started) {
             encode_sps_av1(pcs_ptr->bitstream_ptr, scs_ptr);
             // Add CLL and MDCV meta when frame is keyframe and SPS is written
             write_metadata_av1(pcs_ptr->bitstream_ptr,
@@ -794,7 +804,11 @@ void *packetization_kernel(void *input_ptr) {
             metadata_sz = svt_metadata_size(temp_entry->metadata, EB_AV1_METADATA_TYPE_ITUT_T35);
         }
 
-        write_frame_header_av1(pcs_ptr->bitstream_ptr, scs_ptr, pcs_ptr, 0);
+        if (sub_frame_started)
+            write_tile_group_av1(
+                pcs_ptr->bitstream_ptr, pcs_ptr, pcs_ptr->sub_frame_tiles_emitted, tile_cnt - 1);
+        else
+            write_frame_header_av1(pcs_ptr->bitstream_ptr, scs_ptr, pcs_ptr, 0);
 
         output_stream_ptr->n_alloc_len =
             (uint32_t)(bitstream_get_bytes_count(pcs_ptr->bitstream_ptr) + TD_SIZE + metadata_sz);
@@ -829,7 +843,9 @@ void *packetization_kernel(void *input_ptr) {
         }
 
         // Send the number of bytes per frame to RC
-        pcs_ptr->parent_pcs_ptr->total_num_bits = output_stream_ptr->n_filled_len << 3;
+        pcs_ptr->parent_pcs_ptr->total_num_bits = (output_stream_ptr->n_filled_len +
+                                                   pcs_ptr->sub_frame_bytes_emitted)
+            << 3;
         if (scs_ptr->passes == 3 && scs_ptr->static_config.pass == ENC_MIDDLE_PASS) {
             StatStruct stat_struct;
             stat_struct.poc = pcs_ptr->picture_number;
@@ -864,6 +880,7 @@ void *packetization_kernel(void *input_ptr) {
                    pcs_ptr->parent_pcs_ptr->av1_ref_signal.ref_poc_array,
                    7 * sizeof(uint64_t));
 #endif
+        queue_entry_ptr->sub_frame_output    = sub_frame_started;
         queue_entry_ptr->show_frame          = frm_hdr->show_frame;
         queue_entry_ptr->has_show_existing   = pcs_ptr->parent_pcs_ptr->has_show_existing;
         queue_entry_ptr->show_existing_frame = frm_hdr->show_existing_frame;
@@ -943,6 +960,10 @@ void *packetization_kernel(void *input_ptr) {
                 }
             }
             release_frames(encode_context_ptr, frames);
+            if (scs_ptr->static_config.sub_frame_output) {
+                // Let the next frame in decode order send its finished tiles
+                sub_frame_output_advance(encode_context_ptr, frames);
+            }
         }
     }
     return NULL;
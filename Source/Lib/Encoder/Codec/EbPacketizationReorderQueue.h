@@ -50,6 +50,8 @@ typedef struct PacketizationReorderEntry {
     int64_t                  next_pts;
     uint8_t                  is_alt_ref;
     struct SvtMetadataArray *metadata;
+    // TD and frame header were already output in partial packets
+    Bool sub_frame_output;
 } PacketizationReorderEntry;
 
 extern EbErrorType packetization_reorder_entry_ctor(PacketizationReorderEntry *entry_ptr,
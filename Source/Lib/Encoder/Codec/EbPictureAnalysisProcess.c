@@ -1925,6 +1925,7 @@ static int32_t apply_denoise_2d(SequenceControlSet *scs_ptr, PictureParentContro
     fg_init_data.stride_cb            = pcs_ptr->enhanced_picture_ptr->stride_cb;
     fg_init_data.stride_cr            = pcs_ptr->enhanced_picture_ptr->stride_cr;
     fg_init_data.denoise_apply        = scs_ptr->static_config.film_grain_denoise_apply;
+    fg_init_data.job_pool             = scs_ptr->encode_context_ptr->job_pool;
     EB_NEW(denoise_and_model, denoise_and_model_ctor, (EbPtr)&fg_init_data);
 
     if (svt_aom_denoise_and_model_run(denoise_and_model,
@@ -2711,6 +2712,12 @@ void *picture_analysis_kernel(void *input_ptr) {
         // There is no need to do processing for overlay picture. Overlay and AltRef share the same results.
         if (!pcs_ptr->is_overlay) {
             input_picture_ptr = pcs_ptr->enhanced_picture_ptr;
+            // Identify the source before it gets padded and denoised
+            if (scs_ptr->encode_context_ptr->analysis_file)
+                pcs_ptr->source_hash = analysis_hash_picture(
+                    input_picture_ptr,
+                    scs_ptr->max_input_luma_width - scs_ptr->max_input_pad_right,
+                    scs_ptr->max_input_luma_height - scs_ptr->max_input_pad_bottom);
             int copy_frame    = 1;
             if (pcs_ptr->scs_ptr->ipp_pass_ctrls.skip_frame_first_pass == 1)
                 copy_frame = (((pcs_ptr->picture_number % 8) == 0) ||
@@ -2749,6 +2756,8 @@ void *picture_analysis_kernel(void *input_ptr) {
                 pa_ref_obj_ = (EbPaReferenceObject *)
                                   pcs_ptr->pa_reference_picture_wrapper_ptr->object_ptr;
                 pa_ref_obj_->picture_number = pcs_ptr->picture_number;
+                pa_ref_obj_->source_hash    = pcs_ptr->source_hash;
+                pa_ref_obj_->filter_hash    = pcs_ptr->filter_hash = 0;
                 input_padded_picture_ptr    = (EbPictureBufferDesc *)
                                                pa_ref_obj_->input_padded_picture_ptr;
 
@@ -235,7 +235,14 @@ void picture_control_set_dctor(EbPtr p) {
     EB_DESTROY_MUTEX(obj->entropy_coding_pic_mutex);
     EB_DESTROY_MUTEX(obj->intra_mutex);
     EB_DESTROY_MUTEX(obj->cdef_search_mutex);
+    svt_segment_pass_dctor(&obj->dlf_seg);
+    svt_segment_pass_dctor(&obj->cdef_seg);
+    svt_segment_pass_dctor(&obj->rest_seg);
+    EB_DESTROY_MUTEX(obj->enc_dec_row_mutex);
+    EB_FREE_ARRAY(obj->enc_dec_sb_row_count);
     EB_DESTROY_MUTEX(obj->rest_search_mutex);
+    EB_DESTROY_MUTEX(obj->cdef_fb_row_mutex);
+    EB_FREE_ARRAY(obj->cdef_fb_row_done);
 }
 // Token buffer is only used for palette tokens.
 static INLINE unsigned int get_token_alloc(int mb_rows, int mb_cols, int sb_size_log2,
@@ -1159,6 +1166,15 @@ EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr object
     EB_CREATE_MUTEX(object_ptr->intra_mutex);
 
     EB_CREATE_MUTEX(object_ptr->cdef_search_mutex);
+    return_error = svt_segment_pass_ctor(&object_ptr->dlf_seg);
+    if (return_error == EB_ErrorNone)
+        return_error = svt_segment_pass_ctor(&object_ptr->cdef_seg);
+    if (return_error == EB_ErrorNone)
+        return_error = svt_segment_pass_ctor(&object_ptr->rest_seg);
+    if (return_error == EB_ErrorInsufficientResources)
+        return EB_ErrorInsufficientResources;
+    EB_CREATE_MUTEX(object_ptr->enc_dec_row_mutex);
+    EB_MALLOC_ARRAY(object_ptr->enc_dec_sb_row_count, picture_sb_height);
 
     //object_ptr->mse_seg[0] = (uint64_t(*)[64])svt_aom_malloc(sizeof(**object_ptr->mse_seg) *  picture_sb_width * picture_sb_height);
     // object_ptr->mse_seg[1] = (uint64_t(*)[64])svt_aom_malloc(sizeof(**object_ptr->mse_seg) *  picture_sb_width * picture_sb_height);
@@ -1167,6 +1183,9 @@ EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr object
     EB_MALLOC_ARRAY(object_ptr->skip_cdef_seg, picture_sb_width * picture_sb_height);
     EB_MALLOC_ARRAY(object_ptr->cdef_dir_data, picture_sb_width * picture_sb_height);
     EB_CREATE_MUTEX(object_ptr->rest_search_mutex);
+    EB_CREATE_MUTEX(object_ptr->cdef_fb_row_mutex);
+    EB_MALLOC_ARRAY(object_ptr->cdef_fb_row_done,
+                    (init_data_ptr->picture_height + CDEF_BLOCKSIZE - 1) / CDEF_BLOCKSIZE);
 
     //the granularity is 4x4
     EB_MALLOC_ARRAY(object_ptr->mi_grid_base,
@@ -30,6 +30,7 @@
 #include "EbAv1Structs.h"
 #include "EbMdRateEstimation.h"
 #include "EbEncCdef.h"
+#include "EbSegmentPass.h"
 #include "Av1Common.h"
 
 #include "av1me.h"
@@ -278,6 +279,10 @@ typedef struct PictureControlSet {
     EbHandle          entropy_coding_pic_mutex;
     Bool              entropy_coding_pic_reset_flag;
     uint8_t           tile_size_bytes_minus_1;
+    // Sub-frame output: number of leading tiles and bytes already sent in partial packets
+    Bool              sub_frame_output;
+    uint16_t          sub_frame_tiles_emitted;
+    uint32_t          sub_frame_bytes_emitted;
     EbHandle          intra_mutex;
     uint32_t          intra_coded_area;
     uint64_t          skip_coded_area;
@@ -287,6 +292,23 @@ typedef struct PictureControlSet {
     uint16_t cdef_segments_total_count;
     uint8_t  cdef_segments_column_count;
     uint8_t  cdef_segments_row_count;
+    // Wavefront post-filtering: CDEF search segment rows are sent as soon as EncDec has coded
+    // (and deblocked) the SB rows they need, rather than once the whole picture is coded
+    Bool      cdef_search_wavefront;
+    uint8_t   cdef_seg_rows_posted;
+    EbHandle  enc_dec_row_mutex;
+    uint16_t *enc_dec_sb_row_count; // coded SBs per SB row
+    uint16_t  enc_dec_sb_rows_done; // leading SB rows fully coded
+
+    // DLF segments (bands of SB rows) of the pass being run by the DLF threads
+    SegmentPass dlf_seg;
+    EbFifo     *dlf_seg_fifo_ptr; // helper tasks of the DLF thread running the passes
+    // CDEF application segments (64x64 filter block rows) of the picture
+    SegmentPass cdef_seg;
+    uint16_t   *cdef_linebuf[3]; // unfiltered lines around the top edges of the segments
+    int32_t     cdef_linebuf_stride;
+    // LR application segments (restoration stripes) of the pass being run by the Rest threads
+    SegmentPass rest_seg;
 
     uint64_t (*mse_seg[2])[TOTAL_STRENGTHS];
     uint8_t     *skip_cdef_seg;
@@ -302,6 +324,13 @@ typedef struct PictureControlSet {
     uint8_t  rest_segments_row_count;
     Bool     rest_extend_flag
         [3]; // flag to indicate whether the frame is extended for restoration search
+    // Wavefront LR search: the LR search segment rows are sent as soon as the CDEF application
+    // has filtered (and extended) the filter block rows they read
+    Bool     rest_search_wavefront;
+    uint8_t  rest_seg_rows_posted;
+    EbHandle cdef_fb_row_mutex;
+    uint8_t *cdef_fb_row_done; // per 64x64 filter block row
+    uint16_t cdef_fb_rows_done; // leading filter block rows filtered
 
     // Slice Type
     SliceType slice_type;
@@ -629,6 +658,8 @@ typedef struct CdefControls {
         zero_fs_cost_bias; // 0: OFF, higher is safer. Scaling factor to decrease the zero filter strength cost: : <x>/64
     uint8_t
         use_skip_detector; // Shut CDEF at the picture level based on the skip area of the nearest reference frames.
+    uint8_t
+        second_pass_prim_num; // 0: OFF; else the luma second pass filters the pairs of the <x> best primary strengths of the first pass only, the mse of the other pairs being modelled
 } CdefControls;
 
 typedef struct List0OnlyBase {
@@ -776,6 +807,16 @@ typedef struct PictureParentControlSet {
     // Global motion estimation results
     Bool                  is_global_motion[MAX_NUM_OF_REF_PIC_LIST][REF_LIST_MAX_DEPTH];
     EbWarpedMotionParams  global_motion_estimation[MAX_NUM_OF_REF_PIC_LIST][REF_LIST_MAX_DEPTH];
+    // Checksum of the source luma, and of the sources the ME results depend on
+    // (references, temporal filtering window), used with the analysis file
+    uint64_t              source_hash;
+    uint64_t              analysis_hash;
+    // Temporal filter settings of the picture (0 when not filtered), and of the picture and its
+    // references, used with the analysis file
+    uint64_t              filter_hash;
+    uint64_t              analysis_filter_hash;
+    // ME and GM results were read from the analysis file, ME is not performed
+    Bool                  me_imported;
     uint16_t              me_processed_b64_count;
     EbHandle              me_processed_b64_mutex;
     FirstPassData         firstpass_data;
@@ -763,6 +763,7 @@ void set_cdef_controls(PictureParentControlSet *pcs_ptr, uint8_t cdef_level, Boo
     int i, j, sf_idx, second_pass_fs_num;
     cdef_ctrls->use_reference_cdef_fs = 0;
     cdef_ctrls->use_skip_detector = 0;
+    cdef_ctrls->second_pass_prim_num = 0;
     switch (cdef_level)
     {
         // OFF
@@ -1280,6 +1281,36 @@ void set_cdef_controls(PictureParentControlSet *pcs_ptr, uint8_t cdef_level, Boo
         cdef_ctrls->zero_fs_cost_bias = 62;
         cdef_ctrls->use_skip_detector = 1;
         break;
+    case 19:
+        // pf_set {0,1,2,4,5,6,8,9,10,12,13,14}
+        // sf_set {0,1,..,3} for the 4 best primary strengths of the first pass
+        cdef_ctrls->enabled = 1;
+        cdef_ctrls->first_pass_fs_num = 12;
+        second_pass_fs_num = 3;
+        cdef_ctrls->default_second_pass_fs_num = cdef_ctrls->first_pass_fs_num*second_pass_fs_num;
+        for (i = 0; i < cdef_ctrls->first_pass_fs_num; i++)
+            cdef_ctrls->default_first_pass_fs[i] = pf_gi[i + i / 3];
+        sf_idx = 0;
+        for (i = 0; i < cdef_ctrls->first_pass_fs_num; i++) {
+            int pf_idx = cdef_ctrls->default_first_pass_fs[i];
+            for (j = 1; j < 4; j++) {
+                cdef_ctrls->default_second_pass_fs[sf_idx] = pf_idx + j;
+                sf_idx++;
+            }
+        }
+        for (i = 0; i < cdef_ctrls->first_pass_fs_num; i++)
+            cdef_ctrls->default_first_pass_fs_uv[i] = cdef_ctrls->default_first_pass_fs[i];
+        for (i = 0; i < cdef_ctrls->default_second_pass_fs_num; i++)
+            cdef_ctrls->default_second_pass_fs_uv[i] = -1;
+        cdef_ctrls->use_reference_cdef_fs = 0;
+        cdef_ctrls->search_best_ref_fs = 0;
+        cdef_ctrls->subsampling_factor = 1;
+        cdef_ctrls->second_pass_prim_num = 4;
+        if (fast_decode == 0)
+            cdef_ctrls->zero_fs_cost_bias = 0;
+        else
+            cdef_ctrls->zero_fs_cost_bias = pcs_ptr->input_resolution <= INPUT_SIZE_360p_RANGE ? 0 : 62;
+        break;
     default:
         assert(0);
         break;
@@ -4939,6 +4970,9 @@ void mctf_frame(
 
             svt_block_on_semaphore(pcs_ptr->temp_filt_done_semaphore);
         }
+        // The ME results of the filtered picture depend on the filter strength
+        if (scs_ptr->encode_context_ptr->analysis_file)
+            analysis_mark_filtered(pcs_ptr);
 
 
         if (pcs_ptr->tf_tot_horz_blks > pcs_ptr->tf_tot_vert_blks * 6 / 4){
@@ -5120,6 +5154,13 @@ void send_picture_out(
     uint8_t gm_level = derive_gm_level(pcs);
     set_gm_controls(pcs, gm_level);
 
+    // Reuse the motion analysis of an earlier encode of the same source when available
+    AnalysisFile *analysis_file = scs->encode_context_ptr->analysis_file;
+    if (analysis_file)
+        pcs->analysis_hash = analysis_dependency_hash(pcs);
+    pcs->me_imported = analysis_file && !analysis_file->write &&
+        analysis_read_picture(analysis_file, pcs);
+
     for (uint32_t segment_index = 0; segment_index < pcs->me_segments_total_count; ++segment_index) {
         // Get Empty Results Object
         svt_get_empty_object(
@@ -5883,7 +5924,10 @@ void* picture_decision_kernel(void *input_ptr)
                                 (PictureParentControlSet *)encode_context_ptr->picture_decision_reorder_queue[temp_entry_index]->parent_pcs_wrapper_ptr->object_ptr : NULL;
                             first_pass_pcs_ptr->first_pass_ref_count = first_pass_queue_entry->picture_number > 1 ? 2 : first_pass_queue_entry->picture_number > 0 ? 1 : 0;
 
-                            process_first_pass_frame(scs_ptr, first_pass_pcs_ptr, context_ptr);
+                            // streamed stats replace the first pass of the look ahead
+                            if (!scs_ptr->static_config.rc_stats_stream || !scs_ptr->lap_rc ||
+                                !svt_av1_read_streamed_first_pass_stats(first_pass_pcs_ptr))
+                                process_first_pass_frame(scs_ptr, first_pass_pcs_ptr, context_ptr);
                             first_pass_pcs_ptr->first_pass_done = 1;
                         }
                     }
@@ -1836,6 +1836,9 @@ void md_stage_0(
     //   the stack each pass, so a better solution would be to register the variable,
     //   but this might require asm.
     volatile uint64_t max_cost = MAX_CU_COST;
+    // The non-directional intra candidates share the edges of the block
+    if (context_ptr->target_class == CAND_CLASS_0)
+        svt_av1_build_intra_nd_edges(context_ptr);
     while (fast_loop_cand_index >= fast_candidate_start_index) {
         if (fast_candidate_array[fast_loop_cand_index].cand_class == context_ptr->target_class) {
             ModeDecisionCandidateBuffer *candidate_buffer =
@@ -1890,6 +1893,7 @@ void md_stage_0(
         }
         --fast_loop_cand_index;
     }
+    context_ptr->intra_nd_edges->ready = FALSE;
 
     // Set the cost of the scratch canidate to max to get discarded @ the sorting phase
     *(candidate_buffer_ptr_array_base[highest_cost_index]->fast_cost_ptr) =
@@ -2652,25 +2652,31 @@ static void restore_two_pass_param(PictureParentControlSet         *ppcs_ptr,
                                    RateControlIntervalParamContext *rate_control_param_ptr) {
     SequenceControlSet *scs_ptr = ppcs_ptr->scs_ptr;
     TWO_PASS *const     twopass = &scs_ptr->twopass;
-    if (ppcs_ptr->scs_ptr->enable_dec_order == 1 && ppcs_ptr->scs_ptr->lap_rc &&
-        ppcs_ptr->temporal_layer_index == 0) {
+    STATS_BUFFER_CTX   *stats_buf_ctx = twopass->stats_buf_ctx;
+    if (scs_ptr->enable_dec_order == 1 && scs_ptr->lap_rc && ppcs_ptr->temporal_layer_index == 0) {
         for (uint64_t num_frames = ppcs_ptr->stats_in_offset;
              num_frames < ppcs_ptr->stats_in_end_offset;
              ++num_frames) {
-            FIRSTPASS_STATS *cur_frame = ppcs_ptr->scs_ptr->twopass.stats_buf_ctx->stats_in_start +
-                num_frames;
-            if ((int64_t)cur_frame->frame >
-                ppcs_ptr->scs_ptr->twopass.stats_buf_ctx->last_frame_accumulated) {
-                svt_av1_accumulate_stats(ppcs_ptr->scs_ptr->twopass.stats_buf_ctx->total_stats,
-                                         cur_frame);
-                ppcs_ptr->scs_ptr->twopass.stats_buf_ctx->last_frame_accumulated =
-                    (int64_t)cur_frame->frame;
+            FIRSTPASS_STATS *cur_frame = svt_av1_lap_stats(stats_buf_ctx, num_frames);
+            if ((int64_t)cur_frame->frame > stats_buf_ctx->last_frame_accumulated) {
+                svt_av1_accumulate_stats(stats_buf_ctx->total_stats, cur_frame);
+                stats_buf_ctx->last_frame_accumulated = (int64_t)cur_frame->frame;
             }
         }
     }
-    twopass->stats_in = scs_ptr->twopass.stats_buf_ctx->stats_in_start + ppcs_ptr->stats_in_offset;
-    twopass->stats_buf_ctx->stats_in_end = scs_ptr->twopass.stats_buf_ctx->stats_in_start +
-        ppcs_ptr->stats_in_end_offset;
+    if (scs_ptr->lap_rc) {
+        // window of the look ahead ring, preceded by the stats of the previous frames it holds
+        FIRSTPASS_STATS *stats_in = svt_av1_lap_stats(stats_buf_ctx, ppcs_ptr->stats_in_offset);
+        twopass->stats_in             = stats_in;
+        stats_buf_ctx->stats_in_start = stats_in -
+            MIN(ppcs_ptr->stats_in_offset, LAP_STATS_MARGIN);
+        stats_buf_ctx->stats_in_end = stats_in +
+            (ppcs_ptr->stats_in_end_offset - ppcs_ptr->stats_in_offset);
+    } else {
+        twopass->stats_in = stats_buf_ctx->stats_in_start + ppcs_ptr->stats_in_offset;
+        stats_buf_ctx->stats_in_end = stats_buf_ctx->stats_in_start +
+            ppcs_ptr->stats_in_end_offset;
+    }
     twopass->kf_group_bits       = rate_control_param_ptr->kf_group_bits;
     twopass->kf_group_error_left = rate_control_param_ptr->kf_group_error_left;
 }
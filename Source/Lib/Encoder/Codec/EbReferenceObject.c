@@ -129,6 +129,7 @@ static void svt_reference_object_dctor(EbPtr p) {
     EB_DELETE(obj->input_picture);
     EB_DELETE(obj->quarter_input_picture);
     EB_DELETE(obj->sixteenth_input_picture);
+    svt_subpel_ref_planes_dctor(&obj->subpel_planes);
 }
 
 /*****************************************
@@ -206,7 +207,13 @@ EbErrorType svt_reference_object_ctor(EbReferenceObject *reference_object,
                     picture_buffer_desc_init_data_ptr->sb_total_count);
     EB_MALLOC_ARRAY(reference_object->sb_me_8x8_cost_var,
                     picture_buffer_desc_init_data_ptr->sb_total_count);
-    return EB_ErrorNone;
+    return svt_subpel_ref_planes_ctor(
+        &reference_object->subpel_planes,
+        ref_init_ptr->subpel_ref_planes,
+        picture_buffer_desc_init_data_ptr->max_width,
+        picture_buffer_desc_init_data_ptr->max_height,
+        picture_buffer_desc_init_data_ptr->left_padding,
+        picture_buffer_desc_init_data_16bit_ptr.bit_depth > EB_8BIT);
 }
 
 EbErrorType svt_reference_object_creator(EbPtr *object_dbl_ptr, EbPtr object_init_data_ptr) {
@@ -223,6 +230,7 @@ EbErrorType svt_reference_object_reset(EbReferenceObject  *reference_object,
                                        SequenceControlSet *scs_ptr) {
     reference_object->mi_rows = scs_ptr->max_input_luma_height >> MI_SIZE_LOG2;
     reference_object->mi_cols = scs_ptr->max_input_luma_width >> MI_SIZE_LOG2;
+    svt_atomic_store_i32(&reference_object->subpel_planes.ready, 0);
 
     return EB_ErrorNone;
 }
@@ -242,6 +250,10 @@ static void svt_pa_reference_object_dctor(EbPtr p) {
         }
         EB_DESTROY_MUTEX(obj->resize_mutex[denom_idx]);
     }
+    svt_av1_hash_table_destroy(&obj->hash_table);
+    EB_DESTROY_MUTEX(obj->hash_mutex);
+    EB_FREE_ARRAY(obj->gm_corners);
+    EB_DESTROY_MUTEX(obj->gm_corners_mutex);
 }
 
 /*****************************************
@@ -276,6 +288,10 @@ EbErrorType svt_pa_reference_object_ctor(EbPaReferenceObject *pa_ref_obj_,
         pa_ref_obj_->downscaled_picture_number[down_idx]                    = (uint64_t)~0;
         EB_CREATE_MUTEX(pa_ref_obj_->resize_mutex[down_idx]);
     }
+    pa_ref_obj_->hash_picture_number = (uint64_t)~0;
+    EB_CREATE_MUTEX(pa_ref_obj_->hash_mutex);
+    pa_ref_obj_->gm_corners_picture_number = (uint64_t)~0;
+    EB_CREATE_MUTEX(pa_ref_obj_->gm_corners_mutex);
 
     return EB_ErrorNone;
 }
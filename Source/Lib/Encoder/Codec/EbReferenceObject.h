@@ -17,6 +17,8 @@
 #include "EbCabacContextModel.h"
 #include "EbCodingUnit.h"
 #include "EbSequenceControlSet.h"
+#include "hash_motion.h"
+#include "EbHpelCache.h"
 
 typedef struct EbReferenceObject {
     EbDctor                     dctor;
@@ -59,11 +61,13 @@ typedef struct EbReferenceObject {
     int32_t              mi_rows;
     WienerUnitInfo *
         *unit_info; // per plane, per rest. unit; used for fwding wiener info to future frames
+    SubpelRefPlanes subpel_planes; // sub-pel planes of the luma, when subpel_ref_planes is set
 } EbReferenceObject;
 
 typedef struct EbReferenceObjectDescInitData {
     EbPictureBufferDescInitData reference_picture_desc_init_data;
     int8_t                      hbd_mode_decision;
+    uint8_t                     subpel_ref_planes; // level of the sub-pel planes, 0: none
 } EbReferenceObjectDescInitData;
 
 typedef struct EbPaReferenceObject {
@@ -78,6 +82,21 @@ typedef struct EbPaReferenceObject {
     uint64_t downscaled_picture_number[NUM_SCALES]; // save the picture_number for each denom
     EbHandle resize_mutex[NUM_SCALES];
     uint64_t picture_number;
+    uint64_t source_hash; // source checksum of the picture, set when an analysis file is used
+    uint64_t filter_hash; // temporal filter settings of the picture, 0 when it is not filtered
+    // block hashes of the source, built on first use by the hash based motion search
+    HashTable hash_table;
+    uint64_t  hash_picture_number; // picture_number the hash table was built for
+    EbHandle  hash_mutex;
+    // FAST corners of the source for the global motion, detected by the first
+    // picture using it as reference, at the downsampling gm_corners_level
+    int      *gm_corners;
+    int       gm_num_corners;
+    int       gm_corners_level;
+    int       gm_corners_width;
+    int       gm_corners_height;
+    uint64_t  gm_corners_picture_number;
+    EbHandle  gm_corners_mutex;
     uint8_t  dummy_obj;
 } EbPaReferenceObject;
 
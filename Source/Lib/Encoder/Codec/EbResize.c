@@ -1096,6 +1096,52 @@ static INLINE unsigned int lcg_rand16(unsigned int *state) {
     return *state / 65536 % 32768;
 }
 
+/*
+ * Resize a picture in the application input format (unpacked 8-bit or 16-bit
+ * samples, strides in samples) from width x height to width2 x height2.
+ */
+EbErrorType svt_av1_resize_input_picture(const EbSvtIOFormat *src, int width, int height,
+                                         EbSvtIOFormat *dst, int width2, int height2,
+                                         uint32_t bit_depth, EbColorFormat color_format) {
+    const int      num_planes = color_format == EB_YUV400 ? 1 : MAX_MB_PLANE;
+    const int      ss_x       = color_format == EB_YUV420 || color_format == EB_YUV422;
+    const int      ss_y       = color_format == EB_YUV420;
+    const uint8_t *src_buf[MAX_MB_PLANE]    = {src->luma, src->cb, src->cr};
+    uint8_t       *dst_buf[MAX_MB_PLANE]    = {dst->luma, dst->cb, dst->cr};
+    const int      src_stride[MAX_MB_PLANE] = {
+        (int)src->y_stride, (int)src->cb_stride, (int)src->cr_stride};
+    const int dst_stride[MAX_MB_PLANE] = {
+        (int)dst->y_stride, (int)dst->cb_stride, (int)dst->cr_stride};
+
+    for (int plane = 0; plane < num_planes; ++plane) {
+        const int   sx = plane ? ss_x : 0;
+        const int   sy = plane ? ss_y : 0;
+        EbErrorType return_error;
+        if (bit_depth > EB_8BIT)
+            return_error = av1_highbd_resize_plane((const uint16_t *)src_buf[plane],
+                                                   (height + sy) >> sy,
+                                                   (width + sx) >> sx,
+                                                   src_stride[plane],
+                                                   (uint16_t *)dst_buf[plane],
+                                                   (height2 + sy) >> sy,
+                                                   (width2 + sx) >> sx,
+                                                   dst_stride[plane],
+                                                   bit_depth);
+        else
+            return_error = av1_resize_plane(src_buf[plane],
+                                            (height + sy) >> sy,
+                                            (width + sx) >> sx,
+                                            src_stride[plane],
+                                            dst_buf[plane],
+                                            (height2 + sy) >> sy,
+                                            (width2 + sx) >> sx,
+                                            dst_stride[plane]);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+    }
+    return EB_ErrorNone;
+}
+
 // Compute the horizontal frequency components' energy in a frame
 // by calculuating the 16x4 Horizontal DCT. This is to be used to
 // decide the superresolution parameters.
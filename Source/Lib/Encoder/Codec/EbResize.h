@@ -54,6 +54,10 @@ void scale_pcs_params(SequenceControlSet *scs_ptr, PictureParentControlSet *pcs_
 
 void init_resize_picture(SequenceControlSet *scs_ptr, PictureParentControlSet *pcs_ptr);
 
+EbErrorType svt_av1_resize_input_picture(const EbSvtIOFormat *src, int width, int height,
+                                         EbSvtIOFormat *dst, int width2, int height2,
+                                         uint32_t bit_depth, EbColorFormat color_format);
+
 void reset_resized_picture(SequenceControlSet *scs_ptr, PictureParentControlSet *pcs_ptr,
                            EbPictureBufferDesc *input_picture_ptr);
 
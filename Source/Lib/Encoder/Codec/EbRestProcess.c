@@ -38,14 +38,23 @@ typedef struct RestContext {
     // each thread will hence have his own copy of recon to work on.
     // later we can have a search version that does not need the exact right recon
     int32_t *rst_tmpbuf;
+
+    EbFifo           *rest_feedback_fifo_ptr; // LR segment helper tasks to the Rest threads
+    volatile int32_t *rest_seg_task_count;
 } RestContext;
 
 void pack_highbd_pic(const EbPictureBufferDesc *pic_ptr, uint16_t *buffer_16bit[3], uint32_t ss_x,
                      uint32_t ss_y, Bool include_padding);
 void copy_buffer_info(EbPictureBufferDesc *src_ptr, EbPictureBufferDesc *dst_ptr);
 void recon_output(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr);
-void svt_av1_loop_restoration_filter_frame(Yv12BufferConfig *frame, Av1Common *cm,
-                                           int32_t optimized_lr);
+int32_t svt_av1_loop_restoration_stripe_count(const Av1Common *cm);
+void    svt_av1_loop_restoration_filter_frame_init(Yv12BufferConfig *frame, Av1Common *cm,
+                                                   int32_t optimized_lr);
+void    svt_av1_loop_restoration_filter_stripe(Yv12BufferConfig *frame, Av1Common *cm,
+                                               int32_t stripe, int32_t *tmpbuf);
+void    svt_av1_loop_restoration_copy_stripe(Yv12BufferConfig *frame, Av1Common *cm,
+                                             int32_t stripe);
+void    svt_av1_loop_restoration_filter_frame_free(Av1Common *cm);
 void copy_statistics_to_ref_obj_ect(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr);
 EbErrorType psnr_calculations(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr,
                               Bool free_memory);
@@ -106,6 +115,10 @@ EbErrorType rest_context_ctor(EbThreadContext   *thread_context_ptr,
         enc_handle_ptr->rest_results_resource_ptr, index);
     context_ptr->picture_demux_fifo_ptr = svt_system_resource_get_producer_fifo(
         enc_handle_ptr->picture_demux_results_resource_ptr, demux_index);
+    context_ptr->rest_feedback_fifo_ptr = svt_system_resource_get_producer_fifo(
+        enc_handle_ptr->cdef_results_resource_ptr, scs_ptr->cdef_process_init_count + index);
+    context_ptr->rest_seg_task_count =
+        &enc_handle_ptr->scs_instance_array[0]->encode_context_ptr->rest_seg_task_count;
 
     Bool is_16bit = scs_ptr->is_16bit_pipeline;
 
@@ -138,7 +151,7 @@ EbErrorType rest_context_ctor(EbThreadContext   *thread_context_ptr,
                 context_ptr->org_rec_frame->bit_depth = EB_8BIT;
         }
 
-        EB_MALLOC_ALIGNED(context_ptr->rst_tmpbuf, RESTORATION_TMPBUF_SIZE);
+        EB_MALLOC_ALIGNED(context_ptr->rst_tmpbuf, RESTORATION_SEARCH_TMPBUF_SIZE);
     }
 
     return EB_ErrorNone;
@@ -519,6 +532,92 @@ void svt_av1_superres_upscale_frame(struct Av1Common *cm, PictureControlSet *pcs
     EB_FREE_ALIGNED_ARRAY(ps_recon_pic_temp->buffer_cr);
 }
 
+/* The passes of the LR application. A stripe is filtered with its boundary lines set up in the
+ * frame, over the lines of the stripes next to it, so the even and the odd stripes are filtered
+ * in separate passes. The restored stripes are copied back to the frame in a last pass. */
+typedef enum RestSegmentPass {
+    REST_SEG_EVEN, // filter the stripes 2 * segment
+    REST_SEG_ODD, // filter the stripes 2 * segment + 1
+    REST_SEG_COPY // copy the restored stripe segment to the frame
+} RestSegmentPass;
+
+/* Filters or copies a stripe of an LR application pass, thread_ctx is the tmpbuf of the thread */
+static uint64_t rest_filter_segment(PictureControlSet *pcs_ptr, void *thread_ctx,
+                                    const SegmentPassStep *step, uint32_t segment_index) {
+    Av1Common *cm = pcs_ptr->parent_pcs_ptr->av1_cm;
+    if (step->pass == REST_SEG_COPY)
+        svt_av1_loop_restoration_copy_stripe(cm->frame_to_show, cm, (int32_t)segment_index);
+    else
+        svt_av1_loop_restoration_filter_stripe(cm->frame_to_show,
+                                               cm,
+                                               2 * (int32_t)segment_index +
+                                                   (step->pass == REST_SEG_ODD),
+                                               (int32_t *)thread_ctx);
+    return 0;
+}
+
+static void rest_post_segment_task(EbFifo *fifo_ptr, PictureControlSet *pcs_ptr) {
+    EbObjectWrapper *wrapper_ptr;
+    svt_get_empty_object(fifo_ptr, &wrapper_ptr);
+    CdefResults *task_ptr            = (CdefResults *)wrapper_ptr->object_ptr;
+    task_ptr->pcs_wrapper_ptr        = pcs_ptr->c_pcs_wrapper_ptr;
+    task_ptr->segment_index          = 0;
+    task_ptr->rest_segments          = TRUE;
+    task_ptr->subpel_ref_wrapper_ptr = NULL;
+    svt_post_full_object(wrapper_ptr);
+}
+
+/* Runs a pass over the LR segments of the picture */
+static void rest_run_segments(RestContext *context_ptr, PictureControlSet *pcs_ptr,
+                              RestSegmentPass pass) {
+    SequenceControlSet *scs_ptr      = pcs_ptr->scs_ptr;
+    const int32_t       stripe_count = svt_av1_loop_restoration_stripe_count(
+        pcs_ptr->parent_pcs_ptr->av1_cm);
+    const uint16_t segment_count = (uint16_t)(pass == REST_SEG_EVEN ? (stripe_count + 1) / 2
+                                                  : pass == REST_SEG_ODD ? stripe_count / 2
+                                                                         : stripe_count);
+    const SegmentPassStep    step    = {rest_filter_segment, (uint8_t)pass, {0, 0}};
+    const SegmentPassHelpers helpers = {context_ptr->rest_feedback_fifo_ptr,
+                                        rest_post_segment_task,
+                                        context_ptr->rest_seg_task_count,
+                                        (int32_t)scs_ptr->rest_process_init_count - 1};
+    svt_segment_pass_run(
+        &pcs_ptr->rest_seg, pcs_ptr, &step, segment_count, context_ptr->rst_tmpbuf, &helpers);
+}
+
+/******************************************************
+ * Sub-pel reference planes
+ *   Each plane of a posted reference is built by a task
+ *   to the Rest threads, so that building them does not
+ *   delay the picture. The reference is held until its
+ *   last plane is built.
+ ******************************************************/
+static void post_subpel_ref_planes(RestContext *context_ptr, PictureControlSet *pcs_ptr,
+                                   EbObjectWrapper *ref_wrapper_ptr) {
+    SequenceControlSet  *scs_ptr   = pcs_ptr->scs_ptr;
+    EbReferenceObject   *ref_obj   = (EbReferenceObject *)ref_wrapper_ptr->object_ptr;
+    const Bool           is_highbd = scs_ptr->static_config.encoder_bit_depth > EB_8BIT;
+    EbPictureBufferDesc *ref_pic;
+    get_recon_pic(pcs_ptr, &ref_pic, is_highbd);
+    const int32_t count = svt_subpel_ref_planes_start(&ref_obj->subpel_planes,
+                                                      &scs_ptr->sf_identity,
+                                                      ref_pic,
+                                                      scs_ptr->static_config.encoder_bit_depth);
+    if (!count)
+        return;
+    svt_object_inc_live_count(ref_wrapper_ptr, 1);
+    for (int32_t index = 0; index < count; index++) {
+        EbObjectWrapper *wrapper_ptr;
+        svt_get_empty_object(context_ptr->rest_feedback_fifo_ptr, &wrapper_ptr);
+        CdefResults *task_ptr            = (CdefResults *)wrapper_ptr->object_ptr;
+        task_ptr->pcs_wrapper_ptr        = NULL;
+        task_ptr->segment_index          = (uint32_t)index;
+        task_ptr->rest_segments          = FALSE;
+        task_ptr->subpel_ref_wrapper_ptr = ref_wrapper_ptr;
+        svt_post_full_object(wrapper_ptr);
+    }
+}
+
 /******************************************************
  * Rest Kernel
  ******************************************************/
@@ -549,8 +648,25 @@ void *rest_kernel(void *input_ptr) {
         EB_GET_FULL_OBJECT(context_ptr->rest_input_fifo_ptr, &cdef_results_wrapper_ptr);
 
         cdef_results_ptr      = (CdefResults *)cdef_results_wrapper_ptr->object_ptr;
+        if (cdef_results_ptr->subpel_ref_wrapper_ptr) {
+            EbObjectWrapper   *ref_wrapper_ptr = cdef_results_ptr->subpel_ref_wrapper_ptr;
+            EbReferenceObject *ref_obj         = (EbReferenceObject *)ref_wrapper_ptr->object_ptr;
+            // the last plane built releases the reference
+            if (svt_subpel_ref_planes_build_plane(&ref_obj->subpel_planes,
+                                                  (int32_t)cdef_results_ptr->segment_index))
+                svt_release_object(ref_wrapper_ptr);
+            svt_release_object(cdef_results_wrapper_ptr);
+            continue;
+        }
         pcs_ptr               = (PictureControlSet *)cdef_results_ptr->pcs_wrapper_ptr->object_ptr;
         scs_ptr               = pcs_ptr->scs_ptr;
+
+        if (cdef_results_ptr->rest_segments) {
+            svt_segment_pass_help(
+                &pcs_ptr->rest_seg, pcs_ptr, context_ptr->rst_tmpbuf, context_ptr->rest_seg_task_count);
+            svt_release_object(cdef_results_wrapper_ptr);
+            continue;
+        }
         FrameHeader *frm_hdr  = &pcs_ptr->parent_pcs_ptr->frm_hdr;
         Bool         is_16bit = scs_ptr->is_16bit_pipeline;
         Av1Common   *cm       = pcs_ptr->parent_pcs_ptr->av1_cm;
@@ -619,7 +735,11 @@ void *rest_kernel(void *input_ptr) {
                 if (pcs_ptr->rst_info[0].frame_restoration_type != RESTORE_NONE ||
                     pcs_ptr->rst_info[1].frame_restoration_type != RESTORE_NONE ||
                     pcs_ptr->rst_info[2].frame_restoration_type != RESTORE_NONE) {
-                    svt_av1_loop_restoration_filter_frame(cm->frame_to_show, cm, 0);
+                    svt_av1_loop_restoration_filter_frame_init(cm->frame_to_show, cm, 0);
+                    rest_run_segments(context_ptr, pcs_ptr, REST_SEG_EVEN);
+                    rest_run_segments(context_ptr, pcs_ptr, REST_SEG_ODD);
+                    rest_run_segments(context_ptr, pcs_ptr, REST_SEG_COPY);
+                    svt_av1_loop_restoration_filter_frame_free(cm);
                 }
             } else {
                 pcs_ptr->rst_info[0].frame_restoration_type = RESTORE_NONE;
@@ -741,6 +861,15 @@ void *rest_kernel(void *input_ptr) {
 
                     // Post Reference Picture
                     svt_post_full_object(picture_demux_results_wrapper_ptr);
+
+                    // Interpolate the sub-pel planes of the posted reference in tasks to the Rest
+                    // threads, the pictures using it in the meantime predicting from the
+                    // reference itself
+                    EbObjectWrapper   *ref_wrapper_ptr =
+                        pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr;
+                    EbReferenceObject *ref_obj = (EbReferenceObject *)ref_wrapper_ptr->object_ptr;
+                    if (ref_obj->subpel_planes.level)
+                        post_subpel_ref_planes(context_ptr, pcs_ptr, ref_wrapper_ptr);
                 }
             }
 
@@ -553,36 +553,62 @@ static INLINE void encode_xq(int32_t *xq, int32_t *xqd, const SgrParamsType *par
     }
 }
 
-// Apply the self-guided filter across an entire restoration unit.
+// Apply the self-guided filter across an entire restoration unit, from the
+// integral images C and D of the unit
 static INLINE void apply_sgr(int32_t sgr_params_idx, const uint8_t *dat8, int32_t width,
                              int32_t height, int32_t dat_stride, int32_t use_highbd,
-                             int32_t bit_depth, int32_t pu_width, int32_t pu_height, int32_t *flt0,
-                             int32_t *flt1, int32_t flt_stride) {
+                             int32_t bit_depth, int32_t pu_width, int32_t pu_height,
+                             const int32_t *C, const int32_t *D, int32_t *A, int32_t *B,
+                             int32_t ii_stride, int32_t *flt0, int32_t *flt1, int32_t flt_stride) {
     for (int32_t i = 0; i < height; i += pu_height) {
         const int32_t  h        = AOMMIN(pu_height, height - i);
         int32_t       *flt0_row = flt0 + i * flt_stride;
         int32_t       *flt1_row = flt1 + i * flt_stride;
         const uint8_t *dat8_row = dat8 + i * dat_stride;
+        const int32_t *c_row    = C + i * ii_stride;
+        const int32_t *d_row    = D + i * ii_stride;
 
         // Iterate over the stripe in blocks of width pu_width
         for (int32_t j = 0; j < width; j += pu_width) {
             const int32_t w = AOMMIN(pu_width, width - j);
 
-            //CHKN SSE
-            svt_av1_selfguided_restoration(dat8_row + j,
-                                           w,
-                                           h,
-                                           dat_stride,
-                                           flt0_row + j,
-                                           flt1_row + j,
-                                           flt_stride,
-                                           sgr_params_idx,
-                                           bit_depth,
-                                           use_highbd);
+            svt_av1_selfguided_restoration_from_ii(dat8_row + j,
+                                                   w,
+                                                   h,
+                                                   dat_stride,
+                                                   c_row + j,
+                                                   d_row + j,
+                                                   A,
+                                                   B,
+                                                   ii_stride,
+                                                   flt0_row + j,
+                                                   flt1_row + j,
+                                                   flt_stride,
+                                                   sgr_params_idx,
+                                                   bit_depth,
+                                                   use_highbd);
         }
     }
 }
 
+// Whether the filter outputs of the parameter set ref are those of the set ep
+static INLINE Bool sgr_params_share_filters(int32_t ref, int32_t ep) {
+    const SgrParamsType *const ref_params = &eb_sgr_params[ref];
+    const SgrParamsType *const params     = &eb_sgr_params[ep];
+    for (int32_t i = 0; i < 2; i++)
+        if (params->r[i] > 0 &&
+            (params->r[i] != ref_params->r[i] || params->s[i] != ref_params->s[i]))
+            return FALSE;
+    return TRUE;
+}
+
+// The first parameter set from start_ep with the filter outputs of the set ep
+static INLINE int32_t first_set_sharing_filters(int32_t start_ep, int32_t ep) {
+    int32_t ref = start_ep;
+    while (ref < ep && !sgr_params_share_filters(ref, ep)) ref++;
+    return ref;
+}
+
 static SgrprojInfo search_selfguided_restoration(
     const uint8_t *dat8, int32_t width, int32_t height, int32_t dat_stride, const uint8_t *src8,
     int32_t src_stride, int32_t use_highbitdepth, int32_t bit_depth, int32_t pu_width,
@@ -594,6 +620,15 @@ static SgrprojInfo search_selfguided_restoration(
     int64_t  besterr = -1;
     int32_t  exqd[2], bestxqd[2] = {0, 0};
     int32_t  flt_stride = ((width + 7) & ~7) + 8;
+    // The box sums of all the parameter sets come from the integral images of
+    // the unit, the A and B arrays of a processing unit share their stride
+    const int32_t ii_stride = SGRPROJ_II_STRIDE(width);
+    const int32_t ii_origin = (SGRPROJ_BORDER_VERT + 1) * ii_stride + SGRPROJ_BORDER_HORZ + 1;
+    int32_t      *C         = flt1 + RESTORATION_UNITPELS_MAX + ii_origin;
+    int32_t      *D         = C + SGRPROJ_II_PELS_MAX;
+    int32_t      *A         = D - ii_origin + SGRPROJ_II_PELS_MAX + ii_stride + 1;
+    int32_t      *B         = A + SGRPROJ_AB_PELS_MAX;
+    assert(SGRPROJ_II_ROWS(height) * ii_stride <= SGRPROJ_II_PELS_MAX);
     assert(pu_width == (RESTORATION_PROC_UNIT_SIZE >> 1) || pu_width == RESTORATION_PROC_UNIT_SIZE);
     assert(pu_height == (RESTORATION_PROC_UNIT_SIZE >> 1) ||
            pu_height == RESTORATION_PROC_UNIT_SIZE);
@@ -609,20 +644,42 @@ static SgrprojInfo search_selfguided_restoration(
           : AOMMIN(SGRPROJ_PARAMS, mid_ep + step);
     UNUSED(sg_frame_ep_cnt);
 
+    // A set with the filter of an earlier set is evaluated right after it, on
+    // its filtered unit
+    int8_t  ep_order[SGRPROJ_PARAMS];
+    int32_t ep_count = 0;
     for (ep = start_ep; ep < end_ep; ep++) {
+        if (first_set_sharing_filters(start_ep, ep) < ep)
+            continue;
+        ep_order[ep_count++] = ep;
+        for (int32_t e = ep + 1; e < end_ep; e++)
+            if (first_set_sharing_filters(start_ep, e) == ep)
+                ep_order[ep_count++] = e;
+    }
+    if (ep_count)
+        svt_av1_sgr_integral_images(
+            dat8, width, height, dat_stride, C, D, ii_stride, use_highbitdepth);
+    for (int32_t idx = 0; idx < ep_count; idx++) {
         int32_t exq[2];
-        apply_sgr(ep,
-                  dat8,
-                  width,
-                  height,
-                  dat_stride,
-                  use_highbitdepth,
-                  bit_depth,
-                  pu_width,
-                  pu_height,
-                  flt0,
-                  flt1,
-                  flt_stride);
+        ep = ep_order[idx];
+        if (!idx || !sgr_params_share_filters(ep_order[idx - 1], ep))
+            apply_sgr(ep,
+                      dat8,
+                      width,
+                      height,
+                      dat_stride,
+                      use_highbitdepth,
+                      bit_depth,
+                      pu_width,
+                      pu_height,
+                      C,
+                      D,
+                      A,
+                      B,
+                      ii_stride,
+                      flt0,
+                      flt1,
+                      flt_stride);
 #ifdef ARCH_X86_64
         aom_clear_system_state();
 #endif
@@ -658,7 +715,8 @@ static SgrprojInfo search_selfguided_restoration(
                                                     2,
                                                     exqd,
                                                     params);
-        if (besterr == -1 || err < besterr) {
+        // the lowest set wins a tie as when evaluated in order
+        if (besterr == -1 || err < besterr || (err == besterr && ep < bestep)) {
             bestep     = ep;
             besterr    = err;
             bestxqd[0] = exqd[0];
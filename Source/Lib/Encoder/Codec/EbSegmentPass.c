@@ -0,0 +1,91 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include "EbSegmentPass.h"
+#include "EbThreads.h"
+
+EbErrorType svt_segment_pass_ctor(SegmentPass *sp) {
+    EB_CREATE_MUTEX(sp->mutex);
+    EB_CREATE_SEMAPHORE(sp->done_semaphore, 0, 1);
+    return EB_ErrorNone;
+}
+
+void svt_segment_pass_dctor(SegmentPass *sp) {
+    EB_DESTROY_MUTEX(sp->mutex);
+    EB_DESTROY_SEMAPHORE(sp->done_semaphore);
+}
+
+/* Takes the segments of the current pass until none is left. The step is read with the segment,
+ * so a helper crossing into a later pass runs the segments of that pass. */
+static void segment_pass_do(SegmentPass *sp, struct PictureControlSet *pcs_ptr,
+                            void *thread_ctx) {
+    for (;;) {
+        svt_block_on_mutex(sp->mutex);
+        if (sp->next == sp->total_count) {
+            svt_release_mutex(sp->mutex);
+            break;
+        }
+        const uint32_t        segment_index = sp->next++;
+        const SegmentPassStep step          = sp->step;
+        sp->running++;
+        svt_release_mutex(sp->mutex);
+
+        const uint64_t value = step.fn(pcs_ptr, thread_ctx, &step, segment_index);
+
+        svt_block_on_mutex(sp->mutex);
+        sp->sum += value;
+        const Bool last = --sp->running == 0 && sp->next == sp->total_count && sp->waiting;
+        if (last)
+            sp->waiting = FALSE;
+        svt_release_mutex(sp->mutex);
+        if (last)
+            svt_post_semaphore(sp->done_semaphore);
+    }
+}
+
+/* Runs a pass over segment_count segments of the picture with the helpers of the process,
+ * returns the sum of the values of the segments */
+uint64_t svt_segment_pass_run(SegmentPass *sp, struct PictureControlSet *pcs_ptr,
+                              const SegmentPassStep *step, uint16_t segment_count,
+                              void *thread_ctx, const SegmentPassHelpers *helpers) {
+    svt_block_on_mutex(sp->mutex);
+    sp->step        = *step;
+    sp->total_count = segment_count;
+    sp->next        = 0;
+    sp->sum         = 0;
+    svt_release_mutex(sp->mutex);
+
+    // Helper tasks, at most one per other thread of the process across the pictures
+    for (uint32_t i = 1; helpers->fifo_ptr && i < segment_count; i++) {
+        if (svt_atomic_add_i32(helpers->task_count, 1) > helpers->max_task_count) {
+            svt_atomic_add_i32(helpers->task_count, -1);
+            break;
+        }
+        helpers->post_task(helpers->fifo_ptr, pcs_ptr);
+    }
+
+    segment_pass_do(sp, pcs_ptr, thread_ctx);
+
+    svt_block_on_mutex(sp->mutex);
+    const Bool wait = sp->running > 0;
+    sp->waiting     = wait;
+    svt_release_mutex(sp->mutex);
+    if (wait)
+        svt_block_on_semaphore(sp->done_semaphore);
+    return sp->sum;
+}
+
+/* Runs a helper task taken from the feedback fifo of the process */
+void svt_segment_pass_help(SegmentPass *sp, struct PictureControlSet *pcs_ptr, void *thread_ctx,
+                           volatile int32_t *task_count) {
+    svt_atomic_add_i32(task_count, -1);
+    segment_pass_do(sp, pcs_ptr, thread_ctx);
+}
@@ -0,0 +1,79 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbSegmentPass_h
+#define EbSegmentPass_h
+
+#include "EbDefinitions.h"
+#include "EbSystemResourceManager.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct PictureControlSet;
+struct SegmentPassStep;
+
+/* Processes one segment of a pass, thread_ctx is the context of the thread taking it. Returns
+ * the value of the segment added to the result of the pass. */
+typedef uint64_t (*SegmentPassFn)(struct PictureControlSet *pcs_ptr, void *thread_ctx,
+                                  const struct SegmentPassStep *step, uint32_t segment_index);
+
+/* Posts one helper task of the picture to fifo_ptr */
+typedef void (*SegmentPassPostFn)(EbFifo *fifo_ptr, struct PictureControlSet *pcs_ptr);
+
+/* A pass: the function run on its segments and its parameters */
+typedef struct SegmentPassStep {
+    SegmentPassFn fn;
+    uint8_t       pass;
+    uint8_t       arg[2];
+} SegmentPassStep;
+
+/* The helper tasks of the passes of a process */
+typedef struct SegmentPassHelpers {
+    EbFifo           *fifo_ptr; // the feedback fifo of the process, no helpers when NULL
+    SegmentPassPostFn post_task;
+    volatile int32_t *task_count; // helper tasks sent, not taken yet, across the pictures
+    int32_t           max_task_count; // the other threads of the process
+} SegmentPassHelpers;
+
+/**************************************
+ * SegmentPass
+ *   The passes over the segments of a picture run by the threads of
+ *   a process together, one pass at a time. The thread running a pass
+ *   sends helper tasks to the other threads of the process, and all
+ *   of them take the segments of the pass one at a time. A helper
+ *   task arriving after the pass finds no segment left, or takes the
+ *   segments of a later pass of the picture, which is as good.
+ **************************************/
+typedef struct SegmentPass {
+    EbHandle        mutex;
+    EbHandle        done_semaphore;
+    SegmentPassStep step;
+    Bool            waiting;
+    uint16_t        total_count;
+    uint16_t        next; // first segment not taken
+    uint16_t        running; // segments taken, not done
+    uint64_t        sum;
+} SegmentPass;
+
+EbErrorType svt_segment_pass_ctor(SegmentPass *sp);
+void        svt_segment_pass_dctor(SegmentPass *sp);
+uint64_t    svt_segment_pass_run(SegmentPass *sp, struct PictureControlSet *pcs_ptr,
+                                 const SegmentPassStep *step, uint16_t segment_count,
+                                 void *thread_ctx, const SegmentPassHelpers *helpers);
+void        svt_segment_pass_help(SegmentPass *sp, struct PictureControlSet *pcs_ptr,
+                                  void *thread_ctx, volatile int32_t *task_count);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbSegmentPass_h
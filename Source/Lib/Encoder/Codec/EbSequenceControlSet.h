@@ -230,6 +230,8 @@ typedef struct SequenceControlSet {
     uint32_t         rest_process_init_count;
     uint32_t         tpl_disp_process_init_count;
     uint32_t         total_process_init_count;
+    // Number of worker threads kept active over the stages when adaptive_threads is set
+    uint32_t         thread_budget;
     int32_t          lap_rc;
     TWO_PASS         twopass;
     double           double_frame_rate;
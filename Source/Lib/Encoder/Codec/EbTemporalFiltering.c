@@ -2232,37 +2232,48 @@ static void tf_16x16_sub_pel_search(PictureParentControlSet *pcs_ptr, MeContext
                     mv_unit.mv->x = mv_x + i;
                     mv_unit.mv->y = mv_y + j;
 
-                    av1_inter_prediction(scs_ptr,
-                                         NULL, //pcs_ptr,
-                                         (uint32_t)interp_filters,
-                                         &blk_ptr,
-                                         0, //ref_frame_type,
-                                         &mv_unit,
-                                         0, //use_intrabc,
-                                         SIMPLE_TRANSLATION,
-                                         0,
-                                         0,
-                                         1, //compound_idx not used
-                                         NULL, // interinter_comp not used
-                                         NULL,
-                                         NULL,
-                                         NULL,
-                                         0,
-                                         0,
-                                         0,
-                                         0,
-                                         pu_origin_x,
-                                         pu_origin_y,
-                                         bsize,
-                                         bsize,
-                                         !is_highbd ? pic_ptr_ref : &reference_ptr,
-                                         NULL, //ref_pic_list1,
-                                         &prediction_ptr,
-                                         local_origin_x,
-                                         local_origin_y,
-                                         PICTURE_BUFFER_DESC_LUMA_MASK,
-                                         (uint8_t)encoder_bit_depth,
-                                         0); // is_16bit_pipeline
+                    // read the prediction from the half-pel planes when they hold it
+                    const MV       mv = {mv_unit.mv->y, mv_unit.mv->x};
+                    int32_t        hpel_stride = 0;
+                    const uint8_t *hpel = svt_hpel_cache_get(&context_ptr->tf_hpel_cache,
+                                                             pu_origin_x,
+                                                             pu_origin_y,
+                                                             mv,
+                                                             bsize,
+                                                             bsize,
+                                                             &hpel_stride);
+                    if (hpel == NULL)
+                        av1_inter_prediction(scs_ptr,
+                                             NULL, //pcs_ptr,
+                                             (uint32_t)interp_filters,
+                                             &blk_ptr,
+                                             0, //ref_frame_type,
+                                             &mv_unit,
+                                             0, //use_intrabc,
+                                             SIMPLE_TRANSLATION,
+                                             0,
+                                             0,
+                                             1, //compound_idx not used
+                                             NULL, // interinter_comp not used
+                                             NULL,
+                                             NULL,
+                                             NULL,
+                                             0,
+                                             0,
+                                             0,
+                                             0,
+                                             pu_origin_x,
+                                             pu_origin_y,
+                                             bsize,
+                                             bsize,
+                                             !is_highbd ? pic_ptr_ref : &reference_ptr,
+                                             NULL, //ref_pic_list1,
+                                             &prediction_ptr,
+                                             local_origin_x,
+                                             local_origin_y,
+                                             PICTURE_BUFFER_DESC_LUMA_MASK,
+                                             (uint8_t)encoder_bit_depth,
+                                             0); // is_16bit_pipeline
 
                     uint64_t distortion;
                     if (!is_highbd) {
@@ -2274,8 +2285,11 @@ static void tf_16x16_sub_pel_search(PictureParentControlSet *pcs_ptr, MeContext
                         const AomVarianceFnPtr *fn_ptr = &mefn_ptr[BLOCK_16X16];
 
                         unsigned int sse;
-                        distortion = fn_ptr->vf(
-                            pred_y_ptr, stride_pred[C_Y], src_y_ptr, stride_src[C_Y], &sse);
+                        distortion = fn_ptr->vf(hpel ? hpel : pred_y_ptr,
+                                                hpel ? hpel_stride : (int)stride_pred[C_Y],
+                                                src_y_ptr,
+                                                stride_src[C_Y],
+                                                &sse);
                     } else {
                         uint16_t *pred_y_ptr = pred_16bit[C_Y] + bsize * idx_y * stride_pred[C_Y] +
                             bsize * idx_x;
@@ -2283,8 +2297,13 @@ static void tf_16x16_sub_pel_search(PictureParentControlSet *pcs_ptr, MeContext
                             bsize * idx_x;
 
                         unsigned int sse;
-                        distortion = variance_highbd(
-                            pred_y_ptr, stride_pred[C_Y], src_y_ptr, stride_src[C_Y], 16, 16, &sse);
+                        distortion = variance_highbd(hpel ? (uint16_t *)hpel : pred_y_ptr,
+                                                     hpel ? hpel_stride : (int)stride_pred[C_Y],
+                                                     src_y_ptr,
+                                                     stride_src[C_Y],
+                                                     16,
+                                                     16,
+                                                     &sse);
                     }
                     if (distortion < context_ptr->tf_16x16_block_error[idx_32x32 * 4 + idx_16x16]) {
                         context_ptr->tf_16x16_block_error[idx_32x32 * 4 + idx_16x16] = distortion;
@@ -2301,6 +2320,9 @@ static void tf_16x16_sub_pel_search(PictureParentControlSet *pcs_ptr, MeContext
                 for (signed short j = -2; j <= 2; j = j + 2) {
                     if (pcs_ptr->tf_ctrls.quarter_pel_mode == 2 && i != 0 && j != 0)
                         continue;
+                    // the center is the best position of the 1/2 pel refinement
+                    if (i == 0 && j == 0)
+                        continue;
                     mv_unit.mv->x = mv_x + i;
                     mv_unit.mv->y = mv_y + j;
 
@@ -2375,6 +2397,9 @@ static void tf_16x16_sub_pel_search(PictureParentControlSet *pcs_ptr, MeContext
                     for (signed short j = -1; j <= 1; j++) {
                         if (pcs_ptr->tf_ctrls.eight_pel_mode == 2 && i != 0 && j != 0)
                             continue;
+                        // the center is the best position of the 1/4 pel refinement
+                        if (i == 0 && j == 0)
+                            continue;
                         mv_unit.mv->x = mv_x + i;
                         mv_unit.mv->y = mv_y + j;
 
@@ -2469,23 +2494,38 @@ uint64_t svt_check_position_64x64(TF_SUBPEL_SEARCH_PARAMS  tf_sp_param,
     mv_unit.mv->x = tf_sp_param.mv_x + tf_sp_param.xd;
     mv_unit.mv->y = tf_sp_param.mv_y + tf_sp_param.yd;
 
-    av1_simple_luma_unipred(
-        scs_ptr,
-        scs_ptr->sf_identity,
-        tf_sp_param.interp_filters,
-        blk_ptr,
-        0, //ref_frame_type,
-        &mv_unit,
-        tf_sp_param.pu_origin_x,
-        tf_sp_param.pu_origin_y,
-        tf_sp_param.bsize,
-        tf_sp_param.bsize,
-        pic_ptr_ref,
-        &prediction_ptr,
-        tf_sp_param.local_origin_x,
-        tf_sp_param.local_origin_y,
-        (uint8_t)tf_sp_param.encoder_bit_depth,
-        tf_sp_param.xd == 0 && tf_sp_param.yd == 0 ? tf_sp_param.subsampling_shift : 0);
+    // read the prediction from the half-pel planes when they hold it
+    int32_t        hpel_stride = 0;
+    const uint8_t *hpel        = NULL;
+    if (tf_sp_param.interp_filters ==
+        (uint32_t)av1_make_interp_filters(EIGHTTAP_REGULAR, EIGHTTAP_REGULAR)) {
+        const MV mv = {mv_unit.mv->y, mv_unit.mv->x};
+        hpel        = svt_hpel_cache_get(&context_ptr->tf_hpel_cache,
+                                  tf_sp_param.pu_origin_x,
+                                  tf_sp_param.pu_origin_y,
+                                  mv,
+                                  tf_sp_param.bsize,
+                                  tf_sp_param.bsize,
+                                  &hpel_stride);
+    }
+    if (hpel == NULL)
+        av1_simple_luma_unipred(
+            scs_ptr,
+            scs_ptr->sf_identity,
+            tf_sp_param.interp_filters,
+            blk_ptr,
+            0, //ref_frame_type,
+            &mv_unit,
+            tf_sp_param.pu_origin_x,
+            tf_sp_param.pu_origin_y,
+            tf_sp_param.bsize,
+            tf_sp_param.bsize,
+            pic_ptr_ref,
+            &prediction_ptr,
+            tf_sp_param.local_origin_x,
+            tf_sp_param.local_origin_y,
+            (uint8_t)tf_sp_param.encoder_bit_depth,
+            tf_sp_param.xd == 0 && tf_sp_param.yd == 0 ? tf_sp_param.subsampling_shift : 0);
 
     uint64_t distortion;
     if (!tf_sp_param.is_highbd) {
@@ -2496,8 +2536,9 @@ uint64_t svt_check_position_64x64(TF_SUBPEL_SEARCH_PARAMS  tf_sp_param,
         const AomVarianceFnPtr *fn_ptr = tf_sp_param.subsampling_shift ? &mefn_ptr[BLOCK_64X32]
                                                                        : &mefn_ptr[BLOCK_64X64];
         unsigned int            sse;
-        distortion = fn_ptr->vf(pred_y_ptr,
-                                stride_pred[C_Y] << tf_sp_param.subsampling_shift,
+        distortion = fn_ptr->vf(hpel ? hpel : pred_y_ptr,
+                                (hpel ? hpel_stride : (int)stride_pred[C_Y])
+                                    << tf_sp_param.subsampling_shift,
                                 src_y_ptr,
                                 stride_src[C_Y] << tf_sp_param.subsampling_shift,
                                 &sse)
@@ -2514,8 +2555,10 @@ uint64_t svt_check_position_64x64(TF_SUBPEL_SEARCH_PARAMS  tf_sp_param,
 
         unsigned int sse;
 
-        distortion = fn_ptr->vf_hbd_10(CONVERT_TO_BYTEPTR(pred_y_ptr),
-                                       stride_pred[C_Y] << tf_sp_param.subsampling_shift,
+        distortion = fn_ptr->vf_hbd_10(
+                         CONVERT_TO_BYTEPTR(hpel ? (const uint16_t *)hpel : pred_y_ptr),
+                         (hpel ? hpel_stride : (int)stride_pred[C_Y])
+                             << tf_sp_param.subsampling_shift,
                                        CONVERT_TO_BYTEPTR(src_y_ptr),
                                        stride_src[C_Y] << tf_sp_param.subsampling_shift,
                                        &sse)
@@ -2547,23 +2590,38 @@ uint64_t svt_check_position(TF_SUBPEL_SEARCH_PARAMS tf_sp_param, PictureParentCo
     mv_unit.mv->x               = tf_sp_param.mv_x + tf_sp_param.xd;
     mv_unit.mv->y               = tf_sp_param.mv_y + tf_sp_param.yd;
 
-    av1_simple_luma_unipred(
-        scs_ptr,
-        scs_ptr->sf_identity,
-        tf_sp_param.interp_filters,
-        blk_ptr,
-        0, //ref_frame_type,
-        &mv_unit,
-        tf_sp_param.pu_origin_x,
-        tf_sp_param.pu_origin_y,
-        tf_sp_param.bsize,
-        tf_sp_param.bsize,
-        pic_ptr_ref,
-        &prediction_ptr,
-        tf_sp_param.local_origin_x,
-        tf_sp_param.local_origin_y,
-        (uint8_t)tf_sp_param.encoder_bit_depth,
-        tf_sp_param.xd == 0 && tf_sp_param.yd == 0 ? tf_sp_param.subsampling_shift : 0);
+    // read the prediction from the half-pel planes when they hold it
+    int32_t        hpel_stride = 0;
+    const uint8_t *hpel        = NULL;
+    if (tf_sp_param.interp_filters ==
+        (uint32_t)av1_make_interp_filters(EIGHTTAP_REGULAR, EIGHTTAP_REGULAR)) {
+        const MV mv = {mv_unit.mv->y, mv_unit.mv->x};
+        hpel        = svt_hpel_cache_get(&context_ptr->tf_hpel_cache,
+                                  tf_sp_param.pu_origin_x,
+                                  tf_sp_param.pu_origin_y,
+                                  mv,
+                                  tf_sp_param.bsize,
+                                  tf_sp_param.bsize,
+                                  &hpel_stride);
+    }
+    if (hpel == NULL)
+        av1_simple_luma_unipred(
+            scs_ptr,
+            scs_ptr->sf_identity,
+            tf_sp_param.interp_filters,
+            blk_ptr,
+            0, //ref_frame_type,
+            &mv_unit,
+            tf_sp_param.pu_origin_x,
+            tf_sp_param.pu_origin_y,
+            tf_sp_param.bsize,
+            tf_sp_param.bsize,
+            pic_ptr_ref,
+            &prediction_ptr,
+            tf_sp_param.local_origin_x,
+            tf_sp_param.local_origin_y,
+            (uint8_t)tf_sp_param.encoder_bit_depth,
+            tf_sp_param.xd == 0 && tf_sp_param.yd == 0 ? tf_sp_param.subsampling_shift : 0);
 
     uint64_t distortion;
     if (!tf_sp_param.is_highbd) {
@@ -2574,8 +2632,9 @@ uint64_t svt_check_position(TF_SUBPEL_SEARCH_PARAMS tf_sp_param, PictureParentCo
         const AomVarianceFnPtr *fn_ptr = tf_sp_param.subsampling_shift ? &mefn_ptr[BLOCK_32X16]
                                                                        : &mefn_ptr[BLOCK_32X32];
         unsigned int            sse;
-        distortion = fn_ptr->vf(pred_y_ptr,
-                                stride_pred[C_Y] << tf_sp_param.subsampling_shift,
+        distortion = fn_ptr->vf(hpel ? hpel : pred_y_ptr,
+                                (hpel ? hpel_stride : (int)stride_pred[C_Y])
+                                    << tf_sp_param.subsampling_shift,
                                 src_y_ptr,
                                 stride_src[C_Y] << tf_sp_param.subsampling_shift,
                                 &sse)
@@ -2592,8 +2651,10 @@ uint64_t svt_check_position(TF_SUBPEL_SEARCH_PARAMS tf_sp_param, PictureParentCo
 
         unsigned int sse;
 
-        distortion = fn_ptr->vf_hbd_10(CONVERT_TO_BYTEPTR(pred_y_ptr),
-                                       stride_pred[C_Y] << tf_sp_param.subsampling_shift,
+        distortion = fn_ptr->vf_hbd_10(
+                         CONVERT_TO_BYTEPTR(hpel ? (const uint16_t *)hpel : pred_y_ptr),
+                         (hpel ? hpel_stride : (int)stride_pred[C_Y])
+                             << tf_sp_param.subsampling_shift,
                                        CONVERT_TO_BYTEPTR(src_y_ptr),
                                        stride_src[C_Y] << tf_sp_param.subsampling_shift,
                                        &sse)
@@ -4873,6 +4934,27 @@ static EbErrorType produce_temporally_filtered_pic(
                         context_ptr,
                         input_picture_ptr_central); // source picture
 
+                    // the sub-pel searches of the block share the half-pel planes of the
+                    // reference around its motion compensated position
+                    const uint8_t subpel_bit_depth = (context_ptr->tf_ctrls.use_8bit_subpel)
+                        ? EB_8BIT
+                        : encoder_bit_depth;
+                    const Bool    hme_only         = context_ptr->tf_use_pred_64x64_only_th ==
+                        (uint8_t)~0;
+                    svt_hpel_cache_reset(
+                        &context_ptr->tf_hpel_cache,
+                        &scs->sf_identity,
+                        list_input_picture_ptr[frame_index],
+                        list_picture_control_set_ptr[frame_index]->altref_buffer_highbd[C_Y],
+                        subpel_bit_depth,
+                        blk_col * BW +
+                            (hme_only ? context_ptr->search_results[0][0].hme_sc_x
+                                      : _MVXT(context_ptr->p_best_mv64x64[0]) >> 2),
+                        blk_row * BH +
+                            (hme_only ? context_ptr->search_results[0][0].hme_sc_y
+                                      : _MVYT(context_ptr->p_best_mv64x64[0]) >> 2),
+                        BW);
+
                     if (context_ptr->tf_use_pred_64x64_only_th &&
                         (context_ptr->tf_use_pred_64x64_only_th == (uint8_t)~0 ||
                          tf_use_64x64_pred(context_ptr))) {
@@ -4890,7 +4972,7 @@ static EbErrorType produce_temporally_filtered_pic(
                             (uint32_t)blk_col * BW,
                             (uint32_t)blk_row * BH,
                             ss_x,
-                            (context_ptr->tf_ctrls.use_8bit_subpel) ? EB_8BIT : encoder_bit_depth);
+                            subpel_bit_depth);
 
                         // Perform MC using the information acquired using the ME step
                         tf_64x64_inter_prediction(picture_control_set_ptr_central,
@@ -4925,9 +5007,7 @@ static EbErrorType produce_temporally_filtered_pic(
                                                         (uint32_t)blk_col * BW,
                                                         (uint32_t)blk_row * BH,
                                                         ss_x,
-                                                        (context_ptr->tf_ctrls.use_8bit_subpel)
-                                                            ? EB_8BIT
-                                                            : encoder_bit_depth);
+                                                        subpel_bit_depth);
 
                                 // Perform TF sub-pel search for 16x16 blocks
                                 tf_16x16_sub_pel_search(picture_control_set_ptr_central,
@@ -4943,9 +5023,7 @@ static EbErrorType produce_temporally_filtered_pic(
                                                         (uint32_t)blk_col * BW,
                                                         (uint32_t)blk_row * BH,
                                                         ss_x,
-                                                        (context_ptr->tf_ctrls.use_8bit_subpel)
-                                                            ? EB_8BIT
-                                                            : encoder_bit_depth);
+                                                        subpel_bit_depth);
 
                                 // Derive tf_32x32_block_split_flag
                                 if (context_ptr->tf_16x16_search_do[context_ptr->idx_32x32]) {
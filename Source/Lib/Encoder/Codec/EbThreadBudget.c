@@ -0,0 +1,182 @@
+/*
+* Copyright (c) 2019, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <stdio.h>
+
+#include "EbThreadBudget.h"
+#include "EbTime.h"
+#include "EbUtility.h"
+#include "EbLog.h"
+
+// A stage is saturated when its active threads are busy at least this share of the time
+#define THREAD_BUDGET_SATURATED 0.85
+// A donor must stay below this utilization after giving away one thread
+#define THREAD_BUDGET_DONOR_MAX 0.8
+
+static uint64_t thread_budget_time_us(void) {
+    uint64_t seconds, useconds;
+    svt_av1_get_time(&seconds, &useconds);
+    return seconds * 1000000 + useconds;
+}
+
+static void thread_budget_log_allocation(const ThreadBudget *tb) {
+    char     line[512];
+    int      len    = 0;
+    uint32_t active = 0;
+    for (uint32_t s = 0; s < tb->stage_count && len < (int)sizeof(line); s++) {
+        const ThreadBudgetStage *stage = &tb->stages[s];
+        len += snprintf(line + len,
+                        sizeof(line) - len,
+                        " %s %u/%u",
+                        stage->name,
+                        stage->active_count,
+                        stage->total_count);
+        active += stage->active_count;
+    }
+    SVT_INFO("thread budget %u, active threads %u:%s\n", tb->budget, active, line);
+}
+
+void thread_budget_add_stage(ThreadBudget *tb, const char *name, EbSystemResource *srm,
+                             uint32_t total_count) {
+    if (tb->stage_count == THREAD_BUDGET_MAX_STAGES || !srm || !total_count)
+        return;
+    ThreadBudgetStage *stage = &tb->stages[tb->stage_count++];
+    stage->name              = name;
+    stage->srm               = srm;
+    stage->total_count       = total_count;
+    stage->active_count      = total_count;
+    stage->busy_us           = 0;
+}
+
+/**************************************
+ * thread_budget_init
+ *   Shares the budget over the stages in proportion to the number of
+ *   threads each stage was created with, then starts monitoring them.
+ *   Must be called before the stage threads are started.
+ **************************************/
+void thread_budget_init(ThreadBudget *tb, uint32_t budget) {
+    uint32_t total = 0;
+    for (uint32_t s = 0; s < tb->stage_count; s++) total += tb->stages[s].total_count;
+
+    // every stage keeps at least one thread
+    tb->budget = MIN(MAX(budget, tb->stage_count), total);
+
+    uint32_t assigned = 0;
+    for (uint32_t s = 0; s < tb->stage_count; s++) {
+        ThreadBudgetStage *stage = &tb->stages[s];
+        stage->active_count      = MAX(1, (uint32_t)((uint64_t)stage->total_count * tb->budget / total));
+        assigned += stage->active_count;
+    }
+    // hand out the rounding leftover, or take back what the minimum of one overspent
+    while (assigned < tb->budget) {
+        for (uint32_t s = 0; s < tb->stage_count && assigned < tb->budget; s++) {
+            ThreadBudgetStage *stage = &tb->stages[s];
+            if (stage->active_count < stage->total_count) {
+                stage->active_count++;
+                assigned++;
+            }
+        }
+    }
+    while (assigned > tb->budget) {
+        uint32_t largest = 0;
+        for (uint32_t s = 1; s < tb->stage_count; s++)
+            if (tb->stages[s].active_count > tb->stages[largest].active_count)
+                largest = s;
+        tb->stages[largest].active_count--;
+        assigned--;
+    }
+
+    for (uint32_t s = 0; s < tb->stage_count; s++) {
+        ThreadBudgetStage *stage = &tb->stages[s];
+        svt_system_resource_enable_monitor(stage->srm);
+        svt_system_resource_set_active_process_count(stage->srm, stage->active_count);
+    }
+    tb->last_update_us = 0;
+    tb->enabled        = TRUE;
+    thread_budget_log_allocation(tb);
+}
+
+/**************************************
+ * thread_budget_update
+ *   Called from a single process at picture rate. Once per period, the
+ *   busy time of each stage is compared with the time its active threads
+ *   had: when a stage is saturated and another one can give up a thread
+ *   without getting saturated itself, one thread is moved between them.
+ **************************************/
+void thread_budget_update(ThreadBudget *tb) {
+    const uint64_t now = thread_budget_time_us();
+    if (tb->last_update_us && now - tb->last_update_us < THREAD_BUDGET_PERIOD_US)
+        return;
+
+    double   load[THREAD_BUDGET_MAX_STAGES];
+    double   util[THREAD_BUDGET_MAX_STAGES];
+    uint32_t active = 0;
+    for (uint32_t s = 0; s < tb->stage_count; s++) {
+        ThreadBudgetStage *stage = &tb->stages[s];
+        const uint64_t     busy  = svt_system_resource_get_busy_time(stage->srm);
+        // number of threads worth of work done by the stage over the period
+        load[s] = tb->last_update_us ? (double)(busy - stage->busy_us) / (now - tb->last_update_us)
+                                     : 0;
+        util[s] = load[s] / stage->active_count;
+        stage->busy_us = busy;
+        active += stage->active_count;
+    }
+    const Bool first_period = tb->last_update_us == 0;
+    tb->last_update_us      = now;
+    if (first_period)
+        return;
+
+    int32_t receiver = -1;
+    for (uint32_t s = 0; s < tb->stage_count; s++) {
+        const ThreadBudgetStage *stage = &tb->stages[s];
+        if (stage->active_count < stage->total_count && util[s] >= THREAD_BUDGET_SATURATED &&
+            (receiver < 0 || util[s] > util[receiver]))
+            receiver = s;
+    }
+    if (receiver < 0)
+        return;
+
+    int32_t donor = -1;
+    if (active >= tb->budget) {
+        for (uint32_t s = 0; s < tb->stage_count; s++) {
+            const ThreadBudgetStage *stage = &tb->stages[s];
+            if ((int32_t)s != receiver && stage->active_count > 1 &&
+                load[s] <= THREAD_BUDGET_DONOR_MAX * (stage->active_count - 1) &&
+                (donor < 0 || util[s] < util[donor]))
+                donor = s;
+        }
+        if (donor < 0)
+            return;
+        ThreadBudgetStage *giver = &tb->stages[donor];
+        giver->active_count--;
+        svt_system_resource_set_active_process_count(giver->srm, giver->active_count);
+    }
+    ThreadBudgetStage *stage = &tb->stages[receiver];
+    stage->active_count++;
+    svt_system_resource_set_active_process_count(stage->srm, stage->active_count);
+
+    if (donor >= 0)
+        SVT_INFO("thread budget: %s busy %.0f%%, %u -> %u threads; %s busy %.0f%%, %u -> %u threads\n",
+                 stage->name,
+                 util[receiver] * 100,
+                 stage->active_count - 1,
+                 stage->active_count,
+                 tb->stages[donor].name,
+                 util[donor] * 100,
+                 tb->stages[donor].active_count + 1,
+                 tb->stages[donor].active_count);
+    else
+        SVT_INFO("thread budget: %s busy %.0f%%, %u -> %u threads\n",
+                 stage->name,
+                 util[receiver] * 100,
+                 stage->active_count - 1,
+                 stage->active_count);
+}
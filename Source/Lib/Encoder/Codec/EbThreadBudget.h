@@ -0,0 +1,59 @@
+/*
+* Copyright (c) 2019, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbThreadBudget_h
+#define EbThreadBudget_h
+
+#include "EbDefinitions.h"
+#include "EbSystemResourceManager.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define THREAD_BUDGET_MAX_STAGES 12
+// Minimum time between two rebalancing decisions
+#define THREAD_BUDGET_PERIOD_US 250000
+
+/**************************************
+ * ThreadBudgetStage
+ *   A pool of worker threads consuming the full queue of srm.
+ **************************************/
+typedef struct ThreadBudgetStage {
+    const char       *name;
+    EbSystemResource *srm;
+    uint32_t          total_count; // threads created for the stage
+    uint32_t          active_count; // threads allowed to get tasks
+    uint64_t          busy_us; // srm busy time at the last update
+} ThreadBudgetStage;
+
+/**************************************
+ * ThreadBudget
+ *   Keeps at most budget worker threads active over the stages and moves
+ *   one thread at a time from a lightly loaded stage to a saturated one.
+ **************************************/
+typedef struct ThreadBudget {
+    Bool              enabled;
+    uint32_t          budget;
+    uint32_t          stage_count;
+    ThreadBudgetStage stages[THREAD_BUDGET_MAX_STAGES];
+    uint64_t          last_update_us;
+} ThreadBudget;
+
+void thread_budget_add_stage(ThreadBudget *tb, const char *name, EbSystemResource *srm,
+                             uint32_t total_count);
+void thread_budget_init(ThreadBudget *tb, uint32_t budget);
+void thread_budget_update(ThreadBudget *tb);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbThreadBudget_h
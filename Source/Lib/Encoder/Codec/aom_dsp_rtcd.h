@@ -68,6 +68,10 @@ extern "C" {
     RTCD_EXTERN uint64_t(*svt_compute_cdef_dist_16bit)(const uint16_t *dst, int32_t dstride, const uint16_t *src, const CdefList *dlist, int32_t cdef_count, BlockSize bsize, int32_t coeff_shift, int32_t pli, uint8_t subsampling_factor);
     uint64_t compute_cdef_dist_8bit_c(const uint8_t *dst8, int32_t dstride, const uint8_t *src8, const CdefList *dlist, int32_t cdef_count, BlockSize bsize, int32_t coeff_shift, int32_t pli, uint8_t subsampling_factor);
     RTCD_EXTERN uint64_t(*svt_compute_cdef_dist_8bit)(const uint8_t *dst8, int32_t dstride, const uint8_t *src8, const CdefList *dlist, int32_t cdef_count, BlockSize bsize, int32_t coeff_shift, int32_t pli, uint8_t subsampling_factor);
+    void svt_cdef_search_block_sums_c(const uint16_t *in, int32_t dir, int32_t bsize, uint8_t subsampling_factor, const int32_t *pri_strengths, int32_t num_pri, int32_t pri_damping, const int32_t *sec_strengths, int32_t num_sec, int32_t sec_damping, int32_t coeff_shift, int16_t *range, int16_t *pri_sums, int16_t *sec_sums);
+    RTCD_EXTERN void(*svt_cdef_search_block_sums)(const uint16_t *in, int32_t dir, int32_t bsize, uint8_t subsampling_factor, const int32_t *pri_strengths, int32_t num_pri, int32_t pri_damping, const int32_t *sec_strengths, int32_t num_sec, int32_t sec_damping, int32_t coeff_shift, int16_t *range, int16_t *pri_sums, int16_t *sec_sums);
+    void svt_cdef_search_block_combine_c(const int16_t *range, const int16_t *pri_sum, const int16_t *sec_sum, int32_t bsize, uint8_t subsampling_factor, uint8_t *dst8, uint16_t *dst16);
+    RTCD_EXTERN void(*svt_cdef_search_block_combine)(const int16_t *range, const int16_t *pri_sum, const int16_t *sec_sum, int32_t bsize, uint8_t subsampling_factor, uint8_t *dst8, uint16_t *dst16);
     void svt_av1_compute_stats_c(int32_t wiener_win, const uint8_t *dgd8, const uint8_t *src8, int32_t h_start, int32_t h_end, int32_t v_start, int32_t v_end, int32_t dgd_stride, int32_t src_stride, int64_t *M, int64_t *H);
     RTCD_EXTERN void(*svt_av1_compute_stats)(int32_t wiener_win, const uint8_t *dgd8, const uint8_t *src8, int32_t h_start, int32_t h_end, int32_t v_start, int32_t v_end, int32_t dgd_stride, int32_t src_stride, int64_t *M, int64_t *H);
     void svt_av1_compute_stats_highbd_c(int32_t wiener_win, const uint8_t *dgd8, const uint8_t *src8, int32_t h_start, int32_t h_end, int32_t v_start, int32_t v_end, int32_t dgd_stride, int32_t src_stride, int64_t *M, int64_t *H, AomBitDepth bit_depth);
@@ -773,8 +777,14 @@ extern "C" {
     RTCD_EXTERN void(*svt_av1_txb_init_levels)(const TranLow *const coeff, const int32_t width, const int32_t height, uint8_t *const levels);
     void svt_av1_get_gradient_hist_c(const uint8_t *src, int src_stride, int rows, int cols, uint64_t *hist);
     RTCD_EXTERN void(*svt_av1_get_gradient_hist)(const uint8_t *src, int src_stride, int rows, int cols, uint64_t *hist);
+    void svt_av1_block_2x2_hash_row_c(const uint8_t *src, int stride, int count, const CRC_CALCULATOR *crc_calculator1, const CRC_CALCULATOR *crc_calculator2, uint32_t *hash_value1, uint32_t *hash_value2);
+    RTCD_EXTERN void(*svt_av1_block_2x2_hash_row)(const uint8_t *src, int stride, int count, const CRC_CALCULATOR *crc_calculator1, const CRC_CALCULATOR *crc_calculator2, uint32_t *hash_value1, uint32_t *hash_value2);
+    void svt_av1_block_hash_row_c(const uint32_t *src_hash1, const uint32_t *src_hash2, int src_size, int pic_width, int count, const CRC_CALCULATOR *crc_calculator1, const CRC_CALCULATOR *crc_calculator2, uint32_t *dst_hash1, uint32_t *dst_hash2);
+    RTCD_EXTERN void(*svt_av1_block_hash_row)(const uint32_t *src_hash1, const uint32_t *src_hash2, int src_size, int pic_width, int count, const CRC_CALCULATOR *crc_calculator1, const CRC_CALCULATOR *crc_calculator2, uint32_t *dst_hash1, uint32_t *dst_hash2);
     double svt_av1_compute_cross_correlation_c(unsigned char *im1, int stride1, int x1, int y1, unsigned char *im2, int stride2, int x2, int y2);
     RTCD_EXTERN double(*svt_av1_compute_cross_correlation)(unsigned char *im1, int stride1, int x1, int y1, unsigned char *im2, int stride2, int x2, int y2);
+    int svt_av1_fast9_detect_row_c(const uint8_t *row, int stride, int x_start, int x_end, int b, int *corner_x);
+    RTCD_EXTERN int(*svt_av1_fast9_detect_row)(const uint8_t *row, int stride, int x_start, int x_end, int b, int *corner_x);
     void svt_av1_k_means_dim1_c(const int* data, int* centroids, uint8_t* indices, int n, int k, int max_itr);
     RTCD_EXTERN void(*svt_av1_k_means_dim1)(const int* data, int* centroids, uint8_t* indices, int n, int k, int max_itr);
     void svt_av1_k_means_dim2_c(const int* data, int* centroids, uint8_t* indices, int n, int k, int max_itr);
@@ -891,6 +901,8 @@ extern "C" {
     uint64_t compute_cdef_dist_16bit_avx2(const uint16_t *dst, int32_t dstride, const uint16_t *src, const CdefList *dlist, int32_t cdef_count, BlockSize bsize, int32_t coeff_shift, int32_t pli, uint8_t subsampling_factor);
     uint64_t compute_cdef_dist_8bit_sse4_1(const uint8_t *dst8, int32_t dstride, const uint8_t *src8, const CdefList *dlist, int32_t cdef_count, BlockSize bsize, int32_t coeff_shift, int32_t pli, uint8_t subsampling_factor);
     uint64_t compute_cdef_dist_8bit_avx2(const uint8_t *dst8, int32_t dstride, const uint8_t *src8, const CdefList *dlist, int32_t cdef_count, BlockSize bsize, int32_t coeff_shift, int32_t pli, uint8_t subsampling_factor);
+    void svt_cdef_search_block_sums_avx2(const uint16_t *in, int32_t dir, int32_t bsize, uint8_t subsampling_factor, const int32_t *pri_strengths, int32_t num_pri, int32_t pri_damping, const int32_t *sec_strengths, int32_t num_sec, int32_t sec_damping, int32_t coeff_shift, int16_t *range, int16_t *pri_sums, int16_t *sec_sums);
+    void svt_cdef_search_block_combine_avx2(const int16_t *range, const int16_t *pri_sum, const int16_t *sec_sum, int32_t bsize, uint8_t subsampling_factor, uint8_t *dst8, uint16_t *dst16);
     void svt_av1_compute_stats_sse4_1(int32_t wiener_win, const uint8_t *dgd8, const uint8_t *src8, int32_t h_start, int32_t h_end, int32_t v_start, int32_t v_end, int32_t dgd_stride, int32_t src_stride, int64_t *M, int64_t *H);
     void svt_av1_compute_stats_avx2(int32_t wiener_win, const uint8_t *dgd8, const uint8_t *src8, int32_t h_start, int32_t h_end, int32_t v_start, int32_t v_end, int32_t dgd_stride, int32_t src_stride, int64_t *M, int64_t *H);
     void svt_av1_compute_stats_avx512(int32_t wiener_win, const uint8_t *dgd8, const uint8_t *src8, int32_t h_start, int32_t h_end, int32_t v_start, int32_t v_end, int32_t dgd_stride, int32_t src_stride, int64_t *M, int64_t *H);
@@ -1527,9 +1539,12 @@ extern "C" {
     int svt_aom_satd_avx2(const TranLow *coeff, int length);
     int64_t svt_av1_block_error_avx2(const TranLow *coeff, const TranLow *dqcoeff, intptr_t block_size, int64_t *ssz);
     void svt_av1_get_gradient_hist_avx2(const uint8_t *src, int src_stride, int rows, int cols, uint64_t *hist);
+    void svt_av1_block_2x2_hash_row_avx2(const uint8_t *src, int stride, int count, const CRC_CALCULATOR *crc_calculator1, const CRC_CALCULATOR *crc_calculator2, uint32_t *hash_value1, uint32_t *hash_value2);
+    void svt_av1_block_hash_row_avx2(const uint32_t *src_hash1, const uint32_t *src_hash2, int src_size, int pic_width, int count, const CRC_CALCULATOR *crc_calculator1, const CRC_CALCULATOR *crc_calculator2, uint32_t *dst_hash1, uint32_t *dst_hash2);
 
     double svt_av1_compute_cross_correlation_sse4_1(unsigned char *im1, int stride1, int x1, int y1, unsigned char *im2, int stride2, int x2, int y2);
     double svt_av1_compute_cross_correlation_avx2(unsigned char *im1, int stride1, int x1, int y1, unsigned char *im2, int stride2, int x2, int y2);
+    int svt_av1_fast9_detect_row_avx2(const uint8_t *row, int stride, int x_start, int x_end, int b, int *corner_x);
 
     void svt_av1_k_means_dim1_avx2(const int* data, int* centroids, uint8_t* indices, int n, int k, int max_itr);
 
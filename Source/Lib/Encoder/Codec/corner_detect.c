@@ -13,14 +13,103 @@
 #include "fast.h"
 
 #include "corner_detect.h"
+#include "aom_dsp_rtcd.h"
+
+// true when 9 contiguous bits of the 16 bit circular mask are set
+static INLINE int has_arc9(uint32_t mask) {
+    uint32_t arc = mask | (mask << 16);
+    uint32_t run = arc & (arc >> 1);
+    run &= run >> 2;
+    run &= run >> 4;
+    run &= arc >> 8;
+    return (run & 0xffff) != 0;
+}
+
+void svt_av1_fast9_circle_offsets(int offsets[16], int stride) {
+    static const int8_t circle_x[16] = {0, 1, 2, 3, 3, 3, 2, 1, 0, -1, -2, -3, -3, -3, -2, -1};
+    static const int8_t circle_y[16] = {3, 3, 2, 1, 0, -1, -2, -3, -3, -3, -2, -1, 0, 1, 2, 3};
+    for (int i = 0; i < 16; i++) offsets[i] = circle_x[i] + circle_y[i] * stride;
+}
+
+int svt_av1_fast9_detect_row_c(const uint8_t *row, int stride, int x_start, int x_end, int b,
+                               int *corner_x) {
+    int offsets[16];
+    int count = 0;
+    svt_av1_fast9_circle_offsets(offsets, stride);
+    for (int x = x_start; x < x_end; x++) {
+        const uint8_t *p   = row + x;
+        const int      cb  = *p + b;
+        const int      c_b = *p - b;
+        // any 9 contiguous pixels of the circle hold one of the pixels 0 and 8
+        // and one of the pixels 4 and 12
+        const int bright = (p[offsets[0]] > cb || p[offsets[8]] > cb) &&
+            (p[offsets[4]] > cb || p[offsets[12]] > cb);
+        const int dark = (p[offsets[0]] < c_b || p[offsets[8]] < c_b) &&
+            (p[offsets[4]] < c_b || p[offsets[12]] < c_b);
+        if (!bright && !dark)
+            continue;
+        uint32_t bright_mask = 0, dark_mask = 0;
+        for (int i = 0; i < 16; i++) {
+            bright_mask |= (uint32_t)(p[offsets[i]] > cb) << i;
+            dark_mask |= (uint32_t)(p[offsets[i]] < c_b) << i;
+        }
+        if (has_arc9(bright_mask) || has_arc9(dark_mask))
+            corner_x[count++] = x;
+    }
+    return count;
+}
+
+// FAST-9 segment test of the picture, the corners in raster scan order
+static xy *fast9_detect(const uint8_t *buf, int width, int height, int stride, int b,
+                        int *num_corners) {
+    int  size     = 512;
+    int  count    = 0;
+    xy  *corners  = (xy *)malloc(sizeof(*corners) * size);
+    int *corner_x = (int *)malloc(sizeof(*corner_x) * (width > 0 ? width : 1));
+    if (!corners || !corner_x) {
+        free(corners);
+        free(corner_x);
+        return NULL;
+    }
+    for (int y = 3; y < height - 3; y++) {
+        const int row_count = svt_av1_fast9_detect_row(
+            buf + y * stride, stride, 3, width - 3, b, corner_x);
+        if (count + row_count > size) {
+            while (count + row_count > size) size *= 2;
+            xy *temp = (xy *)realloc(corners, sizeof(*temp) * size);
+            if (!temp) {
+                free(corners);
+                free(corner_x);
+                return NULL;
+            }
+            corners = temp;
+        }
+        for (int i = 0; i < row_count; i++) {
+            corners[count].x = corner_x[i];
+            corners[count].y = y;
+            count++;
+        }
+    }
+    free(corner_x);
+    *num_corners = count;
+    return corners;
+}
 
 // Fast_9 wrapper
 #define FAST_BARRIER 18
 int svt_av1_fast_corner_detect(unsigned char *buf, int width, int height, int stride, int *points,
                                int max_points) {
-    int       num_points;
-    xy *const frm_corners_xy = svt_aom_fast9_detect_nonmax(
-        buf, width, height, stride, FAST_BARRIER, &num_points);
+    int       num_corners = 0;
+    int       num_points  = 0;
+    xy *const corners     = fast9_detect(buf, width, height, stride, FAST_BARRIER, &num_corners);
+    if (!corners)
+        return 0;
+    int *const scores         = svt_aom_fast9_score(buf, stride, corners, num_corners, FAST_BARRIER);
+    xy *const  frm_corners_xy = scores
+         ? svt_aom_nonmax_suppression(corners, scores, num_corners, &num_points)
+         : NULL;
+    free(corners);
+    free(scores);
     num_points = (num_points <= max_points ? num_points : max_points);
     if (num_points > 0 && frm_corners_xy) {
         svt_memcpy(points, frm_corners_xy, sizeof(*frm_corners_xy) * num_points);
@@ -18,5 +18,8 @@
 #include "common_dsp_rtcd.h"
 int svt_av1_fast_corner_detect(unsigned char *buf, int width, int height, int stride, int *points,
                                int max_points);
+// offsets of the 16 pixels of the circle of the FAST-9 segment test, in the
+// order of the fastfeat detector
+void svt_av1_fast9_circle_offsets(int offsets[16], int stride);
 
 #endif // AOM_AV1_ENCODER_CORNER_DETECT_H_
@@ -49,34 +49,19 @@
 #define STATS_CAPABILITY_INIT 100
 //1.5 times larger than request.
 #define STATS_CAPABILITY_GROW(s) (s * 3 / 2)
-static EbErrorType realloc_stats_out(SequenceControlSet *scs_ptr, FirstPassStatsOut *out,
-                                     uint64_t frame_number) {
+static EbErrorType realloc_stats_out(FirstPassStatsOut *out, uint64_t frame_number) {
     if (frame_number < out->size)
         return EB_ErrorNone;
 
-    if ((int64_t)frame_number >= (int64_t)out->capability - 1) {
-        size_t capability = (int64_t)frame_number >= (int64_t)STATS_CAPABILITY_INIT - 1
-            ? STATS_CAPABILITY_GROW(frame_number)
+    // the frames before out->first were handed out
+    const uint64_t index = frame_number - out->first;
+    if ((int64_t)index >= (int64_t)out->capability - 1) {
+        size_t capability = (int64_t)index >= (int64_t)STATS_CAPABILITY_INIT - 1
+            ? STATS_CAPABILITY_GROW(index)
             : STATS_CAPABILITY_INIT;
-        if (scs_ptr->lap_rc) {
-            //store the data points before re-allocation
-            uint64_t stats_in_start_offset = 0;
-            uint64_t stats_in_offset       = 0;
-            uint64_t stats_in_end_offset   = 0;
-            if (frame_number) {
-                stats_in_start_offset = scs_ptr->twopass.stats_buf_ctx->stats_in_start - out->stat;
-                stats_in_offset       = scs_ptr->twopass.stats_in - out->stat;
-                stats_in_end_offset   = scs_ptr->twopass.stats_buf_ctx->stats_in_end_write -
-                    out->stat;
-            }
-            EB_REALLOC_ARRAY(out->stat, capability);
-            // restore the pointers after re-allocation is done
-            scs_ptr->twopass.stats_buf_ctx->stats_in_start     = out->stat + stats_in_start_offset;
-            scs_ptr->twopass.stats_in                          = out->stat + stats_in_offset;
-            scs_ptr->twopass.stats_buf_ctx->stats_in_end_write = out->stat + stats_in_end_offset;
-        } else {
-            EB_REALLOC_ARRAY(out->stat, capability);
-        }
+        EB_REALLOC_ARRAY(out->stat, capability);
+        if (out->stat == NULL)
+            return EB_ErrorInsufficientResources;
         out->capability = capability;
     }
     out->size = frame_number + 1;
@@ -87,10 +72,10 @@ static AOM_INLINE void output_stats(SequenceControlSet *scs_ptr, const FIRSTPASS
                                     uint64_t frame_number) {
     FirstPassStatsOut *stats_out = &scs_ptr->encode_context_ptr->stats_out;
     svt_block_on_mutex(scs_ptr->encode_context_ptr->stat_file_mutex);
-    if (realloc_stats_out(scs_ptr, stats_out, frame_number) != EB_ErrorNone) {
+    if (realloc_stats_out(stats_out, frame_number) != EB_ErrorNone) {
         SVT_ERROR("realloc_stats_out request %d entries failed failed\n", frame_number);
     } else {
-        stats_out->stat[frame_number] = *stats;
+        stats_out->stat[frame_number - stats_out->first] = *stats;
     }
 
     // TEMP debug code
@@ -181,6 +166,82 @@ void svt_av1_end_first_pass(PictureParentControlSet *pcs_ptr) {
         output_stats(scs_ptr, &total_stats, pcs_ptr->picture_number + 1);
     }
 }
+EbErrorType svt_av1_alloc_lap_stats(STATS_BUFFER_CTX *ctx, uint64_t frames_in_flight) {
+    // the margin before the frame of the rate control, and as much for the frames between the
+    // pictures in flight
+    ctx->lap_stats_size  = frames_in_flight + 2 * LAP_STATS_MARGIN;
+    ctx->lap_stats_count = 0;
+    EB_MALLOC_ARRAY(ctx->lap_stats, 2 * ctx->lap_stats_size);
+    return EB_ErrorNone;
+}
+FIRSTPASS_STATS *svt_av1_lap_stats(const STATS_BUFFER_CTX *ctx, uint64_t frame) {
+    uint64_t slot = frame % ctx->lap_stats_size;
+    if (slot < LAP_STATS_MARGIN)
+        slot += ctx->lap_stats_size;
+    return ctx->lap_stats + slot;
+}
+void svt_av1_push_lap_stats(STATS_BUFFER_CTX *ctx, const FIRSTPASS_STATS *stats) {
+    const uint64_t slot = ctx->lap_stats_count % ctx->lap_stats_size;
+    ctx->lap_stats[slot]                       = *stats;
+    ctx->lap_stats[slot + ctx->lap_stats_size] = *stats;
+    ctx->lap_stats_count++;
+}
+static void write_lap_stats(SequenceControlSet *scs_ptr, const FIRSTPASS_STATS *stats) {
+    svt_block_on_mutex(scs_ptr->encode_context_ptr->stat_file_mutex);
+    svt_av1_push_lap_stats(scs_ptr->twopass.stats_buf_ctx, stats);
+    svt_release_mutex(scs_ptr->encode_context_ptr->stat_file_mutex);
+}
+// Returns 1 when the stats repeat the measurements of the previous frame, as written by a first
+// pass skipping frames
+static int is_repeated_first_pass_stats(const FIRSTPASS_STATS *stats,
+                                        const FIRSTPASS_STATS *prev) {
+    return prev->frame + 1 == stats->frame && stats->intra_error == prev->intra_error &&
+        stats->coded_error == prev->coded_error && stats->sr_coded_error == prev->sr_coded_error &&
+        stats->pcnt_inter == prev->pcnt_inter && stats->pcnt_motion == prev->pcnt_motion &&
+        stats->mvr_abs == prev->mvr_abs && stats->mvc_abs == prev->mvc_abs &&
+        stats->mv_in_out_count == prev->mv_in_out_count;
+}
+int svt_av1_read_streamed_first_pass_stats(PictureParentControlSet *pcs_ptr) {
+    SequenceControlSet *scs_ptr = pcs_ptr->scs_ptr;
+    FirstPassStatsIn   *in      = &scs_ptr->encode_context_ptr->stats_stream;
+    FIRSTPASS_STATS     fps;
+
+    svt_block_on_mutex(in->mutex);
+    // drop the stats of the pictures before, their stats were computed
+    while (in->count && in->stat[in->head].frame < (double)pcs_ptr->picture_number) {
+        in->head = (in->head + 1) % in->capability;
+        in->count--;
+    }
+    if (in->count == 0 || in->stat[in->head].frame != (double)pcs_ptr->picture_number) {
+        if (!in->warned)
+            SVT_WARN("No first pass stats sent for picture %llu, computing them\n",
+                     (unsigned long long)pcs_ptr->picture_number);
+        in->warned = TRUE;
+        svt_release_mutex(in->mutex);
+        return 0;
+    }
+    fps      = in->stat[in->head];
+    in->head = (in->head + 1) % in->capability;
+    in->count--;
+    // A first pass skipping frames copies the stats of the last frame it analysed, which would
+    // make the rate control see the motion of a group of frames as a single step. The stats of
+    // those pictures are computed by the look ahead instead.
+    const int repeated = is_repeated_first_pass_stats(&fps, &in->last);
+    in->last           = fps;
+    if (repeated && !in->warned_repeated) {
+        SVT_WARN("First pass stats repeated from picture %llu, computing them, the first pass "
+                 "writes the stats of every picture with rc_stats_stream\n",
+                 (unsigned long long)pcs_ptr->picture_number - 1);
+        in->warned_repeated = TRUE;
+    }
+    svt_release_mutex(in->mutex);
+    if (repeated)
+        return 0;
+
+    memset(&fps.stat_struct, 0, sizeof(StatStruct));
+    write_lap_stats(scs_ptr, &fps);
+    return 1;
+}
 #define UL_INTRA_THRESH 50
 #define INVALID_ROW -1
 // Accumulates motion vector stats.
@@ -261,8 +322,14 @@ static void update_firstpass_stats(PictureParentControlSet *pcs_ptr, const FRAME
     //    : mi_params->MBs;
     const double min_err = 200 * sqrt(num_mbs);
     if (skip_frame) {
-        FirstPassStatsOut *stats_out = &scs_ptr->encode_context_ptr->stats_out;
-        fps       = stats_out->stat[frame_number - 1];
+        if (scs_ptr->lap_rc)
+            fps = *svt_av1_lap_stats(twopass->stats_buf_ctx, frame_number - 1);
+        else {
+            FirstPassStatsOut *stats_out = &scs_ptr->encode_context_ptr->stats_out;
+            svt_block_on_mutex(scs_ptr->encode_context_ptr->stat_file_mutex);
+            fps = stats_out->stat[frame_number - 1 - stats_out->first];
+            svt_release_mutex(scs_ptr->encode_context_ptr->stat_file_mutex);
+        }
         fps.frame = frame_number;
     } else {
         fps.weight = stats->intra_factor * stats->brightness_factor;
@@ -295,6 +362,11 @@ static void update_firstpass_stats(PictureParentControlSet *pcs_ptr, const FRAME
         fps.duration = (double)ts_duration;
     }
     memset(&fps.stat_struct, 0, sizeof(StatStruct));
+    // The look ahead keeps the stats of the frames in flight only
+    if (scs_ptr->lap_rc) {
+        write_lap_stats(scs_ptr, &fps);
+        return;
+    }
     // We will store the stats inside the persistent twopass struct (and NOT the
     // local variable 'fps'), and then cpi->output_pkt_list will point to it.
     *this_frame_stats = fps;
@@ -303,8 +375,7 @@ static void update_firstpass_stats(PictureParentControlSet *pcs_ptr, const FRAME
         scs_ptr->static_config.pass == ENC_FIRST_PASS) {
         svt_av1_accumulate_stats(twopass->stats_buf_ctx->total_stats, &fps);
     }
-    /*In the case of two pass, first pass uses it as a circular buffer,
-   * when LAP is enabled it is used as a linear buffer*/
+    /*In the case of two pass, first pass uses it as a circular buffer*/
     twopass->stats_buf_ctx->stats_in_end_write++;
     if (scs_ptr->static_config.pass == ENC_FIRST_PASS &&
         (twopass->stats_buf_ctx->stats_in_end_write >= twopass->stats_buf_ctx->stats_in_buf_end)) {
@@ -42,6 +42,9 @@ extern "C" {
 // The maximum duration of a GF group that is static (e.g. a slide show).
 #define MAX_STATIC_GF_GROUP_LENGTH 250
 #define MAX_LAP_BUFFERS 35
+// Frames of the look ahead stats ring kept before the current frame of the rate control, the
+// backward reads of the rate control stop at the previous GF group
+#define LAP_STATS_MARGIN 128
 
 /*!
  * \brief The stucture of acummulated frame stats in the first pass.
@@ -163,6 +166,11 @@ typedef struct {
     FIRSTPASS_STATS *total_stats;
     FIRSTPASS_STATS *total_left_stats;
     int64_t          last_frame_accumulated;
+    // Stats of the look ahead rate control (lap_rc). Frame f is stored at f % lap_stats_size and
+    // at f % lap_stats_size + lap_stats_size so that the window of the rate control is contiguous.
+    FIRSTPASS_STATS *lap_stats;
+    uint64_t         lap_stats_size;
+    uint64_t         lap_stats_count; // frames written
 } STATS_BUFFER_CTX;
 
 /*!\endcond */
@@ -250,9 +258,20 @@ typedef struct {
 } FirstPassData;
 struct AV1EncoderConfig;
 struct TileDataEnc;
+struct PictureParentControlSet;
 
 void svt_av1_twopass_zero_stats(FIRSTPASS_STATS *section);
 void svt_av1_accumulate_stats(FIRSTPASS_STATS *section, const FIRSTPASS_STATS *frame);
+// Allocates the look ahead stats ring for frames_in_flight frames between the rate control and
+// the first pass.
+EbErrorType svt_av1_alloc_lap_stats(STATS_BUFFER_CTX *ctx, uint64_t frames_in_flight);
+// Stores the stats of the next frame in the look ahead ring
+void svt_av1_push_lap_stats(STATS_BUFFER_CTX *ctx, const FIRSTPASS_STATS *stats);
+// Stats of frame in the look ahead ring, the LAP_STATS_MARGIN previous frames are stored before
+FIRSTPASS_STATS *svt_av1_lap_stats(const STATS_BUFFER_CTX *ctx, uint64_t frame);
+// Stores the next streamed first pass stats as the stats of the picture, returns 0 when no
+// stats have been sent for it.
+int svt_av1_read_streamed_first_pass_stats(struct PictureParentControlSet *pcs_ptr);
 /*!\endcond */
 
 #ifdef __cplusplus
@@ -82,10 +82,14 @@ int64_t svt_av1_refine_integerized_param(EbWarpedMotionParams *wm, Transformatio
   "num_inliers" should be length "num_motions", and will be populated with the
   number of inlier feature points for each motion. Params for which the
   num_inliers entry is 0 should be ignored by the caller.
+
+  The motions are fitted to the "num_correspondences" point pairs of
+  "correspondences", as found by svt_av1_determine_correspondence() between
+  the corners of the two frames, so that they are matched once for all the
+  transformation types.
 */
-int svt_av1_compute_global_motion(TransformationType type, unsigned char *frm_buffer, int frm_width,
-                                  int frm_height, int frm_stride, int *frm_corners,
-                                  int num_frm_corners, uint8_t *ref, int ref_stride, int bit_depth,
+int svt_av1_compute_global_motion(TransformationType type, int *correspondences,
+                                  int num_correspondences,
                                   GlobalMotionEstimationType gm_estimation_type,
                                   int *num_inliers_by_motion, MotionModel *params_by_motion,
                                   int num_motions);
@@ -46,6 +46,20 @@ static void crc_calculator_init_table(CRC_CALCULATOR *p_crc_calculator) {
     }
 }
 
+static void crc_calculator_init_slice_table(CRC_CALCULATOR *p_crc_calculator) {
+    const uint32_t mask = p_crc_calculator->final_result_mask;
+    for (uint32_t value = 0; value < 256; value++) {
+        uint32_t remainder = p_crc_calculator->table[value];
+        p_crc_calculator->slice_table[0][value] = remainder & mask;
+        // append one zero byte per table
+        for (int k = 1; k < CRC_SLICE_MAX_LENGTH; k++) {
+            const uint8_t index = (uint8_t)(remainder >> (p_crc_calculator->bits - 8));
+            remainder = (remainder << 8) ^ p_crc_calculator->table[index];
+            p_crc_calculator->slice_table[k][value] = remainder & mask;
+        }
+    }
+}
+
 void svt_av1_crc_calculator_init(CRC_CALCULATOR *p_crc_calculator, uint32_t bits,
                                  uint32_t truncPoly) {
     p_crc_calculator->remainder         = 0;
@@ -53,6 +67,7 @@ void svt_av1_crc_calculator_init(CRC_CALCULATOR *p_crc_calculator, uint32_t bits
     p_crc_calculator->trunc_poly        = truncPoly;
     p_crc_calculator->final_result_mask = (1 << bits) - 1;
     crc_calculator_init_table(p_crc_calculator);
+    crc_calculator_init_slice_table(p_crc_calculator);
 }
 
 uint32_t svt_av1_get_crc_value(void *crc_calculator, uint8_t *p, int length) {
@@ -61,3 +76,34 @@ uint32_t svt_av1_get_crc_value(void *crc_calculator, uint8_t *p, int length) {
     crc_calculator_process_data(p_crc_calculator, p, length);
     return crc_calculator_get_crc(p_crc_calculator);
 }
+
+void svt_av1_block_2x2_hash_row_c(const uint8_t *src, int stride, int count,
+                                  const CRC_CALCULATOR *crc_calculator1,
+                                  const CRC_CALCULATOR *crc_calculator2, uint32_t *hash_value1,
+                                  uint32_t *hash_value2) {
+    for (int x = 0; x < count; x++) {
+        const uint8_t p[4] = {src[x], src[x + 1], src[x + stride], src[x + stride + 1]};
+        hash_value1[x]     = svt_av1_get_crc_value_sliced(crc_calculator1, p, sizeof(p));
+        hash_value2[x]     = svt_av1_get_crc_value_sliced(crc_calculator2, p, sizeof(p));
+    }
+}
+
+void svt_av1_block_hash_row_c(const uint32_t *src_hash1, const uint32_t *src_hash2, int src_size,
+                              int pic_width, int count, const CRC_CALCULATOR *crc_calculator1,
+                              const CRC_CALCULATOR *crc_calculator2, uint32_t *dst_hash1,
+                              uint32_t *dst_hash2) {
+    const int bottom = src_size * pic_width;
+    for (int x = 0; x < count; x++) {
+        uint32_t p[4];
+        p[0]         = src_hash1[x];
+        p[1]         = src_hash1[x + src_size];
+        p[2]         = src_hash1[x + bottom];
+        p[3]         = src_hash1[x + bottom + src_size];
+        dst_hash1[x] = svt_av1_get_crc_value_sliced(crc_calculator1, (uint8_t *)p, sizeof(p));
+        p[0]         = src_hash2[x];
+        p[1]         = src_hash2[x + src_size];
+        p[2]         = src_hash2[x + bottom];
+        p[3]         = src_hash2[x + bottom + src_size];
+        dst_hash2[x] = svt_av1_get_crc_value_sliced(crc_calculator2, (uint8_t *)p, sizeof(p));
+    }
+}
@@ -18,12 +18,18 @@
 extern "C" {
 #endif
 
+#define CRC_SLICE_MAX_LENGTH 16
+
 typedef struct _crc_calculator {
     uint32_t remainder;
     uint32_t trunc_poly;
     uint32_t bits;
     uint32_t table[256];
     uint32_t final_result_mask;
+    // slice_table[k][b]: crc of the byte b followed by k zero bytes. The crc
+    // being linear, the crc of a message is the xor of the entries of its
+    // bytes, which removes the dependency between the bytes of the message.
+    uint32_t slice_table[CRC_SLICE_MAX_LENGTH][256];
 } CRC_CALCULATOR;
 
 // Initialize the crc calculator. It must be executed at least once before
@@ -31,6 +37,17 @@ typedef struct _crc_calculator {
 void     svt_av1_crc_calculator_init(CRC_CALCULATOR *p_crc_calculator, uint32_t bits,
                                      uint32_t truncPoly);
 uint32_t svt_av1_get_crc_value(void *crc_calculator, uint8_t *p, int length);
+
+// Same value as svt_av1_get_crc_value() for messages of up to
+// CRC_SLICE_MAX_LENGTH bytes, without changing the calculator, so that it
+// can be shared between threads.
+static INLINE uint32_t svt_av1_get_crc_value_sliced(const CRC_CALCULATOR *p_crc_calculator,
+                                                    const uint8_t *p, int length) {
+    uint32_t crc = 0;
+    assert(length <= CRC_SLICE_MAX_LENGTH);
+    for (int i = 0; i < length; i++) crc ^= p_crc_calculator->slice_table[length - 1 - i][p[i]];
+    return crc;
+}
 #define AOM_BUFFER_SIZE_FOR_BLOCK_HASH (4096)
 
 #ifdef __cplusplus
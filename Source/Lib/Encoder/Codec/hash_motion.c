@@ -12,6 +12,7 @@
 #include "hash.h"
 #include "hash_motion.h"
 #include "EbPictureControlSet.h"
+#include "aom_dsp_rtcd.h"
 
 void             svt_aom_free(void *memblk);
 static const int crc_bits        = 16;
@@ -137,7 +138,9 @@ Iterator svt_av1_hash_get_first_iterator(HashTable *p_hash_table, uint32_t hash_
 
 void svt_av1_generate_block_2x2_hash_value(const Yv12BufferConfig *picture,
                                            uint32_t               *pic_block_hash[2],
-                                           int8_t *pic_block_same_info[3], PictureControlSet *pcs) {
+                                           int8_t                 *pic_block_same_info[3],
+                                           const CRC_CALCULATOR   *crc_calculator1,
+                                           const CRC_CALCULATOR   *crc_calculator2) {
     const int width  = 2;
     const int height = 2;
     const int x_end  = picture->y_crop_width - width + 1;
@@ -156,10 +159,10 @@ void svt_av1_generate_block_2x2_hash_value(const Yv12BufferConfig *picture,
                 pic_block_same_info[0][pos] = is_block16_2x2_row_same_value(p);
                 pic_block_same_info[1][pos] = is_block16_2x2_col_same_value(p);
 
-                pic_block_hash[0][pos] = svt_av1_get_crc_value(
-                    &pcs->crc_calculator1, (uint8_t *)p, length * sizeof(p[0]));
-                pic_block_hash[1][pos] = svt_av1_get_crc_value(
-                    &pcs->crc_calculator2, (uint8_t *)p, length * sizeof(p[0]));
+                pic_block_hash[0][pos] = svt_av1_get_crc_value_sliced(
+                    crc_calculator1, (uint8_t *)p, length * sizeof(p[0]));
+                pic_block_hash[1][pos] = svt_av1_get_crc_value_sliced(
+                    crc_calculator2, (uint8_t *)p, length * sizeof(p[0]));
                 pos++;
             }
             pos += width - 1;
@@ -168,16 +171,18 @@ void svt_av1_generate_block_2x2_hash_value(const Yv12BufferConfig *picture,
         uint8_t p[4];
         int     pos = 0;
         for (int y_pos = 0; y_pos < y_end; y_pos++) {
+            uint8_t *src = picture->y_buffer + y_pos * picture->y_stride;
+            svt_av1_block_2x2_hash_row(src,
+                                       picture->y_stride,
+                                       x_end,
+                                       crc_calculator1,
+                                       crc_calculator2,
+                                       pic_block_hash[0] + pos,
+                                       pic_block_hash[1] + pos);
             for (int x_pos = 0; x_pos < x_end; x_pos++) {
-                get_pixels_in_1d_char_array_by_block_2x2(
-                    picture->y_buffer + y_pos * picture->y_stride + x_pos, picture->y_stride, p);
+                get_pixels_in_1d_char_array_by_block_2x2(src + x_pos, picture->y_stride, p);
                 pic_block_same_info[0][pos] = is_block_2x2_row_same_value(p);
                 pic_block_same_info[1][pos] = is_block_2x2_col_same_value(p);
-
-                pic_block_hash[0][pos] = svt_av1_get_crc_value(
-                    &pcs->crc_calculator1, p, length * sizeof(p[0]));
-                pic_block_hash[1][pos] = svt_av1_get_crc_value(
-                    &pcs->crc_calculator2, p, length * sizeof(p[0]));
                 pos++;
             }
             pos += width - 1;
@@ -186,10 +191,12 @@ void svt_av1_generate_block_2x2_hash_value(const Yv12BufferConfig *picture,
 }
 
 void svt_av1_generate_block_hash_value(const Yv12BufferConfig *picture, int block_size,
-                                       uint32_t *src_pic_block_hash[2],
-                                       uint32_t *dst_pic_block_hash[2],
-                                       int8_t   *src_pic_block_same_info[3],
-                                       int8_t *dst_pic_block_same_info[3], PictureControlSet *pcs) {
+                                       uint32_t             *src_pic_block_hash[2],
+                                       uint32_t             *dst_pic_block_hash[2],
+                                       int8_t               *src_pic_block_same_info[3],
+                                       int8_t               *dst_pic_block_same_info[3],
+                                       const CRC_CALCULATOR *crc_calculator1,
+                                       const CRC_CALCULATOR *crc_calculator2) {
     const int pic_width = picture->y_crop_width;
     const int x_end     = picture->y_crop_width - block_size + 1;
     const int y_end     = picture->y_crop_height - block_size + 1;
@@ -197,26 +204,18 @@ void svt_av1_generate_block_hash_value(const Yv12BufferConfig *picture, int bloc
     const int src_size  = block_size >> 1;
     const int quad_size = block_size >> 2;
 
-    uint32_t  p[4];
-    const int length = sizeof(p);
-
     int pos = 0;
     for (int y_pos = 0; y_pos < y_end; y_pos++) {
+        svt_av1_block_hash_row(src_pic_block_hash[0] + pos,
+                               src_pic_block_hash[1] + pos,
+                               src_size,
+                               pic_width,
+                               x_end,
+                               crc_calculator1,
+                               crc_calculator2,
+                               dst_pic_block_hash[0] + pos,
+                               dst_pic_block_hash[1] + pos);
         for (int x_pos = 0; x_pos < x_end; x_pos++) {
-            p[0] = src_pic_block_hash[0][pos];
-            p[1] = src_pic_block_hash[0][pos + src_size];
-            p[2] = src_pic_block_hash[0][pos + src_size * pic_width];
-            p[3] = src_pic_block_hash[0][pos + src_size * pic_width + src_size];
-            dst_pic_block_hash[0][pos] = svt_av1_get_crc_value(
-                &pcs->crc_calculator1, (uint8_t *)p, length);
-
-            p[0] = src_pic_block_hash[1][pos];
-            p[1] = src_pic_block_hash[1][pos + src_size];
-            p[2] = src_pic_block_hash[1][pos + src_size * pic_width];
-            p[3] = src_pic_block_hash[1][pos + src_size * pic_width + src_size];
-            dst_pic_block_hash[1][pos] = svt_av1_get_crc_value(
-                &pcs->crc_calculator2, (uint8_t *)p, length);
-
             dst_pic_block_same_info[0][pos] = src_pic_block_same_info[0][pos] &&
                 src_pic_block_same_info[0][pos + quad_size] &&
                 src_pic_block_same_info[0][pos + src_size] &&
@@ -283,6 +282,125 @@ void rtime_alloc_svt_av1_add_to_hash_map_by_row_with_precal_data(HashTable *p_ha
     }
 }
 
+/**************************************
+ * svt_av1_build_hash_table
+ *   Adds the luma blocks of picture of size min_block_size to max_block_size
+ *   to p_hash_table. Blocks of a single color are only added at block
+ *   aligned positions.
+ **************************************/
+EbErrorType svt_av1_build_hash_table(HashTable *p_hash_table, const Yv12BufferConfig *picture,
+                                     int min_block_size, int max_block_size,
+                                     const CRC_CALCULATOR *crc_calculator1,
+                                     const CRC_CALCULATOR *crc_calculator2) {
+    const int   pic_width  = picture->y_crop_width;
+    const int   pic_height = picture->y_crop_height;
+    const size_t area      = (size_t)pic_width * pic_height;
+    EbErrorType err_code   = EB_ErrorNone;
+
+    uint32_t *block_hash_values[2][2] = {{NULL, NULL}, {NULL, NULL}};
+    int8_t   *is_block_same[2][3]     = {{NULL, NULL, NULL}, {NULL, NULL, NULL}};
+    for (int k = 0; k < 2; k++) {
+        for (int j = 0; j < 2; j++) {
+            block_hash_values[k][j] = malloc(sizeof(uint32_t) * area);
+            if (!block_hash_values[k][j])
+                err_code = EB_ErrorInsufficientResources;
+        }
+        for (int j = 0; j < 3; j++) {
+            is_block_same[k][j] = malloc(sizeof(int8_t) * area);
+            if (!is_block_same[k][j])
+                err_code = EB_ErrorInsufficientResources;
+        }
+    }
+
+    if (err_code == EB_ErrorNone) {
+        svt_av1_generate_block_2x2_hash_value(
+            picture, block_hash_values[0], is_block_same[0], crc_calculator1, crc_calculator2);
+        uint8_t src_idx = 0;
+        for (int size = 4; size <= max_block_size; size <<= 1, src_idx = !src_idx) {
+            const uint8_t dst_idx = !src_idx;
+            svt_av1_generate_block_hash_value(picture,
+                                              size,
+                                              block_hash_values[src_idx],
+                                              block_hash_values[dst_idx],
+                                              is_block_same[src_idx],
+                                              is_block_same[dst_idx],
+                                              crc_calculator1,
+                                              crc_calculator2);
+            if (size >= min_block_size)
+                rtime_alloc_svt_av1_add_to_hash_map_by_row_with_precal_data(
+                    p_hash_table,
+                    block_hash_values[dst_idx],
+                    is_block_same[dst_idx][2],
+                    pic_width,
+                    pic_height,
+                    size);
+        }
+    }
+
+    for (int k = 0; k < 2; k++) {
+        for (int j = 0; j < 2; j++) free(block_hash_values[k][j]);
+        for (int j = 0; j < 3; j++) free(is_block_same[k][j]);
+    }
+    return err_code;
+}
+
+/**************************************
+ * svt_av1_get_b64_hash_values
+ *   Hashes the aligned square luma blocks of a 64x64 area the same way
+ *   svt_av1_build_hash_table does, so that they can be looked up in a
+ *   picture table. The blocks are stored by size, 64x64 first, then the
+ *   32x32, 16x16 and 8x8 blocks each in raster order (HASH_B64_*_OFFSET).
+ **************************************/
+void svt_av1_get_b64_hash_values(const uint8_t *src, int stride,
+                                 const CRC_CALCULATOR *crc_calculator1,
+                                 const CRC_CALCULATOR *crc_calculator2,
+                                 uint32_t              hash_value1[HASH_B64_BLOCK_COUNT],
+                                 uint32_t              hash_value2[HASH_B64_BLOCK_COUNT]) {
+    // level hashes, each stored with a row length of 32 entries
+    uint32_t  hash[2][2][32 * 32];
+    uint8_t   pixel_to_hash[4];
+    uint32_t  to_hash[4];
+    const int crc_mask = (1 << crc_bits) - 1;
+
+    for (int y = 0; y < 32; y++) {
+        for (int x = 0; x < 32; x++) {
+            get_pixels_in_1d_char_array_by_block_2x2(
+                (uint8_t *)src + 2 * y * stride + 2 * x, stride, pixel_to_hash);
+            hash[0][0][y * 32 + x] = svt_av1_get_crc_value_sliced(
+                crc_calculator1, pixel_to_hash, sizeof(pixel_to_hash));
+            hash[1][0][y * 32 + x] = svt_av1_get_crc_value_sliced(
+                crc_calculator2, pixel_to_hash, sizeof(pixel_to_hash));
+        }
+    }
+
+    static const int out_offset[] = {
+        -1, HASH_B64_8X8_OFFSET, HASH_B64_16X16_OFFSET, HASH_B64_32X32_OFFSET, HASH_B64_64X64_OFFSET};
+    int src_idx = 0;
+    for (int size = 4, count = 16; size <= 64; size <<= 1, count >>= 1, src_idx = !src_idx) {
+        const int dst_idx   = !src_idx;
+        const int level     = hash_block_size_to_index(size);
+        const int add_value = level << crc_bits;
+        for (int y = 0; y < count; y++) {
+            for (int x = 0; x < count; x++) {
+                const int src_pos = 2 * y * 32 + 2 * x;
+                for (int c = 0; c < 2; c++) {
+                    to_hash[0] = hash[c][src_idx][src_pos];
+                    to_hash[1] = hash[c][src_idx][src_pos + 1];
+                    to_hash[2] = hash[c][src_idx][src_pos + 32];
+                    to_hash[3] = hash[c][src_idx][src_pos + 32 + 1];
+                    hash[c][dst_idx][y * 32 + x] = svt_av1_get_crc_value_sliced(
+                        c ? crc_calculator2 : crc_calculator1, (uint8_t *)to_hash, sizeof(to_hash));
+                }
+                if (level > 0) {
+                    const int out = out_offset[level] + y * count + x;
+                    hash_value1[out] = (hash[0][dst_idx][y * 32 + x] & crc_mask) + add_value;
+                    hash_value2[out] = hash[1][dst_idx][y * 32 + x];
+                }
+            }
+        }
+    }
+}
+
 void svt_av1_get_block_hash_value(uint8_t *y_src, int stride, int block_size, uint32_t *hash_value1,
                                   uint32_t *hash_value2, int use_highbitdepth,
                                   struct PictureControlSet *pcs, IntraBcContext *x) {
@@ -303,10 +421,10 @@ void svt_av1_get_block_hash_value(uint8_t *y_src, int stride, int block_size, ui
                 get_pixels_in_1d_short_array_by_block_2x2(
                     y16_src + y_pos * stride + x_pos, stride, pixel_to_hash);
                 assert(pos < AOM_BUFFER_SIZE_FOR_BLOCK_HASH);
-                x->hash_value_buffer[0][0][pos] = svt_av1_get_crc_value(
-                    &x->crc_calculator1, (uint8_t *)pixel_to_hash, sizeof(pixel_to_hash));
-                x->hash_value_buffer[1][0][pos] = svt_av1_get_crc_value(
-                    &x->crc_calculator2, (uint8_t *)pixel_to_hash, sizeof(pixel_to_hash));
+                x->hash_value_buffer[0][0][pos] = svt_av1_get_crc_value_sliced(
+                    x->crc_calculator1, (uint8_t *)pixel_to_hash, sizeof(pixel_to_hash));
+                x->hash_value_buffer[1][0][pos] = svt_av1_get_crc_value_sliced(
+                    x->crc_calculator2, (uint8_t *)pixel_to_hash, sizeof(pixel_to_hash));
             }
         }
     } else {
@@ -317,10 +435,10 @@ void svt_av1_get_block_hash_value(uint8_t *y_src, int stride, int block_size, ui
                 get_pixels_in_1d_char_array_by_block_2x2(
                     y_src + y_pos * stride + x_pos, stride, pixel_to_hash);
                 assert(pos < AOM_BUFFER_SIZE_FOR_BLOCK_HASH);
-                x->hash_value_buffer[0][0][pos] = svt_av1_get_crc_value(
-                    &x->crc_calculator1, pixel_to_hash, sizeof(pixel_to_hash));
-                x->hash_value_buffer[1][0][pos] = svt_av1_get_crc_value(
-                    &x->crc_calculator2, pixel_to_hash, sizeof(pixel_to_hash));
+                x->hash_value_buffer[0][0][pos] = svt_av1_get_crc_value_sliced(
+                    x->crc_calculator1, pixel_to_hash, sizeof(pixel_to_hash));
+                x->hash_value_buffer[1][0][pos] = svt_av1_get_crc_value_sliced(
+                    x->crc_calculator2, pixel_to_hash, sizeof(pixel_to_hash));
             }
         }
     }
@@ -348,15 +466,15 @@ void svt_av1_get_block_hash_value(uint8_t *y_src, int stride, int block_size, ui
                 to_hash[1] = x->hash_value_buffer[0][src_idx][src_pos + 1];
                 to_hash[2] = x->hash_value_buffer[0][src_idx][src_pos + src_sub_block_in_width];
                 to_hash[3] = x->hash_value_buffer[0][src_idx][src_pos + src_sub_block_in_width + 1];
-                x->hash_value_buffer[0][dst_idx][dst_pos] = svt_av1_get_crc_value(
-                    &x->crc_calculator1, (uint8_t *)to_hash, sizeof(to_hash));
+                x->hash_value_buffer[0][dst_idx][dst_pos] = svt_av1_get_crc_value_sliced(
+                    x->crc_calculator1, (uint8_t *)to_hash, sizeof(to_hash));
 
                 to_hash[0] = x->hash_value_buffer[1][src_idx][src_pos];
                 to_hash[1] = x->hash_value_buffer[1][src_idx][src_pos + 1];
                 to_hash[2] = x->hash_value_buffer[1][src_idx][src_pos + src_sub_block_in_width];
                 to_hash[3] = x->hash_value_buffer[1][src_idx][src_pos + src_sub_block_in_width + 1];
-                x->hash_value_buffer[1][dst_idx][dst_pos] = svt_av1_get_crc_value(
-                    &x->crc_calculator2, (uint8_t *)to_hash, sizeof(to_hash));
+                x->hash_value_buffer[1][dst_idx][dst_pos] = svt_av1_get_crc_value_sliced(
+                    x->crc_calculator2, (uint8_t *)to_hash, sizeof(to_hash));
                 dst_pos++;
             }
         }
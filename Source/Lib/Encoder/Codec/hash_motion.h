@@ -15,6 +15,7 @@
 #include "EbDefinitions.h"
 #include "EbCodingUnit.h"
 #include "vector.h"
+#include "hash.h"
 #include "EbPictureBufferDesc.h"
 
 #ifdef __cplusplus
@@ -37,21 +38,39 @@ void        svt_av1_hash_table_destroy(HashTable *p_hash_table);
 EbErrorType rtime_alloc_svt_av1_hash_table_create(HashTable *p_hash_table);
 int32_t     svt_av1_hash_table_count(const HashTable *p_hash_table, uint32_t hash_value);
 Iterator    svt_av1_hash_get_first_iterator(HashTable *p_hash_table, uint32_t hash_value);
-void        svt_av1_generate_block_2x2_hash_value(const Yv12BufferConfig   *picture,
-                                                  uint32_t                 *pic_block_hash[2],
-                                                  int8_t                   *pic_block_same_info[3],
-                                                  struct PictureControlSet *pcs);
+void        svt_av1_generate_block_2x2_hash_value(const Yv12BufferConfig *picture,
+                                                  uint32_t               *pic_block_hash[2],
+                                                  int8_t                 *pic_block_same_info[3],
+                                                  const CRC_CALCULATOR   *crc_calculator1,
+                                                  const CRC_CALCULATOR   *crc_calculator2);
 
 void svt_av1_generate_block_hash_value(const Yv12BufferConfig *picture, int block_size,
-                                       uint32_t                 *src_pic_block_hash[2],
-                                       uint32_t                 *dst_pic_block_hash[2],
-                                       int8_t                   *src_pic_block_same_info[3],
-                                       int8_t                   *dst_pic_block_same_info[3],
-                                       struct PictureControlSet *pcs);
+                                       uint32_t             *src_pic_block_hash[2],
+                                       uint32_t             *dst_pic_block_hash[2],
+                                       int8_t               *src_pic_block_same_info[3],
+                                       int8_t               *dst_pic_block_same_info[3],
+                                       const CRC_CALCULATOR *crc_calculator1,
+                                       const CRC_CALCULATOR *crc_calculator2);
 void rtime_alloc_svt_av1_add_to_hash_map_by_row_with_precal_data(HashTable *p_hash_table,
                                                                  uint32_t  *pic_hash[2],
                                                                  int8_t *pic_is_same, int pic_width,
                                                                  int pic_height, int block_size);
+EbErrorType svt_av1_build_hash_table(HashTable *p_hash_table, const Yv12BufferConfig *picture,
+                                     int min_block_size, int max_block_size,
+                                     const CRC_CALCULATOR *crc_calculator1,
+                                     const CRC_CALCULATOR *crc_calculator2);
+
+// Position of the blocks of each size in the output of svt_av1_get_b64_hash_values
+#define HASH_B64_64X64_OFFSET 0
+#define HASH_B64_32X32_OFFSET 1
+#define HASH_B64_16X16_OFFSET 5
+#define HASH_B64_8X8_OFFSET 21
+#define HASH_B64_BLOCK_COUNT 85
+void svt_av1_get_b64_hash_values(const uint8_t *src, int stride,
+                                 const CRC_CALCULATOR *crc_calculator1,
+                                 const CRC_CALCULATOR *crc_calculator2,
+                                 uint32_t              hash_value1[HASH_B64_BLOCK_COUNT],
+                                 uint32_t              hash_value2[HASH_B64_BLOCK_COUNT]);
 
 // check whether the block starts from (x_start, y_start) with the size of
 // BlockSize x BlockSize has the same color in all rows
@@ -16,6 +16,7 @@
 #include "noise_util.h"
 #include "mathutils.h"
 #include "EbLog.h"
+#include "EbThreads.h"
 #include "aom_dsp_rtcd.h"
 
 #define kLowPolyNumParams 3
@@ -580,45 +581,57 @@ static int compare_scores(const void *a, const void *b) {
     return diff < 0 ? -1 : diff > 0;
 }
 
-int32_t svt_aom_flat_block_finder_run(const AomFlatBlockFinder *block_finder,
-                                      const uint8_t *const data, int32_t w, int32_t h,
-                                      int32_t stride, uint8_t *flat_blocks) {
+typedef struct FlatBlockFinderRows {
+    const AomFlatBlockFinder *block_finder;
+    const uint8_t            *data;
+    int32_t                   w;
+    int32_t                   h;
+    int32_t                   stride;
+    int32_t                   num_blocks_w;
+    uint8_t                  *flat_blocks;
+    IndexAndscore            *scores;
+} FlatBlockFinderRows;
+
+// scores the blocks of the block rows [first, end)
+static int32_t flat_block_finder_rows(void *ctx, int32_t first, int32_t end) {
     // The gradient-based features used in this code are based on:
     //  A. Kokaram, D. Kelly, H. Denman and A. Crawford, "Measuring noise
     //  correlation for improved video denoising," 2012 19th, ICIP.
     // The thresholds are more lenient to allow for correct grain modeling
     // if extreme cases.
-    const int32_t  block_size        = block_finder->block_size;
-    const int32_t  n                 = block_size * block_size;
-    const double   k_trace_threshold = 0.15 / (32 * 32);
-    const double   k_ratio_threshold = 1.25;
-    const double   k_norm_threshold  = 0.08 / (32 * 32);
-    const double   k_var_threshold   = 0.005 / (double)n;
-    const int32_t  num_blocks_w      = (w + block_size - 1) / block_size;
-    const int32_t  num_blocks_h      = (h + block_size - 1) / block_size;
-    int32_t        num_flat          = 0;
-    double *       plane             = (double *)malloc(n * sizeof(*plane));
-    double *       block             = (double *)malloc(n * sizeof(*block));
-    IndexAndscore *scores = (IndexAndscore *)malloc(num_blocks_w * num_blocks_h * sizeof(*scores));
-    if (plane == NULL || block == NULL || scores == NULL) {
+    const FlatBlockFinderRows *rows              = (const FlatBlockFinderRows *)ctx;
+    const AomFlatBlockFinder  *block_finder      = rows->block_finder;
+    const int32_t              block_size        = block_finder->block_size;
+    const int32_t              n                 = block_size * block_size;
+    const double               k_trace_threshold = 0.15 / (32 * 32);
+    const double               k_ratio_threshold = 1.25;
+    const double               k_norm_threshold  = 0.08 / (32 * 32);
+    const double               k_var_threshold   = 0.005 / (double)n;
+    const int32_t              num_blocks_w      = rows->num_blocks_w;
+    double                    *plane             = (double *)malloc(n * sizeof(*plane));
+    double                    *block             = (double *)malloc(n * sizeof(*block));
+    if (plane == NULL || block == NULL) {
         SVT_ERROR("Failed to allocate memory for block of size %d\n", n);
         free(plane);
         free(block);
-        free(scores);
-        return -1;
+        return 0;
     }
 
-#ifdef NOISE_MODEL_LOG_SCORE
-    SVT_ERROR("score = [");
-#endif
-    for (int32_t by = 0; by < num_blocks_h; ++by) {
+    for (int32_t by = first; by < end; ++by) {
         for (int32_t bx = 0; bx < num_blocks_w; ++bx) {
             // Compute gradient covariance matrix.
             double g_xx = 0, g_xy = 0, g_yy = 0;
             double var  = 0;
             double mean = 0;
-            svt_aom_flat_block_finder_extract_block(
-                block_finder, data, w, h, stride, bx * block_size, by * block_size, plane, block);
+            svt_aom_flat_block_finder_extract_block(block_finder,
+                                                    rows->data,
+                                                    rows->w,
+                                                    rows->h,
+                                                    rows->stride,
+                                                    bx * block_size,
+                                                    by * block_size,
+                                                    plane,
+                                                    block);
 
             for (int32_t yi = 1; yi < block_size - 1; ++yi) {
                 for (int32_t xi = 1; xi < block_size - 1; ++xi) {
@@ -661,28 +674,65 @@ int32_t svt_aom_flat_block_finder_run(const AomFlatBlockFinder *block_finder,
                 // The weights are given in the following order:
                 //    [{var}, {ratio}, {trace}, {norm}, offset]
                 // with one of the most discriminative being simply the variance.
-                const double weights[5]              = {-6682, -0.2056, 13087, -12434, 2.5694};
-                const float  score                   = (float)(1.0 /
+                const double weights[5]                    = {-6682, -0.2056, 13087, -12434, 2.5694};
+                const float  score                         = (float)(1.0 /
                                             (1 +
                                              exp(-(weights[0] * var + weights[1] * ratio +
                                                    weights[2] * trace + weights[3] * norm +
                                                    weights[4]))));
-                flat_blocks[by * num_blocks_w + bx]  = is_flat ? 255 : 0;
-                scores[by * num_blocks_w + bx].score = var > k_var_threshold ? score : 0;
-                scores[by * num_blocks_w + bx].index = by * num_blocks_w + bx;
+                rows->flat_blocks[by * num_blocks_w + bx]  = is_flat ? 255 : 0;
+                rows->scores[by * num_blocks_w + bx].score = var > k_var_threshold ? score : 0;
+                rows->scores[by * num_blocks_w + bx].index = by * num_blocks_w + bx;
 #ifdef NOISE_MODEL_LOG_SCORE
                 SVT_ERROR("%g %g %g %g %g %d ", score, var, ratio, trace, norm, is_flat);
 #endif
-                num_flat += is_flat;
             }
         }
 #ifdef NOISE_MODEL_LOG_SCORE
         SVT_ERROR("\n");
 #endif
     }
+    free(block);
+    free(plane);
+    return 1;
+}
+
+int32_t svt_aom_flat_block_finder_run(const AomFlatBlockFinder *block_finder,
+                                      const uint8_t *const data, int32_t w, int32_t h,
+                                      int32_t stride, uint8_t *flat_blocks, SvtJobPool *job_pool) {
+    const int32_t       block_size   = block_finder->block_size;
+    const int32_t       num_blocks_w = (w + block_size - 1) / block_size;
+    const int32_t       num_blocks_h = (h + block_size - 1) / block_size;
+    int32_t             num_flat     = 0;
+    FlatBlockFinderRows rows;
+    IndexAndscore *scores = (IndexAndscore *)malloc(num_blocks_w * num_blocks_h * sizeof(*scores));
+    if (scores == NULL) {
+        SVT_ERROR("Failed to allocate memory for %d block scores\n", num_blocks_w * num_blocks_h);
+        return -1;
+    }
+
+    rows.block_finder = block_finder;
+    rows.data         = data;
+    rows.w            = w;
+    rows.h            = h;
+    rows.stride       = stride;
+    rows.num_blocks_w = num_blocks_w;
+    rows.flat_blocks  = flat_blocks;
+    rows.scores       = scores;
+#ifdef NOISE_MODEL_LOG_SCORE
+    SVT_ERROR("score = [");
+    // keep the rows of the log in order
+    job_pool = NULL;
+#endif
+    if (!svt_job_pool_run(job_pool, flat_block_finder_rows, &rows, num_blocks_h)) {
+        free(scores);
+        return -1;
+    }
 #ifdef NOISE_MODEL_LOG_SCORE
     SVT_ERROR("];\n");
 #endif
+    for (int32_t i = 0; i < num_blocks_w * num_blocks_h; ++i) num_flat += flat_blocks[i] != 0;
+
     // Find the top-scored blocks (most likely to be flat) and set the flat blocks
     // be the union of the thresholded results and the top 10th percentile of the
     // scored results.
@@ -695,8 +745,6 @@ int32_t svt_aom_flat_block_finder_run(const AomFlatBlockFinder *block_finder,
             flat_blocks[scores[i].index] |= 1;
         }
     }
-    free(block);
-    free(plane);
     free(scores);
     return num_flat;
 }
@@ -1058,16 +1106,58 @@ static int32_t ar_equation_system_solve(AomNoiseState *state, int32_t is_chroma)
     return ret;
 }
 
+typedef struct BlockObservations {
+    AomNoiseModel        *noise_model;
+    const uint8_t *const *data;
+    const uint8_t *const *denoised;
+    int32_t               w;
+    int32_t               h;
+    int32_t              *stride;
+    int32_t              *chroma_sub_log2;
+    const uint8_t        *flat_blocks;
+    int32_t               block_size;
+    int32_t               num_blocks_w;
+    int32_t               num_blocks_h;
+} BlockObservations;
+
+// adds the block observations of the channels [first, end)
+static int32_t add_channel_observations(void *ctx, int32_t first, int32_t end) {
+    const BlockObservations *obs = (const BlockObservations *)ctx;
+    for (int32_t channel = first; channel < end; ++channel) {
+        int32_t no_subsampling[2] = {0, 0};
+        if (!add_block_observations(obs->noise_model,
+                                    channel,
+                                    obs->data[channel],
+                                    obs->denoised[channel],
+                                    obs->w,
+                                    obs->h,
+                                    obs->stride[channel],
+                                    channel > 0 ? obs->chroma_sub_log2 : no_subsampling,
+                                    channel > 0 ? obs->data[0] : 0,
+                                    channel > 0 ? obs->denoised[0] : 0,
+                                    obs->stride[0],
+                                    obs->flat_blocks,
+                                    obs->block_size,
+                                    obs->num_blocks_w,
+                                    obs->num_blocks_h))
+            return 0;
+    }
+    return 1;
+}
+
 AomNoiseStatus svt_aom_noise_model_update(AomNoiseModel *const noise_model,
                                           const uint8_t *const data[3],
                                           const uint8_t *const denoised[3], int32_t w, int32_t h,
                                           int32_t stride[3], int32_t chroma_sub_log2[2],
-                                          const uint8_t *const flat_blocks, int32_t block_size) {
+                                          const uint8_t *const flat_blocks, int32_t block_size,
+                                          SvtJobPool *job_pool) {
     const int32_t num_blocks_w = (w + block_size - 1) / block_size;
     const int32_t num_blocks_h = (h + block_size - 1) / block_size;
     //  int32_t y_model_different = 0;
-    int32_t num_blocks = 0;
-    int32_t i = 0, channel = 0;
+    int32_t           num_blocks = 0;
+    int32_t           i = 0, channel = 0;
+    int32_t           num_channels = 0;
+    BlockObservations observations;
 
     if (block_size <= 1) {
         SVT_ERROR("BlockSize = %d must be > 1\n", block_size);
@@ -1097,32 +1187,32 @@ AomNoiseStatus svt_aom_noise_model_update(AomNoiseModel *const noise_model,
         return AOM_NOISE_STATUS_INSUFFICIENT_FLAT_BLOCKS;
     }
 
-    for (channel = 0; channel < 3; ++channel) {
+    while (num_channels < 3 && data[num_channels] && denoised[num_channels]) num_channels++;
+
+    // The equation systems of the channels are independent, accumulate them
+    // in parallel
+    observations.noise_model     = noise_model;
+    observations.data            = data;
+    observations.denoised        = denoised;
+    observations.w               = w;
+    observations.h               = h;
+    observations.stride          = stride;
+    observations.chroma_sub_log2 = chroma_sub_log2;
+    observations.flat_blocks     = flat_blocks;
+    observations.block_size      = block_size;
+    observations.num_blocks_w    = num_blocks_w;
+    observations.num_blocks_h    = num_blocks_h;
+    if (!svt_job_pool_run(
+            job_pool, add_channel_observations, &observations, num_channels)) {
+        SVT_ERROR("Adding block observation failed\n");
+        return AOM_NOISE_STATUS_INTERNAL_ERROR;
+    }
+
+    for (channel = 0; channel < num_channels; ++channel) {
         int32_t        no_subsampling[2] = {0, 0};
         const uint8_t *alt_data          = channel > 0 ? data[0] : 0;
-        const uint8_t *alt_denoised      = channel > 0 ? denoised[0] : 0;
         int32_t *      sub               = channel > 0 ? chroma_sub_log2 : no_subsampling;
         const int32_t  is_chroma         = channel != 0;
-        if (!data[channel] || !denoised[channel])
-            break;
-        if (!add_block_observations(noise_model,
-                                    channel,
-                                    data[channel],
-                                    denoised[channel],
-                                    w,
-                                    h,
-                                    stride[channel],
-                                    sub,
-                                    alt_data,
-                                    alt_denoised,
-                                    stride[0],
-                                    flat_blocks,
-                                    block_size,
-                                    num_blocks_w,
-                                    num_blocks_h)) {
-            SVT_ERROR("Adding block observation failed\n");
-            return AOM_NOISE_STATUS_INTERNAL_ERROR;
-        }
 
         if (!ar_equation_system_solve(&noise_model->latest_state[channel], is_chroma)) {
             if (is_chroma) {
@@ -1340,10 +1430,6 @@ int32_t svt_aom_noise_model_get_grain_parameters(AomNoiseModel *const noise_mode
     return 1;
 }
 
-static void pointwise_multiply(const float *a, float *b, int32_t n) {
-    for (int32_t i = 0; i < n; ++i) b[i] *= a[i];
-}
-
 //window_function[y * block_size + x] = (float)(cos((.5 + y) * PI / block_size - PI / 2) * cos((.5 + x) * PI / block_size - PI / 2));
 static const float window_function_half_cos_window_2[4] = {
     0.500000f,
@@ -2222,26 +2308,92 @@ static const float *get_half_cos_window(int32_t block_size) {
 DITHER_AND_QUANTIZE(uint8_t, lowbd);
 DITHER_AND_QUANTIZE(uint16_t, highbd);
 
+typedef struct WienerDenoisePass {
+    const AomFlatBlockFinder *block_finder;
+    const uint8_t            *data;
+    int32_t                   w;
+    int32_t                   h;
+    int32_t                   stride;
+    const float              *window_function;
+    float                     noise_psd;
+    int32_t                   block_size;
+    int32_t                   num_blocks_w;
+    int32_t                   offsx;
+    int32_t                   offsy;
+    float                    *result;
+    int32_t                   result_stride;
+} WienerDenoisePass;
+
+// filters the block rows [first - 1, end - 1) of a pass. The blocks of a pass
+// do not overlap, so that the rows can be accumulated in parallel.
+static int32_t wiener_denoise_rows(void *ctx, int32_t first, int32_t end) {
+    const WienerDenoisePass *pass             = (const WienerDenoisePass *)ctx;
+    const int32_t            block_size       = pass->block_size;
+    const int32_t            pixels_per_block = block_size * block_size;
+    const float             *window_function  = pass->window_function;
+    float                   *plane = (float *)malloc(pixels_per_block * sizeof(*plane));
+    DECLARE_ALIGNED(32, float, *block);
+    block = (float *)svt_aom_memalign(32, 2 * pixels_per_block * sizeof(*block));
+    double                *block_d = (double *)malloc(pixels_per_block * sizeof(*block_d));
+    double                *plane_d = (double *)malloc(pixels_per_block * sizeof(*plane_d));
+    struct aom_noise_tx_t *tx      = svt_aom_noise_tx_malloc(block_size);
+    const int32_t          success = (plane != NULL) && (block != NULL) && (block_d != NULL) &&
+        (plane_d != NULL) && (tx != NULL);
+
+    // Pad the boundary when processing each block-set.
+    for (int32_t by = first - 1; success && by < end - 1; ++by) {
+        for (int32_t bx = -1; bx < pass->num_blocks_w; ++bx) {
+            svt_aom_flat_block_finder_extract_block(pass->block_finder,
+                                                    pass->data,
+                                                    pass->w,
+                                                    pass->h,
+                                                    pass->stride,
+                                                    bx * block_size + pass->offsx,
+                                                    by * block_size + pass->offsy,
+                                                    plane_d,
+                                                    block_d);
+            // Apply window function to the plane approximation (we will apply
+            // it to the sum of plane + block when composing the results).
+            for (int32_t j = 0; j < pixels_per_block; ++j) {
+                block[j] = (float)block_d[j] * window_function[j];
+                plane[j] = (float)plane_d[j] * window_function[j];
+            }
+            svt_aom_noise_tx_forward(tx, block);
+            svt_aom_noise_tx_filter(tx, pass->noise_psd);
+            svt_aom_noise_tx_inverse(tx, block);
+
+            for (int32_t y = 0; y < block_size; ++y) {
+                const int32_t y_result = y + (by + 1) * block_size + pass->offsy;
+                float        *result   = pass->result + y_result * pass->result_stride +
+                    (bx + 1) * block_size + pass->offsx;
+                for (int32_t x = 0; x < block_size; ++x)
+                    result[x] += (block[y * block_size + x] + plane[y * block_size + x]) *
+                        window_function[y * block_size + x];
+            }
+        }
+    }
+    free(plane);
+    svt_aom_free(block);
+    free(plane_d);
+    free(block_d);
+    svt_aom_noise_tx_free(tx);
+    return success;
+}
+
 int32_t svt_aom_wiener_denoise_2d(const uint8_t *const data[3], uint8_t *denoised[3], int32_t w,
                                   int32_t h, int32_t stride[3], int32_t chroma_sub[2],
                                   float noise_psd[3], int32_t block_size, int32_t bit_depth,
-                                  int32_t use_highbd) {
-    const float *window_full = NULL, *window_chroma = NULL;
-    float *      plane = NULL;
-    DECLARE_ALIGNED(32, float, *block);
-    block                          = NULL;
-    double *               block_d = NULL, *plane_d = NULL;
-    struct aom_noise_tx_t *tx_full       = NULL;
-    struct aom_noise_tx_t *tx_chroma     = NULL;
-    const int32_t          num_blocks_w  = (w + block_size - 1) / block_size;
-    const int32_t          num_blocks_h  = (h + block_size - 1) / block_size;
-    const int32_t          result_stride = (num_blocks_w + 2) * block_size;
-    const int32_t          result_height = (num_blocks_h + 2) * block_size;
-    float *                result        = NULL;
-    int32_t                init_success  = 1;
-    AomFlatBlockFinder     block_finder_full;
-    AomFlatBlockFinder     block_finder_chroma;
-    const float            k_block_normalization = (float)((1 << bit_depth) - 1);
+                                  int32_t use_highbd, SvtJobPool *job_pool) {
+    const float       *window_full = NULL, *window_chroma = NULL;
+    const int32_t      num_blocks_w  = (w + block_size - 1) / block_size;
+    const int32_t      num_blocks_h  = (h + block_size - 1) / block_size;
+    const int32_t      result_stride = (num_blocks_w + 2) * block_size;
+    const int32_t      result_height = (num_blocks_h + 2) * block_size;
+    float             *result        = NULL;
+    int32_t            init_success  = 1;
+    AomFlatBlockFinder block_finder_full;
+    AomFlatBlockFinder block_finder_chroma;
+    const float        k_block_normalization = (float)((1 << bit_depth) - 1);
     if (chroma_sub[0] != chroma_sub[1]) {
         SVT_ERROR(
             "svt_aom_wiener_denoise_2d doesn't handle different chroma "
@@ -2250,86 +2402,46 @@ int32_t svt_aom_wiener_denoise_2d(const uint8_t *const data[3], uint8_t *denoise
     }
     init_success &= svt_aom_flat_block_finder_init(
         &block_finder_full, block_size, bit_depth, use_highbd);
-    result  = (float *)malloc((num_blocks_h + 2) * block_size * result_stride * sizeof(*result));
-    plane   = (float *)malloc(block_size * block_size * sizeof(*plane));
-    block   = (float *)svt_aom_memalign(32, 2 * block_size * block_size * sizeof(*block));
-    block_d = (double *)malloc(block_size * block_size * sizeof(*block_d));
-    plane_d = (double *)malloc(block_size * block_size * sizeof(*plane_d));
+    result      = (float *)malloc((num_blocks_h + 2) * block_size * result_stride * sizeof(*result));
     window_full = get_half_cos_window(block_size);
-    tx_full     = svt_aom_noise_tx_malloc(block_size);
 
     if (chroma_sub[0] != 0) {
         init_success &= svt_aom_flat_block_finder_init(
             &block_finder_chroma, block_size >> chroma_sub[0], bit_depth, use_highbd);
         window_chroma = get_half_cos_window(block_size >> chroma_sub[0]);
-        tx_chroma     = svt_aom_noise_tx_malloc(block_size >> chroma_sub[0]);
     } else {
         window_chroma = window_full;
-        tx_chroma     = tx_full;
     }
 
-    init_success &= (int32_t)((tx_full != NULL) && (tx_chroma != NULL) && (plane != NULL) &&
-                              (plane_d != NULL) && (block != NULL) && (block_d != NULL) &&
-                              (window_full != NULL) && (window_chroma != NULL) && (result != NULL));
+    init_success &= (int32_t)((window_full != NULL) && (window_chroma != NULL) &&
+                              (result != NULL));
     for (int32_t c = init_success ? 0 : 3; c < 3; ++c) {
-        const float *          window_function = c == 0 ? window_full : window_chroma;
-        AomFlatBlockFinder *   block_finder    = &block_finder_full;
-        const int32_t          chroma_sub_h    = c > 0 ? chroma_sub[1] : 0;
-        const int32_t          chroma_sub_w    = c > 0 ? chroma_sub[0] : 0;
-        struct aom_noise_tx_t *tx              = (c > 0 && chroma_sub[0] > 0) ? tx_chroma : tx_full;
+        const int32_t     chroma_sub_h = c > 0 ? chroma_sub[1] : 0;
+        const int32_t     chroma_sub_w = c > 0 ? chroma_sub[0] : 0;
+        WienerDenoisePass pass;
         if (!data[c] || !denoised[c])
             continue;
-        if (c > 0 && chroma_sub[0] != 0)
-            block_finder = &block_finder_chroma;
+        pass.block_finder = (c > 0 && chroma_sub[0] != 0) ? &block_finder_chroma
+                                                          : &block_finder_full;
+        pass.data            = data[c];
+        pass.w               = w >> chroma_sub_w;
+        pass.h               = h >> chroma_sub_h;
+        pass.stride          = stride[c];
+        pass.window_function = c == 0 ? window_full : window_chroma;
+        pass.noise_psd       = noise_psd[c];
+        pass.block_size      = block_size >> chroma_sub_w;
+        pass.num_blocks_w    = num_blocks_w;
+        pass.result          = result;
+        pass.result_stride   = result_stride;
         memset(result, 0, sizeof(*result) * result_stride * result_height);
-        // Do overlapped block processing (half overlapped). The block rows can
-        // easily be done in parallel
-        for (int32_t offsy = 0; offsy < (block_size >> chroma_sub_h);
-             offsy += (block_size >> chroma_sub_h) / 2) {
-            for (int32_t offsx = 0; offsx < (block_size >> chroma_sub_w);
-                 offsx += (block_size >> chroma_sub_w) / 2) {
-                // Pad the boundary when processing each block-set.
-                for (int32_t by = -1; by < num_blocks_h; ++by) {
-                    for (int32_t bx = -1; bx < num_blocks_w; ++bx) {
-                        const int32_t pixels_per_block = (block_size >> chroma_sub_w) *
-                            (block_size >> chroma_sub_h);
-                        svt_aom_flat_block_finder_extract_block(
-                            block_finder,
-                            data[c],
-                            w >> chroma_sub_w,
-                            h >> chroma_sub_h,
-                            stride[c],
-                            bx * (block_size >> chroma_sub_w) + offsx,
-                            by * (block_size >> chroma_sub_h) + offsy,
-                            plane_d,
-                            block_d);
-                        for (int32_t j = 0; j < pixels_per_block; ++j) {
-                            block[j] = (float)block_d[j];
-                            plane[j] = (float)plane_d[j];
-                        }
-                        pointwise_multiply(window_function, block, pixels_per_block);
-                        svt_aom_noise_tx_forward(tx, block);
-                        svt_aom_noise_tx_filter(tx, noise_psd[c]);
-                        svt_aom_noise_tx_inverse(tx, block);
-
-                        // Apply window function to the plane approximation (we will apply
-                        // it to the sum of plane + block when composing the results).
-                        pointwise_multiply(window_function, plane, pixels_per_block);
-
-                        for (int32_t y = 0; y < (block_size >> chroma_sub_h); ++y) {
-                            const int32_t y_result = y + (by + 1) * (block_size >> chroma_sub_h) +
-                                offsy;
-                            for (int32_t x = 0; x < (block_size >> chroma_sub_w); ++x) {
-                                const int32_t x_result = x +
-                                    (bx + 1) * (block_size >> chroma_sub_w) + offsx;
-                                result[y_result * result_stride + x_result] +=
-                                    (block[y * (block_size >> chroma_sub_w) + x] +
-                                     plane[y * (block_size >> chroma_sub_w) + x]) *
-                                    window_function[y * (block_size >> chroma_sub_w) + x];
-                            }
-                        }
-                    }
-                }
+        // Do overlapped block processing (half overlapped). The block rows of
+        // each of the 4 passes are done in parallel, the passes in order.
+        for (pass.offsy = 0; pass.offsy < (block_size >> chroma_sub_h);
+             pass.offsy += (block_size >> chroma_sub_h) / 2) {
+            for (pass.offsx = 0; pass.offsx < (block_size >> chroma_sub_w);
+                 pass.offsx += (block_size >> chroma_sub_w) / 2) {
+                init_success &= svt_job_pool_run(
+                    job_pool, wiener_denoise_rows, &pass, num_blocks_h + 1);
             }
         }
         if (use_highbd) {
@@ -2357,18 +2469,10 @@ int32_t svt_aom_wiener_denoise_2d(const uint8_t *const data[3], uint8_t *denoise
         }
     }
     free(result);
-    free(plane);
-    svt_aom_free(block);
-    free(plane_d);
-    free(block_d);
-
-    svt_aom_noise_tx_free(tx_full);
 
     svt_aom_flat_block_finder_free(&block_finder_full);
-    if (chroma_sub[0] != 0) {
+    if (chroma_sub[0] != 0)
         svt_aom_flat_block_finder_free(&block_finder_chroma);
-        svt_aom_noise_tx_free(tx_chroma);
-    }
     return init_success;
 }
 
@@ -2436,6 +2540,7 @@ EbErrorType denoise_and_model_ctor(AomDenoiseAndModel *object_ptr, EbPtr object_
     }
 
     object_ptr->denoise_apply = init_data_ptr->denoise_apply;
+    object_ptr->job_pool      = init_data_ptr->job_pool;
 
     return return_error;
 }
@@ -2600,7 +2705,8 @@ int32_t svt_aom_denoise_and_model_run(struct AomDenoiseAndModel *ctx, EbPictureB
     const uint8_t *const data[3] = {raw_data[0], raw_data[1], raw_data[2]};
 
     svt_aom_flat_block_finder_run(
-        &ctx->flat_block_finder, data[0], sd->width, sd->height, strides[0], ctx->flat_blocks);
+        &ctx->flat_block_finder, data[0], sd->width, sd->height, strides[0], ctx->flat_blocks,
+        ctx->job_pool);
 
     if (!svt_aom_wiener_denoise_2d(data,
                                    ctx->denoised,
@@ -2611,7 +2717,8 @@ int32_t svt_aom_denoise_and_model_run(struct AomDenoiseAndModel *ctx, EbPictureB
                                    ctx->noise_psd,
                                    block_size,
                                    ctx->bit_depth,
-                                   use_highbd)) {
+                                   use_highbd,
+                                   ctx->job_pool)) {
         SVT_ERROR("Unable to denoise image\n");
         return 0;
     }
@@ -2624,7 +2731,8 @@ int32_t svt_aom_denoise_and_model_run(struct AomDenoiseAndModel *ctx, EbPictureB
                                                              strides,
                                                              chroma_sub_log2,
                                                              ctx->flat_blocks,
-                                                             block_size);
+                                                             block_size,
+                                                             ctx->job_pool);
 
     int32_t have_noise_estimate = 0;
     if (status == AOM_NOISE_STATUS_OK || status == AOM_NOISE_STATUS_DIFFERENT_NOISE_TYPE) {
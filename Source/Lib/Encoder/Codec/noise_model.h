@@ -143,11 +143,12 @@ void svt_aom_flat_block_finder_extract_block(const AomFlatBlockFinder *block_fin
      * Find flat blocks in the input image data. Returns a map of
      * flat_blocks, where the value of flat_blocks map will be non-zero
      * when a block is determined to be flat. A higher value indicates a bigger
-     * confidence in the decision.
+     * confidence in the decision. The block rows are scored on the threads
+     * of job_pool.
      */
 int32_t svt_aom_flat_block_finder_run(const AomFlatBlockFinder *block_finder,
                                       const uint8_t *const data, int32_t w, int32_t h,
-                                      int32_t stride, uint8_t *flat_blocks);
+                                      int32_t stride, uint8_t *flat_blocks, SvtJobPool *job_pool);
 
 // The noise shape indicates the allowed coefficients in the AR model.
 typedef enum { AOM_NOISE_SHAPE_DIAMOND = 0, AOM_NOISE_SHAPE_SQUARE = 1 } AomNoiseShape;
@@ -214,6 +215,9 @@ typedef struct DenoiseAndModelInitData {
     uint16_t stride_cb;
     uint16_t stride_cr;
     uint8_t denoise_apply;
+    // threads of the denoising and the noise modeling, NULL for the calling
+    // thread only, the result does not depend on it
+    SvtJobPool *job_pool;
 } DenoiseAndModelInitData;
 
 typedef struct AomDenoiseAndModel {
@@ -241,6 +245,7 @@ typedef struct AomDenoiseAndModel {
     AomFlatBlockFinder flat_block_finder;
     AomNoiseModel      noise_model;
     uint8_t denoise_apply;
+    SvtJobPool *job_pool;
 } AomDenoiseAndModel;
 
 /************************************
@@ -275,12 +280,15 @@ void    svt_aom_noise_model_free(AomNoiseModel *model);
      * \param[in]     chroma_sub_log2 Chroma subsampling for planes != 0.
      * \param[in]     flat_blocks     A map to blocks that have been determined flat
      * \param[in]     block_size      The size of blocks.
+     * \param[in]     job_pool        Threads accumulating the equations of
+     *                                the planes.
      */
 AomNoiseStatus svt_aom_noise_model_update(AomNoiseModel *const noise_model,
                                           const uint8_t *const data[3],
                                           const uint8_t *const denoised[3], int32_t w, int32_t h,
                                           int32_t strides[3], int32_t chroma_sub_log2[2],
-                                          const uint8_t *const flat_blocks, int32_t block_size);
+                                          const uint8_t *const flat_blocks, int32_t block_size,
+                                          SvtJobPool *job_pool);
 
 /*\brief Save the "latest" estimate into the "combined" estimate.
      *
@@ -314,11 +322,13 @@ int32_t svt_aom_noise_model_get_grain_parameters(AomNoiseModel *const noise_mode
      * \param[in]     use_highbd      If true, uint8 pointers are interpreted as
      *                                uint16 and stride is measured in uint16.
      *                                This must be true when bit_depth >= 10.
+     * \param[in]     job_pool        Threads filtering the block rows, the
+     *                                output does not depend on it.
      */
 int32_t svt_aom_wiener_denoise_2d(const uint8_t *const data[3], uint8_t *denoised[3], int32_t w,
                                   int32_t h, int32_t stride[3], int32_t chroma_sub_log2[2],
                                   float noise_psd[3], int32_t block_size, int32_t bit_depth,
-                                  int32_t use_highbd);
+                                  int32_t use_highbd, SvtJobPool *job_pool);
 
 struct AomDenoiseAndModel;
 
@@ -112,8 +112,10 @@ void svt_aom_noise_tx_filter(struct aom_noise_tx_t *noise_tx, const float psd) {
 
 void svt_aom_noise_tx_inverse(struct aom_noise_tx_t *noise_tx, float *data) {
     const int32_t n = noise_tx->block_size * noise_tx->block_size;
+    // n is a power of 2, the product by its inverse is exact
+    const float inv_n = 1.0f / n;
     noise_tx->ifft(noise_tx->tx_block, noise_tx->temp, data);
-    for (int32_t i = 0; i < n; ++i) data[i] /= n;
+    for (int32_t i = 0; i < n; ++i) data[i] *= inv_n;
 }
 
 void svt_aom_noise_tx_free(struct aom_noise_tx_t *noise_tx) {
@@ -456,6 +456,9 @@ static int ransac(const int *matched_points, int npoints, int *num_inliers_by_mo
         projectpoints(params_this_motion, corners1, image1_coord, npoints, 2, 2);
 
         for (int i = 0; i < npoints; ++i) {
+            // stop counting once the motion can no longer be kept
+            if (current_motion.num_inliers + npoints - i < worst_kept_motion->num_inliers)
+                break;
             double dx            = image1_coord[i * 2] - corners2[i * 2];
             double dy            = image1_coord[i * 2 + 1] - corners2[i * 2 + 1];
             double distance_pow2 = dx * dx + dy * dy;
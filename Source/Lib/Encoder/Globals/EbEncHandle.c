@@ -51,6 +51,7 @@
 #include "EbEntropyCodingResults.h"
 #include "EbPredictionStructure.h"
 #include "EbRestProcess.h"
+#include "EbResize.h"
 #include "EbCdefProcess.h"
 #include "EbDlfProcess.h"
 #include "EbRateControlResults.h"
@@ -422,14 +423,15 @@ EbErrorType load_default_buffer_configuration_settings(
     if (return_ppcs == -1)
         return EB_ErrorInsufficientResources;
 
+    // One EncDec segment per SB, which codes the pictures as an SB wavefront
     uint32_t enc_dec_seg_h = (core_count == SINGLE_CORE_COUNT || is_pic_width_single_sb(scs_ptr->super_block_size, scs_ptr->max_input_luma_width)) ? 1 :
         (scs_ptr->super_block_size == 128) ?
-        ((scs_ptr->max_input_luma_height + 64) / 128) :
-        ((scs_ptr->max_input_luma_height + 32) / 64);
+        ((scs_ptr->max_input_luma_height + 127) / 128) :
+        ((scs_ptr->max_input_luma_height + 63) / 64);
     uint32_t enc_dec_seg_w = (core_count == SINGLE_CORE_COUNT) ? 1 :
         (scs_ptr->super_block_size == 128) ?
-        ((scs_ptr->max_input_luma_width + 64) / 128) :
-        ((scs_ptr->max_input_luma_width + 32) / 64);
+        ((scs_ptr->max_input_luma_width + 127) / 128) :
+        ((scs_ptr->max_input_luma_width + 63) / 64);
 
     if (scs_ptr->static_config.rate_control_mode != 0)
     {
@@ -748,6 +750,10 @@ EbErrorType load_default_buffer_configuration_settings(
     scs_ptr->dlf_fifo_init_count                         = 300;
     scs_ptr->cdef_fifo_init_count                        = 300;
     scs_ptr->rest_fifo_init_count                        = 300;
+    // the sub-pel plane tasks of the references to the Rest threads, see post_subpel_ref_planes()
+    if (scs_ptr->static_config.subpel_ref_planes)
+        scs_ptr->rest_fifo_init_count += scs_ptr->reference_picture_buffer_init_count *
+            SUBPEL_REF_PLANES;
     //#====================== Processes number ======================
     scs_ptr->total_process_init_count                    = 0;
 
@@ -856,6 +862,7 @@ EbErrorType load_default_buffer_configuration_settings(
     }
 
     scs_ptr->total_process_init_count += 6; // single processes count
+    scs_ptr->thread_budget = core_count;
     if (scs_ptr->static_config.pass == 0 || scs_ptr->static_config.pass == 3){
         SVT_INFO("Number of logical cores available: %u\n", core_count);
         SVT_INFO("Number of PPCS %u\n", scs_ptr->picture_control_set_pool_init_count);
@@ -1047,6 +1054,8 @@ static void svt_enc_handle_stop_threads(EbEncHandle *enc_handle_ptr)
 
     // Packetization
     EB_DESTROY_THREAD(enc_handle_ptr->packetization_thread_handle);
+    svt_job_pool_destroy(control_set_ptr->encode_context_ptr->job_pool);
+    control_set_ptr->encode_context_ptr->job_pool = NULL;
 }
 /**********************************
 * Encoder Library Handle Deonstructor
@@ -1079,6 +1088,10 @@ static void svt_enc_handle_dctor(EbPtr p)
         }
     }
     EB_DELETE(enc_handle_ptr->input_buffer_resource_ptr);
+    if (enc_handle_ptr->scaled_input) {
+        EB_FREE(enc_handle_ptr->scaled_input->luma);
+        EB_FREE(enc_handle_ptr->scaled_input);
+    }
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->output_stream_buffer_resource_ptr_array, enc_handle_ptr->encode_instance_total_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->output_recon_buffer_resource_ptr_array, enc_handle_ptr->encode_instance_total_count);
     EB_DELETE(enc_handle_ptr->resource_coordination_results_resource_ptr);
@@ -1405,6 +1418,21 @@ static int create_ref_buf_descs(EbEncHandle *enc_handle_ptr, uint32_t instance_i
     eb_ref_obj_ect_desc_init_data_structure.reference_picture_desc_init_data = ref_pic_buf_desc_init_data;
     eb_ref_obj_ect_desc_init_data_structure.hbd_mode_decision =
         scs_ptr->enable_hbd_mode_decision;
+    // the first pass does not predict from padded references
+    eb_ref_obj_ect_desc_init_data_structure.subpel_ref_planes =
+        scs_ptr->static_config.pass == ENC_FIRST_PASS ? 0 : scs_ptr->static_config.subpel_ref_planes;
+    if (eb_ref_obj_ect_desc_init_data_structure.subpel_ref_planes) {
+        const uint64_t size = svt_subpel_ref_planes_size(
+            eb_ref_obj_ect_desc_init_data_structure.subpel_ref_planes,
+            ref_pic_buf_desc_init_data.max_width,
+            ref_pic_buf_desc_init_data.max_height,
+            padding,
+            is_16bit);
+        SVT_INFO("Sub-pel reference planes: %.1f MB per reference, %.1f MB for %u references\n",
+                 size / (1024.0 * 1024.0),
+                 size * scs_ptr->reference_picture_buffer_init_count / (1024.0 * 1024.0),
+                 scs_ptr->reference_picture_buffer_init_count);
+    }
 
     // Reference Picture Buffers
     EB_NEW(
@@ -1429,6 +1457,39 @@ static int create_ref_buf_descs(EbEncHandle *enc_handle_ptr, uint32_t instance_i
 
 void init_fn_ptr(void);
 void svt_av1_init_wedge_masks(void);
+/*
+ * Allocate the picture the input is resized into when its size
+ * (input_picture_width/height) differs from the encoding size
+ */
+static EbErrorType scaled_input_ctor(EbEncHandle *enc_handle_ptr) {
+    SequenceControlSet *scs_ptr      = enc_handle_ptr->scs_instance_array[0]->scs_ptr;
+    const EbColorFormat color_format = scs_ptr->static_config.encoder_color_format;
+    const uint32_t      width  = scs_ptr->max_input_luma_width - scs_ptr->max_input_pad_right;
+    const uint32_t      height = scs_ptr->max_input_luma_height - scs_ptr->max_input_pad_bottom;
+    const uint32_t      ss_x   = color_format == EB_YUV420 || color_format == EB_YUV422;
+    const uint32_t      ss_y   = color_format == EB_YUV420;
+    const uint32_t      bytes_per_pixel = scs_ptr->static_config.encoder_bit_depth > EB_8BIT ? 2 : 1;
+    const size_t        luma_size       = (size_t)width * height;
+    const size_t        chroma_size     = color_format == EB_YUV400
+                   ? 0
+                   : (size_t)((width + ss_x) >> ss_x) * ((height + ss_y) >> ss_y);
+
+    EbSvtIOFormat *pic;
+    EB_CALLOC(pic, 1, sizeof(*pic));
+    enc_handle_ptr->scaled_input = pic;
+    EB_MALLOC(pic->luma, (luma_size + 2 * chroma_size) * bytes_per_pixel);
+    pic->cb        = pic->luma + luma_size * bytes_per_pixel;
+    pic->cr        = pic->cb + chroma_size * bytes_per_pixel;
+    pic->y_stride  = width;
+    pic->cb_stride = (width + ss_x) >> ss_x;
+    pic->cr_stride = (width + ss_x) >> ss_x;
+    pic->width     = width;
+    pic->height    = height;
+    pic->color_fmt = color_format;
+    pic->bit_depth = scs_ptr->static_config.encoder_bit_depth;
+    return EB_ErrorNone;
+}
+
 /**********************************
 * Initialize Encoder Library
 **********************************/
@@ -1762,6 +1823,12 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
 #endif
     enc_handle_ptr->input_y8b_buffer_producer_fifo_ptr = svt_system_resource_get_producer_fifo(enc_handle_ptr->input_y8b_buffer_resource_ptr, 0);
 
+    if (enc_handle_ptr->scs_instance_array[0]->scs_ptr->static_config.input_picture_width) {
+        return_error = scaled_input_ctor(enc_handle_ptr);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+    }
+
     // EbBufferHeaderType Output Stream
     EB_ALLOC_PTR_ARRAY(enc_handle_ptr->output_stream_buffer_resource_ptr_array, enc_handle_ptr->encode_instance_total_count);
 
@@ -1962,7 +2029,9 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             enc_handle_ptr->enc_dec_results_resource_ptr,
             svt_system_resource_ctor,
             enc_handle_ptr->scs_instance_array[0]->scs_ptr->enc_dec_fifo_init_count,
-            enc_handle_ptr->scs_instance_array[0]->scs_ptr->enc_dec_process_init_count,
+            // the DLF processes send their DLF segment helper tasks to each other
+            enc_handle_ptr->scs_instance_array[0]->scs_ptr->enc_dec_process_init_count +
+                enc_handle_ptr->scs_instance_array[0]->scs_ptr->dlf_process_init_count,
             enc_handle_ptr->scs_instance_array[0]->scs_ptr->dlf_process_init_count,
             enc_dec_results_creator,
             &enc_dec_result_init_data,
@@ -1977,7 +2046,9 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             enc_handle_ptr->dlf_results_resource_ptr,
             svt_system_resource_ctor,
             enc_handle_ptr->scs_instance_array[0]->scs_ptr->dlf_fifo_init_count,
-            enc_handle_ptr->scs_instance_array[0]->scs_ptr->dlf_process_init_count,
+            // the CDEF processes send their CDEF segment helper tasks to each other
+            enc_handle_ptr->scs_instance_array[0]->scs_ptr->dlf_process_init_count +
+                enc_handle_ptr->scs_instance_array[0]->scs_ptr->cdef_process_init_count,
             enc_handle_ptr->scs_instance_array[0]->scs_ptr->cdef_process_init_count,
             dlf_results_creator,
             &delf_result_init_data,
@@ -1991,7 +2062,9 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             enc_handle_ptr->cdef_results_resource_ptr,
             svt_system_resource_ctor,
             enc_handle_ptr->scs_instance_array[0]->scs_ptr->cdef_fifo_init_count,
-            enc_handle_ptr->scs_instance_array[0]->scs_ptr->cdef_process_init_count,
+            // the Rest processes send their LR segment helper tasks to each other
+            enc_handle_ptr->scs_instance_array[0]->scs_ptr->cdef_process_init_count +
+                enc_handle_ptr->scs_instance_array[0]->scs_ptr->rest_process_init_count,
             enc_handle_ptr->scs_instance_array[0]->scs_ptr->rest_process_init_count,
             cdef_results_creator,
             &cdef_result_init_data,
@@ -2224,6 +2297,55 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
 
     control_set_ptr = enc_handle_ptr->scs_instance_array[0]->scs_ptr;
 
+    // Motion analysis export / import, the first pass of a multi-pass encode doesn't take part
+    if ((config_ptr->analysis_out_file || config_ptr->analysis_in_file) &&
+        (config_ptr->pass == ENC_SINGLE_PASS || config_ptr->pass == ENC_LAST_PASS)) {
+        return_error = analysis_file_open(&control_set_ptr->encode_context_ptr->analysis_file,
+                                          control_set_ptr,
+                                          config_ptr->analysis_out_file ? config_ptr->analysis_out_file
+                                                                        : config_ptr->analysis_in_file,
+                                          config_ptr->analysis_out_file != NULL);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+    }
+
+    // Look ahead rate control: the first pass stats of the frames in flight
+    if (control_set_ptr->lap_rc) {
+        EncodeContext *encode_context_ptr = control_set_ptr->encode_context_ptr;
+        return_error = svt_av1_alloc_lap_stats(&encode_context_ptr->stats_buf_context,
+                                               control_set_ptr->picture_control_set_pool_init_count);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+        if (config_ptr->rc_stats_stream) {
+            // the stats of the pictures sent and not yet in the look ahead
+            FirstPassStatsIn *in = &encode_context_ptr->stats_stream;
+            in->capability = control_set_ptr->input_buffer_fifo_init_count +
+                control_set_ptr->picture_control_set_pool_init_count + LAP_STATS_MARGIN;
+            EB_MALLOC_ARRAY(in->stat, in->capability);
+            EB_CREATE_MUTEX(in->mutex);
+            in->last.frame = -1;
+        }
+    }
+
+    // Adaptive thread allocation, set up before the workers ask for their first task
+    if (config_ptr->adaptive_threads) {
+        ThreadBudget *tb = &control_set_ptr->encode_context_ptr->thread_budget;
+        thread_budget_add_stage(tb, "PA", enc_handle_ptr->resource_coordination_results_resource_ptr, control_set_ptr->picture_analysis_process_init_count);
+        thread_budget_add_stage(tb, "ME", enc_handle_ptr->picture_decision_results_resource_ptr, control_set_ptr->motion_estimation_process_init_count);
+        thread_budget_add_stage(tb, "TPL", enc_handle_ptr->tpl_disp_res_srm, control_set_ptr->tpl_disp_process_init_count);
+        thread_budget_add_stage(tb, "MDC", enc_handle_ptr->rate_control_results_resource_ptr, control_set_ptr->mode_decision_configuration_process_init_count);
+        thread_budget_add_stage(tb, "EncDec", enc_handle_ptr->enc_dec_tasks_resource_ptr, control_set_ptr->enc_dec_process_init_count);
+        thread_budget_add_stage(tb, "DLF", enc_handle_ptr->enc_dec_results_resource_ptr, control_set_ptr->dlf_process_init_count);
+        thread_budget_add_stage(tb, "CDEF", enc_handle_ptr->dlf_results_resource_ptr, control_set_ptr->cdef_process_init_count);
+        thread_budget_add_stage(tb, "REST", enc_handle_ptr->cdef_results_resource_ptr, control_set_ptr->rest_process_init_count);
+        thread_budget_add_stage(tb, "EC", enc_handle_ptr->rest_results_resource_ptr, control_set_ptr->entropy_coding_process_init_count);
+        thread_budget_init(tb, control_set_ptr->thread_budget);
+    }
+
+    // Jobs run inside the processes, the calling thread being one of the budget
+    control_set_ptr->encode_context_ptr->job_pool = svt_job_pool_create(
+        control_set_ptr->thread_budget - 1);
+
     // Resource Coordination
     EB_CREATE_THREAD(enc_handle_ptr->resource_coordination_thread_handle, resource_coordination_kernel, enc_handle_ptr->resource_coordination_context_ptr);
     EB_CREATE_THREAD_ARRAY(enc_handle_ptr->picture_analysis_thread_handle_array,control_set_ptr->picture_analysis_process_init_count,
@@ -3183,7 +3305,8 @@ void set_multi_pass_params(SequenceControlSet *scs_ptr)
         }
 
         case ENC_FIRST_PASS: {
-            if (config->enc_mode <= ENC_M4)
+            // the streamed stats replace the look ahead first pass, which analyses every frame
+            if (config->rc_stats_stream || config->enc_mode <= ENC_M4)
                 set_ipp_pass_ctrls(scs_ptr, 0);
             else if (config->enc_mode <= ENC_M10)
                 set_ipp_pass_ctrls(scs_ptr, 1);
@@ -4022,6 +4145,16 @@ void copy_api_from_app(
         : scs_ptr->static_config.sframe_dist > 0 ? 16384 : scs_ptr->max_input_luma_width;
     scs_ptr->seq_header.max_frame_height = config_struct->forced_max_frame_height > 0 ? config_struct->forced_max_frame_height
         : scs_ptr->static_config.sframe_dist > 0 ? 8704 : scs_ptr->max_input_luma_height;
+
+    // Low latency output
+    scs_ptr->static_config.sub_frame_output = config_struct->sub_frame_output;
+    scs_ptr->static_config.adaptive_threads = config_struct->adaptive_threads;
+    scs_ptr->static_config.input_picture_width  = config_struct->input_picture_width;
+    scs_ptr->static_config.input_picture_height = config_struct->input_picture_height;
+    scs_ptr->static_config.analysis_out_file    = config_struct->analysis_out_file;
+    scs_ptr->static_config.analysis_in_file     = config_struct->analysis_in_file;
+    scs_ptr->static_config.subpel_ref_planes    = config_struct->subpel_ref_planes;
+    scs_ptr->static_config.rc_stats_stream      = config_struct->rc_stats_stream;
     return;
 }
 
@@ -4712,6 +4845,44 @@ static EbErrorType copy_metadata_buffer(EbBufferHeaderType *dst, EbBufferHeaderT
     return return_error;
 }
 /**********************************
+* svt_av1_enc_send_stats queues the streamed first pass stats
+**********************************/
+EB_API EbErrorType svt_av1_enc_send_stats(
+    EbComponentType      *svt_enc_component,
+    const SvtAv1FixedBuf *stats)
+{
+    if (svt_enc_component == NULL || stats == NULL)
+        return EB_ErrorBadParameter;
+    EbEncHandle      *enc_handle_ptr = (EbEncHandle*)svt_enc_component->p_component_private;
+    EncodeContext    *context = enc_handle_ptr->scs_instance_array[0]->encode_context_ptr;
+    FirstPassStatsIn *in = &context->stats_stream;
+    // the stats are sent to the single pass encode, not to the first pass writing them
+    if (!in->stat || stats->sz % sizeof(FIRSTPASS_STATS))
+        return EB_ErrorBadParameter;
+
+    const FIRSTPASS_STATS *stat = (const FIRSTPASS_STATS*)stats->buf;
+    const uint64_t         count = stats->sz / sizeof(FIRSTPASS_STATS);
+    EbErrorType            return_error = EB_ErrorNone;
+    svt_block_on_mutex(in->mutex);
+    // the stats are taken whole or not at all
+    uint64_t frames = 0;
+    for (uint64_t i = 0; i < count; i++)
+        frames += stat[i].count == 1.0;
+    if (in->count + frames > in->capability)
+        return_error = EB_ErrorInsufficientResources;
+    else {
+        for (uint64_t i = 0; i < count; i++) {
+            // the total stats closing the first pass cover several frames
+            if (stat[i].count != 1.0)
+                continue;
+            in->stat[(in->head + in->count) % in->capability] = stat[i];
+            in->count++;
+        }
+    }
+    svt_release_mutex(in->mutex);
+    return return_error;
+}
+/**********************************
 * Empty This Buffer
 **********************************/
 EB_API EbErrorType svt_av1_enc_send_picture(
@@ -4721,6 +4892,28 @@ EB_API EbErrorType svt_av1_enc_send_picture(
     EbEncHandle          *enc_handle_ptr = (EbEncHandle*)svt_enc_component->p_component_private;
     EbObjectWrapper      *eb_wrapper_ptr;
     EbBufferHeaderType   *app_hdr = p_buffer;
+    EbBufferHeaderType    scaled_hdr;
+
+    if (enc_handle_ptr->scaled_input && p_buffer && p_buffer->p_buffer) {
+        // resize into the staging picture, then copy it as if the app had sent it; this is done
+        // before taking the input buffers so that a failure leaves the pipeline untouched
+        EbSvtAv1EncConfiguration *config = &enc_handle_ptr->scs_instance_array[0]->scs_ptr->static_config;
+        EbSvtIOFormat            *scaled = enc_handle_ptr->scaled_input;
+        EbErrorType               return_error = svt_av1_resize_input_picture(
+            (EbSvtIOFormat *)p_buffer->p_buffer,
+            config->input_picture_width,
+            config->input_picture_height,
+            scaled,
+            scaled->width,
+            scaled->height,
+            config->encoder_bit_depth,
+            config->encoder_color_format);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+        scaled_hdr          = *p_buffer;
+        scaled_hdr.p_buffer = (uint8_t *)scaled;
+        app_hdr             = &scaled_hdr;
+    }
 
     // Get new Luma-8b buffer & a new (Chroma-8b + Luma-Chroma-2bit) buffers; Lib will release once done.
     EbObjectWrapper  *eb_y8b_wrapper_ptr;
@@ -4820,7 +5013,7 @@ EB_API EbErrorType svt_av1_enc_get_packet(
 
     if (eb_wrapper_ptr) {
         packet = (EbBufferHeaderType*)eb_wrapper_ptr->object_ptr;
-        if ( packet->flags & 0xfffffff0 )
+        if ( packet->flags & EB_BUFFERFLAG_ERROR_MASK )
             return_error = EB_ErrorMax;
         // return the output stream buffer
         *p_buffer = packet;
@@ -5259,10 +5452,47 @@ EB_API EbErrorType svt_av1_enc_get_stream_info(EbComponentType *    svt_enc_comp
     if (stream_info_id == SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_OUT) {
         EncodeContext*      context = enc_handle->scs_instance_array[0]->encode_context_ptr;
         SvtAv1FixedBuf*     first_pass_stats = (SvtAv1FixedBuf*)info;
+        // the stats handed out incrementally were dropped
+        if (context->stats_out.first)
+            return EB_ErrorBadParameter;
         first_pass_stats->buf = context->stats_out.stat;
         first_pass_stats->sz = context->stats_out.size * sizeof(FIRSTPASS_STATS);
         return EB_ErrorNone;
     }
+    if (stream_info_id == SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_NEW) {
+        EncodeContext*      context = enc_handle->scs_instance_array[0]->encode_context_ptr;
+        FirstPassStatsOut*  out = &context->stats_out;
+        SvtAv1FixedBuf*     first_pass_stats = (SvtAv1FixedBuf*)info;
+        EbErrorType         return_error = EB_ErrorNone;
+        svt_block_on_mutex(context->stat_file_mutex);
+        const size_t count = out->size - out->handed_out;
+        if (count > out->new_capability) {
+            EB_REALLOC_ARRAY(out->new_stat, count);
+            out->new_capability = out->new_stat ? count : 0;
+        }
+        if (count && !out->new_stat)
+            return_error = EB_ErrorInsufficientResources;
+        else {
+            if (count)
+                svt_memcpy(out->new_stat, out->stat + (out->handed_out - out->first),
+                           count * sizeof(FIRSTPASS_STATS));
+            out->handed_out = out->size;
+            // keep the last frame, read by the next one when it is skipped
+            if (out->size > out->first + 1) {
+                const size_t last = out->size - 1;
+                out->stat[0] = out->stat[last - out->first];
+                out->first   = last;
+            }
+        }
+        first_pass_stats->buf = return_error == EB_ErrorNone ? out->new_stat : NULL;
+        first_pass_stats->sz = return_error == EB_ErrorNone ? count * sizeof(FIRSTPASS_STATS) : 0;
+        svt_release_mutex(context->stat_file_mutex);
+        return return_error;
+    }
+    if (stream_info_id == SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_SIZE) {
+        *(uint64_t*)info = sizeof(FIRSTPASS_STATS);
+        return EB_ErrorNone;
+    }
     return EB_ErrorBadParameter;
 }
 // clang-format on
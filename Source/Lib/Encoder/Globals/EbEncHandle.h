@@ -124,6 +124,9 @@ struct _EbEncHandle {
     EbFifo *input_y8b_buffer_producer_fifo_ptr;
     EbFifo *output_stream_buffer_consumer_fifo_ptr;
     EbFifo *output_recon_buffer_consumer_fifo_ptr;
+
+    // Input pictures resized to the encoding size when input_picture_width/height are set
+    EbSvtIOFormat *scaled_input;
 };
 
 #endif // EbEncHandle_h
@@ -433,8 +433,8 @@ EbErrorType svt_av1_verify_settings(SequenceControlSet *scs_ptr) {
     }
 
     // CDEF
-    if (config->cdef_level > 4 || config->cdef_level < -1) {
-        SVT_ERROR("Instance %u: Invalid CDEF level [0 - 4, -1 for auto], your input: %d\n",
+    if ((config->cdef_level > 4 && config->cdef_level != 19) || config->cdef_level < -1) {
+        SVT_ERROR("Instance %u: Invalid CDEF level [0 - 4, 19, -1 for auto], your input: %d\n",
                   channel_number + 1,
                   config->cdef_level);
         return_error = EB_ErrorBadParameter;
@@ -795,6 +795,66 @@ EbErrorType svt_av1_verify_settings(SequenceControlSet *scs_ptr) {
             return_error = EB_ErrorBadParameter;
         }
     }
+    if (config->sub_frame_output) {
+        if (config->pred_structure != 1) {
+            SVT_ERROR("Instance %u: Sub-frame output is only supported for low-delay.\n",
+                      channel_number + 1);
+            return_error = EB_ErrorBadParameter;
+        }
+        if (config->tile_columns == 0 && config->tile_rows == 0) {
+            SVT_WARN(
+                "Instance %u: Sub-frame output has no effect with a single tile, frames will be "
+                "output whole. Use --tile-columns / --tile-rows to get per-tile output.\n",
+                channel_number + 1);
+        }
+    }
+    if (config->input_picture_width || config->input_picture_height) {
+        if (!config->input_picture_width || !config->input_picture_height) {
+            SVT_ERROR("Instance %u: Input picture width and height must be set together\n",
+                      channel_number + 1);
+            return_error = EB_ErrorBadParameter;
+        } else if (config->input_picture_width < 64 || config->input_picture_width > 16384 ||
+                   config->input_picture_height < 64 || config->input_picture_height > 8704) {
+            SVT_ERROR("Instance %u: Input picture size must be between 64x64 and 16384x8704\n",
+                      channel_number + 1);
+            return_error = EB_ErrorBadParameter;
+        } else if (config->input_picture_width % 2 || config->input_picture_height % 2) {
+            SVT_ERROR("Instance %u: Input picture width and height must be even\n",
+                      channel_number + 1);
+            return_error = EB_ErrorBadParameter;
+        }
+        if (config->encoder_bit_depth > EB_8BIT && config->compressed_ten_bit_format) {
+            SVT_ERROR(
+                "Instance %u: Input picture resizing is not supported with the compressed 10-bit "
+                "format\n",
+                channel_number + 1);
+            return_error = EB_ErrorBadParameter;
+        }
+    }
+    if (config->analysis_out_file && config->analysis_in_file) {
+        SVT_ERROR("Instance %u: The analysis file can be either exported or imported\n",
+                  channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+    if ((config->analysis_out_file || config->analysis_in_file) &&
+        config->superres_mode != SUPERRES_NONE) {
+        SVT_ERROR("Instance %u: The analysis file is not supported with super-resolution\n",
+                  channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+    if (config->subpel_ref_planes > 2) {
+        SVT_ERROR("Instance %u: Invalid sub-pel reference planes level [0-2], your input: %u\n",
+                  channel_number + 1,
+                  config->subpel_ref_planes);
+        return_error = EB_ErrorBadParameter;
+    }
+    if (config->rc_stats_stream && config->pass != ENC_FIRST_PASS &&
+        (config->rate_control_mode != 1 || config->pass != ENC_SINGLE_PASS)) {
+        SVT_ERROR("Instance %u: Streamed first pass stats are only supported by the first pass and "
+                  "the single pass VBR\n",
+                  channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
     if (scs_ptr->static_config.scene_change_detection) {
         scs_ptr->static_config.scene_change_detection = 0;
         SVT_WARN(
@@ -937,6 +997,21 @@ EbErrorType svt_av1_set_default_params(EbSvtAv1EncConfiguration *config_ptr) {
     // Switch frame default values
     config_ptr->sframe_dist = 0;
     config_ptr->sframe_mode = SFRAME_NEAREST_BASE;
+
+    // Low latency output
+    config_ptr->sub_frame_output = FALSE;
+
+    config_ptr->adaptive_threads = FALSE;
+
+    config_ptr->input_picture_width  = 0;
+    config_ptr->input_picture_height = 0;
+
+    config_ptr->analysis_out_file = NULL;
+    config_ptr->analysis_in_file  = NULL;
+
+    config_ptr->subpel_ref_planes = 0;
+
+    config_ptr->rc_stats_stream = FALSE;
     return return_error;
 }
 
@@ -1564,6 +1639,8 @@ EB_API EbErrorType svt_av1_enc_parse_parameter(EbSvtAv1EncConfiguration *config_
     } uint_opts[] = {
         {"width", &config_struct->source_width},
         {"height", &config_struct->source_height},
+        {"input-picture-width", &config_struct->input_picture_width},
+        {"input-picture-height", &config_struct->input_picture_height},
         {"qp", &config_struct->qp},
         {"film-grain", &config_struct->film_grain_denoise_strength},
         {"hierarchical-levels", &config_struct->hierarchical_levels},
@@ -1617,6 +1694,7 @@ EB_API EbErrorType svt_av1_enc_parse_parameter(EbSvtAv1EncConfiguration *config_
         {"fast-decode", &config_struct->fast_decode},
         {"tune", &config_struct->tune},
         {"film-grain-denoise", &config_struct->film_grain_denoise_apply},
+        {"subpel-ref-planes", &config_struct->subpel_ref_planes},
     };
     const size_t uint8_opts_size = sizeof(uint8_opts) / sizeof(uint8_opts[0]);
 
@@ -1661,6 +1739,7 @@ EB_API EbErrorType svt_av1_enc_parse_parameter(EbSvtAv1EncConfiguration *config_
         {"chroma-v-ac-qindex-offset", &config_struct->chroma_v_ac_qindex_offset},
         {"pass", &config_struct->pass},
         {"enable-cdef", &config_struct->cdef_level},
+        {"cdef-level", &config_struct->cdef_level},
         {"enable-restoration", &config_struct->enable_restoration_filtering},
         {"enable-mfmv", &config_struct->enable_mfmv},
         {"intra-period", &config_struct->intra_period_length},
@@ -1708,6 +1787,9 @@ EB_API EbErrorType svt_av1_enc_parse_parameter(EbSvtAv1EncConfiguration *config_
         {"enable-tf", &config_struct->enable_tf},
         {"enable-overlays", &config_struct->enable_overlays},
         {"enable-hdr", &config_struct->high_dynamic_range_input},
+        {"sub-frame-output", &config_struct->sub_frame_output},
+        {"adaptive-threads", &config_struct->adaptive_threads},
+        {"stats-stream", &config_struct->rc_stats_stream},
     };
     const size_t bool_opts_size = sizeof(bool_opts) / sizeof(bool_opts[0]);
 
@@ -20,7 +20,9 @@
  ******************************************************************************/
 #include <math.h>
 #include <stdlib.h>
+#include <algorithm>
 #include <random>
+#include <vector>
 #include "EbCabacContextModel.h"
 #if defined(CHAR_BIT)
 #undef CHAR_BIT  // defined in clang/9.1.0/include/limits.h
@@ -30,6 +32,7 @@
 #include "EbDecHandle.h"
 #include "EbDecBitReader.h"
 #include "EbDecParseFrame.h"
+#include "EbTime.h"
 #include "gtest/gtest.h"
 #include "random.h"
 
@@ -316,4 +319,151 @@ TEST(Entropy_BitstreamWriter, write_symbol_with_update) {
                   rnd(gen));
     }
 }
+
+// scalar form of update_cdf(), as the decoder used to implement it
+static void update_cdf_ref(AomCdfProb *cdf, int val, int nsymbs) {
+    static const int nsymbs2speed[17] = {
+        0, 0, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2};
+    const int rate = 3 + (cdf[nsymbs] > 15) + (cdf[nsymbs] > 31) +
+                     nsymbs2speed[nsymbs];
+    int tmp = AOM_ICDF(0);
+    for (int i = 0; i < nsymbs - 1; ++i) {
+        tmp = (i == val) ? 0 : tmp;
+        if (tmp < cdf[i])
+            cdf[i] -= (AomCdfProb)((cdf[i] - tmp) >> rate);
+        else
+            cdf[i] += (AomCdfProb)((tmp - cdf[i]) >> rate);
+    }
+    cdf[nsymbs] += (cdf[nsymbs] < 32);
+}
+
+// uniform cdf of nsymbs symbols, followed by its counter
+static void init_uniform_cdf(AomCdfProb *cdf, int nsymbs) {
+    for (int i = 0; i < nsymbs; ++i)
+        cdf[i] = AOM_ICDF(CDF_PROB_TOP * (i + 1) / nsymbs);
+    cdf[nsymbs] = 0;
+}
+
+// draw a symbol in [0, nsymbs), skewed toward 0 as skew grows
+static int draw_symbol(std::mt19937 &gen, int nsymbs, double skew) {
+    std::geometric_distribution<int> geo(skew);
+    std::uniform_int_distribution<int> uni(0, nsymbs - 1);
+    return skew > 0 ? std::min(geo(gen), nsymbs - 1) : uni(gen);
+}
+
+TEST(Entropy_BitstreamWriter, update_cdf_match_reference) {
+    std::mt19937 gen(deterministic_seeds);
+    for (int nsymbs = 2; nsymbs <= 16; ++nsymbs) {
+        AomCdfProb cdf[CDF_SIZE(16)], ref[CDF_SIZE(16)];
+        init_uniform_cdf(cdf, nsymbs);
+        init_uniform_cdf(ref, nsymbs);
+        for (int i = 0; i < 200; ++i) {
+            const int val = draw_symbol(gen, nsymbs, i < 100 ? 0.3 : 0);
+            update_cdf(cdf, val, nsymbs);
+            update_cdf_ref(ref, val, nsymbs);
+            for (int j = 0; j <= nsymbs; ++j)
+                ASSERT_EQ(cdf[j], ref[j])
+                    << "nsymbs " << nsymbs << " update " << i << " index " << j;
+        }
+    }
+}
+
+// write then read symbols of every alphabet size, with cdf adaptation
+TEST(Entropy_BitstreamWriter, write_symbol_all_sizes) {
+    const int buffer_size = 16384;
+    uint8_t stream_buffer[buffer_size];
+    OutputBitstreamUnit output_bitstream_ptr;
+    output_bitstream_ptr.buffer_av1 = stream_buffer;
+    output_bitstream_ptr.buffer_begin_av1 = stream_buffer;
+    output_bitstream_ptr.size = buffer_size;
+
+    for (int allow_update = 0; allow_update <= 1; ++allow_update) {
+        AomCdfProb cdf[17][CDF_SIZE(16)];
+        AomWriter bw;
+        memset(&bw, 0, sizeof(bw));
+        bw.allow_update_cdf = allow_update;
+        for (int nsymbs = 2; nsymbs <= 16; ++nsymbs)
+            init_uniform_cdf(cdf[nsymbs], nsymbs);
+
+        std::mt19937 gen(deterministic_seeds);
+        aom_start_encode(&bw, &output_bitstream_ptr);
+        for (int i = 0; i < 300; ++i)
+            for (int nsymbs = 2; nsymbs <= 16; ++nsymbs)
+                aom_write_symbol(&bw,
+                                 draw_symbol(gen, nsymbs, (i & 1) ? 0.5 : 0),
+                                 cdf[nsymbs],
+                                 nsymbs);
+        aom_stop_encode(&bw);
+
+        for (int nsymbs = 2; nsymbs <= 16; ++nsymbs)
+            init_uniform_cdf(cdf[nsymbs], nsymbs);
+        gen.seed(deterministic_seeds);
+        SvtReader br;
+        memset(&br, 0, sizeof(br));
+        init_svt_reader(
+            &br, stream_buffer, stream_buffer + buffer_size, bw.pos, allow_update);
+        for (int i = 0; i < 300; ++i)
+            for (int nsymbs = 2; nsymbs <= 16; ++nsymbs)
+                ASSERT_EQ(svt_read_symbol(&br, cdf[nsymbs], nsymbs, nullptr),
+                          draw_symbol(gen, nsymbs, (i & 1) ? 0.5 : 0))
+                    << "nsymbs " << nsymbs << " symbol " << i;
+    }
+}
+
+// Time the symbol reader from low to high entropy streams, the rate of the
+// coefficient syntax elements going up with the bitrate.
+TEST(Entropy_BitstreamWriter, DISABLED_read_symbol_speed) {
+    const int num_symbols = 1 << 20;
+    const int buffer_size = num_symbols * 2;
+    std::vector<uint8_t> stream_buffer(buffer_size);
+    std::vector<uint8_t> symbols(num_symbols);
+    OutputBitstreamUnit output_bitstream_ptr;
+    output_bitstream_ptr.buffer_av1 = stream_buffer.data();
+    output_bitstream_ptr.buffer_begin_av1 = stream_buffer.data();
+    output_bitstream_ptr.size = buffer_size;
+    const double skews[] = {0.9, 0.6, 0.3, 0.1, 0};
+
+    for (const int nsymbs : {4, 8, 13, 16}) {
+        for (const double skew : skews) {
+            AomCdfProb cdf[CDF_SIZE(16)];
+            AomWriter bw;
+            memset(&bw, 0, sizeof(bw));
+            bw.allow_update_cdf = 1;
+            std::mt19937 gen(deterministic_seeds);
+            init_uniform_cdf(cdf, nsymbs);
+            aom_start_encode(&bw, &output_bitstream_ptr);
+            for (int i = 0; i < num_symbols; ++i) {
+                symbols[i] = draw_symbol(gen, nsymbs, skew);
+                aom_write_symbol(&bw, symbols[i], cdf, nsymbs);
+            }
+            aom_stop_encode(&bw);
+
+            uint64_t start_time_seconds, start_time_useconds;
+            uint64_t finish_time_seconds, finish_time_useconds;
+            SvtReader br;
+            memset(&br, 0, sizeof(br));
+            init_svt_reader(&br,
+                            stream_buffer.data(),
+                            stream_buffer.data() + buffer_size,
+                            bw.pos,
+                            1);
+            init_uniform_cdf(cdf, nsymbs);
+            svt_av1_get_time(&start_time_seconds, &start_time_useconds);
+            for (int i = 0; i < num_symbols; ++i)
+                ASSERT_EQ(svt_read_symbol(&br, cdf, nsymbs, nullptr),
+                          symbols[i]);
+            svt_av1_get_time(&finish_time_seconds, &finish_time_useconds);
+            const double time = svt_av1_compute_overall_elapsed_time_ms(
+                start_time_seconds,
+                start_time_useconds,
+                finish_time_seconds,
+                finish_time_useconds);
+            printf("nsymbs %2d skew %.1f: %6.3f bits/symbol, %7.2f Msymbols/s\n",
+                   nsymbs,
+                   skew,
+                   8.0 * bw.pos / num_symbols,
+                   num_symbols / time / 1000);
+        }
+    }
+}
 }  // namespace
@@ -19,6 +19,8 @@
  * * compute_cdef_dist_16bit_avx2
  * * copy_rect8_8bit_to_16bit_avx2
  * * svt_search_one_dual_avx2
+ * * svt_cdef_search_block_sums_avx2
+ * * svt_cdef_search_block_combine_avx2
  *
  * @author Cidana-Wenyao
  *
@@ -726,6 +728,217 @@ TEST(CdefToolTest, ComputeCdefDist8bitMatchTest) {
     }
 }
 
+/**
+ * @brief Unit test for svt_cdef_search_block_sums_avx2 and
+ * svt_cdef_search_block_combine_avx2
+ *
+ * Test strategy:
+ * Feed src blocks generated randomly, with the borders of the frame, compute
+ * the sums of all the strengths of a block and filter the block with each
+ * strength pair from them.
+ *
+ * Expect result:
+ * The sums and the outputs of the targeted functions should be identical
+ * with the ones of the reference functions, and the output of a pair should be
+ * the one of svt_cdef_filter_block_c.
+ *
+ * Test coverage:
+ * Test cases:
+ * bitdepth: 8, 10, 12
+ * BlockSize: {BLOCK_4X4, BLOCK_4X8, BLOCK_8X4, BLOCK_8X8}
+ * direction: [0, 7]
+ * primary_strength: [0, 15] << (bd - 8), adjusted by a random variance
+ * second_strength: 0, 1, 2, 4
+ * subsampling: 1, 2, 4 as capped by the search
+ *
+ */
+TEST(CdefToolTest, SearchBlockSumsMatchTest) {
+    const int size = 8;
+    const int ysize = size + 2 * CDEF_VBORDER;
+    DECLARE_ALIGNED(16, uint16_t, src_[ysize * CDEF_BSTRIDE]);
+    DECLARE_ALIGNED(16, int16_t, range_ref_[3 * 64]);
+    DECLARE_ALIGNED(16, int16_t, range_tst_[3 * 64]);
+    DECLARE_ALIGNED(16, int16_t, pri_ref_[15 * 64]);
+    DECLARE_ALIGNED(16, int16_t, pri_tst_[15 * 64]);
+    DECLARE_ALIGNED(16, int16_t, sec_ref_[3 * 64]);
+    DECLARE_ALIGNED(16, int16_t, sec_tst_[3 * 64]);
+    DECLARE_ALIGNED(16, uint16_t, dst_blk_[size * size]);
+    DECLARE_ALIGNED(16, uint16_t, dst_ref_[size * size]);
+    DECLARE_ALIGNED(16, uint16_t, dst_tst_[size * size]);
+    const BlockSize test_bs[] = {BLOCK_4X4, BLOCK_4X8, BLOCK_8X4, BLOCK_8X8};
+    const int max_subsampling[] = {1, 2, 2, 4};
+    SVTRandom rnd_(0, (1 << 16) - 1);
+
+    for (int bd = 8; bd <= 12; bd += 2) {
+        const int coeff_shift = bd - 8;
+        for (int k = 0; k < 8; ++k) {
+            const int level = rnd_.random() & ((1 << bd) - 1);
+            const int bits = 1 + rnd_.random() % bd;
+            const int boundary = k & 3 ? rnd_.random() & 15 : 0;
+            for (int i = 0; i < ysize * CDEF_BSTRIDE; i++)
+                src_[i] = clamp((rnd_.random() & ((1 << bits) - 1)) + level,
+                                0,
+                                (1 << bd) - 1);
+            for (int i = 0; i < ysize; i++) {
+                for (int j = 0; j < CDEF_BSTRIDE; j++) {
+                    if (((boundary & 1) && j < CDEF_HBORDER) ||
+                        ((boundary & 2) && j >= CDEF_HBORDER + size) ||
+                        ((boundary & 4) && i < CDEF_VBORDER) ||
+                        ((boundary & 8) && i >= CDEF_VBORDER + size))
+                        src_[i * CDEF_BSTRIDE + j] = CDEF_VERY_LARGE;
+                }
+            }
+            const uint16_t *in =
+                src_ + CDEF_HBORDER + CDEF_VBORDER * CDEF_BSTRIDE;
+            const int32_t var = rnd_.random() & 1023;
+            const int32_t damping = 3 + (rnd_.random() & 3) + coeff_shift;
+            int32_t pri_strengths[15], sec_strengths[3];
+            for (int s = 0; s < 15; s++)
+                pri_strengths[s] = k & 1 ? (s + 1) << coeff_shift
+                                         : svt_cdef_adjust_strength(
+                                               (s + 1) << coeff_shift, var);
+            for (int s = 0; s < 3; s++)
+                sec_strengths[s] = (1 << s) << coeff_shift;
+
+            for (int b = 0; b < 4; ++b) {
+                const int w = test_bs[b] == BLOCK_8X8 ||
+                                      test_bs[b] == BLOCK_8X4
+                                  ? 8
+                                  : 4;
+                const int h = test_bs[b] == BLOCK_8X8 ||
+                                      test_bs[b] == BLOCK_4X8
+                                  ? 8
+                                  : 4;
+                for (uint8_t subsampling = 1;
+                     subsampling <= max_subsampling[b];
+                     subsampling <<= 1) {
+                    const int n = h / subsampling * w;
+                    for (int dir = 0; dir < 8; ++dir) {
+                        svt_cdef_search_block_sums_c(in,
+                                                     dir,
+                                                     test_bs[b],
+                                                     subsampling,
+                                                     pri_strengths,
+                                                     15,
+                                                     damping,
+                                                     sec_strengths,
+                                                     3,
+                                                     damping,
+                                                     coeff_shift,
+                                                     range_ref_,
+                                                     pri_ref_,
+                                                     sec_ref_);
+                        svt_cdef_search_block_sums_avx2(in,
+                                                        dir,
+                                                        test_bs[b],
+                                                        subsampling,
+                                                        pri_strengths,
+                                                        15,
+                                                        damping,
+                                                        sec_strengths,
+                                                        3,
+                                                        damping,
+                                                        coeff_shift,
+                                                        range_tst_,
+                                                        pri_tst_,
+                                                        sec_tst_);
+                        for (int i = 0; i < n; i++) {
+                            for (int r = 0; r < 3; r++)
+                                ASSERT_EQ(range_ref_[r * 64 + i],
+                                          range_tst_[r * 64 + i])
+                                    << "range " << r << " pos " << i;
+                            for (int s = 0; s < 15; s++)
+                                ASSERT_EQ(pri_ref_[s * 64 + i],
+                                          pri_tst_[s * 64 + i])
+                                    << "primary " << s << " pos " << i;
+                            for (int s = 0; s < 3; s++)
+                                ASSERT_EQ(sec_ref_[s * 64 + i],
+                                          sec_tst_[s * 64 + i])
+                                    << "secondary " << s << " pos " << i;
+                        }
+
+                        for (int p = 0; p <= 15; p++) {
+                            for (int s = 0; s <= 3; s++) {
+                                const int16_t *pri_sum =
+                                    p ? pri_ref_ + (p - 1) * 64 : NULL;
+                                const int16_t *sec_sum =
+                                    s ? sec_ref_ + (s - 1) * 64 : NULL;
+                                svt_cdef_filter_block_c(
+                                    NULL,
+                                    dst_blk_,
+                                    w,
+                                    in,
+                                    p ? pri_strengths[p - 1] : 0,
+                                    s ? sec_strengths[s - 1] : 0,
+                                    dir,
+                                    damping,
+                                    damping,
+                                    test_bs[b],
+                                    coeff_shift,
+                                    subsampling);
+                                svt_cdef_search_block_combine_c(range_ref_,
+                                                                pri_sum,
+                                                                sec_sum,
+                                                                test_bs[b],
+                                                                subsampling,
+                                                                NULL,
+                                                                dst_ref_);
+                                svt_cdef_search_block_combine_avx2(
+                                    range_ref_,
+                                    pri_sum,
+                                    sec_sum,
+                                    test_bs[b],
+                                    subsampling,
+                                    NULL,
+                                    dst_tst_);
+                                for (int i = 0; i < h; i += subsampling) {
+                                    for (int j = 0; j < w; j++) {
+                                        ASSERT_EQ(dst_blk_[i * w + j],
+                                                  dst_ref_[i * w + j])
+                                            << "bitdepth: " << bd
+                                            << " size: " << test_bs[b]
+                                            << " dir: " << dir
+                                            << " strengths: " << p << ","
+                                            << s << " pos " << i << "," << j;
+                                        ASSERT_EQ(dst_ref_[i * w + j],
+                                                  dst_tst_[i * w + j])
+                                            << "bitdepth: " << bd
+                                            << " size: " << test_bs[b];
+                                    }
+                                }
+                                if (bd != 8)
+                                    continue;
+                                uint8_t dst8_ref[size * size];
+                                uint8_t dst8_tst[size * size];
+                                svt_cdef_search_block_combine_c(range_ref_,
+                                                                pri_sum,
+                                                                sec_sum,
+                                                                test_bs[b],
+                                                                subsampling,
+                                                                dst8_ref,
+                                                                NULL);
+                                svt_cdef_search_block_combine_avx2(
+                                    range_ref_,
+                                    pri_sum,
+                                    sec_sum,
+                                    test_bs[b],
+                                    subsampling,
+                                    dst8_tst,
+                                    NULL);
+                                for (int i = 0; i < h; i += subsampling) {
+                                    for (int j = 0; j < w; j++)
+                                        ASSERT_EQ(dst8_ref[i * w + j],
+                                                  dst8_tst[i * w + j]);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
 /**
  * @brief Unit test for svt_search_one_dual_avx2
  *
@@ -0,0 +1,224 @@
+/*
+ * Copyright(c) 2019 Netflix, Inc.
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file EncDecWavefrontTest.cc
+ *
+ * @brief Unit test of the SB wavefront of the EncDec segments:
+ * - enc_dec_segments_sb_ready
+ * - enc_dec_segments_park_sb_row
+ * - enc_dec_segments_sb_done
+ * - enc_dec_wavefront_queue_{add,post_row,take_row,remove}
+ *
+ ******************************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+// workaround to eliminate the compiling warning on linux
+// The macro will conflict with definition in gtest.h
+#ifdef __USE_GNU
+#undef __USE_GNU  // defined in EbThreads.h
+#endif
+#ifdef _GNU_SOURCE
+#undef _GNU_SOURCE  // defined in EbThreads.h
+#endif
+#include "EbEncDecSegments.h"
+#include "random.h"
+
+namespace {
+
+// Runs the EncDec threads over a picture of SBs the way the EncDec kernel
+// does, a task being an SB row to code from its first SB not coded yet
+class EncDecWavefrontTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        memset(&segments_, 0, sizeof(segments_));
+    }
+
+    void TearDown() override {
+        if (segments_.dctor)
+            segments_.dctor(&segments_);
+    }
+
+    void post_row(int32_t row) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(row);
+        cond_.notify_one();
+    }
+
+    void code_row(uint32_t row, svt_av1_test_tool::SVTRandom &rnd) {
+        for (uint32_t x = (uint32_t)segments_.sb_row_array[row].progress;
+             x < width_;
+             ++x) {
+            if (!enc_dec_segments_sb_ready(&segments_, x, row) &&
+                enc_dec_segments_park_sb_row(&segments_, row)) {
+                parks_++;
+                return;
+            }
+            // the left and top-right SBs are coded, this one is not
+            EXPECT_EQ(coded_[row * width_ + x].load(), 0);
+            if (x) {
+                EXPECT_EQ(coded_[row * width_ + x - 1].load(), 1);
+            }
+            if (row) {
+                EXPECT_EQ(
+                    coded_[(row - 1) * width_ + std::min(x + 1, width_ - 1)]
+                        .load(),
+                    1);
+            }
+            if (rnd.random() & 1)
+                std::this_thread::sleep_for(
+                    std::chrono::microseconds(rnd.random() & 63));
+            coded_[row * width_ + x] = 1;
+            const int32_t ready_row = enc_dec_segments_sb_done(&segments_, row);
+            if (ready_row >= 0)
+                post_row(ready_row);
+        }
+        rows_done_++;
+    }
+
+    void worker(int seed) {
+        svt_av1_test_tool::SVTRandom rnd(8, false);
+        rnd.reset(seed);
+        for (;;) {
+            int32_t row;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cond_.wait(lock, [this] {
+                    return !tasks_.empty() || rows_done_ == height_;
+                });
+                if (tasks_.empty())
+                    return;
+                row = tasks_.front();
+                tasks_.pop_front();
+            }
+            code_row((uint32_t)row, rnd);
+            if (rows_done_ == height_) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                cond_.notify_all();
+            }
+        }
+    }
+
+    void run(uint32_t width, uint32_t height, int num_threads) {
+        width_ = width;
+        height_ = height;
+        ASSERT_EQ(enc_dec_segments_ctor(&segments_, width, height),
+                  EB_ErrorNone);
+        for (int pic = 0; pic < 4; pic++) {
+            enc_dec_segments_init(&segments_, width, height, width, height);
+            ASSERT_TRUE(segments_.sb_wavefront);
+            coded_ = std::vector<std::atomic<int>>(width * height);
+            rows_done_ = 0;
+            post_row(0);
+            std::vector<std::thread> threads;
+            for (int t = 0; t < num_threads; t++)
+                threads.emplace_back(&EncDecWavefrontTest::worker, this,
+                                     pic * num_threads + t);
+            for (auto &t : threads)
+                t.join();
+            ASSERT_TRUE(tasks_.empty());
+            for (uint32_t i = 0; i < width * height; i++)
+                ASSERT_EQ(coded_[i].load(), 1) << "sb " << i;
+        }
+    }
+
+    EncDecSegments segments_;
+    uint32_t width_;
+    uint32_t height_;
+    std::vector<std::atomic<int>> coded_;
+    std::atomic<uint32_t> rows_done_;
+    std::atomic<int> parks_{0};
+    std::deque<int32_t> tasks_;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+};
+
+TEST_F(EncDecWavefrontTest, CodesEachSbAfterItsNeighbors) {
+    run(30, 17, 8);
+}
+
+TEST_F(EncDecWavefrontTest, SingleColumn) {
+    run(1, 9, 4);
+}
+
+TEST_F(EncDecWavefrontTest, SingleThread) {
+    run(12, 7, 1);
+    // a single thread codes the rows one after the other
+    EXPECT_EQ(parks_.load(), 0);
+}
+
+TEST_F(EncDecWavefrontTest, CoarseSegmentsKeepSegmentScheduling) {
+    ASSERT_EQ(enc_dec_segments_ctor(&segments_, 30, 17), EB_ErrorNone);
+    enc_dec_segments_init(&segments_, 15, 17, 30, 17);
+    EXPECT_FALSE(segments_.sb_wavefront);
+    enc_dec_segments_init(&segments_, 30, 16, 30, 17);
+    EXPECT_FALSE(segments_.sb_wavefront);
+    enc_dec_segments_init(&segments_, 30, 17, 30, 17);
+    EXPECT_TRUE(segments_.sb_wavefront);
+}
+
+// the pending rows are taken from the oldest picture first, lowest row first
+TEST(EncDecWavefrontQueueTest, TakesOldestPictureFirst) {
+    EncDecSegments segments[3];
+    EncDecWavefrontQueue queue;
+    memset(segments, 0, sizeof(segments));
+    queue.mutex = svt_create_mutex();
+    queue.head = NULL;
+    for (int i = 0; i < 3; i++) {
+        ASSERT_EQ(enc_dec_segments_ctor(&segments[i], 8, 6), EB_ErrorNone);
+        enc_dec_segments_init(&segments[i], 8, 6, 8, 6);
+    }
+    // picture 1 comes first in decode order
+    enc_dec_wavefront_queue_add(&queue, &segments[0], NULL, 7, 0);
+    enc_dec_wavefront_queue_add(&queue, &segments[1], NULL, 3, 0);
+    uint32_t row = 99;
+    EXPECT_EQ(enc_dec_wavefront_queue_take_row(&queue, &row), &segments[1]);
+    EXPECT_EQ(row, 0u);
+    // a later picture in decode order goes after it
+    enc_dec_wavefront_queue_add(&queue, &segments[2], NULL, 5, 1);
+    EXPECT_EQ(segments[2].tile_group_index, 1);
+    enc_dec_wavefront_queue_post_row(&queue, &segments[0], 3);
+    enc_dec_wavefront_queue_post_row(&queue, &segments[1], 4);
+    enc_dec_wavefront_queue_post_row(&queue, &segments[1], 2);
+    const struct {
+        EncDecSegments *segments;
+        uint32_t row;
+    } expected[] = {{&segments[1], 2},
+                    {&segments[1], 4},
+                    {&segments[2], 0},
+                    {&segments[0], 0},
+                    {&segments[0], 3}};
+    for (const auto &e : expected) {
+        EXPECT_EQ(enc_dec_wavefront_queue_take_row(&queue, &row), e.segments);
+        EXPECT_EQ(row, e.row);
+    }
+    EXPECT_EQ(enc_dec_wavefront_queue_take_row(&queue, &row), nullptr);
+    // a picture done leaves the queue
+    enc_dec_wavefront_queue_remove(&queue, &segments[1]);
+    enc_dec_wavefront_queue_post_row(&queue, &segments[2], 1);
+    enc_dec_wavefront_queue_post_row(&queue, &segments[0], 1);
+    EXPECT_EQ(enc_dec_wavefront_queue_take_row(&queue, &row), &segments[2]);
+    EXPECT_EQ(queue.head, &segments[2]);
+    EXPECT_EQ(segments[2].next_wavefront, &segments[0]);
+    for (int i = 0; i < 3; i++)
+        segments[i].dctor(&segments[i]);
+    svt_destroy_mutex(queue.mutex);
+}
+
+}  // namespace
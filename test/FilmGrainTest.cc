@@ -11,6 +11,8 @@
  * https://www.aomedia.org/license/patent-license.
  */
 #include <stdlib.h>
+#include <string.h>
+#include <vector>
 
 // workaround to eliminate the compiling warning on linux
 // The macro will conflict with definition in gtest.h
@@ -28,6 +30,10 @@
 #include "acm_random.h"
 #include "noise_model.h"
 #include "aom_dsp_rtcd.h"
+#include "EbTime.h"
+
+/** setup_test_env is implemented in test/TestEnv.c */
+extern "C" void setup_test_env();
 
 static AomFilmGrain film_grain_test_vectors[3] = {
     /* Test 1 */
@@ -206,6 +212,7 @@ class AddFilmGrainTest : public ::testing::Test {
     static const int chroma_size = luma_size >> 2;
 
     void SetUp() override {
+        setup_test_env();
         luma_ = (uint8_t *)svt_aom_malloc(luma_size);
         cb_ = (uint8_t *)svt_aom_malloc(chroma_size);
         cr_ = (uint8_t *)svt_aom_malloc(chroma_size);
@@ -262,12 +269,221 @@ TEST_F(AddFilmGrainTest, MatchTest) {
                                    kWidth / 2, /* chroma stride */
                                    0,
                                    1,
-                                   1);
+                                   1,
+                                   nullptr);
         check_output(i);
         EXPECT_FALSE(HasFailure());
     }
 }
 
+// the picture is split in stripes of 32 luma rows over the threads, the
+// output must not depend on the number of threads
+class AddFilmGrainThreadTest : public ::testing::Test {
+  public:
+    static const int kWidth = 250;
+    static const int kHeight = 182;
+
+    void SetUp() override {
+        setup_test_env();
+        rnd_.Reset(libaom_test::ACMRandom::DeterministicSeed());
+    }
+
+  protected:
+    template <typename Sample>
+    void run(AomFilmGrain *params, int subsamp_y, int subsamp_x) {
+        const int use_high_bit_depth = sizeof(Sample) > 1;
+        const int chroma_width = (kWidth + subsamp_x) >> subsamp_x;
+        const int chroma_height = (kHeight + subsamp_y) >> subsamp_y;
+        const int luma_size = kWidth * kHeight;
+        const int chroma_size = chroma_width * chroma_height;
+        const int max_value = (1 << params->bit_depth) - 1;
+        std::vector<Sample> ref(luma_size + 2 * chroma_size);
+        for (size_t i = 0; i < ref.size(); i++)
+            ref[i] = (Sample)(rnd_.Rand16() & max_value);
+
+        std::vector<Sample> out[4];
+        for (int t = 0; t < 4; t++) {
+            const int num_threads = t == 3 ? 16 : t + 1;
+            SvtJobPool *job_pool = svt_job_pool_create(num_threads - 1);
+            out[t] = ref;
+            Sample *luma = out[t].data();
+            svt_av1_add_film_grain_run(params,
+                                       (uint8_t *)luma,
+                                       (uint8_t *)(luma + luma_size),
+                                       (uint8_t *)(luma + luma_size + chroma_size),
+                                       kHeight,
+                                       kWidth,
+                                       kWidth,
+                                       chroma_width,
+                                       use_high_bit_depth,
+                                       subsamp_y,
+                                       subsamp_x,
+                                       job_pool);
+            svt_job_pool_destroy(job_pool);
+        }
+        EXPECT_NE(out[0], ref);
+        for (int t = 1; t < 4; t++)
+            EXPECT_EQ(out[0], out[t]) << "thread config " << t;
+    }
+
+    libaom_test::ACMRandom rnd_;
+};
+
+TEST_F(AddFilmGrainThreadTest, MatchSingleThread) {
+    for (int i = 0; i < 3; ++i) {
+        AomFilmGrain params = film_grain_test_vectors[i];
+        for (int overlap = 0; overlap < 2; overlap++) {
+            params.overlap_flag = overlap;
+            params.bit_depth = 8;
+            run<uint8_t>(&params, 1, 1);
+            run<uint8_t>(&params, 0, 0);
+            params.bit_depth = 10;
+            run<uint16_t>(&params, 1, 1);
+            run<uint16_t>(&params, 0, 1);
+        }
+    }
+}
+
+#ifdef ARCH_X86_64
+// the rows of noise added by the kernels match the C ones
+class FilmGrainNoiseRowTest : public ::testing::Test {
+  public:
+    static const int kMaxWidth = 80;
+
+    void SetUp() override {
+        setup_test_env();
+        rnd_.Reset(libaom_test::ACMRandom::DeterministicSeed());
+    }
+
+  protected:
+    void init(int bit_depth) {
+        const int lut_size = 256 << (bit_depth - 8);
+        const int grain_max = (128 << (bit_depth - 8)) - 1;
+        lut_.resize(lut_size);
+        for (int i = 0; i < lut_size; i++) lut_[i] = rnd_.Rand8();
+        for (int i = 0; i < kMaxWidth; i++)
+            grain_[i] = (int32_t)(rnd_.Rand16() % (2 * grain_max + 1)) - grain_max;
+    }
+
+    template <typename Sample>
+    void fill(Sample *p, int n, int bit_depth) {
+        for (int i = 0; i < n; i++)
+            p[i] = (Sample)(rnd_.Rand16() & ((1 << bit_depth) - 1));
+    }
+
+    void check_luma() {
+        for (int iter = 0; iter < 20; iter++) {
+            init(8);
+            for (int width = 1; width <= kMaxWidth; width++) {
+                uint8_t luma_c[kMaxWidth], luma_avx2[kMaxWidth];
+                fill(luma_c, width, 8);
+                memcpy(luma_avx2, luma_c, sizeof(luma_c));
+                const int min_value = iter & 1 ? 16 : 0;
+                const int max_value = iter & 1 ? 235 : 255;
+                const int shift = 8 + (iter & 3);
+                svt_av1_fgn_add_luma_noise_row_c(
+                    luma_c, grain_, lut_.data(), width, shift, min_value, max_value);
+                svt_av1_fgn_add_luma_noise_row_avx2(
+                    luma_avx2, grain_, lut_.data(), width, shift, min_value, max_value);
+                ASSERT_EQ(0, memcmp(luma_c, luma_avx2, width)) << "width " << width;
+            }
+        }
+    }
+
+    void check_luma_hbd(int bit_depth) {
+        for (int iter = 0; iter < 20; iter++) {
+            init(bit_depth);
+            for (int width = 1; width <= kMaxWidth; width++) {
+                uint16_t luma_c[kMaxWidth], luma_avx2[kMaxWidth];
+                fill(luma_c, width, bit_depth);
+                memcpy(luma_avx2, luma_c, sizeof(luma_c));
+                const int min_value = iter & 1 ? 16 << (bit_depth - 8) : 0;
+                const int max_value = iter & 1 ? 235 << (bit_depth - 8)
+                                               : (1 << bit_depth) - 1;
+                const int shift = 8 + (iter & 3);
+                svt_av1_fgn_add_luma_noise_row_hbd_c(
+                    luma_c, grain_, lut_.data(), width, shift, min_value, max_value);
+                svt_av1_fgn_add_luma_noise_row_hbd_avx2(
+                    luma_avx2, grain_, lut_.data(), width, shift, min_value, max_value);
+                ASSERT_EQ(0, memcmp(luma_c, luma_avx2, width * sizeof(uint16_t)))
+                    << "width " << width;
+            }
+        }
+    }
+
+    void check_chroma(int subsamp_x) {
+        for (int iter = 0; iter < 20; iter++) {
+            init(8);
+            const int luma_mult = iter & 1 ? 64 : (int)rnd_.Rand8() - 128;
+            const int mult = iter & 1 ? 0 : (int)rnd_.Rand8() - 128;
+            const int offset = iter & 1 ? 0 : (int)(rnd_.Rand16() & 511) - 256;
+            for (int width = 1; width <= kMaxWidth / 2; width++) {
+                uint8_t luma[kMaxWidth], chroma_c[kMaxWidth], chroma_avx2[kMaxWidth];
+                fill(luma, kMaxWidth, 8);
+                fill(chroma_c, width, 8);
+                memcpy(chroma_avx2, chroma_c, sizeof(chroma_c));
+                svt_av1_fgn_add_chroma_noise_row_c(chroma_c, luma, subsamp_x, grain_,
+                                                   lut_.data(), width, luma_mult, mult,
+                                                   offset, 255, 10, 16, 240);
+                svt_av1_fgn_add_chroma_noise_row_avx2(chroma_avx2, luma, subsamp_x, grain_,
+                                                      lut_.data(), width, luma_mult, mult,
+                                                      offset, 255, 10, 16, 240);
+                ASSERT_EQ(0, memcmp(chroma_c, chroma_avx2, width)) << "width " << width;
+            }
+        }
+    }
+
+    void check_chroma_hbd(int subsamp_x, int bit_depth) {
+        const int max_index = (256 << (bit_depth - 8)) - 1;
+        for (int iter = 0; iter < 20; iter++) {
+            init(bit_depth);
+            const int luma_mult = iter & 1 ? 64 : (int)rnd_.Rand8() - 128;
+            const int mult = iter & 1 ? 0 : (int)rnd_.Rand8() - 128;
+            const int offset = iter & 1
+                ? 0
+                : ((int)(rnd_.Rand16() & 511) << (bit_depth - 8)) - (1 << bit_depth);
+            for (int width = 1; width <= kMaxWidth / 2; width++) {
+                uint16_t luma[kMaxWidth], chroma_c[kMaxWidth], chroma_avx2[kMaxWidth];
+                fill(luma, kMaxWidth, bit_depth);
+                fill(chroma_c, width, bit_depth);
+                memcpy(chroma_avx2, chroma_c, sizeof(chroma_c));
+                svt_av1_fgn_add_chroma_noise_row_hbd_c(chroma_c, luma, subsamp_x, grain_,
+                                                       lut_.data(), width, luma_mult, mult,
+                                                       offset, max_index, 11, 0, max_index);
+                svt_av1_fgn_add_chroma_noise_row_hbd_avx2(chroma_avx2, luma, subsamp_x,
+                                                          grain_, lut_.data(), width,
+                                                          luma_mult, mult, offset,
+                                                          max_index, 11, 0, max_index);
+                ASSERT_EQ(0, memcmp(chroma_c, chroma_avx2, width * sizeof(uint16_t)))
+                    << "width " << width;
+            }
+        }
+    }
+
+    libaom_test::ACMRandom rnd_;
+    std::vector<int32_t> lut_;
+    int32_t grain_[kMaxWidth];
+};
+
+TEST_F(FilmGrainNoiseRowTest, LumaAVX2) {
+    if (!(get_cpu_flags_to_use() & CPU_FLAGS_AVX2))
+        return;
+    check_luma();
+    check_luma_hbd(10);
+    check_luma_hbd(12);
+}
+
+TEST_F(FilmGrainNoiseRowTest, ChromaAVX2) {
+    if (!(get_cpu_flags_to_use() & CPU_FLAGS_AVX2))
+        return;
+    for (int subsamp_x = 0; subsamp_x < 2; subsamp_x++) {
+        check_chroma(subsamp_x);
+        check_chroma_hbd(subsamp_x, 10);
+        check_chroma_hbd(subsamp_x, 12);
+    }
+}
+#endif
+
 extern "C" {
 #include "EbPictureControlSet.h"
 #include "EbPictureBufferDesc.h"
@@ -391,6 +607,8 @@ class DenoiseModelRunTest : public ::testing::Test {
         fg_init_data.stride_y = width_;
         fg_init_data.stride_cb = fg_init_data.stride_cr =
             fg_init_data.stride_y >> subsampling_x_;
+        fg_init_data.denoise_apply = 0;
+        fg_init_data.job_pool = nullptr;
 
         memset(&noise_model, 0, sizeof(noise_model));
         err = denoise_and_model_ctor(&noise_model, &fg_init_data);
@@ -462,3 +680,60 @@ TEST_F(DenoiseModelRunTest, OutputFilmGrainCheck) {
     check_filmgrain();
     EXPECT_FALSE(HasFailure());
 }
+
+// the block rows and the planes split over threads give the single thread
+// denoised planes and grain parameters
+TEST_F(DenoiseModelRunTest, MultiThreadMatchSingleThread) {
+    const size_t plane_size[3] = {width_ * height_,
+                                  (width_ >> 1) * (height_ >> 1),
+                                  (width_ >> 1) * (height_ >> 1)};
+    std::vector<uint8_t> denoised[3];
+    run_test();
+    AomFilmGrain single_thread_grain = output_film_grain;
+    for (int c = 0; c < 3; ++c)
+        denoised[c].assign(noise_model.denoised[c],
+                           noise_model.denoised[c] + plane_size[c]);
+
+    for (int num_threads = 2; num_threads <= 5; num_threads += 3) {
+        random_.Reset(100171);
+        memset(&output_film_grain, 0, sizeof(output_film_grain));
+        noise_model.job_pool = svt_job_pool_create(num_threads - 1);
+        run_test();
+        svt_job_pool_destroy(noise_model.job_pool);
+        noise_model.job_pool = nullptr;
+        EXPECT_EQ(film_grain_params_equal(&output_film_grain,
+                                          &single_thread_grain),
+                  1)
+            << "threads " << num_threads;
+        for (int c = 0; c < 3; ++c)
+            EXPECT_EQ(memcmp(denoised[c].data(),
+                             noise_model.denoised[c],
+                             plane_size[c]),
+                      0)
+                << "threads " << num_threads << " plane " << c;
+    }
+    check_filmgrain();
+}
+
+TEST_F(DenoiseModelRunTest, DISABLED_ThreadSpeed) {
+    const int num_loop = 20;
+    double time[2];
+    for (int i = 0; i < 2; ++i) {
+        uint64_t start_seconds, start_useconds;
+        uint64_t finish_seconds, finish_useconds;
+        noise_model.job_pool = i ? svt_job_pool_create(3) : nullptr;
+        svt_av1_get_time(&start_seconds, &start_useconds);
+        for (int loop = 0; loop < num_loop; ++loop)
+            run_test();
+        svt_av1_get_time(&finish_seconds, &finish_useconds);
+        time[i] = svt_av1_compute_overall_elapsed_time_ms(
+            start_seconds, start_useconds, finish_seconds, finish_useconds);
+        svt_job_pool_destroy(noise_model.job_pool);
+        noise_model.job_pool = nullptr;
+    }
+    printf("Average Milliseconds per Picture\n");
+    printf("    1 thread  : %6.2f\n", time[0] / num_loop);
+    printf("    4 threads : %6.2f   (Comparison: %5.2fx)\n",
+           time[1] / num_loop,
+           time[0] / time[1]);
+}
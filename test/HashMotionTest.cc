@@ -0,0 +1,252 @@
+/*
+ * Copyright(c) 2019 Netflix, Inc.
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file HashMotionTest.cc
+ *
+ * @brief Unit test of the block hashes used by the hash based motion search:
+ * - svt_av1_get_b64_hash_values
+ * - svt_av1_build_hash_table
+ * - svt_av1_get_crc_value_sliced
+ * - svt_av1_block_2x2_hash_row_{c,avx2}
+ * - svt_av1_block_hash_row_{c,avx2}
+ *
+ ******************************************************************************/
+
+#include <string.h>
+#include "gtest/gtest.h"
+// workaround to eliminate the compiling warning on linux
+// The macro will conflict with definition in gtest.h
+#ifdef __USE_GNU
+#undef __USE_GNU  // defined in EbThreads.h
+#endif
+#ifdef _GNU_SOURCE
+#undef _GNU_SOURCE  // defined in EbThreads.h
+#endif
+extern "C" {
+#include "vector.h"  // no C++ guards of its own
+}
+#include "hash_motion.h"
+#include "aom_dsp_rtcd.h"
+#include "random.h"
+
+/** setup_test_env is implemented in test/TestEnv.c */
+extern "C" void setup_test_env();
+
+namespace {
+
+static const int kPicWidth = 192;
+static const int kPicHeight = 128;
+
+class HashMotionTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        setup_test_env();
+        svt_av1_crc_calculator_init(&crc1_, 24, 0x5D6DCB);
+        svt_av1_crc_calculator_init(&crc2_, 24, 0x864CFB);
+        memset(&table_, 0, sizeof(table_));
+        memset(&pic_, 0, sizeof(pic_));
+        pic_.y_buffer = pixels_;
+        pic_.y_stride = kPicWidth;
+        pic_.y_crop_width = kPicWidth;
+        pic_.y_crop_height = kPicHeight;
+    }
+
+    void TearDown() override {
+        svt_av1_hash_table_destroy(&table_);
+    }
+
+    // true when the table holds the block of size at (x, y) under the hashes
+    bool find_block(uint32_t hash_value1, uint32_t hash_value2, int x,
+                    int y) {
+        const int count = svt_av1_hash_table_count(&table_, hash_value1);
+        if (!count)
+            return false;
+        Iterator it = svt_av1_hash_get_first_iterator(&table_, hash_value1);
+        for (int i = 0; i < count; i++, iterator_increment(&it)) {
+            const BlockHash *bh = (const BlockHash *)iterator_get(&it);
+            if (bh->x == x && bh->y == y && bh->hash_value2 == hash_value2)
+                return true;
+        }
+        return false;
+    }
+
+    // checks the hashes of the 64x64 area at (x0, y0) against the table
+    void check_b64(int x0, int y0) {
+        uint32_t hash_value1[HASH_B64_BLOCK_COUNT];
+        uint32_t hash_value2[HASH_B64_BLOCK_COUNT];
+        svt_av1_get_b64_hash_values(pixels_ + y0 * kPicWidth + x0,
+                                    kPicWidth,
+                                    &crc1_,
+                                    &crc2_,
+                                    hash_value1,
+                                    hash_value2);
+        static const int offset[] = {HASH_B64_8X8_OFFSET,
+                                     HASH_B64_16X16_OFFSET,
+                                     HASH_B64_32X32_OFFSET,
+                                     HASH_B64_64X64_OFFSET};
+        for (int level = 0, size = 8; size <= 64; level++, size <<= 1) {
+            const int count = 64 / size;
+            for (int y = 0; y < count; y++) {
+                for (int x = 0; x < count; x++) {
+                    const int idx = offset[level] + y * count + x;
+                    EXPECT_TRUE(find_block(hash_value1[idx],
+                                           hash_value2[idx],
+                                           x0 + x * size,
+                                           y0 + y * size))
+                        << "block " << size << "x" << size << " at ("
+                        << x0 + x * size << ", " << y0 + y * size << ")";
+                }
+            }
+        }
+    }
+
+    CRC_CALCULATOR crc1_;
+    CRC_CALCULATOR crc2_;
+    HashTable table_;
+    Yv12BufferConfig pic_;
+    uint8_t pixels_[kPicWidth * kPicHeight];
+};
+
+TEST_F(HashMotionTest, MatchesPictureTable) {
+    svt_av1_test_tool::SVTRandom rnd(8, false);
+    for (int i = 0; i < kPicWidth * kPicHeight; i++)
+        pixels_[i] = (uint8_t)rnd.random();
+    // flat and repeated areas, as found in screen content
+    for (int y = 64; y < kPicHeight; y++) {
+        memset(pixels_ + y * kPicWidth, 200, 64);
+        memcpy(pixels_ + y * kPicWidth + 64, pixels_ + (y - 64) * kPicWidth + 7, 64);
+    }
+
+    ASSERT_EQ(rtime_alloc_svt_av1_hash_table_create(&table_), EB_ErrorNone);
+    ASSERT_EQ(svt_av1_build_hash_table(&table_, &pic_, 8, 64, &crc1_, &crc2_),
+              EB_ErrorNone);
+    for (int y0 = 0; y0 + 64 <= kPicHeight; y0 += 64)
+        for (int x0 = 0; x0 + 64 <= kPicWidth; x0 += 64)
+            check_b64(x0, y0);
+
+    // the copied area is found at its source position
+    uint32_t hash_value1[HASH_B64_BLOCK_COUNT];
+    uint32_t hash_value2[HASH_B64_BLOCK_COUNT];
+    svt_av1_get_b64_hash_values(pixels_ + 64 * kPicWidth + 64,
+                                kPicWidth,
+                                &crc1_,
+                                &crc2_,
+                                hash_value1,
+                                hash_value2);
+    EXPECT_TRUE(find_block(hash_value1[HASH_B64_64X64_OFFSET],
+                           hash_value2[HASH_B64_64X64_OFFSET],
+                           7,
+                           0));
+}
+
+TEST_F(HashMotionTest, SlicedCrcMatchesSerial) {
+    svt_av1_test_tool::SVTRandom rnd(8, false);
+    uint8_t msg[CRC_SLICE_MAX_LENGTH];
+    for (int iter = 0; iter < 1000; iter++) {
+        for (int i = 0; i < CRC_SLICE_MAX_LENGTH; i++)
+            msg[i] = (uint8_t)rnd.random();
+        for (int length = 1; length <= CRC_SLICE_MAX_LENGTH; length++) {
+            ASSERT_EQ(svt_av1_get_crc_value_sliced(&crc1_, msg, length),
+                      svt_av1_get_crc_value(&crc1_, msg, length));
+            ASSERT_EQ(svt_av1_get_crc_value_sliced(&crc2_, msg, length),
+                      svt_av1_get_crc_value(&crc2_, msg, length));
+        }
+    }
+}
+
+typedef void (*Block2x2HashRowFunc)(const uint8_t *src, int stride, int count,
+                                    const CRC_CALCULATOR *crc_calculator1,
+                                    const CRC_CALCULATOR *crc_calculator2,
+                                    uint32_t *hash_value1, uint32_t *hash_value2);
+typedef void (*BlockHashRowFunc)(const uint32_t *src_hash1,
+                                 const uint32_t *src_hash2, int src_size,
+                                 int pic_width, int count,
+                                 const CRC_CALCULATOR *crc_calculator1,
+                                 const CRC_CALCULATOR *crc_calculator2,
+                                 uint32_t *dst_hash1, uint32_t *dst_hash2);
+
+// the row kernels give the hashes of the byte by byte crc of the messages
+class HashRowTest : public HashMotionTest {
+  protected:
+    void check_2x2_row(Block2x2HashRowFunc func) {
+        svt_av1_test_tool::SVTRandom rnd(8, false);
+        for (int i = 0; i < kPicWidth * kPicHeight; i++)
+            pixels_[i] = (uint8_t)rnd.random();
+        uint32_t hash1[kPicWidth], hash2[kPicWidth];
+        for (int count = 1; count < kPicWidth; count += 13) {
+            func(pixels_, kPicWidth, count, &crc1_, &crc2_, hash1, hash2);
+            for (int x = 0; x < count; x++) {
+                uint8_t p[4] = {pixels_[x],
+                                pixels_[x + 1],
+                                pixels_[kPicWidth + x],
+                                pixels_[kPicWidth + x + 1]};
+                ASSERT_EQ(hash1[x], svt_av1_get_crc_value(&crc1_, p, 4))
+                    << "count " << count << " x " << x;
+                ASSERT_EQ(hash2[x], svt_av1_get_crc_value(&crc2_, p, 4))
+                    << "count " << count << " x " << x;
+            }
+        }
+    }
+
+    void check_row(BlockHashRowFunc func) {
+        // 24 bit crcs, as stored in the level hashes
+        svt_av1_test_tool::SVTRandom rnd(24, false);
+        static uint32_t src[2][kPicWidth * 64];
+        for (int c = 0; c < 2; c++)
+            for (int i = 0; i < kPicWidth * 64; i++)
+                src[c][i] = (uint32_t)rnd.random();
+        uint32_t dst1[kPicWidth], dst2[kPicWidth];
+        for (int src_size = 2; src_size <= 32; src_size <<= 1) {
+            const int count = kPicWidth - 2 * src_size + 1;
+            func(src[0], src[1], src_size, kPicWidth, count, &crc1_, &crc2_, dst1, dst2);
+            for (int x = 0; x < count; x++) {
+                for (int c = 0; c < 2; c++) {
+                    const uint32_t *s = src[c] + x;
+                    uint32_t p[4] = {s[0],
+                                     s[src_size],
+                                     s[src_size * kPicWidth],
+                                     s[src_size * kPicWidth + src_size]};
+                    ASSERT_EQ(c ? dst2[x] : dst1[x],
+                              svt_av1_get_crc_value(c ? &crc2_ : &crc1_,
+                                                    (uint8_t *)p,
+                                                    sizeof(p)))
+                        << "size " << src_size << " x " << x;
+                }
+            }
+        }
+    }
+};
+
+TEST_F(HashRowTest, Block2x2HashRowC) {
+    check_2x2_row(svt_av1_block_2x2_hash_row_c);
+}
+
+TEST_F(HashRowTest, BlockHashRowC) {
+    check_row(svt_av1_block_hash_row_c);
+}
+
+#ifdef ARCH_X86_64
+TEST_F(HashRowTest, Block2x2HashRowAVX2) {
+    if (!(get_cpu_flags_to_use() & CPU_FLAGS_AVX2))
+        return;
+    check_2x2_row(svt_av1_block_2x2_hash_row_avx2);
+}
+
+TEST_F(HashRowTest, BlockHashRowAVX2) {
+    if (!(get_cpu_flags_to_use() & CPU_FLAGS_AVX2))
+        return;
+    check_row(svt_av1_block_hash_row_avx2);
+}
+#endif
+
+}  // namespace
@@ -0,0 +1,348 @@
+/*
+ * Copyright(c) 2019 Netflix, Inc.
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file HpelCacheTest.cc
+ *
+ * @brief Unit test of the half-pel plane cache of the TF sub-pel searches:
+ * - svt_hpel_cache_reset
+ * - svt_hpel_cache_get against the regular prediction of the blocks
+ * and of the sub-pel reference planes:
+ * - svt_subpel_ref_planes_build
+ * - svt_subpel_ref_planes_get against the regular prediction of the blocks
+ *
+ ******************************************************************************/
+
+#include <string.h>
+#include <vector>
+#include "gtest/gtest.h"
+// workaround to eliminate the compiling warning on linux
+// The macro will conflict with definition in gtest.h
+#ifdef __USE_GNU
+#undef __USE_GNU  // defined in EbThreads.h
+#endif
+#ifdef _GNU_SOURCE
+#undef _GNU_SOURCE  // defined in EbThreads.h
+#endif
+#include "EbHpelCache.h"
+#include "random.h"
+
+/** setup_test_env is implemented in test/TestEnv.c */
+extern "C" void setup_test_env();
+/** the convolution tables of the predictions, set up by the encoder handle */
+extern "C" void asm_set_convolve_asm_table(void);
+extern "C" void asm_set_convolve_hbd_asm_table(void);
+
+namespace {
+
+static const int kPicWidth = 216;
+static const int kPicHeight = 152;
+static const int kPadding = 40;
+static const int kStride = kPicWidth + 2 * kPadding;
+
+class HpelCacheTest : public ::testing::TestWithParam<int> {
+  protected:
+    void SetUp() override {
+        setup_test_env();
+        asm_set_convolve_asm_table();
+        asm_set_convolve_hbd_asm_table();
+        bit_depth_ = (uint8_t)GetParam();
+        memset(&sf_, 0, sizeof(sf_));
+        memset(&pic_, 0, sizeof(pic_));
+        pixels_.resize(kStride * (kPicHeight + 2 * kPadding));
+        pixels16_.resize(pixels_.size());
+        svt_av1_test_tool::SVTRandom rnd(bit_depth_, false);
+        for (size_t i = 0; i < pixels_.size(); i++) {
+            pixels16_[i] = (uint16_t)rnd.random();
+            pixels_[i] = (uint8_t)pixels16_[i];
+        }
+        pic_.buffer_y = pixels_.data();
+        pic_.stride_y = kStride;
+        pic_.origin_x = kPadding;
+        pic_.origin_y = kPadding;
+        pic_.origin_bot_y = kPadding;
+        pic_.width = kPicWidth;
+        pic_.height = kPicHeight;
+        ASSERT_EQ(svt_hpel_cache_ctor(&cache_), EB_ErrorNone);
+    }
+
+    void TearDown() override {
+        svt_hpel_cache_dctor(&cache_);
+    }
+
+    void reset(int block_x, int block_y) {
+        svt_hpel_cache_reset(&cache_,
+                             &sf_,
+                             &pic_,
+                             bit_depth_ > 8 ? pixels16_.data() : NULL,
+                             bit_depth_,
+                             block_x,
+                             block_y,
+                             64);
+    }
+
+    // the regular prediction of the block
+    void predict(int x, int y, MV mv, int bw, int bh, uint16_t *dst) {
+        SubpelParams subpel_params;
+        subpel_params.xs = SCALE_SUBPEL_SHIFTS;
+        subpel_params.ys = SCALE_SUBPEL_SHIFTS;
+        subpel_params.subpel_x = ((mv.col * 2) & SUBPEL_MASK)
+                                 << SCALE_EXTRA_BITS;
+        subpel_params.subpel_y = ((mv.row * 2) & SUBPEL_MASK)
+                                 << SCALE_EXTRA_BITS;
+        ConvolveParams conv_params =
+            get_conv_params_no_round(0, 0, 0, NULL, 0, 0, bit_depth_);
+        const InterpFilters filters =
+            av1_make_interp_filters(EIGHTTAP_REGULAR, EIGHTTAP_REGULAR);
+        const int offset = (kPadding + y + (mv.row >> 3)) * kStride +
+                           kPadding + x + (mv.col >> 3);
+        if (bit_depth_ > 8) {
+            svt_highbd_inter_predictor(pixels16_.data() + offset,
+                                       kStride,
+                                       dst,
+                                       bw,
+                                       &subpel_params,
+                                       &sf_,
+                                       bw,
+                                       bh,
+                                       &conv_params,
+                                       filters,
+                                       0,
+                                       bit_depth_);
+        } else {
+            std::vector<uint8_t> dst8(bw * bh);
+            svt_inter_predictor(pixels_.data() + offset,
+                                kStride,
+                                dst8.data(),
+                                bw,
+                                &subpel_params,
+                                &sf_,
+                                bw,
+                                bh,
+                                &conv_params,
+                                filters,
+                                0);
+            for (int i = 0; i < bw * bh; i++)
+                dst[i] = dst8[i];
+        }
+    }
+
+    // the block read from the cache is the prediction of the block
+    void check_block(int x, int y, MV mv, int bw) {
+        int32_t stride = 0;
+        const uint8_t *block =
+            svt_hpel_cache_get(&cache_, x, y, mv, bw, bw, &stride);
+        ASSERT_NE(block, nullptr)
+            << "block " << x << ", " << y << " mv " << mv.col << ", "
+            << mv.row;
+        std::vector<uint16_t> ref(bw * bw);
+        predict(x, y, mv, bw, bw, ref.data());
+        for (int i = 0; i < bw; i++) {
+            for (int j = 0; j < bw; j++) {
+                const int v = bit_depth_ > 8
+                                  ? ((const uint16_t *)block)[i * stride + j]
+                                  : block[i * stride + j];
+                ASSERT_EQ(v, ref[i * bw + j])
+                    << "block " << x << ", " << y << " mv " << mv.col << ", "
+                    << mv.row << " at " << j << ", " << i;
+            }
+        }
+    }
+
+    uint8_t bit_depth_;
+    ScaleFactors sf_;
+    EbPictureBufferDesc pic_;
+    std::vector<uint8_t> pixels_;
+    std::vector<uint16_t> pixels16_;
+    HpelCache cache_;
+};
+
+TEST_P(HpelCacheTest, MatchesRegularPrediction) {
+    svt_av1_test_tool::SVTRandom rnd(0, 1 << 30);
+    static const int sizes[] = {16, 32, 64};
+    // the 64x64 blocks of the picture, the last ones partly out of it
+    for (int block_y = 0; block_y < kPicHeight; block_y += 64) {
+        for (int block_x = 0; block_x < kPicWidth; block_x += 64) {
+            reset(block_x, block_y);
+            for (int n = 0; n < 64; n++) {
+                const int bw = sizes[rnd.random() % 3];
+                const int x = block_x + (int)(rnd.random() % (64 / bw)) * bw;
+                const int y = block_y + (int)(rnd.random() % (64 / bw)) * bw;
+                if (x + bw > kPicWidth || y + bw > kPicHeight)
+                    continue;
+                // full-pel and half-pel mvs in the window and the picture
+                MV mv;
+                int32_t stride;
+                do {
+                    mv.col = (int16_t)(((int)(rnd.random() % 65) - 32) * 4);
+                    mv.row = (int16_t)(((int)(rnd.random() % 65) - 32) * 4);
+                } while (!svt_hpel_cache_get(
+                    &cache_, x, y, mv, bw, bw, &stride));
+                check_block(x, y, mv, bw);
+                if (HasFatalFailure())
+                    return;
+            }
+        }
+    }
+    EXPECT_GT(cache_.hits, 0u);
+    EXPECT_GT(cache_.tile_fills, 0u);
+}
+
+TEST_P(HpelCacheTest, HoldsHalfPelPositionsOfTheWindow) {
+    int32_t stride;
+    reset(64, 64);
+    // the 1/4 and 1/8 pel positions are not held
+    EXPECT_EQ(
+        svt_hpel_cache_get(&cache_, 64, 64, MV{2, 4}, 16, 16, &stride),
+        nullptr);
+    EXPECT_EQ(
+        svt_hpel_cache_get(&cache_, 64, 64, MV{4, 1}, 16, 16, &stride),
+        nullptr);
+    EXPECT_EQ(cache_.hits + cache_.misses, 0u);
+    // out of the window
+    const int16_t far = (HPEL_CACHE_WIN / 2) * 8;
+    EXPECT_EQ(
+        svt_hpel_cache_get(&cache_, 64, 64, MV{4, far}, 64, 64, &stride),
+        nullptr);
+    EXPECT_EQ(cache_.misses, 1u);
+    // the diagonal half-pel position interpolates the tiles of the block once
+    check_block(80, 80, MV{-12, 20}, 16);
+    const uint64_t tile_fills = cache_.tile_fills;
+    EXPECT_EQ(tile_fills, 4u);
+    check_block(80, 80, MV{-12, 20}, 16);
+    EXPECT_EQ(cache_.tile_fills, tile_fills);
+    EXPECT_EQ(cache_.hits, 2u);
+    // the full-pel positions are read in the reference
+    const uint8_t *block =
+        svt_hpel_cache_get(&cache_, 64, 64, MV{8, -16}, 16, 16, &stride);
+    EXPECT_EQ(stride, kStride);
+    EXPECT_EQ(block,
+              (bit_depth_ > 8 ? (const uint8_t *)pixels16_.data()
+                              : pixels_.data()) +
+                  (((kPadding + 65) * kStride + kPadding + 62)
+                   << (bit_depth_ > 8)));
+}
+
+TEST_P(HpelCacheTest, DisabledWithoutPadding) {
+    int32_t stride;
+    pic_.origin_bot_y = 8;
+    reset(0, 0);
+    EXPECT_EQ(
+        svt_hpel_cache_get(&cache_, 0, 0, MV{4, 4}, 16, 16, &stride),
+        nullptr);
+    EXPECT_EQ(cache_.misses, 1u);
+}
+
+INSTANTIATE_TEST_CASE_P(HpelCache, HpelCacheTest, ::testing::Values(8, 10));
+
+class SubpelRefPlanesTest : public HpelCacheTest {
+  protected:
+    void SetUp() override {
+        HpelCacheTest::SetUp();
+        if (bit_depth_ > 8)
+            pic_.buffer_y = (uint8_t *)pixels16_.data();
+        memset(&planes_, 0, sizeof(planes_));
+    }
+
+    void TearDown() override {
+        svt_subpel_ref_planes_dctor(&planes_);
+        HpelCacheTest::TearDown();
+    }
+
+    void build(uint8_t level) {
+        ASSERT_EQ(svt_subpel_ref_planes_ctor(&planes_,
+                                             level,
+                                             kPicWidth,
+                                             kPicHeight,
+                                             kPadding,
+                                             bit_depth_ > 8),
+                  EB_ErrorNone);
+        svt_subpel_ref_planes_build(&planes_, &sf_, &pic_, bit_depth_);
+    }
+
+    // the block at (x, y) displaced by the 1/8-pel mv, read from the planes
+    const uint8_t *get(int x, int y, MV mv, int bw, int bh,
+                       int32_t *stride) {
+        return svt_subpel_ref_planes_get(
+            &planes_,
+            x + (mv.col >> 3),
+            y + (mv.row >> 3),
+            ((mv.col * 2) & SUBPEL_MASK) << SCALE_EXTRA_BITS,
+            ((mv.row * 2) & SUBPEL_MASK) << SCALE_EXTRA_BITS,
+            bw,
+            bh,
+            stride);
+    }
+
+    SubpelRefPlanes planes_;
+};
+
+TEST_P(SubpelRefPlanesTest, MatchesRegularPrediction) {
+    svt_av1_test_tool::SVTRandom rnd(0, 1 << 30);
+    static const int sizes[] = {8, 16, 32, 64};
+    build(2);
+    ASSERT_TRUE(planes_.ready);
+    for (int n = 0; n < 256; n++) {
+        const int bw = sizes[rnd.random() % 4];
+        const int bh = sizes[rnd.random() % 4];
+        const int x = (int)(rnd.random() % (kPicWidth - bw + 1));
+        const int y = (int)(rnd.random() % (kPicHeight - bh + 1));
+        // the quarter-pel mvs but the full-pel ones, up to 24 pixels
+        MV mv;
+        do {
+            mv.col = (int16_t)(((int)(rnd.random() % 97) - 48) * 4);
+            mv.row = (int16_t)(((int)(rnd.random() % 97) - 48) * 4);
+            mv.col /= 2;
+            mv.row /= 2;
+        } while (!(mv.col & 7) && !(mv.row & 7));
+        int32_t stride = 0;
+        const uint8_t *block = get(x, y, mv, bw, bh, &stride);
+        ASSERT_NE(block, nullptr) << "block " << x << ", " << y << " mv "
+                                  << mv.col << ", " << mv.row;
+        std::vector<uint16_t> ref(bw * bh);
+        predict(x, y, mv, bw, bh, ref.data());
+        for (int i = 0; i < bh; i++) {
+            for (int j = 0; j < bw; j++) {
+                const int v = bit_depth_ > 8
+                                  ? ((const uint16_t *)block)[i * stride + j]
+                                  : block[i * stride + j];
+                ASSERT_EQ(v, ref[i * bw + j])
+                    << "block " << x << ", " << y << " mv " << mv.col
+                    << ", " << mv.row << " at " << j << ", " << i;
+            }
+        }
+    }
+}
+
+TEST_P(SubpelRefPlanesTest, HoldsPositionsOfTheLevel) {
+    int32_t stride;
+    build(1);
+    // half-pel positions only at level 1
+    EXPECT_NE(get(32, 32, MV{4, 0}, 16, 16, &stride), nullptr);
+    EXPECT_NE(get(32, 32, MV{-12, 20}, 16, 16, &stride), nullptr);
+    EXPECT_EQ(get(32, 32, MV{2, 4}, 16, 16, &stride), nullptr);
+    // neither the full-pel nor the 1/8-pel positions
+    EXPECT_EQ(get(32, 32, MV{8, -16}, 16, 16, &stride), nullptr);
+    EXPECT_EQ(get(32, 32, MV{4, 1}, 16, 16, &stride), nullptr);
+    // out of the margin of the planes
+    const int16_t far = (int16_t)((kPadding - 8 + 1) * 8);
+    EXPECT_NE(get(0, 0, MV{-(far - 8), 4}, 16, 16, &stride), nullptr);
+    EXPECT_EQ(get(0, 0, MV{-far, 4}, 16, 16, &stride), nullptr);
+    // not before the planes are built
+    planes_.ready = 0;
+    EXPECT_EQ(get(32, 32, MV{4, 0}, 16, 16, &stride), nullptr);
+}
+
+INSTANTIATE_TEST_CASE_P(HpelCache, SubpelRefPlanesTest,
+                        ::testing::Values(8, 10));
+
+}  // namespace
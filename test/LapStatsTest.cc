@@ -0,0 +1,91 @@
+/*
+ * Copyright(c) 2019 Netflix, Inc.
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file LapStatsTest.cc
+ *
+ * @brief Unit test of the first pass stats ring of the look ahead rate
+ * control:
+ * - svt_av1_push_lap_stats
+ * - svt_av1_lap_stats, the window around a frame is contiguous
+ *
+ ******************************************************************************/
+
+#include <string.h>
+#include "gtest/gtest.h"
+// workaround to eliminate the compiling warning on linux
+// The macro will conflict with definition in gtest.h
+#ifdef __USE_GNU
+#undef __USE_GNU  // defined in EbThreads.h
+#endif
+#ifdef _GNU_SOURCE
+#undef _GNU_SOURCE  // defined in EbThreads.h
+#endif
+#include "EbPictureControlSet.h"
+#include "firstpass.h"
+
+namespace {
+
+class LapStatsTest : public ::testing::TestWithParam<int> {
+  protected:
+    void SetUp() override {
+        memset(&ctx_, 0, sizeof(ctx_));
+        frames_in_flight_ = (uint64_t)GetParam();
+        ASSERT_EQ(svt_av1_alloc_lap_stats(&ctx_, frames_in_flight_),
+                  EB_ErrorNone);
+    }
+
+    void TearDown() override {
+        free(ctx_.lap_stats);
+    }
+
+    void push(uint64_t frame) {
+        FIRSTPASS_STATS stats;
+        memset(&stats, 0, sizeof(stats));
+        stats.frame = (double)frame;
+        stats.count = 1.0;
+        svt_av1_push_lap_stats(&ctx_, &stats);
+    }
+
+    STATS_BUFFER_CTX ctx_;
+    uint64_t frames_in_flight_;
+};
+
+// The frames written after a frame of the rate control, and the margin before
+// it, are read at their offset from the frame
+TEST_P(LapStatsTest, WindowIsContiguous) {
+    const uint64_t frames = 3 * ctx_.lap_stats_size;
+    for (uint64_t written = 0; written < frames; written++) {
+        push(written);
+        ASSERT_EQ(ctx_.lap_stats_count, written + 1);
+        // the oldest frame of the rate control, with the frames in flight
+        // and the reorder of the mini GOPs after it
+        const uint64_t span = frames_in_flight_ + LAP_STATS_MARGIN - 1;
+        const uint64_t oldest = written > span ? written - span : 0;
+        for (uint64_t frame = oldest; frame <= written; frame++) {
+            const FIRSTPASS_STATS *stats = svt_av1_lap_stats(&ctx_, frame);
+            const int64_t before =
+                (int64_t)(frame < LAP_STATS_MARGIN ? frame : LAP_STATS_MARGIN);
+            ASSERT_GE(stats - before, ctx_.lap_stats);
+            ASSERT_LE(stats + (written - frame),
+                      ctx_.lap_stats + 2 * ctx_.lap_stats_size - 1);
+            for (int64_t i = -before; i <= (int64_t)(written - frame); i++)
+                ASSERT_EQ(stats[i].frame, (double)((int64_t)frame + i))
+                    << "frame " << frame << " offset " << i << " written "
+                    << written;
+        }
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(LapStats, LapStatsTest, ::testing::Values(1, 75));
+
+}  // namespace
@@ -0,0 +1,247 @@
+/*
+ * Copyright(c) 2019 Netflix, Inc.
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file SvtAv1EncStatsStreamTest.cc
+ *
+ * @brief SVT-AV1 encoder api test, check the rate of the single pass VBR
+ * taking streamed first pass stats
+ *
+ ******************************************************************************/
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "EbSvtAv1Enc.h"
+#include "SvtAv1EncTestFrames.h"
+#include "gtest/gtest.h"
+
+using namespace svt_av1_test;
+
+namespace {
+
+static const int frame_count = 32;
+static const uint32_t frame_rate = 30;
+static const uint32_t target_kbps = 500;
+
+struct Encoding {
+    uint64_t bytes;
+    double psnr;  // average luma psnr of the recon
+    int recon_count;
+    Buffer stats;  // first pass stats
+};
+
+/** a texture panning slowly, then fast with noise, so that the rate control
+ * has to move the bits between the two halves */
+static void fill_clip_frame(int frame, Buffer &yuv) {
+    const bool fast = frame >= frame_count / 2;
+    fill_frame(frame, fast ? 4 * frame - 3 * frame_count / 2 : frame, fast, yuv);
+}
+
+static double luma_psnr(const uint8_t *a, const uint8_t *b) {
+    double sse = 0;
+    for (uint32_t i = 0; i < frame_width * frame_height; i++) {
+        const double d = (double)a[i] - b[i];
+        sse += d * d;
+    }
+    const double mse = sse / (frame_width * frame_height);
+    return mse > 0 ? 10 * log10(255.0 * 255.0 / mse) : 100.0;
+}
+
+/** returns true once the end of stream packet is received */
+static bool collect_packets(EbComponentType *handle, Encoding &encoding,
+                            bool first_pass, uint8_t done) {
+    for (;;) {
+        EbBufferHeaderType *packet = nullptr;
+        const EbErrorType ret = svt_av1_enc_get_packet(handle, &packet, done);
+        if (ret == EB_NoErrorEmptyQueue)
+            return false;
+        EXPECT_EQ(ret, EB_ErrorNone);
+        if (ret != EB_ErrorNone)
+            return true;
+        const uint32_t flags = packet->flags;
+        encoding.bytes += packet->n_filled_len;
+        svt_av1_enc_release_out_buffer(&packet);
+        if (first_pass) {
+            SvtAv1FixedBuf stats;
+            EXPECT_EQ(svt_av1_enc_get_stream_info(
+                          handle,
+                          SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_NEW,
+                          &stats),
+                      EB_ErrorNone);
+            const uint8_t *buf = (const uint8_t *)stats.buf;
+            encoding.stats.insert(encoding.stats.end(), buf, buf + stats.sz);
+        }
+        if (flags & EB_BUFFERFLAG_EOS)
+            return true;
+    }
+}
+
+/** scores the recon pictures output so far */
+static void collect_recon(EbComponentType *handle,
+                          const std::vector<Buffer> &source,
+                          Encoding &encoding) {
+    Buffer recon(frame_size);
+    EbBufferHeaderType header;
+    memset(&header, 0, sizeof(header));
+    header.size = sizeof(header);
+    header.p_buffer = recon.data();
+    header.n_alloc_len = frame_size;
+    while (svt_av1_get_recon(handle, &header) == EB_ErrorNone) {
+        ASSERT_LT(header.pts, (int64_t)source.size());
+        encoding.psnr += luma_psnr(source[header.pts].data(), recon.data());
+        encoding.recon_count++;
+    }
+}
+
+/** first pass when first_pass is set, else single pass VBR taking the stats
+ * of stats_in when given */
+static void encode(bool first_pass, Bool stats_stream, const Buffer *stats_in,
+                   Encoding &encoding) {
+    EbComponentType *handle = nullptr;
+    EbSvtAv1EncConfiguration config;
+    ASSERT_EQ(svt_av1_enc_init_handle(&handle, nullptr, &config),
+              EB_ErrorNone);
+    config.source_width = frame_width;
+    config.source_height = frame_height;
+    config.frame_rate_numerator = frame_rate;
+    config.frame_rate_denominator = 1;
+    // the first pass of presets 5 to 10 skips frames unless it streams
+    config.enc_mode = 8;
+    config.rc_stats_stream = stats_stream;
+    if (first_pass) {
+        config.pass = 1;
+    } else {
+        config.rate_control_mode = 1;
+        config.target_bit_rate = target_kbps * 1000;
+        config.recon_enabled = 1;
+    }
+    ASSERT_EQ(svt_av1_enc_set_parameter(handle, &config), EB_ErrorNone);
+    ASSERT_EQ(svt_av1_enc_init(handle), EB_ErrorNone);
+
+    uint64_t stat_size = 0;
+    ASSERT_EQ(svt_av1_enc_get_stream_info(
+                  handle, SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_SIZE, &stat_size),
+              EB_ErrorNone);
+    ASSERT_GT(stat_size, 0u);
+    if (stats_in) {
+        ASSERT_GE(stats_in->size(), stat_size * frame_count);
+    }
+
+    std::vector<Buffer> source(frame_count);
+    encoding.bytes = 0;
+    encoding.psnr = 0;
+    encoding.recon_count = 0;
+    encoding.stats.clear();
+
+    EbSvtIOFormat input;
+    EbBufferHeaderType header;
+    bool eos = false;
+    for (int frame = 0; frame <= frame_count && !eos; frame++) {
+        memset(&header, 0, sizeof(header));
+        header.size = sizeof(header);
+        header.pic_type = EB_AV1_INVALID_PICTURE;
+        if (frame < frame_count) {
+            // the stats of a picture are sent before it
+            if (stats_in) {
+                SvtAv1FixedBuf stats = {
+                    (uint8_t *)stats_in->data() + frame * stat_size, stat_size};
+                ASSERT_EQ(svt_av1_enc_send_stats(handle, &stats), EB_ErrorNone);
+            }
+            fill_clip_frame(frame, source[frame]);
+            set_input_format(source[frame], input);
+            header.p_buffer = (uint8_t *)&input;
+            header.n_filled_len = frame_size;
+            header.pts = frame;
+        } else {
+            header.flags = EB_BUFFERFLAG_EOS;
+        }
+        ASSERT_EQ(svt_av1_enc_send_picture(handle, &header), EB_ErrorNone);
+        eos = collect_packets(handle, encoding, first_pass, 0);
+        if (!first_pass) {
+            ASSERT_NO_FATAL_FAILURE(collect_recon(handle, source, encoding));
+        }
+    }
+    // the recon pictures are taken while waiting, the encoder holds its
+    // packets until they are
+    while (!eos) {
+        eos = collect_packets(handle, encoding, first_pass, first_pass);
+        if (!first_pass) {
+            ASSERT_NO_FATAL_FAILURE(collect_recon(handle, source, encoding));
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    if (!first_pass) {
+        EXPECT_EQ(encoding.recon_count, frame_count);
+        encoding.psnr /= frame_count;
+    }
+
+    EXPECT_EQ(svt_av1_enc_deinit(handle), EB_ErrorNone);
+    EXPECT_EQ(svt_av1_enc_deinit_handle(handle), EB_ErrorNone);
+}
+
+static double kbps(const Encoding &encoding) {
+    return encoding.bytes * 8.0 * frame_rate / frame_count / 1000;
+}
+
+/** checks the streamed encode rates and scores as the plain VBR */
+static void compare_rate(const Encoding &streamed, const Encoding &vbr) {
+    EXPECT_NEAR(kbps(streamed), kbps(vbr), 0.2 * kbps(vbr))
+        << "streamed " << kbps(streamed) << " kbps, vbr " << kbps(vbr)
+        << " kbps";
+    EXPECT_GT(streamed.psnr, vbr.psnr - 1.0)
+        << "streamed " << streamed.psnr << " dB, vbr " << vbr.psnr << " dB";
+}
+
+/** @brief EncStatsStreamTest.streamed_vbr_rate_matches_vbr
+ *
+ * Test strategy: <br>
+ * Run the first pass with rc_stats_stream, taking its stats as they are
+ * output. Encode the clip with the single pass VBR, sending the stats of
+ * each picture before it, and without stats. Repeat with the stats of a
+ * first pass without rc_stats_stream, which skips frames and repeats the
+ * stats of the frames it analysed.
+ *
+ * Expected result: <br>
+ * The first pass outputs the stats of every picture and the closing total.
+ * The streamed encodes land within 20% of the rate of the single pass VBR,
+ * at most 1 dB lower in luma PSNR.
+ *
+ * Test coverage:
+ * rc_stats_stream, svt_av1_enc_send_stats,
+ * SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_NEW
+ */
+TEST(EncStatsStreamTest, streamed_vbr_rate_matches_vbr) {
+    Encoding first_pass, coarse_first_pass, vbr, streamed, coarse_streamed;
+    ASSERT_NO_FATAL_FAILURE(encode(true, TRUE, nullptr, first_pass));
+    ASSERT_NO_FATAL_FAILURE(encode(true, FALSE, nullptr, coarse_first_pass));
+    ASSERT_EQ(first_pass.stats.size() % (frame_count + 1), 0u);
+    ASSERT_EQ(coarse_first_pass.stats.size(), first_pass.stats.size());
+
+    ASSERT_NO_FATAL_FAILURE(encode(false, FALSE, nullptr, vbr));
+    ASSERT_NO_FATAL_FAILURE(
+        encode(false, TRUE, &first_pass.stats, streamed));
+    ASSERT_NO_FATAL_FAILURE(
+        encode(false, TRUE, &coarse_first_pass.stats, coarse_streamed));
+    {
+        SCOPED_TRACE("streamed stats of every picture");
+        compare_rate(streamed, vbr);
+    }
+    {
+        SCOPED_TRACE("streamed stats of a frame-skipping first pass");
+        compare_rate(coarse_streamed, vbr);
+    }
+}
+
+}  // namespace
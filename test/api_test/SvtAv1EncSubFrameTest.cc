@@ -0,0 +1,341 @@
+/*
+ * Copyright(c) 2019 Netflix, Inc.
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file SvtAv1EncSubFrameTest.cc
+ *
+ * @brief SVT-AV1 encoder api test, check the sub-frame output
+ *
+ ******************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+#include "EbSvtAv1Enc.h"
+#include "EbSvtAv1Dec.h"
+#include "SvtAv1EncTestFrames.h"
+#include "gtest/gtest.h"
+
+using namespace svt_av1_test;
+
+namespace {
+
+static const int frame_count = 8;
+// 2x2 tiles, with --tile-columns 1 --tile-rows 1
+static const int tile_count = 4;
+static const int tile_log2 = 2;
+
+enum { OBU_SEQUENCE_HEADER = 1, OBU_FRAME_HEADER = 3, OBU_TILE_GROUP = 4,
+       OBU_FRAME = 6 };
+
+/** one temporal unit per frame, and the number of partial packets it came in */
+struct Stream {
+    std::vector<Buffer> frames;
+    int partial_packets;
+};
+
+struct Obu {
+    int type;
+    Buffer payload;
+};
+
+/** splits a temporal unit in its OBUs, the encoder always codes their size */
+static std::vector<Obu> parse_obus(const Buffer &tu) {
+    std::vector<Obu> obus;
+    size_t pos = 0;
+    while (pos < tu.size()) {
+        Obu obu;
+        const uint8_t header = tu[pos++];
+        obu.type = (header >> 3) & 15;
+        EXPECT_TRUE(header & 2) << "obu without size";
+        if (header & 4)
+            pos++;  // extension
+        uint64_t size = 0;
+        for (int i = 0; pos < tu.size(); i++) {
+            const uint8_t byte = tu[pos++];
+            size |= (uint64_t)(byte & 0x7f) << (7 * i);
+            if (!(byte & 0x80))
+                break;
+        }
+        if (pos + size > tu.size()) {
+            ADD_FAILURE() << "truncated obu";
+            break;
+        }
+        obu.payload.assign(tu.begin() + pos, tu.begin() + pos + size);
+        pos += size;
+        obus.push_back(obu);
+    }
+    return obus;
+}
+
+/** the coded data of each tile of the OBU_TILE_GROUPs of a temporal unit */
+static std::vector<Buffer> tiles_of_tile_groups(const std::vector<Obu> &obus) {
+    std::vector<Buffer> tiles;
+    for (const Obu &obu : obus) {
+        if (obu.type != OBU_TILE_GROUP)
+            continue;
+        const Buffer &p = obu.payload;
+        // tile_start_and_end_present_flag, tg_start, tg_end, byte alignment
+        int start = 0, end = tile_count - 1;
+        if (p[0] & 0x80) {
+            start = (p[0] >> (7 - tile_log2)) & (tile_count - 1);
+            end = (p[0] >> (7 - 2 * tile_log2)) & (tile_count - 1);
+        }
+        EXPECT_EQ(start, (int)tiles.size()) << "tile groups out of order";
+        size_t pos = 1;
+        for (int tile = start; tile <= end; tile++) {
+            // the sub-frame output codes the tile sizes on 4 bytes
+            size_t size = p.size() - pos;
+            if (tile != end) {
+                size = ((size_t)p[pos] | (size_t)p[pos + 1] << 8 |
+                        (size_t)p[pos + 2] << 16 | (size_t)p[pos + 3] << 24) +
+                    1;
+                pos += 4;
+            }
+            tiles.push_back(Buffer(p.begin() + pos, p.begin() + pos + size));
+            pos += size;
+        }
+    }
+    return tiles;
+}
+
+/** the tile group of an OBU_FRAME holding the tiles, with sizes coded on
+ * size_bytes bytes */
+static Buffer frame_tile_group(const std::vector<Buffer> &tiles,
+                               int size_bytes) {
+    // tile_start_and_end_present_flag is 0 in an OBU_FRAME, byte alignment
+    Buffer tile_group(1, 0);
+    for (size_t tile = 0; tile < tiles.size(); tile++) {
+        if (tile + 1 != tiles.size())
+            for (int i = 0; i < size_bytes; i++)
+                tile_group.push_back(
+                    (uint8_t)((tiles[tile].size() - 1) >> (8 * i)));
+        tile_group.insert(
+            tile_group.end(), tiles[tile].begin(), tiles[tile].end());
+    }
+    return tile_group;
+}
+
+/** checks the partial packets of a frame concatenate to the sequence header
+ * and the tile data of its whole-frame packet */
+static void compare_frame(const Buffer &whole, const Buffer &sub_frame) {
+    const std::vector<Obu> whole_obus = parse_obus(whole);
+    const std::vector<Obu> sub_frame_obus = parse_obus(sub_frame);
+    const Obu *whole_frame = nullptr;
+    for (const Obu &obu : whole_obus)
+        if (obu.type == OBU_FRAME)
+            whole_frame = &obu;
+    ASSERT_NE(whole_frame, nullptr);
+    ASSERT_GE(sub_frame_obus.size(), 2u);
+    // no leading tile was ready before the last one, the frame is whole
+    if (sub_frame_obus.back().type == OBU_FRAME)
+        return;
+    // the sequence header of key frames, then the frame header
+    size_t first = 1;
+    if (whole_obus[1].type == OBU_SEQUENCE_HEADER) {
+        ASSERT_EQ(sub_frame_obus[1].type, OBU_SEQUENCE_HEADER);
+        EXPECT_TRUE(sub_frame_obus[1].payload == whole_obus[1].payload);
+        first = 2;
+    }
+    ASSERT_EQ(sub_frame_obus[first].type, OBU_FRAME_HEADER);
+    for (size_t i = first + 1; i < sub_frame_obus.size(); i++)
+        ASSERT_EQ(sub_frame_obus[i].type, OBU_TILE_GROUP);
+
+    const std::vector<Buffer> tiles = tiles_of_tile_groups(sub_frame_obus);
+    ASSERT_EQ(tiles.size(), (size_t)tile_count);
+    // the whole frame codes the tile sizes on as few bytes as they need
+    bool found = false;
+    for (int size_bytes = 1; size_bytes <= 4 && !found; size_bytes++) {
+        const Buffer tile_group = frame_tile_group(tiles, size_bytes);
+        const Buffer &p = whole_frame->payload;
+        found = p.size() > tile_group.size() &&
+            std::equal(tile_group.begin(), tile_group.end(),
+                       p.end() - tile_group.size());
+    }
+    EXPECT_TRUE(found) << "the tiles differ from the whole-frame packet";
+}
+
+/** returns true once the end of stream packet is received */
+static bool collect_packets(EbComponentType *handle, Stream &stream,
+                            Buffer &pending, uint8_t done) {
+    for (;;) {
+        EbBufferHeaderType *packet = nullptr;
+        const EbErrorType ret = svt_av1_enc_get_packet(handle, &packet, done);
+        if (ret == EB_NoErrorEmptyQueue)
+            return false;
+        EXPECT_EQ(ret, EB_ErrorNone);
+        if (ret != EB_ErrorNone)
+            return true;
+        const uint32_t flags = packet->flags;
+        pending.insert(pending.end(),
+                       packet->p_buffer,
+                       packet->p_buffer + packet->n_filled_len);
+        if (flags & EB_BUFFERFLAG_PARTIAL) {
+            stream.partial_packets++;
+        } else {
+            stream.frames.push_back(pending);
+            pending.clear();
+        }
+        svt_av1_enc_release_out_buffer(&packet);
+        if (flags & EB_BUFFERFLAG_EOS)
+            return true;
+    }
+}
+
+static void encode(Bool sub_frame_output, Stream &stream) {
+    EbComponentType *handle = nullptr;
+    EbSvtAv1EncConfiguration config;
+    ASSERT_EQ(svt_av1_enc_init_handle(&handle, nullptr, &config),
+              EB_ErrorNone);
+    config.source_width = frame_width;
+    config.source_height = frame_height;
+    config.enc_mode = 10;
+    config.pred_structure = 1;
+    config.tile_columns = 1;
+    config.tile_rows = 1;
+    config.sub_frame_output = sub_frame_output;
+    ASSERT_EQ(svt_av1_enc_set_parameter(handle, &config), EB_ErrorNone);
+    ASSERT_EQ(svt_av1_enc_init(handle), EB_ErrorNone);
+
+    stream.frames.clear();
+    stream.partial_packets = 0;
+    Buffer yuv, pending;
+    EbSvtIOFormat input;
+    EbBufferHeaderType header;
+    for (int frame = 0; frame < frame_count; frame++) {
+        // moving texture, the tiles differ and the motion is not trivial
+        fill_frame(frame, 3 * frame, false, yuv);
+        set_input_format(yuv, input);
+        memset(&header, 0, sizeof(header));
+        header.size = sizeof(header);
+        header.p_buffer = (uint8_t *)&input;
+        header.n_filled_len = (uint32_t)yuv.size();
+        header.pts = frame;
+        header.pic_type = EB_AV1_INVALID_PICTURE;
+        ASSERT_EQ(svt_av1_enc_send_picture(handle, &header), EB_ErrorNone);
+        collect_packets(handle, stream, pending, 0);
+    }
+    memset(&header, 0, sizeof(header));
+    header.flags = EB_BUFFERFLAG_EOS;
+    header.pic_type = EB_AV1_INVALID_PICTURE;
+    ASSERT_EQ(svt_av1_enc_send_picture(handle, &header), EB_ErrorNone);
+    while (!collect_packets(handle, stream, pending, 1)) {
+    }
+    EXPECT_TRUE(pending.empty());
+
+    EXPECT_EQ(svt_av1_enc_deinit(handle), EB_ErrorNone);
+    EXPECT_EQ(svt_av1_enc_deinit_handle(handle), EB_ErrorNone);
+}
+
+static void decode(const Stream &stream, std::vector<Buffer> &pictures) {
+    EbComponentType *handle = nullptr;
+    EbSvtAv1DecConfiguration config;
+    ASSERT_EQ(svt_av1_dec_init_handle(&handle, nullptr, &config),
+              EB_ErrorNone);
+    ASSERT_EQ(svt_av1_dec_set_parameter(handle, &config), EB_ErrorNone);
+    ASSERT_EQ(svt_av1_dec_init(handle), EB_ErrorNone);
+
+    // the planes are malloc'ed, the decoder reallocates them when the
+    // picture format changes
+    EbSvtIOFormat output;
+    memset(&output, 0, sizeof(output));
+    output.luma = (uint8_t *)malloc(frame_width * frame_height);
+    output.cb = (uint8_t *)malloc(frame_width * frame_height / 4);
+    output.cr = (uint8_t *)malloc(frame_width * frame_height / 4);
+    output.y_stride = frame_width;
+    output.cb_stride = frame_width / 2;
+    output.cr_stride = frame_width / 2;
+    output.width = frame_width;
+    output.height = frame_height;
+    output.color_fmt = EB_YUV420;
+    output.bit_depth = EB_EIGHT_BIT;
+    EbBufferHeaderType header;
+    memset(&header, 0, sizeof(header));
+    header.p_buffer = (uint8_t *)&output;
+    EbAV1StreamInfo stream_info;
+    EbAV1FrameInfo frame_info;
+
+    pictures.clear();
+    for (const Buffer &frame : stream.frames) {
+        EXPECT_EQ(svt_av1_dec_frame(handle, frame.data(), frame.size(), 0),
+                  EB_ErrorNone);
+        if (svt_av1_dec_get_picture(
+                handle, &header, &stream_info, &frame_info) ==
+            EB_DecNoOutputPicture)
+            continue;
+        ASSERT_EQ(output.width, frame_width);
+        ASSERT_EQ(output.height, frame_height);
+        Buffer picture;
+        for (uint32_t y = 0; y < frame_height; y++)
+            picture.insert(picture.end(),
+                           output.luma + y * output.y_stride,
+                           output.luma + y * output.y_stride + frame_width);
+        for (uint32_t y = 0; y < frame_height / 2; y++) {
+            picture.insert(picture.end(),
+                           output.cb + y * output.cb_stride,
+                           output.cb + y * output.cb_stride + frame_width / 2);
+            picture.insert(picture.end(),
+                           output.cr + y * output.cr_stride,
+                           output.cr + y * output.cr_stride + frame_width / 2);
+        }
+        pictures.push_back(picture);
+    }
+    free(output.luma);
+    free(output.cb);
+    free(output.cr);
+    EXPECT_EQ(svt_av1_dec_deinit(handle), EB_ErrorNone);
+    EXPECT_EQ(svt_av1_dec_deinit_handle(handle), EB_ErrorNone);
+}
+
+/** @brief EncSubFrameTest.partial_packets_match_whole_frames
+ *
+ * Test strategy: <br>
+ * Encode the same low-delay multi-tile clip with and without the sub-frame
+ * output. Concatenate the partial packets of each frame with its last
+ * packet, compare the OBUs with the whole-frame packet, and decode both
+ * streams.
+ *
+ * Expected result: <br>
+ * Frames are sent in several packets, and each frame concatenates to one
+ * temporal unit. Its sequence header and tile data bytes are those of the
+ * whole-frame packet; only the frame header and the tile groups are split
+ * in separate OBUs. It decodes to the same picture as the whole-frame
+ * packet.
+ *
+ * Test coverage:
+ * sub_frame_output, EB_BUFFERFLAG_PARTIAL
+ */
+TEST(EncSubFrameTest, partial_packets_match_whole_frames) {
+    Stream whole, sub_frame;
+    ASSERT_NO_FATAL_FAILURE(encode(FALSE, whole));
+    ASSERT_NO_FATAL_FAILURE(encode(TRUE, sub_frame));
+    EXPECT_EQ(whole.partial_packets, 0);
+    EXPECT_GT(sub_frame.partial_packets, 0);
+    ASSERT_EQ(whole.frames.size(), (size_t)frame_count);
+    ASSERT_EQ(sub_frame.frames.size(), whole.frames.size());
+    for (int frame = 0; frame < frame_count; frame++) {
+        SCOPED_TRACE(frame);
+        ASSERT_NO_FATAL_FAILURE(
+            compare_frame(whole.frames[frame], sub_frame.frames[frame]));
+    }
+
+    std::vector<Buffer> whole_pictures, sub_frame_pictures;
+    ASSERT_NO_FATAL_FAILURE(decode(whole, whole_pictures));
+    ASSERT_NO_FATAL_FAILURE(decode(sub_frame, sub_frame_pictures));
+    ASSERT_EQ(whole_pictures.size(), (size_t)frame_count);
+    ASSERT_EQ(sub_frame_pictures.size(), whole_pictures.size());
+    for (int frame = 0; frame < frame_count; frame++)
+        EXPECT_TRUE(sub_frame_pictures[frame] == whole_pictures[frame])
+            << "frame " << frame;
+}
+
+}  // namespace
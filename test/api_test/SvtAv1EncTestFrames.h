@@ -0,0 +1,76 @@
+/*
+ * Copyright(c) 2019 Netflix, Inc.
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file SvtAv1EncTestFrames.h
+ *
+ * @brief Synthetic 8-bit 4:2:0 input pictures shared by the encoder api tests
+ * that run whole encodes.
+ *
+ ******************************************************************************/
+#ifndef _SVT_AV1_ENC_TEST_FRAMES_H_
+#define _SVT_AV1_ENC_TEST_FRAMES_H_
+
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include "EbSvtAv1Enc.h"
+
+namespace svt_av1_test {
+
+typedef std::vector<uint8_t> Buffer;
+
+static const uint32_t frame_width = 352;
+static const uint32_t frame_height = 288;
+static const uint32_t frame_size = frame_width * frame_height * 3 / 2;
+
+/** fills yuv with a texture moved by shift pixels across and shift / 2 down,
+ * plus a pseudo-random noise of +/- 8 when noisy is set; the chroma changes
+ * with frame */
+static inline void fill_frame(int frame, int shift, bool noisy, Buffer &yuv) {
+    yuv.resize(frame_size);
+    uint32_t seed = 12345u + frame;
+    for (uint32_t y = 0; y < frame_height; y++) {
+        for (uint32_t x = 0; x < frame_width; x++) {
+            const uint32_t u = x + shift, v = y + shift / 2;
+            int pixel = (int)((u * v / 7 + (u ^ v) * 5 + (u / 16 + v / 16) * 40) &
+                              0xff);
+            if (noisy) {
+                seed = seed * 1103515245u + 12345u;
+                pixel += (int)((seed >> 16) & 15) - 8;
+            }
+            yuv[y * frame_width + x] =
+                (uint8_t)(pixel < 0 ? 0 : pixel > 255 ? 255 : pixel);
+        }
+    }
+    for (uint32_t i = frame_width * frame_height; i < frame_size; i++)
+        yuv[i] = (uint8_t)(128 + ((i * 13 + frame) & 31));
+}
+
+/** points input at the planes of yuv, filled by fill_frame() */
+static inline void set_input_format(Buffer &yuv, EbSvtIOFormat &input) {
+    memset(&input, 0, sizeof(input));
+    input.luma = yuv.data();
+    input.cb = input.luma + frame_width * frame_height;
+    input.cr = input.cb + frame_width * frame_height / 4;
+    input.y_stride = frame_width;
+    input.cb_stride = frame_width / 2;
+    input.cr_stride = frame_width / 2;
+    input.width = frame_width;
+    input.height = frame_height;
+    input.color_fmt = EB_YUV420;
+    input.bit_depth = EB_EIGHT_BIT;
+}
+
+}  // namespace svt_av1_test
+
+#endif  // _SVT_AV1_ENC_TEST_FRAMES_H_
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file corner_detect_test.cc
+ *
+ * @brief Unit test of the FAST-9 row detectors used by the global motion:
+ * - svt_av1_fast9_detect_row_{c,avx2} against the fastfeat detector
+ *
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <vector>
+#include "gtest/gtest.h"
+#include "aom_dsp_rtcd.h"
+#include "EbDefinitions.h"
+#include "EbTime.h"
+#include "util.h"
+#include "acm_random.h"
+extern "C" {
+#include "fast.h"  // no C++ guards of its own
+}
+
+using libaom_test::ACMRandom;
+
+/** setup_test_env is implemented in test/TestEnv.c */
+extern "C" void setup_test_env();
+
+namespace {
+
+typedef int (*Fast9DetectRowFunc)(const uint8_t *row, int stride, int x_start,
+                                  int x_end, int b, int *corner_x);
+
+using ::testing::make_tuple;
+using ::testing::tuple;
+// the cpu flags the function needs, the function
+typedef tuple<uint64_t, Fast9DetectRowFunc> Fast9DetectRowParam;
+
+// the FAST barrier of the global motion
+static const int kBarrier = 18;
+
+class Fast9DetectRowTest
+    : public ::testing::TestWithParam<Fast9DetectRowParam> {
+  public:
+    void SetUp() override {
+        setup_test_env();
+        rnd_.Reset(ACMRandom::DeterministicSeed());
+        cpu_flags_ = TEST_GET_PARAM(0);
+        target_func_ = TEST_GET_PARAM(1);
+    }
+
+    bool is_supported() const {
+        return (get_cpu_flags_to_use() & cpu_flags_) == cpu_flags_;
+    }
+
+  protected:
+    // 0: random, 1: noisy gradient, 2: flat blocks with saturated pixels,
+    // 3: panned texture of a synthetic camera pan
+    void fill(std::vector<uint8_t> &pic, int w, int h, int stride,
+              int mode) {
+        for (int y = 0; y < h; ++y) {
+            for (int x = 0; x < w; ++x) {
+                int v;
+                switch (mode) {
+                case 0: v = rnd_.Rand8(); break;
+                case 1: v = (x + 2 * y) / 3 + (rnd_.Rand8() & 31); break;
+                case 2:
+                    v = ((x >> 3) ^ (y >> 3)) & 1 ? 255 : 0;
+                    if ((rnd_.Rand8() & 15) == 0)
+                        v = rnd_.Rand8();
+                    break;
+                default:
+                    v = (((x + 5) / 7 * 37) ^ ((y + 3) / 5 * 91)) & 255;
+                    break;
+                }
+                pic[y * stride + x] = (uint8_t)v;
+            }
+        }
+    }
+
+    // the corners of the rows of the target match the fastfeat ones
+    void check_picture(const std::vector<uint8_t> &pic, int w, int h,
+                       int stride, int b) {
+        int num_ref = 0;
+        xy *ref = svt_aom_fast9_detect(pic.data(), w, h, stride, b, &num_ref);
+        ASSERT_NE(ref, nullptr);
+        std::vector<int> corner_x(w);
+        int n = 0;
+        for (int y = 3; y < h - 3; ++y) {
+            const int count = target_func_(
+                pic.data() + y * stride, stride, 3, w - 3, b, corner_x.data());
+            for (int i = 0; i < count; ++i, ++n) {
+                ASSERT_LT(n, num_ref) << "extra corner at " << corner_x[i]
+                                      << ", " << y;
+                ASSERT_EQ(corner_x[i], ref[n].x) << "row " << y;
+                ASSERT_EQ(y, ref[n].y);
+            }
+        }
+        EXPECT_EQ(n, num_ref);
+        free(ref);
+    }
+
+    void run_check_output() {
+        static const int sizes[][2] = {{7, 7}, {40, 9}, {67, 35}, {128, 96}};
+        for (int mode = 0; mode < 4; ++mode) {
+            for (const auto &size : sizes) {
+                const int w = size[0], h = size[1], stride = w + 5;
+                std::vector<uint8_t> pic(stride * h);
+                fill(pic, w, h, stride, mode);
+                for (int b = 0; b <= 255; b += b < 30 ? 6 : 75) {
+                    check_picture(pic, w, h, stride, b);
+                    if (HasFatalFailure())
+                        return;
+                }
+                check_picture(pic, w, h, stride, kBarrier);
+            }
+        }
+    }
+
+    void run_speed_test() {
+        const int w = 1920, h = 1080;
+        const int num_loop = 20;
+        std::vector<uint8_t> pic(w * h);
+        std::vector<int> corner_x(w);
+        Fast9DetectRowFunc funcs[2] = {svt_av1_fast9_detect_row_c,
+                                       target_func_};
+        double time[2];
+        int count[2] = {0, 0};
+        // frames of a synthetic pan, the texture moving by 3 pixels a frame
+        fill(pic, w, h, w, 3);
+        for (int f = 0; f < 2; ++f) {
+            uint64_t start_seconds, start_useconds;
+            uint64_t finish_seconds, finish_useconds;
+            svt_av1_get_time(&start_seconds, &start_useconds);
+            for (int loop = 0; loop < num_loop; ++loop) {
+                const int shift = 3 * loop;
+                for (int y = 3; y < h - 3; ++y)
+                    count[f] += funcs[f](pic.data() + y * w + shift,
+                                         w,
+                                         3,
+                                         w - 3 - shift,
+                                         kBarrier,
+                                         corner_x.data());
+            }
+            svt_av1_get_time(&finish_seconds, &finish_useconds);
+            time[f] = svt_av1_compute_overall_elapsed_time_ms(
+                start_seconds, start_useconds, finish_seconds, finish_useconds);
+        }
+        EXPECT_EQ(count[0], count[1]);
+        printf("Average Milliseconds per 1080p Frame\n");
+        printf("    svt_av1_fast9_detect_row_c()   : %6.2f\n",
+               time[0] / num_loop);
+        printf(
+            "    svt_av1_fast9_detect_row_opt() : %6.2f   (Comparison: "
+            "%5.2fx)\n",
+            time[1] / num_loop,
+            time[0] / time[1]);
+    }
+
+    ACMRandom rnd_;
+    uint64_t cpu_flags_;
+    Fast9DetectRowFunc target_func_;
+};
+
+TEST_P(Fast9DetectRowTest, CheckOutput) {
+    if (!is_supported())
+        return;
+    run_check_output();
+}
+
+TEST_P(Fast9DetectRowTest, DISABLED_Speed) {
+    if (!is_supported())
+        return;
+    run_speed_test();
+}
+
+INSTANTIATE_TEST_CASE_P(
+    C, Fast9DetectRowTest,
+    ::testing::Values(make_tuple((uint64_t)0, &svt_av1_fast9_detect_row_c)));
+
+#ifdef ARCH_X86_64
+INSTANTIATE_TEST_CASE_P(
+    AVX2, Fast9DetectRowTest,
+    ::testing::Values(make_tuple((uint64_t)CPU_FLAGS_AVX2,
+                                 &svt_av1_fast9_detect_row_avx2)));
+#endif
+
+}  // namespace
@@ -15,8 +15,8 @@
  *
  * @brief Unit test for upsample and edge filter:
  * - svt_av1_upsample_intra_edge_sse4_1
- * - svt_av1_filter_intra_edge_sse4_1
- * - svt_av1_filter_intra_edge_high_sse4_1
+ * - svt_av1_filter_intra_edge_{sse4_1,avx2}
+ * - svt_av1_filter_intra_edge_high_{sse4_1,avx2}
  *
  * @author Cidana-Wenyao
  *
@@ -181,8 +181,8 @@ using FILTER_EDGE_HBD = void (*)(uint16_t *p, int size, int strength);
 
 /**
  * @brief Unit test for edge filter in intra prediction:
- * - svt_av1_filter_intra_edge_sse4_1
- * - svt_av1_filter_intra_edge_high_sse4_1
+ * - svt_av1_filter_intra_edge_{sse4_1,avx2}
+ * - svt_av1_filter_intra_edge_high_{sse4_1,avx2}
  *
  * Test strategy:
  * Verify this assembly code by comparing with reference c implementation.
@@ -284,6 +284,23 @@ class HighbdFilterEdgeTest : public FilterEdgeTest<uint16_t, FILTER_EDGE_HBD> {
     }
 };
 
+class LowbdFilterEdgeAvx2Test : public LowbdFilterEdgeTest {
+  public:
+    LowbdFilterEdgeAvx2Test() {
+        tst_func_ = svt_av1_filter_intra_edge_avx2;
+    }
+};
+
+class HighbdFilterEdgeAvx2Test : public HighbdFilterEdgeTest {
+  public:
+    HighbdFilterEdgeAvx2Test() {
+        tst_func_ = svt_av1_filter_intra_edge_high_avx2;
+        bd_ = 12;
+    }
+};
+
 TEST_CLASS(IntraFilterEdgeTestLowbd, LowbdFilterEdgeTest)
 TEST_CLASS(IntraFilterEdgeTestHighbd, HighbdFilterEdgeTest)
+TEST_CLASS(IntraFilterEdgeTestLowbdAvx2, LowbdFilterEdgeAvx2Test)
+TEST_CLASS(IntraFilterEdgeTestHighbdAvx2, HighbdFilterEdgeAvx2Test)
 }  // namespace
@@ -404,6 +404,12 @@ const LBD_PARAMS LowbdIntraPredTestVectorAsm[] = {
     lbd_entry(paeth, 64, 64, ssse3),    lbd_entry(paeth, 64, 64, avx2),
     lbd_entry(paeth, 8, 16, ssse3),     lbd_entry(paeth, 8, 32, ssse3),
     lbd_entry(paeth, 8, 4, ssse3),      lbd_entry(paeth, 8, 8, ssse3),
+    lbd_entry(dc, 32, 8, avx2),         lbd_entry(dc_left, 32, 8, avx2),
+    lbd_entry(dc_top, 32, 8, avx2),     lbd_entry(dc_128, 32, 8, avx2),
+    lbd_entry(v, 32, 8, avx2),          lbd_entry(h, 32, 8, avx2),
+    lbd_entry(h, 32, 16, avx2),         lbd_entry(h, 32, 64, avx2),
+    lbd_entry(h, 64, 16, avx2),         lbd_entry(h, 64, 32, avx2),
+    lbd_entry(h, 64, 64, avx2),
 };
 
 INSTANTIATE_TEST_CASE_P(intrapred, LowbdIntraPredTest,
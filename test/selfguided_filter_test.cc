@@ -11,6 +11,7 @@
  */
 
 #include <ctime>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "acm_random.h"
@@ -498,4 +499,150 @@ INSTANTIATE_TEST_CASE_P(
     ::testing::Combine(::testing::Values(svt_apply_selfguided_restoration_avx2),
                        ::testing::ValuesIn(highbd_params_avx2)));
 
+typedef void (*SgrIntegralImagesFunc)(const uint8_t *dgd8, int32_t width,
+                                      int32_t height, int32_t dgd_stride,
+                                      int32_t *C, int32_t *D,
+                                      int32_t buf_stride, int32_t highbd);
+typedef void (*SgrFromIiFunc)(const uint8_t *dgd8, int32_t width,
+                              int32_t height, int32_t dgd_stride,
+                              const int32_t *C, const int32_t *D, int32_t *A,
+                              int32_t *B, int32_t buf_stride, int32_t *flt0,
+                              int32_t *flt1, int32_t flt_stride,
+                              int32_t sgr_params_idx, int32_t bit_depth,
+                              int32_t highbd);
+
+// Test parameter list:
+//  <integral images function, filter function, bit_depth>
+typedef tuple<SgrIntegralImagesFunc, SgrFromIiFunc, int32_t> FromIiTestParam;
+
+// The filter of the processing units of a restoration unit from the integral
+// images of the unit matches svt_av1_selfguided_restoration_c() on each
+// processing unit, for all the parameter sets
+class AV1SelfguidedFromIiTest
+    : public ::testing::TestWithParam<FromIiTestParam> {
+  public:
+    virtual void TearDown() {
+        aom_clear_system_state();
+    }
+
+  protected:
+    void RunCorrectnessTest() {
+        const SgrIntegralImagesFunc ii_fun = TEST_GET_PARAM(0);
+        const SgrFromIiFunc tst_fun = TEST_GET_PARAM(1);
+        const int32_t bit_depth = TEST_GET_PARAM(2);
+        const int32_t highbd = bit_depth > 8;
+        const int32_t max_w = RESTORATION_UNITSIZE_MAX * 3 / 2;
+        const int32_t max_h = max_w + RESTORATION_UNIT_OFFSET;
+        const int32_t stride = max_w + 32;
+        const int32_t flt_stride = max_w + 16;
+        const int NUM_ITERS = 12;
+        ACMRandom rnd(ACMRandom::DeterministicSeed());
+
+        std::vector<uint16_t> input16(stride * (max_h + 32));
+        std::vector<uint8_t> input8(stride * (max_h + 32));
+        std::vector<int32_t> ref(2 * flt_stride * max_h);
+        std::vector<int32_t> tst(2 * flt_stride * max_h);
+        int32_t *ii_buf = (int32_t *)svt_aom_memalign(32, SGRPROJ_II_TMPBUF_SIZE);
+        ASSERT_NE(ii_buf, nullptr);
+
+        for (int i = 0; i < NUM_ITERS; ++i) {
+            // small units, units of odd sizes, and the largest units
+            const int32_t w = i < 4 ? 8 + rnd.PseudoUniform(64)
+                                    : max_w - rnd.PseudoUniform(i < 8 ? 200 : 3);
+            const int32_t h = i < 4 ? 8 + rnd.PseudoUniform(64)
+                                    : max_h - rnd.PseudoUniform(i < 8 ? 200 : 3);
+            const int32_t pu = (i & 1) ? RESTORATION_PROC_UNIT_SIZE >> 1
+                                       : RESTORATION_PROC_UNIT_SIZE;
+            // flat areas and noise
+            const int32_t mask = (1 << bit_depth) - 1;
+            for (size_t k = 0; k < input16.size(); ++k) {
+                input16[k] = (i % 3 == 2 && (k / 37) % 3 == 0)
+                    ? mask
+                    : rnd.Rand16() & mask;
+                input8[k] = (uint8_t)input16[k];
+            }
+            const uint8_t *dgd = highbd
+                ? CONVERT_TO_BYTEPTR(input16.data() + 16 * stride + 16)
+                : input8.data() + 16 * stride + 16;
+
+            const int32_t ii_stride = SGRPROJ_II_STRIDE(w);
+            const int32_t ii_origin = (SGRPROJ_BORDER_VERT + 1) * ii_stride +
+                SGRPROJ_BORDER_HORZ + 1;
+            int32_t *C = ii_buf + ii_origin;
+            int32_t *D = C + SGRPROJ_II_PELS_MAX;
+            int32_t *A = D - ii_origin + SGRPROJ_II_PELS_MAX + ii_stride + 1;
+            int32_t *B = A + SGRPROJ_AB_PELS_MAX;
+            ii_fun(dgd, w, h, stride, C, D, ii_stride, highbd);
+
+            for (int32_t ep = 0; ep < SGRPROJ_PARAMS; ++ep) {
+                const SgrParamsType *params = &eb_sgr_params[ep];
+                for (int32_t y = 0; y < h; y += pu) {
+                    for (int32_t x = 0; x < w; x += pu) {
+                        const int32_t pw = AOMMIN(pu, w - x);
+                        const int32_t ph = AOMMIN(pu, h - y);
+                        const int32_t o = y * flt_stride + x;
+                        svt_av1_selfguided_restoration_c(
+                            dgd + y * stride + x,
+                            pw,
+                            ph,
+                            stride,
+                            ref.data() + o,
+                            ref.data() + flt_stride * max_h + o,
+                            flt_stride,
+                            ep,
+                            bit_depth,
+                            highbd);
+                        tst_fun(dgd + y * stride + x,
+                                pw,
+                                ph,
+                                stride,
+                                C + y * ii_stride + x,
+                                D + y * ii_stride + x,
+                                A,
+                                B,
+                                ii_stride,
+                                tst.data() + o,
+                                tst.data() + flt_stride * max_h + o,
+                                flt_stride,
+                                ep,
+                                bit_depth,
+                                highbd);
+                    }
+                }
+                for (int32_t f = 0; f < 2; ++f) {
+                    if (params->r[f] == 0)
+                        continue;
+                    for (int32_t y = 0; y < h; ++y)
+                        for (int32_t x = 0; x < w; ++x) {
+                            const int32_t o = f * flt_stride * max_h +
+                                y * flt_stride + x;
+                            ASSERT_EQ(ref[o], tst[o])
+                                << "unit " << w << "x" << h << " ep " << ep
+                                << " flt" << f << " at " << x << "," << y;
+                        }
+                }
+            }
+        }
+        svt_aom_free(ii_buf);
+    }
+};
+
+TEST_P(AV1SelfguidedFromIiTest, CorrectnessTest) {
+    RunCorrectnessTest();
+}
+
+INSTANTIATE_TEST_CASE_P(
+    C, AV1SelfguidedFromIiTest,
+    ::testing::Combine(
+        ::testing::Values(svt_av1_sgr_integral_images_c),
+        ::testing::Values(svt_av1_selfguided_restoration_from_ii_c),
+        ::testing::ValuesIn(highbd_params_avx2)));
+
+INSTANTIATE_TEST_CASE_P(
+    AVX2, AV1SelfguidedFromIiTest,
+    ::testing::Combine(
+        ::testing::Values(svt_av1_sgr_integral_images_avx2),
+        ::testing::Values(svt_av1_selfguided_restoration_from_ii_avx2),
+        ::testing::ValuesIn(highbd_params_avx2)));
+
 }  // namespace